@@ -37,10 +37,14 @@
 #ifndef _H5EBSDVOLUMEREADER_H_
 #define _H5EBSDVOLUMEREADER_H_
 
+#include <hdf5.h>
+
 #include <QtCore/QString>
 #include <QtCore/QVector>
 #include <QtCore/QSet>
 
+#include "H5Support/H5Lite.h"
+
 #include "EbsdLib/EbsdSetGetMacros.h"
 #include "EbsdLib/EbsdLib.h"
 #include "EbsdLib/EbsdConstants.h"
@@ -146,6 +150,58 @@ class EbsdLib_EXPORT H5EbsdVolumeReader : public H5EbsdVolumeInfo
   protected:
     H5EbsdVolumeReader();
 
+    /**
+     * @brief Reads one data set of a slice straight into its plane of a volume array. A slice that is
+     * smaller than the volume in X or Y is centered in the plane, and only the first xslice * yslice
+     * values of the data set are read.
+     * @param dataGid The 'Data' group of the slice
+     * @param name The name of the data set
+     * @param volume The first value of the volume array
+     * @param xpoints The number of x voxels in the volume
+     * @param ypoints The number of y voxels in the volume
+     * @param zval The z index of the slice in the volume
+     * @param xslice The number of x points in the slice
+     * @param yslice The number of y points in the slice
+     * @return Negative value on error
+     */
+    template<typename T>
+    int readSliceArray(hid_t dataGid, const QString& name, T* volume, int64_t xpoints, int64_t ypoints, int64_t zval,
+                       int64_t xslice, int64_t yslice)
+    {
+      if (xslice > xpoints || yslice > ypoints || xslice < 1 || yslice < 1) { return -1; }
+      T test = 0x00;
+      hid_t memType = H5Lite::HDFTypeForPrimitive(test);
+      hid_t did = H5Dopen(dataGid, name.toLatin1().data(), H5P_DEFAULT);
+      if (did < 0) { return -1; }
+
+      herr_t err = -1;
+      hid_t fileSpace = H5Dget_space(did);
+      hsize_t numValues = static_cast<hsize_t>(H5Sget_simple_extent_npoints(fileSpace));
+      hsize_t fileStart[1] = { 0 };
+      hsize_t fileCount[1] = { static_cast<hsize_t>(xslice * yslice) };
+      if (numValues == fileCount[0]) { err = H5Sselect_all(fileSpace); }
+      else if (numValues > fileCount[0] && H5Sget_simple_extent_ndims(fileSpace) == 1)
+      {
+        err = H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, fileStart, NULL, fileCount, NULL);
+      }
+      if (err >= 0)
+      {
+        hsize_t memDims[2] = { static_cast<hsize_t>(ypoints), static_cast<hsize_t>(xpoints) };
+        hsize_t memStart[2] = { static_cast<hsize_t>((ypoints - yslice) / 2), static_cast<hsize_t>((xpoints - xslice) / 2) };
+        hsize_t memCount[2] = { static_cast<hsize_t>(yslice), static_cast<hsize_t>(xslice) };
+        hid_t memSpace = H5Screate_simple(2, memDims, NULL);
+        err = H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, memStart, NULL, memCount, NULL);
+        if (err >= 0)
+        {
+          err = H5Dread(did, memType, memSpace, fileSpace, H5P_DEFAULT, volume + zval * xpoints * ypoints);
+        }
+        H5Sclose(memSpace);
+      }
+      H5Sclose(fileSpace);
+      H5Dclose(did);
+      return err;
+    }
+
   private:
     QSet<QString>         m_ArrayNames;
     bool                  m_ReadAllArrays;
@@ -40,6 +40,7 @@
 
 #include "H5Support/QH5Lite.h"
 #include "H5Support/QH5Utilities.h"
+#include "H5Support/HDF5ScopedFileSentinel.h"
 
 #include "EbsdLib/EbsdConstants.h"
 #include "EbsdLib/HKL/H5CtfReader.h"
@@ -204,6 +205,12 @@ QVector<CtfPhase::Pointer> H5CtfVolumeReader::getPhases()
   return m_Phases;
 }
 
+#define H5CTFREADER_READ_SLICE_ARRAY(name, var)\
+  if (NULL != var) {\
+    err = readSliceArray(dataGid, Ebsd::Ctf::name, var, xpoints, ypoints, zval, xpointsslice, ypointsslice);\
+    if (err < 0) { return err; }\
+  }
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -212,108 +219,94 @@ int H5CtfVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir)
 {
-  int index = 0;
   int err = -1;
 // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-  int readerIndex = 0;
-  int64_t xpointsslice = 0;
-  int64_t ypointsslice = 0;
-  int64_t xpointstemp = 0;
-  int64_t ypointstemp = 0;
   int zval = 0;
 
+  err = readVolumeInfo();
 
-  int xstartspot = 0;
-  int ystartspot = 0;
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == Ebsd::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
 
-  err = readVolumeInfo();
+  // The file is opened once and every slice is read by HDF5 straight into its plane of the volume arrays
+  hid_t fileId = QH5Utilities::openFile(getFileName(), true);
+  if (fileId < 0)
+  {
+    std::cout << "H5CtfVolumeReader Error: Could not open the hdf5 file." << std::endl;
+    return -77000;
+  }
+  HDF5ScopedFileSentinel sentinel(&fileId, true);
 
   for (int slice = 0; slice < zpoints; ++slice)
   {
-    H5CtfReader::Pointer reader = H5CtfReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-
-    err = reader->readFile();
-    if (err < 0)
-    {
-      std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
-      return -77000;
-    }
-    readerIndex = 0;
-    xpointsslice = reader->getXCells();
-    ypointsslice = reader->getYCells();
-    int* phasePtr = reader->getPhasePointer();
-    float* xPtr = reader->getXPointer();
-    float* yPtr = reader->getYPointer();
-    int* bandPtr = reader->getBandCountPointer();
-    int* errorPtr = reader->getErrorPointer();
-    float* euler1Ptr = reader->getEuler1Pointer();
-    float* euler2Ptr = reader->getEuler2Pointer();
-    float* euler3Ptr = reader->getEuler3Pointer();
-    float* madPtr = reader->getMeanAngularDeviationPointer();
-    int* bcPtr = reader->getBandContrastPointer();
-    int* bsPtr = reader->getBandSlopePointer();
-
-    xpointstemp = xpoints;
-    ypointstemp = ypoints;
-    xstartspot = static_cast<int>( (xpointstemp - xpointsslice) / 2 );
-    ystartspot = static_cast<int>( (ypointstemp - ypointsslice) / 2 );
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == Ebsd::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
     if (ZDir == 0) { zval = slice; }
     if (ZDir == 1) { zval = static_cast<int>( (zpoints - 1) - slice ); }
 
-    // Copy the data from the current storage into the Storage Location
-    for (int j = 0; j < ypointsslice; j++)
+    err = readSlice(fileId, QString::number(slice + getSliceStart()), xpoints, ypoints, zval);
+    if (err < 0)
     {
-      for (int i = 0; i < xpointsslice; i++)
-      {
-        index = static_cast<int>( (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot) );
-        if (NULL != phasePtr) {m_Phase[index] = phasePtr[readerIndex];}
-        if (NULL != xPtr) {m_X[index] = xPtr[readerIndex];}
-        if (NULL != yPtr) {m_Y[index] = yPtr[readerIndex];}
-        if (NULL != bandPtr) {m_Bands[index] = bandPtr[readerIndex];}
-        if (NULL != errorPtr) {m_Error[index] = errorPtr[readerIndex];}
-        if (NULL != euler1Ptr) {m_Euler1[index] = euler1Ptr[readerIndex];}
-        if (NULL != euler2Ptr) {m_Euler2[index] = euler2Ptr[readerIndex];}
-        if (NULL != euler3Ptr) {m_Euler3[index] = euler3Ptr[readerIndex];}
-        if (NULL != madPtr) {m_MAD[index] = madPtr[readerIndex];}
-        if (NULL != bcPtr) {m_BC[index] = bcPtr[readerIndex];}
-        if (NULL != bsPtr) {m_BS[index] = bsPtr[readerIndex];}
-
-        /* For HKL OIM Files if there is a single phase then the value of the phase
-         * data is one (1). If there are 2 or more phases then the lowest value
-         * of phase is also one (1). However, if there are "zero solutions" in the data
-         * then those points are assigned a phase of zero.  Since those points can be identified
-         * by other methods, the phase of these points should be changed to one since in the rest
-         * of the reconstruction code we follow the convention that the lowest value is One (1)
-         * even if there is only a single phase. The next if statement converts all zeros to ones
-         * if there is a single phase in the OIM data.
-         */
-//        if(NULL != phasePtr && m_Phase[index] < 1)
-//        {
-//          m_Phase[index] = 1;
-//        }
-
-        ++readerIndex;
-      }
+      std::cout << "H5CtfVolumeReader Error: There was an issue loading the data from the hdf5 file." << std::endl;
+      return -77000;
     }
   }
   return err;
 
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5CtfVolumeReader::readSlice(hid_t fileId, const QString& slicePath, int64_t xpoints, int64_t ypoints, int zval)
+{
+  int err = -1;
+  hid_t sliceGid = H5Gopen(fileId, slicePath.toLatin1().data(), H5P_DEFAULT);
+  if (sliceGid < 0) { return -1; }
+  HDF5ScopedGroupSentinel sentinel(&sliceGid, true);
+
+  hid_t headerGid = H5Gopen(sliceGid, Ebsd::H5::Header.toLatin1().data(), H5P_DEFAULT);
+  if (headerGid < 0) { return -1; }
+  sentinel.addGroupId(&headerGid);
+
+  int xpointsslice = 0;
+  int ypointsslice = 0;
+  err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ctf::XCells, xpointsslice);
+  if (err >= 0) { err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ctf::YCells, ypointsslice); }
+  if (err < 0) { return err; }
+  if (xpointsslice < 1 || ypointsslice < 1)
+  {
+    setErrorCode(-90021);
+    setErrorMessage(QString("H5CtfVolumeReader Error: The grid of slice '%1' is empty (%2 x %3 points)").arg(slicePath).arg(xpointsslice).arg(ypointsslice));
+    return getErrorCode();
+  }
+  if (xpointsslice > xpoints || ypointsslice > ypoints)
+  {
+    setErrorCode(-90022);
+    setErrorMessage(QString("H5CtfVolumeReader Error: The grid of slice '%1' (%2 x %3 points) is larger than the volume (%4 x %5 points)")
+                    .arg(slicePath).arg(xpointsslice).arg(ypointsslice).arg(xpoints).arg(ypoints));
+    return getErrorCode();
+  }
+
+  hid_t dataGid = H5Gopen(sliceGid, Ebsd::H5::Data.toLatin1().data(), H5P_DEFAULT);
+  if (dataGid < 0) { return -1; }
+  sentinel.addGroupId(&dataGid);
+
+  // Arrays that were not requested were never allocated by initPointers(). The X, Y and Z
+  // positions are not stored in the .h5ebsd file and stay zero.
+  H5CTFREADER_READ_SLICE_ARRAY(Phase, m_Phase)
+  H5CTFREADER_READ_SLICE_ARRAY(Bands, m_Bands)
+  H5CTFREADER_READ_SLICE_ARRAY(Error, m_Error)
+  H5CTFREADER_READ_SLICE_ARRAY(Euler1, m_Euler1)
+  H5CTFREADER_READ_SLICE_ARRAY(Euler2, m_Euler2)
+  H5CTFREADER_READ_SLICE_ARRAY(Euler3, m_Euler3)
+  H5CTFREADER_READ_SLICE_ARRAY(MAD, m_MAD)
+  H5CTFREADER_READ_SLICE_ARRAY(BC, m_BC)
+  H5CTFREADER_READ_SLICE_ARRAY(BS, m_BS)
+
+  return 0;
+}
+
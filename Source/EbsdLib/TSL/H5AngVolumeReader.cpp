@@ -41,7 +41,9 @@
 #include <QtCore/QString>
 
 #include "H5Support/H5Lite.h"
+#include "H5Support/QH5Lite.h"
 #include "H5Support/QH5Utilities.h"
+#include "H5Support/HDF5ScopedFileSentinel.h"
 
 #include "EbsdLib/EbsdConstants.h"
 #include "EbsdLib/TSL/H5AngReader.h"
@@ -203,6 +205,17 @@ QVector<AngPhase::Pointer> H5AngVolumeReader::getPhases()
 
 
 
+#define H5ANGREADER_READ_SLICE_ARRAY(name, var)\
+  if (NULL != var) {\
+    err = readSliceArray(dataGid, Ebsd::Ang::name, var, xpoints, ypoints, zval, xpointsslice, ypointsslice);\
+    if (err < 0) {\
+      setErrorCode(-90020);\
+      setErrorMessage(QString("Error reading dataset '%1' of slice '%2' from the HDF5 file. This data set is required to be in the file because either "\
+                              "the program is set to read ALL the Data arrays or the program was instructed to read this array.").arg(#name).arg(slicePath));\
+      return getErrorCode();\
+    }\
+  }
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -211,108 +224,143 @@ int H5AngVolumeReader::loadData(int64_t xpoints,
                                 int64_t zpoints,
                                 uint32_t ZDir )
 {
-  int index = 0;
   int err = -1;
   // Initialize all the pointers
   initPointers(xpoints * ypoints * zpoints);
 
-
-  int readerIndex = 0;
-  int xpointsslice = 0;
-  int ypointsslice = 0;
-  int xpointstemp = 0;
-  int ypointstemp = 0;
-  int xstop = 0;
-  int ystop = 0;
   int zval = 0;
-
-  int xstartspot = 0;
-  int ystartspot = 0;
   int numPhases = getNumPhases();
   err = readVolumeInfo();
+
+  // If no stacking order preference was passed, read it from the file and use that value
+  if(ZDir == Ebsd::RefFrameZDir::UnknownRefFrameZDirection)
+  {
+    ZDir = getStackingOrder();
+  }
+
+  // The file is opened once and every slice is read by HDF5 straight into its plane of the volume arrays
+  hid_t fileId = QH5Utilities::openFile(getFileName(), true);
+  if (fileId < 0)
+  {
+    setErrorCode(-90000);
+    setErrorMessage(QString("H5AngVolumeReader Error: Could not open HDF5 file '%1'").arg(getFileName()));
+    return getErrorCode();
+  }
+  HDF5ScopedFileSentinel sentinel(&fileId, true);
+
   for (int slice = 0; slice < zpoints; ++slice)
   {
-    H5AngReader::Pointer reader = H5AngReader::New();
-    reader->setFileName(getFileName());
-    reader->setHDF5Path(QString::number(slice + getSliceStart()));
-    reader->setUserZDir(getStackingOrder());
-    reader->setSampleTransformationAngle(getSampleTransformationAngle());
-    reader->setSampleTransformationAxis(getSampleTransformationAxis());
-    reader->setEulerTransformationAngle(getEulerTransformationAngle());
-    reader->setEulerTransformationAxis(getEulerTransformationAxis());
-    reader->readAllArrays(getReadAllArrays());
-    reader->setArraysToRead(getArraysToRead());
-    err = reader->readFile();
-    if(err < 0)
+    if(ZDir == Ebsd::RefFrameZDir::LowtoHigh) { zval = slice; }
+    if(ZDir == Ebsd::RefFrameZDir::HightoLow) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+
+    err = readSlice(fileId, QString::number(slice + getSliceStart()), xpoints, ypoints, zval, numPhases);
+    if (err < 0)
     {
-      setErrorCode(reader->getErrorCode());
-      setErrorMessage(reader->getErrorMessage());
       return getErrorCode();
     }
-    readerIndex = 0;
-    xpointsslice = reader->getNumEvenCols();
-    ypointsslice = reader->getNumRows();
-    float* euler1Ptr = reader->getPhi1Pointer();
-    if (NULL == euler1Ptr) { setErrorCode(-99090); setErrorMessage("Euler1 Pointer was NULL from Reader"); return getErrorCode(); }
-    float* euler2Ptr = reader->getPhiPointer();
-    float* euler3Ptr = reader->getPhi2Pointer();
-    float* xPtr = reader->getXPositionPointer();
-    float* yPtr = reader->getYPositionPointer();
-    float* iqPtr = reader->getImageQualityPointer();
-    float* ciPtr = reader->getConfidenceIndexPointer();
-    int* phasePtr = reader->getPhaseDataPointer();
-    float* sigPtr = reader->getSEMSignalPointer();
-    float* fitPtr = reader->getFitPointer();
-
-    xpointstemp = static_cast<int>(xpoints);
-    ypointstemp = static_cast<int>(ypoints);
-    xstartspot = (xpointstemp - xpointsslice) / 2;
-    ystartspot = (ypointstemp - ypointsslice) / 2;
-    xstop = xpointsslice;
-    ystop = ypointsslice;
-
-    // If no stacking order preference was passed, read it from the file and use that value
-    if(ZDir == Ebsd::RefFrameZDir::UnknownRefFrameZDirection)
-    {
-      ZDir = getStackingOrder();
-    }
-    if(ZDir == Ebsd::RefFrameZDir::LowtoHigh) { zval = slice; }
-    if(ZDir == Ebsd::RefFrameZDir::HightoLow) { zval = static_cast<int>( (zpoints - 1) - slice ); }
+  }
+  return err;
+}
 
-    // Copy the data from the current storage into the new memory Location
-    for (int j = 0; j < ystop; j++)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int H5AngVolumeReader::readSlice(hid_t fileId, const QString& slicePath, int64_t xpoints, int64_t ypoints, int zval, int numPhases)
+{
+  int err = -1;
+  hid_t sliceGid = H5Gopen(fileId, slicePath.toLatin1().data(), H5P_DEFAULT);
+  if (sliceGid < 0)
+  {
+    setErrorCode(-90001);
+    setErrorMessage(QString("H5AngVolumeReader Error: Could not open path '%1'").arg(slicePath));
+    return getErrorCode();
+  }
+  HDF5ScopedGroupSentinel sentinel(&sliceGid, true);
+
+  hid_t headerGid = H5Gopen(sliceGid, Ebsd::H5::Header.toLatin1().data(), H5P_DEFAULT);
+  if (headerGid < 0)
+  {
+    setErrorCode(-90008);
+    setErrorMessage("H5AngVolumeReader Error: Could not open 'Header' Group");
+    return getErrorCode();
+  }
+  sentinel.addGroupId(&headerGid);
+
+  int xpointsslice = 0;
+  int ypointsslice = 0;
+  QString grid;
+  err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ang::NColsEven, xpointsslice);
+  if (err >= 0) { err = QH5Lite::readScalarDataset(headerGid, Ebsd::Ang::NRows, ypointsslice); }
+  if (err >= 0) { err = QH5Lite::readStringDataset(headerGid, Ebsd::Ang::Grid, grid); }
+  if (err < 0)
+  {
+    setErrorCode(-90001);
+    setErrorMessage(QString("H5AngVolumeReader Error: The header of slice '%1' is missing the grid or its dimensions").arg(slicePath));
+    return getErrorCode();
+  }
+  if (grid.startsWith(Ebsd::Ang::HexGrid) == true)
+  {
+    setErrorCode(-90400);
+    setErrorMessage("Ang Files with Hex Grids Are NOT currently supported. Please convert them to Square Grid files first");
+    return getErrorCode();
+  }
+  if (xpointsslice < 1 || ypointsslice < 1)
+  {
+    setErrorCode(-90021);
+    setErrorMessage(QString("H5AngVolumeReader Error: The grid of slice '%1' is empty (%2 x %3 points)").arg(slicePath).arg(xpointsslice).arg(ypointsslice));
+    return getErrorCode();
+  }
+  if (xpointsslice > xpoints || ypointsslice > ypoints)
+  {
+    setErrorCode(-90022);
+    setErrorMessage(QString("H5AngVolumeReader Error: The grid of slice '%1' (%2 x %3 points) is larger than the volume (%4 x %5 points)")
+                    .arg(slicePath).arg(xpointsslice).arg(ypointsslice).arg(xpoints).arg(ypoints));
+    return getErrorCode();
+  }
+
+  hid_t dataGid = H5Gopen(sliceGid, Ebsd::H5::Data.toLatin1().data(), H5P_DEFAULT);
+  if (dataGid < 0)
+  {
+    setErrorCode(-90012);
+    setErrorMessage("H5AngVolumeReader Error: Could not open 'Data' Group");
+    return getErrorCode();
+  }
+  sentinel.addGroupId(&dataGid);
+
+  // Arrays that were not requested were never allocated by initPointers()
+  H5ANGREADER_READ_SLICE_ARRAY(Phi1, m_Phi1)
+  H5ANGREADER_READ_SLICE_ARRAY(Phi, m_Phi)
+  H5ANGREADER_READ_SLICE_ARRAY(Phi2, m_Phi2)
+  H5ANGREADER_READ_SLICE_ARRAY(ImageQuality, m_Iq)
+  H5ANGREADER_READ_SLICE_ARRAY(ConfidenceIndex, m_Ci)
+  H5ANGREADER_READ_SLICE_ARRAY(PhaseData, m_PhaseData)
+  H5ANGREADER_READ_SLICE_ARRAY(XPosition, m_X)
+  H5ANGREADER_READ_SLICE_ARRAY(YPosition, m_Y)
+  H5ANGREADER_READ_SLICE_ARRAY(Fit, m_Fit)
+  H5ANGREADER_READ_SLICE_ARRAY(SEMSignal, m_SEMSignal)
+
+  /* For TSL OIM Files if there is a single phase then the value of the phase
+   * data is zero (0). If there are 2 or more phases then the lowest value
+   * of phase is one (1). In the rest of the reconstruction code we follow the
+   * convention that the lowest value is One (1) even if there is only a single
+   * phase. The next if statement converts all zeros to ones if there is a single
+   * phase in the OIM data.
+   */
+  if (numPhases == 1 && NULL != m_PhaseData)
+  {
+    int64_t xstartspot = (xpoints - xpointsslice) / 2;
+    int64_t ystartspot = (ypoints - ypointsslice) / 2;
+    for (int64_t j = 0; j < ypointsslice; j++)
     {
-      for (int i = 0; i < xstop; i++)
+      int* phases = m_PhaseData + (zval * xpoints * ypoints) + ((j + ystartspot) * xpoints) + xstartspot;
+      for (int64_t i = 0; i < xpointsslice; i++)
       {
-        index = (zval * xpointstemp * ypointstemp) + ((j + ystartspot) * xpointstemp) + (i + xstartspot);
-        if (NULL != euler1Ptr) {m_Phi1[index] = euler1Ptr[readerIndex];}
-        if (NULL != euler2Ptr) {m_Phi[index] = euler2Ptr[readerIndex];}
-        if (NULL != euler3Ptr) {m_Phi2[index] = euler3Ptr[readerIndex];}
-        if (NULL != xPtr) {m_X[index] = xPtr[readerIndex];}
-        if (NULL != yPtr) {m_Y[index] = yPtr[readerIndex];}
-        if (NULL != iqPtr) {m_Iq[index] = iqPtr[readerIndex];}
-        if (NULL != ciPtr) {m_Ci[index] = ciPtr[readerIndex];}
-        if (NULL != phasePtr) {m_PhaseData[index] = phasePtr[readerIndex];} // Phase
-        if (NULL != sigPtr) {m_SEMSignal[index] = sigPtr[readerIndex];}
-        if (NULL != fitPtr) {m_Fit[index] = fitPtr[readerIndex];}
-
-        /* For TSL OIM Files if there is a single phase then the value of the phase
-         * data is zero (0). If there are 2 or more phases then the lowest value
-         * of phase is one (1). In the rest of the reconstruction code we follow the
-         * convention that the lowest value is One (1) even if there is only a single
-         * phase. The next if statement converts all zeros to ones if there is a single
-         * phase in the OIM data.
-         */
-        if (numPhases == 1 && NULL != phasePtr && m_PhaseData[index] < 1)
-        {
-          m_PhaseData[index] = 1;
-        }
-
-        ++readerIndex;
+        if (phases[i] < 1) { phases[i] = 1; }
       }
     }
   }
-  return err;
+
+  return 0;
 }
 
 
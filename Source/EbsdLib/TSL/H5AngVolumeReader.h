@@ -119,6 +119,18 @@ class EbsdLib_EXPORT H5AngVolumeReader : public H5EbsdVolumeReader
   protected:
     H5AngVolumeReader();
 
+    /**
+     * @brief Reads the requested arrays of one slice from an open .h5ebsd file into the volume arrays
+     * @param fileId The open .h5ebsd file
+     * @param slicePath The HDF5 path of the slice
+     * @param xpoints The number of x voxels
+     * @param ypoints The number of y voxels
+     * @param zval The z index of the slice in the volume
+     * @param numPhases The number of phases in the volume
+     * @return Negative value on error
+     */
+    int readSlice(hid_t fileId, const QString& slicePath, int64_t xpoints, int64_t ypoints, int zval, int numPhases);
+
   private:
     QVector<AngPhase::Pointer> m_Phases;
 
@@ -0,0 +1,473 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "EbsdLib/EbsdLib.h"
+#include "EbsdLib/EbsdConstants.h"
+#include "EbsdLib/TSL/AngConstants.h"
+#include "EbsdLib/TSL/H5AngVolumeReader.h"
+#include "EbsdLib/HKL/CtfConstants.h"
+#include "EbsdLib/HKL/H5CtfVolumeReader.h"
+
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "EbsdLib/Test/EbsdLibTestFileLocation.h"
+
+#if defined (H5Support_NAMESPACE)
+using namespace H5Support_NAMESPACE;
+#endif
+
+namespace
+{
+  const int64_t k_XPoints = 6;
+  const int64_t k_YPoints = 5;
+
+  /**
+   * @brief Describes one slice of the test file: the grid stored in its header and
+   * the number of values actually stored in each of its data sets
+   */
+  struct SliceSpec
+  {
+    int32_t slice;
+    int32_t xCells;
+    int32_t yCells;
+    int32_t numValues;
+  };
+
+  // Slice 1 and 4 fill the volume, 2 is a smaller grid that gets centered and 3 is
+  // a smaller grid whose data sets are longer than the grid. The last three slices
+  // are broken: an empty grid, a grid larger than the volume and data sets that are
+  // shorter than the grid.
+  const SliceSpec k_Slices[] =
+  {
+    { 1, 6, 5, 30 },
+    { 2, 4, 3, 12 },
+    { 3, 4, 3, 30 },
+    { 4, 6, 5, 30 },
+    { 5, 4, 0, 12 },
+    { 6, 7, 5, 35 },
+    { 7, 4, 3, 10 }
+  };
+  const int32_t k_NumSlices = sizeof(k_Slices) / sizeof(SliceSpec);
+
+  const int32_t k_EmptyGridSlice = 5;
+  const int32_t k_OversizedGridSlice = 6;
+  const int32_t k_ShortDataSlice = 7;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  QFile::remove(UnitTest::H5EbsdVolumeReaderTest::AngFile);
+  QFile::remove(UnitTest::H5EbsdVolumeReaderTest::CtfFile);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float SliceValue(int32_t slice, int64_t index)
+{
+  return static_cast<float>(slice * 100 + index);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteVolumeHeader(hid_t fileId, const QString& manufacturer)
+{
+  int err = 0;
+  int32_t zStart = k_Slices[0].slice;
+  int32_t zEnd = k_Slices[k_NumSlices - 1].slice;
+  int64_t xPoints = k_XPoints;
+  int64_t yPoints = k_YPoints;
+  float res = 0.5f;
+  uint32_t stackingOrder = Ebsd::RefFrameZDir::LowtoHigh;
+  float angle = 0.0f;
+  QVector<hsize_t> dims(1, 3);
+  QVector<float> axis(3, 0.0f);
+  axis[2] = 1.0f;
+
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZStartIndex, zStart);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZEndIndex, zEnd);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::XPoints, xPoints);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::YPoints, yPoints);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::XResolution, res);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::YResolution, res);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::ZResolution, res);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::StackingOrder, stackingOrder);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::SampleTransformationAngle, angle);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeVectorDataset(fileId, Ebsd::H5::SampleTransformationAxis, dims, axis);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeScalarDataset(fileId, Ebsd::H5::EulerTransformationAngle, angle);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeVectorDataset(fileId, Ebsd::H5::EulerTransformationAxis, dims, axis);
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writeStringDataset(fileId, Ebsd::H5::Manufacturer, manufacturer);
+  DREAM3D_REQUIRE(err >= 0)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteSliceData(hid_t dataGid, const SliceSpec& spec, const QString& eulerName, const QString& phaseName, int phase)
+{
+  std::vector<float> euler(spec.numValues);
+  std::vector<int> phases(spec.numValues, phase);
+  for (int32_t i = 0; i < spec.numValues; ++i)
+  {
+    euler[i] = SliceValue(spec.slice, i);
+  }
+  hsize_t dims[1] = { static_cast<hsize_t>(spec.numValues) };
+  int err = QH5Lite::writePointerDataset(dataGid, eulerName, 1, dims, &(euler.front()));
+  DREAM3D_REQUIRE(err >= 0)
+  err = QH5Lite::writePointerDataset(dataGid, phaseName, 1, dims, &(phases.front()));
+  DREAM3D_REQUIRE(err >= 0)
+}
+
+// -----------------------------------------------------------------------------
+//  Writes a TSL h5ebsd file. Every slice holds a single phase, which TSL stores
+//  as phase 0, so the reader has to convert the phases of each slice to 1.
+// -----------------------------------------------------------------------------
+void WriteAngFile()
+{
+  hid_t fileId = QH5Utilities::createFile(UnitTest::H5EbsdVolumeReaderTest::AngFile);
+  DREAM3D_REQUIRE(fileId > 0)
+  WriteVolumeHeader(fileId, Ebsd::Ang::Manufacturer);
+
+  for (int32_t s = 0; s < k_NumSlices; ++s)
+  {
+    const SliceSpec& spec = k_Slices[s];
+    hid_t sliceGid = QH5Utilities::createGroup(fileId, QString::number(spec.slice));
+    DREAM3D_REQUIRE(sliceGid > 0)
+
+    hid_t headerGid = QH5Utilities::createGroup(sliceGid, Ebsd::H5::Header);
+    DREAM3D_REQUIRE(headerGid > 0)
+    int32_t xCells = spec.xCells;
+    int32_t yCells = spec.yCells;
+    int err = QH5Lite::writeScalarDataset(headerGid, Ebsd::Ang::NColsEven, xCells);
+    DREAM3D_REQUIRE(err >= 0)
+    err = QH5Lite::writeScalarDataset(headerGid, Ebsd::Ang::NRows, yCells);
+    DREAM3D_REQUIRE(err >= 0)
+    err = QH5Lite::writeStringDataset(headerGid, Ebsd::Ang::Grid, Ebsd::Ang::SquareGrid);
+    DREAM3D_REQUIRE(err >= 0)
+    hid_t phasesGid = QH5Utilities::createGroup(headerGid, Ebsd::H5::Phases);
+    DREAM3D_REQUIRE(phasesGid > 0)
+    hid_t phaseGid = QH5Utilities::createGroup(phasesGid, QString::number(1));
+    DREAM3D_REQUIRE(phaseGid > 0)
+    H5Gclose(phaseGid);
+    H5Gclose(phasesGid);
+    H5Gclose(headerGid);
+
+    hid_t dataGid = QH5Utilities::createGroup(sliceGid, Ebsd::H5::Data);
+    DREAM3D_REQUIRE(dataGid > 0)
+    WriteSliceData(dataGid, spec, Ebsd::Ang::Phi1, Ebsd::Ang::PhaseData, 0);
+    H5Gclose(dataGid);
+    H5Gclose(sliceGid);
+  }
+  QH5Utilities::closeFile(fileId);
+}
+
+// -----------------------------------------------------------------------------
+//  Writes an HKL h5ebsd file with the same slices. The phase of every point is
+//  the number of its slice.
+// -----------------------------------------------------------------------------
+void WriteCtfFile()
+{
+  hid_t fileId = QH5Utilities::createFile(UnitTest::H5EbsdVolumeReaderTest::CtfFile);
+  DREAM3D_REQUIRE(fileId > 0)
+  WriteVolumeHeader(fileId, Ebsd::Ctf::Manufacturer);
+
+  for (int32_t s = 0; s < k_NumSlices; ++s)
+  {
+    const SliceSpec& spec = k_Slices[s];
+    hid_t sliceGid = QH5Utilities::createGroup(fileId, QString::number(spec.slice));
+    DREAM3D_REQUIRE(sliceGid > 0)
+
+    hid_t headerGid = QH5Utilities::createGroup(sliceGid, Ebsd::H5::Header);
+    DREAM3D_REQUIRE(headerGid > 0)
+    int32_t xCells = spec.xCells;
+    int32_t yCells = spec.yCells;
+    int err = QH5Lite::writeScalarDataset(headerGid, Ebsd::Ctf::XCells, xCells);
+    DREAM3D_REQUIRE(err >= 0)
+    err = QH5Lite::writeScalarDataset(headerGid, Ebsd::Ctf::YCells, yCells);
+    DREAM3D_REQUIRE(err >= 0)
+    hid_t phasesGid = QH5Utilities::createGroup(headerGid, Ebsd::H5::Phases);
+    DREAM3D_REQUIRE(phasesGid > 0)
+    hid_t phaseGid = QH5Utilities::createGroup(phasesGid, QString::number(1));
+    DREAM3D_REQUIRE(phaseGid > 0)
+    H5Gclose(phaseGid);
+    H5Gclose(phasesGid);
+    H5Gclose(headerGid);
+
+    hid_t dataGid = QH5Utilities::createGroup(sliceGid, Ebsd::H5::Data);
+    DREAM3D_REQUIRE(dataGid > 0)
+    WriteSliceData(dataGid, spec, Ebsd::Ctf::Euler1, Ebsd::Ctf::Phase, spec.slice);
+    H5Gclose(dataGid);
+    H5Gclose(sliceGid);
+  }
+  QH5Utilities::closeFile(fileId);
+}
+
+// -----------------------------------------------------------------------------
+//  Checks that a slice landed centered in plane zval of the volume and that the
+//  points around it were left at zero
+// -----------------------------------------------------------------------------
+void CheckEulerPlane(float* volume, int64_t zval, const SliceSpec& spec)
+{
+  int64_t xstart = (k_XPoints - spec.xCells) / 2;
+  int64_t ystart = (k_YPoints - spec.yCells) / 2;
+  float* plane = volume + zval * k_XPoints * k_YPoints;
+  for (int64_t y = 0; y < k_YPoints; ++y)
+  {
+    for (int64_t x = 0; x < k_XPoints; ++x)
+    {
+      bool inside = (x >= xstart && x < xstart + spec.xCells && y >= ystart && y < ystart + spec.yCells);
+      float expected = 0.0f;
+      if (inside)
+      {
+        expected = SliceValue(spec.slice, (y - ystart) * spec.xCells + (x - xstart));
+      }
+      DREAM3D_REQUIRE_EQUAL(plane[y * k_XPoints + x], expected)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CheckPhasePlane(int* volume, int64_t zval, const SliceSpec& spec, int phase)
+{
+  int64_t xstart = (k_XPoints - spec.xCells) / 2;
+  int64_t ystart = (k_YPoints - spec.yCells) / 2;
+  int* plane = volume + zval * k_XPoints * k_YPoints;
+  for (int64_t y = 0; y < k_YPoints; ++y)
+  {
+    for (int64_t x = 0; x < k_XPoints; ++x)
+    {
+      bool inside = (x >= xstart && x < xstart + spec.xCells && y >= ystart && y < ystart + spec.yCells);
+      int expected = inside ? phase : 0;
+      DREAM3D_REQUIRE_EQUAL(plane[y * k_XPoints + x], expected)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5AngVolumeReader::Pointer CreateAngReader(int sliceStart, int sliceEnd)
+{
+  QSet<QString> arrayNames;
+  arrayNames.insert(Ebsd::Ang::Phi1);
+  arrayNames.insert(Ebsd::Ang::PhaseData);
+
+  H5AngVolumeReader::Pointer reader = H5AngVolumeReader::New();
+  reader->setFileName(UnitTest::H5EbsdVolumeReaderTest::AngFile);
+  reader->setSliceStart(sliceStart);
+  reader->setSliceEnd(sliceEnd);
+  reader->setArraysToRead(arrayNames);
+  reader->readAllArrays(false);
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+H5CtfVolumeReader::Pointer CreateCtfReader(int sliceStart, int sliceEnd)
+{
+  QSet<QString> arrayNames;
+  arrayNames.insert(Ebsd::Ctf::Euler1);
+  arrayNames.insert(Ebsd::Ctf::Phase);
+
+  H5CtfVolumeReader::Pointer reader = H5CtfVolumeReader::New();
+  reader->setFileName(UnitTest::H5EbsdVolumeReaderTest::CtfFile);
+  reader->setSliceStart(sliceStart);
+  reader->setSliceEnd(sliceEnd);
+  reader->setArraysToRead(arrayNames);
+  reader->readAllArrays(false);
+  return reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestAngCentering()
+{
+  WriteAngFile();
+
+  // Slices 1 to 4: full grids, a centered smaller grid and a smaller grid with over long data sets
+  H5AngVolumeReader::Pointer reader = CreateAngReader(1, 4);
+  int err = reader->loadData(k_XPoints, k_YPoints, 4, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE(err >= 0)
+  DREAM3D_REQUIRE_VALID_POINTER(reader->getPhi1Pointer())
+  DREAM3D_REQUIRE_VALID_POINTER(reader->getPhaseDataPointer())
+  DREAM3D_REQUIRE(NULL == reader->getPhiPointer())
+
+  for (int32_t z = 0; z < 4; ++z)
+  {
+    CheckEulerPlane(reader->getPhi1Pointer(), z, k_Slices[z]);
+    // The single phase is converted from 0 to 1, but only inside the slice
+    CheckPhasePlane(reader->getPhaseDataPointer(), z, k_Slices[z], 1);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestAngSubRange()
+{
+  // Only slices 2 and 3 are read. High to low puts the first slice read at the top of the volume.
+  H5AngVolumeReader::Pointer reader = CreateAngReader(2, 3);
+  int err = reader->loadData(k_XPoints, k_YPoints, 2, Ebsd::RefFrameZDir::HightoLow);
+  DREAM3D_REQUIRE(err >= 0)
+  CheckEulerPlane(reader->getPhi1Pointer(), 1, k_Slices[1]);
+  CheckEulerPlane(reader->getPhi1Pointer(), 0, k_Slices[2]);
+  CheckPhasePlane(reader->getPhaseDataPointer(), 1, k_Slices[1], 1);
+  CheckPhasePlane(reader->getPhaseDataPointer(), 0, k_Slices[2], 1);
+
+  reader = CreateAngReader(3, 4);
+  err = reader->loadData(k_XPoints, k_YPoints, 2, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE(err >= 0)
+  CheckEulerPlane(reader->getPhi1Pointer(), 0, k_Slices[2]);
+  CheckEulerPlane(reader->getPhi1Pointer(), 1, k_Slices[3]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestAngSliceErrors()
+{
+  H5AngVolumeReader::Pointer reader = CreateAngReader(k_EmptyGridSlice, k_EmptyGridSlice);
+  int err = reader->loadData(k_XPoints, k_YPoints, 1, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -90021)
+  DREAM3D_REQUIRE(reader->getErrorMessage().contains("is empty"))
+
+  reader = CreateAngReader(k_OversizedGridSlice, k_OversizedGridSlice);
+  err = reader->loadData(k_XPoints, k_YPoints, 1, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -90022)
+  DREAM3D_REQUIRE(reader->getErrorMessage().contains("larger than the volume"))
+
+  // The grid is fine but the data sets hold fewer values than the grid
+  reader = CreateAngReader(k_ShortDataSlice, k_ShortDataSlice);
+  err = reader->loadData(k_XPoints, k_YPoints, 1, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -90020)
+  DREAM3D_REQUIRE(reader->getErrorMessage().contains(Ebsd::Ang::Phi1))
+
+  // A bad slice after good ones still fails the whole volume
+  reader = CreateAngReader(3, k_EmptyGridSlice);
+  err = reader->loadData(k_XPoints, k_YPoints, 3, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -90021)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestCtfReadSlice()
+{
+  WriteCtfFile();
+
+  H5CtfVolumeReader::Pointer reader = CreateCtfReader(1, 4);
+  int err = reader->loadData(k_XPoints, k_YPoints, 4, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE(err >= 0)
+  DREAM3D_REQUIRE_VALID_POINTER(reader->getEuler1Pointer())
+  DREAM3D_REQUIRE_VALID_POINTER(reader->getPhasePointer())
+  for (int32_t z = 0; z < 4; ++z)
+  {
+    CheckEulerPlane(reader->getEuler1Pointer(), z, k_Slices[z]);
+    CheckPhasePlane(reader->getPhasePointer(), z, k_Slices[z], k_Slices[z].slice);
+  }
+
+  reader = CreateCtfReader(2, 3);
+  err = reader->loadData(k_XPoints, k_YPoints, 2, Ebsd::RefFrameZDir::HightoLow);
+  DREAM3D_REQUIRE(err >= 0)
+  CheckEulerPlane(reader->getEuler1Pointer(), 1, k_Slices[1]);
+  CheckEulerPlane(reader->getEuler1Pointer(), 0, k_Slices[2]);
+  CheckPhasePlane(reader->getPhasePointer(), 1, k_Slices[1], k_Slices[1].slice);
+  CheckPhasePlane(reader->getPhasePointer(), 0, k_Slices[2], k_Slices[2].slice);
+
+  // The Ctf reader reports every slice failure as -77000 and keeps the cause in its error code
+  reader = CreateCtfReader(k_EmptyGridSlice, k_EmptyGridSlice);
+  err = reader->loadData(k_XPoints, k_YPoints, 1, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -77000)
+  DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -90021)
+
+  reader = CreateCtfReader(k_OversizedGridSlice, k_OversizedGridSlice);
+  err = reader->loadData(k_XPoints, k_YPoints, 1, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -77000)
+  DREAM3D_REQUIRE_EQUAL(reader->getErrorCode(), -90022)
+
+  reader = CreateCtfReader(k_ShortDataSlice, k_ShortDataSlice);
+  err = reader->loadData(k_XPoints, k_YPoints, 1, Ebsd::RefFrameZDir::LowtoHigh);
+  DREAM3D_REQUIRE_EQUAL(err, -77000)
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestAngCentering() )
+  DREAM3D_REGISTER_TEST( TestAngSubRange() )
+  DREAM3D_REGISTER_TEST( TestAngSliceErrors() )
+  DREAM3D_REGISTER_TEST( TestCtfReadSlice() )
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,606 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _OrientationBatchTransforms_H_
+#define _OrientationBatchTransforms_H_
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+#include "OrientationLib/OrientationLib.h"
+#include "OrientationLib/OrientationLibConstants.h"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/* The kernels in this file compute the same results as the matching functions in
+ * OrientationTransforms.hpp (Vector-Scalar quaternion layout) for whole arrays of
+ * orientations. Each thread copies a tile of interleaved tuples into one array per
+ * component, runs straight line loops over those arrays so the compiler can keep
+ * every lane busy, and writes the tile back out interleaved. Degenerate orientations
+ * that need a different formula are repaired by a scalar pass over the tile.
+ */
+namespace OrientationBatchDetail
+{
+  static const size_t k_TileSize = 128;
+  static const size_t k_MinParallelTuples = 8192;
+
+  /**
+   * @brief The Tile struct holds one tile of orientations split into one array per component
+   * along with scratch arrays for the intermediate values of a kernel
+   */
+  template<typename T>
+  struct Tile
+  {
+    T in[9][k_TileSize];
+    T out[9][k_TileSize];
+    T work[6][k_TileSize];
+  };
+
+  /**
+   * @brief wrapAngle Maps a negative angle into [0, period) the same way OrientationTransforms does
+   */
+  template<typename T>
+  inline T wrapAngle(T angle, double period)
+  {
+    if(angle < 0.0) { return static_cast<T>(fmod(angle + 100.0 * SIMPLib::Constants::k_Pi, period)); }
+    return angle;
+  }
+
+  /**
+   * @brief The TrigConstants struct holds the argument reduction constants (Pi/4 split in 3 parts)
+   * and minimax polynomials used by sinCos(). The coefficients are those of the Cephes
+   * sinf/cosf and sin/cos routines.
+   */
+  template<typename T>
+  struct TrigConstants
+  {
+  };
+
+  template<>
+  struct TrigConstants<float>
+  {
+    static float maxArgument() { return 8192.0f; }
+    static float fourOverPi() { return 1.27323954473516f; }
+    static float dp1() { return 0.78515625f; }
+    static float dp2() { return 2.4187564849853515625e-4f; }
+    static float dp3() { return 3.77489497744594108e-8f; }
+    static float sinPoly(float z) { return (-1.9515295891E-4f * z + 8.3321608736E-3f) * z - 1.6666654611E-1f; }
+    static float cosPoly(float z) { return (2.443315711809948E-005f * z - 1.388731625493765E-003f) * z + 4.166664568298827E-002f; }
+  };
+
+  template<>
+  struct TrigConstants<double>
+  {
+    static double maxArgument() { return 1.073741824e9; }
+    static double fourOverPi() { return 1.27323954473516268615; }
+    static double dp1() { return 7.85398125648498535156E-1; }
+    static double dp2() { return 3.77489470793079817668E-8; }
+    static double dp3() { return 2.69515142907905952645E-15; }
+    static double sinPoly(double z)
+    {
+      return ((((1.58962301576546568060E-10 * z - 2.50507477628578072866E-8) * z + 2.75573136213857245213E-6) * z
+               - 1.98412698295895385996E-4) * z + 8.33333333332211858878E-3) * z - 1.66666666666666307295E-1;
+    }
+    static double cosPoly(double z)
+    {
+      return ((((-1.13585365213876817300E-11 * z + 2.08757008419747316778E-9) * z - 2.75573141792967388112E-7) * z
+               + 2.48015872888517045348E-5) * z - 1.38888888888730564116E-3) * z + 4.16666666666665929218E-2;
+    }
+  };
+
+  /**
+   * @brief sinCos Computes the sine and cosine of an array of angles. The main loop has no branches
+   * or library calls so that it can be vectorized. Arguments larger than TrigConstants<T>::maxArgument()
+   * (and NaN) are recomputed with the C math library afterwards.
+   * @param x The angles in radians
+   * @param s [output] The sines
+   * @param c [output] The cosines. May not alias x.
+   * @param n The number of angles
+   */
+  template<typename T>
+  void sinCos(const T* x, T* s, T* c, size_t n)
+  {
+    typedef TrigConstants<T> TC;
+    const T maxArgument = TC::maxArgument();
+
+    // Stage the clamped magnitudes in the cosine array. Doing the clamp in its own loop keeps the
+    // compiler from splitting the main loop into an in range path and an out of range path.
+    int outOfRange = 0;
+    for(size_t i = 0; i < n; i++)
+    {
+      T ax = fabs(x[i]);
+      outOfRange += (ax < maxArgument) ? 0 : 1;
+      c[i] = (ax < maxArgument) ? ax : static_cast<T>(0.0);
+    }
+
+    for(size_t i = 0; i < n; i++)
+    {
+      T ax = c[i];
+      // Octant of the argument rounded up to an even value so the reduced argument is in [-Pi/4, Pi/4]
+      int j = static_cast<int>(ax * TC::fourOverPi());
+      j = (j + 1) & ~1;
+      T y = static_cast<T>(j);
+      T r = ((ax - y * TC::dp1()) - y * TC::dp2()) - y * TC::dp3();
+      T z = r * r;
+      T sp = r + r * z * TC::sinPoly(z);
+      T cp = static_cast<T>(1.0) - static_cast<T>(0.5) * z + z * z * TC::cosPoly(z);
+      int quadrant = (j >> 1) & 3;
+      T ss = ((quadrant & 1) != 0) ? cp : sp;
+      T cc = ((quadrant & 1) != 0) ? sp : cp;
+      T sinSign = ((quadrant & 2) != 0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+      T cosSign = (((quadrant + 1) & 2) != 0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+      T xSign = (x[i] < 0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+      s[i] = xSign * (sinSign * ss);
+      c[i] = cosSign * cc;
+    }
+
+    for(size_t i = 0; outOfRange > 0 && i < n; i++)
+    {
+      if(!(fabs(x[i]) < maxArgument))
+      {
+        s[i] = sin(x[i]);
+        c[i] = cos(x[i]);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Eu2Qu
+  {
+    enum { InComps = 3, OutComps = 4 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      const T eps = static_cast<T>(RConst::epsijk);
+      T* phi = t.out[0];
+      T* minus = t.out[1];
+      T* plus = t.out[2];
+      for(size_t i = 0; i < n; i++)
+      {
+        T h0 = static_cast<T>(0.5) * t.in[0][i];
+        T h2 = static_cast<T>(0.5) * t.in[2][i];
+        phi[i] = static_cast<T>(0.5) * t.in[1][i];
+        minus[i] = h0 - h2;
+        plus[i] = h0 + h2;
+      }
+      sinCos(phi, t.work[0], t.work[1], n);
+      sinCos(minus, t.work[2], t.work[3], n);
+      sinCos(plus, t.work[4], t.work[5], n);
+
+      for(size_t i = 0; i < n; i++)
+      {
+        T sPhi = t.work[0][i];
+        T cPhi = t.work[1][i];
+        T sm = t.work[2][i];
+        T cm = t.work[3][i];
+        T sp = t.work[4][i];
+        T cp = t.work[5][i];
+        T w = cPhi * cp;
+        T sign = (w < 0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0);
+        t.out[0][i] = sign * -eps * sPhi * cm;
+        t.out[1][i] = sign * -eps * sPhi * sm;
+        t.out[2][i] = sign * -eps * cPhi * sp;
+        t.out[3][i] = sign * w;
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Qu2Eu
+  {
+    enum { InComps = 4, OutComps = 3 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      const T* qx = t.in[0];
+      const T* qy = t.in[1];
+      const T* qz = t.in[2];
+      const T* qw = t.in[3];
+      int degenerate = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+        T q03 = qw[i] * qw[i] + qz[i] * qz[i];
+        T q12 = qx[i] * qx[i] + qy[i] * qy[i];
+        T chi = sqrt(q03 * q12);
+        degenerate += (chi == 0.0) ? 1 : 0;
+        T ichi = (chi == 0.0) ? static_cast<T>(0.0) : static_cast<T>(1.0) / chi;
+        t.out[1][i] = atan2(static_cast<T>(2.0) * chi, q03 - q12);
+        t.out[0][i] = atan2((-qw[i] * qy[i] + qx[i] * qz[i]) * ichi, (-qw[i] * qx[i] - qy[i] * qz[i]) * ichi);
+        t.out[2][i] = atan2((qw[i] * qy[i] + qx[i] * qz[i]) * ichi, (-qw[i] * qx[i] + qy[i] * qz[i]) * ichi);
+      }
+
+      // Rotations about the sample or crystal Z axis only: phi2 is arbitrary and set to zero
+      for(size_t i = 0; degenerate > 0 && i < n; i++)
+      {
+        T q03 = qw[i] * qw[i] + qz[i] * qz[i];
+        T q12 = qx[i] * qx[i] + qy[i] * qy[i];
+        if(sqrt(q03 * q12) != 0.0) { continue; }
+        if(q12 == 0.0)
+        {
+          t.out[0][i] = atan2(static_cast<T>(-2.0 * RConst::epsijkd) * qw[i] * qz[i], qw[i] * qw[i] - qz[i] * qz[i]);
+          t.out[1][i] = 0.0;
+        }
+        else
+        {
+          t.out[0][i] = atan2(static_cast<T>(2.0) * qx[i] * qy[i], qx[i] * qx[i] - qy[i] * qy[i]);
+          t.out[1][i] = static_cast<T>(SIMPLib::Constants::k_Pi);
+        }
+        t.out[2][i] = 0.0;
+      }
+
+      for(size_t i = 0; i < n; i++)
+      {
+        t.out[0][i] = wrapAngle(t.out[0][i], SIMPLib::Constants::k_2Pi);
+        t.out[1][i] = wrapAngle(t.out[1][i], SIMPLib::Constants::k_Pi);
+        t.out[2][i] = wrapAngle(t.out[2][i], SIMPLib::Constants::k_2Pi);
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Eu2Om
+  {
+    enum { InComps = 3, OutComps = 9 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      const T eps = static_cast<T>(1.0E-7f);
+      sinCos(t.in[0], t.work[0], t.work[1], n);
+      sinCos(t.in[1], t.work[2], t.work[3], n);
+      sinCos(t.in[2], t.work[4], t.work[5], n);
+
+      for(size_t i = 0; i < n; i++)
+      {
+        T s1 = t.work[0][i];
+        T c1 = t.work[1][i];
+        T s = t.work[2][i];
+        T c = t.work[3][i];
+        T s2 = t.work[4][i];
+        T c2 = t.work[5][i];
+        t.out[0][i] = c1 * c2 - s1 * s2 * c;
+        t.out[1][i] = s1 * c2 + c1 * s2 * c;
+        t.out[2][i] = s2 * s;
+        t.out[3][i] = -c1 * s2 - s1 * c2 * c;
+        t.out[4][i] = -s1 * s2 + c1 * c2 * c;
+        t.out[5][i] = c2 * s;
+        t.out[6][i] = s1 * s;
+        t.out[7][i] = -c1 * s;
+        t.out[8][i] = c;
+      }
+      for(int k = 0; k < 9; k++)
+      {
+        T* v = t.out[k];
+        for(size_t i = 0; i < n; i++)
+        {
+          v[i] = (fabs(v[i]) < eps) ? static_cast<T>(0.0) : v[i];
+        }
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Om2Eu
+  {
+    enum { InComps = 9, OutComps = 3 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      int degenerate = 0;
+      for(size_t i = 0; i < n; i++)
+      {
+        T o8 = t.in[8][i];
+        bool pole = (static_cast<T>(1.0E-6) > fabs(fabs(o8) - static_cast<T>(1.0)));
+        degenerate += pole ? 1 : 0;
+        T zeta = pole ? static_cast<T>(0.0) : static_cast<T>(1.0) / sqrt(static_cast<T>(1.0) - o8 * o8);
+        t.out[1][i] = acos(o8);
+        t.out[0][i] = atan2(t.in[6][i] * zeta, -t.in[7][i] * zeta);
+        t.out[2][i] = atan2(t.in[2][i] * zeta, t.in[5][i] * zeta);
+      }
+
+      // Matrices with Phi at 0 or Pi: phi2 is arbitrary and set to zero
+      for(size_t i = 0; degenerate > 0 && i < n; i++)
+      {
+        T o8 = t.in[8][i];
+        if(static_cast<T>(1.0E-6) > fabs(fabs(o8) - static_cast<T>(1.0)))
+        {
+          T o0 = t.in[0][i];
+          T o1 = t.in[1][i];
+          if(static_cast<T>(1.0E-6) > fabs(o8 - static_cast<T>(1.0)))
+          {
+            t.out[0][i] = atan2(o1, o0);
+            t.out[1][i] = 0.0;
+          }
+          else
+          {
+            t.out[0][i] = -atan2(-o1, o0);
+            t.out[1][i] = static_cast<T>(SIMPLib::Constants::k_Pi);
+          }
+          t.out[2][i] = 0.0;
+        }
+      }
+
+      for(size_t i = 0; i < n; i++)
+      {
+        t.out[0][i] = wrapAngle(t.out[0][i], SIMPLib::Constants::k_2Pi);
+        t.out[1][i] = wrapAngle(t.out[1][i], SIMPLib::Constants::k_Pi);
+        t.out[2][i] = wrapAngle(t.out[2][i], SIMPLib::Constants::k_2Pi);
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Qu2Ro
+  {
+    enum { InComps = 4, OutComps = 4 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      const T thr = static_cast<T>(1.0E-8L);
+      const T inf = std::numeric_limits<T>::infinity();
+      for(size_t i = 0; i < n; i++)
+      {
+        T x = t.in[0][i];
+        T y = t.in[1][i];
+        T z = t.in[2][i];
+        T w = t.in[3][i];
+        T s = sqrt(x * x + y * y + z * z);
+        bool halfTurn = (w < thr);
+        bool identity = !halfTurn && (s < thr);
+        T scale = halfTurn ? static_cast<T>(1.0) : (identity ? static_cast<T>(0.0) : static_cast<T>(1.0) / s);
+        // tan(acos(w)) written without the library calls
+        T r = sqrt((static_cast<T>(1.0) - w) * (static_cast<T>(1.0) + w)) / w;
+        t.out[0][i] = x * scale;
+        t.out[1][i] = y * scale;
+        t.out[2][i] = z * scale;
+        t.out[3][i] = halfTurn ? inf : (identity ? static_cast<T>(0.0) : r);
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Ro2Qu
+  {
+    enum { InComps = 4, OutComps = 4 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      const T inf = std::numeric_limits<T>::infinity();
+      const T large = static_cast<T>(1.0E15);
+      for(size_t i = 0; i < n; i++)
+      {
+        T x = t.in[0][i];
+        T y = t.in[1][i];
+        T z = t.in[2][i];
+        T ta = t.in[3][i];
+        bool halfTurn = (ta == inf);
+        bool identity = (ta == 0.0);
+        // The half rotation angle is atan(ta) so its cosine and sine are 1/sqrt(1+ta^2) and ta/sqrt(1+ta^2)
+        T ata = fabs(ta);
+        T c = (ata < large) ? static_cast<T>(1.0) / sqrt(static_cast<T>(1.0) + ta * ta) : static_cast<T>(1.0) / ata;
+        T s = (ata < large) ? ta * c : ((ta < 0.0) ? static_cast<T>(-1.0) : static_cast<T>(1.0));
+        c = halfTurn ? static_cast<T>(SIMPLib::Constants::k_PiOver2 - static_cast<T>(SIMPLib::Constants::k_PiOver2)) : c;
+        s = halfTurn ? static_cast<T>(1.0) : s / sqrt(x * x + y * y + z * z);
+        t.out[0][i] = identity ? static_cast<T>(0.0) : x * s;
+        t.out[1][i] = identity ? static_cast<T>(0.0) : y * s;
+        t.out[2][i] = identity ? static_cast<T>(0.0) : z * s;
+        t.out[3][i] = identity ? static_cast<T>(1.0) : c;
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Qu2Ho
+  {
+    enum { InComps = 4, OutComps = 3 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        T x = t.in[0][i];
+        T y = t.in[1][i];
+        T z = t.in[2][i];
+        T omega = static_cast<T>(2.0 * acos(t.in[3][i]));
+        T f = pow(static_cast<T>(0.75) * (omega - sin(omega)), static_cast<T>(1.0 / 3.0));
+        T s = f / sqrt(x * x + y * y + z * z);
+        s = (omega == 0.0) ? static_cast<T>(0.0) : s;
+        t.out[0][i] = x * s;
+        t.out[1][i] = y * s;
+        t.out[2][i] = z * s;
+      }
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  struct Ho2Qu
+  {
+    enum { InComps = 3, OutComps = 4 };
+
+    static void compute(Tile<T>& t, size_t n)
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        T x = t.in[0][i];
+        T y = t.in[1][i];
+        T z = t.in[2][i];
+        T hmag = x * x + y * y + z * z;
+        T hm = hmag;
+        // Cosine of the half rotation angle from the fit used by OrientationTransforms::ho2ax
+        T s = static_cast<T>(LPs::tfit[0] + LPs::tfit[1] * hmag);
+        for(int k = 2; k < 16; k++)
+        {
+          hm = hm * hmag;
+          s = s + static_cast<T>(LPs::tfit[k]) * hm;
+        }
+        bool identity = (hmag == 0.0) || (s >= 1.0);
+        T scale = sqrt((static_cast<T>(1.0) - s) * (static_cast<T>(1.0) + s)) / sqrt(hmag);
+        t.out[0][i] = identity ? static_cast<T>(0.0) : x * scale;
+        t.out[1][i] = identity ? static_cast<T>(0.0) : y * scale;
+        t.out[2][i] = identity ? static_cast<T>(0.0) : z * scale;
+        t.out[3][i] = identity ? static_cast<T>(1.0) : s;
+      }
+    }
+  };
+
+  /**
+   * @brief The ConvertImpl class runs a conversion kernel over a range of interleaved tuples one tile at a time
+   */
+  template<typename T, typename Kernel>
+  class ConvertImpl
+  {
+      const T* m_Input;
+      int m_InStride;
+      T* m_Output;
+
+    public:
+      ConvertImpl(const T* input, int inStride, T* output) :
+        m_Input(input),
+        m_InStride(inStride),
+        m_Output(output)
+      {}
+      virtual ~ConvertImpl() {}
+
+      void convert(size_t start, size_t end) const
+      {
+        Tile<T> tile;
+        for(size_t first = start; first < end; first += k_TileSize)
+        {
+          size_t n = std::min(k_TileSize, end - first);
+          const T* src = m_Input + first * m_InStride;
+          for(size_t i = 0; i < n; i++)
+          {
+            for(int c = 0; c < Kernel::InComps; c++)
+            {
+              tile.in[c][i] = src[i * m_InStride + c];
+            }
+          }
+
+          Kernel::compute(tile, n);
+
+          T* dst = m_Output + first * Kernel::OutComps;
+          for(size_t i = 0; i < n; i++)
+          {
+            for(int c = 0; c < Kernel::OutComps; c++)
+            {
+              dst[i * Kernel::OutComps + c] = tile.out[c][i];
+            }
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+  };
+}
+
+/**
+ * @brief The OrientationBatchTransforms class converts whole arrays of orientations between
+ * the most commonly used representations. The input is read with the given tuple stride
+ * and the output is written densely packed. Quaternions are in Vector-Scalar order. Results
+ * agree with the per orientation functions in OrientationTransforms to within rounding.
+ */
+template<typename T>
+class OrientationBatchTransforms
+{
+  public:
+    virtual ~OrientationBatchTransforms() {}
+
+    static void eu2qu(const T* eu, int inStride, T* qu, size_t count) { Run<OrientationBatchDetail::Eu2Qu<T> >(eu, inStride, qu, count); }
+    static void qu2eu(const T* qu, int inStride, T* eu, size_t count) { Run<OrientationBatchDetail::Qu2Eu<T> >(qu, inStride, eu, count); }
+    static void eu2om(const T* eu, int inStride, T* om, size_t count) { Run<OrientationBatchDetail::Eu2Om<T> >(eu, inStride, om, count); }
+    static void om2eu(const T* om, int inStride, T* eu, size_t count) { Run<OrientationBatchDetail::Om2Eu<T> >(om, inStride, eu, count); }
+    static void qu2ro(const T* qu, int inStride, T* ro, size_t count) { Run<OrientationBatchDetail::Qu2Ro<T> >(qu, inStride, ro, count); }
+    static void ro2qu(const T* ro, int inStride, T* qu, size_t count) { Run<OrientationBatchDetail::Ro2Qu<T> >(ro, inStride, qu, count); }
+    static void qu2ho(const T* qu, int inStride, T* ho, size_t count) { Run<OrientationBatchDetail::Qu2Ho<T> >(qu, inStride, ho, count); }
+    static void ho2qu(const T* ho, int inStride, T* qu, size_t count) { Run<OrientationBatchDetail::Ho2Qu<T> >(ho, inStride, qu, count); }
+
+  protected:
+    OrientationBatchTransforms() {}
+
+  private:
+    template<typename Kernel>
+    static void Run(const T* input, int inStride, T* output, size_t count)
+    {
+      typedef OrientationBatchDetail::ConvertImpl<T, Kernel> ImplType;
+
+      // Small arrays are not worth waking the worker threads for
+      ImplType impl(input, inStride, output);
+      if (count < OrientationBatchDetail::k_MinParallelTuples)
+      {
+        impl.convert(0, count);
+        return;
+      }
+      ParallelContext::ParallelFor<size_t>(0, count, impl, OrientationBatchDetail::k_TileSize);
+    }
+
+    OrientationBatchTransforms(const OrientationBatchTransforms&); // Copy Constructor Not Implemented
+    void operator=(const OrientationBatchTransforms&); // Operator '=' Not Implemented
+};
+
+#endif /* _OrientationBatchTransforms_H_ */
@@ -49,6 +49,7 @@
 #include "OrientationLib/OrientationLib.h"
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
 
 template<typename T>
 class OrientationConverter
@@ -259,6 +260,17 @@ class OrientationConverter
   }\
   this->setOutputData(output);
 
+/* Same as OC_CONVERT_BODY but for the representation pairs that have a batched kernel
+ * in OrientationBatchTransforms, which converts all the tuples in one call. */
+#define OC_BATCH_CONVERT_BODY(OUTSTRIDE, OUT_ARRAY_NAME, CONVERSION_METHOD)\
+  typename DataArray<T>::Pointer input = this->getInputData();\
+  size_t nTuples = input->getNumberOfTuples();\
+  int inStride = input->getNumberOfComponents();\
+  QVector<size_t> cDims(1, OUTSTRIDE); /* Create the n component (nx1) based array.*/ \
+  typename DataArray<T>::Pointer output = DataArray<T>::CreateArray(nTuples, cDims, #OUT_ARRAY_NAME);\
+  if(nTuples > 0) { OrientationBatchTransforms<T>::CONVERSION_METHOD(input->getPointer(0), inStride, output->getPointer(0), nTuples); }\
+  this->setOutputData(output);
+
 
 
 // -----------------------------------------------------------------------------
@@ -290,13 +302,13 @@ class EulerConverter : public OrientationConverter<T>
     virtual void toOrientationMatrix()
     {
       sanityCheckInputData();
-      OC_CONVERT_BODY(9, OrientationMatrix, eu2om)
+      OC_BATCH_CONVERT_BODY(9, OrientationMatrix, eu2om)
     }
 
     virtual void toQuaternion()
     {
       sanityCheckInputData();
-      OC_CONVERT_BODY(4, Quaternions, eu2qu)
+      OC_BATCH_CONVERT_BODY(4, Quaternions, eu2qu)
     }
 
     virtual void toAxisAngle()
@@ -398,7 +410,7 @@ class OrientationMatrixConverter : public OrientationConverter<T>
     virtual void toEulers()
     {
       sanityCheckInputData();
-      OC_CONVERT_BODY(3, Eulers, om2eu)
+      OC_BATCH_CONVERT_BODY(3, Eulers, om2eu)
     }
 
     virtual void toOrientationMatrix()
@@ -520,7 +532,7 @@ class QuaternionConverter : public OrientationConverter<T>
 
     virtual void toEulers()
     {
-      OC_CONVERT_BODY(3, Eulers, qu2eu)
+      OC_BATCH_CONVERT_BODY(3, Eulers, qu2eu)
     }
 
     virtual void toOrientationMatrix()
@@ -543,12 +555,12 @@ class QuaternionConverter : public OrientationConverter<T>
 
     virtual void toRodrigues()
     {
-      OC_CONVERT_BODY(4, Rodrigues, qu2ro)
+      OC_BATCH_CONVERT_BODY(4, Rodrigues, qu2ro)
     }
 
     virtual void toHomochoric()
     {
-      OC_CONVERT_BODY(3, Homochoric, qu2ho)
+      OC_BATCH_CONVERT_BODY(3, Homochoric, qu2ho)
     }
 
     virtual void toCubochoric()
@@ -725,7 +737,7 @@ class RodriguesConverter : public OrientationConverter<T>
 
     virtual void toQuaternion()
     {
-      OC_CONVERT_BODY(4, Quaternions, ro2qu)
+      OC_BATCH_CONVERT_BODY(4, Quaternions, ro2qu)
     }
 
     virtual void toAxisAngle()
@@ -820,7 +832,7 @@ class HomochoricConverter : public OrientationConverter<T>
 
     virtual void toQuaternion()
     {
-      OC_CONVERT_BODY(4, Quaternions, ho2qu)
+      OC_BATCH_CONVERT_BODY(4, Quaternions, ho2qu)
     }
 
     virtual void toAxisAngle()
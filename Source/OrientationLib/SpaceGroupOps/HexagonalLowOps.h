@@ -86,7 +86,7 @@ class OrientationLib_EXPORT HexagonalLowOps : public SpaceGroupOps
     virtual int getMisoBin(FOrientArrayType rod);
     virtual bool inUnitTriangle(float eta, float chi);
     virtual FOrientArrayType determineEulerAngles(uint64_t seed, int choose);
-    virtual FOrientArrayType randomizeEulerAngles(FOrientArrayType euler);
+    virtual FOrientArrayType randomizeEulerAngles(FOrientArrayType euler, uint64_t seed);
     virtual FOrientArrayType determineRodriguesVector(uint64_t seed, int choose);
     virtual int getOdfBin(FOrientArrayType rod);
     virtual void getSchmidFactorAndSS(float load[3], float& schmidfactor, float angleComps[2], int& slipsys);
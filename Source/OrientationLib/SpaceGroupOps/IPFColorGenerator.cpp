@@ -0,0 +1,373 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "IPFColorGenerator.h"
+
+#include <math.h>
+
+#include <vector>
+
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/MatrixMath.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#if !defined(DREAM3D_PASSIVE_ROTATION) && !defined(DREAM3D_ACTIVE_ROTATION)
+#error "OrientationTransforms.hpp must define either DREAM3D_PASSIVE_ROTATION or DREAM3D_ACTIVE_ROTATION"
+#endif
+
+namespace Detail
+{
+  namespace IPFColor
+  {
+    /**
+     * @brief The FixedChiTriangle class describes the standard triangles of the non cubic Laue classes,
+     * which span a fixed range of eta and chi from 0 to 90 degrees
+     */
+    template<int EtaMinDeg, int EtaMaxDeg>
+    class FixedChiTriangle
+    {
+      public:
+        static bool etaInRange(float eta)
+        {
+          return !(eta < (EtaMinDeg * SIMPLib::Constants::k_PiOver180) || eta > (EtaMaxDeg * SIMPLib::Constants::k_PiOver180));
+        }
+
+        static bool chiInRange(float eta, float chi)
+        {
+          return !(chi < 0 || chi > (90.0 * SIMPLib::Constants::k_PiOver180));
+        }
+
+        static void color(float eta, float chi, float _rgb[3])
+        {
+          float etaMin = EtaMinDeg;
+          float etaMax = EtaMaxDeg;
+          float chiMax = 90.0;
+          float etaDeg = eta * SIMPLib::Constants::k_180OverPi;
+          float chiDeg = chi * SIMPLib::Constants::k_180OverPi;
+
+          _rgb[0] = 1.0 - chiDeg / chiMax;
+          _rgb[2] = fabs(etaDeg - etaMin) / (etaMax - etaMin);
+          _rgb[1] = 1 - _rgb[2];
+          _rgb[1] *= chiDeg / chiMax;
+          _rgb[2] *= chiDeg / chiMax;
+        }
+    };
+
+    /**
+     * @brief The CubicTriangle class describes the standard triangles of the cubic Laue classes, whose
+     * chi limit depends on eta
+     */
+    template<int EtaMaxDeg>
+    class CubicTriangle
+    {
+      public:
+        static float chiMax(float eta)
+        {
+          float etaDeg = eta * SIMPLib::Constants::k_180OverPi;
+          float chiMax;
+          if(etaDeg > 45.0)
+          {
+            chiMax = sqrt(1.0 / (2.0 + tanf(0.5 * SIMPLib::Constants::k_Pi - eta) * tanf(0.5 * SIMPLib::Constants::k_Pi - eta)));
+          }
+          else
+          {
+            chiMax = sqrt(1.0 / (2.0 + tanf(eta) * tanf(eta)));
+          }
+          SIMPLibMath::boundF(chiMax, -1.0f, 1.0f);
+          chiMax = acos(chiMax);
+          return chiMax;
+        }
+
+        static bool etaInRange(float eta)
+        {
+          return !(eta < 0.0 || eta > (EtaMaxDeg * SIMPLib::Constants::k_PiOver180));
+        }
+
+        static bool chiInRange(float eta, float chi)
+        {
+          return !(chi < 0.0 || chi > chiMax(eta));
+        }
+
+        static void color(float eta, float chi, float _rgb[3])
+        {
+          float etaMin = 0.0;
+          float etaMax = EtaMaxDeg;
+          float etaDeg = eta * SIMPLib::Constants::k_180OverPi;
+          float chiMaxValue = chiMax(eta);
+
+          _rgb[0] = 1.0 - chi / chiMaxValue;
+          _rgb[2] = fabs(etaDeg - etaMin) / (etaMax - etaMin);
+          _rgb[1] = 1 - _rgb[2];
+          _rgb[1] *= chi / chiMaxValue;
+          _rgb[2] *= chi / chiMaxValue;
+        }
+    };
+
+    /**
+     * @brief The EulerInput class reads Euler angles and converts them to an orientation matrix
+     */
+    class EulerInput
+    {
+      public:
+        static const size_t Stride = 3;
+
+        static void toMatrix(const float* eulers, float* om)
+        {
+          float eu[3] = { eulers[0], eulers[1], eulers[2] };
+          float qu[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+          FOrientArrayType euWrap(eu, 3);
+          FOrientArrayType quWrap(qu, 4);
+          FOrientArrayType omWrap(om, 9);
+          OrientationTransforms<FOrientArrayType, float>::eu2qu(euWrap, quWrap);
+          OrientationTransforms<FOrientArrayType, float>::qu2om(quWrap, omWrap);
+        }
+    };
+
+    /**
+     * @brief The QuatInput class reads <x, y, z, w> quaternions and converts them to an orientation matrix
+     */
+    class QuatInput
+    {
+      public:
+        static const size_t Stride = 4;
+
+        static void toMatrix(const float* quats, float* om)
+        {
+          float qu[4] = { quats[0], quats[1], quats[2], quats[3] };
+          FOrientArrayType quWrap(qu, 4);
+          FOrientArrayType omWrap(om, 9);
+          OrientationTransforms<FOrientArrayType, float>::qu2om(quWrap, omWrap);
+        }
+    };
+
+    /**
+     * @brief colorOrientations Computes the IPF colors of a run of orientations. With passive rotations the
+     * orientation matrix of a symmetric equivalent S * q is om(S) * om(q), so the sample direction is rotated
+     * into the crystal frame once and each symmetry operator then only costs a matrix-vector product. With
+     * active rotations qu2om() returns the transpose and the product is om(q) * om(S) instead, so the sample
+     * direction is rotated by every operator once per run and each orientation is applied to those directions.
+     */
+    template<typename Triangle, typename Input>
+    void colorOrientations(const float (*symMatrices)[9], int numSymOps, bool hasInversion,
+                           const float* orientations, const float* refDir, uint8_t* rgb, size_t count)
+    {
+      float om[9];
+      float v[3];
+      float p[3];
+      float _rgb[3];
+#if !DREAM3D_PASSIVE_ROTATION
+      float r[3] = { refDir[0], refDir[1], refDir[2] };
+      MatrixMath::Normalize3x1(r);
+      std::vector<float> symDirs(3 * numSymOps, 0.0f);
+      for (int j = 0; j < numSymOps; j++)
+      {
+        const float* g = symMatrices[j];
+        symDirs[3 * j] = g[0] * r[0] + g[1] * r[1] + g[2] * r[2];
+        symDirs[3 * j + 1] = g[3] * r[0] + g[4] * r[1] + g[5] * r[2];
+        symDirs[3 * j + 2] = g[6] * r[0] + g[7] * r[1] + g[8] * r[2];
+      }
+#endif
+      for (size_t i = 0; i < count; i++)
+      {
+        Input::toMatrix(orientations + i * Input::Stride, om);
+#if DREAM3D_PASSIVE_ROTATION
+        v[0] = om[0] * refDir[0] + om[1] * refDir[1] + om[2] * refDir[2];
+        v[1] = om[3] * refDir[0] + om[4] * refDir[1] + om[5] * refDir[2];
+        v[2] = om[6] * refDir[0] + om[7] * refDir[1] + om[8] * refDir[2];
+        MatrixMath::Normalize3x1(v);
+#endif
+
+        float eta = 0.0f, chi = 0.0f;
+        float lastZ = 0.0f;
+        bool found = false;
+        for (int j = 0; j < numSymOps; j++)
+        {
+#if DREAM3D_PASSIVE_ROTATION
+          const float* g = symMatrices[j];
+#else
+          const float* g = om;
+          v[0] = symDirs[3 * j];
+          v[1] = symDirs[3 * j + 1];
+          v[2] = symDirs[3 * j + 2];
+#endif
+          p[0] = g[0] * v[0] + g[1] * v[1] + g[2] * v[2];
+          p[1] = g[3] * v[0] + g[4] * v[1] + g[5] * v[2];
+          p[2] = g[6] * v[0] + g[7] * v[1] + g[8] * v[2];
+          if (p[2] < 0)
+          {
+            if (hasInversion == false) { continue; }
+            p[0] = -p[0], p[1] = -p[1], p[2] = -p[2];
+          }
+          // atan2 alone rejects most of the symmetric variants, acos is only needed for the rest
+          eta = atan2(p[1], p[0]);
+          lastZ = p[2];
+          if (Triangle::etaInRange(eta) == false) { continue; }
+          chi = acos(p[2]);
+          if (Triangle::chiInRange(eta, chi) == true)
+          {
+            found = true;
+            break;
+          }
+        }
+        if (found == false)
+        {
+          // Same fall back as the scalar code, which colors the last symmetric variant it looked at
+          chi = acos(lastZ);
+        }
+
+        Triangle::color(eta, chi, _rgb);
+        _rgb[0] = sqrt(_rgb[0]);
+        _rgb[1] = sqrt(_rgb[1]);
+        _rgb[2] = sqrt(_rgb[2]);
+
+        float max = _rgb[0];
+        if (_rgb[1] > max) { max = _rgb[1]; }
+        if (_rgb[2] > max) { max = _rgb[2]; }
+
+        rgb[i * 3] = static_cast<uint8_t>(static_cast<int>(_rgb[0] / max * 255) & 0xff);
+        rgb[i * 3 + 1] = static_cast<uint8_t>(static_cast<int>(_rgb[1] / max * 255) & 0xff);
+        rgb[i * 3 + 2] = static_cast<uint8_t>(static_cast<int>(_rgb[2] / max * 255) & 0xff);
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorGenerator::IPFColorGenerator()
+{
+  QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+  for (uint32_t laue = 0; laue < Ebsd::CrystalStructure::LaueGroupEnd; laue++)
+  {
+    m_NumSymOps[laue] = ops[laue]->getNumSymOps();
+    m_HasInversion[laue] = ops[laue]->getHasInversion();
+    for (int j = 0; j < m_NumSymOps[laue]; j++)
+    {
+      QuatF q;
+      ops[laue]->getQuatSymOp(j, q);
+      float qu[4] = { q.x, q.y, q.z, q.w };
+      FOrientArrayType quWrap(qu, 4);
+      FOrientArrayType omWrap(m_SymMatrices[laue][j], 9);
+      OrientationTransforms<FOrientArrayType, float>::qu2om(quWrap, omWrap);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IPFColorGenerator::~IPFColorGenerator()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename Input>
+void IPFColorGenerator::dispatch(uint32_t laueClass, const float* orientations, const float* refDir, uint8_t* rgb, size_t count) const
+{
+  using namespace Detail::IPFColor;
+  if (laueClass >= Ebsd::CrystalStructure::LaueGroupEnd) { return; }
+  const float (*symMatrices)[9] = m_SymMatrices[laueClass];
+  int numSymOps = m_NumSymOps[laueClass];
+  bool hasInversion = m_HasInversion[laueClass];
+  switch(laueClass)
+  {
+    case Ebsd::CrystalStructure::Hexagonal_High:
+      colorOrientations<FixedChiTriangle<0, 30>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Cubic_High:
+      colorOrientations<CubicTriangle<45>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Hexagonal_Low:
+      colorOrientations<FixedChiTriangle<0, 60>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Cubic_Low:
+      colorOrientations<CubicTriangle<90>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Triclinic:
+      colorOrientations<FixedChiTriangle<0, 180>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Monoclinic:
+      colorOrientations<FixedChiTriangle<0, 180>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::OrthoRhombic:
+      colorOrientations<FixedChiTriangle<0, 90>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Tetragonal_Low:
+      colorOrientations<FixedChiTriangle<0, 90>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Tetragonal_High:
+      colorOrientations<FixedChiTriangle<0, 45>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Trigonal_Low:
+      colorOrientations<FixedChiTriangle<-120, 0>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    case Ebsd::CrystalStructure::Trigonal_High:
+      colorOrientations<FixedChiTriangle<-90, -30>, Input>(symMatrices, numSymOps, hasInversion, orientations, refDir, rgb, count);
+      break;
+    default:
+      break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IPFColorGenerator::generateIPFColors(uint32_t laueClass, const float* eulers, const float* refDir, uint8_t* rgb, size_t count) const
+{
+  dispatch<Detail::IPFColor::EulerInput>(laueClass, eulers, refDir, rgb, count);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IPFColorGenerator::generateIPFColorsFromQuats(uint32_t laueClass, const float* quats, const float* refDir, uint8_t* rgb, size_t count) const
+{
+  dispatch<Detail::IPFColor::QuatInput>(laueClass, quats, refDir, rgb, count);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void IPFColorGenerator::generateIPFColor(uint32_t laueClass, const float* euler, const float* refDir, uint8_t* rgb) const
+{
+  dispatch<Detail::IPFColor::EulerInput>(laueClass, euler, refDir, rgb, 1);
+}
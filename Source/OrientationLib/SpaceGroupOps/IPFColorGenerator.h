@@ -0,0 +1,113 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _IPFColorGenerator_H_
+#define _IPFColorGenerator_H_
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+#include "OrientationLib/OrientationLib.h"
+
+/**
+ * @class IPFColorGenerator IPFColorGenerator.h OrientationLib/SpaceGroupOps/IPFColorGenerator.h
+ * @brief This class computes inverse pole figure colors for batches of orientations. The symmetry
+ * operators of every Laue class are converted to rotation matrices once, when the generator is created,
+ * and the search for the standard triangle and the coloring are compiled separately for each Laue class
+ * so no virtual calls or quaternion products happen per orientation. The colors match those of
+ * SpaceGroupOps::generateIPFColor() except for orientations that sit within rounding error of a
+ * standard triangle edge. A generator is read only after construction and may be shared between threads.
+ */
+class OrientationLib_EXPORT IPFColorGenerator
+{
+  public:
+    SIMPL_SHARED_POINTERS(IPFColorGenerator)
+    SIMPL_STATIC_NEW_MACRO(IPFColorGenerator)
+    SIMPL_TYPE_MACRO(IPFColorGenerator)
+
+    virtual ~IPFColorGenerator();
+
+    /**
+     * @brief generateIPFColors Computes the IPF colors of a run of orientations that share a Laue class
+     * and a reference direction
+     * @param laueClass The Ebsd::CrystalStructure value of the orientations
+     * @param eulers Euler angles in radians, 3 values per orientation
+     * @param refDir The sample reference direction
+     * @param rgb [output] 3 color values per orientation
+     * @param count The number of orientations
+     */
+    void generateIPFColors(uint32_t laueClass, const float* eulers, const float* refDir, uint8_t* rgb, size_t count) const;
+
+    /**
+     * @brief generateIPFColorsFromQuats Computes the IPF colors of a run of orientations that share a Laue class
+     * and a reference direction
+     * @param laueClass The Ebsd::CrystalStructure value of the orientations
+     * @param quats Quaternions stored as <x, y, z, w>, 4 values per orientation
+     * @param refDir The sample reference direction
+     * @param rgb [output] 3 color values per orientation
+     * @param count The number of orientations
+     */
+    void generateIPFColorsFromQuats(uint32_t laueClass, const float* quats, const float* refDir, uint8_t* rgb, size_t count) const;
+
+    /**
+     * @brief generateIPFColor Computes the IPF color of a single orientation
+     * @param laueClass The Ebsd::CrystalStructure value of the orientation
+     * @param euler Euler angles in radians
+     * @param refDir The sample reference direction
+     * @param rgb [output] The 3 color values
+     */
+    void generateIPFColor(uint32_t laueClass, const float* euler, const float* refDir, uint8_t* rgb) const;
+
+  protected:
+    IPFColorGenerator();
+
+  private:
+    static const int k_MaxSymOps = 24;
+
+    float m_SymMatrices[Ebsd::CrystalStructure::LaueGroupEnd][k_MaxSymOps][9];
+    int m_NumSymOps[Ebsd::CrystalStructure::LaueGroupEnd];
+    bool m_HasInversion[Ebsd::CrystalStructure::LaueGroupEnd];
+
+    template<typename Input>
+    void dispatch(uint32_t laueClass, const float* orientations, const float* refDir, uint8_t* rgb, size_t count) const;
+
+    IPFColorGenerator(const IPFColorGenerator&); // Copy Constructor Not Implemented
+    void operator=(const IPFColorGenerator&); // Operator '=' Not Implemented
+};
+
+#endif /* _IPFColorGenerator_H_ */
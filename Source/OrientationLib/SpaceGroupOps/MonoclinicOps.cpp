@@ -40,7 +40,6 @@
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #include <tbb/task_group.h>
 #include <tbb/task.h>
 #endif
@@ -49,6 +48,7 @@
 // to expose some of the constants needed below
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
@@ -312,11 +312,11 @@ FOrientArrayType MonoclinicOps::determineEulerAngles(uint64_t seed, int choose)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FOrientArrayType MonoclinicOps::randomizeEulerAngles(FOrientArrayType synea)
+FOrientArrayType MonoclinicOps::randomizeEulerAngles(FOrientArrayType synea, uint64_t seed)
 {
   QuatF q;
   QuatF qc;
-  size_t symOp = getRandomSymmetryOperatorIndex(k_NumSymQuats);
+  size_t symOp = getRandomSymmetryOperatorIndex(k_NumSymQuats, seed);
 
   FOrientArrayType quat(4, 0.0f);
   OrientationTransforms<FOrientArrayType, float>::eu2qu(synea, quat);
@@ -559,8 +559,8 @@ void MonoclinicOps::generateSphereCoordsFromEulers(FloatArrayType* eulers, Float
 
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
@@ -748,8 +748,8 @@ QVector<UInt8ArrayType::Pointer> MonoclinicOps::generatePoleFigure(PoleFigureCon
   DoubleArrayType::Pointer intensity011 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label1 + "_Intensity_Image");
   DoubleArrayType::Pointer intensity111 = DoubleArrayType::CreateArray(config.imageDim * config.imageDim, label2 + "_Intensity_Image");
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
   tbb::task_group* g = new tbb::task_group;
 
   if(doParallel == true)
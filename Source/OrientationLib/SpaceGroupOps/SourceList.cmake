@@ -49,6 +49,7 @@ set(OrientationLib_SpaceGroupOps_HDRS
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/TriclinicOps.h
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/MonoclinicOps.h
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/SO3Sampler.h
+  ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/IPFColorGenerator.h
 )
 set(OrientationLib_SpaceGroupOps_SRCS
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/SpaceGroupOps.cpp
@@ -64,6 +65,7 @@ set(OrientationLib_SpaceGroupOps_SRCS
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/TriclinicOps.cpp
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/MonoclinicOps.cpp
   ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/SO3Sampler.cpp
+  ${OrientationLib_SOURCE_DIR}/SpaceGroupOps/IPFColorGenerator.cpp
 )
 cmp_IDE_SOURCE_PROPERTIES( "SpaceGroupOps" "${OrientationLib_SpaceGroupOps_HDRS}" "${OrientationLib_SpaceGroupOps_SRCS}" "0")
 if( ${PROJECT_INSTALL_HEADERS} EQUAL 1 )
@@ -42,8 +42,6 @@
 #include <boost/random/uniform_int.hpp>
 #include <boost/random/variate_generator.hpp>
 
-#include <QtCore/QDateTime>
-
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/ColorTable.h"
 
@@ -419,8 +417,14 @@ std::vector<SpaceGroupOps::Pointer> SpaceGroupOps::getOrientationOpsVector()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-size_t SpaceGroupOps::getRandomSymmetryOperatorIndex(int numSymOps)
+size_t SpaceGroupOps::getRandomSymmetryOperatorIndex(int numSymOps, uint64_t seed)
 {
+  // determineEulerAngles is usually called with the same seed, so scramble it first to keep
+  // the symmetry operator independent of the sampled orientation
+  seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+  seed = seed ^ (seed >> 31);
+
   const int rangeMin = 0;
   const int rangeMax = numSymOps-1;
   typedef boost::uniform_int<int> NumberDistribution;
@@ -430,7 +434,7 @@ size_t SpaceGroupOps::getRandomSymmetryOperatorIndex(int numSymOps)
   NumberDistribution distribution(rangeMin, rangeMax);
   RandomNumberGenerator generator;
   Generator numberGenerator(generator, distribution);
-  generator.seed(static_cast<boost::uint32_t>( QDateTime::currentMSecsSinceEpoch() )); // seed with the current time
+  generator.seed(static_cast<boost::uint32_t>(seed ^ (seed >> 32)));
   size_t symOp = numberGenerator(); // Random remaining position.
   return symOp;
 }
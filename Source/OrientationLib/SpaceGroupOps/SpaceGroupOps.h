@@ -138,8 +138,23 @@ class OrientationLib_EXPORT SpaceGroupOps
     virtual int getMisoBin(FOrientArrayType rod) = 0;
     virtual bool inUnitTriangle(float eta, float chi) = 0;
     virtual FOrientArrayType determineEulerAngles(uint64_t seed, int choose) = 0;
-    virtual FOrientArrayType randomizeEulerAngles(FOrientArrayType euler) = 0;
-    virtual size_t getRandomSymmetryOperatorIndex(int numSymOps);
+
+    /**
+     * @brief randomizeEulerAngles Applies a randomly chosen symmetry operator to the Euler angles
+     * @param euler The Euler angles to randomize
+     * @param seed Seed of the symmetry operator draw; the same seed always picks the same operator
+     * @return The symmetrically equivalent Euler angles
+     */
+    virtual FOrientArrayType randomizeEulerAngles(FOrientArrayType euler, uint64_t seed) = 0;
+
+    /**
+     * @brief getRandomSymmetryOperatorIndex Draws the index of a symmetry operator
+     * @param numSymOps The number of symmetry operators to choose from
+     * @param seed Seed of the draw
+     * @return An index in [0, numSymOps)
+     */
+    virtual size_t getRandomSymmetryOperatorIndex(int numSymOps, uint64_t seed);
+
     virtual FOrientArrayType determineRodriguesVector(uint64_t seed, int choose) = 0;
     virtual int getOdfBin(FOrientArrayType rod) = 0;
     virtual void getSchmidFactorAndSS(float load[3], float& schmidfactor, float angleComps[2], int& slipsys) = 0;
@@ -0,0 +1,94 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _BatchTestOrientations_H_
+#define _BatchTestOrientations_H_
+
+#include <math.h>
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+
+/**
+ * @brief The TestOrientations struct holds the same orientations in each of the representations
+ * that have a batched conversion. Every 50th orientation is a degenerate one (identity, half turn
+ * or a rotation about Z) so the special cases of every kernel are covered.
+ */
+template<typename T>
+struct TestOrientations
+{
+  std::vector<T> eu;
+  std::vector<T> om;
+  std::vector<T> qu;
+  std::vector<T> ro;
+  std::vector<T> ho;
+
+  explicit TestOrientations(size_t count) :
+    eu(3 * count), om(9 * count), qu(4 * count), ro(4 * count), ho(3 * count)
+  {
+    SIMPLibRandom rg;
+    rg.init_genrand(5489UL);
+    for(size_t i = 0; i < count; i++)
+    {
+      double q[4] = { 0.0, 0.0, 0.0, 0.0 };
+      for(int k = 0; k < 4; k++) { q[k] = 2.0 * rg.genrand_res53() - 1.0; }
+      switch(i % 50)
+      {
+        case 1: q[0] = 0.0; q[1] = 0.0; break; // rotation about Z
+        case 2: q[2] = 0.0; q[3] = 0.0; break; // Phi of 180 degrees
+        case 3: q[0] = 0.0; q[1] = 0.0; q[2] = 0.0; break; // identity
+        case 4: q[3] = 0.0; break; // half turn
+        default: break;
+      }
+      double norm = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+      if(q[3] < 0.0) { norm = -norm; }
+      for(int k = 0; k < 4; k++) { qu[4 * i + k] = static_cast<T>(q[k] / norm); }
+
+      DOrientArrayType dq(qu[4 * i], qu[4 * i + 1], qu[4 * i + 2], qu[4 * i + 3]);
+      DOrientArrayType de(3), dom(9), dro(4), dho(3);
+      OrientationTransforms<DOrientArrayType, double>::qu2eu(dq, de);
+      OrientationTransforms<DOrientArrayType, double>::eu2om(de, dom);
+      OrientationTransforms<DOrientArrayType, double>::qu2ro(dq, dro);
+      OrientationTransforms<DOrientArrayType, double>::qu2ho(dq, dho);
+      for(int k = 0; k < 3; k++) { eu[3 * i + k] = static_cast<T>(de[k]); ho[3 * i + k] = static_cast<T>(dho[k]); }
+      for(int k = 0; k < 9; k++) { om[9 * i + k] = static_cast<T>(dom[k]); }
+      for(int k = 0; k < 4; k++) { ro[4 * i + k] = static_cast<T>(dro[k]); }
+    }
+  }
+};
+
+#endif /* _BatchTestOrientations_H_ */
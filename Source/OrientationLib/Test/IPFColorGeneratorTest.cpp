@@ -0,0 +1,155 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/SpaceGroupOps/IPFColorGenerator.h"
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+namespace
+{
+  const size_t k_NumOrientations = 20000;
+
+  /**
+   * @brief The TestOrientations struct holds random orientations as Euler angles and as the quaternions
+   * that the Euler angles convert to, so both inputs describe exactly the same rotation matrices
+   */
+  struct TestOrientations
+  {
+    std::vector<float> eu;
+    std::vector<float> qu;
+
+    explicit TestOrientations(size_t count) :
+      eu(3 * count), qu(4 * count)
+    {
+      SIMPLibRandom rg;
+      rg.init_genrand(5489UL);
+      for (size_t i = 0; i < count; i++)
+      {
+        double q[4] = { 0.0, 0.0, 0.0, 0.0 };
+        for (int k = 0; k < 4; k++) { q[k] = 2.0 * rg.genrand_res53() - 1.0; }
+        double norm = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        if (q[3] < 0.0) { norm = -norm; }
+        DOrientArrayType dq(q[0] / norm, q[1] / norm, q[2] / norm, q[3] / norm);
+        DOrientArrayType de(3);
+        OrientationTransforms<DOrientArrayType, double>::qu2eu(dq, de);
+        for (int k = 0; k < 3; k++) { eu[3 * i + k] = static_cast<float>(de[k]); }
+
+        FOrientArrayType fe(&(eu[3 * i]), 3);
+        FOrientArrayType fq(&(qu[4 * i]), 4);
+        OrientationTransforms<FOrientArrayType, float>::eu2qu(fe, fq);
+      }
+    }
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestGeneratorMatchesSpaceGroupOps()
+{
+  TestOrientations orientations(k_NumOrientations);
+  QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+  IPFColorGenerator::Pointer generator = IPFColorGenerator::New();
+
+  float refDirs[4][3] = { { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.3f, -0.5f, 0.81f } };
+  for (int r = 0; r < 4; r++)
+  {
+    MatrixMath::Normalize3x1(refDirs[r]);
+  }
+  std::vector<uint8_t> rgb(3 * k_NumOrientations, 0);
+  std::vector<uint8_t> quatRgb(3 * k_NumOrientations, 0);
+
+  for (uint32_t laue = 0; laue < Ebsd::CrystalStructure::LaueGroupEnd; laue++)
+  {
+    for (int r = 0; r < 4; r++)
+    {
+      double refDir[3] = { refDirs[r][0], refDirs[r][1], refDirs[r][2] };
+
+      generator->generateIPFColors(laue, &(orientations.eu.front()), refDirs[r], &(rgb.front()), k_NumOrientations);
+      generator->generateIPFColorsFromQuats(laue, &(orientations.qu.front()), refDirs[r], &(quatRgb.front()), k_NumOrientations);
+
+      // Orientations within rounding error of a standard triangle edge may pick another symmetric
+      // variant than the scalar code, which moves a channel by at most one step
+      size_t numDiffering = 0;
+      for (size_t i = 0; i < k_NumOrientations; i++)
+      {
+        double eulers[3] = { orientations.eu[3 * i], orientations.eu[3 * i + 1], orientations.eu[3 * i + 2] };
+        DREAM3D::Rgb argb = ops[laue]->generateIPFColor(eulers, refDir, false);
+        int expected[3] = { RgbColor::dRed(argb), RgbColor::dGreen(argb), RgbColor::dBlue(argb) };
+        bool differs = false;
+        for (int k = 0; k < 3; k++)
+        {
+          int diff = abs(expected[k] - static_cast<int>(rgb[3 * i + k]));
+          DREAM3D_REQUIRED(diff, <=, 1)
+          if (diff != 0) { differs = true; }
+          DREAM3D_REQUIRE_EQUAL(quatRgb[3 * i + k], rgb[3 * i + k])
+        }
+        if (differs == true) { numDiffering++; }
+
+        uint8_t single[3] = { 0, 0, 0 };
+        generator->generateIPFColor(laue, &(orientations.eu[3 * i]), refDirs[r], single);
+        DREAM3D_REQUIRE_EQUAL(single[0], rgb[3 * i])
+        DREAM3D_REQUIRE_EQUAL(single[1], rgb[3 * i + 1])
+        DREAM3D_REQUIRE_EQUAL(single[2], rgb[3 * i + 2])
+      }
+      DREAM3D_REQUIRED(numDiffering, <=, k_NumOrientations / 1000)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestGeneratorMatchesSpaceGroupOps() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
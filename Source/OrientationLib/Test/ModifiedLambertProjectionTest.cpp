@@ -0,0 +1,230 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/Utilities/ModifiedLambertProjection.h"
+
+namespace
+{
+  // Enough points for CreateProjectionFromXYZCoords to bin them in several chunks
+  const size_t k_NumPoints = 200000;
+  const int k_LambertDim = 64;
+  // Not a multiple of the tile size so the last row and column of tiles are partial
+  const int k_ImageDim = 150;
+
+  /**
+   * @brief CreateSphereCoords Returns random points on the unit sphere
+   */
+  FloatArrayType::Pointer CreateSphereCoords(size_t count)
+  {
+    QVector<size_t> cDims(1, 3);
+    FloatArrayType::Pointer coords = FloatArrayType::CreateArray(count, cDims, "Sphere_Coords");
+    SIMPLibRandom rg;
+    rg.init_genrand(5489UL);
+    size_t i = 0;
+    while (i < count)
+    {
+      float xyz[3];
+      for (int k = 0; k < 3; k++) { xyz[k] = static_cast<float>(2.0 * rg.genrand_res53() - 1.0); }
+      float lengthSq = xyz[0] * xyz[0] + xyz[1] * xyz[1] + xyz[2] * xyz[2];
+      if (lengthSq > 1.0f || lengthSq < 1.0e-4f) { continue; }
+      MatrixMath::Normalize3x1(xyz);
+      coords->setComponent(i, 0, xyz[0]);
+      coords->setComponent(i, 1, xyz[1]);
+      coords->setComponent(i, 2, xyz[2]);
+      i++;
+    }
+    return coords;
+  }
+
+  /**
+   * @brief SerialProjection Bins every point into a single pair of squares, one after the other
+   */
+  ModifiedLambertProjection::Pointer SerialProjection(FloatArrayType* coords, int dimension, float sphereRadius)
+  {
+    ModifiedLambertProjection::Pointer lambert = ModifiedLambertProjection::New();
+    lambert->initializeSquares(dimension, sphereRadius);
+    float sqCoord[2];
+    for (size_t i = 0; i < coords->getNumberOfTuples(); i++)
+    {
+      sqCoord[0] = 0.0f;
+      sqCoord[1] = 0.0f;
+      if (lambert->getSquareCoord(coords->getPointer(i * 3), sqCoord) == true)
+      {
+        lambert->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+      }
+      else
+      {
+        lambert->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+      }
+    }
+    return lambert;
+  }
+
+  /**
+   * @brief SerialStereographicProjection Fills the stereographic image one pixel after the other
+   */
+  std::vector<double> SerialStereographicProjection(ModifiedLambertProjection* lambert, int dim)
+  {
+    std::vector<double> intensity(static_cast<size_t>(dim) * dim, 0.0);
+    int halfDim = dim / 2;
+    float res = 2.0f / static_cast<float>(dim);
+    float sqCoord[2];
+    float xyz[3];
+    for (int y = 0; y < dim; y++)
+    {
+      for (int x = 0; x < dim; x++)
+      {
+        float xtmp = float(x - halfDim) * res + (res * 0.5);
+        float ytmp = float(y - halfDim) * res + (res * 0.5);
+        size_t index = static_cast<size_t>(y) * dim + x;
+        if ((xtmp * xtmp + ytmp * ytmp) <= 1.0)
+        {
+          xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
+          xyz[0] = xtmp * (1 + xyz[2]);
+          xyz[1] = ytmp * (1 + xyz[2]);
+          for (int m = 0; m < 2; m++)
+          {
+            if (m == 1) { MatrixMath::Multiply3x1withConstant(xyz, -1.0); }
+            if (lambert->getSquareCoord(xyz, sqCoord) == true)
+            {
+              intensity[index] += lambert->getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
+            }
+            else
+            {
+              intensity[index] += lambert->getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
+            }
+          }
+          intensity[index] = intensity[index] * 0.5;
+        }
+      }
+    }
+    return intensity;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The chunked squares must match binning every point serially up to the order the
+// values were summed in, and must not depend on the number of threads
+// -----------------------------------------------------------------------------
+void TestLambertSquaresMatchSerial()
+{
+  FloatArrayType::Pointer coords = CreateSphereCoords(k_NumPoints);
+  ModifiedLambertProjection::Pointer serial = SerialProjection(coords.get(), k_LambertDim, 1.0f);
+
+  ParallelContext::SetNumberOfThreads(1);
+  ModifiedLambertProjection::Pointer oneThread = ModifiedLambertProjection::CreateProjectionFromXYZCoords(coords.get(), k_LambertDim, 1.0f);
+  ParallelContext::SetNumberOfThreads(4);
+  ModifiedLambertProjection::Pointer fourThreads = ModifiedLambertProjection::CreateProjectionFromXYZCoords(coords.get(), k_LambertDim, 1.0f);
+  ParallelContext::SetNumberOfThreads(0);
+
+  DoubleArrayType::Pointer squares[3][2] =
+  {
+    { serial->getNorthSquare(), serial->getSouthSquare() },
+    { oneThread->getNorthSquare(), oneThread->getSouthSquare() },
+    { fourThreads->getNorthSquare(), fourThreads->getSouthSquare() }
+  };
+  double total = 0.0;
+  for (int s = 0; s < 2; s++)
+  {
+    size_t numBins = squares[0][s]->getNumberOfTuples();
+    DREAM3D_REQUIRE_EQUAL(numBins, static_cast<size_t>(k_LambertDim * k_LambertDim))
+    DREAM3D_REQUIRE_EQUAL(squares[1][s]->getNumberOfTuples(), numBins)
+    DREAM3D_REQUIRE_EQUAL(squares[2][s]->getNumberOfTuples(), numBins)
+    for (size_t i = 0; i < numBins; i++)
+    {
+      double expected = squares[0][s]->getValue(i);
+      double tolerance = 1.0e-9 * (fabs(expected) > 1.0 ? fabs(expected) : 1.0);
+      DREAM3D_REQUIRED(fabs(squares[1][s]->getValue(i) - expected), <=, tolerance)
+      DREAM3D_REQUIRE_EQUAL(squares[2][s]->getValue(i), squares[1][s]->getValue(i))
+      total += squares[1][s]->getValue(i);
+    }
+  }
+  // Every point spreads a weight of one over its bins
+  DREAM3D_REQUIRED(fabs(total - static_cast<double>(k_NumPoints)), <, 1.0e-3)
+}
+
+// -----------------------------------------------------------------------------
+// The tiled stereographic image must match filling it one pixel at a time
+// -----------------------------------------------------------------------------
+void TestStereographicProjectionMatchesSerial()
+{
+  FloatArrayType::Pointer coords = CreateSphereCoords(k_NumPoints);
+  ModifiedLambertProjection::Pointer lambert = SerialProjection(coords.get(), k_LambertDim, 1.0f);
+  lambert->normalizeSquaresToMRD();
+  std::vector<double> expected = SerialStereographicProjection(lambert.get(), k_ImageDim);
+
+  int threads[2] = { 1, 4 };
+  for (int t = 0; t < 2; t++)
+  {
+    ParallelContext::SetNumberOfThreads(threads[t]);
+    DoubleArrayType::Pointer intensity = lambert->createStereographicProjection(k_ImageDim);
+    ParallelContext::SetNumberOfThreads(0);
+
+    DREAM3D_REQUIRE_EQUAL(intensity->getNumberOfTuples(), expected.size())
+    size_t numNonZero = 0;
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(intensity->getValue(i), expected[i])
+      if (expected[i] != 0.0) { numNonZero++; }
+    }
+    DREAM3D_REQUIRED(numNonZero, >, expected.size() / 2)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestLambertSquaresMatchSerial() )
+  DREAM3D_REGISTER_TEST( TestStereographicProjectionMatchesSerial() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,97 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QDateTime>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+
+#include "BatchTestOrientations.h"
+
+namespace
+{
+  const size_t k_NumBenchmarkOrientations = 2000000;
+}
+
+#define BENCHMARK_CONVERSION(NAME, IN, IN_STRIDE, OUT_STRIDE)\
+  {\
+    qint64 start = QDateTime::currentMSecsSinceEpoch();\
+    for(size_t i = 0; i < count; i++)\
+    {\
+      FOrientArrayType a(&(data.IN[IN_STRIDE * i]), IN_STRIDE);\
+      FOrientArrayType b(&(out[OUT_STRIDE * i]), OUT_STRIDE);\
+      OrientationTransforms<FOrientArrayType, float>::NAME(a, b);\
+    }\
+    qint64 perElement = QDateTime::currentMSecsSinceEpoch() - start;\
+    start = QDateTime::currentMSecsSinceEpoch();\
+    OrientationBatchTransforms<float>::NAME(&(data.IN.front()), IN_STRIDE, &(out.front()), count);\
+    qint64 batched = QDateTime::currentMSecsSinceEpoch() - start;\
+    std::cout << "  " << #NAME << ": per element " << perElement << " ms, batched " << batched << " ms" << std::endl;\
+  }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BenchmarkBatchConversions()
+{
+  size_t count = k_NumBenchmarkOrientations;
+  TestOrientations<float> data(count);
+  std::vector<float> out(9 * count, 0.0f);
+
+  std::cout << "Converting " << count << " single precision orientations" << std::endl;
+  BENCHMARK_CONVERSION(eu2qu, eu, 3, 4)
+  BENCHMARK_CONVERSION(qu2eu, qu, 4, 3)
+  BENCHMARK_CONVERSION(eu2om, eu, 3, 9)
+  BENCHMARK_CONVERSION(om2eu, om, 9, 3)
+  BENCHMARK_CONVERSION(qu2ro, qu, 4, 4)
+  BENCHMARK_CONVERSION(ro2qu, ro, 4, 4)
+  BENCHMARK_CONVERSION(qu2ho, qu, 4, 3)
+  BENCHMARK_CONVERSION(ho2qu, ho, 3, 4)
+}
+
+// -----------------------------------------------------------------------------
+//  Times the per element conversions against the batched ones. This is not a unit
+//  test; the accuracy of the batched conversions is checked in OrientationBatchTransformsTest.
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  BenchmarkBatchConversions();
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,259 @@
+/* ============================================================================
+ * Copyright (c) 2015 BlueQuartz Softwae, LLC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the names of any of the BlueQuartz Software contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include <stdio.h>
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "OrientationLib/OrientationMath/OrientationArray.hpp"
+#include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
+#include "OrientationLib/OrientationMath/OrientationBatchTransforms.hpp"
+
+#include "BatchTestOrientations.h"
+
+typedef OrientationTransforms<DOrientArrayType, double> ReferenceTransformsType;
+
+namespace
+{
+  const size_t k_NumTestOrientations = 200000;
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  DOrientArrayType toDouble(const T* ptr, int count)
+  {
+    DOrientArrayType out(count);
+    for(int k = 0; k < count; k++) { out[k] = static_cast<double>(ptr[k]); }
+    return out;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Largest component difference of two arrays, ignoring components that are both infinite
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  double maxDifference(const DOrientArrayType& a, const T* b, int count)
+  {
+    double delta = 0.0;
+    for(int k = 0; k < count; k++)
+    {
+      if(a[k] == std::numeric_limits<double>::infinity() && b[k] == std::numeric_limits<T>::infinity()) { continue; }
+      // Rodrigues vectors near a half turn have very large lengths so compare those relative to their size
+      double scale = std::max(1.0, std::fabs(a[k]));
+      delta = std::max(delta, std::fabs(a[k] - static_cast<double>(b[k])) / scale);
+    }
+    return delta;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Quaternions q and -q describe the same rotation
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  double quaternionDifference(const DOrientArrayType& a, const T* b)
+  {
+    double plus = 0.0;
+    double minus = 0.0;
+    for(int k = 0; k < 4; k++)
+    {
+      plus = std::max(plus, std::fabs(a[k] - static_cast<double>(b[k])));
+      minus = std::max(minus, std::fabs(a[k] + static_cast<double>(b[k])));
+    }
+    return std::min(plus, minus);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Euler angles are compared through their rotation matrices so that angles that
+  // wrap around 2Pi, or the arbitrary split of phi1 and phi2 when Phi is 0, do not matter
+  // -----------------------------------------------------------------------------
+  template<typename T>
+  double eulerDifference(const DOrientArrayType& a, const T* b)
+  {
+    DOrientArrayType omA(9), omB(9);
+    ReferenceTransformsType::eu2om(a, omA);
+    ReferenceTransformsType::eu2om(toDouble(b, 3), omB);
+    double delta = 0.0;
+    for(int k = 0; k < 9; k++) { delta = std::max(delta, std::fabs(omA[k] - omB[k])); }
+    return delta;
+  }
+
+  /**
+   * @brief Tolerances for the comparison against the double precision reference.
+   * qu2ho subtracts sin(omega) from omega, which cancels most of the digits for small
+   * rotations in single precision. The reference qu2ho also keeps its intermediate values
+   * in single precision, which limits how closely even the double precision kernel can match it.
+   */
+  template<typename T> double tolerance() { return 1.0E-5; }
+  template<> double tolerance<double>() { return 1.0E-10; }
+  template<typename T> double homochoricTolerance() { return 1.0E-4; }
+  template<> double homochoricTolerance<double>() { return 1.0E-6; }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+void TestBatchAccuracy()
+{
+  typedef OrientationBatchTransforms<T> BatchType;
+  size_t count = k_NumTestOrientations;
+  TestOrientations<T> data(count);
+  std::vector<T> out(9 * count, 0);
+  double delta = 0.0;
+
+  BatchType::eu2qu(&(data.eu.front()), 3, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(4);
+    ReferenceTransformsType::eu2qu(toDouble(&(data.eu[3 * i]), 3), ref);
+    delta = std::max(delta, quaternionDifference(ref, &(out[4 * i])));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+
+  BatchType::qu2eu(&(data.qu.front()), 4, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(3);
+    ReferenceTransformsType::qu2eu(toDouble(&(data.qu[4 * i]), 4), ref);
+    delta = std::max(delta, eulerDifference(ref, &(out[3 * i])));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+
+  BatchType::eu2om(&(data.eu.front()), 3, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(9);
+    ReferenceTransformsType::eu2om(toDouble(&(data.eu[3 * i]), 3), ref);
+    delta = std::max(delta, maxDifference(ref, &(out[9 * i]), 9));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+
+  BatchType::om2eu(&(data.om.front()), 9, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(3);
+    ReferenceTransformsType::om2eu(toDouble(&(data.om[9 * i]), 9), ref);
+    delta = std::max(delta, eulerDifference(ref, &(out[3 * i])));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+
+  BatchType::qu2ro(&(data.qu.front()), 4, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(4);
+    ReferenceTransformsType::qu2ro(toDouble(&(data.qu[4 * i]), 4), ref);
+    delta = std::max(delta, maxDifference(ref, &(out[4 * i]), 4));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+
+  BatchType::ro2qu(&(data.ro.front()), 4, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(4);
+    ReferenceTransformsType::ro2qu(toDouble(&(data.ro[4 * i]), 4), ref);
+    delta = std::max(delta, quaternionDifference(ref, &(out[4 * i])));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+
+  BatchType::qu2ho(&(data.qu.front()), 4, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(3);
+    ReferenceTransformsType::qu2ho(toDouble(&(data.qu[4 * i]), 4), ref);
+    delta = std::max(delta, maxDifference(ref, &(out[3 * i]), 3));
+  }
+  DREAM3D_REQUIRED(delta, <, homochoricTolerance<T>())
+
+  BatchType::ho2qu(&(data.ho.front()), 3, &(out.front()), count);
+  delta = 0.0;
+  for(size_t i = 0; i < count; i++)
+  {
+    DOrientArrayType ref(4);
+    ReferenceTransformsType::ho2qu(toDouble(&(data.ho[3 * i]), 3), ref);
+    delta = std::max(delta, quaternionDifference(ref, &(out[4 * i])));
+  }
+  DREAM3D_REQUIRED(delta, <, tolerance<T>())
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestStridedInput()
+{
+  // Euler angles stored with a 4th (unused) component must give the same result as packed ones
+  size_t count = 1000;
+  TestOrientations<float> data(count);
+  std::vector<float> strided(4 * count, -1.0f);
+  for(size_t i = 0; i < count; i++)
+  {
+    for(int k = 0; k < 3; k++) { strided[4 * i + k] = data.eu[3 * i + k]; }
+  }
+  std::vector<float> packedOut(4 * count, 0.0f);
+  std::vector<float> stridedOut(4 * count, 0.0f);
+  OrientationBatchTransforms<float>::eu2qu(&(data.eu.front()), 3, &(packedOut.front()), count);
+  OrientationBatchTransforms<float>::eu2qu(&(strided.front()), 4, &(stridedOut.front()), count);
+  for(size_t i = 0; i < 4 * count; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(packedOut[i], stridedOut[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestBatchAccuracy<float>() )
+  DREAM3D_REGISTER_TEST( TestBatchAccuracy<double>() )
+  DREAM3D_REGISTER_TEST( TestStridedInput() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -38,16 +38,17 @@
 #define _TEXTURE_H_
 
 #include <vector>
+#include <algorithm>
 #include <QtCore/QString>
 #include <fstream>
 
 #include <boost/shared_array.hpp>
 
-
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
@@ -56,6 +57,114 @@
 #include "OrientationLib/SpaceGroupOps/HexagonalOps.h"
 #include "OrientationLib/SpaceGroupOps/OrthoRhombicOps.h"
 
+/**
+ * @brief The MDFSamplerImpl class draws random pairs of orientations from an ODF and counts the
+ * misorientation bins they fall into. Every attempt at a sample uses its own seeds, so the counts do
+ * not depend on how the samples are split between threads. It is used directly as the body of
+ * ParallelContext::ParallelReduce.
+ */
+template<typename T, class SpaceGroupOps>
+class MDFSamplerImpl
+{
+    const std::vector<float>* m_CumulativeODF;
+    const T* m_MDF;
+    uint64_t m_Seed;
+    size_t m_NumSamples;
+    SpaceGroupOps m_OrientationOps;
+    std::vector<int> m_Counts;
+
+  public:
+    MDFSamplerImpl(const std::vector<float>* cumulativeODF, const T* mdf, int mdfSize, uint64_t seed, size_t numSamples) :
+      m_CumulativeODF(cumulativeODF),
+      m_MDF(mdf),
+      m_Seed(seed),
+      m_NumSamples(numSamples),
+      m_Counts(mdfSize, 0)
+    {}
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    MDFSamplerImpl(MDFSamplerImpl& other, tbb::split) :
+      m_CumulativeODF(other.m_CumulativeODF),
+      m_MDF(other.m_MDF),
+      m_Seed(other.m_Seed),
+      m_NumSamples(other.m_NumSamples),
+      m_Counts(other.m_Counts.size(), 0)
+    {}
+#endif
+
+    virtual ~MDFSamplerImpl() {}
+
+    /**
+     * @brief chooseBin Returns the ODF bin whose share of the running total contains the random value
+     */
+    int chooseBin(float random) const
+    {
+      std::vector<float>::const_iterator iter = std::upper_bound(m_CumulativeODF->begin(), m_CumulativeODF->end(), random);
+      if (iter == m_CumulativeODF->end()) { return 0; }
+      return static_cast<int>(iter - m_CumulativeODF->begin());
+    }
+
+    void convert(size_t start, size_t end)
+    {
+      int mbin;
+      float w = 0;
+      QuatF q1;
+      QuatF q2;
+      float n1, n2, n3;
+
+      for (size_t i = start; i < end; i++)
+      {
+        // Bins that were given a fixed weight are negative in the MDF, so a pair landing there is redrawn
+        for (uint64_t attempt = 0; ; attempt++)
+        {
+          uint64_t seed = m_Seed + 2 * (attempt * m_NumSamples + i) + 1;
+          SIMPL_RANDOMNG_NEW_SEEDED(seed);
+          float random1 = rg.genrand_res53();
+          float random2 = rg.genrand_res53();
+
+          FOrientArrayType eu = m_OrientationOps.determineEulerAngles(seed, chooseBin(random1));
+          FOrientArrayType qu(4);
+          OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
+          q1 = qu.toQuaternion();
+
+          eu = m_OrientationOps.determineEulerAngles(seed + 1, chooseBin(random2));
+          OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
+          q2 = qu.toQuaternion();
+          w = m_OrientationOps.getMisoQuat(q1, q2, n1, n2, n3);
+
+          FOrientArrayType ax(n1, n2, n3, w);
+          FOrientArrayType ro(4);
+          OrientationTransforms<FOrientArrayType, float>::ax2ro(ax, ro);
+
+          ro = m_OrientationOps.getMDFFZRod(ro);
+          mbin = m_OrientationOps.getMisoBin(ro);
+          if(m_MDF[mbin] >= 0)
+          {
+            m_Counts[mbin]++;
+            break;
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r)
+    {
+      convert(r.begin(), r.end());
+    }
+
+    void join(const MDFSamplerImpl& rhs)
+    {
+      for (size_t i = 0; i < m_Counts.size(); i++)
+      {
+        m_Counts[i] += rhs.m_Counts[i];
+      }
+    }
+#endif
+
+    const std::vector<int>& getCounts() const { return m_Counts; }
+};
+
 /**
  * @class Texture Texture.h AIM/Common/Texture.h
  * @brief This class holds default data for Orientation Distribution Function
@@ -446,16 +555,8 @@ class Texture
       const int mdfsize = orientationOps.getMDFSize();
 
       uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
-      SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
       int mbin;
-      float w = 0;
-      int choose1, choose2;
-      QuatF q1;
-      QuatF q2;
-      float totaldensity;
-      float n1, n2, n3;
-      float random1, random2, density;
 
       for (int i = 0; i < mdfsize; i++)
       {
@@ -475,44 +576,25 @@ class Texture
         remainingcount = remainingcount + mdf[mbin];
       }
 
-      for (int i = 0; i < remainingcount; i++)
+      // Every random number is looked up in the running total of the ODF, so it is only summed once
+      std::vector<float> cumulativeODF(odfsize);
+      float totaldensity = 0;
+      for (int j = 0; j < odfsize; j++)
       {
-        m_Seed++;
-        SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
-        random1 = rg.genrand_res53();
-        random2 = rg.genrand_res53();
-        choose1 = 0;
-        choose2 = 0;
-
-        totaldensity = 0;
-        for (int j = 0; j < odfsize; j++)
+        totaldensity = totaldensity + odf[j];
+        cumulativeODF[j] = totaldensity;
+      }
+
+      if (remainingcount > 0)
+      {
+        MDFSamplerImpl<T, SpaceGroupOps> sampler(&cumulativeODF, mdf, mdfsize, m_Seed, static_cast<size_t>(remainingcount));
+        ParallelContext::ParallelReduce<size_t>(0, remainingcount, sampler, 64);
+
+        const std::vector<int>& counts = sampler.getCounts();
+        for (int i = 0; i < mdfsize; i++)
         {
-          density = odf[j];
-          float d = totaldensity;
-          totaldensity = totaldensity + density;
-          if(random1 >= d && random1 < totaldensity) { choose1 = static_cast<int>(j); }
-          if(random2 >= d && random2 < totaldensity) { choose2 = static_cast<int>(j); }
+          mdf[i] = mdf[i] + counts[i];
         }
-
-        FOrientArrayType eu = orientationOps.determineEulerAngles(m_Seed, choose1);
-        FOrientArrayType qu(4);
-        OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
-        q1 = qu.toQuaternion();
-
-        m_Seed++;
-        eu = orientationOps.determineEulerAngles(m_Seed, choose2);
-        OrientationTransforms<FOrientArrayType, float>::eu2qu(eu, qu);
-        q2 = qu.toQuaternion();
-        w = orientationOps.getMisoQuat(q1, q2, n1, n2, n3);
-
-        FOrientArrayType ax(n1, n2, n3, w);
-        FOrientArrayType ro(4);
-        OrientationTransforms<FOrientArrayType, float>::ax2ro(ax, ro);
-
-        ro = orientationOps.getMDFFZRod(ro);
-        mbin = orientationOps.getMisoBin(ro);
-        if(mdf[mbin] >= 0) { mdf[mbin]++; }
-        if(mdf[mbin] < 0) { i = i - 1; }
       }
       for (int i = 0; i < mdfsize; i++)
       {
@@ -36,14 +36,170 @@
 
 #include "ModifiedLambertProjection.h"
 
+#include <vector>
+
 #include <QtCore/QSet>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/blocked_range2d.h>
+#include <tbb/partitioner.h>
+#endif
 
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #define WRITE_LAMBERT_SQUARE_COORD_VTK 0
 
+namespace Detail
+{
+  // The sphere coordinates are split into at most this many contiguous chunks, each of which is
+  // binned into its own pair of squares. The chunking only depends on the number of points so the
+  // summed squares do not depend on how many threads were used.
+  static const size_t MaxLambertChunks = 64;
+  static const size_t MinPointsPerLambertChunk = 32768;
+  // Edge length in pixels of the tiles the stereographic projection is filled in
+  static const int64_t StereographicTileSize = 32;
+}
+
+/**
+ * @brief The AccumulateLambertSquaresImpl class bins chunks of XYZ sphere coordinates into separate
+ * pairs of modified Lambert squares that are summed once all the chunks are done
+ */
+class AccumulateLambertSquaresImpl
+{
+    float* m_Coords;
+    size_t m_NumPoints;
+    size_t m_NumChunks;
+    int m_Dimension;
+    float m_SphereRadius;
+    std::vector<ModifiedLambertProjection::Pointer>& m_Projections;
+
+  public:
+    AccumulateLambertSquaresImpl(float* coords, size_t numPoints, size_t numChunks, int dimension, float sphereRadius,
+                                 std::vector<ModifiedLambertProjection::Pointer>& projections) :
+      m_Coords(coords),
+      m_NumPoints(numPoints),
+      m_NumChunks(numChunks),
+      m_Dimension(dimension),
+      m_SphereRadius(sphereRadius),
+      m_Projections(projections)
+    {}
+    virtual ~AccumulateLambertSquaresImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      float sqCoord[2];
+      for (size_t chunk = start; chunk < end; chunk++)
+      {
+        ModifiedLambertProjection::Pointer squareProj = ModifiedLambertProjection::New();
+        squareProj->initializeSquares(m_Dimension, m_SphereRadius);
+        size_t pointStart = chunk * m_NumPoints / m_NumChunks;
+        size_t pointEnd = (chunk + 1) * m_NumPoints / m_NumChunks;
+        for (size_t i = pointStart; i < pointEnd; ++i)
+        {
+          sqCoord[0] = 0.0;
+          sqCoord[1] = 0.0;
+          if (squareProj->getSquareCoord(m_Coords + i * 3, sqCoord) == true)
+          {
+            squareProj->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+          }
+          else
+          {
+            squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+          }
+        }
+        m_Projections[chunk] = squareProj;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The StereographicProjectionImpl class fills a rectangular tile of a stereographic intensity
+ * image by interpolating the modified Lambert squares
+ */
+class StereographicProjectionImpl
+{
+    ModifiedLambertProjection* m_Lambert;
+    int64_t m_Dim;
+    double* m_Intensity;
+
+  public:
+    StereographicProjectionImpl(ModifiedLambertProjection* lambert, int64_t dim, double* intensity) :
+      m_Lambert(lambert),
+      m_Dim(dim),
+      m_Intensity(intensity)
+    {}
+    virtual ~StereographicProjectionImpl() {}
+
+    void convert(int64_t yStart, int64_t yEnd, int64_t xStart, int64_t xEnd) const
+    {
+      int64_t xpointshalf = m_Dim / 2;
+      int64_t ypointshalf = m_Dim / 2;
+
+      float xres = 2.0 / (float)(m_Dim);
+      float yres = 2.0 / (float)(m_Dim);
+      float xtmp, ytmp;
+      float sqCoord[2];
+      float xyz[3];
+      bool nhCheck = false;
+
+      for (int64_t y = yStart; y < yEnd; y++)
+      {
+        for (int64_t x = xStart; x < xEnd; x++)
+        {
+          //get (x,y) for stereographic projection pixel
+          xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
+          ytmp = float(y - ypointshalf) * yres + (yres * 0.5);
+          int64_t index = y * m_Dim + x;
+          if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
+          {
+            //project xy from stereo projection to the unit spehere
+            xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
+            xyz[0] = xtmp * (1 + xyz[2]);
+            xyz[1] = ytmp * (1 + xyz[2]);
+
+            for( int64_t m = 0; m < 2; m++)
+            {
+              if(m == 1)
+              {
+                MatrixMath::Multiply3x1withConstant(xyz, -1.0);
+              }
+              nhCheck = m_Lambert->getSquareCoord(xyz, sqCoord);
+              if (nhCheck == true)
+              {
+                //get Value from North square
+                m_Intensity[index] += m_Lambert->getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
+              }
+              else
+              {
+                //get Value from South square
+                m_Intensity[index] += m_Lambert->getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
+              }
+            }
+            m_Intensity[index]  = m_Intensity[index] * 0.5;
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range2d<int64_t, int64_t>& r) const
+    {
+      convert(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+    }
+#endif
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -99,7 +255,6 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
   fprintf(f, "\n");
 
   fprintf(f, "DATASET UNSTRUCTURED_GRID\nPOINTS %lu float\n", coords->getNumberOfTuples() );
-#endif
 
   for(size_t i = 0; i < npoints; ++i)
   {
@@ -107,28 +262,53 @@ ModifiedLambertProjection::Pointer ModifiedLambertProjection::CreateProjectionFr
     sqCoord[1] = 0.0;
     //get coordinates in square projection of crystal normal parallel to boundary normal
     nhCheck = squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
     fprintf(f, "%f %f 0\n", sqCoord[0], sqCoord[1]);
+  }
+  fclose(f);
 #endif
 
-    // Based on the XY coordinate, get the pointer index that the value corresponds to in the proper square
-//    sqIndex = squareProj->getSquareIndex(sqCoord);
-    if (nhCheck == true)
+  size_t numChunks = npoints / Detail::MinPointsPerLambertChunk;
+  if (numChunks > Detail::MaxLambertChunks) { numChunks = Detail::MaxLambertChunks; }
+  if (numChunks < 2)
+  {
+    for(size_t i = 0; i < npoints; ++i)
     {
-      //north increment by 1
-//      squareProj->addValue(ModifiedLambertProjection::NorthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+      sqCoord[0] = 0.0;
+      sqCoord[1] = 0.0;
+      //get coordinates in square projection of crystal normal parallel to boundary normal
+      nhCheck = squareProj->getSquareCoord(coords->getPointer(i * 3), sqCoord);
+      if (nhCheck == true)
+      {
+        //north increment by 1
+        squareProj->addInterpolatedValues(ModifiedLambertProjection::NorthSquare, sqCoord, 1.0);
+      }
+      else
+      {
+        // south increment by 1
+        squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+      }
     }
-    else
+    return squareProj;
+  }
+
+  // Bin each chunk of points into its own squares and then sum the squares in chunk order
+  std::vector<ModifiedLambertProjection::Pointer> chunkProjections(numChunks);
+  ParallelContext::ParallelFor<size_t>(0, numChunks, AccumulateLambertSquaresImpl(coords->getPointer(0), npoints, numChunks, dimension, sphereRadius, chunkProjections));
+
+  double* north = squareProj->getNorthSquare()->getPointer(0);
+  double* south = squareProj->getSouthSquare()->getPointer(0);
+  size_t numBins = squareProj->getNorthSquare()->getNumberOfTuples();
+  for (size_t chunk = 0; chunk < numChunks; chunk++)
+  {
+    double* chunkNorth = chunkProjections[chunk]->getNorthSquare()->getPointer(0);
+    double* chunkSouth = chunkProjections[chunk]->getSouthSquare()->getPointer(0);
+    for (size_t i = 0; i < numBins; i++)
     {
-      // south increment by 1
-//      squareProj->addValue(ModifiedLambertProjection::SouthSquare, sqIndex, 1.0);
-      squareProj->addInterpolatedValues(ModifiedLambertProjection::SouthSquare, sqCoord, 1.0);
+      north[i] += chunkNorth[i];
+      south[i] += chunkSouth[i];
     }
+    chunkProjections[chunk] = ModifiedLambertProjection::NullPointer();
   }
-#if WRITE_LAMBERT_SQUARE_COORD_VTK
-  fclose(f);
-#endif
 
   return squareProj;
 }
@@ -249,28 +429,11 @@ void ModifiedLambertProjection::addInterpolatedValues(Square square, float* sqCo
   int index2 = bbin2 * m_Dimension + abin2;
   int index3 = bbin3 * m_Dimension + abin3;
   int index4 = bbin4 * m_Dimension + abin4;
-  if (square == NorthSquare)
-  {
-    double v1 = m_NorthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_NorthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_NorthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_NorthSquare->getValue(index4) + value * (modX) * (modY);
-    m_NorthSquare->setValue(index1, v1);
-    m_NorthSquare->setValue(index2, v2);
-    m_NorthSquare->setValue(index3, v3);
-    m_NorthSquare->setValue(index4, v4);
-  }
-  else
-  {
-    double v1 = m_SouthSquare->getValue(index1) + value * (1.0 - modX) * (1.0 - modY);
-    double v2 = m_SouthSquare->getValue(index2) + value * (modX) * (1.0 - modY);
-    double v3 = m_SouthSquare->getValue(index3) + value * (1.0 - modX) * (modY);
-    double v4 = m_SouthSquare->getValue(index4) + value * (modX) * (modY);
-    m_SouthSquare->setValue(index1, v1);
-    m_SouthSquare->setValue(index2, v2);
-    m_SouthSquare->setValue(index3, v3);
-    m_SouthSquare->setValue(index4, v4);
-  }
+  double* values = (square == NorthSquare) ? m_NorthSquare->getPointer(0) : m_SouthSquare->getPointer(0);
+  values[index1] += value * (1.0 - modX) * (1.0 - modY);
+  values[index2] += value * (modX) * (1.0 - modY);
+  values[index3] += value * (1.0 - modX) * (modY);
+  values[index4] += value * (modX) * (modY);
 }
 
 // -----------------------------------------------------------------------------
@@ -531,63 +694,22 @@ void ModifiedLambertProjection::normalizeSquaresToMRD()
 // -----------------------------------------------------------------------------
 void ModifiedLambertProjection::createStereographicProjection(int dim, DoubleArrayType* stereoIntensity)
 {
-  int xpoints = dim;
-  int ypoints = dim;
-
-  int xpointshalf = xpoints / 2;
-  int ypointshalf = ypoints / 2;
-
-  float xres = 2.0 / (float)(xpoints);
-  float yres = 2.0 / (float)(ypoints);
-  float xtmp, ytmp;
-  float sqCoord[2];
-  float xyz[3];
-  bool nhCheck = false;
-
   stereoIntensity->initializeWithZeros();
   double* intensity = stereoIntensity->getPointer(0);
-// int sqIndex = 0;
 
-  for (int64_t y = 0; y < ypoints; y++)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
+  if (doParallel == true)
   {
-    for (int64_t x = 0; x < xpoints; x++)
-    {
-      //get (x,y) for stereographic projection pixel
-      xtmp = float(x - xpointshalf) * xres + (xres * 0.5);
-      ytmp = float(y - ypointshalf) * yres + (yres * 0.5);
-      int index = y * xpoints + x;
-      if((xtmp * xtmp + ytmp * ytmp) <= 1.0)
-      {
-        //project xy from stereo projection to the unit spehere
-        xyz[2] = -((xtmp * xtmp + ytmp * ytmp) - 1) / ((xtmp * xtmp + ytmp * ytmp) + 1);
-        xyz[0] = xtmp * (1 + xyz[2]);
-        xyz[1] = ytmp * (1 + xyz[2]);
-
-
-        for( int64_t m = 0; m < 2; m++)
-        {
-          if(m == 1)
-          {
-            MatrixMath::Multiply3x1withConstant(xyz, -1.0);
-          }
-          nhCheck = getSquareCoord(xyz, sqCoord);
-          //sqIndex = getSquareIndex(sqCoord);
-          if (nhCheck == true)
-          {
-            //get Value from North square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::NorthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::NorthSquare, sqIndex);
-          }
-          else
-          {
-            //get Value from South square
-            intensity[index] += getInterpolatedValue(ModifiedLambertProjection::SouthSquare, sqCoord);
-            //intensity[index] += getValue(ModifiedLambertProjection::SouthSquare, sqIndex);
-          }
-        }
-        intensity[index]  = intensity[index] * 0.5;
-      }
-    }
+    tbb::parallel_for(tbb::blocked_range2d<int64_t, int64_t>(0, dim, Detail::StereographicTileSize, 0, dim, Detail::StereographicTileSize),
+                      StereographicProjectionImpl(this, dim, intensity), tbb::auto_partitioner());
+  }
+  else
+#endif
+  {
+    StereographicProjectionImpl serial(this, dim, intensity);
+    serial.convert(0, dim, 0, dim);
   }
 }
 
@@ -39,6 +39,8 @@
 
 #include "H5Support/QH5Utilities.h"
 
+#include "SIMPLib/DataArrays/TupleTransfer.h"
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -397,6 +399,50 @@ IDataArray::Pointer ModifiedLambertProjectionArray::reorderCopy(QVector<size_t>
   return daCopyPtr;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer ModifiedLambertProjectionArray::gather(const IndexMap& map)
+{
+  if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false)
+  {
+    return IDataArray::NullPointer();
+  }
+  ModifiedLambertProjectionArray::Pointer daCopyPtr = ModifiedLambertProjectionArray::New();
+  daCopyPtr->setName(getName());
+  for(size_t i = 0; i < map.size(); i++)
+  {
+    if(map[i] >= 0)
+    {
+      daCopyPtr->setModifiedLambertProjection(static_cast<int>(i), m_ModifiedLambertProjectionArray[map[i]]);
+    }
+    else
+    {
+      daCopyPtr->setModifiedLambertProjection(static_cast<int>(i), ModifiedLambertProjection::New());
+    }
+  }
+  return daCopyPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ModifiedLambertProjectionArray::scatter(const IndexMap& map, IDataArray::Pointer sourceArray)
+{
+  Self* source = dynamic_cast<Self*>(sourceArray.get());
+  if(NULL == source) { return false; }
+  if(source->getNumberOfTuples() != map.size()) { return false; }
+  if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false) { return false; }
+  for(size_t i = 0; i < map.size(); i++)
+  {
+    if(map[i] >= 0)
+    {
+      m_ModifiedLambertProjectionArray[map[i]] = (*source)[i];
+    }
+  }
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
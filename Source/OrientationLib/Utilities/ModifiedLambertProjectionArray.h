@@ -277,6 +277,21 @@ class OrientationLib_EXPORT ModifiedLambertProjectionArray : public IDataArray
      */
     virtual IDataArray::Pointer reorderCopy(QVector<size_t> newOrderMap);
 
+    /**
+     * @brief gather
+     * @param map
+     * @return
+     */
+    virtual IDataArray::Pointer gather(const IndexMap& map);
+
+    /**
+     * @brief scatter
+     * @param map
+     * @param sourceArray
+     * @return
+     */
+    virtual bool scatter(const IndexMap& map, IDataArray::Pointer sourceArray);
+
     /**
      * @brief Splats the same value c across all values in the Tuple
      * @param i The index of the Tuple
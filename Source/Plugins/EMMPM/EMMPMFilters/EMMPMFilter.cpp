@@ -36,6 +36,8 @@
 
 #include "EMMPMFilter.h"
 
+#include <limits>
+
 #include "EMMPM/EMMPMConstants.h"
 #include "EMMPM/EMMPMLib/EMMPMLib.h"
 #include "EMMPM/EMMPMLib/Common/EMTime.h"
@@ -199,6 +201,19 @@ void EMMPMFilter::dataCheck()
     QString ss = QObject::tr("The minimum number of classes is 2");
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
   }
+
+  // A volume is segmented as a whole, but the curvature penalty only works on a single image
+  AttributeMatrix::Pointer am = getDataContainerArray()->getAttributeMatrix(getInputDataArrayPath());
+  if (NULL != am.get() && getUseCurvaturePenalty())
+  {
+    QVector<size_t> tDims = am->getTupleDimensions();
+    if (tDims.size() > 2 && tDims[2] > 1)
+    {
+      setErrorCondition(-62004);
+      QString ss = QObject::tr("The curvature penalty can only be used on a single image, not on a volume with more than one slice");
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -226,6 +241,7 @@ void EMMPMFilter::execute()
 
   // This is the routine that sets up the EM/MPM to segment the image
   segment(getEmmpmInitType());
+  if(getErrorCondition() < 0) { return; }
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -279,8 +295,34 @@ void EMMPMFilter::segment(EMMPM_InitializationType initType)
   IDataArray::Pointer iDataArray = am->getAttributeArray(getInputDataArrayPath().getDataArrayName());
   QVector<size_t> cDims = iDataArray->getComponentDimensions();
 
-  data->columns = tDims[0];
-  data->rows = tDims[1];
+  // A volume is segmented in one pass: its slices are stacked along the rows and the MPM
+  // neighborhood of each voxel also reaches into the slices above and below it
+  size_t slices = (tDims.size() > 2 && tDims[2] > 1) ? tDims[2] : 1;
+  size_t stackedRows = tDims[1] * slices;
+  // EMMPM_Data stores the image size as unsigned int and sizes its buffers with
+  // rows * columns, so the stacked image must fit in that type
+  const size_t maxSize = static_cast<size_t>(std::numeric_limits<unsigned int>::max());
+  if (stackedRows > maxSize || tDims[0] > maxSize / stackedRows)
+  {
+    setErrorCondition(-62005);
+    QString ss = QObject::tr("The volume has %1 x %2 x %3 voxels, which is more than the EM/MPM algorithm can segment at once").arg(tDims[0]).arg(tDims[1]).arg(slices);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  // The per class arrays hold every voxel once for each class, so the size of all of them
+  // together must also be addressable
+  size_t totalVoxels = tDims[0] * stackedRows;
+  size_t classes = static_cast<size_t>(data->classes);
+  if (totalVoxels > std::numeric_limits<size_t>::max() / (classes * sizeof(real_t)))
+  {
+    setErrorCondition(-62006);
+    QString ss = QObject::tr("The volume has %1 voxels, which is too many to segment into %2 classes at once").arg(totalVoxels).arg(classes);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  data->columns = static_cast<unsigned int>(tDims[0]);
+  data->rows = static_cast<unsigned int>(stackedRows);
+  data->slices = static_cast<unsigned int>(slices);
   data->dims = 1; // We operate on a single channel | single component "image".
   data->inputImageChannels = cDims[0];
 
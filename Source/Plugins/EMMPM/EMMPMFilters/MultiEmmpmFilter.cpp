@@ -252,6 +252,13 @@ void MultiEmmpmFilter::dataCheck()
     QString ss = QObject::tr("The minimum number of classes is 2");
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
   }
+  // A volume is segmented as a whole, but the curvature penalty only works on a single image
+  if (getUseCurvaturePenalty() && tDims.size() > 2 && tDims[2] > 1)
+  {
+    setErrorCondition(-62004);
+    QString ss = QObject::tr("The curvature penalty can only be used on a single image, not on a volume with more than one slice");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
 }
 
 // -----------------------------------------------------------------------------
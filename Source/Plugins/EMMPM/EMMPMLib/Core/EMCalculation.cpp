@@ -42,6 +42,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "EMMPMLib/EMMPMLib.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
@@ -54,10 +55,6 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "EMMPMLib/Core/MorphFilt.h"
 #include "EMMPMLib/Core/MPMCalculation.h"
 
-#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-#include <tbb/task_scheduler_init.h>
-#endif
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -82,11 +79,9 @@ EMCalculation::~EMCalculation()
 // -----------------------------------------------------------------------------
 void EMCalculation::execute()
 {
-#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-  tbb::task_scheduler_init init;
-  //  int threads = init.default_num_threads();
+  ParallelContext::Scheduler scheduler;
+  //  int threads = scheduler.getNumberOfThreads();
   //   std::cout << "TBB Thread Count: " << threads << std::endl;
-#endif
   EMMPM_Data* data = m_Data.get();
   int k;
   int emiter = data->emIterations;
@@ -52,13 +52,13 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 void EMMPMUtilities::ConvertInputImageToWorkingImage(EMMPM_Data::Pointer data)
 {
   uint8_t* dst;
-  int i;
-  int j;
-  int d;
+  size_t i;
+  size_t j;
+  size_t d;
   size_t index = 0;
-  int width;
-  int height;
-  int dims;
+  size_t width;
+  size_t height;
+  size_t dims;
 
   if (data->inputImageChannels == 0)
   {
@@ -86,7 +86,7 @@ void EMMPMUtilities::ConvertInputImageToWorkingImage(EMMPM_Data::Pointer data)
     {
       for (d = 0; d < dims; d++)
       {
-        index = (j * width * dims) + (i * dims) + d;
+        index = PixelComponentIndex(j, i, d, width, dims);
         data->y[index] = *dst;
         ++dst;
       }
@@ -100,7 +100,8 @@ void EMMPMUtilities::ConvertInputImageToWorkingImage(EMMPM_Data::Pointer data)
 void EMMPMUtilities::ConvertXtToOutputImage(EMMPM_Data::Pointer data)
 {
   size_t index;
-  unsigned int i, j, d;
+  size_t i, j;
+  unsigned int d;
   unsigned char* raster;
   int l, ld;
   size_t gtindex = 0;
@@ -128,10 +129,10 @@ void EMMPMUtilities::ConvertXtToOutputImage(EMMPM_Data::Pointer data)
   }
   raster = data->outputImage;
   index = 0;
-  totalPixels = data->rows * data->columns;
-  unsigned int rows = data->rows;
-  unsigned int columns = data->columns;
-  unsigned int ixCol = 0;
+  totalPixels = static_cast<size_t>(data->rows) * data->columns;
+  size_t rows = data->rows;
+  size_t columns = data->columns;
+  size_t ixCol = 0;
   unsigned int* colorTable = data->colorTable;
 
   for (i = 0; i < rows; i++)
@@ -254,28 +255,27 @@ class EstimateMeans
     }
     virtual ~EstimateMeans() {}
 
-    void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
+    void calc(size_t rowStart, size_t rowEnd, size_t colStart, size_t colEnd) const
     {
-      int dims = data->dims;
-      int rows = data->rows;
-      int cols = data->columns;
-      int32_t k_, k2_, lij, ld, ijd, k_temp, k2_temp;
+      size_t dims = data->dims;
+      size_t rows = data->rows;
+      size_t cols = data->columns;
+      size_t k_, k2_, lij, ld, ijd, k2_temp;
       real_t* m = data->mean;
       unsigned char* y = data->y;
       real_t* probs = data->probs;
       real_t* N = data->N;
 
-      k_temp = (cols * rows * l);
-      for (int r = rowStart; r < rowEnd; r++)
+      for (size_t r = rowStart; r < rowEnd; r++)
       {
-        k_ = k_temp + (cols * r);
-        k2_temp = (dims * cols * r);
-        for (int c = colStart; c < colEnd; c++)
+        k_ = EMMPMUtilities::ClassPixelIndex(l, r, 0, rows, cols);
+        k2_temp = EMMPMUtilities::PixelComponentIndex(r, 0, 0, cols, dims);
+        for (size_t c = colStart; c < colEnd; c++)
         {
           k2_ = k2_temp + ( dims * c);
           lij = k_ + c;
           N[l] += probs[lij]; // denominator of (20)
-          for (int d = 0; d < dims; d++)
+          for (size_t d = 0; d < dims; d++)
           {
             ld = dims * l + d;
             ijd = k2_ + d;
@@ -285,7 +285,7 @@ class EstimateMeans
       }
       if (N[l] != 0)
       {
-        for (int d = 0; d < dims; d++)
+        for (size_t d = 0; d < dims; d++)
         {
           ld = dims * l + d;
           m[ld] = m[ld] / N[l];
@@ -311,31 +311,30 @@ class EstimateVariance
     }
     virtual ~EstimateVariance() {}
 
-    void calc(int rowStart, int rowEnd, int colStart, int colEnd) const
+    void calc(size_t rowStart, size_t rowEnd, size_t colStart, size_t colEnd) const
     {
-      int dims = data->dims;
-      int rows = data->rows;
-      int cols = data->columns;
-      int32_t k_, k2_, lij, ld, ijd, k_temp, k2_temp;
+      size_t dims = data->dims;
+      size_t rows = data->rows;
+      size_t cols = data->columns;
+      size_t k_, k2_, lij, ld, ijd, k2_temp;
       real_t* m = data->mean;
       unsigned char* y = data->y;
       real_t* probs = data->probs;
       real_t* N = data->N;
       real_t res = 0.0f;
       real_t* v = data->variance;
-      int32_t dimsXl = dims * l;
+      size_t dimsXl = dims * l;
 
-      k_temp = (cols * rows * l);
-      for (int r = rowStart; r < rowEnd; r++)
+      for (size_t r = rowStart; r < rowEnd; r++)
       {
-        k_ = k_temp + (cols * r);
-        k2_temp = (dims * cols * r);
-        for (int c = colStart; c < colEnd; c++)
+        k_ = EMMPMUtilities::ClassPixelIndex(l, r, 0, rows, cols);
+        k2_temp = EMMPMUtilities::PixelComponentIndex(r, 0, 0, cols, dims);
+        for (size_t c = colStart; c < colEnd; c++)
         {
           k2_ = k2_temp + ( dims * c);
           // numerator of (21)
           lij = k_ + c;
-          for (int d = 0; d < dims; d++)
+          for (size_t d = 0; d < dims; d++)
           {
             ld = dimsXl + d;
             ijd = k2_ + d;
@@ -348,7 +347,7 @@ class EstimateVariance
 
       if(N[l] != 0)
       {
-        for (int d = 0; d < dims; d++)
+        for (size_t d = 0; d < dims; d++)
         {
           ld = dims * l + d;
           v[ld] = v[ld] / N[l];
@@ -125,6 +125,35 @@ class EMMPMLib_EXPORT EMMPMUtilities
      */
     static void ComputeEntropy(real_t** *probs, unsigned char** output,
                                unsigned int rows, unsigned int cols, unsigned int classes);
+
+    /**
+     * @brief Returns the index of a pixel in the per class arrays (probs, ccost), which
+     * hold every pixel of class 0 followed by every pixel of class 1 and so on. The index
+     * is 64 bit since a stacked volume can hold more than 2^31 entries over all classes.
+     * @param l The class
+     * @param row The row of the (stacked) image
+     * @param col The column
+     * @param rows The number of rows of the (stacked) image
+     * @param cols The number of columns
+     */
+    static size_t ClassPixelIndex(size_t l, size_t row, size_t col, size_t rows, size_t cols)
+    {
+      return (cols * rows * l) + (cols * row) + col;
+    }
+
+    /**
+     * @brief Returns the index of one vector component of a pixel in the working image y
+     * @param row The row of the (stacked) image
+     * @param col The column
+     * @param d The vector component
+     * @param cols The number of columns
+     * @param dims The number of vector components per pixel
+     */
+    static size_t PixelComponentIndex(size_t row, size_t col, size_t d, size_t cols, size_t dims)
+    {
+      return (dims * cols * row) + (dims * col) + d;
+    }
+
   protected:
     EMMPMUtilities()
     {
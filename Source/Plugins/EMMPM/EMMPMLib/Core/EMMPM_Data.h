@@ -99,6 +99,7 @@ class EMMPMLib_EXPORT EMMPM_Data
     real_t in_beta; /**<  */
     int classes; /**<  */
     unsigned int rows; /**< The height of the image.  Applicable for both input and output images */
+    unsigned int slices; /**< The number of slices of a volume, stacked along the rows so rows is a multiple of it. 1 for a single image */
     unsigned int columns; /**< The width of the image. Applicable for both input and output images */
     unsigned int dims; /**< The number of vector elements in the image.*/
     enum EMMPM_InitializationType initType;  /**< The type of initialization algorithm to use  */
@@ -50,6 +50,7 @@
 
 //-- EMMMPM Lib Includes
 #include "EMMPMLib/Core/EMMPM.h"
+#include "EMMPMLib/Core/EMMPMUtilities.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
 #include "EMMPMLib/Common/EMMPM_Math.h"
 #include "EMMPMLib/Common/EMTime.h"
@@ -103,7 +104,8 @@ BasicInitialization::~BasicInitialization()
 void BasicInitialization::initialize(EMMPM_Data::Pointer data)
 {
   //FIXME: This needs to be adapted for vector images (dims > 1)
-  unsigned int i, k, l;
+  size_t i;
+  unsigned int k, l;
   real_t mu, sigma;
   char msgbuff[256];
   unsigned int rows = data->rows;
@@ -112,7 +114,7 @@ void BasicInitialization::initialize(EMMPM_Data::Pointer data)
   unsigned char* y = data->y;
   size_t total;
 
-  total = rows * cols;
+  total = static_cast<size_t>(rows) * cols;
 
   memset(msgbuff, 0, 256);
 
@@ -124,14 +126,14 @@ void BasicInitialization::initialize(EMMPM_Data::Pointer data)
     mu += y[i];
   }
 
-  mu /= (rows * cols);
+  mu /= total;
 
   for (i = 0; i < total; i++)
   {
     sigma += (y[i] - mu) * (y[i] - mu);
   }
 
-  sigma /= (rows * cols);
+  sigma /= total;
   sigma = sqrt((real_t)sigma);
 
   if (classes % 2 == 0)
@@ -182,11 +184,11 @@ UserDefinedAreasInitialization::~UserDefinedAreasInitialization()
 void UserDefinedAreasInitialization::initialize(EMMPM_Data::Pointer data)
 {
 
-  unsigned int i, j;
+  size_t i, j;
   size_t index;
   int c, l;
   real_t mu = 0.0;
-  unsigned int cols = data->columns;
+  size_t cols = data->columns;
   char msgbuff[256];
   unsigned char* y = data->y;
 
@@ -251,7 +253,7 @@ void XtArrayInitialization::initialize(EMMPM_Data::Pointer data)
 {
   size_t total;
 
-  total = data->rows * data->columns;
+  total = static_cast<size_t>(data->rows) * data->columns;
 
   const float rangeMin = 0.0f;
   const float rangeMax = 1.0f;
@@ -305,7 +307,7 @@ void GradientVariablesInitialization::initialize(EMMPM_Data::Pointer data)
   size_t nwCols = data->columns - 1;
   size_t nwRows = data->rows - 1;
 
-  int dims = data->dims;
+  size_t dims = data->dims;
   real_t x;
 
   /* Allocate for edge images */
@@ -320,12 +322,12 @@ void GradientVariablesInitialization::initialize(EMMPM_Data::Pointer data)
   if (data->nw == NULL) { return; }
 
   /* Do edge detection for gradient penalty*/
-  for (uint32_t i = 0; i < data->rows; i++)
+  for (size_t i = 0; i < data->rows; i++)
   {
-    for (uint32_t j = 0; j < nwCols; j++)
+    for (size_t j = 0; j < nwCols; j++)
     {
       x = 0;
-      for (int32_t d = 0; d < dims; d++)
+      for (size_t d = 0; d < dims; d++)
       {
         ijd = (dims * nwCols * i) + (dims * j) + d;
         ijd1 = (dims * nwCols * (i)) + (dims * (j + 1)) + d;
@@ -335,12 +337,12 @@ void GradientVariablesInitialization::initialize(EMMPM_Data::Pointer data)
       data->ns[ij] = data->beta_e * atan((10 - sqrt(x)) / 5);
     }
   }
-  for (uint32_t i = 0; i < nwRows; i++)
+  for (size_t i = 0; i < nwRows; i++)
   {
-    for (uint32_t j = 0; j < data->columns; j++)
+    for (size_t j = 0; j < data->columns; j++)
     {
       x = 0;
-      for (int32_t d = 0; d < dims; d++)
+      for (size_t d = 0; d < dims; d++)
       {
         ijd = (dims * data->columns * i) + (dims * j) + d;
         ijd1 = (dims * data->columns * (i + 1)) + (dims * (j)) + d;
@@ -352,12 +354,12 @@ void GradientVariablesInitialization::initialize(EMMPM_Data::Pointer data)
   }
   nwCols = data->columns - 1;
   nwRows = data->rows - 1;
-  for (uint32_t i = 0; i < nwRows; i++)
+  for (size_t i = 0; i < nwRows; i++)
   {
-    for (uint32_t j = 0; j < nwCols; j++)
+    for (size_t j = 0; j < nwCols; j++)
     {
       x = 0;
-      for (uint32_t d = 0; d < data->dims; d++)
+      for (size_t d = 0; d < dims; d++)
       {
         ijd = (dims * data->columns * i) + (dims * j) + d;
         ijd1 = (dims * data->columns * (i + 1)) + (dims * (j + 1)) + d;
@@ -366,7 +368,7 @@ void GradientVariablesInitialization::initialize(EMMPM_Data::Pointer data)
       ij = (nwCols * i) + j;
       data->sw[ij] = data->beta_e * atan((10 - sqrt(0.5 * x)) / 5);
       x = 0;
-      for (uint32_t d = 0; d < data->dims; d++)
+      for (size_t d = 0; d < dims; d++)
       {
         ijd = (dims * data->columns * (i + 1)) + (dims * (j)) + d;
         ijd1 = (dims * data->columns * (i)) + (dims * (j + 1)) + d;
@@ -411,10 +413,10 @@ void CurvatureInitialization::initialize(EMMPM_Data::Pointer data)
 // -----------------------------------------------------------------------------
 void CurvatureInitialization::initCurvatureVariables(EMMPM_Data::Pointer data)
 {
-  int l, lij;
-  unsigned int i, j;
+  int l;
+  size_t i, j, lij;
 
-  data->ccost = (real_t*)malloc(data->classes * data->rows * data->columns * sizeof(real_t));
+  data->ccost = (real_t*)malloc(static_cast<size_t>(data->classes) * data->rows * data->columns * sizeof(real_t));
   if (data->ccost == NULL) { return; }
 
   /* Initialize Curve Costs to zero */
@@ -425,7 +427,7 @@ void CurvatureInitialization::initCurvatureVariables(EMMPM_Data::Pointer data)
       for (j = 0; j < data->columns; j++)
       {
         {
-          lij = (data->columns * data->rows * l) + (data->columns * i) + j;
+          lij = EMMPMUtilities::ClassPixelIndex(l, i, j, data->rows, data->columns);
           data->ccost[lij] = 0;
         }
       }
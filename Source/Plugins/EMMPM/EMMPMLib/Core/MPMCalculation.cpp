@@ -49,10 +49,9 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 #include <stdio.h>
 
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/uniform_real.hpp>
-#include <boost/random/variate_generator.hpp>
+#include <vector>
 
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "EMMPMLib/Core/EMMPM.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
@@ -60,32 +59,40 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "EMMPMLib/Common/EMTime.h"
 #include "EMMPMLib/Core/EMMPMUtilities.h"
 
-#define USE_TBB_TASK_GROUP 0
 #if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-#include <tbb/task_scheduler_init.h>
 #include <tbb/parallel_for.h>
-#include <tbb/blocked_range2d.h>
+#include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_group.h>
-
 #endif
 
-#define COMPUTE_C_CLIQUE( C, x, y, ci, cj)\
-  if((x) < 0 || (x) >= colEnd || (y) < 0 || (y) >= rowEnd) {\
-    C[ci][cj] = classes;\
-  }\
-  else\
-  {\
-    ij = (cols * (y)) + (x);\
-    C[ci][cj] = xt[ij];\
+namespace MPMDetail
+{
+  // Thickness of the slabs the image is split into, in slices for a volume or in rows for a single
+  // image. The even slabs are updated first and then the odd ones, so no slab reads labels that
+  // another thread is writing; the neighboring slabs act as the halo. The thickness is fixed so the
+  // segmentation does not depend on the number of threads.
+  static const int k_SlabThickness = 8;
+
+  /**
+   * @brief CounterUniform Returns a uniform random number in [0, 1) that depends only on the seed and
+   * the counter (a SplitMix64 hash). Every voxel of every MPM loop draws its own number this way, so
+   * nothing has to be stored up front or generated in sequence.
+   */
+  inline real_t CounterUniform(uint64_t seed, uint64_t counter)
+  {
+    uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return static_cast<real_t>(z >> 40) * (1.0f / 16777216.0f);
   }
-
-
-
+}
 
 /**
- * @class ParallelCalcLoop ParallelCalcLoop.h EMMPM/Curvature/ParallelCalcLoop.h
- * @brief This class can calculate the parts of the MPM loop in parallel
+ * @class ParallelMPMLoop ParallelMPMLoop.h EMMPM/Curvature/ParallelMPMLoop.h
+ * @brief This class updates the labels of one pass of slabs of the MPM loop in parallel. The
+ * image is a stack of data->slices slices of (data->rows / data->slices) rows each. The clique of
+ * a voxel is its 8 neighbors in the slice plus, for a volume, the voxels directly above and below.
  *
  * @date March 11, 2012
  * @version 1.0
@@ -93,37 +100,46 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 class ParallelMPMLoop
 {
   public:
-#if USE_TBB_TASK_GROUP
-    ParallelCalcLoop(EMMPM_Data* dPtr, real_t* ykPtr, real_t* rnd, int rowStart, int rowEnd,
-                     int colStart, int colEnd) :
-      m_RowStart(rowStart),
-      m_RowEnd(rowEnd),
-      m_ColStart(colStart),
-      m_ColEnd(colEnd),
-#else
-    ParallelMPMLoop(EMMPM_Data * dPtr, real_t* ykPtr, real_t* rnd) :
-#endif
-
+    ParallelMPMLoop(EMMPM_Data* dPtr, const real_t* ykPtr, const real_t* couplingPtr, uint64_t seed, uint64_t counterOffset, int parity) :
       data(dPtr),
       yk(ykPtr),
-      rnd(rnd)
+      coupling(couplingPtr),
+      m_Seed(seed),
+      m_CounterOffset(counterOffset),
+      m_Parity(parity)
     {}
     virtual ~ParallelMPMLoop() {}
 
+    /**
+     * @brief calcSlabs Updates the slabs (2 * s + parity) for s in [start, end)
+     */
+    void calcSlabs(int start, int end) const
+    {
+      int extent = (data->slices > 1) ? data->slices : data->rows;
+      for (int s = start; s < end; s++)
+      {
+        int slabStart = (2 * s + m_Parity) * MPMDetail::k_SlabThickness;
+        int slabEnd = slabStart + MPMDetail::k_SlabThickness;
+        if (slabEnd > extent) { slabEnd = extent; }
+        calc(slabStart, slabEnd);
+      }
+    }
 
-    void calc(int rowStart, int rowEnd,
-              int colStart, int colEnd) const
+    /**
+     * @brief calc Updates the labels of the slices [start, end) of a volume, or the rows [start, end) of
+     * a single image
+     */
+    void calc(int start, int end) const
     {
-      //uint64_t millis = EMMPM_getMilliSeconds();
-      //  int l;
-      real_t prior;
-      int32_t ij, lij;
-      int rows = data->rows;
-      int cols = data->columns;
       int classes = data->classes;
+      int slices = data->slices;
+      int cols = data->columns;
+      int sliceRows = data->rows / slices;
+      size_t totalVoxels = static_cast<size_t>(cols) * data->rows;
 
-      real_t xrnd, current;
-      real_t post[EMMPM_MAX_CLASSES], sum, edge;
+      int zStart = 0, zEnd = 1, rowStart = 0, rowEnd = sliceRows;
+      if (slices > 1) { zStart = start; zEnd = end; }
+      else { rowStart = start; rowEnd = end; }
 
       size_t nsCols = data->columns - 1;
       size_t ewCols = data->columns;
@@ -132,174 +148,145 @@ class ParallelMPMLoop
 
       unsigned char* xt = data->xt;
       real_t* probs = data->probs;
-      real_t* ccost = data->ccost;
-      real_t* ns = data->ns;
-      real_t* ew = data->ew;
-      real_t* sw = data->sw;
-      real_t* nw = data->nw;
-      real_t curvature_value = (real_t)0.0;
-
-
-      int C[3][3]; // This is the Clique for the current Pixel
-//      --------- X -----
-//      |   | 0 | 1 | 2 |
-//      -----------------
-//   Y  | 0 |   |   |   |
-//      -----------------
-//      | 1 |   | P |   |
-//      -----------------
-//      | 2 |   |   |   |
-//
-// When we calculate the "C" matrix if the pixel value for the specific index of
-// the clique would be off the image then a value = number of classes is
-// used for the C[i][j]. That way we can figure out if we are off the image
-
-      std::stringstream ss;
-      unsigned int cSize = classes + 1;
-      real_t* coupling = data->couplingBeta;
-
-      for (int32_t y = rowStart; y < rowEnd; y++)
+      const real_t* ccost = data->ccost;
+      const real_t* ns = data->ns;
+      const real_t* ew = data->ew;
+      const real_t* sw = data->sw;
+      const real_t* nw = data->nw;
+      bool useGradientPenalty = (data->useGradientPenalty != 0);
+      bool useCurvaturePenalty = (data->useCurvaturePenalty != 0);
+      real_t kappa = data->workingKappa;
+
+      // Labels of the clique; a value of "classes" marks a neighbor that is off the image
+      //      --------- X -----
+      //      |   | 0 | 1 | 2 |
+      //      -----------------
+      //   Y  | 0 | 0 | 1 | 2 |
+      //      -----------------
+      //      | 1 | 3 | P | 4 |
+      //      -----------------
+      //      | 2 | 5 | 6 | 7 |
+      //  plus 8 (slice below) and 9 (slice above)
+      int clique[10];
+      real_t edges[8];
+      real_t arg[EMMPM_MAX_CLASSES];
+      real_t post[EMMPM_MAX_CLASSES];
+      int numNeighbors = (slices > 1) ? 10 : 8;
+
+      for (int32_t z = zStart; z < zEnd; z++)
       {
-        for (int32_t x = colStart; x < colEnd; x++)
+        for (int32_t y = rowStart; y < rowEnd; y++)
         {
-
-          /* -------------  */
-          COMPUTE_C_CLIQUE(C, x - 1, y - 1, 0, 0);
-          COMPUTE_C_CLIQUE(C,   x, y - 1, 1, 0);
-          COMPUTE_C_CLIQUE(C, x + 1, y - 1, 2, 0);
-          COMPUTE_C_CLIQUE(C, x - 1,   y, 0, 1);
-          COMPUTE_C_CLIQUE(C, x + 1,   y, 2, 1);
-          COMPUTE_C_CLIQUE(C, x - 1, y + 1, 0, 2);
-          COMPUTE_C_CLIQUE(C,   x, y + 1, 1, 2);
-          COMPUTE_C_CLIQUE(C, x + 1, y + 1, 2, 2);
-
-#if 0
-          if (y == rowStart + 1 && x == colStart + 1)
-          {
-            ss << "------------------------------" << std::endl;
-            ss << "|" << C[0][0] << "\t" << C[1][0] << "\t" << C[2][0] << std::endl;
-            ss << "|" << C[0][1] << "\t" << C[1][1] << "\t" << C[2][1] << std::endl;
-            ss << "|" << C[0][2] << "\t" << C[1][2] << "\t" << C[2][2] << std::endl;
-            ss << "------------------------------" << std::endl;
-            std::cout << ss.str() << std::endl;
-          }
-#endif
-
-          ij = (cols * y) + x;
-          sum = 0;
-          for (int l = 0; l < classes; ++l)
+          // Row of the stacked image; the gradient arrays are indexed by it. Voxel indices are
+          // 64 bit since a volume can hold more than 2^31 voxels.
+          size_t row = static_cast<size_t>(z) * sliceRows + y;
+          for (int32_t x = 0; x < cols; x++)
           {
-            prior = 0;
-            edge = 0;
-
-            prior += coupling[(cSize * l) + C[0][0]];
-            prior += coupling[(cSize * l) + C[1][0]];
-            prior += coupling[(cSize * l) + C[2][0]];
-            prior += coupling[(cSize * l) + C[0][1]];
-            prior += coupling[(cSize * l) + C[2][1]];
-            prior += coupling[(cSize * l) + C[0][2]];
-            prior += coupling[(cSize * l) + C[1][2]];
-            prior += coupling[(cSize * l) + C[2][2]];
-
-#if 0
-            if (y == rowStart + 1 && x == colStart + 1)
+            size_t ij = (static_cast<size_t>(cols) * row) + x;
+            bool north = (y > 0), south = (y < sliceRows - 1);
+            bool west = (x > 0), east = (x < cols - 1);
+
+            clique[0] = (north && west) ? xt[ij - cols - 1] : classes;
+            clique[1] = (north) ? xt[ij - cols] : classes;
+            clique[2] = (north && east) ? xt[ij - cols + 1] : classes;
+            clique[3] = (west) ? xt[ij - 1] : classes;
+            clique[4] = (east) ? xt[ij + 1] : classes;
+            clique[5] = (south && west) ? xt[ij + cols - 1] : classes;
+            clique[6] = (south) ? xt[ij + cols] : classes;
+            clique[7] = (south && east) ? xt[ij + cols + 1] : classes;
+            if (slices > 1)
             {
-              std::cout << "Class: " << l << "\t prior: " << prior << std::endl;
+              size_t sliceSize = static_cast<size_t>(cols) * sliceRows;
+              clique[8] = (z > 0) ? xt[ij - sliceSize] : classes;
+              clique[9] = (z < slices - 1) ? xt[ij + sliceSize] : classes;
             }
-#endif
 
-            // now check for the gradient penalty. If our current class is NOT equal
-            // to the class at index[i][j] AND the value of C[i][j] does NOT equal
-            // to the Number of Classes then add in the gradient penalty.
-            if (data->useGradientPenalty)
+            // Evaluate the exponent for all classes at once: the likelihood, then one row of the
+            // transposed coupling table per neighbor
+            const real_t* ykVoxel = yk + ij * classes;
+            for (int l = 0; l < classes; ++l)
             {
-              if (C[0][0] != l && C[0][0] != classes) { edge += sw[(swCols * (y - 1)) + x - 1]; }
-              if (C[1][0] != l && C[1][0] != classes) { edge += ew[(ewCols * (y - 1)) + x]; }
-              if (C[2][0] != l && C[2][0] != classes) { edge += nw[(nwCols * (y - 1)) + x]; }
-              if (C[0][1] != l && C[0][1] != classes) { edge += ns[(nsCols * y) + x - 1]; }
-              if (C[2][1] != l && C[2][1] != classes) { edge += ns[(nsCols * y) + x]; }
-              if (C[0][2] != l && C[0][2] != classes) { edge += nw[(nwCols * y) + x - 1]; }
-              if (C[1][2] != l && C[1][2] != classes) { edge += ew[(ewCols * y) + x]; }
-              if (C[2][2] != l && C[2][2] != classes) { edge += sw[(swCols * y) + x]; }
+              arg[l] = ykVoxel[l] - data->w_gamma[l];
+            }
+            for (int n = 0; n < numNeighbors; ++n)
+            {
+              const real_t* couplingRow = coupling + clique[n] * classes;
+              for (int l = 0; l < classes; ++l)
+              {
+                arg[l] -= couplingRow[l];
+              }
             }
 
-
-            lij = (cols * rows * l) + (cols * y) + x;
-            curvature_value = 0.0;
-            if (data->useCurvaturePenalty)
+            // The gradient penalty of an in-plane neighbor applies to every class except the
+            // neighbor's own, so subtract it from all classes and give it back to that one
+            if (useGradientPenalty)
             {
-              curvature_value = data->beta_c * ccost[lij];
+              edges[0] = (north && west) ? sw[(swCols * (row - 1)) + x - 1] : 0.0f;
+              edges[1] = (north) ? ew[(ewCols * (row - 1)) + x] : 0.0f;
+              edges[2] = (north && east) ? nw[(nwCols * (row - 1)) + x] : 0.0f;
+              edges[3] = (west) ? ns[(nsCols * row) + x - 1] : 0.0f;
+              edges[4] = (east) ? ns[(nsCols * row) + x] : 0.0f;
+              edges[5] = (south && west) ? nw[(nwCols * row) + x - 1] : 0.0f;
+              edges[6] = (south) ? ew[(ewCols * row) + x] : 0.0f;
+              edges[7] = (south && east) ? sw[(swCols * row) + x] : 0.0f;
+              for (int n = 0; n < 8; ++n)
+              {
+                if (clique[n] == classes) { continue; }
+                for (int l = 0; l < classes; ++l)
+                {
+                  arg[l] -= edges[n];
+                }
+                arg[clique[n]] += edges[n];
+              }
             }
-            real_t arg = data->workingKappa * (yk[lij] - (prior) - (edge) - (curvature_value) - data->w_gamma[l]);
-            post[l] = expf(arg);
-            sum += post[l];
-          }
 
-          xrnd = rnd[ij];
-          current = 0.0;
+            if (useCurvaturePenalty)
+            {
+              for (int l = 0; l < classes; ++l)
+              {
+                arg[l] -= data->beta_c * ccost[(totalVoxels * l) + ij];
+              }
+            }
 
-          for (int l = 0; l < classes; l++)
-          {
-            lij = (cols * rows * l) + ij;
-            real_t arg = post[l] / sum;
-            if ((xrnd >= current) && (xrnd <= (current + arg)))
+            real_t sum = 0;
+            for (int l = 0; l < classes; ++l)
             {
-              xt[ij] = l;
-              probs[lij] += 1.0;
+              post[l] = expf(kappa * arg[l]);
+              sum += post[l];
             }
-            current += arg;
-          }
-#if 0
-          Dont even THINK about using this code...
-          This classifys the pixel based on the largest
-          in magnitude  probability
-          real_t max = 0.0;
-          int maxClass = 0;
-          for (int l = 0; l < classes; l++)
-          {
-            lij = (cols * rows * l) + ij;
-            //real_t arg = post[l] / sum;
-            if (probs[lij] > max)
+
+            real_t xrnd = MPMDetail::CounterUniform(m_Seed, m_CounterOffset + ij);
+            real_t current = 0.0;
+            for (int l = 0; l < classes; l++)
             {
-              max = probs[lij];
-              maxClass = l;
+              size_t lij = (totalVoxels * l) + ij;
+              real_t p = post[l] / sum;
+              if ((xrnd >= current) && (xrnd <= (current + p)))
+              {
+                xt[ij] = l;
+                probs[lij] += 1.0;
+              }
+              current += p;
             }
           }
-          //Assign class based on Maximum probability
-          xt[ij] = maxClass;
-#endif
         }
       }
-      //  std::cout << "     --" << EMMPM_getMilliSeconds() - millis << "--" << std::endl;
     }
 
-
 #if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-#if USE_TBB_TASK_GROUP
-    void operator()() const
-    {
-      calc(m_RowStart, m_RowEnd, m_ColStart, m_ColEnd);
-    }
-#else
-    void operator()(const tbb::blocked_range2d<int>& r) const
+    void operator()(const tbb::blocked_range<int>& r) const
     {
-      calc(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+      calcSlabs(r.begin(), r.end());
     }
 #endif
-#endif
-
 
   private:
-#if USE_TBB_TASK_GROUP
-    int m_RowStart;
-    int m_RowEnd;
-    int m_ColStart;
-    int m_ColEnd;
-#endif
-    const EMMPM_Data* data;
+    EMMPM_Data* data;
     const real_t* yk;
-    const real_t* rnd;
-
+    const real_t* coupling;
+    uint64_t m_Seed;
+    uint64_t m_CounterOffset;
+    int m_Parity;
 };
 
 // -----------------------------------------------------------------------------
@@ -328,37 +315,31 @@ void MPMCalculation::execute()
 
   real_t* yk;
   real_t sqrt2pi, con[EMMPM_MAX_CLASSES];
-  real_t post[EMMPM_MAX_CLASSES];
 
-  // int k, l;
-// unsigned int i, j, d;
   size_t ld, ijd, lij;
   unsigned int dims = data->dims;
   unsigned int rows = data->rows;
   unsigned int cols = data->columns;
   unsigned int classes = data->classes;
 
-//  int rowEnd = rows/2;
   unsigned char* y = data->y;
   real_t* probs = data->probs;
   real_t* m = data->mean;
   real_t* v = data->variance;
 
-  char msgbuff[256];
   float totalLoops;
 
   int currentLoopCount;
 
-//  real_t curvature_value = (real_t)0.0;
-
-  memset(post, 0, EMMPM_MAX_CLASSES * sizeof(real_t));
   memset(con, 0,  EMMPM_MAX_CLASSES * sizeof(real_t));
 
   totalLoops = (float)(data->emIterations * data->mpmIterations + data->mpmIterations);
-  memset(msgbuff, 0, 256);
   data->progress++;
 
-  yk = (real_t*)malloc(cols * rows * classes * sizeof(real_t));
+  size_t total = static_cast<size_t>(rows) * cols;
+
+  // The class likelihoods are stored voxel by voxel so all classes of a voxel are contiguous
+  yk = (real_t*)malloc(total * classes * sizeof(real_t));
 
   sqrt2pi = sqrt(2.0 * M_PI);
 
@@ -372,48 +353,44 @@ void MPMCalculation::execute()
     }
   }
 
-  for (uint32_t i = 0; i < rows; i++)
+  for (size_t ij = 0; ij < total; ij++)
   {
-    for (uint32_t j = 0; j < cols; j++)
+    for (uint32_t l = 0; l < classes; l++)
     {
-      for (uint32_t l = 0; l < classes; l++)
+      lij = (total * l) + ij;
+      probs[lij] = 0;
+      real_t value = con[l];
+      for (uint32_t d = 0; d < dims; d++)
       {
-        lij = (cols * rows * l) + (cols * i) + j;
-        probs[lij] = 0;
-        yk[lij] = con[l];
-        for (uint32_t d = 0; d < dims; d++)
-        {
-          ld = dims * l + d;
-          ijd = (dims * cols * i) + (dims * j) + d;
-          yk[lij] += ((y[ijd] - m[ld]) * (y[ijd] - m[ld]) / (-2.0 * v[ld]));
-        }
+        ld = dims * l + d;
+        ijd = (dims * ij) + d;
+        value += ((y[ijd] - m[ld]) * (y[ijd] - m[ld]) / (-2.0 * v[ld]));
       }
+      yk[(ij * classes) + l] = value;
     }
   }
 
-  const float rangeMin = 0;
-  const float rangeMax = 1.0f;
-  typedef boost::uniform_real<real_t> NumberDistribution;
-  typedef boost::mt19937 RandomNumberGenerator;
-  typedef boost::variate_generator<RandomNumberGenerator&,
-          NumberDistribution> Generator;
-
-  NumberDistribution distribution(rangeMin, rangeMax);
-  RandomNumberGenerator generator;
-  Generator numberGenerator(generator, distribution);
-  generator.seed(EMMPM_getMilliSeconds()); // seed with the current time
-
-  // Generate all the numbers up front
-  size_t total = rows * cols;
-  std::vector<real_t> rndNumbers(total);
-  real_t* rndNumbersPtr = &(rndNumbers.front());
-  for(size_t i = 0; i < total; ++i)
+  // Transpose the coupling matrix so that the couplings of one neighbor label to every class are
+  // contiguous. Row "classes" holds the zero coupling of a neighbor that is off the image.
+  unsigned int cSize = classes + 1;
+  std::vector<real_t> couplingByNeighbor(cSize * classes, 0.0f);
+  for (uint32_t c = 0; c < cSize; c++)
   {
-    rndNumbersPtr[i] = numberGenerator(); // Work directly with the pointer for speed.
+    for (uint32_t l = 0; l < classes; l++)
+    {
+      couplingByNeighbor[(c * classes) + l] = data->couplingBeta[(cSize * l) + c];
+    }
   }
 
-  //unsigned long long int millis = EMMPM_getMilliSeconds();
-  //std::cout << "------------------------------------------------" << std::endl;
+  uint64_t seed = EMMPM_getMilliSeconds(); // seed with the current time
+  int slabExtent = (data->slices > 1) ? data->slices : rows;
+  int numSlabs = (slabExtent + MPMDetail::k_SlabThickness - 1) / MPMDetail::k_SlabThickness;
+
+#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
+#endif
+
   /* Perform the MPM loops */
   for (int32_t k = 0; k < data->mpmIterations; k++)
   {
@@ -422,39 +399,22 @@ void MPMCalculation::execute()
     if (data->cancel) { data->progress = 100.0; break; }
     data->inside_mpm_loop = 1;
 
-#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-    tbb::task_scheduler_init init;
-    int threads = init.default_num_threads();
-#if USE_TBB_TASK_GROUP
-    tbb::task_group* g = new tbb::task_group;
-    unsigned int rowIncrement = rows / threads;
-    unsigned int rowStop = 0 + rowIncrement;
-    unsigned int rowStart = 0;
-    for (int t = 0; t < threads; ++t)
+    for (int parity = 0; parity < 2; parity++)
     {
-      g->run(ParallelCalcLoop(data, yk, &(rndNumbers.front()), rowStart, rowStop, 0, cols) );
-      rowStart = rowStop;
-      rowStop = rowStop + rowIncrement;
-      if (rowStop >= rows)
+      ParallelMPMLoop mpmLoop(data, yk, &(couplingByNeighbor.front()), seed, static_cast<uint64_t>(k) * total, parity);
+      int passSlabs = (numSlabs - parity + 1) / 2;
+#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
+      if (doParallel == true)
       {
-        rowStop = rows;
+        tbb::parallel_for(tbb::blocked_range<int>(0, passSlabs), mpmLoop, tbb::simple_partitioner());
       }
-    }
-    g->wait();
-    delete g;
-#else
-    tbb::parallel_for(tbb::blocked_range2d<int>(0, rows, rows / threads, 0, cols, cols),
-                      ParallelMPMLoop(data, yk, &(rndNumbers.front())),
-                      tbb::simple_partitioner());
+      else
 #endif
+      {
+        mpmLoop.calcSlabs(0, passSlabs);
+      }
+    }
 
-#else
-    ParallelMPMLoop pcl(data, yk, &(rndNumbers.front()));
-    pcl.calc(0, rows, 0, cols);
-#endif
-
-
-    //std::cout << "Counter: " << counter << std::endl;
     EMMPMUtilities::ConvertXtToOutputImage(getData());
 
     data->currentMPMLoop = k;
@@ -464,37 +424,20 @@ void MPMCalculation::execute()
     currentLoopCount = data->mpmIterations * data->currentEMLoop + data->currentMPMLoop;
     data->progress = currentLoopCount / totalLoops * 100.0;
 
-    // notify("", data->progress, UpdateProgressValue);
     if (m_StatsDelegate != NULL)
     {
       m_StatsDelegate->reportProgress(m_Data);
     }
   }
-#if 0
-#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-  std::cout << "Parrallel MPM Loop Time to Complete:";
-#else
-  std::cout << "Serial MPM Loop Time To Complete: ";
-#endif
-  std::cout << (EMMPM_getMilliSeconds() - millis) << std::endl;
-#endif
-
 
   data->inside_mpm_loop = 0;
 
   if (!data->cancel)
   {
     /* Normalize probabilities */
-    for (uint32_t i = 0; i < data->rows; i++)
+    for (size_t i = 0; i < total * classes; i++)
     {
-      for (uint32_t j = 0; j < data->columns; j++)
-      {
-        for (uint32_t l = 0; l < classes; l++)
-        {
-          lij = (cols * rows * l) + (cols * i) + j;
-          data->probs[lij] = data->probs[lij] / (real_t)data->mpmIterations;
-        }
-      }
+      data->probs[i] = data->probs[i] / (real_t)data->mpmIterations;
     }
   }
 
@@ -510,4 +453,3 @@ const QString MPMCalculation::getHumanLabel()
 {
   return "MPMCalculation";
 }
-
@@ -48,6 +48,8 @@
 
 #include "MorphFilt.h"
 
+#include "EMMPMLib/Core/EMMPMUtilities.h"
+
 
 #define NUM_SES 8
 
@@ -109,14 +111,15 @@ void MorphFilter::morphFilt(EMMPM_Data* data, unsigned char* curve, unsigned cha
 
   se_cols = 2 * r + 1;
 
-  erosion = (unsigned char*)malloc(cols * rows * sizeof(unsigned char));
-  ::memset(erosion, 0, cols * rows * sizeof(unsigned char));
+  size_t total = static_cast<size_t>(cols) * rows;
+  erosion = (unsigned char*)malloc(total * sizeof(unsigned char));
+  ::memset(erosion, 0, total * sizeof(unsigned char));
 
   for (int i = 0; i < rows; i++)
   {
     for (int j = 0; j < cols; j++)
     {
-      ij = (cols * i) + j;
+      ij = (static_cast<size_t>(cols) * i) + j;
 
       curve[ij] = classes;
       l = data->xt[ij];
@@ -129,7 +132,7 @@ void MorphFilter::morphFilt(EMMPM_Data* data, unsigned char* curve, unsigned cha
       {
         for (int jj = -mini_jj; jj <= (int)maxc && erosion[ij] == l; jj++)
         {
-          i1j1 = (cols * (i + ii)) + (j + jj);
+          i1j1 = (static_cast<size_t>(cols) * (i + ii)) + (j + jj);
           iirjjr = (se_cols * (ii + r)) + (jj + r);
           if (se[iirjjr] == 1 && data->xt[i1j1] != l)
           {
@@ -157,11 +160,11 @@ void MorphFilter::morphFilt(EMMPM_Data* data, unsigned char* curve, unsigned cha
         {
           for (int j = maxi_jj; j < (int)maxc; ++j)
           {
-            ij = (cols * i) + j;
+            ij = (static_cast<size_t>(cols) * i) + j;
             l = erosion[ij];
             if (l != (unsigned int)(classes))
             {
-              i1j1 = (cols * (i + ii)) + (j + jj);
+              i1j1 = (static_cast<size_t>(cols) * (i + ii)) + (j + jj);
               curve[i1j1] = l;
             }
           }
@@ -193,7 +196,7 @@ void MorphFilter::multiSE(EMMPM_Data* data)
 
   pnlty = 1 / (real_t)NUM_SES;
 
-  curve = (unsigned char*)malloc(cols * rows * sizeof(unsigned char));
+  curve = (unsigned char*)malloc(static_cast<size_t>(cols) * rows * sizeof(unsigned char));
 
   for (k = 0; k < NUM_SES; k++)
   {
@@ -230,12 +233,12 @@ void MorphFilter::multiSE(EMMPM_Data* data)
     {
       for (int32_t j = 0; j < cols; j++)
       {
-        ij = (cols * i) + j;
+        ij = (static_cast<size_t>(cols) * i) + j;
         l = curve[ij];
         if (l == classes)
         {
           l = data->xt[ij];
-          lij = (cols * rows * l) + (cols * i) + j;
+          lij = EMMPMUtilities::ClassPixelIndex(l, i, j, rows, cols);
           data->ccost[lij] += pnlty;
         }
       }
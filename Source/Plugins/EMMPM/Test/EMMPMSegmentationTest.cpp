@@ -34,6 +34,11 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
 
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 
@@ -42,6 +47,8 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
 #include "SIMPLib/Common/FilterPipeline.h"
 #include "SIMPLib/Common/FilterManager.h"
 #include "SIMPLib/Common/FilterFactory.hpp"
@@ -50,6 +57,9 @@
 #include "SIMPLib/Utilities/UnitTestSupport.hpp"
 #include "SIMPLib/Utilities/QMetaObjectUtilities.h"
 
+#include "EMMPM/EMMPMLib/Core/EMMPM_Data.h"
+#include "EMMPM/EMMPMLib/Core/EMMPMUtilities.h"
+
 #include "EMMPMTestFileLocations.h"
 
 enum ErrorCodes
@@ -308,6 +318,192 @@ int TestMultiEMMPMSegmentation()
   return EXIT_SUCCESS;
 }
 
+// -----------------------------------------------------------------------------
+// Builds an image of numSlices identical slices of a two phase checkerboard
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer createStackedImage(size_t numSlices)
+{
+  size_t dims[3] = { 48, 40, numSlices };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New("ImageDataContainer");
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, "CellData", DREAM3D::AttributeMatrixType::Cell);
+  UInt8ArrayType::Pointer gray = UInt8ArrayType::CreateArray(tDims, cDims, "Gray");
+  size_t index = 0;
+  for (size_t z = 0; z < dims[2]; z++)
+  {
+    for (size_t y = 0; y < dims[1]; y++)
+    {
+      for (size_t x = 0; x < dims[0]; x++)
+      {
+        uint8_t base = (((x / 8) + (y / 8)) % 2 == 0) ? 50 : 200;
+        gray->setValue(index++, base + static_cast<uint8_t>((x * 7 + y * 3) % 5));
+      }
+    }
+  }
+  cellAttrMat->addAttributeArray(gray->getName(), gray);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+UInt8ArrayType::Pointer segmentStackedImage(size_t numSlices)
+{
+  DataContainerArray::Pointer dca = createStackedImage(numSlices);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("EMMPMFilter");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath("ImageDataContainer", "CellData", "Gray"));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputDataArrayPath", var), true)
+  var.setValue(DataArrayPath("ImageDataContainer", "CellData", "Segmented"));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("OutputDataArrayPath", var), true)
+  var.setValue(2);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumClasses", var), true)
+
+  filter->execute();
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), NO_ERROR)
+
+  IDataArray::Pointer iDataArray = dca->getDataContainer("ImageDataContainer")->getAttributeMatrix("CellData")->getAttributeArray("Segmented");
+  UInt8ArrayType::Pointer segmented = boost::dynamic_pointer_cast<UInt8ArrayType>(iDataArray);
+  DREAM3D_REQUIRE(segmented.get() != NULL)
+  return segmented;
+}
+
+// -----------------------------------------------------------------------------
+// A volume is segmented in one pass with the slices above and below in the MPM
+// clique; a stack of identical, well separated slices must give every slice the
+// labels of the single image
+// -----------------------------------------------------------------------------
+int TestVolumeMatchesSingleSlice()
+{
+  const size_t numSlices = 6;
+  UInt8ArrayType::Pointer slice = segmentStackedImage(1);
+  UInt8ArrayType::Pointer volume = segmentStackedImage(numSlices);
+
+  size_t sliceSize = slice->getNumberOfTuples();
+  DREAM3D_REQUIRE_EQUAL(volume->getNumberOfTuples(), sliceSize * numSlices)
+
+  // Both phases must have been found
+  uint8_t minLabel = slice->getValue(0);
+  uint8_t maxLabel = slice->getValue(0);
+  for (size_t i = 1; i < sliceSize; i++)
+  {
+    minLabel = std::min(minLabel, slice->getValue(i));
+    maxLabel = std::max(maxLabel, slice->getValue(i));
+  }
+  DREAM3D_REQUIRE(minLabel != maxLabel)
+
+  for (size_t z = 0; z < numSlices; z++)
+  {
+    for (size_t i = 0; i < sliceSize; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(volume->getValue(z * sliceSize + i), slice->getValue(i))
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// The per class arrays of a stacked volume can hold more than 2^31 entries, so the
+// index math must be done in 64 bit
+// -----------------------------------------------------------------------------
+void TestIndexMath()
+{
+  // 1024 x 1024 x 600 voxels segmented into 4 classes
+  const uint64_t cols = 1024;
+  const uint64_t rows = 1024 * 600;
+  const uint64_t classes = 4;
+
+  uint64_t last = EMMPMUtilities::ClassPixelIndex(classes - 1, rows - 1, cols - 1, rows, cols);
+  DREAM3D_REQUIRE_EQUAL(last, classes * rows * cols - 1)
+  if (sizeof(size_t) > 4)
+  {
+    DREAM3D_REQUIRE(last > static_cast<uint64_t>(std::numeric_limits<int32_t>::max()))
+  }
+  DREAM3D_REQUIRE_EQUAL(EMMPMUtilities::ClassPixelIndex(2, 7, 5, rows, cols), 2 * rows * cols + 7 * cols + 5)
+
+  const uint64_t dims = 3;
+  uint64_t lastComponent = EMMPMUtilities::PixelComponentIndex(rows - 1, cols - 1, dims - 1, cols, dims);
+  DREAM3D_REQUIRE_EQUAL(lastComponent, rows * cols * dims - 1)
+  DREAM3D_REQUIRE_EQUAL(EMMPMUtilities::PixelComponentIndex(7, 5, 1, cols, dims), 7 * cols * dims + 5 * dims + 1)
+}
+
+// -----------------------------------------------------------------------------
+// The mean and variance of each class are the probability weighted moments of the pixels
+// -----------------------------------------------------------------------------
+void TestUpdateMeansAndVariances()
+{
+  EMMPM_Data::Pointer data = EMMPM_Data::New();
+  data->rows = 6;
+  data->columns = 5;
+  data->slices = 1;
+  data->dims = 1;
+  data->classes = 3;
+  DREAM3D_REQUIRE_EQUAL(data->allocateDataStructureMemory(), 0)
+
+  size_t total = static_cast<size_t>(data->rows) * data->columns;
+  for (size_t i = 0; i < total; i++)
+  {
+    data->y[i] = static_cast<unsigned char>((i * 37) % 251);
+    real_t p0 = static_cast<real_t>((i % 3) + 1);
+    real_t p1 = static_cast<real_t>((i % 5) + 1);
+    real_t p2 = static_cast<real_t>((i % 7) + 1);
+    real_t sum = p0 + p1 + p2;
+    data->probs[i] = p0 / sum;
+    data->probs[total + i] = p1 / sum;
+    data->probs[2 * total + i] = p2 / sum;
+  }
+  for (int l = 0; l < data->classes; l++)
+  {
+    data->min_variance[l] = 0.0;
+  }
+
+  EMMPMUtilities::ZeroMeanVariance(data->classes, data->dims, data->mean, data->variance, data->N);
+  EMMPMUtilities::UpdateMeansAndVariances(data);
+
+  for (int l = 0; l < data->classes; l++)
+  {
+    double n = 0.0;
+    double mean = 0.0;
+    for (size_t i = 0; i < total; i++)
+    {
+      n += data->probs[l * total + i];
+      mean += data->y[i] * data->probs[l * total + i];
+    }
+    mean /= n;
+    double variance = 0.0;
+    for (size_t i = 0; i < total; i++)
+    {
+      variance += (data->y[i] - data->mean[l]) * (data->y[i] - data->mean[l]) * data->probs[l * total + i];
+    }
+    variance /= n;
+
+    DREAM3D_REQUIRED(fabs(data->N[l] - n), <, 1.0E-4)
+    DREAM3D_REQUIRED(fabs(data->mean[l] - mean), <, 1.0E-3)
+    DREAM3D_REQUIRED(fabs(data->variance[l] - variance), <, 1.0E-1)
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -337,8 +533,12 @@ int main(int argc, char** argv)
   DREAM3D_REGISTER_TEST( loadFilterPlugins() );
   DREAM3D_REGISTER_TEST( TestFilterAvailability() );
 
+  DREAM3D_REGISTER_TEST(TestIndexMath())
+  DREAM3D_REGISTER_TEST(TestUpdateMeansAndVariances())
+
   DREAM3D_REGISTER_TEST(TestEMMPMSegmentation())
   DREAM3D_REGISTER_TEST(TestMultiEMMPMSegmentation())
+  DREAM3D_REGISTER_TEST(TestVolumeMatchesSingleSlice())
 
   DREAM3D_REGISTER_TEST(RemoveTestFiles())
   PRINT_TEST_SUMMARY();
@@ -46,6 +46,8 @@
 #include <sstream>
 
 
+#include "SIMPLib/Utilities/ParallelContext.h"
+
 #include "EMMPMLib/EMMPMLib.h"
 #include "EMMPMLib/Common/MSVCDefines.h"
 #include "EMMPMLib/Common/EMTime.h"
@@ -58,10 +60,6 @@
 #include "EMMPMLib/Core/InitializationFunctions.h"
 #include "EMMPMLib/Core/EMMPMUtilities.h"
 
-#if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-#include <tbb/task_scheduler_init.h>
-#endif
-
 class CLIStatsDelegate : public StatsDelegate
 {
   public:
@@ -149,8 +147,8 @@ int main(int argc, char* argv[])
 //  unsigned long long int millis = EMMPM_getMilliSeconds();
 
 #if defined (EMMPM_USE_PARALLEL_ALGORITHMS)
-  tbb::task_scheduler_init init;
-  std::cout << "Default Number of Threads: " << init.default_num_threads() << std::endl;
+  ParallelContext::Scheduler scheduler;
+  std::cout << "Number of Threads: " << scheduler.getNumberOfThreads() << std::endl;
 #endif
 
   int err = 0;
@@ -43,6 +43,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/FeatureReductions.hpp"
 
 #include "Generic/GenericConstants.h"
 
@@ -175,13 +176,11 @@ void FindFeaturePhases::execute()
   if(getErrorCondition() < 0) { return; }
 
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  int32_t gnum = 0;
-  for (size_t i = 0; i < totalPoints; i++)
-  {
-    gnum = m_FeatureIds[i];
-    m_FeaturePhases[gnum] = m_CellPhases[i];
-  }
+  FeatureReductionEngine engine(m_FeatureIds, totalPoints, totalFeatures);
+  engine.addReduction(FeatureCellValueReduction<int32_t>::New(m_CellPhases, m_FeaturePhases));
+  engine.execute();
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -13,6 +13,7 @@ START_FILTER_GROUP(${Generic_BINARY_DIR} "${_filterGroupName}" "Generic")
 #---------
 # List your public filters here
 set(_PublicFilters
+ComputeFeatureBasics
 FindBoundaryCells
 FindBoundingBoxFeatures
 FindFeatureCentroids
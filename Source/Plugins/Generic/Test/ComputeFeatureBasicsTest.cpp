@@ -0,0 +1,243 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "GenericTestFileLocations.h"
+
+#define COMPUTE_FEATURE_BASICS_FILTER_NAME "ComputeFeatureBasics"
+
+static const QString DCName("ComputeFeatureBasicsTest");
+static const size_t k_NumFeatures = 40;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the ComputeFeatureBasics Filter from the FilterManager
+  QString filtName = COMPUTE_FEATURE_BASICS_FILTER_NAME;
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The ComputeFeatureBasicsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Generic Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer initializeDataContainerArray(size_t dims[3], float res[3])
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::FeatureIds);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Phases);
+
+  // Feature ids are handed out in runs so that every Feature is split among several threads,
+  // and the last Feature is left without cells
+  srand(4321);
+  size_t numCells = dims[0] * dims[1] * dims[2];
+  for (size_t i = 0; i < numCells; i++)
+  {
+    int32_t feature = static_cast<int32_t>(((i / 53) * 11 + rand() % 3) % (k_NumFeatures - 1));
+    featureIds->setValue(i, feature);
+    phases->setValue(i, 1 + feature % 2);
+  }
+  cellAttrMat->addAttributeArray(featureIds->getName(), featureIds);
+  cellAttrMat->addAttributeArray(phases->getName(), phases);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+  QVector<size_t> fDims(1, k_NumFeatures);
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(fDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+// Runs the filter and compares its output against the serial loops of
+// FindFeaturePhases, FindFeatureCentroids and FindSizes
+// -----------------------------------------------------------------------------
+void TestComputeFeatureBasics(int numThreads)
+{
+  size_t dims[3] = { 31, 27, 19 };
+  float res[3] = { 0.5f, 0.25f, 2.0f };
+  DataContainerArray::Pointer dca = initializeDataContainerArray(dims, res);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter(COMPUTE_FEATURE_BASICS_FILTER_NAME);
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, ""));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellFeatureAttributeMatrixName", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellPhasesArrayPath", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellAttributeMatrixName);
+  AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellFeatureAttributeMatrixName);
+  int32_t* featureIds = boost::dynamic_pointer_cast<Int32ArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::FeatureIds))->getPointer(0);
+  int32_t* cellPhases = boost::dynamic_pointer_cast<Int32ArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::Phases))->getPointer(0);
+  int32_t* featurePhases = boost::dynamic_pointer_cast<Int32ArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::Phases))->getPointer(0);
+  float* centroids = boost::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::Centroids))->getPointer(0);
+  float* volumes = boost::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::Volumes))->getPointer(0);
+  float* diameters = boost::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::EquivalentDiameters))->getPointer(0);
+  int32_t* numCells = boost::dynamic_pointer_cast<Int32ArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::NumCells))->getPointer(0);
+
+  std::vector<float> centers(5 * k_NumFeatures, 0.0f);
+  std::vector<int32_t> phases(k_NumFeatures, 0);
+  for (size_t i = 0; i < dims[2]; i++)
+  {
+    for (size_t j = 0; j < dims[1]; j++)
+    {
+      for (size_t k = 0; k < dims[0]; k++)
+      {
+        size_t index = (i * dims[1] + j) * dims[0] + k;
+        int32_t gnum = featureIds[index];
+        centers[gnum * 5 + 0]++;
+        centers[gnum * 5 + 1] += float(k) * res[0];
+        centers[gnum * 5 + 2] += float(j) * res[1];
+        centers[gnum * 5 + 3] += float(i) * res[2];
+        phases[gnum] = cellPhases[index];
+      }
+    }
+  }
+
+  float resScalar = res[0] * res[1] * res[2];
+  float volTerm = (4.0f / 3.0f) * SIMPLib::Constants::k_Pi;
+  for (size_t i = 1; i < k_NumFeatures; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(numCells[i], static_cast<int32_t>(centers[i * 5 + 0]))
+    DREAM3D_REQUIRE_EQUAL(featurePhases[i], phases[i])
+    float volume = centers[i * 5 + 0] * resScalar;
+    DREAM3D_COMPARE_FLOATS(volumes[i], volume, 4)
+    if (centers[i * 5 + 0] == 0.0f) { continue; }
+    DREAM3D_COMPARE_FLOATS(diameters[i], 2.0f * powf(volume / volTerm, 0.3333333333f), 4)
+    // The serial loop accumulates in float, the filter in double
+    for (size_t c = 0; c < 3; c++)
+    {
+      float expected = centers[i * 5 + 1 + c] / centers[i * 5 + 0];
+      DREAM3D_REQUIRE(fabsf(centroids[3 * i + c] - expected) <= 1.0e-4f * std::max(1.0f, fabsf(expected)))
+    }
+  }
+  DREAM3D_REQUIRE_EQUAL(numCells[k_NumFeatures - 1], 0)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("ComputeFeatureBasicsTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestComputeFeatureBasics(1) )
+  DREAM3D_REGISTER_TEST( TestComputeFeatureBasics(4) )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
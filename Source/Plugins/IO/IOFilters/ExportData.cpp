@@ -51,6 +51,51 @@
 
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/ParallelRowWriter.h"
+
+/**
+ * @brief The ExportDataRowFormatter class formats tuples of an array, ending the line after every
+ * MaxValPerLine tuples and separating the other tuples with the delimiter
+ */
+template<typename TInputType>
+class ExportDataRowFormatter : public ParallelRowWriter::RowFormatter
+{
+  public:
+    ExportDataRowFormatter(const TInputType* data, int32_t numComps, char delimeter, int32_t maxValPerLine) :
+      m_Data(data),
+      m_NumComps(numComps),
+      m_Delimeter(delimeter),
+      m_MaxValPerLine(maxValPerLine)
+    {}
+    virtual ~ExportDataRowFormatter() {}
+
+    void formatRows(QTextStream& out, size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        for (int32_t j = 0; j < m_NumComps; j++)
+        {
+          out << m_Data[i * m_NumComps + j];
+          if (j < m_NumComps - 1) { out << m_Delimeter; }
+        }
+
+        if ((i + 1) % m_MaxValPerLine == 0)
+        {
+          out << '\n';
+        }
+        else
+        {
+          out << m_Delimeter;
+        }
+      }
+    }
+
+  private:
+    const TInputType* m_Data;
+    int32_t m_NumComps;
+    char m_Delimeter;
+    size_t m_MaxValPerLine;
+};
 
 /**
  * @brief The ExportDataPrivate class is a templated class that implements a method to generically
@@ -89,32 +134,18 @@ class ExportDataPrivate
         return;
       }
 
-      QTextStream out(&file);
-
       int32_t nComp = inputArray->getNumberOfComponents();
 
       TInputType* inputArrayPtr = inputArray->getPointer(0);
       size_t nTuples = inputArray->getNumberOfTuples();
 
-      int32_t recCount = 0;
-      for (size_t i = 0; i < nTuples; i++)
+      ExportDataRowFormatter<TInputType> formatter(inputArrayPtr, nComp, delimeter, MaxValPerLine);
+      ParallelRowWriter writer(filter, QObject::tr("Exporting Dataset '%1'").arg(inputArray->getName()));
+      if (writer.write(file, formatter, 0, nTuples) == false && filter->getCancel() == false)
       {
-        for (int32_t j = 0; j < nComp; j++)
-        {
-          out << inputArrayPtr[i * nComp + j];
-          if (j < nComp - 1) { out << delimeter; }
-        }
-        recCount++;
-
-        if (recCount >= MaxValPerLine)
-        {
-          out << '\n';
-          recCount = 0;
-        }
-        else
-        {
-          out << delimeter;
-        }
+        QString ss = QObject::tr("Error writing to the output file: '%1'").arg(outputFile);
+        filter->setErrorCondition(-11009);
+        filter->notifyErrorMessage(filter->getHumanLabel(), ss, filter->getErrorCondition());
       }
     }
 };
@@ -49,6 +49,41 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "IO/IOConstants.h"
+#include "IO/IOFilters/util/ParallelRowWriter.h"
+
+/**
+ * @brief The FeatureRowFormatter class formats one row of Feature data: the Feature Id followed by
+ * every component of every array
+ */
+class FeatureRowFormatter : public ParallelRowWriter::RowFormatter
+{
+  public:
+    FeatureRowFormatter(const std::vector<IDataArray::Pointer>& data, char delimiter) :
+      m_Data(data),
+      m_Delimiter(delimiter)
+    {}
+    virtual ~FeatureRowFormatter() {}
+
+    void formatRows(QTextStream& out, size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; ++i)
+      {
+        // Print the feature id
+        out << i;
+        // Print a row of data
+        for (std::vector<IDataArray::Pointer>::const_iterator p = m_Data.begin(); p != m_Data.end(); ++p)
+        {
+          out << m_Delimiter;
+          (*p)->printTuple(out, i, m_Delimiter);
+        }
+        out << "\n";
+      }
+    }
+
+  private:
+    const std::vector<IDataArray::Pointer>& m_Data;
+    char m_Delimiter;
+};
 
 // Include the MOC generated file for this class
 #include "moc_FeatureDataCSVWriter.cpp"
@@ -231,31 +266,17 @@ void FeatureDataCSVWriter::execute()
   // Get the number of tuples in the arrays
   size_t numTuples = data[0]->getNumberOfTuples();
 
-  float threshold = 0.0f;
-
   // Skip feature 0
-  for (size_t i = 1; i < numTuples; ++i)
+  outFile.flush();
+  FeatureRowFormatter rowFormatter(data, m_Delimiter);
+  ParallelRowWriter rowWriter(this, "Writing Feature Data");
+  if (rowWriter.write(file, rowFormatter, 1, numTuples) == false)
   {
-    if (((float)i / numTuples) * 100.0f > threshold)
-    {
-      QString ss = QObject::tr("Writing Feature Data || %1% Complete").arg(((float)i / numTuples) * 100.0f);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      threshold = threshold + 5.0f;
-      if (threshold < ((float)i / numTuples) * 100.0f)
-      {
-        threshold = ((float)i / numTuples) * 100.0f;
-      }
-    }
-
-    // Print the feature id
-    outFile << i;
-    // Print a row of data
-    for (std::vector<IDataArray::Pointer>::iterator p = data.begin(); p != data.end(); ++p)
-    {
-      outFile << m_Delimiter;
-      (*p)->printTuple(outFile, i, m_Delimiter);
-    }
-    outFile << "\n";
+    if (getCancel() == true) { return; }
+    QString ss = QObject::tr("Error writing to the output file: %1").arg(getFeatureDataFile());
+    setErrorCondition(-101);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
 
   if (m_WriteNeighborListData == true)
@@ -270,20 +291,24 @@ void FeatureDataCSVWriter::execute()
       {
         outFile << DREAM3D::FeatureData::FeatureID << m_Delimiter << DREAM3D::FeatureData::NumNeighbors << m_Delimiter << (*iter) << "\n";
         numTuples = p->getNumberOfTuples();
-
+        outFile.flush();
+        // Each row is the feature id followed by the tuple, which starts with the list size
+        std::vector<IDataArray::Pointer> list(1, p);
+        FeatureRowFormatter listFormatter(list, m_Delimiter);
+        ParallelRowWriter listWriter(this, QObject::tr("Writing Neighbor Data '%1'").arg(*iter));
         // Skip feature 0
-        for(size_t i = 1; i < numTuples; ++i)
+        if (listWriter.write(file, listFormatter, 1, numTuples) == false)
         {
-          // Print the feature id
-          outFile << i;
-          // Print a row of data
-          outFile << m_Delimiter;
-          p->printTuple(outFile, i, m_Delimiter);
-          outFile << "\n";
+          if (getCancel() == true) { return; }
+          QString ss = QObject::tr("Error writing to the output file: %1").arg(getFeatureDataFile());
+          setErrorCondition(-101);
+          notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+          return;
         }
       }
     }
   }
+
   file.close();
 
   // If there is an error set this to something negative and also set a message
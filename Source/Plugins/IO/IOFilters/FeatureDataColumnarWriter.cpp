@@ -0,0 +1,459 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureDataColumnarWriter.h"
+
+#include <cstring>
+#include <typeinfo>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+#include "IO/IOConstants.h"
+
+namespace Detail
+{
+  static const char k_ColumnarMagic[8] = { 'D', '3', 'D', 'C', 'O', 'L', 'S', '1' };
+  // Written in the byte order of the machine so readers can detect it
+  static const uint32_t k_ColumnarByteOrderMark = 0x01020304;
+  // Every column starts on a multiple of this many bytes
+  static const uint64_t k_ColumnarAlignment = 8;
+
+  /**
+   * @brief The Column struct describes one column of the file. Plain arrays point at their own
+   * memory; neighbor lists are packed into buffer
+   */
+  struct Column
+  {
+    QByteArray name;
+    QByteArray type;
+    uint32_t numComps;
+    const char* data;
+    uint64_t numBytes;
+    std::vector<char> buffer;
+    uint64_t offset;
+  };
+
+  template<typename T>
+  QString TypeName()
+  {
+    T value = static_cast<T>(0);
+    if (typeid(value) == typeid(float)) { return "float"; }
+    if (typeid(value) == typeid(double)) { return "double"; }
+    if (typeid(value) == typeid(int8_t)) { return "int8_t"; }
+    if (typeid(value) == typeid(uint8_t)) { return "uint8_t"; }
+    if (typeid(value) == typeid(int16_t)) { return "int16_t"; }
+    if (typeid(value) == typeid(uint16_t)) { return "uint16_t"; }
+    if (typeid(value) == typeid(int32_t)) { return "int32_t"; }
+    if (typeid(value) == typeid(uint32_t)) { return "uint32_t"; }
+    if (typeid(value) == typeid(int64_t)) { return "int64_t"; }
+    if (typeid(value) == typeid(uint64_t)) { return "uint64_t"; }
+    return "";
+  }
+
+  /**
+   * @brief The PackListsImpl class implements a threaded algorithm that copies every list of a
+   * NeighborList to its offset in a single contiguous array of values
+   */
+  template<typename T>
+  class PackListsImpl
+  {
+    public:
+      PackListsImpl(NeighborList<T>* list, const uint64_t* offsets, T* values) :
+        m_List(list),
+        m_Offsets(offsets),
+        m_Values(values)
+      {}
+      virtual ~PackListsImpl() {}
+
+      void convert(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          typename NeighborList<T>::SharedVectorType vec = m_List->getList(static_cast<int>(i));
+          if (NULL != vec.get() && vec->empty() == false)
+          {
+            ::memcpy(m_Values + m_Offsets[i], &(vec->front()), vec->size() * sizeof(T));
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+    private:
+      NeighborList<T>* m_List;
+      const uint64_t* m_Offsets;
+      T* m_Values;
+  };
+
+  /**
+   * @brief PackNeighborList Packs a NeighborList<T> into the column as numRows + 1 UInt64 offsets
+   * followed by all of the values
+   * @return false if the array is not a NeighborList<T>
+   */
+  template<typename T>
+  bool PackNeighborList(IDataArray::Pointer p, Column& column)
+  {
+    typename NeighborList<T>::Pointer list = boost::dynamic_pointer_cast<NeighborList<T> >(p);
+    if (NULL == list.get()) { return false; }
+
+    size_t numRows = list->getNumberOfTuples();
+    std::vector<uint64_t> offsets(numRows + 1, 0);
+    for (size_t i = 0; i < numRows; i++)
+    {
+      offsets[i + 1] = offsets[i] + list->getListSize(static_cast<int>(i));
+    }
+    size_t offsetBytes = offsets.size() * sizeof(uint64_t);
+    column.buffer.resize(offsetBytes + offsets[numRows] * sizeof(T));
+    ::memcpy(&(column.buffer.front()), &(offsets.front()), offsetBytes);
+    T* values = reinterpret_cast<T*>(&(column.buffer.front()) + offsetBytes);
+
+    ParallelContext::ParallelFor<size_t>(0, numRows, PackListsImpl<T>(list.get(), &(offsets.front()), values));
+
+    column.type = QString("list<%1>").arg(TypeName<T>()).toUtf8();
+    column.numComps = 1;
+    column.data = &(column.buffer.front());
+    column.numBytes = column.buffer.size();
+    return true;
+  }
+
+  /**
+   * @brief SetupColumn Points the column at the data of a numeric array or packs a NeighborList
+   * @return false if the array type can not be written
+   */
+  static bool SetupColumn(IDataArray::Pointer p, Column& column)
+  {
+    column.name = p->getName().toUtf8();
+    column.offset = 0;
+    if (p->getNameOfClass().startsWith("DataArray") == true)
+    {
+      column.type = p->getTypeAsString().toUtf8();
+      column.numComps = static_cast<uint32_t>(p->getNumberOfComponents());
+      column.numBytes = static_cast<uint64_t>(p->getSize()) * p->getTypeSize();
+      column.data = (column.numBytes > 0) ? reinterpret_cast<const char*>(p->getVoidPointer(0)) : NULL;
+      return true;
+    }
+    return PackNeighborList<int32_t>(p, column) || PackNeighborList<float>(p, column) || PackNeighborList<double>(p, column)
+           || PackNeighborList<int64_t>(p, column) || PackNeighborList<uint32_t>(p, column) || PackNeighborList<uint64_t>(p, column)
+           || PackNeighborList<int16_t>(p, column) || PackNeighborList<uint16_t>(p, column) || PackNeighborList<int8_t>(p, column)
+           || PackNeighborList<uint8_t>(p, column);
+  }
+
+  template<typename T>
+  void AppendValue(QByteArray& out, T value)
+  {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+// Include the MOC generated file for this class
+#include "moc_FeatureDataColumnarWriter.cpp"
+
+
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureDataColumnarWriter::FeatureDataColumnarWriter() :
+  AbstractFilter(),
+  m_AttributeMatrixPath("", "", ""),
+  m_OutputFile("")
+{
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureDataColumnarWriter::~FeatureDataColumnarWriter()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureDataColumnarWriter::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+  parameters.push_back(OutputFileFilterParameter::New("Output File", "OutputFile", getOutputFile(), FilterParameter::Parameter, "*.d3col", "DREAM3D Columnar Data"));
+  parameters.push_back(SeparatorFilterParameter::New("Feature or Ensemble Data", FilterParameter::RequiredArray));
+  {
+    AttributeMatrixSelectionFilterParameter::RequirementType req = AttributeMatrixSelectionFilterParameter::CreateRequirement(DREAM3D::AttributeMatrixObjectType::Feature);
+    req.amTypes += AttributeMatrixSelectionFilterParameter::CreateRequirement(DREAM3D::AttributeMatrixObjectType::Ensemble).amTypes;
+    parameters.push_back(AttributeMatrixSelectionFilterParameter::New("Attribute Matrix", "AttributeMatrixPath", getAttributeMatrixPath(), FilterParameter::RequiredArray, req));
+  }
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureDataColumnarWriter::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setAttributeMatrixPath( reader->readDataArrayPath( "AttributeMatrixPath", getAttributeMatrixPath() ) );
+  setOutputFile( reader->readString( "OutputFile", getOutputFile() ) );
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FeatureDataColumnarWriter::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
+{
+  writer->openFilterGroup(this, index);
+  SIMPL_FILTER_WRITE_PARAMETER(FilterVersion)
+  SIMPL_FILTER_WRITE_PARAMETER(AttributeMatrixPath)
+  SIMPL_FILTER_WRITE_PARAMETER(OutputFile)
+  writer->closeFilterGroup();
+  return ++index; // we want to return the next index that was just written to
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureDataColumnarWriter::dataCheck()
+{
+  setErrorCondition(0);
+
+  AttributeMatrix::Pointer attrMat = getDataContainerArray()->getPrereqAttributeMatrixFromPath<AbstractFilter>(this, getAttributeMatrixPath(), -301);
+
+  if (getOutputFile().isEmpty() == true)
+  {
+    QString ss = QObject::tr("The output file must be set");
+    setErrorCondition(-1);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  QFileInfo fi(getOutputFile());
+  QDir parentPath(fi.path());
+  if (parentPath.exists() == false)
+  {
+    QString ss = QObject::tr("The directory path for the output file does not exist. DREAM.3D will attempt to create this path during execution of the filter");
+    notifyWarningMessage(getHumanLabel(), ss, -1);
+  }
+
+  if (fi.suffix().compare("") == 0)
+  {
+    setOutputFile(getOutputFile().append(".d3col"));
+  }
+
+  if (NULL == attrMat.get()) { return; }
+
+  QList<QString> names = attrMat->getAttributeArrayNames();
+  foreach(const QString name, names)
+  {
+    IDataArray::Pointer p = attrMat->getAttributeArray(name);
+    if (p->getNameOfClass().startsWith("DataArray") == false && p->getNameOfClass().startsWith("NeighborList") == false)
+    {
+      QString ss = QObject::tr("The Attribute Array '%1' is not a numeric array or neighbor list and will not be written").arg(name);
+      notifyWarningMessage(getHumanLabel(), ss, -302);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureDataColumnarWriter::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureDataColumnarWriter::execute()
+{
+  setErrorCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0) { return; }
+
+  // Make sure any directory path is also available as the user may have just typed
+  // in a path without actually creating the full path
+  QFileInfo fi(getOutputFile());
+  QDir parentPath(fi.path());
+  if(!parentPath.mkpath("."))
+  {
+    QString ss = QObject::tr("Error creating parent path '%1'").arg(parentPath.absolutePath());
+    setErrorCondition(-1);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  AttributeMatrix::Pointer attrMat = getDataContainerArray()->getAttributeMatrix(getAttributeMatrixPath());
+  uint64_t numRows = attrMat->getNumTuples();
+
+  notifyStatusMessage(getHumanLabel(), "Preparing Columns");
+  QList<QString> names = attrMat->getAttributeArrayNames();
+  std::vector<Detail::Column> columns(names.size());
+  size_t numColumns = 0;
+  foreach(const QString name, names)
+  {
+    if (Detail::SetupColumn(attrMat->getAttributeArray(name), columns[numColumns]) == true)
+    {
+      numColumns++;
+    }
+  }
+  columns.resize(numColumns);
+
+  // Header, column descriptors and then the column data, each column aligned
+  QByteArray header;
+  header.append(Detail::k_ColumnarMagic, sizeof(Detail::k_ColumnarMagic));
+  Detail::AppendValue<uint32_t>(header, Detail::k_ColumnarByteOrderMark);
+  Detail::AppendValue<uint32_t>(header, static_cast<uint32_t>(numColumns));
+  Detail::AppendValue<uint64_t>(header, numRows);
+
+  uint64_t descriptorBytes = 0;
+  for (size_t c = 0; c < numColumns; c++)
+  {
+    descriptorBytes += 3 * sizeof(uint32_t) + columns[c].name.size() + columns[c].type.size() + 2 * sizeof(uint64_t);
+  }
+  uint64_t offset = header.size() + descriptorBytes;
+  for (size_t c = 0; c < numColumns; c++)
+  {
+    offset = (offset + Detail::k_ColumnarAlignment - 1) / Detail::k_ColumnarAlignment * Detail::k_ColumnarAlignment;
+    columns[c].offset = offset;
+    offset += columns[c].numBytes;
+  }
+
+  for (size_t c = 0; c < numColumns; c++)
+  {
+    Detail::AppendValue<uint32_t>(header, static_cast<uint32_t>(columns[c].name.size()));
+    header.append(columns[c].name);
+    Detail::AppendValue<uint32_t>(header, static_cast<uint32_t>(columns[c].type.size()));
+    header.append(columns[c].type);
+    Detail::AppendValue<uint32_t>(header, columns[c].numComps);
+    Detail::AppendValue<uint64_t>(header, columns[c].offset);
+    Detail::AppendValue<uint64_t>(header, columns[c].numBytes);
+  }
+
+  QFile file(getOutputFile());
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    QString ss = QObject::tr("Output file could not be opened: %1").arg(getOutputFile());
+    setErrorCondition(-100);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  bool ok = file.write(header) == header.size();
+  uint64_t position = header.size();
+  const char padding[Detail::k_ColumnarAlignment] = { 0 };
+  for (size_t c = 0; c < numColumns && ok; c++)
+  {
+    QString ss = QObject::tr("Writing Column '%1'").arg(QString::fromUtf8(columns[c].name));
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+    qint64 numPad = static_cast<qint64>(columns[c].offset - position);
+    ok = (numPad == 0 || file.write(padding, numPad) == numPad);
+    qint64 numBytes = static_cast<qint64>(columns[c].numBytes);
+    ok = ok && (numBytes == 0 || file.write(columns[c].data, numBytes) == numBytes);
+    position = columns[c].offset + columns[c].numBytes;
+  }
+
+  if (!ok)
+  {
+    QString ss = QObject::tr("Error writing to the output file: %1").arg(getOutputFile());
+    setErrorCondition(-101);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+  file.close();
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer FeatureDataColumnarWriter::newFilterInstance(bool copyFilterParameters)
+{
+  FeatureDataColumnarWriter::Pointer filter = FeatureDataColumnarWriter::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FeatureDataColumnarWriter::getCompiledLibraryName()
+{ return IOConstants::IOBaseName; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FeatureDataColumnarWriter::getGroupName()
+{ return DREAM3D::FilterGroups::IOFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FeatureDataColumnarWriter::getSubGroupName()
+{ return DREAM3D::FilterSubGroups::OutputFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString FeatureDataColumnarWriter::getHumanLabel()
+{ return "Write Feature Data as Columnar Binary File"; }
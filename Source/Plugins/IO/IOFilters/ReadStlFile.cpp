@@ -36,11 +36,18 @@
 
 #include "ReadStlFile.h"
 
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QFile>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
@@ -51,40 +58,179 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "IO/IOConstants.h"
 
+namespace Detail
+{
+  static const size_t k_StlHeaderSize = 80;
+  static const size_t k_StlFileHeaderSize = 84; // Header plus the UINT32 triangle count
+  static const size_t k_StlRecordSize = 50; // 12 REAL32 plus the UINT16 attribute byte count
+  static const size_t k_StlElementCount = 12;
+}
+
+/**
+ * @brief The DecodeStlRecordsImpl class implements a threaded algorithm that copies the normal and
+ * vertices of each STL triangle record into the triangle geometry. Every triangle initially owns its
+ * own 3 vertices; shared vertices are merged afterwards by eliminate_duplicate_nodes
+ */
+class DecodeStlRecordsImpl
+{
+  public:
+    DecodeStlRecordsImpl(const uint8_t* records, size_t stride, const size_t* recordOffsets, float* nodes, int64_t* triangles, double* normals) :
+      m_Records(records),
+      m_Stride(stride),
+      m_RecordOffsets(recordOffsets),
+      m_Nodes(nodes),
+      m_Triangles(triangles),
+      m_Normals(normals)
+    {}
+    virtual ~DecodeStlRecordsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      float v[Detail::k_StlElementCount];
+      for (size_t t = start; t < end; t++)
+      {
+        const uint8_t* record = (NULL == m_RecordOffsets) ? m_Records + t * m_Stride : m_Records + m_RecordOffsets[t];
+        // Records are not 4 byte aligned in a binary file so copy them out before reading
+        ::memcpy(v, record, sizeof(v));
+        m_Normals[3 * t + 0] = v[0];
+        m_Normals[3 * t + 1] = v[1];
+        m_Normals[3 * t + 2] = v[2];
+        ::memcpy(m_Nodes + 9 * t, v + 3, 9 * sizeof(float));
+        m_Triangles[3 * t + 0] = 3 * t + 0;
+        m_Triangles[3 * t + 1] = 3 * t + 1;
+        m_Triangles[3 * t + 2] = 3 * t + 2;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const uint8_t* m_Records;
+    size_t m_Stride;
+    const size_t* m_RecordOffsets;
+    float* m_Nodes;
+    int64_t* m_Triangles;
+    double* m_Normals;
+};
+
+/**
+ * @brief The HashVerticesImpl class implements a threaded algorithm that computes a 64 bit hash
+ * of the exact coordinates of each vertex. Equal vertices always produce equal hashes
+ */
+class HashVerticesImpl
+{
+  public:
+    HashVerticesImpl(const float* vertex, uint64_t* keys) :
+      m_Vertex(vertex),
+      m_Keys(keys)
+    {}
+    virtual ~HashVerticesImpl() {}
+
+    static uint64_t Hash(const float* coords)
+    {
+      uint64_t h = 0x9E3779B97F4A7C15ULL;
+      for (int32_t i = 0; i < 3; i++)
+      {
+        // Adding zero folds -0.0 onto 0.0 so that the hash agrees with operator==
+        float c = coords[i] + 0.0f;
+        uint32_t bits = 0;
+        ::memcpy(&bits, &c, sizeof(bits));
+        h ^= bits;
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+      }
+      h ^= h >> 33;
+      h *= 0x94D049BB133111EBULL;
+      h ^= h >> 29;
+      return h;
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        m_Keys[i] = Hash(m_Vertex + 3 * i);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const float* m_Vertex;
+    uint64_t* m_Keys;
+};
+
+/**
+ * @brief The VertexKeyLess class orders vertex ids by hash and then by id, so that equal vertices
+ * end up adjacent with the lowest id first
+ */
+class VertexKeyLess
+{
+  public:
+    VertexKeyLess(const uint64_t* keys) : m_Keys(keys) {}
+
+    bool operator()(int64_t a, int64_t b) const
+    {
+      if (m_Keys[a] != m_Keys[b]) { return m_Keys[a] < m_Keys[b]; }
+      return a < b;
+    }
+  private:
+    const uint64_t* m_Keys;
+};
+
 /**
  * @brief The FindUniqueIdsImpl class implements a threaded algorithm that determines the set of
- * unique vertices in the triangle geometry
+ * unique vertices in the triangle geometry. Each run of equal hashes in the sorted vertex order
+ * is handled by the range that contains its first entry
  */
 class FindUniqueIdsImpl
 {
   public:
-    FindUniqueIdsImpl(SharedVertexList::Pointer vertex, QVector<QVector<size_t> > nodesInBin, int64_t* uniqueIds) :
+    FindUniqueIdsImpl(const float* vertex, const uint64_t* keys, const int64_t* sorted, size_t numNodes, int64_t* uniqueIds) :
       m_Vertex(vertex),
-      m_NodesInBin(nodesInBin),
+      m_Keys(keys),
+      m_Sorted(sorted),
+      m_NumNodes(numNodes),
       m_UniqueIds(uniqueIds)
     {}
     virtual ~FindUniqueIdsImpl() {}
 
     void convert(size_t start, size_t end) const
     {
-      float* verts = m_Vertex->getPointer(0);
-      for (size_t i = start; i < end; i++)
+      for (size_t p = start; p < end; p++)
       {
-        for (int32_t j = 0; j < m_NodesInBin[i].size(); j++)
+        uint64_t key = m_Keys[m_Sorted[p]];
+        if (p > 0 && m_Keys[m_Sorted[p - 1]] == key) { continue; }
+
+        size_t runEnd = p + 1;
+        while (runEnd < m_NumNodes && m_Keys[m_Sorted[runEnd]] == key) { runEnd++; }
+        if (runEnd - p == 1) { continue; }
+
+        // Ids in a run are ascending, so the first match found for a node is its lowest duplicate
+        for (size_t j = p; j < runEnd; j++)
         {
-          size_t node1 = m_NodesInBin[i][j];
-          if (m_UniqueIds[node1] == node1)
+          int64_t node1 = m_Sorted[j];
+          if (m_UniqueIds[node1] != node1) { continue; }
+          const float* v1 = m_Vertex + 3 * node1;
+          for (size_t k = j + 1; k < runEnd; k++)
           {
-            for (int32_t k = j + 1; k < m_NodesInBin[i].size(); k++)
+            int64_t node2 = m_Sorted[k];
+            const float* v2 = m_Vertex + 3 * node2;
+            if (m_UniqueIds[node2] == node2 && v1[0] == v2[0] && v1[1] == v2[1] && v1[2] == v2[2])
             {
-              size_t node2 = m_NodesInBin[i][k];
-              if (verts[node1 * 3] == verts[node2 * 3] && verts[node1 * 3 + 1] == verts[node2 * 3 + 1] && verts[node1 * 3 + 2] == verts[node2 * 3 + 2])
-              {
-                m_UniqueIds[node2] = node1;
-              }
+              m_UniqueIds[node2] = node1;
             }
           }
         }
@@ -98,11 +244,131 @@ class FindUniqueIdsImpl
     }
 #endif
   private:
-    SharedVertexList::Pointer m_Vertex;
-    QVector<QVector<size_t> > m_NodesInBin;
+    const float* m_Vertex;
+    const uint64_t* m_Keys;
+    const int64_t* m_Sorted;
+    size_t m_NumNodes;
     int64_t* m_UniqueIds;
 };
 
+/**
+ * @brief IsStlSpace Returns true for the characters that separate the tokens of an ASCII STL file
+ */
+static inline bool IsStlSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief NextStlToken Skips white space and returns the length of the token that follows
+ * @param p Current position; moved past the token
+ * @param end End of the buffer
+ * @param token Receives the start of the token
+ */
+static size_t NextStlToken(const char*& p, const char* end, const char*& token)
+{
+  while (p < end && IsStlSpace(*p)) { p++; }
+  token = p;
+  while (p < end && !IsStlSpace(*p)) { p++; }
+  return static_cast<size_t>(p - token);
+}
+
+/**
+ * @brief NextStlFloat Reads the next token as a float. The token is copied out before it is
+ * converted since the buffer is not NUL terminated
+ * @return false if the token is not a number
+ */
+static bool NextStlFloat(const char*& p, const char* end, float& value)
+{
+  const char* token = NULL;
+  size_t length = NextStlToken(p, end, token);
+  char number[64];
+  if (length == 0 || length >= sizeof(number)) { return false; }
+  ::memcpy(number, token, length);
+  number[length] = '\0';
+  char* next = NULL;
+  value = ::strtof(number, &next);
+  return next == number + length;
+}
+
+/**
+ * @brief ParseAsciiStl Parses the facets of an ASCII STL file into records of 12 floats (normal
+ * followed by the 3 vertices), matching the layout of a binary record. Any token that does not
+ * belong to the ASCII format fails the parse, so a binary file whose header happens to start
+ * with "solid" is rejected instead of being read as an empty mesh
+ * @param begin Start of the file contents
+ * @param end End of the file contents
+ * @param records Output records
+ * @return false if the contents are not a well formed ASCII STL file
+ */
+static bool ParseAsciiStl(const char* begin, const char* end, std::vector<float>& records)
+{
+  const char* p = begin;
+  const char* token = NULL;
+  float record[Detail::k_StlElementCount];
+  int32_t numVerts = 0;
+  bool inFacet = false;
+  while (p < end)
+  {
+    size_t length = NextStlToken(p, end, token);
+    if (length == 0) { break; }
+
+    if ((length == 5 && ::strncmp(token, "solid", 5) == 0) || (length == 8 && ::strncmp(token, "endsolid", 8) == 0))
+    {
+      if (inFacet) { return false; }
+      // The rest of the line is a free form name, but it has to be text
+      while (p < end && *p != '\n')
+      {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c < 0x20 && c != '\t' && c != '\r') { return false; }
+        p++;
+      }
+    }
+    else if (length == 5 && ::strncmp(token, "facet", 5) == 0)
+    {
+      if (inFacet) { return false; }
+      length = NextStlToken(p, end, token);
+      if (length != 6 || ::strncmp(token, "normal", 6) != 0) { return false; }
+      for (int32_t i = 0; i < 3; i++)
+      {
+        if (!NextStlFloat(p, end, record[i])) { return false; }
+      }
+      inFacet = true;
+      numVerts = 0;
+    }
+    else if (length == 6 && ::strncmp(token, "vertex", 6) == 0)
+    {
+      if (!inFacet || numVerts == 3) { return false; }
+      for (int32_t i = 0; i < 3; i++)
+      {
+        if (!NextStlFloat(p, end, record[3 + 3 * numVerts + i])) { return false; }
+      }
+      numVerts++;
+    }
+    else if (length == 8 && ::strncmp(token, "endfacet", 8) == 0)
+    {
+      if (!inFacet || numVerts != 3) { return false; }
+      records.insert(records.end(), record, record + Detail::k_StlElementCount);
+      inFacet = false;
+    }
+    else if (length == 5 && ::strncmp(token, "outer", 5) == 0)
+    {
+      // "outer loop" and "endloop" carry no data
+      length = NextStlToken(p, end, token);
+      if (!inFacet || length != 4 || ::strncmp(token, "loop", 4) != 0) { return false; }
+    }
+    else if (length == 7 && ::strncmp(token, "endloop", 7) == 0)
+    {
+      if (!inFacet) { return false; }
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return !inFacet;
+}
+
 // Include the MOC generated file for this class
 #include "moc_ReadStlFile.cpp"
 
@@ -117,13 +383,7 @@ ReadStlFile::ReadStlFile() :
   m_FaceAttributeMatrixName(DREAM3D::Defaults::FaceAttributeMatrixName),
   m_StlFilePath(""),
   m_FaceNormalsArrayName(DREAM3D::FaceData::SurfaceMeshFaceNormals),
-  m_FaceNormals(NULL),
-  m_minXcoord(std::numeric_limits<float>::max()),
-  m_maxXcoord(-std::numeric_limits<float>::max()),
-  m_minYcoord(std::numeric_limits<float>::max()),
-  m_maxYcoord(-std::numeric_limits<float>::max()),
-  m_minZcoord(std::numeric_limits<float>::max()),
-  m_maxZcoord(-std::numeric_limits<float>::max())
+  m_FaceNormals(NULL)
 {
   setupFilterParameters();
 }
@@ -246,9 +506,9 @@ void ReadStlFile::execute()
   if(getErrorCondition() < 0) { return; }
 
   readFile();
+  if(getErrorCondition() < 0) { return; }
   eliminate_duplicate_nodes();
 
-  setErrorCondition(0);
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
@@ -257,84 +517,127 @@ void ReadStlFile::execute()
 // -----------------------------------------------------------------------------
 void ReadStlFile::readFile()
 {
-  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshDataContainerName);
-
-  // Open File
-  FILE* f = fopen(m_StlFilePath.toLatin1().data(), "rb");
-  if (NULL == f)
+  QFile file(m_StlFilePath);
+  if (!file.open(QIODevice::ReadOnly))
   {
     setErrorCondition(-1003);
     notifyErrorMessage(getHumanLabel(), "Error opening STL file", -1003);
     return;
   }
+  qint64 fileSize = file.size();
+
+  // The whole file is mapped; binary records are decoded and ASCII text is parsed straight from the mapping
+  uint8_t* mapped = NULL;
+  if (fileSize > 0)
+  {
+    mapped = file.map(0, fileSize);
+    if (NULL == mapped)
+    {
+      setErrorCondition(-1003);
+      notifyErrorMessage(getHumanLabel(), "Error mapping STL file into memory", -1003);
+      return;
+    }
+  }
+
+  // A binary file starts with an 80 byte header and the triangle count; it is exactly 50 bytes per
+  // triangle longer than that unless some records carry extra attribute bytes
+  uint32_t triCount = 0;
+  bool binaryHeader = (fileSize >= static_cast<qint64>(Detail::k_StlFileHeaderSize));
+  if (binaryHeader)
+  {
+    ::memcpy(&triCount, mapped + Detail::k_StlHeaderSize, sizeof(uint32_t));
+  }
+  const uint64_t fixedSize = Detail::k_StlFileHeaderSize + static_cast<uint64_t>(triCount) * Detail::k_StlRecordSize;
+
+  if (binaryHeader && static_cast<uint64_t>(fileSize) == fixedSize)
+  {
+    decodeTriangles(mapped + Detail::k_StlFileHeaderSize, Detail::k_StlRecordSize, NULL, triCount);
+    file.unmap(mapped);
+    return;
+  }
 
-  // Read Header
-  char h[80];
-  int32_t triCount = 0;
-  fread(h, sizeof(int32_t), 20, f);
-  fread(&triCount, sizeof(int32_t), 1, f);
+  // Binary headers may also start with "solid", so when the text does not parse the file is
+  // read as binary records after all
+  bool asciiFailed = false;
+  if (fileSize >= 5 && ::memcmp(mapped, "solid", 5) == 0)
+  {
+    std::vector<float> records;
+    const char* text = reinterpret_cast<const char*>(mapped);
+    if (ParseAsciiStl(text, text + fileSize, records))
+    {
+      file.unmap(mapped);
+      int64_t numRecords = static_cast<int64_t>(records.size() / Detail::k_StlElementCount);
+      const uint8_t* data = records.empty() ? NULL : reinterpret_cast<const uint8_t*>(&records.front());
+      decodeTriangles(data, Detail::k_StlElementCount * sizeof(float), NULL, numRecords);
+      return;
+    }
+    asciiFailed = true;
+  }
+
+  if (!binaryHeader)
+  {
+    if (NULL != mapped) { file.unmap(mapped); }
+    if (asciiFailed)
+    {
+      setErrorCondition(-1005);
+      notifyErrorMessage(getHumanLabel(), "Error parsing ASCII STL file", -1005);
+      return;
+    }
+    setErrorCondition(-1004);
+    notifyErrorMessage(getHumanLabel(), "The STL file is too short to contain a header", -1004);
+    return;
+  }
+
+  // Some records declare extra attribute bytes, so walk the records to find where each one starts
+  std::vector<size_t> recordOffsets(triCount);
+  uint64_t offset = Detail::k_StlFileHeaderSize;
+  for (uint32_t t = 0; t < triCount; ++t)
+  {
+    if (offset + Detail::k_StlRecordSize > static_cast<uint64_t>(fileSize))
+    {
+      file.unmap(mapped);
+      if (asciiFailed)
+      {
+        // Neither layout fits; a file that starts with "solid" is most likely broken ASCII
+        setErrorCondition(-1005);
+        notifyErrorMessage(getHumanLabel(), "Error parsing ASCII STL file", -1005);
+        return;
+      }
+      setErrorCondition(-1004);
+      notifyErrorMessage(getHumanLabel(), "The STL file ended before all of its triangles were read", -1004);
+      return;
+    }
+    uint16_t attr = 0;
+    ::memcpy(&attr, mapped + offset + Detail::k_StlRecordSize - sizeof(uint16_t), sizeof(uint16_t));
+    recordOffsets[t] = static_cast<size_t>(offset - Detail::k_StlFileHeaderSize);
+    offset += Detail::k_StlRecordSize + attr;
+  }
+
+  decodeTriangles(mapped + Detail::k_StlFileHeaderSize, Detail::k_StlRecordSize, recordOffsets.empty() ? NULL : &recordOffsets.front(), triCount);
+  file.unmap(mapped);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ReadStlFile::decodeTriangles(const uint8_t* records, size_t stride, const size_t* recordOffsets, int64_t triCount)
+{
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshDataContainerName);
 
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   triangleGeom->resizeTriList(triCount);
   triangleGeom->resizeVertexList(triCount * 3);
-  float* nodes = triangleGeom->getVertexPointer(0);
-  int64_t* triangles = triangleGeom->getTriPointer(0);
 
   // Resize the triangle attribute matrix to hold the normals and update the normals pointer
   QVector<size_t> tDims(1, triCount);
   sm->getAttributeMatrix(getFaceAttributeMatrixName())->resizeAttributeArrays(tDims);
   updateFaceInstancePointers();
 
-  // Read the triangles
-  static const size_t k_StlElementCount = 12;
-  float v[k_StlElementCount];
-  unsigned short attr;
-  for (int32_t t = 0; t < triCount; ++t)
-  {
-    fread(reinterpret_cast<void*>(v), sizeof(float), k_StlElementCount, f);
-
-    fread(reinterpret_cast<void*>(&attr), sizeof(unsigned short), 1, f);
-    if (attr > 0)
-    {
-      std::vector<unsigned char> buffer(attr); // Allocate a buffer for the STL attribute data to be placed into
-      fread( reinterpret_cast<void*>(&(buffer.front())), attr, 1, f); // Read the bytes into the buffer so that we can skip it.
-    }
-    if(v[3] < m_minXcoord) { m_minXcoord = v[3]; }
-    if(v[3] > m_maxXcoord) { m_maxXcoord = v[3]; }
-    if(v[4] < m_minYcoord) { m_minYcoord = v[4]; }
-    if(v[4] > m_maxYcoord) { m_maxYcoord = v[4]; }
-    if(v[5] < m_minZcoord) { m_minZcoord = v[5]; }
-    if(v[5] > m_maxZcoord) { m_maxZcoord = v[5]; }
-    if(v[6] < m_minXcoord) { m_minXcoord = v[6]; }
-    if(v[6] > m_maxXcoord) { m_maxXcoord = v[6]; }
-    if(v[7] < m_minYcoord) { m_minYcoord = v[7]; }
-    if(v[7] > m_maxYcoord) { m_maxYcoord = v[7]; }
-    if(v[8] < m_minZcoord) { m_minZcoord = v[8]; }
-    if(v[8] > m_maxZcoord) { m_maxZcoord = v[8]; }
-    if(v[9] < m_minXcoord) { m_minXcoord = v[9]; }
-    if(v[9] > m_maxXcoord) { m_maxXcoord = v[9]; }
-    if(v[10] < m_minYcoord) { m_minYcoord = v[10]; }
-    if(v[10] > m_maxYcoord) { m_maxYcoord = v[10]; }
-    if(v[11] < m_minZcoord) { m_minZcoord = v[11]; }
-    if(v[11] > m_maxZcoord) { m_maxZcoord = v[11]; }
-    m_FaceNormals[3 * t + 0] = v[0];
-    m_FaceNormals[3 * t + 1] = v[1];
-    m_FaceNormals[3 * t + 2] = v[2];
-    nodes[3 * (3 * t + 0) + 0] = v[3];
-    nodes[3 * (3 * t + 0) + 1] = v[4];
-    nodes[3 * (3 * t + 0) + 2] = v[5];
-    nodes[3 * (3 * t + 1) + 0] = v[6];
-    nodes[3 * (3 * t + 1) + 1] = v[7];
-    nodes[3 * (3 * t + 1) + 2] = v[8];
-    nodes[3 * (3 * t + 2) + 0] = v[9];
-    nodes[3 * (3 * t + 2) + 1] = v[10];
-    nodes[3 * (3 * t + 2) + 2] = v[11];
-    triangles[t * 3] = 3 * t + 0;
-    triangles[t * 3 + 1] = 3 * t + 1;
-    triangles[t * 3 + 2] = 3 * t + 2;
-  }
+  if (triCount == 0) { return; }
+  float* nodes = triangleGeom->getVertexPointer(0);
+  int64_t* triangles = triangleGeom->getTriPointer(0);
 
-  return;
+  ParallelContext::ParallelFor<size_t>(0, triCount, DecodeStlRecordsImpl(records, stride, recordOffsets, nodes, triangles, m_FaceNormals));
 }
 
 // -----------------------------------------------------------------------------
@@ -345,29 +648,18 @@ void ReadStlFile::eliminate_duplicate_nodes()
   DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(m_SurfaceMeshDataContainerName);
 
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
-  float* vertex = triangleGeom->getVertexPointer(0);
   int64_t nNodes = triangleGeom->getNumberOfVertices();
-  int64_t* triangles = triangleGeom->getTriPointer(0);
   int64_t nTriangles = triangleGeom->getNumberOfTris();
+  if (nNodes == 0) { return; }
+  float* vertex = triangleGeom->getVertexPointer(0);
+  int64_t* triangles = triangleGeom->getTriPointer(0);
 
-  float stepX = (m_maxXcoord - m_minXcoord) / 100.0f;
-  float stepY = (m_maxYcoord - m_minYcoord) / 100.0f;
-  float stepZ = (m_maxZcoord - m_minZcoord) / 100.0f;
-
-  QVector<QVector<size_t> > nodesInBin(100 * 100 * 100);
-
-  // determine (xyz) bin each node falls in - used to speed up node comparison
-  int32_t bin = 0, xBin = 0, yBin = 0, zBin = 0;
+  // Hash each vertex and sort the vertex ids so that equal vertices become neighbors
+  std::vector<uint64_t> keys(nNodes);
+  std::vector<int64_t> sorted(nNodes);
   for (int64_t i = 0; i < nNodes; i++)
   {
-    xBin = (vertex[i * 3] - m_minXcoord) / stepX;
-    yBin = (vertex[i * 3 + 1] - m_minYcoord) / stepY;
-    zBin = (vertex[i * 3 + 2] - m_minZcoord) / stepZ;
-    if (xBin == 100) { xBin = 99; }
-    if (yBin == 100) { yBin = 99; }
-    if (zBin == 100) { zBin = 99; }
-    bin = (zBin * 10000) + (yBin * 100) + xBin;
-    nodesInBin[bin].push_back(i);
+    sorted[i] = i;
   }
 
   // Create array to hold unique node numbers
@@ -378,25 +670,12 @@ void ReadStlFile::eliminate_duplicate_nodes()
     uniqueIds[i] = i;
   }
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
   //Parallel algorithm to find duplicate nodes
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  if (doParallel == true)
-  {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, 100 * 100 * 100),
-                      FindUniqueIdsImpl(triangleGeom->getVertices(), nodesInBin, uniqueIds), tbb::auto_partitioner());
-
-  }
-  else
-#endif
-  {
-    FindUniqueIdsImpl serial(triangleGeom->getVertices(), nodesInBin, uniqueIds);
-    serial.convert(0, 100 * 100 * 100);
-  }
+  ParallelContext::ParallelFor<size_t>(0, nNodes, HashVerticesImpl(vertex, &keys.front()));
+  ParallelContext::ParallelSort(sorted.begin(), sorted.end(), VertexKeyLess(&keys.front()));
+  ParallelContext::ParallelFor<size_t>(0, nNodes, FindUniqueIdsImpl(vertex, &keys.front(), &sorted.front(), nNodes, uniqueIds));
+  keys.clear();
+  sorted.clear();
 
   //renumber the unique nodes
   int64_t uniqueCount = 0;
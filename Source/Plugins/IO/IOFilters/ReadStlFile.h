@@ -150,26 +150,33 @@ class ReadStlFile : public AbstractFilter
   private:
     DEFINE_DATAARRAY_VARIABLE(double, FaceNormals)
 
-    double m_minXcoord;
-    double m_maxXcoord;
-    double m_minYcoord;
-    double m_maxYcoord;
-    double m_minZcoord;
-    double m_maxZcoord;
-
     /**
      * @brief updateFaceInstancePointers Updates raw Face pointers
      */
     void updateFaceInstancePointers();
 
     /**
-     * @brief readFile Reads the .stl file
+     * @brief readFile Reads the .stl file. The file is memory mapped; binary records are decoded in
+     * parallel and ASCII files (those starting with "solid" whose size does not match the binary
+     * record layout) are parsed from the mapping with a single pass tokenizer. A file that starts
+     * with "solid" but does not parse as ASCII is read as binary
      */
     void readFile();
 
+    /**
+     * @brief decodeTriangles Resizes the geometry and Face data for the given number of
+     * triangles and copies the normal and 3 vertices of each record into them
+     * @param records Pointer to the first record
+     * @param stride Byte distance between records when recordOffsets is NULL
+     * @param recordOffsets Optional byte offset of each record from records
+     * @param triCount Number of triangles
+     */
+    void decodeTriangles(const uint8_t* records, size_t stride, const size_t* recordOffsets, int64_t triCount);
+
     /**
      * @brief eliminate_duplicate_nodes Removes duplicate nodes to ensure the
-     * created vertex list is shared
+     * created vertex list is shared. Vertices are grouped by a hash of their exact
+     * coordinates, so no spatial bins are required
      */
     void eliminate_duplicate_nodes();
 
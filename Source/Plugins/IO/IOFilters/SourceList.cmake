@@ -20,6 +20,7 @@ set(_PublicFilters
   EnsembleInfoReader
   ExportData
   FeatureDataCSVWriter
+  FeatureDataColumnarWriter
   FeatureInfoReader
   GBCDTriangleDumper
   INLWriter
@@ -36,6 +37,8 @@ set(_PublicFilters
   WriteTriangleGeometry
 
   VtkRectilinearGridWriter
+  VtkXmlImageDataWriter
+  VtkXmlSurfaceMeshWriter
 )
 
 #--------------
@@ -78,6 +81,10 @@ endforeach()
 #-------------
 # These are files that need to be compiled into DREAM3DLib but are NOT filters
 ADD_DREAM3D_SUPPORT_HEADER_SUBDIR(${IO_SOURCE_DIR} ${_filterGroupName} GenericDataParser.hpp util)
+ADD_DREAM3D_SUPPORT_HEADER(${IO_SOURCE_DIR} ${_filterGroupName} util/VtkXmlAppendedData.h)
+ADD_DREAM3D_SUPPORT_SOURCE(${IO_SOURCE_DIR} ${_filterGroupName} util/VtkXmlAppendedData.cpp)
+ADD_DREAM3D_SUPPORT_HEADER(${IO_SOURCE_DIR} ${_filterGroupName} util/ParallelRowWriter.h)
+ADD_DREAM3D_SUPPORT_SOURCE(${IO_SOURCE_DIR} ${_filterGroupName} util/ParallelRowWriter.cpp)
 
 #---------------------
 # This macro must come last after we are done adding all the filters and support files.
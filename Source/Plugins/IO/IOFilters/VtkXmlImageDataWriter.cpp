@@ -0,0 +1,337 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "VtkXmlImageDataWriter.h"
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/Common/TemplateHelpers.hpp"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
+
+#include "IO/IOConstants.h"
+#include "IO/IOFilters/util/VtkXmlAppendedData.h"
+
+// Include the MOC generated file for this class
+#include "moc_VtkXmlImageDataWriter.cpp"
+
+
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlImageDataWriter::VtkXmlImageDataWriter() :
+  AbstractFilter(),
+  m_OutputFile(""),
+  m_CompressData(true)
+{
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlImageDataWriter::~VtkXmlImageDataWriter()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlImageDataWriter::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+
+  parameters.push_back(OutputFileFilterParameter::New("Output File", "OutputFile", getOutputFile(), FilterParameter::Parameter, "*.vti", "VTK XML Image Data"));
+  parameters.push_back(BooleanFilterParameter::New("Compress Data", "CompressData", getCompressData(), FilterParameter::Parameter));
+
+  {
+    MultiDataArraySelectionFilterParameter::RequirementType req;
+    req.dcGeometryTypes = QVector<unsigned int>(1, DREAM3D::GeometryType::ImageGeometry);
+    req.amTypes = QVector<unsigned int>(1, DREAM3D::AttributeMatrixType::Cell);
+    parameters.push_back(MultiDataArraySelectionFilterParameter::New("Attribute Arrays to Write", "SelectedDataArrayPaths", getSelectedDataArrayPaths(), FilterParameter::RequiredArray, req));
+  }
+
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlImageDataWriter::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setOutputFile( reader->readString( "OutputFile", getOutputFile() ) );
+  setCompressData( reader->readValue("CompressData", getCompressData()) );
+  setSelectedDataArrayPaths( reader->readDataArrayPathVector("SelectedDataArrayPaths", getSelectedDataArrayPaths()) );
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int VtkXmlImageDataWriter::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
+{
+  writer->openFilterGroup(this, index);
+  SIMPL_FILTER_WRITE_PARAMETER(FilterVersion)
+  SIMPL_FILTER_WRITE_PARAMETER(SelectedDataArrayPaths)
+  SIMPL_FILTER_WRITE_PARAMETER(OutputFile)
+  SIMPL_FILTER_WRITE_PARAMETER(CompressData)
+  writer->closeFilterGroup();
+  return ++index; // we want to return the next index that was just written to
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlImageDataWriter::dataCheck()
+{
+  setErrorCondition(0);
+
+  if(m_OutputFile.isEmpty() == true)
+  {
+    QString ss = QObject::tr("The output file must be set before executing this filter.");
+    setErrorCondition(-2033000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  // Make sure what we are checking is an actual file name and not a directory
+  QFileInfo fi(m_OutputFile);
+  if (fi.isDir() == false)
+  {
+    QDir parentPath = fi.path();
+    if (parentPath.exists() == false)
+    {
+      QString ss = QObject::tr("The directory path for the output file does not exist.");
+      notifyWarningMessage(getHumanLabel(), ss, -1);
+    }
+  }
+  else
+  {
+    QString ss = QObject::tr("The output file path is a path to an existing directory. Please change the path to point to a file");
+    setErrorCondition(-2033000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if (m_SelectedDataArrayPaths.isEmpty() == true)
+  {
+    setErrorCondition(-2033001);
+    QString ss = QObject::tr("At least one Attribute Array must be selected");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  QVector<DataArrayPath> paths = getSelectedDataArrayPaths();
+
+  if (DataArrayPath::ValidateVector(paths) == false)
+  {
+    setErrorCondition(-2033002);
+    QString ss = QObject::tr("There are Attribute Arrays selected that are not contained in the same Attribute Matrix. All selected Attribute Arrays must belong to the same Attribute Matrix");
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  for (int32_t i = 0; i < paths.count(); i++)
+  {
+    IDataArray::Pointer ptr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, paths.at(i));
+    if (NULL != ptr.get() && ptr->getNameOfClass().startsWith("DataArray") == false)
+    {
+      setErrorCondition(-2033003);
+      QString ss = QObject::tr("The Attribute Array '%1' is not a numeric array and can not be written to a VTK file").arg(ptr->getName());
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+  }
+
+  QString dcName = DataArrayPath::GetAttributeMatrixPath(getSelectedDataArrayPaths()).getDataContainerName();
+
+  ImageGeom::Pointer image = getDataContainerArray()->getPrereqGeometryFromDataContainer<ImageGeom, AbstractFilter>(this, dcName);
+  if(getErrorCondition() < 0 || NULL == image.get()) { return; }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlImageDataWriter::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlImageDataWriter::execute()
+{
+  setErrorCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0) { return; }
+
+  // Make sure any directory path is also available as the user may have just typed
+  // in a path without actually creating the full path
+  QFileInfo fi(m_OutputFile);
+  QString parentPath = fi.path();
+  QDir dir;
+  if(!dir.mkpath(parentPath))
+  {
+    QString ss = QObject::tr("Error creating parent path '%1'").arg(parentPath);
+    setErrorCondition(-2033004);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  QString dcName = DataArrayPath::GetAttributeMatrixPath(getSelectedDataArrayPaths()).getDataContainerName();
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(dcName);
+  ImageGeom::Pointer image = m->getGeometryAs<ImageGeom>();
+  size_t dims[3] = {0, 0, 0};
+  image->getDimensions(dims);
+  float res[3] = { 0.0f, 0.0f, 0.0f };
+  image->getResolution(res);
+  float origin[3] = { 0.0f, 0.0f, 0.0f };
+  image->getOrigin(origin);
+  size_t totalCells = dims[0] * dims[1] * dims[2];
+
+  // Queue every array; the arrays are written straight from their own memory
+  VtkXmlAppendedData appended(m_CompressData);
+  std::vector<size_t> blocks;
+  QVector<DataArrayPath> dataPaths = getSelectedDataArrayPaths();
+  foreach(const DataArrayPath arrayPath, dataPaths)
+  {
+    IDataArray::Pointer iDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, arrayPath);
+    if (iDataPtr->getNumberOfTuples() != totalCells)
+    {
+      QString ss = QObject::tr("The Attribute Array '%1' has %2 tuples but the Image Geometry has %3 cells").arg(iDataPtr->getName()).arg(iDataPtr->getNumberOfTuples()).arg(totalCells);
+      setErrorCondition(-2033005);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    EXECUTE_FUNCTION_TEMPLATE(this, VtkXmlAppendedData::AddIDataArray, iDataPtr, appended, iDataPtr, blocks);
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Encoding Cell Data");
+  appended.encode();
+
+  // The point coordinates follow the same cell centered convention as the Vtk Rectilinear Grid Writer
+  QString extent = QString("0 %1 0 %2 0 %3").arg(dims[0]).arg(dims[1]).arg(dims[2]);
+  QString xml;
+  QTextStream out(&xml);
+  out << "<?xml version=\"1.0\"?>\n";
+  out << "<!-- Written by " << SIMPLib::Version::PackageComplete() << " -->\n";
+  out << "<VTKFile type=\"ImageData\" version=\"1.0\" " << appended.getFileAttributes() << ">\n";
+  // 9 significant digits are enough for the float origin and spacing to read back exactly
+  out << "  <ImageData WholeExtent=\"" << extent << "\" Origin=\"" << qSetRealNumberPrecision(9) << origin[0] - res[0] * 0.5f << " " << origin[1] - res[1] * 0.5f << " " << origin[2] - res[2] * 0.5f
+      << "\" Spacing=\"" << res[0] << " " << res[1] << " " << res[2] << "\">\n";
+  out << "    <Piece Extent=\"" << extent << "\">\n";
+  out << "      <CellData>\n";
+  for (size_t i = 0; i < blocks.size(); i++)
+  {
+    out << appended.getDataArrayTag(blocks[i], 8);
+  }
+  out << "      </CellData>\n";
+  out << "    </Piece>\n";
+  out << "  </ImageData>\n";
+  out.flush();
+
+  QFile file(getOutputFile());
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    QString ss = QObject::tr("Error opening output vtk file '%1'").arg(m_OutputFile);
+    setErrorCondition(-2033006);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Writing File");
+  QByteArray header = xml.toUtf8();
+  bool ok = file.write(header) == header.size();
+  ok = ok && appended.writeAppendedData(file);
+  ok = ok && file.write("</VTKFile>\n") > 0;
+  if (!ok)
+  {
+    QString ss = QObject::tr("Error writing output vtk file '%1'").arg(m_OutputFile);
+    setErrorCondition(-2033007);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer VtkXmlImageDataWriter::newFilterInstance(bool copyFilterParameters)
+{
+  VtkXmlImageDataWriter::Pointer filter = VtkXmlImageDataWriter::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlImageDataWriter::getCompiledLibraryName()
+{ return IOConstants::IOBaseName; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlImageDataWriter::getGroupName()
+{ return DREAM3D::FilterGroups::IOFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlImageDataWriter::getSubGroupName()
+{ return DREAM3D::FilterSubGroups::OutputFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlImageDataWriter::getHumanLabel()
+{ return "Vtk XML Image Data Writer"; }
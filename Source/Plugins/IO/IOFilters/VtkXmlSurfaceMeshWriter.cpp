@@ -0,0 +1,430 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "VtkXmlSurfaceMeshWriter.h"
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLibVersion.h"
+#include "SIMPLib/Common/TemplateHelpers.hpp"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
+#include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
+#include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/MultiDataArraySelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+
+#include "IO/IOConstants.h"
+
+// Include the MOC generated file for this class
+#include "moc_VtkXmlSurfaceMeshWriter.cpp"
+
+namespace Detail
+{
+  enum VtkXmlSurfaceMeshFormat
+  {
+    PolyData = 0,
+    UnstructuredGrid = 1
+  };
+
+  static const uint8_t k_VtkTriangle = 5;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlSurfaceMeshWriter::VtkXmlSurfaceMeshWriter() :
+  AbstractFilter(),
+  m_OutputFile(""),
+  m_CompressData(true),
+  m_OutputFormat(Detail::PolyData),
+  m_DataContainerName(DREAM3D::Defaults::TriangleDataContainerName)
+{
+  setupFilterParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlSurfaceMeshWriter::~VtkXmlSurfaceMeshWriter()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::setupFilterParameters()
+{
+  FilterParameterVector parameters;
+
+  parameters.push_back(OutputFileFilterParameter::New("Output File", "OutputFile", getOutputFile(), FilterParameter::Parameter, "*.vtp *.vtu", "VTK XML Surface Mesh"));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Output Format");
+    parameter->setPropertyName("OutputFormat");
+
+    QVector<QString> choices;
+    choices.push_back("PolyData (.vtp)");
+    choices.push_back("Unstructured Grid (.vtu)");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
+  parameters.push_back(BooleanFilterParameter::New("Compress Data", "CompressData", getCompressData(), FilterParameter::Parameter));
+  {
+    DataContainerSelectionFilterParameter::RequirementType req;
+    req.dcGeometryTypes = QVector<unsigned int>(1, DREAM3D::GeometryType::TriangleGeometry);
+    parameters.push_back(DataContainerSelectionFilterParameter::New("Data Container", "DataContainerName", getDataContainerName(), FilterParameter::RequiredArray, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Vertex Data", FilterParameter::RequiredArray));
+  {
+    MultiDataArraySelectionFilterParameter::RequirementType req;
+    req.dcGeometryTypes = QVector<unsigned int>(1, DREAM3D::GeometryType::TriangleGeometry);
+    req.amTypes = QVector<unsigned int>(1, DREAM3D::AttributeMatrixType::Vertex);
+    parameters.push_back(MultiDataArraySelectionFilterParameter::New("Vertex Arrays", "SelectedVertexArrays", getSelectedVertexArrays(), FilterParameter::RequiredArray, req));
+  }
+  parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::RequiredArray));
+  {
+    MultiDataArraySelectionFilterParameter::RequirementType req;
+    req.dcGeometryTypes = QVector<unsigned int>(1, DREAM3D::GeometryType::TriangleGeometry);
+    req.amTypes = QVector<unsigned int>(1, DREAM3D::AttributeMatrixType::Face);
+    parameters.push_back(MultiDataArraySelectionFilterParameter::New("Face Arrays", "SelectedFaceArrays", getSelectedFaceArrays(), FilterParameter::RequiredArray, req));
+  }
+
+  setFilterParameters(parameters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::readFilterParameters(AbstractFilterParametersReader* reader, int index)
+{
+  reader->openFilterGroup(this, index);
+  setOutputFile( reader->readString( "OutputFile", getOutputFile() ) );
+  setOutputFormat( reader->readValue("OutputFormat", getOutputFormat()) );
+  setCompressData( reader->readValue("CompressData", getCompressData()) );
+  setDataContainerName( reader->readString("DataContainerName", getDataContainerName()) );
+  setSelectedVertexArrays( reader->readDataArrayPathVector("SelectedVertexArrays", getSelectedVertexArrays()) );
+  setSelectedFaceArrays( reader->readDataArrayPathVector("SelectedFaceArrays", getSelectedFaceArrays()) );
+  reader->closeFilterGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int VtkXmlSurfaceMeshWriter::writeFilterParameters(AbstractFilterParametersWriter* writer, int index)
+{
+  writer->openFilterGroup(this, index);
+  SIMPL_FILTER_WRITE_PARAMETER(FilterVersion)
+  SIMPL_FILTER_WRITE_PARAMETER(OutputFile)
+  SIMPL_FILTER_WRITE_PARAMETER(OutputFormat)
+  SIMPL_FILTER_WRITE_PARAMETER(CompressData)
+  SIMPL_FILTER_WRITE_PARAMETER(DataContainerName)
+  SIMPL_FILTER_WRITE_PARAMETER(SelectedVertexArrays)
+  SIMPL_FILTER_WRITE_PARAMETER(SelectedFaceArrays)
+  writer->closeFilterGroup();
+  return ++index; // we want to return the next index that was just written to
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::checkArrays(const QVector<DataArrayPath>& paths, int errorCode)
+{
+  foreach(DataArrayPath dap, paths)
+  {
+    if(dap.getDataContainerName().compare(getDataContainerName()) != 0)
+    {
+      setErrorCondition(errorCode);
+      QString ss = QObject::tr("The Attribute Array '%1' does not belong to the Data Container '%2'").arg(dap.serialize("/")).arg(getDataContainerName());
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    IDataArray::Pointer ptr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, dap);
+    if (NULL != ptr.get() && ptr->getNameOfClass().startsWith("DataArray") == false)
+    {
+      setErrorCondition(errorCode);
+      QString ss = QObject::tr("The Attribute Array '%1' is not a numeric array and can not be written to a VTK file").arg(ptr->getName());
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::dataCheck()
+{
+  setErrorCondition(0);
+
+  if(m_OutputFile.isEmpty() == true)
+  {
+    QString ss = QObject::tr("The output file must be set before executing this filter.");
+    setErrorCondition(-2034000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  QFileInfo fi(m_OutputFile);
+  if (fi.isDir() == true)
+  {
+    QString ss = QObject::tr("The output file path is a path to an existing directory. Please change the path to point to a file");
+    setErrorCondition(-2034000);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  if (m_OutputFormat != Detail::PolyData && m_OutputFormat != Detail::UnstructuredGrid)
+  {
+    QString ss = QObject::tr("The output format %1 is not supported").arg(m_OutputFormat);
+    setErrorCondition(-2034001);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+  }
+
+  TriangleGeom::Pointer triangles = getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom, AbstractFilter>(this, getDataContainerName());
+  if(getErrorCondition() < 0) { return; }
+
+  // We MUST have Nodes
+  if (NULL == triangles->getVertices().get())
+  {
+    setErrorCondition(-2034002);
+    notifyErrorMessage(getHumanLabel(), "DataContainer Geometry missing Vertices", getErrorCondition());
+  }
+  // We MUST have Triangles defined also.
+  if (NULL == triangles->getTriangles().get())
+  {
+    setErrorCondition(-2034003);
+    notifyErrorMessage(getHumanLabel(), "DataContainer Geometry missing Triangles", getErrorCondition());
+  }
+
+  checkArrays(getSelectedVertexArrays(), -2034004);
+  checkArrays(getSelectedFaceArrays(), -2034005);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::preflight()
+{
+  setInPreflight(true);
+  emit preflightAboutToExecute();
+  emit updateFilterParameters(this);
+  dataCheck();
+  emit preflightExecuted();
+  setInPreflight(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::addArrays(VtkXmlAppendedData& appended, const QVector<DataArrayPath>& paths, size_t numTuples, std::vector<size_t>& blocks)
+{
+  foreach(const DataArrayPath arrayPath, paths)
+  {
+    IDataArray::Pointer iDataPtr = getDataContainerArray()->getPrereqIDataArrayFromPath<IDataArray, AbstractFilter>(this, arrayPath);
+    if (iDataPtr->getNumberOfTuples() != numTuples)
+    {
+      QString ss = QObject::tr("The Attribute Array '%1' has %2 tuples but %3 were expected").arg(iDataPtr->getName()).arg(iDataPtr->getNumberOfTuples()).arg(numTuples);
+      setErrorCondition(-2034006);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    EXECUTE_FUNCTION_TEMPLATE(this, VtkXmlAppendedData::AddIDataArray, iDataPtr, appended, iDataPtr, blocks);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlSurfaceMeshWriter::execute()
+{
+  setErrorCondition(0);
+  dataCheck();
+  if(getErrorCondition() < 0) { return; }
+
+  // Make sure any directory path is also available as the user may have just typed
+  // in a path without actually creating the full path
+  QFileInfo fi(m_OutputFile);
+  QString parentPath = fi.path();
+  QDir dir;
+  if(!dir.mkpath(parentPath))
+  {
+    QString ss = QObject::tr("Error creating parent path '%1'").arg(parentPath);
+    setErrorCondition(-2034007);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  TriangleGeom::Pointer triangleGeom = getDataContainerArray()->getDataContainer(getDataContainerName())->getGeometryAs<TriangleGeom>();
+  size_t numVerts = triangleGeom->getNumberOfVertices();
+  size_t numTris = triangleGeom->getNumberOfTris();
+
+  // The geometry, the connectivity and the selected arrays are written straight from their own
+  // memory; only the cell offsets (and the cell types of an unstructured grid) are generated
+  VtkXmlAppendedData appended(m_CompressData);
+  std::vector<size_t> pointBlocks;
+  std::vector<size_t> cellBlocks;
+  addArrays(appended, getSelectedVertexArrays(), numVerts, pointBlocks);
+  if(getErrorCondition() < 0) { return; }
+  addArrays(appended, getSelectedFaceArrays(), numTris, cellBlocks);
+  if(getErrorCondition() < 0) { return; }
+
+  size_t points = appended.addDataArray<float>("Points", triangleGeom->getVertexPointer(0), numVerts * 3, 3);
+  size_t connectivity = appended.addDataArray<int64_t>("connectivity", triangleGeom->getTriPointer(0), numTris * 3, 1);
+
+  std::vector<int64_t> offsetBuffer(numTris);
+  for (size_t i = 0; i < numTris; i++)
+  {
+    offsetBuffer[i] = static_cast<int64_t>(3 * (i + 1));
+  }
+  size_t offsets = appended.addDataArray<int64_t>("offsets", offsetBuffer.empty() ? NULL : &(offsetBuffer.front()), numTris, 1);
+  std::vector<uint8_t> typeBuffer;
+  size_t types = 0;
+  if (m_OutputFormat == Detail::UnstructuredGrid)
+  {
+    typeBuffer.resize(numTris, Detail::k_VtkTriangle);
+    types = appended.addDataArray<uint8_t>("types", typeBuffer.empty() ? NULL : &(typeBuffer.front()), numTris, 1);
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Encoding Surface Mesh");
+  appended.encode();
+
+  QString dataSet = (m_OutputFormat == Detail::UnstructuredGrid) ? "UnstructuredGrid" : "PolyData";
+  QString xml;
+  QTextStream out(&xml);
+  out << "<?xml version=\"1.0\"?>\n";
+  out << "<!-- Written by " << SIMPLib::Version::PackageComplete() << " -->\n";
+  out << "<VTKFile type=\"" << dataSet << "\" version=\"1.0\" " << appended.getFileAttributes() << ">\n";
+  out << "  <" << dataSet << ">\n";
+  if (m_OutputFormat == Detail::UnstructuredGrid)
+  {
+    out << "    <Piece NumberOfPoints=\"" << numVerts << "\" NumberOfCells=\"" << numTris << "\">\n";
+  }
+  else
+  {
+    out << "    <Piece NumberOfPoints=\"" << numVerts << "\" NumberOfVerts=\"0\" NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\"" << numTris << "\">\n";
+  }
+  out << "      <PointData>\n";
+  for (size_t i = 0; i < pointBlocks.size(); i++)
+  {
+    out << appended.getDataArrayTag(pointBlocks[i], 8);
+  }
+  out << "      </PointData>\n";
+  out << "      <CellData>\n";
+  for (size_t i = 0; i < cellBlocks.size(); i++)
+  {
+    out << appended.getDataArrayTag(cellBlocks[i], 8);
+  }
+  out << "      </CellData>\n";
+  out << "      <Points>\n";
+  out << appended.getDataArrayTag(points, 8);
+  out << "      </Points>\n";
+  QString cellElement = (m_OutputFormat == Detail::UnstructuredGrid) ? "Cells" : "Polys";
+  out << "      <" << cellElement << ">\n";
+  out << appended.getDataArrayTag(connectivity, 8);
+  out << appended.getDataArrayTag(offsets, 8);
+  if (m_OutputFormat == Detail::UnstructuredGrid)
+  {
+    out << appended.getDataArrayTag(types, 8);
+  }
+  out << "      </" << cellElement << ">\n";
+  out << "    </Piece>\n";
+  out << "  </" << dataSet << ">\n";
+  out.flush();
+
+  QFile file(getOutputFile());
+  if (!file.open(QIODevice::WriteOnly))
+  {
+    QString ss = QObject::tr("Error opening output vtk file '%1'").arg(m_OutputFile);
+    setErrorCondition(-2034008);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Writing File");
+  QByteArray header = xml.toUtf8();
+  bool ok = file.write(header) == header.size();
+  ok = ok && appended.writeAppendedData(file);
+  ok = ok && file.write("</VTKFile>\n") > 0;
+  if (!ok)
+  {
+    QString ss = QObject::tr("Error writing output vtk file '%1'").arg(m_OutputFile);
+    setErrorCondition(-2034009);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
+  }
+
+  notifyStatusMessage(getHumanLabel(), "Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer VtkXmlSurfaceMeshWriter::newFilterInstance(bool copyFilterParameters)
+{
+  VtkXmlSurfaceMeshWriter::Pointer filter = VtkXmlSurfaceMeshWriter::New();
+  if(true == copyFilterParameters)
+  {
+    copyFilterParameterInstanceVariables(filter.get());
+  }
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlSurfaceMeshWriter::getCompiledLibraryName()
+{ return IOConstants::IOBaseName; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlSurfaceMeshWriter::getGroupName()
+{ return DREAM3D::FilterGroups::IOFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlSurfaceMeshWriter::getSubGroupName()
+{ return DREAM3D::FilterSubGroups::OutputFilters; }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const QString VtkXmlSurfaceMeshWriter::getHumanLabel()
+{ return "Vtk XML Surface Mesh Writer"; }
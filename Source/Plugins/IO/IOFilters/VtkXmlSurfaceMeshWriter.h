@@ -0,0 +1,185 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _VtkXmlSurfaceMeshWriter_H_
+#define _VtkXmlSurfaceMeshWriter_H_
+
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/AbstractFilter.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+
+#include "IO/IOFilters/util/VtkXmlAppendedData.h"
+
+/**
+ * @brief The VtkXmlSurfaceMeshWriter class writes a Triangle Geometry and its Vertex and Face arrays to
+ * either a VTK XML PolyData (.vtp) or UnstructuredGrid (.vtu) file using appended raw binary data,
+ * optionally zlib compressed. See
+ * [Filter documentation](@ref vtkxmlsurfacemeshwriter) for details.
+ */
+class VtkXmlSurfaceMeshWriter : public AbstractFilter
+{
+    Q_OBJECT /* Need this for Qt's signals and slots mechanism to work */
+  public:
+    SIMPL_SHARED_POINTERS(VtkXmlSurfaceMeshWriter)
+    SIMPL_STATIC_NEW_MACRO(VtkXmlSurfaceMeshWriter)
+    SIMPL_TYPE_MACRO_SUPER(VtkXmlSurfaceMeshWriter, AbstractFilter)
+
+    virtual ~VtkXmlSurfaceMeshWriter();
+
+    SIMPL_FILTER_PARAMETER(QString, OutputFile)
+    Q_PROPERTY(QString OutputFile READ getOutputFile WRITE setOutputFile)
+
+    SIMPL_FILTER_PARAMETER(bool, CompressData)
+    Q_PROPERTY(bool CompressData READ getCompressData WRITE setCompressData)
+
+    SIMPL_FILTER_PARAMETER(int, OutputFormat)
+    Q_PROPERTY(int OutputFormat READ getOutputFormat WRITE setOutputFormat)
+
+    SIMPL_FILTER_PARAMETER(QString, DataContainerName)
+    Q_PROPERTY(QString DataContainerName READ getDataContainerName WRITE setDataContainerName)
+
+    SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, SelectedVertexArrays)
+    Q_PROPERTY(QVector<DataArrayPath> SelectedVertexArrays READ getSelectedVertexArrays WRITE setSelectedVertexArrays)
+
+    SIMPL_FILTER_PARAMETER(QVector<DataArrayPath>, SelectedFaceArrays)
+    Q_PROPERTY(QVector<DataArrayPath> SelectedFaceArrays READ getSelectedFaceArrays WRITE setSelectedFaceArrays)
+
+    /**
+     * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
+     */
+    virtual const QString getCompiledLibraryName();
+
+    /**
+     * @brief newFilterInstance Reimplemented from @see AbstractFilter class
+     */
+    virtual AbstractFilter::Pointer newFilterInstance(bool copyFilterParameters);
+
+    /**
+     * @brief getGroupName Reimplemented from @see AbstractFilter class
+     */
+    virtual const QString getGroupName();
+
+    /**
+     * @brief getSubGroupName Reimplemented from @see AbstractFilter class
+     */
+    virtual const QString getSubGroupName();
+
+    /**
+     * @brief getHumanLabel Reimplemented from @see AbstractFilter class
+     */
+    virtual const QString getHumanLabel();
+
+    /**
+     * @brief setupFilterParameters Reimplemented from @see AbstractFilter class
+     */
+    virtual void setupFilterParameters();
+
+    /**
+     * @brief writeFilterParameters Reimplemented from @see AbstractFilter class
+     */
+    virtual int writeFilterParameters(AbstractFilterParametersWriter* writer, int index);
+
+    /**
+     * @brief readFilterParameters Reimplemented from @see AbstractFilter class
+     */
+    virtual void readFilterParameters(AbstractFilterParametersReader* reader, int index);
+
+    /**
+     * @brief execute Reimplemented from @see AbstractFilter class
+     */
+    virtual void execute();
+
+    /**
+    * @brief preflight Reimplemented from @see AbstractFilter class
+    */
+    virtual void preflight();
+
+  signals:
+    /**
+     * @brief updateFilterParameters Emitted when the Filter requests all the latest Filter parameters
+     * be pushed from a user-facing control (such as a widget)
+     * @param filter Filter instance pointer
+     */
+    void updateFilterParameters(AbstractFilter* filter);
+
+    /**
+     * @brief parametersChanged Emitted when any Filter parameter is changed internally
+     */
+    void parametersChanged();
+
+    /**
+     * @brief preflightAboutToExecute Emitted just before calling dataCheck()
+     */
+    void preflightAboutToExecute();
+
+    /**
+     * @brief preflightExecuted Emitted just after calling dataCheck()
+     */
+    void preflightExecuted();
+
+  protected:
+    VtkXmlSurfaceMeshWriter();
+
+    /**
+     * @brief dataCheck Checks for the appropriate parameter values and availability of arrays
+     */
+    void dataCheck();
+
+  private:
+    /**
+     * @brief checkArrays Validates that the selected arrays belong to the selected Data Container
+     * and are numeric arrays
+     * @param paths Selected array paths
+     * @param errorCode Error code to report
+     */
+    void checkArrays(const QVector<DataArrayPath>& paths, int errorCode);
+
+    /**
+     * @brief addArrays Queues the selected arrays after checking that each has the given number of
+     * tuples. Sets the error condition if one does not
+     */
+    void addArrays(VtkXmlAppendedData& appended, const QVector<DataArrayPath>& paths, size_t numTuples, std::vector<size_t>& blocks);
+
+    VtkXmlSurfaceMeshWriter(const VtkXmlSurfaceMeshWriter&); // Copy Constructor Not Implemented
+    void operator=(const VtkXmlSurfaceMeshWriter&); // Operator '=' Not Implemented
+};
+
+#endif /* _VtkXmlSurfaceMeshWriter_H_ */
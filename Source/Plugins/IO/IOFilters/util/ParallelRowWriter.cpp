@@ -0,0 +1,148 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ParallelRowWriter.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+namespace Detail
+{
+  // Rows formatted by a single task
+  static const size_t k_RowsPerChunk = 2048;
+  // Chunks formatted before they are written out; bounds the memory held at once
+  static const size_t k_ChunksPerBatch = 256;
+}
+
+/**
+ * @brief The FormatRowChunksImpl class implements a threaded algorithm that formats chunks of rows
+ * into separate buffers
+ */
+class FormatRowChunksImpl
+{
+  public:
+    FormatRowChunksImpl(const ParallelRowWriter::RowFormatter& formatter, size_t firstRow, size_t endRow, QByteArray* buffers) :
+      m_Formatter(formatter),
+      m_FirstRow(firstRow),
+      m_EndRow(endRow),
+      m_Buffers(buffers)
+    {}
+    virtual ~FormatRowChunksImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t c = start; c < end; c++)
+      {
+        size_t rowStart = m_FirstRow + c * Detail::k_RowsPerChunk;
+        size_t rowEnd = std::min(rowStart + Detail::k_RowsPerChunk, m_EndRow);
+        m_Buffers[c].clear();
+        QTextStream out(&(m_Buffers[c]), QIODevice::WriteOnly);
+        m_Formatter.formatRows(out, rowStart, rowEnd);
+        out.flush();
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const ParallelRowWriter::RowFormatter& m_Formatter;
+    size_t m_FirstRow;
+    size_t m_EndRow;
+    QByteArray* m_Buffers;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelRowWriter::ParallelRowWriter(AbstractFilter* filter, const QString& message) :
+  m_Filter(filter),
+  m_Message(message)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelRowWriter::~ParallelRowWriter()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParallelRowWriter::write(QIODevice& device, const RowFormatter& formatter, size_t start, size_t end)
+{
+  if (end <= start) { return true; }
+
+  std::vector<QByteArray> buffers(Detail::k_ChunksPerBatch);
+  size_t rowsPerBatch = Detail::k_RowsPerChunk * Detail::k_ChunksPerBatch;
+  size_t totalRows = end - start;
+
+  for (size_t batchStart = start; batchStart < end; batchStart += rowsPerBatch)
+  {
+    size_t batchEnd = std::min(batchStart + rowsPerBatch, end);
+    size_t numChunks = (batchEnd - batchStart + Detail::k_RowsPerChunk - 1) / Detail::k_RowsPerChunk;
+
+    ParallelContext::ParallelFor<size_t>(0, numChunks, FormatRowChunksImpl(formatter, batchStart, batchEnd, &(buffers.front())));
+
+    for (size_t c = 0; c < numChunks; c++)
+    {
+      if (device.write(buffers[c]) != buffers[c].size()) { return false; }
+    }
+
+    if (NULL != m_Filter)
+    {
+      if (m_Filter->getCancel() == true) { return false; }
+      float percent = static_cast<float>(batchEnd - start) / static_cast<float>(totalRows) * 100.0f;
+      QString ss = QObject::tr("%1 || %2% Complete").arg(m_Message).arg(static_cast<int>(percent));
+      m_Filter->notifyStatusMessage(m_Filter->getMessagePrefix(), m_Filter->getHumanLabel(), ss);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,95 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _ParallelRowWriter_H_
+#define _ParallelRowWriter_H_
+
+#include <QtCore/QIODevice>
+#include <QtCore/QString>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/AbstractFilter.h"
+
+/**
+ * @brief The ParallelRowWriter class writes the text rows of a table to a device. Consecutive rows are
+ * grouped into chunks that are formatted in parallel, each into its own buffer, and the buffers are then
+ * written to the device in order. Only a bounded number of chunks is held in memory at a time, so the
+ * output is streamed no matter how many rows are written.
+ *
+ * The rows are produced by a RowFormatter, whose formatRows() is called concurrently for disjoint
+ * ranges of rows and must therefore only read shared data.
+ */
+class ParallelRowWriter
+{
+  public:
+    /**
+     * @brief The RowFormatter class formats a range of rows into a text stream
+     */
+    class RowFormatter
+    {
+      public:
+        virtual ~RowFormatter() {}
+
+        /**
+         * @brief formatRows Writes rows [start, end), including their line endings, to out
+         */
+        virtual void formatRows(QTextStream& out, size_t start, size_t end) const = 0;
+    };
+
+    /**
+     * @brief ParallelRowWriter
+     * @param filter Filter used to report progress and to check for cancellation. May be NULL
+     * @param message Progress message; the percentage complete is appended to it
+     */
+    ParallelRowWriter(AbstractFilter* filter, const QString& message);
+    virtual ~ParallelRowWriter();
+
+    /**
+     * @brief write Formats rows [start, end) and writes them to the device. Any QTextStream already
+     * writing to the device must be flushed first
+     * @return false if the device reported a write error or the filter was canceled
+     */
+    bool write(QIODevice& device, const RowFormatter& formatter, size_t start, size_t end);
+
+  private:
+    AbstractFilter* m_Filter;
+    QString m_Message;
+
+    ParallelRowWriter(const ParallelRowWriter&); // Copy Constructor Not Implemented
+    void operator=(const ParallelRowWriter&); // Operator '=' Not Implemented
+};
+
+#endif /* _ParallelRowWriter_H_ */
@@ -0,0 +1,247 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "VtkXmlAppendedData.h"
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+namespace Detail
+{
+  // Uncompressed size of each compressed chunk; the last chunk of a block may be shorter
+  static const size_t k_ChunkSize = 65536;
+  // qCompress() prefixes its zlib stream with the uncompressed size as a big endian UInt32
+  static const int k_QCompressPrefix = 4;
+
+  struct ChunkTask
+  {
+    const char* source;
+    int numBytes;
+    QByteArray* dest;
+  };
+}
+
+/**
+ * @brief The CompressChunksImpl class implements a threaded algorithm that zlib compresses
+ * independent chunks of the appended data blocks
+ */
+class CompressChunksImpl
+{
+  public:
+    CompressChunksImpl(const Detail::ChunkTask* tasks) :
+      m_Tasks(tasks)
+    {}
+    virtual ~CompressChunksImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        const Detail::ChunkTask& task = m_Tasks[i];
+        *(task.dest) = qCompress(reinterpret_cast<const uchar*>(task.source), task.numBytes);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const Detail::ChunkTask* m_Tasks;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlAppendedData::VtkXmlAppendedData(bool compress) :
+  m_Compress(compress)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VtkXmlAppendedData::~VtkXmlAppendedData()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VtkXmlAppendedData::addBlock(const QString& type, const QString& name, int numComps, const char* data, size_t numBytes)
+{
+  Block block;
+  block.type = type;
+  block.name = name;
+  block.numComps = numComps;
+  block.data = data;
+  block.numBytes = numBytes;
+  block.offset = 0;
+  m_Blocks.push_back(block);
+  return m_Blocks.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void VtkXmlAppendedData::encode()
+{
+  std::vector<Detail::ChunkTask> tasks;
+  for (size_t b = 0; b < m_Blocks.size(); b++)
+  {
+    Block& block = m_Blocks[b];
+    block.header.clear();
+    block.chunks.clear();
+    if (m_Compress == false)
+    {
+      block.header.push_back(block.numBytes);
+      continue;
+    }
+    // vtkZLibDataCompressor layout: chunk count, chunk size, size of a partial last chunk (0 if
+    // the last chunk is full) and then the compressed size of every chunk
+    size_t numChunks = (block.numBytes + Detail::k_ChunkSize - 1) / Detail::k_ChunkSize;
+    block.header.push_back(numChunks);
+    block.header.push_back(Detail::k_ChunkSize);
+    block.header.push_back(block.numBytes % Detail::k_ChunkSize);
+    block.chunks.resize(numChunks);
+  }
+
+  // The chunk vectors are no longer resized, so the task pointers into them stay valid
+  for (size_t b = 0; b < m_Blocks.size() && m_Compress == true; b++)
+  {
+    Block& block = m_Blocks[b];
+    for (size_t c = 0; c < block.chunks.size(); c++)
+    {
+      size_t start = c * Detail::k_ChunkSize;
+      Detail::ChunkTask task;
+      task.source = block.data + start;
+      task.numBytes = static_cast<int>(std::min(Detail::k_ChunkSize, block.numBytes - start));
+      task.dest = &(block.chunks[c]);
+      tasks.push_back(task);
+    }
+  }
+
+  if (tasks.empty() == false)
+  {
+    ParallelContext::ParallelFor<size_t>(0, tasks.size(), CompressChunksImpl(&tasks.front()));
+  }
+
+  uint64_t offset = 0;
+  for (size_t b = 0; b < m_Blocks.size(); b++)
+  {
+    Block& block = m_Blocks[b];
+    uint64_t numBytes = block.numBytes;
+    if (m_Compress == true)
+    {
+      numBytes = 0;
+      for (size_t c = 0; c < block.chunks.size(); c++)
+      {
+        uint64_t compressedSize = block.chunks[c].size() - Detail::k_QCompressPrefix;
+        block.header.push_back(compressedSize);
+        numBytes += compressedSize;
+      }
+    }
+    block.offset = offset;
+    offset += block.header.size() * sizeof(uint64_t) + numBytes;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString VtkXmlAppendedData::getFileAttributes() const
+{
+#ifdef CMP_WORDS_BIGENDIAN
+  QString attributes("byte_order=\"BigEndian\" header_type=\"UInt64\"");
+#else
+  QString attributes("byte_order=\"LittleEndian\" header_type=\"UInt64\"");
+#endif
+  if (m_Compress == true)
+  {
+    attributes.append(" compressor=\"vtkZLibDataCompressor\"");
+  }
+  return attributes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString VtkXmlAppendedData::getDataArrayTag(size_t block, int indent) const
+{
+  const Block& b = m_Blocks[block];
+  return QString("%1<DataArray type=\"%2\" Name=\"%3\" NumberOfComponents=\"%4\" format=\"appended\" offset=\"%5\"/>\n")
+         .arg(QString(indent, ' ')).arg(b.type).arg(b.name.toHtmlEscaped()).arg(b.numComps).arg(b.offset);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VtkXmlAppendedData::writeAppendedData(QFile& out) const
+{
+  bool ok = true;
+  const QByteArray open("  <AppendedData encoding=\"raw\">\n   _");
+  ok = ok && out.write(open) == open.size();
+  for (size_t b = 0; b < m_Blocks.size() && ok; b++)
+  {
+    const Block& block = m_Blocks[b];
+    qint64 headerBytes = static_cast<qint64>(block.header.size() * sizeof(uint64_t));
+    ok = ok && out.write(reinterpret_cast<const char*>(&(block.header.front())), headerBytes) == headerBytes;
+    if (m_Compress == true)
+    {
+      for (size_t c = 0; c < block.chunks.size() && ok; c++)
+      {
+        qint64 numBytes = block.chunks[c].size() - Detail::k_QCompressPrefix;
+        ok = out.write(block.chunks[c].constData() + Detail::k_QCompressPrefix, numBytes) == numBytes;
+      }
+    }
+    else if (block.numBytes > 0)
+    {
+      qint64 numBytes = static_cast<qint64>(block.numBytes);
+      ok = out.write(block.data, numBytes) == numBytes;
+    }
+  }
+  const QByteArray close("\n  </AppendedData>\n");
+  ok = ok && out.write(close) == close.size();
+  return ok;
+}
@@ -0,0 +1,167 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _VtkXmlAppendedData_H_
+#define _VtkXmlAppendedData_H_
+
+#include <typeinfo>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+/**
+ * @brief The VtkXmlAppendedData class collects the binary blocks of a VTK XML file (.vti, .vtu, .vtp)
+ * that are stored in its "appended" section with raw encoding. Blocks are queued with addDataArray(),
+ * optionally zlib compressed in parallel by encode() and then written with a few large sequential
+ * writes by writeAppendedData(). Every block is preceded by a UInt64 header in the layout that
+ * vtkXMLReader expects, so the file needs no byte swapping on the writing machine.
+ *
+ * Typical use:
+ * @code
+ *   VtkXmlAppendedData appended(compress);
+ *   size_t ids = appended.addDataArray<int32_t>("FeatureIds", featureIds, numCells, 1);
+ *   appended.encode();
+ *   out << "<VTKFile type=\"ImageData\" version=\"1.0\" " << appended.getFileAttributes() << ">\n";
+ *   out << appended.getDataArrayTag(ids);
+ *   ...
+ *   appended.writeAppendedData(file);
+ * @endcode
+ */
+class VtkXmlAppendedData
+{
+  public:
+    VtkXmlAppendedData(bool compress);
+    virtual ~VtkXmlAppendedData();
+
+    /**
+     * @brief TypeName Returns the VTK XML type name for the primitive type T. Booleans are written as UInt8
+     */
+    template<typename T>
+    static QString TypeName()
+    {
+      T value = static_cast<T>(0);
+      if (typeid(value) == typeid(float)) { return "Float32"; }
+      if (typeid(value) == typeid(double)) { return "Float64"; }
+      if (typeid(value) == typeid(int8_t)) { return "Int8"; }
+      if (typeid(value) == typeid(uint8_t)) { return "UInt8"; }
+      if (typeid(value) == typeid(int16_t)) { return "Int16"; }
+      if (typeid(value) == typeid(uint16_t)) { return "UInt16"; }
+      if (typeid(value) == typeid(int32_t)) { return "Int32"; }
+      if (typeid(value) == typeid(uint32_t)) { return "UInt32"; }
+      if (typeid(value) == typeid(int64_t)) { return "Int64"; }
+      if (typeid(value) == typeid(uint64_t)) { return "UInt64"; }
+      if (typeid(value) == typeid(bool) && sizeof(bool) == 1) { return "UInt8"; }
+      return "";
+    }
+
+    /**
+     * @brief addDataArray Queues a data array. The memory must stay valid until writeAppendedData() returns
+     * @param name Name of the array in the file
+     * @param data Pointer to the values
+     * @param numValues Total number of values (tuples times components)
+     * @param numComps Number of components per tuple
+     * @return Index of the block to pass to getDataArrayTag()
+     */
+    template<typename T>
+    size_t addDataArray(const QString& name, const T* data, size_t numValues, int numComps)
+    {
+      return addBlock(TypeName<T>(), name, numComps, reinterpret_cast<const char*>(data), numValues * sizeof(T));
+    }
+
+    /**
+     * @brief AddIDataArray Queues a DataArray<T> under its own name. Meant to be dispatched with
+     * EXECUTE_FUNCTION_TEMPLATE; the index of the new block is appended to blocks
+     */
+    template<typename T>
+    static void AddIDataArray(VtkXmlAppendedData& appended, IDataArray::Pointer iDataPtr, std::vector<size_t>& blocks)
+    {
+      typename DataArray<T>::Pointer array = boost::dynamic_pointer_cast<DataArray<T> >(iDataPtr);
+      if (NULL == array.get()) { return; }
+      blocks.push_back(appended.addDataArray<T>(array->getName(), array->getPointer(0), array->getSize(), array->getNumberOfComponents()));
+    }
+
+    /**
+     * @brief encode Compresses the queued blocks if compression was requested and computes the offset
+     * of each block within the appended section. Must be called before any of the methods below
+     */
+    void encode();
+
+    /**
+     * @brief getFileAttributes Returns the byte_order, header_type and optional compressor attributes
+     * for the VTKFile element
+     */
+    QString getFileAttributes() const;
+
+    /**
+     * @brief getDataArrayTag Returns the complete, newline terminated DataArray element for a block
+     * @param block Block index returned by addDataArray()
+     * @param indent Number of spaces to indent the element by
+     */
+    QString getDataArrayTag(size_t block, int indent) const;
+
+    /**
+     * @brief writeAppendedData Writes the AppendedData element, including all of the blocks, to the file
+     * @return false if any write failed
+     */
+    bool writeAppendedData(QFile& out) const;
+
+  private:
+    struct Block
+    {
+      QString type;
+      QString name;
+      int numComps;
+      const char* data;
+      size_t numBytes;
+      std::vector<uint64_t> header;
+      std::vector<QByteArray> chunks;
+      uint64_t offset;
+    };
+
+    bool m_Compress;
+    std::vector<Block> m_Blocks;
+
+    size_t addBlock(const QString& type, const QString& name, int numComps, const char* data, size_t numBytes);
+
+    VtkXmlAppendedData(const VtkXmlAppendedData&); // Copy Constructor Not Implemented
+    void operator=(const VtkXmlAppendedData&); // Operator '=' Not Implemented
+};
+
+#endif /* _VtkXmlAppendedData_H_ */
@@ -0,0 +1,183 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QBuffer>
+#include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "IO/IOFilters/util/ParallelRowWriter.h"
+
+namespace
+{
+  // The writer formats 2048 rows per chunk and 256 chunks per batch; this is two full
+  // batches plus a partial batch that ends in a partial chunk
+  const size_t k_NumRows = 2 * 256 * 2048 + 3 * 2048 + 1234;
+}
+
+/**
+ * @brief The TestRowFormatter class writes a few columns that depend on the row index and
+ * counts how often each row is formatted
+ */
+class TestRowFormatter : public ParallelRowWriter::RowFormatter
+{
+  public:
+    TestRowFormatter(size_t numRows) :
+      m_Calls(numRows, 0)
+    {}
+    virtual ~TestRowFormatter() {}
+
+    void formatRows(QTextStream& out, size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        out << i << ',' << (i * 2654435761ULL) % 1000003ULL << ',' << static_cast<float>(i) * 0.25f << '\n';
+        // The writer hands out disjoint ranges, so each entry is only written by one thread
+        m_Calls[i]++;
+      }
+    }
+
+    void resetCalls()
+    {
+      std::fill(m_Calls.begin(), m_Calls.end(), 0);
+    }
+
+    int calls(size_t row) const
+    {
+      return m_Calls[row];
+    }
+
+  private:
+    mutable std::vector<int> m_Calls;
+};
+
+// -----------------------------------------------------------------------------
+// Formats rows [start, end) on a single stream, the way the writers did before
+// -----------------------------------------------------------------------------
+QByteArray FormatSerial(const TestRowFormatter& formatter, size_t start, size_t end)
+{
+  QByteArray expected;
+  QTextStream out(&expected, QIODevice::WriteOnly);
+  formatter.formatRows(out, start, end);
+  out.flush();
+  return expected;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray WriteParallel(TestRowFormatter& formatter, size_t start, size_t end, int numThreads)
+{
+  QByteArray written;
+  QBuffer buffer(&written);
+  DREAM3D_REQUIRE_EQUAL(buffer.open(QIODevice::WriteOnly), true)
+
+  formatter.resetCalls();
+  ParallelRowWriter writer(NULL, "Writing Rows");
+  ParallelContext::SetNumberOfThreads(numThreads);
+  bool ok = writer.write(buffer, formatter, start, end);
+  ParallelContext::SetNumberOfThreads(0);
+  buffer.close();
+  DREAM3D_REQUIRE_EQUAL(ok, true)
+
+  for (size_t i = 0; i < k_NumRows; i++)
+  {
+    int expectedCalls = (i >= start && i < end) ? 1 : 0;
+    DREAM3D_REQUIRE_EQUAL(formatter.calls(i), expectedCalls)
+  }
+  return written;
+}
+
+// -----------------------------------------------------------------------------
+// Whatever the number of threads, the device must receive exactly the bytes a single
+// stream would have produced, with the rows in order
+// -----------------------------------------------------------------------------
+void TestMatchesSerialFormatting(int numThreads)
+{
+  TestRowFormatter formatter(k_NumRows);
+
+  QByteArray expected = FormatSerial(formatter, 0, k_NumRows);
+  QByteArray written = WriteParallel(formatter, 0, k_NumRows, numThreads);
+  DREAM3D_REQUIRE_EQUAL(written.size(), expected.size())
+  DREAM3D_REQUIRE(written == expected)
+  DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(written.count('\n')), k_NumRows)
+
+  // A range that does not start on a chunk boundary
+  expected = FormatSerial(formatter, 1000, k_NumRows - 17);
+  written = WriteParallel(formatter, 1000, k_NumRows - 17, numThreads);
+  DREAM3D_REQUIRE(written == expected)
+
+  // An empty range writes nothing
+  written = WriteParallel(formatter, 50, 50, numThreads);
+  DREAM3D_REQUIRE_EQUAL(written.size(), 0)
+}
+
+// -----------------------------------------------------------------------------
+// A device that can not be written to must be reported
+// -----------------------------------------------------------------------------
+void TestWriteError()
+{
+  TestRowFormatter formatter(k_NumRows);
+  QByteArray data;
+  QBuffer buffer(&data);
+  DREAM3D_REQUIRE_EQUAL(buffer.open(QIODevice::ReadOnly), true)
+  ParallelRowWriter writer(NULL, "Writing Rows");
+  DREAM3D_REQUIRE_EQUAL(writer.write(buffer, formatter, 0, 10), false)
+  buffer.close();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestMatchesSerialFormatting(1) )
+  DREAM3D_REGISTER_TEST( TestMatchesSerialFormatting(4) )
+  DREAM3D_REGISTER_TEST( TestWriteError() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,373 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "IOTestFileLocations.h"
+
+namespace
+{
+  // A tetrahedron: 4 triangles sharing 4 vertices. Each row is the normal followed by the 3 vertices
+  const size_t k_NumTriangles = 4;
+  const size_t k_NumVertices = 4;
+  const float k_Triangles[k_NumTriangles][12] =
+  {
+    { 0.0f, 0.0f, -1.0f,   0.0f, 0.0f, 0.0f,   0.0f, 1.0f, 0.0f,   1.0f, 0.0f, 0.0f },
+    { 0.0f, -1.0f, 0.0f,   0.0f, 0.0f, 0.0f,   1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f },
+    { -1.0f, 0.0f, 0.0f,   0.0f, 0.0f, 0.0f,   0.0f, 0.0f, 1.0f,   0.0f, 1.0f, 0.0f },
+    { 0.57735027f, 0.57735027f, 0.57735027f,   1.0f, 0.0f, 0.0f,   0.0f, 1.0f, 0.0f,   0.0f, 0.0f, 1.0f }
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  QFile::remove(UnitTest::StlReaderTest::BinaryFile);
+  QFile::remove(UnitTest::StlReaderTest::AsciiFile);
+  QFile::remove(UnitTest::StlReaderTest::TruncatedFile);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the ReadStlFile Filter from the FilterManager
+  QString filtName = "ReadStlFile";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The StlReaderTest Requires the use of the " << filtName.toStdString() << " filter which is found in the IO Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Writes the tetrahedron as a binary STL file. When attributeBytes is not zero every
+// other record declares that many extra bytes after it. When numRecords is less than
+// the number of triangles the file is cut short after that many records while the
+// header still declares all of them. trailingBytes are appended after the last record.
+// -----------------------------------------------------------------------------
+void WriteBinaryStl(const QString& filePath, uint16_t attributeBytes, size_t numRecords,
+                    const char* headerText = "StlReaderTest binary file", size_t trailingBytes = 0)
+{
+  FILE* f = fopen(filePath.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE(NULL != f)
+
+  char header[80];
+  ::memset(header, 0, sizeof(header));
+  ::strncpy(header, headerText, sizeof(header) - 1);
+  fwrite(header, 1, sizeof(header), f);
+  uint32_t triCount = static_cast<uint32_t>(k_NumTriangles);
+  fwrite(&triCount, sizeof(uint32_t), 1, f);
+
+  for (size_t t = 0; t < numRecords; t++)
+  {
+    fwrite(k_Triangles[t], sizeof(float), 12, f);
+    uint16_t attr = (t % 2 == 1) ? attributeBytes : 0;
+    fwrite(&attr, sizeof(uint16_t), 1, f);
+    for (uint16_t i = 0; i < attr; i++)
+    {
+      fputc(0xAB, f);
+    }
+  }
+  for (size_t i = 0; i < trailingBytes; i++)
+  {
+    fputc(0xCD, f);
+  }
+  fclose(f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteAsciiStl(const QString& filePath)
+{
+  FILE* f = fopen(filePath.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE(NULL != f)
+
+  fprintf(f, "solid StlReaderTest\n");
+  for (size_t t = 0; t < k_NumTriangles; t++)
+  {
+    const float* r = k_Triangles[t];
+    fprintf(f, "  facet normal %.8e %.8e %.8e\n", r[0], r[1], r[2]);
+    fprintf(f, "    outer loop\n");
+    for (size_t v = 0; v < 3; v++)
+    {
+      fprintf(f, "      vertex %.8e %.8e %.8e\n", r[3 + 3 * v], r[4 + 3 * v], r[5 + 3 * v]);
+    }
+    fprintf(f, "    endloop\n");
+    fprintf(f, "  endfacet\n");
+  }
+  fprintf(f, "endsolid StlReaderTest\n");
+  fclose(f);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer RunReader(const QString& filePath, DataContainerArray::Pointer dca)
+{
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter("ReadStlFile");
+  DREAM3D_REQUIRE(NULL != filterFactory.get())
+  AbstractFilter::Pointer filter = filterFactory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(filePath);
+  bool propWasSet = filter->setProperty("StlFilePath", var);
+  DREAM3D_REQUIRE_EQUAL(propWasSet, true)
+
+  filter->execute();
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+// Checks that the mesh read back is the tetrahedron with its shared vertices merged
+// -----------------------------------------------------------------------------
+void CheckTetrahedron(DataContainerArray::Pointer dca)
+{
+  DataContainer::Pointer sm = dca->getDataContainer(DREAM3D::Defaults::TriangleDataContainerName);
+  DREAM3D_REQUIRE(NULL != sm.get())
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+  DREAM3D_REQUIRE(NULL != triangleGeom.get())
+  DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfTris(), static_cast<int64_t>(k_NumTriangles))
+  DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfVertices(), static_cast<int64_t>(k_NumVertices))
+
+  IDataArray::Pointer iNormals = sm->getAttributeMatrix(DREAM3D::Defaults::FaceAttributeMatrixName)->getAttributeArray(DREAM3D::FaceData::SurfaceMeshFaceNormals);
+  DoubleArrayType::Pointer normals = boost::dynamic_pointer_cast<DoubleArrayType>(iNormals);
+  DREAM3D_REQUIRE(NULL != normals.get())
+  DREAM3D_REQUIRE_EQUAL(normals->getNumberOfTuples(), k_NumTriangles)
+
+  int64_t* triangles = triangleGeom->getTriPointer(0);
+  for (size_t t = 0; t < k_NumTriangles; t++)
+  {
+    for (size_t c = 0; c < 3; c++)
+    {
+      DREAM3D_REQUIRE(std::fabs(normals->getValue(3 * t + c) - k_Triangles[t][c]) < 1.0e-6)
+    }
+    for (size_t v = 0; v < 3; v++)
+    {
+      float* vertex = triangleGeom->getVertexPointer(triangles[3 * t + v]);
+      for (size_t c = 0; c < 3; c++)
+      {
+        DREAM3D_REQUIRE_EQUAL(vertex[c], k_Triangles[t][3 + 3 * v + c])
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestBinaryStl()
+{
+  WriteBinaryStl(UnitTest::StlReaderTest::BinaryFile, 0, k_NumTriangles);
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = RunReader(UnitTest::StlReaderTest::BinaryFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  CheckTetrahedron(dca);
+
+  // Records with extra attribute bytes are not at a fixed stride
+  WriteBinaryStl(UnitTest::StlReaderTest::BinaryFile, 6, k_NumTriangles);
+  dca = DataContainerArray::New();
+  filter = RunReader(UnitTest::StlReaderTest::BinaryFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  CheckTetrahedron(dca);
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestAsciiStl()
+{
+  WriteAsciiStl(UnitTest::StlReaderTest::AsciiFile);
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = RunReader(UnitTest::StlReaderTest::AsciiFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  CheckTetrahedron(dca);
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Binary files whose header starts with "solid" must not be taken for ASCII, even
+// when their size does not match the fixed record layout
+// -----------------------------------------------------------------------------
+int TestSolidHeaderBinaryStl()
+{
+  WriteBinaryStl(UnitTest::StlReaderTest::BinaryFile, 0, k_NumTriangles, "solid StlReaderTest binary file", 7);
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = RunReader(UnitTest::StlReaderTest::BinaryFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  CheckTetrahedron(dca);
+
+  WriteBinaryStl(UnitTest::StlReaderTest::BinaryFile, 6, k_NumTriangles, "solid StlReaderTest binary file", 0);
+  dca = DataContainerArray::New();
+  filter = RunReader(UnitTest::StlReaderTest::BinaryFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), 0)
+  CheckTetrahedron(dca);
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// ASCII files that do not follow the facet layout must fail
+// -----------------------------------------------------------------------------
+int TestMalformedAsciiStl()
+{
+  // A facet without its endfacet, long enough to also hold a binary header
+  FILE* f = fopen(UnitTest::StlReaderTest::AsciiFile.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE(NULL != f)
+  fprintf(f, "solid StlReaderTest\n");
+  fprintf(f, "  facet normal 0 0 1\n    outer loop\n");
+  fprintf(f, "      vertex 0 0 0\n      vertex 1 0 0\n      vertex 0 1 0\n");
+  fprintf(f, "    endloop\n");
+  fprintf(f, "endsolid StlReaderTest\n");
+  fclose(f);
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = RunReader(UnitTest::StlReaderTest::AsciiFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -1005)
+
+  // A vertex that is not a number, in a file too short for a binary header
+  f = fopen(UnitTest::StlReaderTest::AsciiFile.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE(NULL != f)
+  fprintf(f, "solid\nfacet normal 0 0 1\nouter loop\nvertex 0 x 0\n");
+  fclose(f);
+  dca = DataContainerArray::New();
+  filter = RunReader(UnitTest::StlReaderTest::AsciiFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -1005)
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// A binary file that ends before all the triangles its header declares must fail
+// -----------------------------------------------------------------------------
+int TestTruncatedStl()
+{
+  WriteBinaryStl(UnitTest::StlReaderTest::TruncatedFile, 0, k_NumTriangles - 1);
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = RunReader(UnitTest::StlReaderTest::TruncatedFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -1004)
+
+  // The same with attribute bytes, where the records have to be walked one by one
+  WriteBinaryStl(UnitTest::StlReaderTest::TruncatedFile, 6, k_NumTriangles - 1);
+  dca = DataContainerArray::New();
+  filter = RunReader(UnitTest::StlReaderTest::TruncatedFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -1004)
+
+  // Too short to hold even the header
+  FILE* f = fopen(UnitTest::StlReaderTest::TruncatedFile.toLatin1().data(), "wb");
+  DREAM3D_REQUIRE(NULL != f)
+  fprintf(f, "STL");
+  fclose(f);
+  dca = DataContainerArray::New();
+  filter = RunReader(UnitTest::StlReaderTest::TruncatedFile, dca);
+  DREAM3D_REQUIRE_EQUAL(filter->getErrorCondition(), -1004)
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("StlReaderTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestBinaryStl() )
+  DREAM3D_REGISTER_TEST( TestAsciiStl() )
+  DREAM3D_REGISTER_TEST( TestSolidHeaderBinaryStl() )
+  DREAM3D_REGISTER_TEST( TestMalformedAsciiStl() )
+  DREAM3D_REGISTER_TEST( TestTruncatedStl() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
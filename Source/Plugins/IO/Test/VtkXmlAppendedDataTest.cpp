@@ -0,0 +1,381 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "IO/IOFilters/util/VtkXmlAppendedData.h"
+
+#include "IOTestFileLocations.h"
+
+namespace
+{
+  const size_t k_ChunkSize = 65536;
+  const QByteArray k_AppendedOpen("  <AppendedData encoding=\"raw\">\n   _");
+  const QByteArray k_AppendedClose("\n  </AppendedData>\n");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  QFile::remove(UnitTest::VtkXmlAppendedDataTest::AppendedFile);
+  QFile::remove(UnitTest::VtkXmlAppendedDataTest::ImageDataFile);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the VtkXmlImageDataWriter Filter from the FilterManager
+  QString filtName = "VtkXmlImageDataWriter";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The VtkXmlAppendedDataTest Requires the use of the " << filtName.toStdString() << " filter which is found in the IO Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Encodes the queued blocks with the given number of threads, writes them to the test
+// file and returns what was written between the '_' marker and the closing tag
+// -----------------------------------------------------------------------------
+QByteArray WriteAndReadBack(VtkXmlAppendedData& appended, int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+  appended.encode();
+  ParallelContext::SetNumberOfThreads(0);
+
+  QFile out(UnitTest::VtkXmlAppendedDataTest::AppendedFile);
+  DREAM3D_REQUIRE_EQUAL(out.open(QIODevice::WriteOnly), true)
+  DREAM3D_REQUIRE_EQUAL(appended.writeAppendedData(out), true)
+  out.close();
+
+  QFile in(UnitTest::VtkXmlAppendedDataTest::AppendedFile);
+  DREAM3D_REQUIRE_EQUAL(in.open(QIODevice::ReadOnly), true)
+  QByteArray contents = in.readAll();
+  in.close();
+
+  DREAM3D_REQUIRE(contents.startsWith(k_AppendedOpen))
+  DREAM3D_REQUIRE(contents.endsWith(k_AppendedClose))
+  return contents.mid(k_AppendedOpen.size(), contents.size() - k_AppendedOpen.size() - k_AppendedClose.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint64_t ReadUInt64(const QByteArray& data, uint64_t position)
+{
+  DREAM3D_REQUIRED(position + sizeof(uint64_t), <=, static_cast<uint64_t>(data.size()))
+  uint64_t value = 0;
+  ::memcpy(&value, data.constData() + position, sizeof(uint64_t));
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the value of the offset attribute of a DataArray element
+// -----------------------------------------------------------------------------
+uint64_t TagOffset(const QString& tag)
+{
+  bool ok = false;
+  uint64_t offset = tag.section("offset=\"", 1).section('"', 0, 0).toULongLong(&ok);
+  DREAM3D_REQUIRE_EQUAL(ok, true)
+  return offset;
+}
+
+// -----------------------------------------------------------------------------
+// Without compression every block is its byte count followed by the raw values
+// -----------------------------------------------------------------------------
+void TestUncompressedBlocks()
+{
+  std::vector<int32_t> ids(1000, 0);
+  for (size_t i = 0; i < ids.size(); i++)
+  {
+    ids[i] = static_cast<int32_t>(7 * i) - 3;
+  }
+  std::vector<float> normals(3 * 257, 0.0f);
+  for (size_t i = 0; i < normals.size(); i++)
+  {
+    normals[i] = 0.25f * static_cast<float>(i) - 11.0f;
+  }
+
+  VtkXmlAppendedData appended(false);
+  size_t idsBlock = appended.addDataArray<int32_t>("Ids", &(ids.front()), ids.size(), 1);
+  size_t normalsBlock = appended.addDataArray<float>("Normals", &(normals.front()), normals.size(), 3);
+  QByteArray data = WriteAndReadBack(appended, 1);
+
+  DREAM3D_REQUIRE_EQUAL(appended.getFileAttributes().contains("header_type=\"UInt64\""), true)
+  DREAM3D_REQUIRE_EQUAL(appended.getFileAttributes().contains("compressor"), false)
+  DREAM3D_REQUIRE_EQUAL(appended.getDataArrayTag(idsBlock, 2), QString("  <DataArray type=\"Int32\" Name=\"Ids\" NumberOfComponents=\"1\" format=\"appended\" offset=\"0\"/>\n"))
+  DREAM3D_REQUIRE_EQUAL(appended.getDataArrayTag(normalsBlock, 0), QString("<DataArray type=\"Float32\" Name=\"Normals\" NumberOfComponents=\"3\" format=\"appended\" offset=\"4008\"/>\n"))
+
+  uint64_t idsBytes = ids.size() * sizeof(int32_t);
+  uint64_t normalsBytes = normals.size() * sizeof(float);
+  DREAM3D_REQUIRE_EQUAL(static_cast<uint64_t>(data.size()), 2 * sizeof(uint64_t) + idsBytes + normalsBytes)
+  DREAM3D_REQUIRE_EQUAL(ReadUInt64(data, 0), idsBytes)
+  DREAM3D_REQUIRE_EQUAL(::memcmp(data.constData() + sizeof(uint64_t), &(ids.front()), idsBytes), 0)
+  uint64_t position = TagOffset(appended.getDataArrayTag(normalsBlock, 0));
+  DREAM3D_REQUIRE_EQUAL(ReadUInt64(data, position), normalsBytes)
+  DREAM3D_REQUIRE_EQUAL(::memcmp(data.constData() + position + sizeof(uint64_t), &(normals.front()), normalsBytes), 0)
+}
+
+// -----------------------------------------------------------------------------
+// Reads one compressed block at its offset: the chunk count, the chunk size, the size of
+// a partial last chunk and the compressed size of every chunk, followed by the zlib
+// streams. Every chunk must decompress to its part of the original values. Returns the
+// position just past the block.
+// -----------------------------------------------------------------------------
+uint64_t CheckCompressedBlock(const QByteArray& data, uint64_t position, const char* values, size_t numBytes)
+{
+  uint64_t numChunks = ReadUInt64(data, position);
+  DREAM3D_REQUIRE_EQUAL(numChunks, (numBytes + k_ChunkSize - 1) / k_ChunkSize)
+  DREAM3D_REQUIRE_EQUAL(ReadUInt64(data, position + 8), k_ChunkSize)
+  DREAM3D_REQUIRE_EQUAL(ReadUInt64(data, position + 16), numBytes % k_ChunkSize)
+
+  std::vector<uint64_t> compressedSizes(numChunks, 0);
+  for (uint64_t c = 0; c < numChunks; c++)
+  {
+    compressedSizes[c] = ReadUInt64(data, position + 24 + 8 * c);
+  }
+  position += 24 + 8 * numChunks;
+
+  for (uint64_t c = 0; c < numChunks; c++)
+  {
+    size_t start = c * k_ChunkSize;
+    int chunkBytes = static_cast<int>(std::min(k_ChunkSize, numBytes - start));
+    DREAM3D_REQUIRED(position + compressedSizes[c], <=, static_cast<uint64_t>(data.size()))
+
+    // qUncompress() expects the uncompressed size as a big endian UInt32 in front of the zlib stream
+    QByteArray zipped;
+    zipped.append(static_cast<char>((chunkBytes >> 24) & 0xFF));
+    zipped.append(static_cast<char>((chunkBytes >> 16) & 0xFF));
+    zipped.append(static_cast<char>((chunkBytes >> 8) & 0xFF));
+    zipped.append(static_cast<char>(chunkBytes & 0xFF));
+    zipped.append(data.constData() + position, static_cast<int>(compressedSizes[c]));
+    QByteArray chunk = qUncompress(zipped);
+    DREAM3D_REQUIRE_EQUAL(chunk.size(), chunkBytes)
+    DREAM3D_REQUIRE_EQUAL(::memcmp(chunk.constData(), values + start, chunkBytes), 0)
+    position += compressedSizes[c];
+  }
+  return position;
+}
+
+// -----------------------------------------------------------------------------
+// Compressed blocks that end in a partial chunk, in a full chunk, are empty or fit in
+// a single chunk. Each block starts where the one before it ends and the bytes written
+// do not depend on the number of threads.
+// -----------------------------------------------------------------------------
+void TestCompressedBlocks()
+{
+  std::vector<uint8_t> partial(2 * k_ChunkSize + 100, 0);
+  for (size_t i = 0; i < partial.size(); i++)
+  {
+    partial[i] = static_cast<uint8_t>((i * i + i / 7) % 251);
+  }
+  std::vector<double> full(2 * k_ChunkSize / sizeof(double), 0.0);
+  for (size_t i = 0; i < full.size(); i++)
+  {
+    full[i] = 1.0 / static_cast<double>(i + 1);
+  }
+  std::vector<float> small(10, 0.0f);
+  for (size_t i = 0; i < small.size(); i++)
+  {
+    small[i] = static_cast<float>(i) * 1.5f;
+  }
+
+  QByteArray written[2];
+  for (int run = 0; run < 2; run++)
+  {
+    VtkXmlAppendedData appended(true);
+    size_t blocks[4] = { 0, 0, 0, 0 };
+    blocks[0] = appended.addDataArray<uint8_t>("Partial", &(partial.front()), partial.size(), 1);
+    blocks[1] = appended.addDataArray<double>("Full", &(full.front()), full.size(), 2);
+    blocks[2] = appended.addDataArray<int16_t>("Empty", static_cast<const int16_t*>(NULL), 0, 1);
+    blocks[3] = appended.addDataArray<float>("Small", &(small.front()), small.size(), 1);
+    QByteArray data = WriteAndReadBack(appended, (run == 0) ? 1 : 4);
+    DREAM3D_REQUIRE_EQUAL(appended.getFileAttributes().contains("compressor=\"vtkZLibDataCompressor\""), true)
+
+    const char* values[4] = { reinterpret_cast<const char*>(&(partial.front())), reinterpret_cast<const char*>(&(full.front())),
+                              NULL, reinterpret_cast<const char*>(&(small.front()))
+                            };
+    size_t numBytes[4] = { partial.size(), full.size() * sizeof(double), 0, small.size() * sizeof(float) };
+    uint64_t position = 0;
+    for (int b = 0; b < 4; b++)
+    {
+      DREAM3D_REQUIRE_EQUAL(TagOffset(appended.getDataArrayTag(blocks[b], 0)), position)
+      position = CheckCompressedBlock(data, position, values[b], numBytes[b]);
+    }
+    DREAM3D_REQUIRE_EQUAL(position, static_cast<uint64_t>(data.size()))
+    written[run] = data;
+  }
+  DREAM3D_REQUIRE(written[0] == written[1])
+}
+
+// -----------------------------------------------------------------------------
+// The origin and spacing attributes of a .vti file must read back as the exact float
+// values of the Image Geometry
+// -----------------------------------------------------------------------------
+void TestImageDataOriginAndSpacing()
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DREAM3D::Defaults::ImageDataContainerName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  size_t dims[3] = { 3, 2, 2 };
+  float res[3] = { 0.333333343f, 0.1f, 2.71828175f };
+  float origin[3] = { 0.123456791f, -7.00000048f, 1024.00012f };
+  image->setDimensions(dims);
+  image->setResolution(res);
+  image->setOrigin(origin);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  QVector<size_t> cDims(1, 1);
+  Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::FeatureIds);
+  for (size_t i = 0; i < featureIds->getNumberOfTuples(); i++)
+  {
+    featureIds->setValue(i, static_cast<int32_t>(i));
+  }
+  cellAttrMat->addAttributeArray(featureIds->getName(), featureIds);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+  dca->addDataContainer(m);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("VtkXmlImageDataWriter");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(UnitTest::VtkXmlAppendedDataTest::ImageDataFile);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("OutputFile", var), true)
+  var.setValue(true);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CompressData", var), true)
+  QVector<DataArrayPath> paths(1, DataArrayPath(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds));
+  var.setValue(paths);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SelectedDataArrayPaths", var), true)
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  QFile in(UnitTest::VtkXmlAppendedDataTest::ImageDataFile);
+  DREAM3D_REQUIRE_EQUAL(in.open(QIODevice::ReadOnly), true)
+  QString header = QString::fromLatin1(in.read(1024));
+  in.close();
+
+  QStringList originValues = header.section("Origin=\"", 1).section('"', 0, 0).split(' ');
+  QStringList spacingValues = header.section("Spacing=\"", 1).section('"', 0, 0).split(' ');
+  DREAM3D_REQUIRE_EQUAL(originValues.size(), 3)
+  DREAM3D_REQUIRE_EQUAL(spacingValues.size(), 3)
+  for (int i = 0; i < 3; i++)
+  {
+    // The points are cell centered, so the file origin is half a cell before the geometry origin
+    float expectedOrigin = origin[i] - res[i] * 0.5f;
+    DREAM3D_REQUIRE_EQUAL(originValues[i].toFloat(), expectedOrigin)
+    DREAM3D_REQUIRE_EQUAL(spacingValues[i].toFloat(), res[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("VtkXmlAppendedDataTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestUncompressedBlocks() )
+  DREAM3D_REGISTER_TEST( TestCompressedBlocks() )
+  DREAM3D_REGISTER_TEST( TestImageDataOriginAndSpacing() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -36,12 +36,23 @@
 
 #include "ImportImageStack.h"
 
+#include <algorithm>
+#include <vector>
+
+#include <QtGui/QImage>
 #include <QtGui/QImageReader>
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
+#include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
@@ -49,12 +60,108 @@
 #include "SIMPLib/FilterParameters/InputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Utilities/FilePathGenerator.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "ImageIO/ImageIOConstants.h"
+#include "ImageIO/ImageIOFilters/util/TiffSliceReader.h"
 
 // Include the MOC generated file for this class
 #include "moc_ImportImageStack.cpp"
 
+namespace Detail
+{
+  // Slices decoded between progress updates and cancel checks
+  static const size_t k_SlicesPerBatch = 32;
+
+  static const int32_t k_LoadImageFailed = -14000;
+  static const int32_t k_MismatchedImage = -14001;
+}
+
+/**
+ * @brief The ImportImageSlicesImpl class implements a threaded algorithm that decodes a range of image
+ * files, each straight into its own slice of the destination array. TIFF files the TiffSliceReader
+ * understands are decoded natively; all other files are read through QImage. 16 bit grayscale TIFF files
+ * are only decoded natively when their full depth is kept, otherwise QImage reduces them to 8 bits.
+ */
+class ImportImageSlicesImpl
+{
+  public:
+    ImportImageSlicesImpl(const QVector<QString>& fileList, uint8_t* destination, int32_t width, int32_t height,
+                          int32_t numComps, int32_t compBytes, bool keepFullBitDepth, int32_t* status) :
+      m_FileList(fileList),
+      m_Destination(destination),
+      m_Width(width),
+      m_Height(height),
+      m_NumComps(numComps),
+      m_CompBytes(compBytes),
+      m_KeepFullBitDepth(keepFullBitDepth),
+      m_Status(status)
+    {}
+    virtual ~ImportImageSlicesImpl() {}
+
+    int32_t importSlice(const QString& filePath, uint8_t* slice) const
+    {
+      TiffSliceReader tiffReader;
+      if (tiffReader.readHeader(filePath) == true && (tiffReader.getBytesPerComponent() == 1 || m_KeepFullBitDepth == true))
+      {
+        if (tiffReader.getWidth() != m_Width || tiffReader.getHeight() != m_Height
+            || tiffReader.getNumberOfComponents() != m_NumComps || tiffReader.getBytesPerComponent() != m_CompBytes)
+        {
+          return Detail::k_MismatchedImage;
+        }
+        if (tiffReader.readImage(slice) == true) { return 0; }
+      }
+
+      QImage image(filePath);
+      if (image.isNull() == true) { return Detail::k_LoadImageFailed; }
+
+      int32_t pixelBytes = 0;
+      if (image.format() == QImage::Format_Indexed8) { pixelBytes = 1; }
+      else if (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32) { pixelBytes = 4; }
+      if (image.width() != m_Width || image.height() != m_Height || pixelBytes != m_NumComps || m_CompBytes != 1)
+      {
+        return Detail::k_MismatchedImage;
+      }
+#if defined (CMP_WORDS_BIGENDIAN)
+#error
+#else
+      // We need to convert from Little Endian based ARGB to a physical RGB layout
+      image = image.rgbSwapped();
+#endif
+      size_t rowBytes = size_t(m_Width) * pixelBytes;
+      for (int32_t i = 0; i < m_Height; ++i)
+      {
+        ::memcpy(slice + i * rowBytes, image.scanLine(i), rowBytes);
+      }
+      return 0;
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      size_t sliceBytes = size_t(m_Width) * m_Height * m_NumComps * m_CompBytes;
+      for (size_t z = start; z < end; z++)
+      {
+        m_Status[z] = importSlice(m_FileList[static_cast<int32_t>(z)], m_Destination + z * sliceBytes);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const QVector<QString>& m_FileList;
+    uint8_t* m_Destination;
+    int32_t m_Width;
+    int32_t m_Height;
+    int32_t m_NumComps;
+    int32_t m_CompBytes;
+    bool m_KeepFullBitDepth;
+    int32_t* m_Status;
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -66,7 +173,8 @@ ImportImageStack::ImportImageStack() :
   m_CellAttributeMatrixName(DREAM3D::Defaults::CellAttributeMatrixName),
   m_BoundsFile(""),
   m_GeometryType(0),
-  m_ImageDataArrayName(DREAM3D::CellData::ImageData)
+  m_ImageDataArrayName(DREAM3D::CellData::ImageData),
+  m_KeepFullBitDepth(false)
 {
   m_Origin.x = 0.0f;
   m_Origin.y = 0.0f;
@@ -98,6 +206,7 @@ void ImportImageStack::setupFilterParameters()
 {
   QVector<FilterParameter::Pointer> parameters;
   parameters.push_back(FileListInfoFilterParameter::New("Input File List", "InputFileListInfo", getInputFileListInfo(), FilterParameter::Parameter));
+  parameters.push_back(BooleanFilterParameter::New("Keep 16 Bit Grayscale Depth", "KeepFullBitDepth", getKeepFullBitDepth(), FilterParameter::Parameter));
   {
     LinkedChoicesFilterParameter::Pointer parameter = LinkedChoicesFilterParameter::New();
     parameter->setHumanLabel("Geometry Type");
@@ -138,6 +247,7 @@ void ImportImageStack::readFilterParameters(AbstractFilterParametersReader* read
   setResolution( reader->readFloatVec3("Resolution", getResolution()) );
   setGeometryType(reader->readValue("GeometryType", getGeometryType()));
   setBoundsFile(reader->readString("BoundsFile", getBoundsFile()));
+  setKeepFullBitDepth(reader->readValue("KeepFullBitDepth", getKeepFullBitDepth()));
   reader->closeFilterGroup();
 }
 
@@ -156,6 +266,7 @@ int ImportImageStack::writeFilterParameters(AbstractFilterParametersWriter* writ
   SIMPL_FILTER_WRITE_PARAMETER(Resolution)
   SIMPL_FILTER_WRITE_PARAMETER(GeometryType)
   SIMPL_FILTER_WRITE_PARAMETER(BoundsFile)
+  SIMPL_FILTER_WRITE_PARAMETER(KeepFullBitDepth)
   writer->closeFilterGroup();
   return ++index; // we want to return the next index that was just written to
 }
@@ -232,8 +343,11 @@ void ImportImageStack::dataCheck()
     // We should read the file and see what we have? Of course Qt is going to read it up into
     // an RGB array by default
     int32_t err = 0;
+    TiffSliceReader tiffReader;
+    // 16 bit grayscale TIFF files go through QImage, and so become 8 bit, unless their full depth is asked for
+    bool nativeTiff = tiffReader.readHeader(fileList[0]) && (tiffReader.getBytesPerComponent() == 1 || m_KeepFullBitDepth == true);
     QImageReader reader((fileList[0]));
-    QSize imageDims = reader.size();
+    QSize imageDims = nativeTiff ? QSize(tiffReader.getWidth(), tiffReader.getHeight()) : reader.size();
     int64_t dims[3] = { imageDims.width(), imageDims.height(), fileList.size() };
     /* Sanity check what we are trying to load to make sure it can fit in our address space.
      * Note that this does not guarantee the user has enough left, just that the
@@ -282,15 +396,21 @@ void ImportImageStack::dataCheck()
     }
     m->createNonPrereqAttributeMatrix<AbstractFilter>(this, getCellAttributeMatrixName(), tDims, DREAM3D::AttributeMatrixType::Cell);
 
-    int32_t pixelBytes = 0;
+    int32_t numComps = 0;
+    int32_t compBytes = 1;
 
-    if (reader.imageFormat() == QImage::Format_Indexed8)
+    if (nativeTiff == true)
+    {
+      numComps = tiffReader.getNumberOfComponents();
+      compBytes = tiffReader.getBytesPerComponent();
+    }
+    else if (reader.imageFormat() == QImage::Format_Indexed8)
     {
-      pixelBytes = 1;
+      numComps = 1;
     }
     else if (reader.imageFormat() == QImage::Format_RGB32 || reader.imageFormat() == QImage::Format_ARGB32)
     {
-      pixelBytes = 4;
+      numComps = 4;
     }
     else
     {
@@ -299,12 +419,16 @@ void ImportImageStack::dataCheck()
       notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
     }
 
-    QVector<size_t> cDims(1, pixelBytes);
-    // This would be for a gray scale image
+    QVector<size_t> cDims(1, numComps);
     tempPath.update(getDataContainerName(), getCellAttributeMatrixName(), getImageDataArrayName() );
-    m_ImageDataPtr = getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint8_t>, AbstractFilter, uint8_t>(this, tempPath, 0, cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if( NULL != m_ImageDataPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
-    { m_ImageData = m_ImageDataPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if (compBytes == 2)
+    {
+      getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint16_t>, AbstractFilter, uint16_t>(this, tempPath, 0, cDims);
+    }
+    else
+    {
+      getDataContainerArray()->createNonPrereqArrayFromPath<DataArray<uint8_t>, AbstractFilter, uint8_t>(this, tempPath, 0, cDims);
+    }
   }
 }
 
@@ -343,17 +467,6 @@ void ImportImageStack::execute()
     int err = readBounds();
     if (err < 0) return;
   }
-  UInt8ArrayType::Pointer data = UInt8ArrayType::NullPointer();
-
-  uint8_t* imagePtr = NULL;
-
-  int32_t pixelBytes = 0;
-  int32_t totalPixels = 0;
-  int32_t height = 0;
-  int32_t width = 0;
-
-  int64_t z = m_InputFileListInfo.StartIndex;
-  int64_t zSpot;
 
   bool hasMissingFiles = false;
   bool orderAscending = false;
@@ -372,70 +485,47 @@ void ImportImageStack::execute()
     QString ss = QObject::tr("No files have been selected for import");
     setErrorCondition(-11);
     notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
 
-  for (QVector<QString>::iterator filepath = fileList.begin(); filepath != fileList.end(); ++filepath)
+  // dataCheck() sized the image data array from the first file, so every file is decoded directly into its slice
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
+  IDataArray::Pointer imageData = cellAttrMat->getAttributeArray(getImageDataArrayName());
+  QVector<size_t> tDims = cellAttrMat->getTupleDimensions();
+  uint8_t* destination = reinterpret_cast<uint8_t*>(imageData->getVoidPointer(0));
+
+  size_t numSlices = static_cast<size_t>(fileList.size());
+  std::vector<int32_t> status(numSlices, 0);
+  ImportImageSlicesImpl importer(fileList, destination, static_cast<int32_t>(tDims[0]), static_cast<int32_t>(tDims[1]),
+                                 imageData->getNumberOfComponents(), static_cast<int32_t>(imageData->getTypeSize()), m_KeepFullBitDepth, &(status.front()));
+
+  for (size_t batchStart = 0; batchStart < numSlices; batchStart += Detail::k_SlicesPerBatch)
   {
-    QString imageFName = *filepath;
-    QString ss = QObject::tr("Importing file %1").arg(imageFName);
+    size_t batchEnd = std::min(batchStart + Detail::k_SlicesPerBatch, numSlices);
+    QString ss = QObject::tr("Importing files %1 to %2 of %3").arg(batchStart + 1).arg(batchEnd).arg(numSlices);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
-    QImage image(imageFName);
-    if (image.isNull() == true)
-    {
-      setErrorCondition(-14000);
-      notifyErrorMessage(getHumanLabel(), "Failed to load image file", getErrorCondition());
-      return;
-    }
-#if defined (CMP_WORDS_BIGENDIAN)
-#error
-#else
-    // We need to convert from Little Endian based ARGB to a physical RGB layout
-    image = image.rgbSwapped();
-#endif
-    height = image.height();
-    width = image.width();
-    totalPixels = width * height;
-    // This is the first image so we need to create our block of data to store the data
-    if (z == m_InputFileListInfo.StartIndex)
+    ParallelContext::ParallelFor<size_t>(batchStart, batchEnd, importer);
+
+    for (size_t z = batchStart; z < batchEnd; z++)
     {
-      if (m_GeometryType == 0) { m->getGeometryAs<ImageGeom>()->setDimensions(width, height, fileList.size()); }
-      else if (m_GeometryType == 1) { m->getGeometryAs<RectGridGeom>()->setDimensions(width, height, fileList.size()); }
-      if (image.format() == QImage::Format_Indexed8)
-      {
-        pixelBytes = 1;
-      }
-      else if (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32)
+      if (status[z] == 0) { continue; }
+      if (status[z] == Detail::k_LoadImageFailed)
       {
-        pixelBytes = 4;
+        ss = QObject::tr("Failed to load image file %1").arg(fileList[static_cast<int32_t>(z)]);
       }
       else
       {
-        ss = QObject::tr("Image format is of unsupported type. Imported images must be either grayscale, RGB, or ARGB");
-        setErrorCondition(-1);
-        notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-        return;
+        ss = QObject::tr("Image file %1 does not have the same size and format as the first image").arg(fileList[static_cast<int32_t>(z)]);
       }
-      QVector<size_t> compDims(1, pixelBytes);
-
-      data = UInt8ArrayType::CreateArray(size_t(fileList.size()) * height * width, compDims, m_ImageDataArrayName);
-    }
-
-    // Get the current position in the array to copy the image into
-    zSpot = (z -  m_InputFileListInfo.StartIndex);
-    for (int32_t i = 0; i < height; ++i)
-    {
-      imagePtr = data->getPointer( (zSpot) * totalPixels * pixelBytes + i * (width * pixelBytes));
-      uint8_t* source = image.scanLine(i);
-      ::memcpy(imagePtr, source, width * pixelBytes);
+      setErrorCondition(status[z]);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
     }
 
-    ++z;
     if (getCancel() == true) { return; }
   }
 
-  m->getAttributeMatrix(getCellAttributeMatrixName())->addAttributeArray(data->getName(), data);
-
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
@@ -85,6 +85,9 @@ class ImportImageStack : public AbstractFilter
     SIMPL_FILTER_PARAMETER(QString, ImageDataArrayName)
     Q_PROPERTY(QString ImageDataArrayName READ getImageDataArrayName WRITE setImageDataArrayName)
 
+    SIMPL_FILTER_PARAMETER(bool, KeepFullBitDepth)
+    Q_PROPERTY(bool KeepFullBitDepth READ getKeepFullBitDepth WRITE setKeepFullBitDepth)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -172,8 +175,6 @@ class ImportImageStack : public AbstractFilter
     int readBounds();
 
   private:
-    DEFINE_DATAARRAY_VARIABLE(uint8_t, ImageData)
-
     ImportImageStack(const ImportImageStack&); // Copy Constructor Not Implemented
     void operator=(const ImportImageStack&); // Operator '=' Not Implemented
 };
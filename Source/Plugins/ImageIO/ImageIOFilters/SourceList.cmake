@@ -43,6 +43,10 @@ foreach(f ${_PrivateFilters} )
 endforeach()
 
 
+#-------------
+# These are files that need to be compiled into DREAM3DLib but are NOT filters
+ADD_DREAM3D_SUPPORT_HEADER(${ImageIO_SOURCE_DIR} ${_filterGroupName} util/TiffSliceReader.h)
+ADD_DREAM3D_SUPPORT_SOURCE(${ImageIO_SOURCE_DIR} ${_filterGroupName} util/TiffSliceReader.cpp)
 
 
 END_FILTER_GROUP(${ImageIO_BINARY_DIR} "${_filterGroupName}" "Image Import Filters")
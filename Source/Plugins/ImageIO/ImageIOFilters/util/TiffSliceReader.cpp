@@ -0,0 +1,448 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TiffSliceReader.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace Detail
+{
+  enum TiffTag
+  {
+    ImageWidth = 256,
+    ImageLength = 257,
+    BitsPerSample = 258,
+    Compression = 259,
+    Photometric = 262,
+    FillOrder = 266,
+    StripOffsets = 273,
+    Orientation = 274,
+    SamplesPerPixel = 277,
+    RowsPerStrip = 278,
+    StripByteCounts = 279,
+    PlanarConfig = 284,
+    Predictor = 317,
+    TileWidth = 322,
+    ExtraSamples = 338,
+    SampleFormat = 339
+  };
+
+  enum TiffFieldType
+  {
+    Byte = 1,
+    Short = 3,
+    Long = 4
+  };
+
+  static const int32_t k_CompressionNone = 1;
+  static const int32_t k_CompressionLZW = 5;
+  static const int32_t k_PhotometricMinIsBlack = 1;
+  static const int32_t k_PhotometricRGB = 2;
+  static const int32_t k_ExtraSampleUnspecified = 0;
+
+  static const int32_t k_LZWClear = 256;
+  static const int32_t k_LZWEndOfInformation = 257;
+  static const int32_t k_LZWFirstCode = 258;
+  static const int32_t k_LZWMaxBits = 12;
+
+  /**
+   * @brief DecodeLZW Decodes a TIFF LZW (MSB first, early change) compressed strip into dst
+   * @return false if the data is corrupt or holds fewer than dstSize bytes
+   */
+  static bool DecodeLZW(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+  {
+    // Old style (LSB first) LZW streams begin with a cleared low bit followed by a set one
+    if (srcSize >= 2 && src[0] == 0 && (src[1] & 0x01) != 0) { return false; }
+
+    std::vector<uint16_t> prefix(1 << k_LZWMaxBits, 0);
+    std::vector<uint8_t> suffix(1 << k_LZWMaxBits, 0);
+    std::vector<uint8_t> firstChar(1 << k_LZWMaxBits, 0);
+    std::vector<uint16_t> length(1 << k_LZWMaxBits, 0);
+    for (int32_t i = 0; i < 256; i++)
+    {
+      suffix[i] = static_cast<uint8_t>(i);
+      firstChar[i] = static_cast<uint8_t>(i);
+      length[i] = 1;
+    }
+
+    int32_t nextCode = k_LZWFirstCode;
+    int32_t codeBits = 9;
+    int32_t previous = -1;
+    uint32_t bitBuffer = 0;
+    int32_t bitCount = 0;
+    size_t in = 0;
+    size_t out = 0;
+
+    while (out < dstSize)
+    {
+      while (bitCount < codeBits && in < srcSize)
+      {
+        bitBuffer = (bitBuffer << 8) | src[in++];
+        bitCount += 8;
+      }
+      if (bitCount < codeBits) { break; }
+      int32_t code = static_cast<int32_t>((bitBuffer >> (bitCount - codeBits)) & ((1u << codeBits) - 1));
+      bitCount -= codeBits;
+
+      if (code == k_LZWEndOfInformation) { break; }
+      if (code == k_LZWClear)
+      {
+        nextCode = k_LZWFirstCode;
+        codeBits = 9;
+        previous = -1;
+        continue;
+      }
+      if (previous < 0)
+      {
+        if (code > 255) { return false; }
+        dst[out++] = static_cast<uint8_t>(code);
+        previous = code;
+        continue;
+      }
+      if (code > nextCode) { return false; }
+
+      // A code that is not in the table yet is the previous string plus its own first character
+      int32_t stringCode = (code < nextCode) ? code : previous;
+      size_t stringEnd = out + length[stringCode];
+      if (code == nextCode) { stringEnd++; }
+      size_t pos = stringEnd;
+      if (code == nextCode)
+      {
+        pos--;
+        if (pos < dstSize) { dst[pos] = firstChar[previous]; }
+      }
+      for (int32_t c = stringCode; pos > out; c = prefix[c])
+      {
+        pos--;
+        if (pos < dstSize) { dst[pos] = suffix[c]; }
+      }
+      out = std::min(stringEnd, dstSize);
+
+      if (nextCode < (1 << k_LZWMaxBits))
+      {
+        prefix[nextCode] = static_cast<uint16_t>(previous);
+        suffix[nextCode] = firstChar[stringCode];
+        firstChar[nextCode] = firstChar[previous];
+        length[nextCode] = length[previous] + 1;
+        nextCode++;
+        if (nextCode >= (1 << codeBits) - 1 && codeBits < k_LZWMaxBits) { codeBits++; }
+      }
+      previous = code;
+    }
+    return (out == dstSize);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TiffSliceReader::TiffSliceReader() :
+  m_Data(NULL),
+  m_Size(0),
+  m_SwapBytes(false),
+  m_Width(0),
+  m_Height(0),
+  m_BitsPerSample(0),
+  m_SamplesPerPixel(0),
+  m_RowsPerStrip(0),
+  m_Compression(0),
+  m_Predictor(1)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TiffSliceReader::~TiffSliceReader()
+{
+  close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TiffSliceReader::close()
+{
+  if (NULL != m_Data) { m_File.unmap(const_cast<uchar*>(m_Data)); }
+  m_Data = NULL;
+  m_Size = 0;
+  m_File.close();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint16_t TiffSliceReader::readUInt16(quint64 offset) const
+{
+  const uint8_t* p = m_Data + offset;
+  return m_SwapBytes ? static_cast<uint16_t>((p[0] << 8) | p[1]) : static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+uint32_t TiffSliceReader::readUInt32(quint64 offset) const
+{
+  const uint8_t* p = m_Data + offset;
+  if (m_SwapBytes) { return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]); }
+  return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TiffSliceReader::readValues(quint64 entryOffset, QVector<quint64>& values) const
+{
+  uint16_t type = readUInt16(entryOffset + 2);
+  quint64 count = readUInt32(entryOffset + 4);
+  quint64 size = 0;
+  if (type == Detail::Byte) { size = 1; }
+  else if (type == Detail::Short) { size = 2; }
+  else if (type == Detail::Long) { size = 4; }
+  else { return false; }
+
+  // Values that fit in the four byte value field are stored inline
+  quint64 offset = entryOffset + 8;
+  if (count * size > 4) { offset = readUInt32(entryOffset + 8); }
+  if (count == 0 || offset + count * size > quint64(m_Size)) { return false; }
+
+  values.resize(count);
+  for (quint64 i = 0; i < count; i++)
+  {
+    if (size == 1) { values[i] = m_Data[offset + i]; }
+    else if (size == 2) { values[i] = readUInt16(offset + i * 2); }
+    else { values[i] = readUInt32(offset + i * 4); }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TiffSliceReader::readHeader(const QString& filePath)
+{
+  close();
+  m_File.setFileName(filePath);
+  if (m_File.open(QIODevice::ReadOnly) == false) { return false; }
+  m_Size = m_File.size();
+  if (m_Size < 8) { return false; }
+  m_Data = m_File.map(0, m_Size);
+  if (NULL == m_Data) { return false; }
+
+  bool fileBigEndian = false;
+  if (m_Data[0] == 'I' && m_Data[1] == 'I') { fileBigEndian = false; }
+  else if (m_Data[0] == 'M' && m_Data[1] == 'M') { fileBigEndian = true; }
+  else { return false; }
+#ifdef CMP_WORDS_BIGENDIAN
+  m_SwapBytes = !fileBigEndian;
+#else
+  m_SwapBytes = fileBigEndian;
+#endif
+  // BigTIFF files (version 43) are left to the general purpose reader
+  if (readUInt16(2) != 42) { return false; }
+
+  quint64 ifdOffset = readUInt32(4);
+  if (ifdOffset + 2 > quint64(m_Size)) { return false; }
+  uint16_t numEntries = readUInt16(ifdOffset);
+  if (ifdOffset + 2 + numEntries * 12 > quint64(m_Size)) { return false; }
+
+  m_Width = 0;
+  m_Height = 0;
+  m_BitsPerSample = 1;
+  m_SamplesPerPixel = 1;
+  m_RowsPerStrip = 0;
+  m_Compression = Detail::k_CompressionNone;
+  m_Predictor = 1;
+  m_StripOffsets.clear();
+  m_StripByteCounts.clear();
+  int32_t photometric = -1;
+  int32_t extraSample = Detail::k_ExtraSampleUnspecified;
+
+  QVector<quint64> values;
+  for (uint16_t e = 0; e < numEntries; e++)
+  {
+    quint64 entryOffset = ifdOffset + 2 + e * 12;
+    uint16_t tag = readUInt16(entryOffset);
+    if (tag == Detail::TileWidth) { return false; }
+    if (tag != Detail::ImageWidth && tag != Detail::ImageLength && tag != Detail::BitsPerSample
+        && tag != Detail::Compression && tag != Detail::Photometric && tag != Detail::FillOrder
+        && tag != Detail::StripOffsets && tag != Detail::Orientation && tag != Detail::SamplesPerPixel
+        && tag != Detail::RowsPerStrip && tag != Detail::StripByteCounts && tag != Detail::PlanarConfig
+        && tag != Detail::Predictor && tag != Detail::ExtraSamples && tag != Detail::SampleFormat)
+    {
+      continue;
+    }
+    if (readValues(entryOffset, values) == false) { return false; }
+
+    switch(tag)
+    {
+      case Detail::ImageWidth: m_Width = static_cast<int32_t>(values[0]); break;
+      case Detail::ImageLength: m_Height = static_cast<int32_t>(values[0]); break;
+      case Detail::BitsPerSample:
+        // Every sample must have the same depth
+        for (int32_t i = 1; i < values.size(); i++) { if (values[i] != values[0]) { return false; } }
+        m_BitsPerSample = static_cast<int32_t>(values[0]);
+        break;
+      case Detail::Compression: m_Compression = static_cast<int32_t>(values[0]); break;
+      case Detail::Photometric: photometric = static_cast<int32_t>(values[0]); break;
+      case Detail::FillOrder: if (values[0] != 1) { return false; } break;
+      case Detail::StripOffsets: m_StripOffsets = values; break;
+      case Detail::Orientation: if (values[0] != 1) { return false; } break;
+      case Detail::SamplesPerPixel: m_SamplesPerPixel = static_cast<int32_t>(values[0]); break;
+      case Detail::RowsPerStrip: m_RowsPerStrip = static_cast<int32_t>(std::min<quint64>(values[0], 0x7fffffff)); break;
+      case Detail::StripByteCounts: m_StripByteCounts = values; break;
+      case Detail::PlanarConfig: if (values[0] != 1) { return false; } break;
+      case Detail::Predictor: m_Predictor = static_cast<int32_t>(values[0]); break;
+      case Detail::ExtraSamples: extraSample = static_cast<int32_t>(values[0]); break;
+      case Detail::SampleFormat: if (values[0] != 1) { return false; } break;
+      default: break;
+    }
+  }
+
+  if (m_Width <= 0 || m_Height <= 0) { return false; }
+  if (m_Compression != Detail::k_CompressionNone && m_Compression != Detail::k_CompressionLZW) { return false; }
+  // The predictor belongs to the compression scheme, so like libtiff it is ignored for uncompressed strips
+  if (m_Compression == Detail::k_CompressionNone) { m_Predictor = 1; }
+  if (m_Predictor != 1 && m_Predictor != 2) { return false; }
+  if (photometric == Detail::k_PhotometricMinIsBlack)
+  {
+    if (m_SamplesPerPixel != 1 || (m_BitsPerSample != 8 && m_BitsPerSample != 16)) { return false; }
+  }
+  else if (photometric == Detail::k_PhotometricRGB)
+  {
+    if ((m_SamplesPerPixel != 3 && m_SamplesPerPixel != 4) || m_BitsPerSample != 8) { return false; }
+    // QImage premultiplies a declared alpha channel, so only files whose fourth sample is left
+    // unspecified are passed through unchanged by both readers
+    if (m_SamplesPerPixel == 4 && extraSample != Detail::k_ExtraSampleUnspecified) { return false; }
+  }
+  else
+  {
+    return false;
+  }
+
+  if (m_RowsPerStrip <= 0 || m_RowsPerStrip > m_Height) { m_RowsPerStrip = m_Height; }
+  int32_t numStrips = (m_Height + m_RowsPerStrip - 1) / m_RowsPerStrip;
+  if (m_StripOffsets.size() != numStrips || m_StripByteCounts.size() != numStrips) { return false; }
+  for (int32_t s = 0; s < numStrips; s++)
+  {
+    if (m_StripOffsets[s] + m_StripByteCounts[s] > quint64(m_Size)) { return false; }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TiffSliceReader::readImage(void* dest)
+{
+  if (NULL == m_Data || NULL == dest) { return false; }
+
+  size_t bytesPerSample = m_BitsPerSample / 8;
+  size_t rowBytes = size_t(m_Width) * m_SamplesPerPixel * bytesPerSample;
+  size_t outRowBytes = size_t(m_Width) * getNumberOfComponents() * bytesPerSample;
+  // RGB strips are decoded into a scratch buffer and then expanded to RGBA
+  bool direct = (m_SamplesPerPixel == getNumberOfComponents());
+  std::vector<uint8_t> scratch;
+  uint8_t* out = reinterpret_cast<uint8_t*>(dest);
+
+  for (int32_t s = 0; s < m_StripOffsets.size(); s++)
+  {
+    size_t firstRow = size_t(s) * m_RowsPerStrip;
+    size_t numRows = std::min(size_t(m_RowsPerStrip), size_t(m_Height) - firstRow);
+    size_t stripBytes = numRows * rowBytes;
+    uint8_t* strip = out + firstRow * outRowBytes;
+    if (direct == false)
+    {
+      scratch.resize(stripBytes);
+      strip = &(scratch.front());
+    }
+
+    const uint8_t* src = m_Data + m_StripOffsets[s];
+    size_t srcBytes = static_cast<size_t>(m_StripByteCounts[s]);
+    if (m_Compression == Detail::k_CompressionLZW)
+    {
+      if (Detail::DecodeLZW(src, srcBytes, strip, stripBytes) == false) { return false; }
+    }
+    else
+    {
+      if (srcBytes < stripBytes) { return false; }
+      ::memcpy(strip, src, stripBytes);
+    }
+
+    if (bytesPerSample == 2)
+    {
+      uint16_t* samples = reinterpret_cast<uint16_t*>(strip);
+      size_t numSamples = stripBytes / 2;
+      if (m_SwapBytes == true)
+      {
+        for (size_t i = 0; i < numSamples; i++) { samples[i] = static_cast<uint16_t>((samples[i] << 8) | (samples[i] >> 8)); }
+      }
+      if (m_Predictor == 2)
+      {
+        size_t rowSamples = rowBytes / 2;
+        for (size_t r = 0; r < numRows; r++)
+        {
+          uint16_t* row = samples + r * rowSamples;
+          for (size_t i = m_SamplesPerPixel; i < rowSamples; i++) { row[i] = static_cast<uint16_t>(row[i] + row[i - m_SamplesPerPixel]); }
+        }
+      }
+    }
+    else if (m_Predictor == 2)
+    {
+      for (size_t r = 0; r < numRows; r++)
+      {
+        uint8_t* row = strip + r * rowBytes;
+        for (size_t i = m_SamplesPerPixel; i < rowBytes; i++) { row[i] = static_cast<uint8_t>(row[i] + row[i - m_SamplesPerPixel]); }
+      }
+    }
+
+    if (direct == false)
+    {
+      uint8_t* rgba = out + firstRow * outRowBytes;
+      size_t numPixels = numRows * m_Width;
+      for (size_t i = 0; i < numPixels; i++)
+      {
+        rgba[4 * i] = strip[3 * i];
+        rgba[4 * i + 1] = strip[3 * i + 1];
+        rgba[4 * i + 2] = strip[3 * i + 2];
+        rgba[4 * i + 3] = 255;
+      }
+    }
+  }
+  return true;
+}
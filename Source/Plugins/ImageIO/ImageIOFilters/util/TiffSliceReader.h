@@ -0,0 +1,117 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _TiffSliceReader_H_
+#define _TiffSliceReader_H_
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The TiffSliceReader class is a small reader for the baseline TIFF files that make up most
+ * image stacks: uncompressed or LZW compressed strips holding 8 or 16 bit grayscale or 8 bit RGB(A)
+ * pixels. The file is memory mapped and the strips are decoded straight into a caller supplied
+ * buffer, so a slice can be written directly into its place in a volume without an intermediate image.
+ *
+ * Grayscale images are written with 1 component, RGB and RGBA images with 4 components in R, G, B, A
+ * byte order (the alpha of an RGB image is set to 255), matching the layout produced from a QImage.
+ * 16 bit samples are written in the byte order of the host. Files using any other feature (tiles,
+ * palettes, planar separate samples, other compressions, associated or unassociated alpha, ...) are
+ * rejected by readHeader() so the caller can fall back to a general purpose image reader.
+ *
+ * Instances are not shared between threads, but any number of them may read files concurrently.
+ */
+class TiffSliceReader
+{
+  public:
+    TiffSliceReader();
+    virtual ~TiffSliceReader();
+
+    /**
+     * @brief readHeader Opens the file and parses its first image directory
+     * @param filePath Path to the TIFF file
+     * @return true if the file is a TIFF that this reader can decode
+     */
+    bool readHeader(const QString& filePath);
+
+    /**
+     * @brief readImage Decodes the image found by readHeader() into dest, which must hold
+     * width * height * components * bytesPerComponent bytes. Rows are written top to bottom.
+     * @return false if the image data is truncated or corrupt
+     */
+    bool readImage(void* dest);
+
+    int32_t getWidth() const { return m_Width; }
+    int32_t getHeight() const { return m_Height; }
+
+    /**
+     * @brief getNumberOfComponents Returns the number of components per pixel written by readImage()
+     */
+    int32_t getNumberOfComponents() const { return (m_SamplesPerPixel == 1) ? 1 : 4; }
+
+    /**
+     * @brief getBytesPerComponent Returns the size in bytes of each component written by readImage()
+     */
+    int32_t getBytesPerComponent() const { return m_BitsPerSample / 8; }
+
+  private:
+    QFile m_File;
+    const uint8_t* m_Data;
+    qint64 m_Size;
+    bool m_SwapBytes;
+
+    int32_t m_Width;
+    int32_t m_Height;
+    int32_t m_BitsPerSample;
+    int32_t m_SamplesPerPixel;
+    int32_t m_RowsPerStrip;
+    int32_t m_Compression;
+    int32_t m_Predictor;
+    QVector<quint64> m_StripOffsets;
+    QVector<quint64> m_StripByteCounts;
+
+    void close();
+    uint16_t readUInt16(quint64 offset) const;
+    uint32_t readUInt32(quint64 offset) const;
+    bool readValues(quint64 entryOffset, QVector<quint64>& values) const;
+
+    TiffSliceReader(const TiffSliceReader&); // Copy Constructor Not Implemented
+    void operator=(const TiffSliceReader&); // Operator '=' Not Implemented
+};
+
+#endif /* _TiffSliceReader_H_ */
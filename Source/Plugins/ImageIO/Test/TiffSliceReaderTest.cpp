@@ -0,0 +1,587 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QString>
+#include <QtGui/QImage>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/FilterParameters/FileListInfoFilterParameter.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "ImageIO/ImageIOFilters/util/TiffSliceReader.h"
+
+#include "ImageIOTestFileLocations.h"
+
+#define IMPORT_IMAGE_STACK_FILTER_NAME "ImportImageStack"
+
+QList<QString> fileNames;
+
+namespace
+{
+  const int32_t k_Width = 131;
+  const int32_t k_Height = 97;
+
+  /**
+   * @brief The TiffSpec struct describes the layout of a generated TIFF file
+   */
+  struct TiffSpec
+  {
+    int32_t samplesPerPixel;
+    int32_t bitsPerSample;
+    bool bigEndian;
+    bool lzw;
+    int32_t predictor;
+    int32_t rowsPerStrip;
+    int32_t extraSample;
+  };
+
+  void PutUInt16(std::vector<uint8_t>& out, bool bigEndian, uint32_t value)
+  {
+    if (bigEndian) { out.push_back((value >> 8) & 0xff); out.push_back(value & 0xff); }
+    else { out.push_back(value & 0xff); out.push_back((value >> 8) & 0xff); }
+  }
+
+  void PutUInt32(std::vector<uint8_t>& out, bool bigEndian, uint32_t value)
+  {
+    if (bigEndian) { PutUInt16(out, true, value >> 16); PutUInt16(out, true, value & 0xffff); }
+    else { PutUInt16(out, false, value & 0xffff); PutUInt16(out, false, value >> 16); }
+  }
+
+  void PutCode(std::vector<uint8_t>& out, uint32_t& bitBuffer, int32_t& bitCount, int32_t code, int32_t codeBits)
+  {
+    bitBuffer = (bitBuffer << codeBits) | static_cast<uint32_t>(code);
+    bitCount += codeBits;
+    while (bitCount >= 8)
+    {
+      out.push_back(static_cast<uint8_t>((bitBuffer >> (bitCount - 8)) & 0xff));
+      bitCount -= 8;
+    }
+  }
+
+  /**
+   * @brief EncodeLZW Compresses data the way libtiff does: MSB first codes that widen one code early,
+   * and a clear code whenever the 12 bit table fills up
+   */
+  std::vector<uint8_t> EncodeLZW(const std::vector<uint8_t>& data)
+  {
+    const int32_t clear = 256;
+    const int32_t endOfInformation = 257;
+    const int32_t firstCode = 258;
+    const int32_t tableFull = 4094;
+
+    std::vector<uint8_t> out;
+    uint32_t bitBuffer = 0;
+    int32_t bitCount = 0;
+    int32_t codeBits = 9;
+    int32_t nextCode = firstCode;
+    std::map<uint32_t, int32_t> table;
+
+    PutCode(out, bitBuffer, bitCount, clear, codeBits);
+    int32_t current = data[0];
+    for (size_t i = 1; i < data.size(); i++)
+    {
+      uint32_t key = (static_cast<uint32_t>(current) << 8) | data[i];
+      std::map<uint32_t, int32_t>::iterator iter = table.find(key);
+      if (iter != table.end())
+      {
+        current = iter->second;
+        continue;
+      }
+      PutCode(out, bitBuffer, bitCount, current, codeBits);
+      current = data[i];
+      table[key] = nextCode++;
+      if (nextCode == tableFull)
+      {
+        PutCode(out, bitBuffer, bitCount, clear, codeBits);
+        table.clear();
+        nextCode = firstCode;
+        codeBits = 9;
+      }
+      else if (nextCode > (1 << codeBits) - 1)
+      {
+        codeBits++;
+      }
+    }
+    PutCode(out, bitBuffer, bitCount, current, codeBits);
+    nextCode++;
+    if (nextCode == tableFull)
+    {
+      PutCode(out, bitBuffer, bitCount, clear, codeBits);
+      codeBits = 9;
+    }
+    else if (nextCode > (1 << codeBits) - 1)
+    {
+      codeBits++;
+    }
+    PutCode(out, bitBuffer, bitCount, endOfInformation, codeBits);
+    if (bitCount > 0) { out.push_back(static_cast<uint8_t>((bitBuffer << (8 - bitCount)) & 0xff)); }
+    return out;
+  }
+
+  /**
+   * @brief CreateSamples Fills an image with bands of noise, which fill the LZW table, and bands of
+   * gradients, which compress well. 16 bit samples repeat their high byte in the low byte, so that
+   * truncating or rounding them to 8 bits gives the same value.
+   */
+  std::vector<uint16_t> CreateSamples(const TiffSpec& spec)
+  {
+    std::vector<uint16_t> samples(size_t(k_Width) * k_Height * spec.samplesPerPixel, 0);
+    size_t i = 0;
+    for (int32_t y = 0; y < k_Height; y++)
+    {
+      for (int32_t x = 0; x < k_Width; x++)
+      {
+        for (int32_t c = 0; c < spec.samplesPerPixel; c++)
+        {
+          uint16_t value = ((y / 5) % 2 == 0) ? static_cast<uint16_t>(rand() % 256) : static_cast<uint16_t>((x * 3 + y * 5 + c * 40) % 256);
+          if (spec.bitsPerSample == 16) { value = static_cast<uint16_t>(value * 257); }
+          samples[i++] = value;
+        }
+      }
+    }
+    return samples;
+  }
+
+  /**
+   * @brief EncodeStrip Serializes a run of rows in the byte order of the file, applying the horizontal
+   * predictor and the compression
+   */
+  std::vector<uint8_t> EncodeStrip(const TiffSpec& spec, const std::vector<uint16_t>& samples, int32_t firstRow, int32_t numRows)
+  {
+    size_t rowSamples = size_t(k_Width) * spec.samplesPerPixel;
+    std::vector<uint8_t> bytes;
+    for (int32_t r = firstRow; r < firstRow + numRows; r++)
+    {
+      const uint16_t* row = &(samples.front()) + r * rowSamples;
+      for (size_t i = 0; i < rowSamples; i++)
+      {
+        uint32_t value = row[i];
+        // libtiff only applies the predictor to compressed strips
+        if (spec.lzw == true && spec.predictor == 2 && i >= size_t(spec.samplesPerPixel)) { value = value - row[i - spec.samplesPerPixel]; }
+        if (spec.bitsPerSample == 8) { bytes.push_back(static_cast<uint8_t>(value & 0xff)); }
+        else { PutUInt16(bytes, spec.bigEndian, value & 0xffff); }
+      }
+    }
+    if (spec.lzw == true) { return EncodeLZW(bytes); }
+    return bytes;
+  }
+
+  /**
+   * @brief WriteTiff Writes a single image TIFF file, with the strips first and the image directory last
+   */
+  void WriteTiff(const QString& filePath, const TiffSpec& spec, const std::vector<uint16_t>& samples)
+  {
+    const uint16_t shortType = 3;
+    const uint16_t longType = 4;
+    bool bigEndian = spec.bigEndian;
+
+    std::vector<uint8_t> file;
+    file.push_back(bigEndian ? 'M' : 'I');
+    file.push_back(bigEndian ? 'M' : 'I');
+    PutUInt16(file, bigEndian, 42);
+    PutUInt32(file, bigEndian, 0);
+
+    std::vector<uint32_t> stripOffsets;
+    std::vector<uint32_t> stripByteCounts;
+    for (int32_t firstRow = 0; firstRow < k_Height; firstRow += spec.rowsPerStrip)
+    {
+      std::vector<uint8_t> strip = EncodeStrip(spec, samples, firstRow, std::min(spec.rowsPerStrip, k_Height - firstRow));
+      stripOffsets.push_back(static_cast<uint32_t>(file.size()));
+      stripByteCounts.push_back(static_cast<uint32_t>(strip.size()));
+      file.insert(file.end(), strip.begin(), strip.end());
+    }
+    if (file.size() % 2 != 0) { file.push_back(0); }
+
+    // Image directory entries in increasing tag order: tag, type and values
+    std::vector<uint16_t> tags;
+    std::vector<uint16_t> types;
+    std::vector<std::vector<uint32_t> > values;
+    tags.push_back(256); types.push_back(longType); values.push_back(std::vector<uint32_t>(1, k_Width));
+    tags.push_back(257); types.push_back(longType); values.push_back(std::vector<uint32_t>(1, k_Height));
+    tags.push_back(258); types.push_back(shortType); values.push_back(std::vector<uint32_t>(spec.samplesPerPixel, spec.bitsPerSample));
+    tags.push_back(259); types.push_back(shortType); values.push_back(std::vector<uint32_t>(1, spec.lzw ? 5 : 1));
+    tags.push_back(262); types.push_back(shortType); values.push_back(std::vector<uint32_t>(1, spec.samplesPerPixel == 1 ? 1 : 2));
+    tags.push_back(273); types.push_back(longType); values.push_back(stripOffsets);
+    tags.push_back(277); types.push_back(shortType); values.push_back(std::vector<uint32_t>(1, spec.samplesPerPixel));
+    tags.push_back(278); types.push_back(longType); values.push_back(std::vector<uint32_t>(1, spec.rowsPerStrip));
+    tags.push_back(279); types.push_back(longType); values.push_back(stripByteCounts);
+    tags.push_back(284); types.push_back(shortType); values.push_back(std::vector<uint32_t>(1, 1));
+    if (spec.predictor != 1) { tags.push_back(317); types.push_back(shortType); values.push_back(std::vector<uint32_t>(1, spec.predictor)); }
+    if (spec.samplesPerPixel == 4) { tags.push_back(338); types.push_back(shortType); values.push_back(std::vector<uint32_t>(1, spec.extraSample)); }
+
+    uint32_t ifdOffset = static_cast<uint32_t>(file.size());
+    std::vector<uint8_t> header;
+    PutUInt32(header, bigEndian, ifdOffset);
+    std::copy(header.begin(), header.end(), file.begin() + 4);
+
+    // Values that do not fit in an entry are stored after the directory
+    uint32_t extraOffset = ifdOffset + 2 + static_cast<uint32_t>(tags.size()) * 12 + 4;
+    std::vector<uint8_t> extra;
+    PutUInt16(file, bigEndian, static_cast<uint32_t>(tags.size()));
+    for (size_t e = 0; e < tags.size(); e++)
+    {
+      size_t valueSize = (types[e] == shortType) ? 2 : 4;
+      PutUInt16(file, bigEndian, tags[e]);
+      PutUInt16(file, bigEndian, types[e]);
+      PutUInt32(file, bigEndian, static_cast<uint32_t>(values[e].size()));
+      bool inlineValues = (values[e].size() * valueSize <= 4);
+      if (inlineValues == false) { PutUInt32(file, bigEndian, extraOffset + static_cast<uint32_t>(extra.size())); }
+      std::vector<uint8_t>& out = inlineValues ? file : extra;
+      for (size_t v = 0; v < values[e].size(); v++)
+      {
+        if (valueSize == 2) { PutUInt16(out, bigEndian, values[e][v]); }
+        else { PutUInt32(out, bigEndian, values[e][v]); }
+      }
+      if (inlineValues == true)
+      {
+        for (size_t pad = values[e].size() * valueSize; pad < 4; pad++) { file.push_back(0); }
+      }
+    }
+    PutUInt32(file, bigEndian, 0);
+    file.insert(file.end(), extra.begin(), extra.end());
+
+    QFile out(filePath);
+    DREAM3D_REQUIRE_EQUAL(out.open(QIODevice::WriteOnly), true)
+    out.write(reinterpret_cast<const char*>(&(file.front())), static_cast<qint64>(file.size()));
+    out.close();
+  }
+
+  /**
+   * @brief ReadWithQImage Decodes a file with QImage into the bytes ImportImageStack takes from a QImage:
+   * the gray level of grayscale images and R, G, B, A for color images
+   */
+  bool ReadWithQImage(const QString& filePath, int32_t numComps, std::vector<uint8_t>& bytes)
+  {
+    QImage image(filePath);
+    if (image.isNull() == true || image.width() != k_Width || image.height() != k_Height) { return false; }
+    bytes.resize(size_t(k_Width) * k_Height * numComps);
+    size_t i = 0;
+    for (int32_t y = 0; y < k_Height; y++)
+    {
+      for (int32_t x = 0; x < k_Width; x++)
+      {
+        QRgb pixel = image.pixel(x, y);
+        bytes[i++] = static_cast<uint8_t>(qRed(pixel));
+        if (numComps == 1) { continue; }
+        bytes[i++] = static_cast<uint8_t>(qGreen(pixel));
+        bytes[i++] = static_cast<uint8_t>(qBlue(pixel));
+        bytes[i++] = static_cast<uint8_t>(qAlpha(pixel));
+      }
+    }
+    return true;
+  }
+
+  QString TempFilePath(const QString& prefix, int32_t index)
+  {
+    QString filePath = UnitTest::TestTempDir + QString("/%1%2.tif").arg(prefix).arg(index);
+    fileNames.push_back(filePath);
+    return filePath;
+  }
+
+  /**
+   * @brief CheckTiffSliceReader Writes a file with the given layout and checks that the TiffSliceReader
+   * decodes the samples that were written and the same bytes that ImportImageStack gets from QImage
+   */
+  void CheckTiffSliceReader(const TiffSpec& spec, int32_t index)
+  {
+    QString filePath = TempFilePath("TiffSliceReaderTest_", index);
+    std::vector<uint16_t> samples = CreateSamples(spec);
+    WriteTiff(filePath, spec, samples);
+
+    int32_t numComps = (spec.samplesPerPixel == 1) ? 1 : 4;
+    int32_t compBytes = spec.bitsPerSample / 8;
+    TiffSliceReader reader;
+    DREAM3D_REQUIRE_EQUAL(reader.readHeader(filePath), true)
+    DREAM3D_REQUIRE_EQUAL(reader.getWidth(), k_Width)
+    DREAM3D_REQUIRE_EQUAL(reader.getHeight(), k_Height)
+    DREAM3D_REQUIRE_EQUAL(reader.getNumberOfComponents(), numComps)
+    DREAM3D_REQUIRE_EQUAL(reader.getBytesPerComponent(), compBytes)
+
+    // The extra byte checks that nothing is written past the end of the image
+    size_t numValues = size_t(k_Width) * k_Height * numComps;
+    std::vector<uint8_t> buffer(numValues * compBytes + 1, 0xAB);
+    DREAM3D_REQUIRE_EQUAL(reader.readImage(&(buffer.front())), true)
+    DREAM3D_REQUIRE_EQUAL(buffer.back(), 0xAB)
+
+    std::vector<uint8_t> qimageBytes;
+    DREAM3D_REQUIRE_EQUAL(ReadWithQImage(filePath, numComps, qimageBytes), true)
+
+    if (spec.bitsPerSample == 8)
+    {
+      for (size_t i = 0; i < numValues; i++)
+      {
+        size_t pixel = i / numComps;
+        int32_t c = static_cast<int32_t>(i % numComps);
+        int32_t expected = (c < spec.samplesPerPixel) ? samples[pixel * spec.samplesPerPixel + c] : 255;
+        DREAM3D_REQUIRE_EQUAL(static_cast<int32_t>(buffer[i]), expected)
+        DREAM3D_REQUIRE_EQUAL(static_cast<int32_t>(buffer[i]), static_cast<int32_t>(qimageBytes[i]))
+      }
+    }
+    else
+    {
+      // QImage only keeps the high byte of 16 bit samples
+      const uint16_t* values = reinterpret_cast<const uint16_t*>(&(buffer.front()));
+      for (size_t i = 0; i < numValues; i++)
+      {
+        DREAM3D_REQUIRE_EQUAL(values[i], samples[i])
+        DREAM3D_REQUIRE_EQUAL(static_cast<int32_t>(values[i] >> 8), static_cast<int32_t>(qimageBytes[i]))
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  for (int i = 0; i < fileNames.size(); i++)
+  {
+    QFileInfo fi(fileNames.at(i));
+    if (fi.exists())
+    {
+      QFile::remove(fileNames.at(i));
+    }
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the ImportImageStack Filter from the FilterManager
+  QString filtName = IMPORT_IMAGE_STACK_FILTER_NAME;
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The TiffSliceReaderTest Requires the use of the " << filtName.toStdString() << " filter which is found in the ImageIO Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestTiffSliceReaderMatchesQImage()
+{
+  // Grayscale 8 and 16 bit, RGB and RGBA
+  const int32_t layouts[4][2] = { { 1, 8 }, { 1, 16 }, { 3, 8 }, { 4, 8 } };
+  int32_t index = 0;
+  srand(50);
+  for (int32_t l = 0; l < 4; l++)
+  {
+    for (int32_t bigEndian = 0; bigEndian < 2; bigEndian++)
+    {
+      for (int32_t lzw = 0; lzw < 2; lzw++)
+      {
+        for (int32_t predictor = 1; predictor <= 2; predictor++)
+        {
+          // A single strip, then strips of 7 rows with a shorter last strip
+          for (int32_t strips = 0; strips < 2; strips++)
+          {
+            TiffSpec spec;
+            spec.samplesPerPixel = layouts[l][0];
+            spec.bitsPerSample = layouts[l][1];
+            spec.bigEndian = (bigEndian == 1);
+            spec.lzw = (lzw == 1);
+            spec.predictor = predictor;
+            spec.rowsPerStrip = (strips == 0) ? k_Height : 7;
+            spec.extraSample = 0;
+            CheckTiffSliceReader(spec, index++);
+          }
+        }
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestTiffSliceReaderRejectsAlpha()
+{
+  // QImage premultiplies associated (1) and unassociated (2) alpha, so those files are left to it
+  for (int32_t extraSample = 1; extraSample <= 2; extraSample++)
+  {
+    TiffSpec spec;
+    spec.samplesPerPixel = 4;
+    spec.bitsPerSample = 8;
+    spec.bigEndian = false;
+    spec.lzw = false;
+    spec.predictor = 1;
+    spec.rowsPerStrip = k_Height;
+    spec.extraSample = extraSample;
+    QString filePath = TempFilePath("TiffSliceReaderAlphaTest_", extraSample);
+    WriteTiff(filePath, spec, CreateSamples(spec));
+
+    TiffSliceReader reader;
+    DREAM3D_REQUIRE_EQUAL(reader.readHeader(filePath), false)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer ImportStack(bool keepFullBitDepth)
+{
+  FileListInfo_t fileListInfo;
+  fileListInfo.PaddingDigits = 0;
+  fileListInfo.Ordering = 0;
+  fileListInfo.StartIndex = 0;
+  fileListInfo.EndIndex = 2;
+  fileListInfo.InputPath = UnitTest::TestTempDir;
+  fileListInfo.FilePrefix = "ImportImageStackTest_";
+  fileListInfo.FileSuffix = "";
+  fileListInfo.FileExtension = "tif";
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  AbstractFilter::Pointer filter = FilterManager::Instance()->getFactoryForFilter(IMPORT_IMAGE_STACK_FILTER_NAME)->create();
+  filter->setDataContainerArray(dca);
+  QVariant var;
+  var.setValue(fileListInfo);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputFileListInfo", var), true)
+  var.setValue(keepFullBitDepth);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("KeepFullBitDepth", var), true)
+  filter->execute();
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestImportImageStackBitDepth()
+{
+  TiffSpec spec;
+  spec.samplesPerPixel = 1;
+  spec.bitsPerSample = 16;
+  spec.bigEndian = false;
+  spec.lzw = true;
+  spec.predictor = 2;
+  spec.rowsPerStrip = 16;
+  spec.extraSample = 0;
+  std::vector<uint16_t> samples;
+  for (int32_t z = 0; z < 3; z++)
+  {
+    std::vector<uint16_t> slice = CreateSamples(spec);
+    WriteTiff(TempFilePath("ImportImageStackTest_", z), spec, slice);
+    samples.insert(samples.end(), slice.begin(), slice.end());
+  }
+  DataArrayPath path(DREAM3D::Defaults::ImageDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::ImageData);
+
+  // By default the slices go through QImage and keep their high byte, as uint8_t filters expect
+  {
+    DataContainerArray::Pointer dca = ImportStack(false);
+    UInt8ArrayType::Pointer imageData = boost::dynamic_pointer_cast<UInt8ArrayType>(dca->getAttributeMatrix(path)->getAttributeArray(path.getDataArrayName()));
+    DREAM3D_REQUIRE_VALID_POINTER(imageData.get())
+    DREAM3D_REQUIRE_EQUAL(imageData->getNumberOfTuples(), samples.size())
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(static_cast<int32_t>(imageData->getComponent(i, 0)), (samples[i] >> 8))
+    }
+  }
+
+  // Keeping the full depth decodes them natively into a uint16_t array
+  {
+    DataContainerArray::Pointer dca = ImportStack(true);
+    UInt16ArrayType::Pointer imageData = boost::dynamic_pointer_cast<UInt16ArrayType>(dca->getAttributeMatrix(path)->getAttributeArray(path.getDataArrayName()));
+    DREAM3D_REQUIRE_VALID_POINTER(imageData.get())
+    DREAM3D_REQUIRE_EQUAL(imageData->getNumberOfComponents(), 1)
+    DREAM3D_REQUIRE_EQUAL(imageData->getNumberOfTuples(), samples.size())
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(imageData->getValue(i), samples[i])
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("TiffSliceReaderTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestTiffSliceReaderMatchesQImage() )
+  DREAM3D_REGISTER_TEST( TestTiffSliceReaderRejectsAlpha() )
+  DREAM3D_REGISTER_TEST( TestImportImageStackBitDepth() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -36,6 +36,12 @@
 
 #include "BadDataNeighborOrientationCheck.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -44,12 +50,92 @@
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_BadDataNeighborOrientationCheck.cpp"
 
+/**
+ * @brief The FaceMisorientationMaskImpl class marks, for each bad voxel, which of its six face neighbors
+ * share its phase and lie within the misorientation tolerance (bit j for neighbor direction j), and counts
+ * how many of those neighbors are already good.
+ */
+class FaceMisorientationMaskImpl
+{
+    const int64_t* m_Dims;
+    const int64_t* m_NeighborPoints;
+    const bool* m_GoodVoxels;
+    const int32_t* m_CellPhases;
+    const uint32_t* m_CrystalStructures;
+    QuatF* m_Quats;
+    const QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    float m_Tolerance;
+    uint8_t* m_Masks;
+    uint8_t* m_NeighborCounts;
+
+  public:
+    FaceMisorientationMaskImpl(const int64_t* dims, const int64_t* neighborPoints, const bool* goodVoxels, const int32_t* cellPhases,
+                               const uint32_t* crystalStructures, QuatF* quats, const QVector<SpaceGroupOps::Pointer>& ops, float tolerance,
+                               uint8_t* masks, uint8_t* neighborCounts) :
+      m_Dims(dims),
+      m_NeighborPoints(neighborPoints),
+      m_GoodVoxels(goodVoxels),
+      m_CellPhases(cellPhases),
+      m_CrystalStructures(crystalStructures),
+      m_Quats(quats),
+      m_OrientationOps(ops),
+      m_Tolerance(tolerance),
+      m_Masks(masks),
+      m_NeighborCounts(neighborCounts)
+    {}
+    virtual ~FaceMisorientationMaskImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      QuatF q1 = QuaternionMathF::New();
+      QuatF q2 = QuaternionMathF::New();
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      for (size_t i = start; i < end; i++)
+      {
+        m_Masks[i] = 0;
+        m_NeighborCounts[i] = 0;
+        if (m_GoodVoxels[i] == true || m_CellPhases[i] <= 0) { continue; }
+        int64_t column = int64_t(i) % m_Dims[0];
+        int64_t row = (int64_t(i) / m_Dims[0]) % m_Dims[1];
+        int64_t plane = int64_t(i) / (m_Dims[0] * m_Dims[1]);
+        uint32_t phase1 = m_CrystalStructures[m_CellPhases[i]];
+        QuaternionMathF::Copy(m_Quats[i], q1);
+        for (int32_t j = 0; j < 6; j++)
+        {
+          if (j == 0 && plane == 0) { continue; }
+          if (j == 5 && plane == (m_Dims[2] - 1)) { continue; }
+          if (j == 1 && row == 0) { continue; }
+          if (j == 4 && row == (m_Dims[1] - 1)) { continue; }
+          if (j == 2 && column == 0) { continue; }
+          if (j == 3 && column == (m_Dims[0] - 1)) { continue; }
+          int64_t neighbor = int64_t(i) + m_NeighborPoints[j];
+          if (m_CellPhases[i] != m_CellPhases[neighbor]) { continue; }
+          QuaternionMathF::Copy(m_Quats[neighbor], q2);
+          float w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+          if (w < m_Tolerance)
+          {
+            m_Masks[i] |= static_cast<uint8_t>(1 << j);
+            if (m_GoodVoxels[neighbor] == true) { m_NeighborCounts[i]++; }
+          }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -204,118 +290,63 @@ void BadDataNeighborOrientationCheck::execute()
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
-  DimType dims[3] =
+
+  int64_t dims[3] =
   {
-    static_cast<DimType>(udims[0]),
-    static_cast<DimType>(udims[1]),
-    static_cast<DimType>(udims[2]),
+    static_cast<int64_t>(udims[0]),
+    static_cast<int64_t>(udims[1]),
+    static_cast<int64_t>(udims[2]),
   };
 
-  int32_t good = 1;
-  DimType neighbor = 0;
-  DimType column = 0, row = 0, plane = 0;
-
-  DimType neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
-  neighpoints[0] = static_cast<DimType>(-dims[0] * dims[1]);
-  neighpoints[1] = static_cast<DimType>(-dims[0]);
-  neighpoints[2] = static_cast<DimType>(-1);
-  neighpoints[3] = static_cast<DimType>(1);
-  neighpoints[4] = static_cast<DimType>(dims[0]);
-  neighpoints[5] = static_cast<DimType>(dims[0] * dims[1]);
-
-  float w = 10000.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
+  // Neighbor directions are ordered so that direction 5 - j is the opposite of direction j
+  int64_t neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
+  neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
+  neighpoints[1] = static_cast<int64_t>(-dims[0]);
+  neighpoints[2] = static_cast<int64_t>(-1);
+  neighpoints[3] = static_cast<int64_t>(1);
+  neighpoints[4] = static_cast<int64_t>(dims[0]);
+  neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
+
+  // The orientations never change while voxels are flipped, so each face misorientation is only tested once
+  std::vector<uint8_t> masks(totalPoints, 0);
+  std::vector<uint8_t> neighborCount(totalPoints, 0);
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  QVector<int32_t> neighborCount(totalPoints, 0);
+  FaceMisorientationMaskImpl maskBuilder(dims, neighpoints, m_GoodVoxels, m_CellPhases, m_CrystalStructures, quats, m_OrientationOps,
+                                         m_MisorientationTolerance, &(masks.front()), &(neighborCount.front()));
+  ParallelContext::ParallelFor<size_t>(0, totalPoints, maskBuilder);
 
+  // Only bad voxels with at least one matching neighbor can ever be flipped
+  std::vector<int64_t> candidates;
   for (size_t i = 0; i < totalPoints; i++)
   {
-    if (m_GoodVoxels[i] == false)
-    {
-      column = i % dims[0];
-      row = (i / dims[0]) % dims[1];
-      plane = i / (dims[0] * dims[1]);
-      for (int32_t j = 0; j < 6; j++)
-      {
-        good = 1;
-        neighbor = i + neighpoints[j];
-        if (j == 0 && plane == 0) { good = 0; }
-        if (j == 5 && plane == (dims[2] - 1)) { good = 0; }
-        if (j == 1 && row == 0) { good = 0; }
-        if (j == 4 && row == (dims[1] - 1)) { good = 0; }
-        if (j == 2 && column == 0) { good = 0; }
-        if (j == 3 && column == (dims[0] - 1)) { good = 0; }
-        if (good == 1 && m_GoodVoxels[neighbor] == true)
-        {
-          phase1 = m_CrystalStructures[m_CellPhases[i]];
-          QuaternionMathF::Copy(quats[i], q1);
-
-          phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-          QuaternionMathF::Copy(quats[neighbor], q2);
-
-          if (m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0) { w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3); }
-          if (w < m_MisorientationTolerance)
-          {
-            neighborCount[i]++;
-          }
-        }
-      }
-    }
+    if (masks[i] != 0) { candidates.push_back(static_cast<int64_t>(i)); }
   }
 
+  // Flipping a voxel only ever raises the counts of its bad neighbors, so each level can be closed by
+  // following the voxels that just flipped instead of rescanning the volume
+  std::vector<int64_t> frontier;
   int32_t currentLevel = 6;
-  int32_t counter = 0;
-
   while (currentLevel > m_NumberOfNeighbors)
   {
-    counter = 1;
-    while (counter > 0)
+    for (size_t c = 0; c < candidates.size(); c++)
     {
-      counter = 0;
-      for (size_t i = 0; i < totalPoints; i++)
+      int64_t i = candidates[c];
+      if (m_GoodVoxels[i] == false && neighborCount[i] >= currentLevel) { frontier.push_back(i); }
+    }
+    while (frontier.empty() == false)
+    {
+      int64_t i = frontier.back();
+      frontier.pop_back();
+      if (m_GoodVoxels[i] == true) { continue; }
+      m_GoodVoxels[i] = true;
+      for (int32_t j = 0; j < 6; j++)
       {
-        if (neighborCount[i] >= currentLevel && m_GoodVoxels[i] == false)
-        {
-          m_GoodVoxels[i] = true;
-          counter++;
-          column = i % dims[0];
-          row = (i / dims[0]) % dims[1];
-          plane = i / (dims[0] * dims[1]);
-          for (DimType j = 0; j < 6; j++)
-          {
-            good = 1;
-            neighbor = i + neighpoints[j];
-            if (j == 0 && plane == 0) { good = 0; }
-            if (j == 5 && plane == (dims[2] - 1)) { good = 0; }
-            if (j == 1 && row == 0) { good = 0; }
-            if (j == 4 && row == (dims[1] - 1)) { good = 0; }
-            if (j == 2 && column == 0) { good = 0; }
-            if (j == 3 && column == (dims[0] - 1)) { good = 0; }
-            if (good == 1 && m_GoodVoxels[neighbor] == false)
-            {
-              phase1 = m_CrystalStructures[m_CellPhases[i]];
-              QuaternionMathF::Copy(quats[i], q1);
-
-              phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-              QuaternionMathF::Copy(quats[neighbor], q2);
-
-              if (m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0) { w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3); }
-              if (w < m_MisorientationTolerance)
-              {
-                neighborCount[neighbor]++;
-              }
-            }
-          }
-        }
+        int64_t neighbor = i + neighpoints[j];
+        if (neighbor < 0 || neighbor >= int64_t(totalPoints)) { continue; }
+        // The neighbor's mask bit toward this voxel is never set across a row or plane wrap
+        if (m_GoodVoxels[neighbor] == true || (masks[neighbor] & (1 << (5 - j))) == 0) { continue; }
+        neighborCount[neighbor]++;
+        if (neighborCount[neighbor] == currentLevel) { frontier.push_back(neighbor); }
       }
     }
     currentLevel = currentLevel - 1;
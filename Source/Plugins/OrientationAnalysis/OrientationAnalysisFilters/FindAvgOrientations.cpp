@@ -36,6 +36,9 @@
 
 #include "FindAvgOrientations.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -43,11 +46,157 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/FeatureReduction.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
+/**
+ * @brief The FirstCellReduction class finds the lowest index of a valid cell in each Feature. That
+ * cell's orientation is the reference that all other cells of the Feature are moved next to.
+ */
+class FirstCellReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(FirstCellReduction)
+    SIMPL_TYPE_MACRO_SUPER(FirstCellReduction, FeatureReduction)
+
+    static Pointer New(int32_t* cellPhases, std::vector<size_t>& firstCells)
+    {
+      Pointer sharedPtr(new FirstCellReduction(cellPhases, firstCells));
+      return sharedPtr;
+    }
+
+    virtual ~FirstCellReduction() {}
+
+    virtual int getNumberOfComponents() { return 1; }
+
+    virtual void initialize(double* accumulator, size_t numValues) const
+    {
+      std::fill(accumulator, accumulator + numValues, std::numeric_limits<double>::max());
+    }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        int32_t gnum = range.featureIds[i];
+        if (gnum > 0 && m_CellPhases[i] > 0 && static_cast<double>(i) < accumulator[gnum])
+        {
+          accumulator[gnum] = static_cast<double>(i);
+        }
+      }
+    }
+
+    virtual void merge(const double* source, double* destination, size_t numValues) const
+    {
+      for (size_t i = 0; i < numValues; i++)
+      {
+        if (source[i] < destination[i]) { destination[i] = source[i]; }
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      m_FirstCells.assign(numFeatures, std::numeric_limits<size_t>::max());
+      for (size_t i = 1; i < numFeatures; i++)
+      {
+        if (accumulator[i] != std::numeric_limits<double>::max()) { m_FirstCells[i] = static_cast<size_t>(accumulator[i]); }
+      }
+    }
+
+  protected:
+    FirstCellReduction(int32_t* cellPhases, std::vector<size_t>& firstCells) :
+      FeatureReduction(),
+      m_CellPhases(cellPhases),
+      m_FirstCells(firstCells)
+    {}
+
+  private:
+    int32_t* m_CellPhases;
+    std::vector<size_t>& m_FirstCells;
+};
+
+/**
+ * @brief The AvgQuatReduction class sums, for each Feature, the symmetrically equivalent cell
+ * quaternions that lie nearest to the Feature's reference quaternion.
+ */
+class AvgQuatReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(AvgQuatReduction)
+    SIMPL_TYPE_MACRO_SUPER(AvgQuatReduction, FeatureReduction)
+
+    static Pointer New(int32_t* cellPhases, QuatF* quats, uint32_t* crystalStructures,
+                       const QVector<SpaceGroupOps::Pointer>& ops, const std::vector<QuatF>& refQuats, std::vector<float>& counts, QuatF* avgQuats)
+    {
+      Pointer sharedPtr(new AvgQuatReduction(cellPhases, quats, crystalStructures, ops, refQuats, counts, avgQuats));
+      return sharedPtr;
+    }
+
+    virtual ~AvgQuatReduction() {}
+
+    virtual int getNumberOfComponents() { return 5; }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      QuatF voxquat = QuaternionMathF::New();
+      QuatF refquat = QuaternionMathF::New();
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        int32_t gnum = range.featureIds[i];
+        if (gnum > 0 && m_CellPhases[i] > 0)
+        {
+          QuaternionMathF::Copy(m_Quats[i], voxquat);
+          QuaternionMathF::Copy(m_RefQuats[gnum], refquat);
+          m_OrientationOps[m_CrystalStructures[m_CellPhases[i]]]->getNearestQuat(refquat, voxquat);
+          double* acc = accumulator + 5 * static_cast<size_t>(gnum);
+          acc[0] += 1.0;
+          acc[1] += voxquat.x;
+          acc[2] += voxquat.y;
+          acc[3] += voxquat.z;
+          acc[4] += voxquat.w;
+        }
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      for (size_t i = 1; i < numFeatures; i++)
+      {
+        const double* acc = accumulator + 5 * i;
+        m_Counts[i] = static_cast<float>(acc[0]);
+        m_AvgQuats[i].x = static_cast<float>(acc[1]);
+        m_AvgQuats[i].y = static_cast<float>(acc[2]);
+        m_AvgQuats[i].z = static_cast<float>(acc[3]);
+        m_AvgQuats[i].w = static_cast<float>(acc[4]);
+      }
+    }
+
+  protected:
+    AvgQuatReduction(int32_t* cellPhases, QuatF* quats, uint32_t* crystalStructures,
+                     const QVector<SpaceGroupOps::Pointer>& ops, const std::vector<QuatF>& refQuats, std::vector<float>& counts, QuatF* avgQuats) :
+      FeatureReduction(),
+      m_CellPhases(cellPhases),
+      m_Quats(quats),
+      m_CrystalStructures(crystalStructures),
+      m_OrientationOps(ops),
+      m_RefQuats(refQuats),
+      m_Counts(counts),
+      m_AvgQuats(avgQuats)
+    {}
+
+  private:
+    int32_t* m_CellPhases;
+    QuatF* m_Quats;
+    uint32_t* m_CrystalStructures;
+    const QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    const std::vector<QuatF>& m_RefQuats;
+    std::vector<float>& m_Counts;
+    QuatF* m_AvgQuats;
+};
+
 // Include the MOC generated file for this class
 #include "moc_FindAvgOrientations.cpp"
 
@@ -222,34 +371,38 @@ void FindAvgOrientations::execute()
 
   std::vector<float> counts(totalFeatures, 0.0f);
 
-  int32_t phase = 0;
-  QuatF voxquat = QuaternionMathF::New();
-  QuatF curavgquat = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
+  // The first valid cell of each Feature, moved nearest to the identity, is the reference for the
+  // rest of the Feature. This makes the average independent of how the cells are split among threads.
+  std::vector<size_t> firstCells;
+  {
+    FeatureReductionEngine engine(m_FeatureIds, totalPoints, totalFeatures);
+    engine.addReduction(FirstCellReduction::New(m_CellPhases, firstCells));
+    engine.execute();
+  }
+
+  std::vector<QuatF> refQuats(totalFeatures);
+  for (size_t i = 0; i < totalFeatures; i++)
+  {
+    QuaternionMathF::Identity(refQuats[i]);
+    if (i == 0 || firstCells[i] == std::numeric_limits<size_t>::max()) { continue; }
+    QuatF identity = QuaternionMathF::New();
+    QuaternionMathF::Identity(identity);
+    QuaternionMathF::Copy(quats[firstCells[i]], refQuats[i]);
+    m_OrientationOps[m_CrystalStructures[m_CellPhases[firstCells[i]]]]->getNearestQuat(identity, refQuats[i]);
+  }
+
   for (size_t i = 1; i < totalFeatures; i++)
   {
     QuaternionMathF::ElementWiseAssign(avgQuats[i], 0.0);
   }
 
-  for (size_t i = 0; i < totalPoints; i++)
   {
-    if (m_FeatureIds[i] > 0 && m_CellPhases[i] > 0)
-    {
-      counts[m_FeatureIds[i]] += 1;
-      phase = m_CellPhases[i];
-      QuaternionMathF::Copy(quats[i], voxquat);
-      QuaternionMathF::Copy(avgQuats[m_FeatureIds[i]], curavgquat);
-      QuaternionMathF::ScalarDivide(curavgquat, counts[m_FeatureIds[i]]);
-
-      if (counts[m_FeatureIds[i]] == 1)
-      {
-        QuaternionMathF::Identity(curavgquat);
-      }
-      m_OrientationOps[m_CrystalStructures[phase]]->getNearestQuat(curavgquat, voxquat);
-      QuaternionMathF::Add(avgQuats[m_FeatureIds[i]], voxquat, avgQuats[m_FeatureIds[i]]);
-    }
+    FeatureReductionEngine engine(m_FeatureIds, totalPoints, totalFeatures);
+    engine.addReduction(AvgQuatReduction::New(m_CellPhases, quats, m_CrystalStructures, m_OrientationOps, refQuats, counts, avgQuats));
+    engine.execute();
   }
 
   for (size_t i = 1; i < totalFeatures; i++)
@@ -41,7 +41,6 @@
 #include <tbb/blocked_range.h>
 #include <tbb/atomic.h>
 #include <tbb/tick_count.h>
-#include <tbb/task_scheduler_init.h>
 #include <tbb/task_group.h>
 #endif
 
@@ -54,6 +53,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
@@ -299,8 +299,8 @@ void FindOrientationFieldCurl::execute()
   }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
 //first determine the misorientation vectors on all the voxel faces
@@ -36,11 +36,12 @@
 
 #include "GenerateIPFColors.h"
 
+#include <string.h>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
@@ -51,9 +52,10 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
-#include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Math/MatrixMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
-#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+#include "OrientationLib/SpaceGroupOps/IPFColorGenerator.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
@@ -64,8 +66,9 @@
 class GenerateIPFColorsImpl
 {
   public:
-    GenerateIPFColorsImpl(FloatVec3_t referenceDir, float* eulers, int32_t* phases, uint32_t* crystalStructures,
+    GenerateIPFColorsImpl(IPFColorGenerator* generator, FloatVec3_t referenceDir, float* eulers, int32_t* phases, uint32_t* crystalStructures,
                           bool* goodVoxels, uint8_t* colors) :
+      m_Generator(generator),
       m_ReferenceDir(referenceDir),
       m_CellEulerAngles(eulers),
       m_CellPhases(phases),
@@ -77,35 +80,31 @@ class GenerateIPFColorsImpl
 
     void convert(size_t start, size_t end) const
     {
-      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
-      double refDir[3] = {m_ReferenceDir.x, m_ReferenceDir.y, m_ReferenceDir.z};
-      double dEuler[3] = {0.0, 0.0, 0.0};
-      DREAM3D::Rgb argb = 0x00000000;
-      int32_t phase = 0;
-      bool calcIPF = false;
-      size_t index = 0;
-      for (size_t i = start; i < end; i++)
+      float refDir[3] = {m_ReferenceDir.x, m_ReferenceDir.y, m_ReferenceDir.z};
+      size_t i = start;
+      while (i < end)
       {
-        phase = m_CellPhases[i];
-        index = i * 3;
-        m_CellIPFColors[index] = 0;
-        m_CellIPFColors[index + 1] = 0;
-        m_CellIPFColors[index + 2] = 0;
-        dEuler[0] = m_CellEulerAngles[index];
-        dEuler[1] = m_CellEulerAngles[index + 1];
-        dEuler[2] = m_CellEulerAngles[index + 2];
-
-        // Make sure we are using a valid Euler Angles with valid crystal symmetry
-        calcIPF = true;
+        int32_t phase = m_CellPhases[i];
+        bool calcIPF = true;
         if (NULL != m_GoodVoxels) { calcIPF = m_GoodVoxels[i]; }
 
+        // Color each run of elements that share a phase and a mask value with one batched call
+        size_t runEnd = i + 1;
+        while (runEnd < end && m_CellPhases[runEnd] == phase && (NULL == m_GoodVoxels || m_GoodVoxels[runEnd] == calcIPF))
+        {
+          runEnd++;
+        }
+
+        // Make sure we are using a valid Euler Angles with valid crystal symmetry
         if (calcIPF && m_CrystalStructures[phase] < Ebsd::CrystalStructure::LaueGroupEnd)
         {
-          argb = ops[m_CrystalStructures[phase]]->generateIPFColor(dEuler, refDir, false);
-          m_CellIPFColors[index] = RgbColor::dRed(argb);
-          m_CellIPFColors[index + 1] = RgbColor::dGreen(argb);
-          m_CellIPFColors[index + 2] = RgbColor::dBlue(argb);
+          m_Generator->generateIPFColors(m_CrystalStructures[phase], m_CellEulerAngles + i * 3, refDir, m_CellIPFColors + i * 3, runEnd - i);
+        }
+        else
+        {
+          ::memset(m_CellIPFColors + i * 3, 0, (runEnd - i) * 3 * sizeof(uint8_t));
         }
+        i = runEnd;
       }
     }
 
@@ -116,13 +115,13 @@ class GenerateIPFColorsImpl
     }
 #endif
   private:
+    IPFColorGenerator* m_Generator;
     FloatVec3_t  m_ReferenceDir;
     float* m_CellEulerAngles;
     int32_t* m_CellPhases;
     unsigned int* m_CrystalStructures;
     bool* m_GoodVoxels;
     uint8_t* m_CellIPFColors;
-
 };
 
 // Include the MOC generated file for this class
@@ -300,21 +299,23 @@ void GenerateIPFColors::execute()
   FloatVec3_t normRefDir = m_ReferenceDir; // Make a copy of the reference Direction
   MatrixMath::Normalize3x1(normRefDir.x, normRefDir.y, normRefDir.z);
 
+  IPFColorGenerator::Pointer generator = IPFColorGenerator::New();
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   if (doParallel == true)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, totalPoints),
-                      GenerateIPFColorsImpl(normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellIPFColors), tbb::auto_partitioner());
+                      GenerateIPFColorsImpl(generator.get(), normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellIPFColors), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    GenerateIPFColorsImpl serial(normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellIPFColors);
+    GenerateIPFColorsImpl serial(generator.get(), normRefDir, m_CellEulerAngles, m_CellPhases, m_CrystalStructures, m_GoodVoxels, m_CellIPFColors);
     serial.convert(0, totalPoints);
   }
 
@@ -36,6 +36,12 @@
 
 #include "NeighborOrientationCorrelation.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -44,12 +50,108 @@
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationAnalysis/OrientationAnalysisConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_NeighborOrientationCorrelation.cpp"
 
+/**
+ * @brief The FindBestNeighborImpl class counts, for each low confidence voxel, how many of its other face
+ * neighbors each face neighbor agrees with in orientation, and records the last neighbor with any agreement
+ * as the voxel to copy from. Voxels without any agreeing neighbors keep their previous choice.
+ */
+class FindBestNeighborImpl
+{
+    const int64_t* m_Dims;
+    const int64_t* m_NeighborPoints;
+    const std::vector<int64_t>& m_Voxels;
+    const int32_t* m_CellPhases;
+    const uint32_t* m_CrystalStructures;
+    QuatF* m_Quats;
+    const QVector<SpaceGroupOps::Pointer>& m_OrientationOps;
+    float m_Tolerance;
+    int64_t* m_BestNeighbor;
+
+  public:
+    FindBestNeighborImpl(const int64_t* dims, const int64_t* neighborPoints, const std::vector<int64_t>& voxels, const int32_t* cellPhases,
+                         const uint32_t* crystalStructures, QuatF* quats, const QVector<SpaceGroupOps::Pointer>& ops, float tolerance,
+                         int64_t* bestNeighbor) :
+      m_Dims(dims),
+      m_NeighborPoints(neighborPoints),
+      m_Voxels(voxels),
+      m_CellPhases(cellPhases),
+      m_CrystalStructures(crystalStructures),
+      m_Quats(quats),
+      m_OrientationOps(ops),
+      m_Tolerance(tolerance),
+      m_BestNeighbor(bestNeighbor)
+    {}
+    virtual ~FindBestNeighborImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      QuatF q1 = QuaternionMathF::New();
+      QuatF q2 = QuaternionMathF::New();
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      bool good[6] = { true, true, true, true, true, true };
+      int32_t neighborSimCount[6] = { 0, 0, 0, 0, 0, 0 };
+      for (size_t v = start; v < end; v++)
+      {
+        int64_t i = m_Voxels[v];
+        int64_t column = i % m_Dims[0];
+        int64_t row = (i / m_Dims[0]) % m_Dims[1];
+        int64_t plane = i / (m_Dims[0] * m_Dims[1]);
+        for (int32_t j = 0; j < 6; j++)
+        {
+          neighborSimCount[j] = 0;
+          good[j] = true;
+        }
+        if (plane == 0) { good[0] = false; }
+        if (plane == (m_Dims[2] - 1)) { good[5] = false; }
+        if (row == 0) { good[1] = false; }
+        if (row == (m_Dims[1] - 1)) { good[4] = false; }
+        if (column == 0) { good[2] = false; }
+        if (column == (m_Dims[0] - 1)) { good[3] = false; }
+
+        for (int32_t j = 0; j < 6; j++)
+        {
+          if (good[j] == false) { continue; }
+          int64_t neighbor = i + m_NeighborPoints[j];
+          for (int32_t k = j + 1; k < 6; k++)
+          {
+            if (good[k] == false) { continue; }
+            int64_t neighbor2 = i + m_NeighborPoints[k];
+            if (m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
+            {
+              uint32_t phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
+              QuaternionMathF::Copy(m_Quats[neighbor2], q1);
+              QuaternionMathF::Copy(m_Quats[neighbor], q2);
+              float w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3);
+              if (w < m_Tolerance)
+              {
+                neighborSimCount[j]++;
+                neighborSimCount[k]++;
+              }
+            }
+          }
+        }
+        for (int32_t j = 0; j < 6; j++)
+        {
+          if (good[j] == true && neighborSimCount[j] > 0) { m_BestNeighbor[i] = i + m_NeighborPoints[j]; }
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -218,13 +320,7 @@ void NeighborOrientationCorrelation::execute()
     static_cast<int64_t>(udims[2]),
   };
 
-  size_t count = 1;
-  int32_t best = 0;
-  bool good = true;
-  bool good2 = true;
   int64_t neighbor = 0;
-  int64_t neighbor2 = 0;
-  int64_t column = 0, row = 0, plane = 0;
 
   int64_t neighpoints[6] = { 0, 0, 0, 0, 0, 0 };
   neighpoints[0] = static_cast<int64_t>(-dims[0] * dims[1]);
@@ -234,125 +330,42 @@ void NeighborOrientationCorrelation::execute()
   neighpoints[4] = static_cast<int64_t>(dims[0]);
   neighpoints[5] = static_cast<int64_t>(dims[0] * dims[1]);
 
-  float w = std::numeric_limits<float>::max();
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  uint32_t phase1 = 0, phase2 = 0;
-
-  QVector<int32_t> neighborDiffCount(totalPoints, 0);
-  QVector<int32_t> neighborSimCount(6, 0);
   QVector<int64_t> bestNeighbor(totalPoints, -1);
   QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
+  std::vector<int64_t> lowConfidenceVoxels;
 
   int32_t startLevel = 6;
   for (int32_t currentLevel = startLevel; currentLevel > m_Level; currentLevel--)
   {
     if (getCancel()) { break; }
 
-    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
-    int64_t prog = 1;
-    int64_t progressInt = 0;
+    QString levelMessage = QObject::tr("Level %1 of %2 || Processing Data").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level);
+    notifyStatusMessage(getMessagePrefix(), getHumanLabel(), levelMessage);
+
+    // Only the voxels that are still below the confidence threshold look for a neighbor to copy from
+    lowConfidenceVoxels.clear();
     for (size_t i = 0; i < totalPoints; i++)
     {
-      if (int64_t(i) > prog)
-      {
-        progressInt = static_cast<int64_t>(((float)i / totalPoints) * 100.0f);
-        QString ss = QObject::tr("Level %1 of %2 || Processing Data %3%").arg((startLevel - currentLevel) + 1).arg(startLevel - m_Level).arg(progressInt);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-        prog = prog + progIncrement;
-      }
-
-      if (m_ConfidenceIndex[i] < m_MinConfidence)
-      {
-        count = 0;
-        column = i % dims[0];
-        row = (i / dims[0]) % dims[1];
-        plane = i / (dims[0] * dims[1]);
-        for (int32_t j = 0; j < 6; j++)
-        {
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if (j == 0 && plane == 0) { good = false; }
-          if (j == 5 && plane == (dims[2] - 1)) { good = false; }
-          if (j == 1 && row == 0) { good = false; }
-          if (j == 4 && row == (dims[1] - 1)) { good = false; }
-          if (j == 2 && column == 0) { good = false; }
-          if (j == 3 && column == (dims[0] - 1)) { good = false; }
-          if (good == true)
-          {
-            phase1 = m_CrystalStructures[m_CellPhases[i]];
-            QuaternionMathF::Copy(quats[i], q1);
+      if (m_ConfidenceIndex[i] < m_MinConfidence) { lowConfidenceVoxels.push_back(static_cast<int64_t>(i)); }
+    }
 
-            phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-            QuaternionMathF::Copy(quats[neighbor], q2);
+    FindBestNeighborImpl finder(dims, neighpoints, lowConfidenceVoxels, m_CellPhases, m_CrystalStructures, quats, m_OrientationOps,
+                                m_MisorientationTolerance, bestNeighbor.data());
+    ParallelContext::ParallelFor<size_t>(0, lowConfidenceVoxels.size(), finder);
 
-            if (m_CellPhases[i] == m_CellPhases[neighbor] && m_CellPhases[i] > 0) { w = m_OrientationOps[phase1]->getMisoQuat(q1, q2, n1, n2, n3); }
-            if (w > m_MisorientationTolerance)
-            {
-              neighborDiffCount[i]++;
-            }
-            for (int32_t k = j + 1; k < 6; k++)
-            {
-              good2 = true;
-              neighbor2 = int64_t(i) + neighpoints[k];
-              if (k == 0 && plane == 0) { good2 = false; }
-              if (k == 5 && plane == (dims[2] - 1)) { good2 = false; }
-              if (k == 1 && row == 0) { good2 = false; }
-              if (k == 4 && row == (dims[1] - 1)) { good2 = false; }
-              if (k == 2 && column == 0) { good2 = false; }
-              if (k == 3 && column == (dims[0] - 1)) { good2 = false; }
-              if (good2 == true)
-              {
-                phase1 = m_CrystalStructures[m_CellPhases[neighbor2]];
-                QuaternionMathF::Copy(quats[neighbor2], q1);
-
-                phase2 = m_CrystalStructures[m_CellPhases[neighbor]];
-                QuaternionMathF::Copy(quats[neighbor], q2);
-                if (m_CellPhases[neighbor2] == m_CellPhases[neighbor] && m_CellPhases[neighbor2] > 0)
-                {
-                  w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3);
-                }
-                if (w < m_MisorientationTolerance)
-                {
-                  neighborSimCount[j]++;
-                  neighborSimCount[k]++;
-                }
-              }
-            }
-          }
-        }
-        for (int32_t j = 0; j < 6; j++)
-        {
-          best = 0;
-          good = true;
-          neighbor = int64_t(i) + neighpoints[j];
-          if (j == 0 && plane == 0) { good = false; }
-          if (j == 5 && plane == (dims[2] - 1)) { good = false; }
-          if (j == 1 && row == 0) { good = false; }
-          if (j == 4 && row == (dims[1] - 1)) { good = false; }
-          if (j == 2 && column == 0) { good = false; }
-          if (j == 3 && column == (dims[0] - 1)) { good = false; }
-          if (good == true)
-          {
-            if (neighborSimCount[j] > best)
-            {
-              best = neighborSimCount[j];
-              bestNeighbor[i] = neighbor;
-            }
-            neighborSimCount[j] = 0;
-          }
-        }
-      }
-    }
     QString attrMatName = m_ConfidenceIndexArrayPath.getAttributeMatrixName();
     QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
+    QVector<IDataArray::Pointer> voxelArrays;
+    for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+    {
+      voxelArrays.push_back(m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter));
+    }
 
     if (getCancel()) { return; }
 
-    progIncrement = static_cast<int64_t>(totalPoints / 100);
-    prog = 1;
-    progressInt = 0;
+    int64_t progIncrement = static_cast<int64_t>(totalPoints / 100);
+    int64_t prog = 1;
+    int64_t progressInt = 0;
     for (size_t i = 0; i < totalPoints; i++)
     {
       if (int64_t(i) > prog)
@@ -365,10 +378,9 @@ void NeighborOrientationCorrelation::execute()
       neighbor = bestNeighbor[i];
       if (neighbor != -1)
       {
-        for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+        for (QVector<IDataArray::Pointer>::iterator iter = voxelArrays.begin(); iter != voxelArrays.end(); ++iter)
         {
-          IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-          p->copyTuple(neighbor, i);
+          (*iter)->copyTuple(neighbor, i);
         }
       }
     }
@@ -36,6 +36,9 @@
 
 #include "WritePoleFigure.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -370,43 +373,45 @@ void WritePoleFigure::execute()
   size_t numPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
   size_t numPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
 
-  // Loop over all the voxels gathering the Eulers for a specific phase into an array
-  for (size_t phase = 1; phase < numPhases; ++phase)
+  // Count the good voxels of each phase and where each phase first and last appears with a
+  // single pass, so each phase can then be gathered on its own from just that range of voxels
+  std::vector<size_t> phaseCounts(numPhases, 0);
+  std::vector<size_t> phaseFirst(numPhases, numPoints);
+  std::vector<size_t> phaseLast(numPhases, 0);
+  size_t maxCount = 0;
+  for (size_t i = 0; i < numPoints; ++i)
   {
-    size_t count = 0;
-    // First find out how many voxels we are going to have. This is probably faster to loop twice than to
-    // keep allocating memory everytime we find one.
-    for (size_t i = 0; i < numPoints; ++i)
+    size_t phase = static_cast<size_t>(m_CellPhases[i]);
+    if (phase > 0 && phase < numPhases && (missingGoodVoxels == true || m_GoodVoxels[i] == true))
     {
-      if (m_CellPhases[i] == phase)
-      {
-        if (missingGoodVoxels == true || m_GoodVoxels[i] == true)
-        {
-          count++;
-        }
-      }
+      if (phaseCounts[phase]++ == 0) { phaseFirst[phase] = i; }
+      phaseLast[phase] = i;
+      maxCount = std::max(maxCount, phaseCounts[phase]);
     }
-    QVector<size_t> eulerCompDim(1, 3);
-    FloatArrayType::Pointer subEulers = FloatArrayType::CreateArray(count, eulerCompDim, "Eulers_Per_Phase");
-    subEulers->initializeWithValue(std::numeric_limits<float>::signaling_NaN());
-    float* eu = subEulers->getPointer(0);
-
-    // Now loop through the eulers again and this time add them to the subEulers Array
-    count = 0;
-    for (size_t i = 0; i < numPoints; ++i)
+  }
+
+  // One buffer sized for the largest phase is reused for every phase
+  QVector<size_t> eulerCompDim(1, 3);
+  FloatArrayType::Pointer phaseEulers = FloatArrayType::CreateArray(maxCount, eulerCompDim, "Eulers_Per_Phase");
+
+  for (size_t phase = 1; phase < numPhases; ++phase)
+  {
+    size_t count = phaseCounts[phase];
+    if (count == 0) { continue; } // Skip because we have no Pole Figure data
+
+    float* eu = phaseEulers->getPointer(0);
+    size_t k = 0;
+    for (size_t i = phaseFirst[phase]; i <= phaseLast[phase]; ++i)
     {
-      if (m_CellPhases[i] == phase)
+      if (static_cast<size_t>(m_CellPhases[i]) == phase && (missingGoodVoxels == true || m_GoodVoxels[i] == true))
       {
-        if (missingGoodVoxels == true || m_GoodVoxels[i] == true)
-        {
-          eu[count * 3] = m_CellEulerAngles[i * 3];
-          eu[count * 3 + 1] = m_CellEulerAngles[i * 3 + 1];
-          eu[count * 3 + 2] = m_CellEulerAngles[i * 3 + 2];
-          count++;
-        }
+        eu[k * 3] = m_CellEulerAngles[i * 3];
+        eu[k * 3 + 1] = m_CellEulerAngles[i * 3 + 1];
+        eu[k * 3 + 2] = m_CellEulerAngles[i * 3 + 2];
+        k++;
       }
     }
-    if (subEulers->getNumberOfTuples() == 0) { continue; } // Skip because we have no Pole Figure data
+    FloatArrayType::Pointer subEulers = FloatArrayType::WrapPointer(eu, count, eulerCompDim, "Eulers_Per_Phase", false);
 
     QVector<UInt8ArrayType::Pointer> figures;
 
@@ -0,0 +1,465 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+#define BAD_DATA_NEIGHBOR_ORIENTATION_CHECK_FILTER_NAME "BadDataNeighborOrientationCheck"
+
+static const QString DCName("BadDataNeighborOrientationCheckTest");
+
+namespace
+{
+  const int64_t k_Dims[3] = { 12, 10, 8 };
+  const float k_Tolerance = 5.0f;
+
+  // Offsets in degrees from the orientation of a Feature, so neighbors in a Feature are at most 2 degrees apart
+  const float k_Offsets[6] = { -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 0.0f };
+
+  // Bad voxels at these cells are set up by hand; see createTestVolume()
+  const int64_t k_Interior[3] = { 2, 5, 4 };
+  const int64_t k_Noise[3] = { 1, 2, 2 };
+  const int64_t k_PhaseBoundary[3] = { 7, 5, 4 };
+  const int64_t k_ClusterStart[3] = { 5, 2, 2 };
+
+  size_t cellIndex(int64_t column, int64_t row, int64_t plane)
+  {
+    return static_cast<size_t>((plane * k_Dims[1] + row) * k_Dims[0] + column);
+  }
+
+  void setRotationAboutZ(std::vector<float>& quats, size_t cell, float degrees)
+  {
+    float halfAngle = 0.5f * degrees * SIMPLib::Constants::k_PiOver180;
+    quats[4 * cell] = 0.0f;
+    quats[4 * cell + 1] = 0.0f;
+    quats[4 * cell + 2] = sinf(halfAngle);
+    quats[4 * cell + 3] = cosf(halfAngle);
+  }
+}
+
+/**
+ * @brief The TestVolume struct holds the cell data of the test volume. Columns 0-3 are a phase 1 Feature at
+ * 0 degrees about Z, columns 4-7 a phase 1 Feature at 20 degrees and columns 8-11 a phase 2 Feature also at
+ * 20 degrees, so only the phase check keeps the last two apart.
+ */
+struct TestVolume
+{
+  std::vector<bool> goodVoxels;
+  std::vector<int32_t> phases;
+  std::vector<float> quats;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the BadDataNeighborOrientationCheck Filter from the FilterManager
+  QString filtName = BAD_DATA_NEIGHBOR_ORIENTATION_CHECK_FILTER_NAME;
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get())
+  {
+    std::stringstream ss;
+    ss << "The BadDataNeighborOrientationCheckTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// A quarter of the cells are bad. Half of those keep the orientation of their Feature and
+// can be recovered; the other half are noise 60 degrees away. On top of that:
+//  - k_Interior is a recoverable bad cell whose six neighbors are all good
+//  - k_Noise is a noise cell whose six neighbors are all good
+//  - k_PhaseBoundary is a recoverable bad cell on the phase boundary with all six
+//    neighbors good; only five of them share its phase
+//  - the 2x2x2 block at k_ClusterStart is recoverable but bad, so each of its cells
+//    starts with three good neighbors
+// -----------------------------------------------------------------------------
+TestVolume createTestVolume()
+{
+  uint64_t seed = 20160105;
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+
+  size_t numCells = static_cast<size_t>(k_Dims[0] * k_Dims[1] * k_Dims[2]);
+  TestVolume volume;
+  volume.goodVoxels.resize(numCells, true);
+  volume.phases.resize(numCells, 1);
+  volume.quats.resize(4 * numCells, 0.0f);
+  std::vector<float> featureAngles(numCells, 0.0f);
+
+  for (int64_t plane = 0; plane < k_Dims[2]; plane++)
+  {
+    for (int64_t row = 0; row < k_Dims[1]; row++)
+    {
+      for (int64_t column = 0; column < k_Dims[0]; column++)
+      {
+        size_t i = cellIndex(column, row, plane);
+        volume.phases[i] = (column < 8) ? 1 : 2;
+        featureAngles[i] = (column < 4) ? 0.0f : 20.0f;
+        setRotationAboutZ(volume.quats, i, featureAngles[i] + k_Offsets[i % 6]);
+        double r = rg.genrand_res53();
+        if (r < 0.125) { volume.goodVoxels[i] = false; }
+        else if (r < 0.25)
+        {
+          volume.goodVoxels[i] = false;
+          setRotationAboutZ(volume.quats, i, featureAngles[i] + 60.0f);
+        }
+      }
+    }
+  }
+
+  const int64_t* centers[3] = { k_Interior, k_Noise, k_PhaseBoundary };
+  for (size_t c = 0; c < 3; c++)
+  {
+    for (int64_t d = -1; d <= 1; d += 2)
+    {
+      size_t neighbors[3] = { cellIndex(centers[c][0] + d, centers[c][1], centers[c][2]),
+                              cellIndex(centers[c][0], centers[c][1] + d, centers[c][2]),
+                              cellIndex(centers[c][0], centers[c][1], centers[c][2] + d) };
+      for (size_t n = 0; n < 3; n++)
+      {
+        volume.goodVoxels[neighbors[n]] = true;
+        setRotationAboutZ(volume.quats, neighbors[n], featureAngles[neighbors[n]]);
+      }
+    }
+    size_t i = cellIndex(centers[c][0], centers[c][1], centers[c][2]);
+    volume.goodVoxels[i] = false;
+    setRotationAboutZ(volume.quats, i, (c == 1) ? featureAngles[i] + 60.0f : featureAngles[i]);
+  }
+
+  for (int64_t plane = k_ClusterStart[2] - 1; plane < k_ClusterStart[2] + 3; plane++)
+  {
+    for (int64_t row = k_ClusterStart[1] - 1; row < k_ClusterStart[1] + 3; row++)
+    {
+      for (int64_t column = k_ClusterStart[0] - 1; column < k_ClusterStart[0] + 3; column++)
+      {
+        size_t i = cellIndex(column, row, plane);
+        bool inside = (plane != k_ClusterStart[2] - 1 && plane != k_ClusterStart[2] + 2
+                       && row != k_ClusterStart[1] - 1 && row != k_ClusterStart[1] + 2
+                       && column != k_ClusterStart[0] - 1 && column != k_ClusterStart[0] + 2);
+        volume.goodVoxels[i] = !inside;
+        setRotationAboutZ(volume.quats, i, featureAngles[i]);
+      }
+    }
+  }
+  return volume;
+}
+
+// -----------------------------------------------------------------------------
+// The serial algorithm the filter used before its face misorientations were cached,
+// with two neighbors of different phases never matching
+// -----------------------------------------------------------------------------
+std::vector<bool> referenceCheck(const TestVolume& volume, int32_t numberOfNeighbors)
+{
+  QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+  std::vector<bool> goodVoxels = volume.goodVoxels;
+  std::vector<float> quatValues = volume.quats;
+  QuatF* quats = reinterpret_cast<QuatF*>(&(quatValues.front()));
+  float tolerance = k_Tolerance * SIMPLib::Constants::k_Pi / 180.0;
+  size_t totalPoints = goodVoxels.size();
+  int64_t neighpoints[6] = { -k_Dims[0] * k_Dims[1], -k_Dims[0], -1, 1, k_Dims[0], k_Dims[0] * k_Dims[1] };
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+
+  std::vector<int32_t> neighborCount(totalPoints, 0);
+  // Marks the cells whose face neighbor j shares their phase and orientation
+  std::vector<std::vector<bool> > matches(totalPoints, std::vector<bool>(6, false));
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    int64_t column = int64_t(i) % k_Dims[0];
+    int64_t row = (int64_t(i) / k_Dims[0]) % k_Dims[1];
+    int64_t plane = int64_t(i) / (k_Dims[0] * k_Dims[1]);
+    for (int32_t j = 0; j < 6; j++)
+    {
+      if (j == 0 && plane == 0) { continue; }
+      if (j == 5 && plane == (k_Dims[2] - 1)) { continue; }
+      if (j == 1 && row == 0) { continue; }
+      if (j == 4 && row == (k_Dims[1] - 1)) { continue; }
+      if (j == 2 && column == 0) { continue; }
+      if (j == 3 && column == (k_Dims[0] - 1)) { continue; }
+      int64_t neighbor = int64_t(i) + neighpoints[j];
+      if (volume.phases[i] != volume.phases[neighbor] || volume.phases[i] <= 0) { continue; }
+      QuatF q1 = quats[i];
+      QuatF q2 = quats[neighbor];
+      float w = ops[Ebsd::CrystalStructure::Cubic_High]->getMisoQuat(q1, q2, n1, n2, n3);
+      matches[i][j] = (w < tolerance);
+      if (matches[i][j] == true && goodVoxels[i] == false && goodVoxels[neighbor] == true) { neighborCount[i]++; }
+    }
+  }
+
+  int32_t currentLevel = 6;
+  while (currentLevel > numberOfNeighbors)
+  {
+    int32_t counter = 1;
+    while (counter > 0)
+    {
+      counter = 0;
+      for (size_t i = 0; i < totalPoints; i++)
+      {
+        if (neighborCount[i] >= currentLevel && goodVoxels[i] == false)
+        {
+          goodVoxels[i] = true;
+          counter++;
+          for (int32_t j = 0; j < 6; j++)
+          {
+            int64_t neighbor = int64_t(i) + neighpoints[j];
+            if (matches[i][j] == true && goodVoxels[neighbor] == false) { neighborCount[neighbor]++; }
+          }
+        }
+      }
+    }
+    currentLevel = currentLevel - 1;
+  }
+  return goodVoxels;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer initializeDataContainerArray(const TestVolume& volume)
+{
+  size_t dims[3] = { static_cast<size_t>(k_Dims[0]), static_cast<size_t>(k_Dims[1]), static_cast<size_t>(k_Dims[2]) };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  BoolArrayType::Pointer goodVoxels = BoolArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::GoodVoxels);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Phases);
+  cDims[0] = 4;
+  FloatArrayType::Pointer quats = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Quats);
+  for (size_t i = 0; i < volume.phases.size(); i++)
+  {
+    goodVoxels->setValue(i, volume.goodVoxels[i]);
+    phases->setValue(i, volume.phases[i]);
+  }
+  std::copy(volume.quats.begin(), volume.quats.end(), quats->getPointer(0));
+  cellAttrMat->addAttributeArray(goodVoxels->getName(), goodVoxels);
+  cellAttrMat->addAttributeArray(phases->getName(), phases);
+  cellAttrMat->addAttributeArray(quats->getName(), quats);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+  QVector<size_t> eDims(1, 3);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  cDims[0] = 1;
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+  crystalStructures->setValue(2, Ebsd::CrystalStructure::Cubic_High);
+  ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+  m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<bool> runFilter(const TestVolume& volume, int32_t numberOfNeighbors, int numThreads)
+{
+  DataContainerArray::Pointer dca = initializeDataContainerArray(volume);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter(BAD_DATA_NEIGHBOR_ORIENTATION_CHECK_FILTER_NAME);
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(k_Tolerance);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("MisorientationTolerance", var), true)
+  var.setValue(numberOfNeighbors);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumberOfNeighbors", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::GoodVoxels));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("GoodVoxelsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellPhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Quats));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("QuatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::CrystalStructures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CrystalStructuresArrayPath", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  BoolArrayType::Pointer goodVoxels = boost::dynamic_pointer_cast<BoolArrayType>(dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellAttributeMatrixName)->getAttributeArray(DREAM3D::CellData::GoodVoxels));
+  DREAM3D_REQUIRE(goodVoxels.get() != NULL)
+  std::vector<bool> result(goodVoxels->getNumberOfTuples(), false);
+  for (size_t i = 0; i < result.size(); i++)
+  {
+    result[i] = goodVoxels->getValue(i);
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool clusterIsGood(const std::vector<bool>& goodVoxels)
+{
+  bool good = true;
+  for (int64_t d = 0; d < 8; d++)
+  {
+    good = good && goodVoxels[cellIndex(k_ClusterStart[0] + d % 2, k_ClusterStart[1] + (d / 2) % 2, k_ClusterStart[2] + d / 4)];
+  }
+  return good;
+}
+
+// -----------------------------------------------------------------------------
+// At five neighbors only cells with all six matching neighbors flip. The cell on the phase
+// boundary has just five neighbors of its own phase, and the cluster cells only three.
+// -----------------------------------------------------------------------------
+void TestKnownFlips()
+{
+  TestVolume volume = createTestVolume();
+
+  std::vector<bool> goodVoxels = runFilter(volume, 5, 1);
+  DREAM3D_REQUIRE_EQUAL(goodVoxels[cellIndex(k_Interior[0], k_Interior[1], k_Interior[2])], true)
+  DREAM3D_REQUIRE_EQUAL(goodVoxels[cellIndex(k_Noise[0], k_Noise[1], k_Noise[2])], false)
+  DREAM3D_REQUIRE_EQUAL(goodVoxels[cellIndex(k_PhaseBoundary[0], k_PhaseBoundary[1], k_PhaseBoundary[2])], false)
+  DREAM3D_REQUIRE_EQUAL(clusterIsGood(goodVoxels), false)
+
+  // At four neighbors the phase boundary cell flips; at two the cluster flips as well
+  goodVoxels = runFilter(volume, 4, 1);
+  DREAM3D_REQUIRE_EQUAL(goodVoxels[cellIndex(k_PhaseBoundary[0], k_PhaseBoundary[1], k_PhaseBoundary[2])], true)
+  DREAM3D_REQUIRE_EQUAL(clusterIsGood(goodVoxels), false)
+
+  goodVoxels = runFilter(volume, 2, 1);
+  DREAM3D_REQUIRE_EQUAL(goodVoxels[cellIndex(k_Noise[0], k_Noise[1], k_Noise[2])], false)
+  DREAM3D_REQUIRE_EQUAL(clusterIsGood(goodVoxels), true)
+}
+
+// -----------------------------------------------------------------------------
+// The filter must flip exactly the cells the serial rescanning algorithm flips, for every
+// number of neighbors and however the mask is split among threads
+// -----------------------------------------------------------------------------
+void TestAgainstSerialReference()
+{
+  TestVolume volume = createTestVolume();
+  for (int32_t numberOfNeighbors = 0; numberOfNeighbors < 6; numberOfNeighbors++)
+  {
+    std::vector<bool> expected = referenceCheck(volume, numberOfNeighbors);
+    std::vector<bool> serial = runFilter(volume, numberOfNeighbors, 1);
+    std::vector<bool> parallel = runFilter(volume, numberOfNeighbors, 4);
+    DREAM3D_REQUIRE(serial == expected)
+    DREAM3D_REQUIRE(parallel == expected)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("BadDataNeighborOrientationCheckTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestKnownFlips() )
+  DREAM3D_REGISTER_TEST( TestAgainstSerialReference() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
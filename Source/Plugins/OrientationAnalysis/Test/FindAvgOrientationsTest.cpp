@@ -0,0 +1,267 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+#define FIND_AVG_ORIENTATIONS_FILTER_NAME "FindAvgOrientations"
+
+static const QString DCName("FindAvgOrientationsTest");
+
+namespace
+{
+  // Offsets in degrees from the mean orientation of a Feature. They cancel over every 6 cells.
+  const float k_Offsets[6] = { -1.0f, 1.0f, -2.0f, 2.0f, -3.0f, 3.0f };
+
+  void setRotationAboutZ(FloatArrayType::Pointer quats, size_t cell, float degrees)
+  {
+    float halfAngle = 0.5f * degrees * SIMPLib::Constants::k_PiOver180;
+    quats->setComponent(cell, 0, 0.0f);
+    quats->setComponent(cell, 1, 0.0f);
+    quats->setComponent(cell, 2, sinf(halfAngle));
+    quats->setComponent(cell, 3, cosf(halfAngle));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the FindAvgOrientations Filter from the FilterManager
+  QString filtName = FIND_AVG_ORIENTATIONS_FILTER_NAME;
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get())
+  {
+    std::stringstream ss;
+    ss << "The FindAvgOrientationsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Every 10th cell belongs to Feature 0. Feature 1 holds cubic orientations that are
+// rotated 45 +/- 3 degrees about Z, which straddles the boundary of the cubic fundamental
+// zone; every other pair of its cells is stored as the equivalent rotation of -45 +/- 3
+// degrees. Feature 2 holds rotations of 0 +/- 3 degrees about Z.
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer initializeDataContainerArray()
+{
+  size_t dims[3] = { 10, 10, 10 };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::FeatureIds);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Phases);
+  cDims[0] = 4;
+  FloatArrayType::Pointer quats = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Quats);
+
+  size_t numCells = dims[0] * dims[1] * dims[2];
+  size_t featureCells[3] = { 0, 0, 0 };
+  for (size_t i = 0; i < numCells; i++)
+  {
+    int32_t feature = (i % 10 == 0) ? 0 : ((i < numCells / 2) ? 1 : 2);
+    featureIds->setValue(i, feature);
+    phases->setValue(i, 1);
+    size_t k = featureCells[feature]++;
+    float offset = k_Offsets[k % 6];
+    if (feature == 0) { setRotationAboutZ(quats, i, 20.0f + offset); }
+    else if (feature == 2) { setRotationAboutZ(quats, i, offset); }
+    else if ((k / 2) % 2 == 0) { setRotationAboutZ(quats, i, 45.0f + offset); }
+    else { setRotationAboutZ(quats, i, -45.0f + offset); }
+  }
+  cellAttrMat->addAttributeArray(featureIds->getName(), featureIds);
+  cellAttrMat->addAttributeArray(phases->getName(), phases);
+  cellAttrMat->addAttributeArray(quats->getName(), quats);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+  QVector<size_t> fDims(1, 3);
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(fDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+  QVector<size_t> eDims(1, 2);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  cDims[0] = 1;
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+  ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+  m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+// The average of a Feature must not depend on which of the equivalent orientations a
+// cell was stored as, or on how the cells were split among threads
+// -----------------------------------------------------------------------------
+void TestFindAvgOrientations(int numThreads)
+{
+  DataContainerArray::Pointer dca = initializeDataContainerArray();
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter(FIND_AVG_ORIENTATIONS_FILTER_NAME);
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellPhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Quats));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("QuatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::CrystalStructures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CrystalStructuresArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::AvgQuats));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("AvgQuatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::AvgEulerAngles));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("AvgEulerAnglesArrayPath", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellFeatureAttributeMatrixName);
+  FloatArrayType::Pointer avgQuats = boost::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::AvgQuats));
+  FloatArrayType::Pointer avgEulers = boost::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::AvgEulerAngles));
+  DREAM3D_REQUIRE(avgQuats.get() != NULL)
+  DREAM3D_REQUIRE(avgEulers.get() != NULL)
+
+  // Feature 1 averages to a rotation of exactly 45 degrees about Z, Feature 2 to the identity.
+  // q and -q are the same rotation.
+  float halfAngle = 0.5f * 45.0f * SIMPLib::Constants::k_PiOver180;
+  float expected[3][4] = { { 0.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, sinf(halfAngle), cosf(halfAngle) }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+  for (size_t f = 1; f < 3; f++)
+  {
+    float sign = (avgQuats->getComponent(f, 3) < 0.0f) ? -1.0f : 1.0f;
+    for (int c = 0; c < 4; c++)
+    {
+      float delta = fabsf(sign * avgQuats->getComponent(f, c) - expected[f][c]);
+      DREAM3D_REQUIRED(delta, <, 1.0e-5f)
+    }
+  }
+
+  // A rotation about Z only has Phi = 0 and phi1 + phi2 carries the angle. The quaternions are
+  // passive, so the Euler angles of Feature 1 sum to -45 degrees.
+  DREAM3D_REQUIRED(fabsf(avgEulers->getComponent(1, 1)), <, 1.0e-4f)
+  float angle = fmodf(avgEulers->getComponent(1, 0) + avgEulers->getComponent(1, 2), SIMPLib::Constants::k_2Pi);
+  float expectedAngle = SIMPLib::Constants::k_2Pi - 45.0f * SIMPLib::Constants::k_PiOver180;
+  DREAM3D_REQUIRED(fabsf(angle - expectedAngle), <, 1.0e-4f)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("FindAvgOrientationsTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestFindAvgOrientations(1) )
+  DREAM3D_REGISTER_TEST( TestFindAvgOrientations(4) )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+  return err;
+}
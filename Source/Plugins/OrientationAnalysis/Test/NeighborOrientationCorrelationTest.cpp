@@ -0,0 +1,452 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
+
+#include "OrientationAnalysisTestFileLocations.h"
+
+#define NEIGHBOR_ORIENTATION_CORRELATION_FILTER_NAME "NeighborOrientationCorrelation"
+
+static const QString DCName("NeighborOrientationCorrelationTest");
+
+namespace
+{
+  const int64_t k_Dims[3] = { 12, 10, 8 };
+  const float k_Tolerance = 5.0f;
+  const float k_MinConfidence = 0.1f;
+  const float k_HighConfidence = 0.5f;
+  const float k_LowConfidence = 0.05f;
+
+  // Offsets in degrees from the orientation of a Feature, so neighbors in a Feature are at most 2 degrees apart
+  const float k_Offsets[6] = { -1.0f, -0.5f, 0.0f, 0.5f, 1.0f, 0.0f };
+
+  // Low confidence cells at these cells are set up by hand; see createTestVolume()
+  const int64_t k_Interior[3] = { 2, 5, 4 };
+  const int64_t k_Unindexed[3] = { 1, 2, 2 };
+  const int64_t k_PhaseBoundary[3] = { 7, 5, 4 };
+
+  size_t cellIndex(int64_t column, int64_t row, int64_t plane)
+  {
+    return static_cast<size_t>((plane * k_Dims[1] + row) * k_Dims[0] + column);
+  }
+
+  void setRotationAboutZ(std::vector<float>& quats, size_t cell, float degrees)
+  {
+    float halfAngle = 0.5f * degrees * SIMPLib::Constants::k_PiOver180;
+    quats[4 * cell] = 0.0f;
+    quats[4 * cell + 1] = 0.0f;
+    quats[4 * cell + 2] = sinf(halfAngle);
+    quats[4 * cell + 3] = cosf(halfAngle);
+  }
+}
+
+/**
+ * @brief The TestVolume struct holds the cell data of the test volume. Columns 0-3 are a phase 1 Feature at
+ * 0 degrees about Z, columns 4-7 a phase 1 Feature at 20 degrees and columns 8-11 a phase 2 Feature also at
+ * 20 degrees, so only the phase check keeps the last two apart.
+ */
+struct TestVolume
+{
+  std::vector<float> confidence;
+  std::vector<int32_t> phases;
+  std::vector<float> quats;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the NeighborOrientationCorrelation Filter from the FilterManager
+  QString filtName = NEIGHBOR_ORIENTATION_CORRELATION_FILTER_NAME;
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get())
+  {
+    std::stringstream ss;
+    ss << "The NeighborOrientationCorrelationTest Requires the use of the " << filtName.toStdString() << " filter which is found in the OrientationAnalysis Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// A fifth of the cells have a low confidence index. Half of those keep the orientation of
+// their Feature; the other half are noise 60 degrees away. On top of that:
+//  - k_Interior is a noise cell whose six neighbors are confident and agree
+//  - k_Unindexed is a noise cell whose six neighbors are confident but in phase 0
+//  - k_PhaseBoundary is a noise cell in the 20 degree phase 1 Feature whose neighbors
+//    are confident. The neighbor at column + 1 is in the phase 2 Feature, with the same
+//    orientation as the phase 1 neighbors, and the neighbor at plane + 1 is in phase 0.
+// -----------------------------------------------------------------------------
+TestVolume createTestVolume()
+{
+  uint64_t seed = 20160107;
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+
+  size_t numCells = static_cast<size_t>(k_Dims[0] * k_Dims[1] * k_Dims[2]);
+  TestVolume volume;
+  volume.confidence.resize(numCells, k_HighConfidence);
+  volume.phases.resize(numCells, 1);
+  volume.quats.resize(4 * numCells, 0.0f);
+  std::vector<float> featureAngles(numCells, 0.0f);
+
+  for (int64_t plane = 0; plane < k_Dims[2]; plane++)
+  {
+    for (int64_t row = 0; row < k_Dims[1]; row++)
+    {
+      for (int64_t column = 0; column < k_Dims[0]; column++)
+      {
+        size_t i = cellIndex(column, row, plane);
+        volume.phases[i] = (column < 8) ? 1 : 2;
+        featureAngles[i] = (column < 4) ? 0.0f : 20.0f;
+        setRotationAboutZ(volume.quats, i, featureAngles[i] + k_Offsets[i % 6]);
+        double r = rg.genrand_res53();
+        if (r < 0.1) { volume.confidence[i] = k_LowConfidence; }
+        else if (r < 0.2)
+        {
+          volume.confidence[i] = k_LowConfidence;
+          setRotationAboutZ(volume.quats, i, featureAngles[i] + 60.0f);
+        }
+      }
+    }
+  }
+
+  const int64_t* centers[3] = { k_Interior, k_Unindexed, k_PhaseBoundary };
+  for (size_t c = 0; c < 3; c++)
+  {
+    for (int64_t d = -1; d <= 1; d += 2)
+    {
+      size_t neighbors[3] = { cellIndex(centers[c][0] + d, centers[c][1], centers[c][2]),
+                              cellIndex(centers[c][0], centers[c][1] + d, centers[c][2]),
+                              cellIndex(centers[c][0], centers[c][1], centers[c][2] + d) };
+      for (size_t n = 0; n < 3; n++)
+      {
+        volume.confidence[neighbors[n]] = k_HighConfidence;
+        setRotationAboutZ(volume.quats, neighbors[n], featureAngles[neighbors[n]] + k_Offsets[n]);
+        if (c == 1) { volume.phases[neighbors[n]] = 0; }
+      }
+    }
+    size_t i = cellIndex(centers[c][0], centers[c][1], centers[c][2]);
+    volume.confidence[i] = k_LowConfidence;
+    setRotationAboutZ(volume.quats, i, featureAngles[i] + 60.0f);
+  }
+  volume.phases[cellIndex(k_PhaseBoundary[0], k_PhaseBoundary[1], k_PhaseBoundary[2] + 1)] = 0;
+  return volume;
+}
+
+// -----------------------------------------------------------------------------
+// The serial algorithm the filter used before the search was limited to the low confidence
+// cells, with two neighbors of different phases never agreeing
+// -----------------------------------------------------------------------------
+TestVolume referenceCorrelation(const TestVolume& input, int32_t level)
+{
+  QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
+  TestVolume volume = input;
+  QuatF* quats = reinterpret_cast<QuatF*>(&(volume.quats.front()));
+  float tolerance = k_Tolerance * SIMPLib::Constants::k_Pi / 180.0f;
+  size_t totalPoints = volume.confidence.size();
+  int64_t neighpoints[6] = { -k_Dims[0] * k_Dims[1], -k_Dims[0], -1, 1, k_Dims[0], k_Dims[0] * k_Dims[1] };
+  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+
+  std::vector<int64_t> bestNeighbor(totalPoints, -1);
+  int32_t startLevel = 6;
+  for (int32_t currentLevel = startLevel; currentLevel > level; currentLevel--)
+  {
+    for (size_t i = 0; i < totalPoints; i++)
+    {
+      if (volume.confidence[i] >= k_MinConfidence) { continue; }
+      int64_t column = int64_t(i) % k_Dims[0];
+      int64_t row = (int64_t(i) / k_Dims[0]) % k_Dims[1];
+      int64_t plane = int64_t(i) / (k_Dims[0] * k_Dims[1]);
+      bool good[6] = { plane > 0, row > 0, column > 0, column < k_Dims[0] - 1, row < k_Dims[1] - 1, plane < k_Dims[2] - 1 };
+      int32_t neighborSimCount[6] = { 0, 0, 0, 0, 0, 0 };
+      for (int32_t j = 0; j < 6; j++)
+      {
+        if (good[j] == false) { continue; }
+        int64_t neighbor = int64_t(i) + neighpoints[j];
+        for (int32_t k = j + 1; k < 6; k++)
+        {
+          if (good[k] == false) { continue; }
+          int64_t neighbor2 = int64_t(i) + neighpoints[k];
+          if (volume.phases[neighbor2] != volume.phases[neighbor] || volume.phases[neighbor2] <= 0) { continue; }
+          QuatF q1 = quats[neighbor2];
+          QuatF q2 = quats[neighbor];
+          float w = ops[Ebsd::CrystalStructure::Cubic_High]->getMisoQuat(q1, q2, n1, n2, n3);
+          if (w < tolerance)
+          {
+            neighborSimCount[j]++;
+            neighborSimCount[k]++;
+          }
+        }
+      }
+      for (int32_t j = 0; j < 6; j++)
+      {
+        if (good[j] == true && neighborSimCount[j] > 0) { bestNeighbor[i] = int64_t(i) + neighpoints[j]; }
+      }
+    }
+
+    for (size_t i = 0; i < totalPoints; i++)
+    {
+      int64_t neighbor = bestNeighbor[i];
+      if (neighbor == -1) { continue; }
+      volume.confidence[i] = volume.confidence[neighbor];
+      volume.phases[i] = volume.phases[neighbor];
+      std::copy(volume.quats.begin() + 4 * neighbor, volume.quats.begin() + 4 * neighbor + 4, volume.quats.begin() + 4 * i);
+    }
+    currentLevel = currentLevel - 1;
+  }
+  return volume;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer initializeDataContainerArray(const TestVolume& volume)
+{
+  size_t dims[3] = { static_cast<size_t>(k_Dims[0]), static_cast<size_t>(k_Dims[1]), static_cast<size_t>(k_Dims[2]) };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, 0);
+  tDims[0] = dims[0];
+  tDims[1] = dims[1];
+  tDims[2] = dims[2];
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  FloatArrayType::Pointer confidence = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::ConfidenceIndex);
+  std::copy(volume.confidence.begin(), volume.confidence.end(), confidence->getPointer(0));
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Phases);
+  std::copy(volume.phases.begin(), volume.phases.end(), phases->getPointer(0));
+  cDims[0] = 4;
+  FloatArrayType::Pointer quats = FloatArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Quats);
+  std::copy(volume.quats.begin(), volume.quats.end(), quats->getPointer(0));
+  cellAttrMat->addAttributeArray(confidence->getName(), confidence);
+  cellAttrMat->addAttributeArray(phases->getName(), phases);
+  cellAttrMat->addAttributeArray(quats->getName(), quats);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+  QVector<size_t> eDims(1, 3);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  cDims[0] = 1;
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+  crystalStructures->setValue(2, Ebsd::CrystalStructure::Cubic_High);
+  ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+  m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TestVolume runFilter(const TestVolume& volume, int32_t level, int numThreads)
+{
+  DataContainerArray::Pointer dca = initializeDataContainerArray(volume);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter(NEIGHBOR_ORIENTATION_CORRELATION_FILTER_NAME);
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(k_Tolerance);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("MisorientationTolerance", var), true)
+  var.setValue(k_MinConfidence);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("MinConfidence", var), true)
+  var.setValue(level);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("Level", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::ConfidenceIndex));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("ConfidenceIndexArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellPhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Quats));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("QuatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::CrystalStructures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CrystalStructuresArrayPath", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellAttributeMatrixName);
+  FloatArrayType::Pointer confidence = boost::dynamic_pointer_cast<FloatArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::ConfidenceIndex));
+  Int32ArrayType::Pointer phases = boost::dynamic_pointer_cast<Int32ArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::Phases));
+  FloatArrayType::Pointer quats = boost::dynamic_pointer_cast<FloatArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::Quats));
+  DREAM3D_REQUIRE(confidence.get() != NULL)
+  DREAM3D_REQUIRE(phases.get() != NULL)
+  DREAM3D_REQUIRE(quats.get() != NULL)
+
+  TestVolume result;
+  result.confidence.assign(confidence->getPointer(0), confidence->getPointer(0) + confidence->getSize());
+  result.phases.assign(phases->getPointer(0), phases->getPointer(0) + phases->getSize());
+  result.quats.assign(quats->getPointer(0), quats->getPointer(0) + quats->getSize());
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool sameCell(const TestVolume& volume1, size_t cell1, const TestVolume& volume2, size_t cell2)
+{
+  return volume1.confidence[cell1] == volume2.confidence[cell2] && volume1.phases[cell1] == volume2.phases[cell2]
+         && std::equal(volume1.quats.begin() + 4 * cell1, volume1.quats.begin() + 4 * cell1 + 4, volume2.quats.begin() + 4 * cell2);
+}
+
+// -----------------------------------------------------------------------------
+// A cell copies from the last of its neighbors that agrees with any other neighbor
+// -----------------------------------------------------------------------------
+void TestKnownCopies()
+{
+  TestVolume volume = createTestVolume();
+  TestVolume result = runFilter(volume, 4, 1);
+
+  // All six neighbors agree, so the neighbor at plane + 1 is the last one
+  size_t interior = cellIndex(k_Interior[0], k_Interior[1], k_Interior[2]);
+  DREAM3D_REQUIRE(sameCell(result, interior, volume, cellIndex(k_Interior[0], k_Interior[1], k_Interior[2] + 1)))
+
+  // Phase 0 neighbors never agree, so the cell keeps its own data
+  size_t unindexed = cellIndex(k_Unindexed[0], k_Unindexed[1], k_Unindexed[2]);
+  DREAM3D_REQUIRE(sameCell(result, unindexed, volume, unindexed))
+
+  // The phase 2 neighbor has the same orientation but must not agree with the phase 1
+  // neighbors, and the phase 0 neighbor agrees with nothing, so the last agreeing neighbor
+  // is the one at row + 1
+  size_t boundary = cellIndex(k_PhaseBoundary[0], k_PhaseBoundary[1], k_PhaseBoundary[2]);
+  DREAM3D_REQUIRE(sameCell(result, boundary, volume, cellIndex(k_PhaseBoundary[0], k_PhaseBoundary[1] + 1, k_PhaseBoundary[2])))
+}
+
+// -----------------------------------------------------------------------------
+// The filter must copy exactly what the serial algorithm copies, at every cleanup level
+// and however the low confidence cells are split among threads
+// -----------------------------------------------------------------------------
+void TestAgainstSerialReference()
+{
+  TestVolume volume = createTestVolume();
+  for (int32_t level = 0; level < 6; level++)
+  {
+    TestVolume expected = referenceCorrelation(volume, level);
+    TestVolume serial = runFilter(volume, level, 1);
+    TestVolume parallel = runFilter(volume, level, 4);
+    DREAM3D_REQUIRE(serial.confidence == expected.confidence)
+    DREAM3D_REQUIRE(serial.phases == expected.phases)
+    DREAM3D_REQUIRE(serial.quats == expected.quats)
+    DREAM3D_REQUIRE(parallel.confidence == expected.confidence)
+    DREAM3D_REQUIRE(parallel.phases == expected.phases)
+    DREAM3D_REQUIRE(parallel.quats == expected.quats)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("NeighborOrientationCorrelationTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestKnownCopies() )
+  DREAM3D_REGISTER_TEST( TestAgainstSerialReference() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -244,7 +244,17 @@ void AlignSections::execute()
     }
   }
 
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArrayNames();
+  // The shift is applied in place: depending on the sign of the shift the cells of a slice are
+  // visited from the end that is overwritten first, so every source cell is read before it is
+  // replaced. The arrays are looked up once instead of once per cell.
+  AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
+  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
+  QVector<IDataArray::Pointer> voxelArrays;
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    voxelArrays.push_back(cellAttrMat->getAttributeArray(*iter));
+  }
+
   DimType progIncrement = dims[2] / 100;
   DimType prog = 1;
   DimType progressInt = 0;
@@ -264,31 +274,26 @@ void AlignSections::execute()
       return;
     }
     slice = (dims[2] - 1) - i;
-    for (DimType l = 0; l < dims[1]; l++)
+    for (QVector<IDataArray::Pointer>::iterator iter = voxelArrays.begin(); iter != voxelArrays.end(); ++iter)
     {
-      for (DimType n = 0; n < dims[0]; n++)
+      IDataArray* p = (*iter).get();
+      for (DimType l = 0; l < dims[1]; l++)
       {
         if (yshifts[i] >= 0) { yspot = l; }
-        else if (yshifts[i] < 0) { yspot = dims[1] - 1 - l; }
-        if (xshifts[i] >= 0) { xspot = n; }
-        else if (xshifts[i] < 0) { xspot = dims[0] - 1 - n; }
-        newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
-        currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
-        if ((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= dims[1] - 1 && (xspot + xshifts[i]) >= 0
-            && (xspot + xshifts[i]) <= dims[0] - 1)
+        else { yspot = dims[1] - 1 - l; }
+        for (DimType n = 0; n < dims[0]; n++)
         {
-          for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+          if (xshifts[i] >= 0) { xspot = n; }
+          else { xspot = dims[0] - 1 - n; }
+          newPosition = (slice * dims[0] * dims[1]) + (yspot * dims[0]) + xspot;
+          if ((yspot + yshifts[i]) >= 0 && (yspot + yshifts[i]) <= dims[1] - 1 && (xspot + xshifts[i]) >= 0
+              && (xspot + xshifts[i]) <= dims[0] - 1)
           {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter);
+            currentPosition = (slice * dims[0] * dims[1]) + ((yspot + yshifts[i]) * dims[0]) + (xspot + xshifts[i]);
             p->copyTuple(currentPosition, newPosition);
           }
-        }
-        if ((yspot + yshifts[i]) < 0 || (yspot + yshifts[i]) > dims[1] - 1 || (xspot + xshifts[i]) < 0
-            || (xspot + xshifts[i]) > dims[0] - 1)
-        {
-          for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+          else
           {
-            IDataArray::Pointer p = m->getAttributeMatrix(getCellAttributeMatrixName())->getAttributeArray(*iter);
             p->initializeTuple(newPosition, 0);
           }
         }
@@ -36,17 +36,79 @@
 
 #include "GroupFeatures.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 
 // Include the MOC generated file for this class
 #include "moc_GroupFeatures.cpp"
 
+/**
+ * @brief The DeterminePairGroupingImpl class evaluates the grouping test for every neighbor pair of
+ * a range of Features, storing one flag per pair in the same order the pairs were listed
+ */
+class DeterminePairGroupingImpl
+{
+    GroupFeatures* m_Filter;
+    const std::vector<int32_t>* m_Neighbors;
+    const std::vector<size_t>* m_Offsets;
+    std::vector<uint8_t>* m_Grouped;
+
+  public:
+    DeterminePairGroupingImpl(GroupFeatures* filter, const std::vector<int32_t>* neighbors, const std::vector<size_t>* offsets, std::vector<uint8_t>* grouped) :
+      m_Filter(filter),
+      m_Neighbors(neighbors),
+      m_Offsets(offsets),
+      m_Grouped(grouped)
+    {}
+    virtual ~DeterminePairGroupingImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        for (size_t p = (*m_Offsets)[i]; p < (*m_Offsets)[i + 1]; p++)
+        {
+          (*m_Grouped)[p] = m_Filter->determinePairGrouping(static_cast<int32_t>(i), (*m_Neighbors)[p]) ? 1 : 0;
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+namespace
+{
+  /**
+   * @brief findRoot Returns the root of a Feature in the union-find forest, halving the path as it goes
+   */
+  int32_t findRoot(std::vector<int32_t>& roots, int32_t feature)
+  {
+    while (roots[feature] != feature)
+    {
+      roots[feature] = roots[roots[feature]];
+      feature = roots[feature];
+    }
+    return feature;
+  }
+}
+
 
 
 // -----------------------------------------------------------------------------
@@ -179,6 +241,81 @@ bool GroupFeatures::growGrouping(int32_t referenceFeature, int32_t neighborFeatu
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupFeatures::determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature)
+{
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t GroupFeatures::groupPairwise(int32_t* featureParentIds, size_t numFeatures)
+{
+  NeighborList<int32_t>& neighborlist = *(m_ContiguousNeighborList.lock());
+  NeighborList<int32_t>* nonContigNeighList = m_NonContiguousNeighborList.lock().get();
+
+  // List each pair once per listing Feature; contiguous neighbors are symmetric, so only the
+  // higher neighbor is kept, while non-contiguous lists are kept whole since they need not be
+  std::vector<size_t> offsets(numFeatures + 1, 0);
+  std::vector<int32_t> neighbors;
+  for (size_t i = 0; i < numFeatures; i++)
+  {
+    offsets[i] = neighbors.size();
+    if (featureParentIds[i] != -1) { continue; }
+    int32_t feature = static_cast<int32_t>(i);
+    for (size_t l = 0; l < neighborlist[i].size(); l++)
+    {
+      int32_t neigh = neighborlist[i][l];
+      if (neigh > feature && featureParentIds[neigh] == -1) { neighbors.push_back(neigh); }
+    }
+    if (m_UseNonContiguousNeighbors == true)
+    {
+      std::vector<int32_t>& list = nonContigNeighList->getListReference(feature);
+      for (size_t l = 0; l < list.size(); l++)
+      {
+        int32_t neigh = list[l];
+        if (neigh != feature && featureParentIds[neigh] == -1) { neighbors.push_back(neigh); }
+      }
+    }
+  }
+  offsets[numFeatures] = neighbors.size();
+
+  std::vector<uint8_t> grouped(neighbors.size(), 0);
+  DeterminePairGroupingImpl pairs(this, &neighbors, &offsets, &grouped);
+  ParallelContext::ParallelFor<size_t>(0, numFeatures, pairs);
+
+  // Join the grouped pairs, always hanging the higher root under the lower one so that every
+  // group ends up rooted at its lowest Feature Id
+  std::vector<int32_t> roots(numFeatures, 0);
+  for (size_t i = 0; i < numFeatures; i++) { roots[i] = static_cast<int32_t>(i); }
+  for (size_t i = 0; i < numFeatures; i++)
+  {
+    for (size_t p = offsets[i]; p < offsets[i + 1]; p++)
+    {
+      if (grouped[p] == 0) { continue; }
+      int32_t root1 = findRoot(roots, static_cast<int32_t>(i));
+      int32_t root2 = findRoot(roots, neighbors[p]);
+      if (root1 < root2) { roots[root2] = root1; }
+      else if (root2 < root1) { roots[root1] = root2; }
+    }
+  }
+
+  // Roots are visited before the rest of their group, so numbering in Feature order is deterministic
+  int32_t parentcount = 0;
+  for (size_t i = 0; i < numFeatures; i++)
+  {
+    if (featureParentIds[i] != -1) { continue; }
+    int32_t root = findRoot(roots, static_cast<int32_t>(i));
+    if (root == static_cast<int32_t>(i)) { featureParentIds[i] = ++parentcount; }
+    else { featureParentIds[i] = featureParentIds[root]; }
+  }
+
+  return parentcount;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -120,6 +120,15 @@ class GroupFeatures : public AbstractFilter
     */
     virtual void preflight();
 
+    /**
+     * @brief determinePairGrouping Determines if two neighboring Features belong in the same group. Unlike
+     * determineGrouping, this must not modify any filter state since pairs are evaluated concurrently
+     * @param referenceFeature First Feature of the pair
+     * @param neighborFeature Second Feature of the pair
+     * @return Boolean check for whether the two Features should be grouped
+     */
+    virtual bool determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature);
+
   signals:
     /**
      * @brief updateFilterParameters Emitted when the Filter requests all the latest Filter parameters
@@ -183,6 +192,16 @@ class GroupFeatures : public AbstractFilter
      */
     virtual bool growGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid);
 
+    /**
+     * @brief groupPairwise Groups Features as the connected components of the neighbor graph, joining
+     * each neighbor pair for which determinePairGrouping is true. Features that already have a parent
+     * Id are left alone; the others are numbered from 1 in order of the lowest Feature Id in each group
+     * @param featureParentIds Feature parent Ids, where -1 marks a Feature to be grouped
+     * @param numFeatures Number of Features
+     * @return Number of groups created
+     */
+    int32_t groupPairwise(int32_t* featureParentIds, size_t numFeatures);
+
   private:
     NeighborList<int32_t>::WeakPointer m_ContiguousNeighborList;
     NeighborList<int32_t>::WeakPointer m_NonContiguousNeighborList;
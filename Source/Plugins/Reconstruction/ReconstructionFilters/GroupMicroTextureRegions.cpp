@@ -332,12 +332,6 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
   int32_t numfeatures = static_cast<int32_t>(m_FeaturePhasesPtr.lock()->getNumberOfTuples());
 
   float c1[3] = { 0.0f, 0.0f, 0.0f };
-  uint32_t phase1 = 0;
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
-  float caxis[3] = { 0.0f, 0.0f, 1.0f };
-  QuatF q1 = QuaternionMathF::New();
-  float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g1t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
 
   SIMPL_RANDOMNG_NEW()
   int32_t seed = -1;
@@ -364,18 +358,7 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
 
     if (m_UseRunningAverage == true)
     {
-      QuaternionMathF::Copy(avgQuats[seed], q1);
-      phase1 = m_CrystalStructures[m_FeaturePhases[seed]];
-      FOrientArrayType om(9);
-      FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-      om.toGMatrix(g1);
-      // transpose the g matrix so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
+      computeCAxis(seed, c1);
       MatrixMath::Copy3x1(c1, avgCaxes);
       MatrixMath::Multiply3x1withConstant(avgCaxes, m_Volumes[seed]);
     }
@@ -383,61 +366,64 @@ int32_t GroupMicroTextureRegions::getSeed(int32_t newFid)
   return seed;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void GroupMicroTextureRegions::computeCAxis(int32_t feature, float c[3])
+{
+  float g[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  float gt[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+  float caxis[3] = { 0.0f, 0.0f, 1.0f };
+  QuatF q = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
+  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
+
+  QuaternionMathF::Copy(avgQuats[feature], q);
+  FOrientArrayType om(9);
+  FOrientTransformsType::qu2om(FOrientArrayType(q), om);
+  om.toGMatrix(g);
+  // transpose the g matrix so when caxis is multiplied by it
+  // it will give the sample direction that the caxis is along
+  MatrixMath::Transpose3x3(g, gt);
+  MatrixMath::Multiply3x3with3x1(gt, caxis, c);
+  // normalize so that the dot product can be taken below without
+  // dividing by the magnitudes (they would be 1)
+  MatrixMath::Normalize3x1(c);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupMicroTextureRegions::cAxesWithinTolerance(float* c1, float* c2)
+{
+  float w = GeometryMath::CosThetaBetweenVectors(c1, c2);
+  SIMPLibMath::boundF(w, -1, 1);
+  w = acosf(w);
+  return (w <= caxisTolerance || (SIMPLib::Constants::k_Pi - w) <= caxisTolerance);
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
 {
   uint32_t phase1 = 0, phase2 = 0;
-  float w = 0.0f;
-  float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g1t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-  float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
   float c1[3] = { 0.0f, 0.0f, 0.0f };
   float c2[3] = { 0.0f, 0.0f, 0.0f };
-  float caxis[3] = {0.0f, 0.0f, 1.0f};
-  QuatF q1 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
-  QuatF q2 = QuaternionMathF::New(0.0f, 0.0f, 0.0f, 0.0f);
-  QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   if (m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
     if (m_UseRunningAverage == false)
     {
-      QuaternionMathF::Copy(avgQuats[referenceFeature], q1);
       phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
-      FOrientArrayType om(9);
-      FOrientTransformsType::qu2om(FOrientArrayType(q1), om);
-      om.toGMatrix(g1);
-      // transpose the g matrix so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g1, g1t);
-      MatrixMath::Multiply3x3with3x1(g1t, caxis, c1);
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c1);
+      computeCAxis(referenceFeature, c1);
     }
     phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
     if (phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High) )
     {
-      QuaternionMathF::Copy(avgQuats[neighborFeature], q2);
-      FOrientArrayType om(9);
-      FOrientTransformsType::qu2om(FOrientArrayType(q2), om);
-      om.toGMatrix(g2);
-      // transpose the g matrix so when caxis is multiplied by it
-      // it will give the sample direction that the caxis is along
-      MatrixMath::Transpose3x3(g2, g2t);
-      MatrixMath::Multiply3x3with3x1(g2t, caxis, c2);
-      // normalize so that the dot product can be taken below without
-      // dividing by the magnitudes (they would be 1)
-      MatrixMath::Normalize3x1(c2);
-
-      if (m_UseRunningAverage == true) { w = GeometryMath::CosThetaBetweenVectors(avgCaxes, c2); }
-      else { w = GeometryMath::CosThetaBetweenVectors(c1, c2); }
-      SIMPLibMath::boundF(w, -1, 1);
-      w = acosf(w);
-      if (w <= caxisTolerance || (SIMPLib::Constants::k_Pi - w) <= caxisTolerance)
+      computeCAxis(neighborFeature, c2);
+
+      bool aligned = (m_UseRunningAverage == true) ? cAxesWithinTolerance(avgCaxes, c2) : cAxesWithinTolerance(c1, c2);
+      if (aligned == true)
       {
         m_FeatureParentIds[neighborFeature] = newFid;
         if (m_UseRunningAverage == true)
@@ -452,6 +438,28 @@ bool GroupMicroTextureRegions::determineGrouping(int32_t referenceFeature, int32
   return false;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool GroupMicroTextureRegions::determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature)
+{
+  float c1[3] = { 0.0f, 0.0f, 0.0f };
+  float c2[3] = { 0.0f, 0.0f, 0.0f };
+
+  if (m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  {
+    uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
+    uint32_t phase2 = m_CrystalStructures[m_FeaturePhases[neighborFeature]];
+    if (phase1 == phase2 && (phase1 == Ebsd::CrystalStructure::Hexagonal_High) )
+    {
+      computeCAxis(referenceFeature, c1);
+      computeCAxis(neighborFeature, c2);
+      return cAxesWithinTolerance(c1, c2);
+    }
+  }
+  return false;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -485,7 +493,23 @@ void GroupMicroTextureRegions::execute()
   avgCaxes[1] = 0.0f;
   avgCaxes[2] = 0.0f;
 
-  GroupFeatures::execute();
+  m_FeatureParentIds[0] = 0; // set feature 0 to be parent 0
+
+  if (m_UseRunningAverage == true)
+  {
+    // The running average c-axis depends on the order Features join a group, so grow the groups from seeds
+    GroupFeatures::execute();
+  }
+  else
+  {
+    // Without the running average the c-axis test only depends on the pair of Features, so the groups are
+    // the connected components of the c-axis graph
+    size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+    int32_t numGroups = groupPairwise(m_FeatureParentIds, numFeatures);
+    QVector<size_t> tDims(1, numGroups + 1);
+    getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+    updateFeatureInstancePointers();
+  }
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if (totalFeatures < 2)
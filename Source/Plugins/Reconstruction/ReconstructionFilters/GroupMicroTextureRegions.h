@@ -151,6 +151,11 @@ class GroupMicroTextureRegions : public GroupFeatures
     */
     virtual void preflight();
 
+    /**
+     * @brief determinePairGrouping Reimplemented from @see GroupFeatures class
+     */
+    virtual bool determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature);
+
   protected:
     GroupMicroTextureRegions();
 
@@ -204,6 +209,21 @@ class GroupMicroTextureRegions : public GroupFeatures
      */
     void updateFeatureInstancePointers();
 
+    /**
+     * @brief computeCAxis Computes the sample direction, normalized, that the c-axis of a Feature lies along
+     * @param feature Feature Id
+     * @param c [output] Unit c-axis direction
+     */
+    void computeCAxis(int32_t feature, float c[3]);
+
+    /**
+     * @brief cAxesWithinTolerance Returns whether two c-axis directions are (anti)parallel to within the c-axis tolerance
+     * @param c1 First c-axis direction
+     * @param c2 Second c-axis direction
+     * @return
+     */
+    bool cAxesWithinTolerance(float* c1, float* c2);
+
     boost::shared_ptr<NumberDistribution> m_Distribution;
     boost::shared_ptr<RandomNumberGenerator> m_RandomNumberGenerator;
     boost::shared_ptr<Generator> m_NumberGenerator;
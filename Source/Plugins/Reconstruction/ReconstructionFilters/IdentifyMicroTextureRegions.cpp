@@ -43,7 +43,6 @@
 #include <tbb/blocked_range.h>
 #include <tbb/atomic.h>
 #include <tbb/tick_count.h>
-#include <tbb/task_scheduler_init.h>
 #include <tbb/task_group.h>
 #endif
 
@@ -56,6 +55,7 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
 
@@ -551,8 +551,8 @@ void IdentifyMicroTextureRegions::execute()
   caxisTolerance = m_CAxisTolerance * SIMPLib::Constants::k_Pi / 180.0f;
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
 // first determine the misorientation vectors on all the voxel faces
@@ -403,6 +403,19 @@ int32_t MergeColonies::getSeed(int32_t newFid)
 //
 // -----------------------------------------------------------------------------
 bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
+{
+  if (m_FeatureParentIds[neighborFeature] == -1 && determinePairGrouping(referenceFeature, neighborFeature) == true)
+  {
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeColonies::determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature)
 {
   float w = 0.0f;
   float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
@@ -411,7 +424,7 @@ bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighbor
   QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  if (m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if (m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
     w = std::numeric_limits<float>::max();
     QuaternionMathF::Copy(avgQuats[referenceFeature], q1);
@@ -445,29 +458,15 @@ bool MergeColonies::determineGrouping(int32_t referenceFeature, int32_t neighbor
       float angdiff5 = fabsf(w - 63.26f);
       float axisdiff5 = acosf(fabsf(n1) * 0.9549f + fabsf(n2) * 0.0000f + fabsf(n3) * 0.2969f);
       if (angdiff5 < m_AngleTolerance && axisdiff5 < axisTolerance) { colony = true; }
-      if (colony == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      return colony;
     }
     else if (Ebsd::CrystalStructure::Cubic_High == phase2 && Ebsd::CrystalStructure::Hexagonal_High == phase1)
     {
-      colony = check_for_burgers(q2, q1);
-      if (colony == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      return check_for_burgers(q2, q1);
     }
     else if ( Ebsd::CrystalStructure::Cubic_High == phase1 && Ebsd::CrystalStructure::Hexagonal_High == phase2)
     {
-      colony = check_for_burgers(q1, q2);
-      if (colony == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      return check_for_burgers(q1, q2);
     }
   }
   return false;
@@ -589,7 +588,14 @@ void MergeColonies::execute()
 
   axisTolerance = m_AxisTolerance * SIMPLib::Constants::k_Pi / 180.0f;
 
-  GroupFeatures::execute();
+  m_FeatureParentIds[0] = 0; // set feature 0 to be parent 0
+
+  // Colony relations only depend on the pair of Features, so the groups are the connected components of the colony graph
+  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  int32_t numGroups = groupPairwise(m_FeatureParentIds, numFeatures);
+  QVector<size_t> tDims(1, numGroups + 1);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if (totalFeatures < 2)
@@ -149,6 +149,11 @@ class MergeColonies : public GroupFeatures
     */
     virtual void preflight();
 
+    /**
+     * @brief determinePairGrouping Reimplemented from @see GroupFeatures class
+     */
+    virtual bool determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature);
+
   protected:
     MergeColonies();
 
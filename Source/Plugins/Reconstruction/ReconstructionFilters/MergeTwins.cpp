@@ -299,15 +299,27 @@ int32_t MergeTwins::getSeed(int32_t newFid)
 //
 // -----------------------------------------------------------------------------
 bool MergeTwins::determineGrouping(int32_t referenceFeature, int32_t neighborFeature, int32_t newFid)
+{
+  if (m_FeatureParentIds[neighborFeature] == -1 && determinePairGrouping(referenceFeature, neighborFeature) == true)
+  {
+    m_FeatureParentIds[neighborFeature] = newFid;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool MergeTwins::determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature)
 {
   float w = 0.0f;
   float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  bool twin = false;
   QuatF q1 = QuaternionMathF::New();
   QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  if (m_FeatureParentIds[neighborFeature] == -1 && m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
+  if (m_FeaturePhases[referenceFeature] > 0 && m_FeaturePhases[neighborFeature] > 0)
   {
     QuaternionMathF::Copy(avgQuats[referenceFeature], q1);
     uint32_t phase1 = m_CrystalStructures[m_FeaturePhases[referenceFeature]];
@@ -319,12 +331,7 @@ bool MergeTwins::determineGrouping(int32_t referenceFeature, int32_t neighborFea
       w = w * (180.0f / SIMPLib::Constants::k_Pi);
       float axisdiff111 = acosf(fabsf(n1) * 0.57735f + fabsf(n2) * 0.57735f + fabsf(n3) * 0.57735f);
       float angdiff60 = fabsf(w - 60.0f);
-      if (axisdiff111 < axisTolerance && angdiff60 < m_AngleTolerance) { twin = true; }
-      if (twin == true)
-      {
-        m_FeatureParentIds[neighborFeature] = newFid;
-        return true;
-      }
+      if (axisdiff111 < axisTolerance && angdiff60 < m_AngleTolerance) { return true; }
     }
   }
   return false;
@@ -351,7 +358,12 @@ void MergeTwins::execute()
 
   m_FeatureParentIds[0] = 0; // set feature 0 to be parent 0
 
-  GroupFeatures::execute();
+  // Twin relations only depend on the pair of Features, so the groups are the connected components of the twin graph
+  size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  int32_t numGroups = groupPairwise(m_FeatureParentIds, numFeatures);
+  QVector<size_t> tDims(1, numGroups + 1);
+  getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName())->getAttributeMatrix(getNewCellFeatureAttributeMatrixName())->resizeAttributeArrays(tDims);
+  updateFeatureInstancePointers();
 
   size_t totalFeatures = m_ActivePtr.lock()->getNumberOfTuples();
   if (totalFeatures < 2)
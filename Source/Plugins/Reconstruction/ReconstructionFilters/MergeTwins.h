@@ -140,6 +140,11 @@ class MergeTwins : public GroupFeatures
     */
     virtual void preflight();
 
+    /**
+     * @brief determinePairGrouping Reimplemented from @see GroupFeatures class
+     */
+    virtual bool determinePairGrouping(int32_t referenceFeature, int32_t neighborFeature);
+
   protected:
     MergeTwins();
 
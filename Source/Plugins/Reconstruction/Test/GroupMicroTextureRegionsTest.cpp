@@ -0,0 +1,275 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "EbsdLib/EbsdConstants.h"
+
+namespace
+{
+  const QString k_DataContainerName("DataContainer");
+  const int32_t k_NumFeatures = 10;
+  const size_t k_NumCells = 40;
+
+  /**
+   * @brief The expected groups of Features 1 to 9: Features 1, 2, 3 and 6 share a c-axis along Z,
+   * Features 4, 5 and 7 share a c-axis along X, Feature 8 has its own c-axis and Feature 9 is cubic
+   */
+  const int32_t k_ExpectedGroups[k_NumFeatures] = { 0, 1, 1, 1, 2, 2, 1, 2, 3, 4 };
+
+  /**
+   * @brief The neighbor pairs of the Feature graph. Features 3 and 4 touch but do not share a c-axis,
+   * and Feature 6 only joins Features 1 to 3 through Feature 2.
+   */
+  const int32_t k_Neighbors[][2] = { { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 5 }, { 5, 6 }, { 2, 6 }, { 6, 7 }, { 5, 7 }, { 7, 8 }, { 8, 9 } };
+  const size_t k_NumNeighborPairs = sizeof(k_Neighbors) / sizeof(k_Neighbors[0]);
+
+  /**
+   * @brief Builds a volume of Features with hexagonal average orientations and the contiguous neighbor list
+   */
+  DataContainerArray::Pointer createDataContainerArray()
+  {
+    DataContainerArray::Pointer dca = DataContainerArray::New();
+    DataContainer::Pointer m = DataContainer::New(k_DataContainerName);
+    dca->addDataContainer(m);
+
+    QVector<size_t> tDims(1, k_NumCells);
+    AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+    m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+    tDims[0] = k_NumFeatures;
+    AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+    m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+    tDims[0] = 3;
+    AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+    m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(k_NumCells, DREAM3D::CellData::FeatureIds);
+    for (size_t i = 0; i < k_NumCells; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i % k_NumFeatures));
+    }
+    cellAttrMat->addAttributeArray(featureIds->getName(), featureIds);
+
+    Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(k_NumFeatures, DREAM3D::FeatureData::Phases);
+    FloatArrayType::Pointer volumes = FloatArrayType::CreateArray(k_NumFeatures, DREAM3D::FeatureData::Volumes);
+    QVector<size_t> cDims(1, 4);
+    FloatArrayType::Pointer avgQuats = FloatArrayType::CreateArray(k_NumFeatures, cDims, DREAM3D::FeatureData::AvgQuats);
+    phases->initializeWithValue(1);
+    phases->setValue(0, 0);
+    phases->setValue(9, 2);
+    volumes->initializeWithValue(1.0f);
+    for (int32_t i = 0; i < k_NumFeatures; i++)
+    {
+      // Rotations about Z keep the c-axis along Z; a quarter turn about Y puts it along X
+      float q[4] = { 0.0f, 0.0f, sinf(0.1f * i), cosf(0.1f * i) };
+      if (k_ExpectedGroups[i] == 2) { q[0] = 0.0f; q[1] = sinf(0.25f * SIMPLib::Constants::k_Pi); q[2] = 0.0f; q[3] = cosf(0.25f * SIMPLib::Constants::k_Pi); }
+      if (i == 8) { q[0] = sinf(0.125f * SIMPLib::Constants::k_Pi); q[1] = 0.0f; q[2] = 0.0f; q[3] = cosf(0.125f * SIMPLib::Constants::k_Pi); }
+      for (int k = 0; k < 4; k++) { avgQuats->setComponent(i, k, q[k]); }
+    }
+    featureAttrMat->addAttributeArray(phases->getName(), phases);
+    featureAttrMat->addAttributeArray(volumes->getName(), volumes);
+    featureAttrMat->addAttributeArray(avgQuats->getName(), avgQuats);
+
+    NeighborList<int32_t>::Pointer neighbors = NeighborList<int32_t>::CreateArray(k_NumFeatures, DREAM3D::FeatureData::NeighborList);
+    for (size_t p = 0; p < k_NumNeighborPairs; p++)
+    {
+      neighbors->getListReference(k_Neighbors[p][0]).push_back(k_Neighbors[p][1]);
+      neighbors->getListReference(k_Neighbors[p][1]).push_back(k_Neighbors[p][0]);
+    }
+    featureAttrMat->addAttributeArray(neighbors->getName(), neighbors);
+
+    UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(3, DREAM3D::EnsembleData::CrystalStructures);
+    crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+    crystalStructures->setValue(1, Ebsd::CrystalStructure::Hexagonal_High);
+    crystalStructures->setValue(2, Ebsd::CrystalStructure::Cubic_High);
+    ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+
+    return dca;
+  }
+
+  /**
+   * @brief Runs GroupMicroTextureRegions and returns the Feature parent Ids
+   */
+  Int32ArrayType::Pointer groupFeatures(bool useRunningAverage)
+  {
+    DataContainerArray::Pointer dca = createDataContainerArray();
+
+    IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryForFilter("GroupMicroTextureRegions");
+    DREAM3D_REQUIRE(factory.get() != NULL)
+    AbstractFilter::Pointer filter = factory->create();
+    DREAM3D_REQUIRE(filter.get() != NULL)
+    filter->setDataContainerArray(dca);
+
+    QString cellName = DREAM3D::Defaults::CellAttributeMatrixName;
+    QString featureName = DREAM3D::Defaults::CellFeatureAttributeMatrixName;
+    QVariant var;
+    var.setValue(DataArrayPath(k_DataContainerName, cellName, DREAM3D::CellData::FeatureIds));
+    DREAM3D_REQUIRE(filter->setProperty("FeatureIdsArrayPath", var))
+    var.setValue(DataArrayPath(k_DataContainerName, featureName, DREAM3D::FeatureData::Phases));
+    DREAM3D_REQUIRE(filter->setProperty("FeaturePhasesArrayPath", var))
+    var.setValue(DataArrayPath(k_DataContainerName, featureName, DREAM3D::FeatureData::Volumes));
+    DREAM3D_REQUIRE(filter->setProperty("VolumesArrayPath", var))
+    var.setValue(DataArrayPath(k_DataContainerName, featureName, DREAM3D::FeatureData::AvgQuats));
+    DREAM3D_REQUIRE(filter->setProperty("AvgQuatsArrayPath", var))
+    var.setValue(DataArrayPath(k_DataContainerName, featureName, DREAM3D::FeatureData::NeighborList));
+    DREAM3D_REQUIRE(filter->setProperty("ContiguousNeighborListArrayPath", var))
+    var.setValue(DataArrayPath(k_DataContainerName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::CrystalStructures));
+    DREAM3D_REQUIRE(filter->setProperty("CrystalStructuresArrayPath", var))
+    DREAM3D_REQUIRE(filter->setProperty("UseNonContiguousNeighbors", false))
+    DREAM3D_REQUIRE(filter->setProperty("CAxisTolerance", 1.0f))
+    DREAM3D_REQUIRE(filter->setProperty("UseRunningAverage", useRunningAverage))
+
+    filter->execute();
+    DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+    DataContainer::Pointer m = dca->getDataContainer(k_DataContainerName);
+    Int32ArrayType::Pointer parentIds = m->getAttributeMatrix(featureName)->getAttributeArrayAs<Int32ArrayType>(DREAM3D::FeatureData::ParentIds);
+    DREAM3D_REQUIRE_VALID_POINTER(parentIds.get())
+
+    // Every cell takes the parent Id of its Feature
+    Int32ArrayType::Pointer featureIds = m->getAttributeMatrix(cellName)->getAttributeArrayAs<Int32ArrayType>(DREAM3D::CellData::FeatureIds);
+    Int32ArrayType::Pointer cellParentIds = m->getAttributeMatrix(cellName)->getAttributeArrayAs<Int32ArrayType>(DREAM3D::CellData::ParentIds);
+    DREAM3D_REQUIRE_VALID_POINTER(cellParentIds.get())
+    for (size_t i = 0; i < k_NumCells; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(cellParentIds->getValue(i), parentIds->getValue(featureIds->getValue(i)))
+    }
+    return parentIds;
+  }
+
+  /**
+   * @brief Checks that the parent Ids put Features in the same group exactly when the expected groups do
+   */
+  void checkPartition(Int32ArrayType::Pointer parentIds, const int32_t* expected)
+  {
+    DREAM3D_REQUIRE_EQUAL(parentIds->getNumberOfTuples(), static_cast<size_t>(k_NumFeatures))
+    DREAM3D_REQUIRE_EQUAL(parentIds->getValue(0), 0)
+    for (int32_t i = 1; i < k_NumFeatures; i++)
+    {
+      DREAM3D_REQUIRED(parentIds->getValue(i), >, 0)
+      for (int32_t j = 1; j < k_NumFeatures; j++)
+      {
+        bool sameParent = (parentIds->getValue(i) == parentIds->getValue(j));
+        bool sameGroup = (expected[i] == expected[j]);
+        DREAM3D_REQUIRE_EQUAL(sameParent, sameGroup)
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  QString filtName = "GroupMicroTextureRegions";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get())
+  {
+    std::stringstream ss;
+    ss << "The GroupMicroTextureRegionsTest Requires the use of the " << filtName.toStdString() << " filter which is found in the Reconstruction Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestPairwiseMatchesSeededGrouping()
+{
+  // Without the running average the groups are found pairwise, with it they are grown from random seeds
+  Int32ArrayType::Pointer pairwise = groupFeatures(false);
+  checkPartition(pairwise, k_ExpectedGroups);
+
+  // Every Feature in a group shares its c-axis, so the running average does not change the groups
+  for (int trial = 0; trial < 5; trial++)
+  {
+    Int32ArrayType::Pointer seeded = groupFeatures(true);
+    checkPartition(seeded, k_ExpectedGroups);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("GroupMicroTextureRegionsTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestPairwiseMatchesSeededGrouping() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
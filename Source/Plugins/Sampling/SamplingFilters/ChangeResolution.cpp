@@ -324,9 +324,10 @@ void ChangeResolution::execute()
   float x = 0.0f, y = 0.0f, z = 0.0f;
   size_t col = 0, row = 0, plane = 0;
   size_t index = 0;
-  size_t index_old = 0 ;
   size_t progressInt = 0;
-  std::vector<size_t> newindicies(totalPoints);
+  float res[3] = { 0.0f, 0.0f, 0.0f };
+  m->getGeometryAs<ImageGeom>()->getResolution(res);
+  IDataArray::IndexMap newindicies(totalPoints);
 
   for (size_t i = 0; i < m_ZP; i++)
   {
@@ -340,12 +341,11 @@ void ChangeResolution::execute()
         x = (k * m_Resolution.x);
         y = (j * m_Resolution.y);
         z = (i * m_Resolution.z);
-        col = size_t(x / m->getGeometryAs<ImageGeom>()->getXRes());
-        row = size_t(y / m->getGeometryAs<ImageGeom>()->getYRes());
-        plane = size_t(z / m->getGeometryAs<ImageGeom>()->getZRes());
-        index_old = (plane * m->getGeometryAs<ImageGeom>()->getXPoints() * m->getGeometryAs<ImageGeom>()->getYPoints()) + (row * m->getGeometryAs<ImageGeom>()->getXPoints()) + col;
+        col = size_t(x / res[0]);
+        row = size_t(y / res[1]);
+        plane = size_t(z / res[2]);
         index = (i * m_XP * m_YP) + (j * m_XP) + k;
-        newindicies[index] = index_old;
+        newindicies[index] = static_cast<int64_t>((plane * dims[0] * dims[1]) + (row * dims[0]) + col);
       }
     }
   }
@@ -357,35 +357,14 @@ void ChangeResolution::execute()
   tDims[0] = m_XP;
   tDims[1] = m_YP;
   tDims[2] = m_ZP;
-  AttributeMatrix::Pointer newCellAttrMat = AttributeMatrix::New(tDims, cellAttrMat->getName(), cellAttrMat->getType());
-
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  if (cellAttrMat->gatherAttributeArrays(newindicies, tDims) == false)
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory.
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = NULL;
-    void* destination = NULL;
-    size_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-      source = p->getVoidPointer((nComp * newIndicies_I));
-      destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-      ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->addAttributeArray(*iter, data);
+    setErrorCondition(-5558);
+    notifyErrorMessage(getHumanLabel(), "Unable to copy the cell data onto the new resolution", getErrorCondition());
+    return;
   }
   m->getGeometryAs<ImageGeom>()->setResolution(m_Resolution.x, m_Resolution.y, m_Resolution.z);
   m->getGeometryAs<ImageGeom>()->setDimensions(m_XP, m_YP, m_ZP);
-  m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  m->addAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName(), newCellAttrMat);
 
   // Feature Ids MUST already be renumbered.
   if (m_RenumberFeatures == true)
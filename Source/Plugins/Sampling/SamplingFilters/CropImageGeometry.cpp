@@ -438,30 +438,34 @@ void CropImageGeometry::execute()
   int64_t YP = ( (m_YMax - m_YMin) + 1 );
   int64_t ZP = ( (m_ZMax - m_ZMin) + 1 );
 
-  int64_t col = 0, row = 0, plane = 0;
-  int64_t colold = 0, rowold = 0, planeold = 0;
+  int64_t plane = 0, row = 0;
+  int64_t planeold = 0, rowold = 0;
   int64_t index = 0;
   int64_t index_old = 0;
+  int64_t srcXP = static_cast<int64_t>(srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints());
+  int64_t srcYP = static_cast<int64_t>(srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
+
+  // Every cropped cell sits at or before its cell in the original volume, so the data is moved in
+  // place front to back and the arrays are shrunk afterwards. Each array is looked up once and
+  // moved as a whole instead of visiting every array for every cell.
   QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (int64_t i = 0; i < ZP; i++)
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
   {
-    QString ss = QObject::tr("Cropping Volume - Slice %1 of %2 Complete").arg(i).arg(ZP);
+    QString ss = QObject::tr("Cropping Volume - Array '%1'").arg(*iter);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    planeold = (i + m_ZMin) * (srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints() * srcCellDataContainer->getGeometryAs<ImageGeom>()->getYPoints());
-    plane = (i * XP * YP);
-    for (int64_t j = 0; j < YP; j++)
+    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
+    for (int64_t i = 0; i < ZP; i++)
     {
-      rowold = (j + m_YMin) * srcCellDataContainer->getGeometryAs<ImageGeom>()->getXPoints();
-      row = (j * XP);
-      for (int64_t k = 0; k < XP; k++)
+      planeold = (i + m_ZMin) * (srcXP * srcYP);
+      plane = (i * XP * YP);
+      for (int64_t j = 0; j < YP; j++)
       {
-        colold = (k + m_XMin);
-        col = k;
-        index_old = planeold + rowold + colold;
-        index = plane + row + col;
-        for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+        rowold = (j + m_YMin) * srcXP;
+        row = (j * XP);
+        for (int64_t k = 0; k < XP; k++)
         {
-          IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
+          index_old = planeold + rowold + (k + m_XMin);
+          index = plane + row + k;
           p->copyTuple(index_old, index);
         }
       }
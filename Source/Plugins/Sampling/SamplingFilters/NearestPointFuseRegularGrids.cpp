@@ -212,22 +212,11 @@ void NearestPointFuseRegularGrids::execute()
 
   float x = 0.0f, y = 0.0f, z = 0.0f;
   int64_t col = 0, row = 0, plane = 0;
-  int64_t refIndex = 0;
-  int64_t sampleIndex = 0;
   int64_t planeComp = 0, rowComp = 0;
 
-  // Create arrays on the reference grid to hold data present on the sampling grid
-  QList<QString> voxelArrayNames = sampleAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-  {
-    IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(numRefTuples, p->getComponentDimensions(), p->getName());
-    refAttrMat->addAttributeArray(p->getName(), data);
-  }
-
+  // Find the sampling cell nearest to each reference cell; reference cells outside of the sampling
+  // grid keep a negative entry and receive zero valued data
+  IDataArray::IndexMap sampleIndices(static_cast<size_t>(numRefTuples), -1);
   bool outside  = false;
   for (int64_t i = 0; i < refDims[2]; i++)
   {
@@ -250,28 +239,29 @@ void NearestPointFuseRegularGrids::execute()
         if (col >= sampleDims[0] || row >= sampleDims[1] || plane >= sampleDims[2]) { outside = true; }
         if (outside == false)
         {
-          sampleIndex = (plane * sampleDims[0] * sampleDims[1]) + (row * sampleDims[0]) + col;
-          refIndex = planeComp + rowComp + k;
-          for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
-          {
-            IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
-            // Make a copy of the 'p' array that has the same name. When placed into
-            // the data container this will over write the current array with
-            // the same name. At least in theory
-            IDataArray::Pointer data = refAttrMat->getAttributeArray(*iter);
-            void* source = NULL;
-            void* destination = NULL;
-            int nComp = data->getNumberOfComponents();
-
-            source = p->getVoidPointer((nComp * sampleIndex));
-            destination = data->getVoidPointer((nComp * refIndex));
-            ::memcpy(destination, source, p->getTypeSize() * nComp);
-          }
+          sampleIndices[planeComp + rowComp + k] = (plane * sampleDims[0] * sampleDims[1]) + (row * sampleDims[0]) + col;
         }
       }
     }
   }
 
+  // Copy every sampling array onto the reference grid. When placed into the reference Attribute Matrix
+  // this will over write any array with the same name.
+  QList<QString> voxelArrayNames = sampleAttrMat->getAttributeArrayNames();
+  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  {
+    IDataArray::Pointer p = sampleAttrMat->getAttributeArray(*iter);
+    IDataArray::Pointer data = p->gather(sampleIndices);
+    if (NULL == data.get())
+    {
+      QString ss = QObject::tr("The Attribute Array '%1' could not be copied onto the reference grid").arg(p->getName());
+      setErrorCondition(-5556);
+      notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+      return;
+    }
+    refAttrMat->addAttributeArray(p->getName(), data);
+  }
+
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
 
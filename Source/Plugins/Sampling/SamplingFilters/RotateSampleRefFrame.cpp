@@ -40,7 +40,6 @@
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range3d.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
@@ -51,6 +50,7 @@
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Math/GeometryMath.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
@@ -83,14 +83,14 @@ typedef struct
 class RotateSampleRefFrameImpl
 {
 
-    DataArray<int64_t>::Pointer newIndicesPtr;
+    int64_t* m_NewIndices;
     float rotMatrixInv[3][3];
     bool m_SliceBySlice;
     RotateSampleRefFrameImplArg_t*  m_params;
 
   public:
-    RotateSampleRefFrameImpl(DataArray<int64_t>::Pointer newindices, RotateSampleRefFrameImplArg_t*  args, float rotMat[3][3], bool sliceBySlice) :
-      newIndicesPtr(newindices),
+    RotateSampleRefFrameImpl(int64_t* newindices, RotateSampleRefFrameImplArg_t*  args, float rotMat[3][3], bool sliceBySlice) :
+      m_NewIndices(newindices),
       m_SliceBySlice(sliceBySlice),
       m_params(args)
     {
@@ -110,7 +110,7 @@ class RotateSampleRefFrameImpl
     void convert(int64_t zStart, int64_t zEnd, int64_t yStart, int64_t yEnd, int64_t xStart, int64_t xEnd) const
     {
 
-      int64_t* newindicies = newIndicesPtr->getPointer(0);
+      int64_t* newindicies = m_NewIndices;
       int64_t index = 0;
       int64_t ktot = 0, jtot = 0;
       //      float rotMatrixInv[3][3];
@@ -466,73 +466,40 @@ void RotateSampleRefFrame::execute()
 
   int64_t newNumCellTuples = params.xpNew * params.ypNew * params.zpNew;
 
-  DataArray<int64_t>::Pointer newIndiciesPtr = DataArray<int64_t>::CreateArray(newNumCellTuples, "_INTERNAL_USE_ONLY_RotateSampleRef_NewIndicies");
-  newIndiciesPtr->initializeWithValue(-1);
-  int64_t* newindicies = newIndiciesPtr->getPointer(0);
+  IDataArray::IndexMap newIndicies(static_cast<size_t>(newNumCellTuples), -1);
+  int64_t* newindicies = &(newIndicies.front());
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   if (doParallel == true)
   {
     tbb::parallel_for(tbb::blocked_range3d<int64_t, int64_t, int64_t>(0, params.zpNew, 0, params.ypNew, 0, params.xpNew),
-                      RotateSampleRefFrameImpl(newIndiciesPtr, &params, rotMat, m_SliceBySlice), tbb::auto_partitioner());
+                      RotateSampleRefFrameImpl(newindicies, &params, rotMat, m_SliceBySlice), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    RotateSampleRefFrameImpl serial(newIndiciesPtr, &params, rotMat, m_SliceBySlice);
+    RotateSampleRefFrameImpl serial(newindicies, &params, rotMat, m_SliceBySlice);
     serial.convert(0, params.zpNew, 0, params.ypNew, 0, params.xpNew);
   }
 
-  // This could technically be parallelized also where each thread takes an array to adjust. Except
-  // that the DataContainer is NOT thread safe or re-entrant so that would actually be a BAD idea.
+  // Every array of the cell Attribute Matrix is moved through the same index map; cells of the
+  // rotated grid that have no source cell are set to zero.
   QString attrMatName = getCellAttributeMatrixPath().getAttributeMatrixName();
-  QList<QString> voxelArrayNames = m->getAttributeMatrix(attrMatName)->getAttributeArrayNames();
-
-  // resize attribute matrix
   QVector<size_t> tDims(3);
   tDims[0] = params.xpNew;
   tDims[1] = params.ypNew;
   tDims[2] = params.zpNew;
-  m->getAttributeMatrix(attrMatName)->resizeAttributeArrays(tDims);
-
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  if (m->getAttributeMatrix(attrMatName)->gatherAttributeArrays(newIndicies, tDims) == false)
   {
-    IDataArray::Pointer p = m->getAttributeMatrix(attrMatName)->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name.
-    IDataArray::Pointer data = p->createNewArray(newNumCellTuples, p->getComponentDimensions(), p->getName());
-    void* source = NULL;
-    void* destination = NULL;
-    int64_t newIndicies_I = 0;
-    int32_t nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(newNumCellTuples); i++)
-    {
-      newIndicies_I = newindicies[i];
-      if(newIndicies_I >= 0)
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        if (NULL == source)
-        {
-          QString ss = QObject::tr("The index is outside the bounds of the source array");
-          setErrorCondition(-11004);
-          notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
-          return;
-        }
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        data->initializeTuple(i, 0);
-      }
-    }
-    m->getAttributeMatrix(attrMatName)->addAttributeArray(*iter, data);
+    QString ss = QObject::tr("The index is outside the bounds of the source array");
+    setErrorCondition(-11004);
+    notifyErrorMessage(getHumanLabel(), ss, getErrorCondition());
+    return;
   }
   m->getGeometryAs<ImageGeom>()->setResolution(params.xResNew, params.yResNew, params.zResNew);
   m->getGeometryAs<ImageGeom>()->setDimensions(params.xpNew, params.ypNew, params.zpNew);
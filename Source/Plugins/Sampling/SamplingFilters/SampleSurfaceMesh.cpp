@@ -40,7 +40,6 @@
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
@@ -52,6 +51,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "Sampling/SamplingConstants.h"
 
@@ -239,8 +239,8 @@ void SampleSurfaceMesh::execute()
   SIMPL_RANDOMNG_NEW()
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
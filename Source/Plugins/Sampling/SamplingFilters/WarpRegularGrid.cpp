@@ -245,7 +245,6 @@ void WarpRegularGrid::execute()
   else { m = getDataContainerArray()->getDataContainer(getNewDataContainerName()); }
 
   AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  AttributeMatrix::Pointer newCellAttrMat = cellAttrMat->deepCopy();
 
   size_t dims[3] = { 0, 0, 0 };
   m->getGeometryAs<ImageGeom>()->getDimensions(dims);
@@ -253,13 +252,12 @@ void WarpRegularGrid::execute()
   m->getGeometryAs<ImageGeom>()->getResolution(res);
   size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
+  float x = 0.0f, y = 0.0f;
   float newX = 0.0f, newY = 0.0f;
   int col = 0.0f, row = 0.0f, plane = 0.0f;
   size_t index;
-  size_t index_old;
-  std::vector<size_t> newindicies(totalPoints);
-  std::vector<bool> goodPoint(totalPoints, true);
+  // Cells whose warped position falls outside of the grid keep a negative entry and are set to zero
+  IDataArray::IndexMap newindicies(totalPoints, -1);
 
   for (size_t i = 0; i < dims[2]; i++)
   {
@@ -271,7 +269,6 @@ void WarpRegularGrid::execute()
       {
         x = static_cast<float>((k * res[0]));
         y = static_cast<float>((j * res[1]));
-        z = static_cast<float>((i * res[2]));
         index = (i * dims[0] * dims[1]) + (j * dims[0]) + k;
 
         determine_warped_coordinates(x, y, newX, newY);
@@ -279,47 +276,21 @@ void WarpRegularGrid::execute()
         row = newY / res[1];
         plane = i;
 
-        index_old = (plane * dims[0] * dims[1]) + (row * dims[0]) + col;
-        newindicies[index] = index_old;
-        if (col > 0 && col < dims[0] && row > 0 && row < dims[1]) { goodPoint[index] = true; }
-        else { goodPoint[index] = false; }
+        if (col > 0 && col < dims[0] && row > 0 && row < dims[1])
+        {
+          newindicies[index] = static_cast<int64_t>((plane * dims[0] * dims[1]) + (row * dims[0]) + col);
+        }
       }
     }
   }
 
-  QList<QString> voxelArrayNames = cellAttrMat->getAttributeArrayNames();
-  for (QList<QString>::iterator iter = voxelArrayNames.begin(); iter != voxelArrayNames.end(); ++iter)
+  QVector<size_t> tDims = cellAttrMat->getTupleDimensions();
+  if (cellAttrMat->gatherAttributeArrays(newindicies, tDims) == false)
   {
-    IDataArray::Pointer p = cellAttrMat->getAttributeArray(*iter);
-    // Make a copy of the 'p' array that has the same name. When placed into
-    // the data container this will over write the current array with
-    // the same name. At least in theory
-    IDataArray::Pointer data = p->createNewArray(p->getNumberOfTuples(), p->getComponentDimensions(), p->getName());
-    data->resize(totalPoints);
-    void* source = NULL;
-    void* destination = NULL;
-    size_t newIndicies_I = 0;
-    int nComp = data->getNumberOfComponents();
-    for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
-    {
-      newIndicies_I = newindicies[i];
-
-      if(goodPoint[i] == true)
-      {
-        source = p->getVoidPointer((nComp * newIndicies_I));
-        destination = data->getVoidPointer((data->getNumberOfComponents() * i));
-        ::memcpy(destination, source, p->getTypeSize() * data->getNumberOfComponents());
-      }
-      else
-      {
-        data->initializeTuple(i, 0);
-      }
-    }
-    cellAttrMat->removeAttributeArray(*iter);
-    newCellAttrMat->addAttributeArray(*iter, data);
+    setErrorCondition(-5556);
+    notifyErrorMessage(getHumanLabel(), "Unable to copy the warped cell data", getErrorCondition());
+    return;
   }
-  m->removeAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName());
-  m->addAttributeMatrix(getCellAttributeMatrixPath().getAttributeMatrixName(), newCellAttrMat);
 
   notifyStatusMessage(getHumanLabel(), "Complete");
 }
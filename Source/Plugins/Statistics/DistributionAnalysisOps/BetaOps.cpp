@@ -134,3 +134,33 @@ int BetaOps::calculateCorrelatedParameters(std::vector<std::vector<float> >& dat
   return err;
 }
 
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BetaOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  float avg = 0;
+  float stddev = 0;
+  float alpha = 0;
+  float beta = 0;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < moments.size(); i++)
+  {
+    alpha = 0;
+    beta = 0;
+    if(moments[i].getCount() > 1)
+    {
+      avg = static_cast<float>(moments[i].getMean());
+      stddev = static_cast<float>(moments[i].getVariance());
+      if (stddev != 0)
+      {
+        alpha = avg * (((avg * (1 - avg)) / stddev) - 1);
+        beta = (1 - avg) * (((avg * (1 - avg)) / stddev) - 1);
+      }
+    }
+    outputs[0]->setValue(i, alpha);
+    outputs[1]->setValue(i, beta);
+  }
+  return err;
+}
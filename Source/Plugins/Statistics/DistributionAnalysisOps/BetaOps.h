@@ -60,6 +60,7 @@ class BetaOps : public DistributionAnalysisOps
 
     int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
     int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+    int calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs);
 
   protected:
     BetaOps();
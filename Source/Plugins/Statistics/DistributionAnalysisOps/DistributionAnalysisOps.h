@@ -44,7 +44,7 @@
 #include "SIMPLib/StatsData/StatsData.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 
-#include "DistributionAnalysisOps/DistributionAnalysisOps.h"
+#include "DistributionAnalysisOps/DistributionMoments.h"
 
 
 /*
@@ -61,6 +61,15 @@ class DistributionAnalysisOps
     virtual int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs) = 0;
     virtual int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs) = 0;
 
+    /**
+     * @brief calculateCorrelatedParameters Fits one distribution per bin from moments that were
+     * gathered in a single pass over the data instead of from the samples themselves.
+     * @param moments The moments of each bin
+     * @param outputs
+     * @return
+     */
+    virtual int calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs) = 0;
+
     static void determineMaxAndMinValues(std::vector<float>& data, float& max, float& min);
     static void determineBinNumbers(float& max, float& min, float& numbins, FloatArrayType::Pointer binnumbers);
 
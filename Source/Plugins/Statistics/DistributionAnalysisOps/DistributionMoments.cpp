@@ -0,0 +1,129 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DistributionMoments.h"
+
+#include <math.h>
+#include <limits>
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DistributionMoments::DistributionMoments() :
+  m_Count(0),
+  m_FirstValue(0.0f),
+  m_Minimum(std::numeric_limits<float>::max()),
+  m_Maximum(-std::numeric_limits<float>::max()),
+  m_Mean(0.0),
+  m_SumSquares(0.0),
+  m_LogMean(0.0),
+  m_LogSumSquares(0.0)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DistributionMoments::~DistributionMoments()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionMoments::addValue(float value)
+{
+  if (m_Count == 0) { m_FirstValue = value; }
+  if (value < m_Minimum) { m_Minimum = value; }
+  if (value > m_Maximum) { m_Maximum = value; }
+  m_Count++;
+
+  double n = static_cast<double>(m_Count);
+  double delta = static_cast<double>(value) - m_Mean;
+  m_Mean += delta / n;
+  m_SumSquares += delta * (static_cast<double>(value) - m_Mean);
+
+  double logValue = log(static_cast<double>(value));
+  delta = logValue - m_LogMean;
+  m_LogMean += delta / n;
+  m_LogSumSquares += delta * (logValue - m_LogMean);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DistributionMoments::merge(const DistributionMoments& other)
+{
+  if (other.m_Count == 0) { return; }
+  if (m_Count == 0)
+  {
+    *this = other;
+    return;
+  }
+  if (other.m_Minimum < m_Minimum) { m_Minimum = other.m_Minimum; }
+  if (other.m_Maximum > m_Maximum) { m_Maximum = other.m_Maximum; }
+
+  double na = static_cast<double>(m_Count);
+  double nb = static_cast<double>(other.m_Count);
+  double n = na + nb;
+
+  double delta = other.m_Mean - m_Mean;
+  m_Mean += delta * nb / n;
+  m_SumSquares += other.m_SumSquares + delta * delta * na * nb / n;
+
+  delta = other.m_LogMean - m_LogMean;
+  m_LogMean += delta * nb / n;
+  m_LogSumSquares += other.m_LogSumSquares + delta * delta * na * nb / n;
+
+  m_Count += other.m_Count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double DistributionMoments::getVariance() const
+{
+  if (m_Count == 0) { return 0.0; }
+  return m_SumSquares / static_cast<double>(m_Count);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double DistributionMoments::getLogVariance() const
+{
+  if (m_Count == 0) { return 0.0; }
+  return m_LogSumSquares / static_cast<double>(m_Count);
+}
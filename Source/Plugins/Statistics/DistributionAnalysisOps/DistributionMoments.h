@@ -0,0 +1,98 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _DistributionMoments_H_
+#define _DistributionMoments_H_
+
+#include <stddef.h>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The DistributionMoments class keeps running statistics of a set of samples so
+ * that a distribution can be fit in a single pass without storing the samples. The mean
+ * and variance of the values and of their logarithms are updated with Welford's method,
+ * and two sets of moments gathered on different threads can be merged.
+ */
+class DistributionMoments
+{
+  public:
+    DistributionMoments();
+    virtual ~DistributionMoments();
+
+    /**
+     * @brief addValue Adds one sample
+     * @param value
+     */
+    void addValue(float value);
+
+    /**
+     * @brief merge Combines the samples seen by another set of moments into this one. When
+     * both sets hold samples the first value of this set is kept.
+     * @param other
+     */
+    void merge(const DistributionMoments& other);
+
+    size_t getCount() const { return m_Count; }
+    float getFirstValue() const { return m_FirstValue; }
+    float getMinimum() const { return m_Minimum; }
+    float getMaximum() const { return m_Maximum; }
+    double getMean() const { return m_Mean; }
+    double getLogMean() const { return m_LogMean; }
+
+    /**
+     * @brief getVariance Returns the population variance of the samples
+     * @return
+     */
+    double getVariance() const;
+
+    /**
+     * @brief getLogVariance Returns the population variance of the logarithm of the samples
+     * @return
+     */
+    double getLogVariance() const;
+
+  private:
+    size_t m_Count;
+    float m_FirstValue;
+    float m_Minimum;
+    float m_Maximum;
+    double m_Mean;
+    double m_SumSquares;
+    double m_LogMean;
+    double m_LogSumSquares;
+};
+
+#endif /* _DistributionMoments_H_ */
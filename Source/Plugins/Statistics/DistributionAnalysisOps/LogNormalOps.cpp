@@ -130,3 +130,30 @@ int LogNormalOps::calculateCorrelatedParameters(std::vector<std::vector<float> >
   return err;
 }
 
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int LogNormalOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  float avg = 0;
+  float stddev = 0;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < moments.size(); i++)
+  {
+    avg = 0;
+    stddev = 0;
+    if(moments[i].getCount() > 1)
+    {
+      avg = static_cast<float>(moments[i].getLogMean());
+      stddev = static_cast<float>(sqrt(moments[i].getLogVariance()));
+    }
+    else if (moments[i].getCount() == 1)
+    {
+      avg = moments[i].getFirstValue();
+    }
+    outputs[0]->setValue(i, avg);
+    outputs[1]->setValue(i, stddev);
+  }
+  return err;
+}
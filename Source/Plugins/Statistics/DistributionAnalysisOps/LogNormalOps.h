@@ -61,6 +61,7 @@ class LogNormalOps : public DistributionAnalysisOps
 
     int calculateParameters(std::vector<float>& data, FloatArrayType::Pointer outputs);
     int calculateCorrelatedParameters(std::vector<std::vector<float> >& data, VectorOfFloatArray outputs);
+    int calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs);
 
   protected:
     LogNormalOps();
@@ -128,3 +128,33 @@ int PowerLawOps::calculateCorrelatedParameters(std::vector<std::vector<float> >&
   return err;
 }
 
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PowerLawOps::calculateCorrelatedParameters(const std::vector<DistributionMoments>& moments, VectorOfFloatArray outputs)
+{
+  int err = 0;
+  float alpha = 0;
+  float min = 0;
+  for(std::vector<DistributionMoments>::size_type i = 0; i < moments.size(); i++)
+  {
+    alpha = 0;
+    min = 0;
+    if(moments[i].getCount() > 1)
+    {
+      // The sum of log(x / min) follows from the mean of log(x)
+      double count = static_cast<double>(moments[i].getCount());
+      min = moments[i].getMinimum();
+      alpha = static_cast<float>(count * (moments[i].getLogMean() - log(static_cast<double>(min))));
+      if(alpha != 0.0f)
+      {
+        alpha = 1.0f / alpha;
+      }
+      alpha = 1.0f + (alpha * moments[i].getCount());
+    }
+    outputs[0]->setValue(i, alpha);
+    outputs[1]->setValue(i, min);
+  }
+  return err;
+}
@@ -36,6 +36,7 @@
 set(DistributionAnalysisOps_HDRS
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/BetaOps.h
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/DistributionAnalysisOps.h
+  ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/DistributionMoments.h
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/LogNormalOps.h
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/PowerLawOps.h
 )
@@ -43,6 +44,7 @@ set(DistributionAnalysisOps_HDRS
 set(DistributionAnalysisOps_SRCS
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/BetaOps.cpp
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/DistributionAnalysisOps.cpp
+  ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/DistributionMoments.cpp
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/LogNormalOps.cpp
   ${Statistics_SOURCE_DIR}/DistributionAnalysisOps/PowerLawOps.cpp
   )
@@ -44,6 +44,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/FeatureReductions.hpp"
 
 #include "Statistics/StatisticsConstants.h"
 
@@ -181,22 +182,9 @@ void findAverage(IDataArray::Pointer inDataPtr, FloatArrayType::Pointer averageA
   size_t numPoints = inputDataPtr->getNumberOfTuples();
   size_t numFeatures = averageArray->getNumberOfTuples();
 
-  std::vector<float> counts(numFeatures, 0.0f);
-
-  int32_t feature = 0;
-  float value = 0.0f;
-  for (size_t i = 0; i < numPoints; i++)
-  {
-    value = float(cPtr[i]);
-    feature = fIds[i];
-    aPtr[feature] += value;
-    counts[feature] += 1.0f;
-  }
-  for (size_t i = 1; i < numFeatures; i++)
-  {
-    if (counts[i] == 0) { aPtr[i] = 0; }
-    else { aPtr[i] /= counts[i]; }
-  }
+  FeatureReductionEngine engine(fIds, numPoints, numFeatures);
+  engine.addReduction(FeatureAverageReduction<T>::New(cPtr, aPtr));
+  engine.execute();
 }
 
 // -----------------------------------------------------------------------------
@@ -11,13 +11,13 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArrayCreationFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 #include "Statistics/StatisticsConstants.h"
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 /**
@@ -88,8 +88,8 @@ class ExecuteFindDifferenceMap
     void Execute(IDataArray::Pointer firstArrayPtr, IDataArray::Pointer secondArrayPtr, IDataArray::Pointer differenceMapPtr)
     {
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-      tbb::task_scheduler_init init;
-      bool doParallel = true;
+      ParallelContext::Scheduler scheduler;
+      bool doParallel = scheduler.doParallel();
 #endif
 
       size_t numTuples = firstArrayPtr->getNumberOfTuples();
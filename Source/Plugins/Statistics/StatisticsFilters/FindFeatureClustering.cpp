@@ -36,6 +36,12 @@
 
 #include "FindFeatureClustering.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -46,12 +52,78 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Math/RadialDistributionFunction.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "Statistics/StatisticsConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindFeatureClustering.cpp"
 
+/**
+ * @brief The FindClusteringDistancesImpl class fills in the distances from each Feature of the
+ * selected phase to every other Feature of that phase, in Feature order. Each Feature computes its
+ * own list, so every pair is measured from both ends rather than shared between threads.
+ */
+class FindClusteringDistancesImpl
+{
+    const float* m_Centroids;
+    const std::vector<size_t>* m_Members;
+    std::vector<std::vector<float> >* m_ClusteringList;
+    float* m_MinDistances;
+    float* m_MaxDistances;
+
+  public:
+    FindClusteringDistancesImpl(const float* centroids, const std::vector<size_t>* members, std::vector<std::vector<float> >* clusteringList,
+                                float* minDistances, float* maxDistances) :
+      m_Centroids(centroids),
+      m_Members(members),
+      m_ClusteringList(clusteringList),
+      m_MinDistances(minDistances),
+      m_MaxDistances(maxDistances)
+    {}
+    virtual ~FindClusteringDistancesImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      const std::vector<size_t>& members = *m_Members;
+      for (size_t a = start; a < end; a++)
+      {
+        size_t i = members[a];
+        float x = m_Centroids[3 * i];
+        float y = m_Centroids[3 * i + 1];
+        float z = m_Centroids[3 * i + 2];
+        float min = std::numeric_limits<float>::max();
+        float max = 0.0f;
+
+        std::vector<float>& distances = (*m_ClusteringList)[i];
+        distances.resize(members.size() - 1);
+        size_t count = 0;
+        for (size_t b = 0; b < members.size(); b++)
+        {
+          if (b == a) { continue; }
+          size_t j = members[b];
+          float xn = m_Centroids[3 * j];
+          float yn = m_Centroids[3 * j + 1];
+          float zn = m_Centroids[3 * j + 2];
+
+          float r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
+          distances[count++] = r;
+          if (r > max) { max = r; }
+          if (r < min) { min = r; }
+        }
+        m_MinDistances[a] = min;
+        m_MaxDistances[a] = max;
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -247,16 +319,11 @@ void FindFeatureClustering::find_clustering()
     writeErrorFile = true;
   }
 
-  float x = 0.0f, y = 0.0f, z = 0.0f;
-  float xn = 0.0f, yn = 0.0f, zn = 0.0f;
-  float r = 0.0f;
-
   int32_t bin = 0;
   int32_t ensemble = 0;
   int32_t totalPPTfeatures = 0;
   float min = std::numeric_limits<float>::max();
   float max = 0.0f;
-  float value = 0.0f;
   float sizex = 0.0f, sizey = 0.0f, sizez = 0.0f, totalvol = 0.0f, totalpoints = 0.0f;
   float normFactor = 0.0f;
 
@@ -287,58 +354,39 @@ void FindFeatureClustering::find_clustering()
   boxres[1] = m->getGeometryAs<ImageGeom>()->getYRes();
   boxres[2] = m->getGeometryAs<ImageGeom>()->getZRes();
 
+  std::vector<size_t> members;
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    if (m_FeaturePhases[i] == m_PhaseNumber) {totalPPTfeatures++;}
+    if (m_FeaturePhases[i] == m_PhaseNumber) { members.push_back(i); }
   }
+  totalPPTfeatures = static_cast<int32_t>(members.size());
 
   clusteringlist.resize(totalFeatures);
 
-  for (size_t i = 1; i < totalFeatures; i++)
+  if (members.size() > 1)
   {
-    if (m_FeaturePhases[i] == m_PhaseNumber)
-    {
-      if (i % 1000 == 0)
-      {
-        QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalPPTfeatures);
-        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-      }
+    // Every Feature of the phase is measured against every other one, so the work is split by Feature
+    std::vector<float> minDistances(members.size());
+    std::vector<float> maxDistances(members.size());
+    FindClusteringDistancesImpl finder(m_Centroids, &members, &clusteringlist, &(minDistances.front()), &(maxDistances.front()));
+    ParallelContext::ParallelFor<size_t>(0, members.size(), finder);
 
-      x = m_Centroids[3 * i];
-      y = m_Centroids[3 * i + 1];
-      z = m_Centroids[3 * i + 2];
-
-      for (size_t j = i + 1; j < totalFeatures; j++)
-      {
-        if (m_FeaturePhases[i] == m_FeaturePhases[j])
-        {
-          xn = m_Centroids[3 * j];
-          yn = m_Centroids[3 * j + 1];
-          zn = m_Centroids[3 * j + 2];
-
-          r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
-
-          clusteringlist[i].push_back(r);
-          clusteringlist[j].push_back(r);
-
-          if (writeErrorFile == true && m_FeaturePhases[j] == 2)
-          {
-            outFile << r << "\n" << r << "\n";
-          }
-        }
-      }
+    for (size_t a = 0; a < members.size(); a++)
+    {
+      if (maxDistances[a] > max) { max = maxDistances[a]; }
+      if (minDistances[a] < min) { min = minDistances[a]; }
     }
-  }
 
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    for (size_t j = 0; j < clusteringlist[i].size(); j++)
+    if (writeErrorFile == true && m_PhaseNumber == 2)
     {
-      if (m_FeaturePhases[i] == m_PhaseNumber)
+      for (size_t a = 0; a < members.size(); a++)
       {
-        value = clusteringlist[i][j];
-        if (value > max) { max = value; }
-        if (value < min) { min = value; }
+        // Each pair is written once, from its lower Feature, whose later partners start at position a
+        const std::vector<float>& distances = clusteringlist[members[a]];
+        for (size_t n = a; n < distances.size(); n++)
+        {
+          outFile << distances[n] << "\n" << distances[n] << "\n";
+        }
       }
     }
   }
@@ -414,7 +462,7 @@ void FindFeatureClustering::find_clustering()
   {
     // Set the vector for each list into the Clustering Object
     NeighborList<float>::SharedVectorType sharedClustLst(new std::vector<float>);
-    sharedClustLst->assign(clusteringlist[i].begin(), clusteringlist[i].end());
+    sharedClustLst->swap(clusteringlist[i]);
     m_ClusteringList.lock()->setList(static_cast<int>(i), sharedClustLst);
   }
 }
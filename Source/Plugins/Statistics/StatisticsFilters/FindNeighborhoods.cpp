@@ -36,6 +36,14 @@
 
 #include "FindNeighborhoods.h"
 
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
@@ -45,12 +53,100 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Math/PointGrid.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "Statistics/StatisticsConstants.h"
 
 // Include the MOC generated file for this class
 #include "moc_FindNeighborhoods.cpp"
 
+/**
+ * @brief The FindNeighborhoodsImpl class finds the neighborhood of each Feature. A Feature's neighbors
+ * are the Features whose centroid bins differ from its own by less than its critical distance along
+ * every axis; the candidates come from a PointGrid of the centroids.
+ */
+class FindNeighborhoodsImpl
+{
+    const PointGrid* m_Grid;
+    const int64_t* m_Bins;
+    const float* m_CriticalDistance;
+    float m_Origin[3];
+    float m_BinSize;
+    int32_t* m_Neighborhoods;
+    std::vector<std::vector<int32_t> >* m_NeighborhoodList;
+
+  public:
+    FindNeighborhoodsImpl(const PointGrid* grid, const int64_t* bins, const float* criticalDistance, const float origin[3], float binSize,
+                          int32_t* neighborhoods, std::vector<std::vector<int32_t> >* neighborhoodList) :
+      m_Grid(grid),
+      m_Bins(bins),
+      m_CriticalDistance(criticalDistance),
+      m_BinSize(binSize),
+      m_Neighborhoods(neighborhoods),
+      m_NeighborhoodList(neighborhoodList)
+    {
+      m_Origin[0] = origin[0];
+      m_Origin[1] = origin[1];
+      m_Origin[2] = origin[2];
+    }
+    virtual ~FindNeighborhoodsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      std::vector<size_t> candidates;
+      float boxMin[3] = { 0.0f, 0.0f, 0.0f };
+      float boxMax[3] = { 0.0f, 0.0f, 0.0f };
+      for (size_t i = start; i < end; i++)
+      {
+        std::vector<int32_t>& neighborhood = (*m_NeighborhoodList)[i];
+        float criticalDistance = m_CriticalDistance[i];
+        if (criticalDistance > 0.0f)
+        {
+          // Bins that differ by less than the critical distance differ by at most reach bins. The box
+          // gets half a bin of slack on each side, plus one more bin below when it reaches bin 0,
+          // because centroids just below the origin also truncate into bin 0.
+          float reach = ceilf(criticalDistance) - 1.0f;
+          for (size_t k = 0; k < 3; k++)
+          {
+            float lowBin = static_cast<float>(m_Bins[3 * i + k]) - reach;
+            float highBin = static_cast<float>(m_Bins[3 * i + k]) + reach + 1.0f;
+            if (lowBin <= 0.0f) { lowBin = lowBin - 1.0f; }
+            boxMin[k] = m_Origin[k] + (lowBin - 0.5f) * m_BinSize;
+            boxMax[k] = m_Origin[k] + (highBin + 0.5f) * m_BinSize;
+          }
+          candidates.clear();
+          m_Grid->findCandidatesInBox(boxMin, boxMax, candidates);
+
+          for (size_t n = 0; n < candidates.size(); n++)
+          {
+            size_t j = candidates[n];
+            if (j == i) { continue; }
+            // Use the llabs version of the "C" abs function because we are using int64_t
+            // do NOT try to use the std::abs() function as this is C++11 ONLY
+            float dBinX = llabs(m_Bins[3 * j] - m_Bins[3 * i]);
+            float dBinY = llabs(m_Bins[3 * j + 1] - m_Bins[3 * i + 1]);
+            float dBinZ = llabs(m_Bins[3 * j + 2] - m_Bins[3 * i + 2]);
+            if (dBinX < criticalDistance && dBinY < criticalDistance && dBinZ < criticalDistance)
+            {
+              neighborhood.push_back(static_cast<int32_t>(j));
+            }
+          }
+          // The neighbors are listed in Feature order
+          std::sort(neighborhood.begin(), neighborhood.end());
+        }
+        m_Neighborhoods[i] = static_cast<int32_t>(neighborhood.size());
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 
 
 // -----------------------------------------------------------------------------
@@ -241,51 +337,12 @@ void FindNeighborhoods::find_neighborhoods()
     bins[3 * i + 2] = zbin;
   }
 
-  int64_t bin1x = 0, bin2x = 0, bin1y = 0, bin2y = 0, bin1z = 0, bin2z = 0;
-  float dBinX = 0, dBinY = 0, dBinZ = 0;
-  float criticalDistance1 = 0, criticalDistance2 = 0;
-
-  for (size_t i = 1; i < totalFeatures; i++)
-  {
-    if (i % 1000 == 0)
-    {
+  float origin[3] = { m_OriginX, m_OriginY, m_OriginZ };
+  PointGrid grid(m_Centroids, totalFeatures, 1, aveDiam);
+  FindNeighborhoodsImpl finder(&grid, &(bins.front()), &(criticalDistance.front()), origin, aveDiam, m_Neighborhoods, &neighborhoodlist);
 
-      QString ss = QObject::tr("Working on Feature %1 of %2").arg(i).arg(totalFeatures);
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    }
-    x = m_Centroids[3 * i];
-    y = m_Centroids[3 * i + 1];
-    z = m_Centroids[3 * i + 2];
-    bin1x = bins[3 * i];
-    bin1y = bins[3 * i + 1];
-    bin1z = bins[3 * i + 2];
-    criticalDistance1 = criticalDistance[i];
+  ParallelContext::ParallelFor<size_t>(1, totalFeatures, finder);
 
-    for (size_t j = i + 1; j < totalFeatures; j++)
-    {
-      bin2x = bins[3 * j];
-      bin2y = bins[3 * j + 1];
-      bin2z = bins[3 * j + 2];
-      criticalDistance2 = criticalDistance[j];
-      // Use the llabs version of the "C" abs function because we are using int64_t
-      // do NOT try to use the std::abs() function as this is C++11 ONLY
-      dBinX = llabs(bin2x - bin1x);
-      dBinY = llabs(bin2y - bin1y);
-      dBinZ = llabs(bin2z - bin1z);
-
-      if (dBinX < criticalDistance1 && dBinY < criticalDistance1 && dBinZ < criticalDistance1)
-      {
-        m_Neighborhoods[i]++;
-        neighborhoodlist[i].push_back(j);
-      }
-
-      if (dBinX < criticalDistance2 && dBinY < criticalDistance2 && dBinZ < criticalDistance2)
-      {
-        m_Neighborhoods[j]++;
-        neighborhoodlist[j].push_back(i);
-      }
-    }
-  }
   for (size_t i = 1; i < totalFeatures; i++)
   {
     // Set the vector for each list into the NeighborhoodList Object
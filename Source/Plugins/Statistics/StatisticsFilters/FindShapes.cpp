@@ -42,11 +42,114 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Utilities/FeatureReduction.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "Statistics/StatisticsConstants.h"
 
+/**
+ * @brief The MomentsReduction class accumulates the second moments of each Feature about its centroid.
+ * Every cell is split into 8 (4 in 2D) sub-cells offset by a quarter of the resolution; the sum over the
+ * sub-cells is evaluated in closed form since the cross terms of the offsets cancel. The accumulator
+ * holds the cell count followed by the xx, yy, zz, xy, yz, xz moments.
+ */
+class MomentsReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(MomentsReduction)
+    SIMPL_TYPE_MACRO_SUPER(MomentsReduction, FeatureReduction)
+
+    static Pointer New(float* centroids, double scaleFactor, float modRes[3], int32_t planeAxes[2], double* featureMoments, float* volumes)
+    {
+      Pointer sharedPtr(new MomentsReduction(centroids, scaleFactor, modRes, planeAxes, featureMoments, volumes));
+      return sharedPtr;
+    }
+
+    virtual ~MomentsReduction() {}
+
+    virtual int getNumberOfComponents() { return 7; }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      size_t idx[3] = { range.start % range.dims[0], (range.start / range.dims[0]) % range.dims[1], range.start / (range.dims[0] * range.dims[1]) };
+      bool is2D = (m_PlaneAxes[0] >= 0);
+      double a2 = (m_ModRes[0] / 4.0f) * (m_ModRes[0] / 4.0f);
+      double b2 = (m_ModRes[1] / 4.0f) * (m_ModRes[1] / 4.0f);
+      double c2 = (m_ModRes[2] / 4.0f) * (m_ModRes[2] / 4.0f);
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        int32_t gnum = range.featureIds[i];
+        double* acc = accumulator + 7 * static_cast<size_t>(gnum);
+        acc[0] += 1.0;
+        if (is2D == true)
+        {
+          double dx = float(idx[m_PlaneAxes[0]]) * m_ModRes[0] - m_Centroids[gnum * 3 + 0] * m_ScaleFactor;
+          double dy = float(idx[m_PlaneAxes[1]]) * m_ModRes[1] - m_Centroids[gnum * 3 + 1] * m_ScaleFactor;
+          acc[1] += 4.0 * (dy * dy + b2);
+          acc[2] += 4.0 * (dx * dx + a2);
+          acc[3] += 4.0 * (dx * dy);
+        }
+        else
+        {
+          double dx = float(idx[0]) * m_ModRes[0] - m_Centroids[gnum * 3 + 0] * m_ScaleFactor;
+          double dy = float(idx[1]) * m_ModRes[1] - m_Centroids[gnum * 3 + 1] * m_ScaleFactor;
+          double dz = float(idx[2]) * m_ModRes[2] - m_Centroids[gnum * 3 + 2] * m_ScaleFactor;
+          double sx = 8.0 * (dx * dx + a2);
+          double sy = 8.0 * (dy * dy + b2);
+          double sz = 8.0 * (dz * dz + c2);
+          acc[1] += sy + sz;
+          acc[2] += sx + sz;
+          acc[3] += sx + sy;
+          acc[4] += 8.0 * (dx * dy);
+          acc[5] += 8.0 * (dy * dz);
+          acc[6] += 8.0 * (dx * dz);
+        }
+        if (++idx[0] == range.dims[0])
+        {
+          idx[0] = 0;
+          if (++idx[1] == range.dims[1]) { idx[1] = 0; idx[2]++; }
+        }
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      for (size_t i = 0; i < numFeatures; i++)
+      {
+        const double* acc = accumulator + 7 * i;
+        m_Volumes[i] = static_cast<float>(acc[0]);
+        for (size_t j = 0; j < 6; j++)
+        {
+          m_FeatureMoments[6 * i + j] = acc[j + 1];
+        }
+      }
+    }
+
+  protected:
+    MomentsReduction(float* centroids, double scaleFactor, float modRes[3], int32_t planeAxes[2], double* featureMoments, float* volumes) :
+      FeatureReduction(),
+      m_Centroids(centroids),
+      m_ScaleFactor(scaleFactor),
+      m_FeatureMoments(featureMoments),
+      m_Volumes(volumes)
+    {
+      m_ModRes[0] = modRes[0];
+      m_ModRes[1] = modRes[1];
+      m_ModRes[2] = modRes[2];
+      m_PlaneAxes[0] = planeAxes[0];
+      m_PlaneAxes[1] = planeAxes[1];
+    }
+
+  private:
+    float* m_Centroids;
+    double m_ScaleFactor;
+    float m_ModRes[3];
+    int32_t m_PlaneAxes[2];
+    double* m_FeatureMoments;
+    float* m_Volumes;
+};
+
 // Include the MOC generated file for this class
 #include "moc_FindShapes.cpp"
 
@@ -229,7 +332,6 @@ void FindShapes::find_moments()
   float u110 = 0.0f;
   float u011 = 0.0f;
   float u101 = 0.0f;
-  float xx = 0.0f, yy = 0.0f, zz = 0.0f, xy = 0.0f, xz = 0.0f, yz = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
@@ -247,90 +349,17 @@ void FindShapes::find_moments()
   float modYRes = yRes * float(scaleFactor);
   float modZRes = zRes * float(scaleFactor);
 
-  for (size_t i = 0; i < numfeatures; i++)
-  {
-    featuremoments[6 * i + 0] = 0.0f;
-    featuremoments[6 * i + 1] = 0.0f;
-    featuremoments[6 * i + 2] = 0.0f;
-    featuremoments[6 * i + 3] = 0.0f;
-    featuremoments[6 * i + 4] = 0.0f;
-    featuremoments[6 * i + 5] = 0.0f;
-  }
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t dims[3] = { xPoints, yPoints, zPoints };
+  float res[3] = { xRes, yRes, zRes };
+  float modRes[3] = { modXRes, modYRes, modZRes };
+  int32_t planeAxes[2] = { -1, -1 };
+
+  FeatureReductionEngine engine(m_FeatureIds, totalPoints, numfeatures);
+  engine.setDimensions(dims, res);
+  engine.addReduction(MomentsReduction::New(m_Centroids, scaleFactor, modRes, planeAxes, featuremoments, m_Volumes));
+  engine.execute();
 
-  float x = 0.0f, y = 0.0f, z = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f, z1 = 0.0f, z2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f, xdist5 = 0.0f, xdist6 = 0.0f, xdist7 = 0.0f, xdist8 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f, ydist5 = 0.0f, ydist6 = 0.0f, ydist7 = 0.0f, ydist8 = 0.0f;
-  float zdist1 = 0.0f, zdist2 = 0.0f, zdist3 = 0.0f, zdist4 = 0.0f, zdist5 = 0.0f, zdist6 = 0.0f, zdist7 = 0.0f, zdist8 = 0.0f;
-  size_t zStride = 0, yStride = 0;
-  for (size_t i = 0; i < zPoints; i++)
-  {
-    zStride = i * xPoints * yPoints;
-    for (size_t j = 0; j < yPoints; j++)
-    {
-      yStride = j * xPoints;
-      for (size_t k = 0; k < xPoints; k++)
-      {
-        int32_t gnum = m_FeatureIds[zStride + yStride + k];
-        x = float(k * modXRes);
-        y = float(j * modYRes);
-        z = float(i * modZRes);
-        x1 = x + (modXRes / 4.0f);
-        x2 = x - (modXRes / 4.0f);
-        y1 = y + (modYRes / 4.0f);
-        y2 = y - (modYRes / 4.0f);
-        z1 = z + (modZRes / 4.0f);
-        z2 = z - (modZRes / 4.0f);
-        xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist1 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist2 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist2 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist3 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist3 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist3 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist4 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist4 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist5 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist5 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist5 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist6 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist6 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist6 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist7 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist7 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist7 = (z1 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-        xdist8 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-        ydist8 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-        zdist8 = (z2 - (m_Centroids[gnum * 3 + 2] * scaleFactor));
-
-        xx = ((ydist1) * (ydist1)) + ((zdist1) * (zdist1)) + ((ydist2) * (ydist2)) + ((zdist2) * (zdist2)) + ((ydist3) * (ydist3)) + ((zdist3) * (zdist3))
-             + ((ydist4) * (ydist4)) + ((zdist4) * (zdist4)) + ((ydist5) * (ydist5)) + ((zdist5) * (zdist5)) + ((ydist6) * (ydist6)) + ((zdist6) * (zdist6))
-             + ((ydist7) * (ydist7)) + ((zdist7) * (zdist7)) + ((ydist8) * (ydist8)) + ((zdist8) * (zdist8));
-        yy = ((xdist1) * (xdist1)) + ((zdist1) * (zdist1)) + ((xdist2) * (xdist2)) + ((zdist2) * (zdist2)) + ((xdist3) * (xdist3)) + ((zdist3) * (zdist3))
-             + ((xdist4) * (xdist4)) + ((zdist4) * (zdist4)) + ((xdist5) * (xdist5)) + ((zdist5) * (zdist5)) + ((xdist6) * (xdist6)) + ((zdist6) * (zdist6))
-             + ((xdist7) * (xdist7)) + ((zdist7) * (zdist7)) + ((xdist8) * (xdist8)) + ((zdist8) * (zdist8));
-        zz = ((xdist1) * (xdist1)) + ((ydist1) * (ydist1)) + ((xdist2) * (xdist2)) + ((ydist2) * (ydist2)) + ((xdist3) * (xdist3)) + ((ydist3) * (ydist3))
-             + ((xdist4) * (xdist4)) + ((ydist4) * (ydist4)) + ((xdist5) * (xdist5)) + ((ydist5) * (ydist5)) + ((xdist6) * (xdist6)) + ((ydist6) * (ydist6))
-             + ((xdist7) * (xdist7)) + ((ydist7) * (ydist7)) + ((xdist8) * (xdist8)) + ((ydist8) * (ydist8));
-        xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4)) + ((xdist5) * (ydist5)) + ((xdist6) * (ydist6))
-             + ((xdist7) * (ydist7)) + ((xdist8) * (ydist8));
-        yz = ((ydist1) * (zdist1)) + ((ydist2) * (zdist2)) + ((ydist3) * (zdist3)) + ((ydist4) * (zdist4)) + ((ydist5) * (zdist5)) + ((ydist6) * (zdist6))
-             + ((ydist7) * (zdist7)) + ((ydist8) * (zdist8));
-        xz = ((xdist1) * (zdist1)) + ((xdist2) * (zdist2)) + ((xdist3) * (zdist3)) + ((xdist4) * (zdist4)) + ((xdist5) * (zdist5)) + ((xdist6) * (zdist6))
-             + ((xdist7) * (zdist7)) + ((xdist8) * (zdist8));
-
-        featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + xx;
-        featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + yy;
-        featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + zz;
-        featuremoments[gnum * 6 + 3] = featuremoments[gnum * 6 + 3] + xy;
-        featuremoments[gnum * 6 + 4] = featuremoments[gnum * 6 + 4] + yz;
-        featuremoments[gnum * 6 + 5] = featuremoments[gnum * 6 + 5] + xz;
-        m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-      }
-    }
-  }
   double sphere = (2000.0 * M_PI * M_PI) / 9.0;
   // constant for moments because voxels are broken into smaller voxels
   double konst1 =  static_cast<double>((modXRes / 2.0) * (modYRes / 2.0) * (modZRes / 2.0));
@@ -372,77 +401,48 @@ void FindShapes::find_moments2D()
 {
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(m_FeatureIdsArrayPath.getDataContainerName());
 
-  float xx = 0.0f, yy = 0.0f, xy = 0.0f;
   size_t numfeatures = m_CentroidsPtr.lock()->getNumberOfTuples();
   m_FeatureMoments->resize(numfeatures * 6);
   featuremoments = m_FeatureMoments->getPointer(0);
 
-  size_t xPoints = 0, yPoints = 0;
   float xRes = 0.0f, yRes = 0.0f;
+  int32_t planeAxes[2] = { 0, 1 };
 
   if (m->getGeometryAs<ImageGeom>()->getXPoints() == 1)
   {
-    xPoints = m->getGeometryAs<ImageGeom>()->getYPoints();
+    planeAxes[0] = 1;
+    planeAxes[1] = 2;
     xRes = m->getGeometryAs<ImageGeom>()->getYRes();
-    yPoints = m->getGeometryAs<ImageGeom>()->getZPoints();
     yRes = m->getGeometryAs<ImageGeom>()->getZRes();
   }
   if (m->getGeometryAs<ImageGeom>()->getYPoints() == 1)
   {
-    xPoints = m->getGeometryAs<ImageGeom>()->getXPoints();
+    planeAxes[0] = 0;
+    planeAxes[1] = 2;
     xRes = m->getGeometryAs<ImageGeom>()->getXRes();
-    yPoints = m->getGeometryAs<ImageGeom>()->getZPoints();
     yRes = m->getGeometryAs<ImageGeom>()->getZRes();
   }
   if (m->getGeometryAs<ImageGeom>()->getZPoints() == 1)
   {
-    xPoints = m->getGeometryAs<ImageGeom>()->getXPoints();
+    planeAxes[0] = 0;
+    planeAxes[1] = 1;
     xRes = m->getGeometryAs<ImageGeom>()->getXRes();
-    yPoints = m->getGeometryAs<ImageGeom>()->getYPoints();
     yRes = m->getGeometryAs<ImageGeom>()->getYRes();
   }
 
   float modXRes = xRes * scaleFactor;
   float modYRes = yRes * scaleFactor;
 
-  for (size_t i = 0; i < 6 * numfeatures; i++)
-  {
-    featuremoments[i] = 0.0;
-  }
+  size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
+  size_t dims[3] = { m->getGeometryAs<ImageGeom>()->getXPoints(), m->getGeometryAs<ImageGeom>()->getYPoints(), m->getGeometryAs<ImageGeom>()->getZPoints() };
+  float res[3] = { m->getGeometryAs<ImageGeom>()->getXRes(), m->getGeometryAs<ImageGeom>()->getYRes(), m->getGeometryAs<ImageGeom>()->getZRes() };
+  float modRes[3] = { modXRes, modYRes, 0.0f };
+
+  FeatureReductionEngine engine(m_FeatureIds, totalPoints, numfeatures);
+  engine.setDimensions(dims, res);
+  engine.addReduction(MomentsReduction::New(m_Centroids, scaleFactor, modRes, planeAxes, featuremoments, m_Volumes));
+  engine.execute();
 
-  float x = 0.0f, y = 0.0f, x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
-  float xdist1 = 0.0f, xdist2 = 0.0f, xdist3 = 0.0f, xdist4 = 0.0f;
-  float ydist1 = 0.0f, ydist2 = 0.0f, ydist3 = 0.0f, ydist4 = 0.0f;
-  size_t yStride = 0;
-  for (size_t j = 0; j < yPoints; j++)
-  {
-    yStride = j * xPoints;
-    for (size_t k = 0; k < xPoints; k++)
-    {
-      int32_t gnum = m_FeatureIds[yStride + k];
-      x = float(k) * modXRes;
-      y = float(j) * modYRes;
-      x1 = x + (modXRes / 4.0f);
-      x2 = x - (modXRes / 4.0f);
-      y1 = y + (modYRes / 4.0f);
-      y2 = y - (modYRes / 4.0f);
-      xdist1 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-      ydist1 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-      xdist2 = (x1 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-      ydist2 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-      xdist3 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-      ydist3 = (y1 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-      xdist4 = (x2 - (m_Centroids[gnum * 3 + 0] * scaleFactor));
-      ydist4 = (y2 - (m_Centroids[gnum * 3 + 1] * scaleFactor));
-      xx = ((ydist1) * (ydist1)) + ((ydist2) * (ydist2)) + ((ydist3) * (ydist3)) + ((ydist4) * (ydist4));
-      yy = ((xdist1) * (xdist1)) + ((xdist2) * (xdist2)) + ((xdist3) * (xdist3)) + ((xdist4) * (xdist4));
-      xy = ((xdist1) * (ydist1)) + ((xdist2) * (ydist2)) + ((xdist3) * (ydist3)) + ((xdist4) * (ydist4));
-      featuremoments[gnum * 6 + 0] = featuremoments[gnum * 6 + 0] + xx;
-      featuremoments[gnum * 6 + 1] = featuremoments[gnum * 6 + 1] + yy;
-      featuremoments[gnum * 6 + 2] = featuremoments[gnum * 6 + 2] + xy;
-      m_Volumes[gnum] = m_Volumes[gnum] + 1.0;
-    }
-  }
   double konst1 = static_cast<double>((modXRes / 2.0) * (modYRes / 2.0));
   double konst2 = static_cast<double>(xRes * yRes);
   for (size_t i = 1; i < numfeatures; i++)
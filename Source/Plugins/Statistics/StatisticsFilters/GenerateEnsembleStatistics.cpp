@@ -36,6 +36,12 @@
 
 #include "GenerateEnsembleStatistics.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/PhaseType.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -54,11 +60,13 @@
 #include "SIMPLib/StatsData/TransformationStatsData.h"
 #include "SIMPLib/StatsData/BoundaryStatsData.h"
 #include "SIMPLib/StatsData/MatrixStatsData.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "Statistics/DistributionAnalysisOps/BetaOps.h"
+#include "Statistics/DistributionAnalysisOps/DistributionMoments.h"
 #include "Statistics/DistributionAnalysisOps/PowerLawOps.h"
 #include "Statistics/DistributionAnalysisOps/LogNormalOps.h"
 
@@ -70,6 +78,321 @@
 // Include the MOC generated file for this class
 #include "moc_GenerateEnsembleStatistics.cpp"
 
+namespace Detail
+{
+  // Smallest number of Features given to a worker. Each worker keeps its own moments or
+  // histograms, so it needs enough Features to amortize merging them.
+  static const size_t k_MinimumGrainSize = 16384;
+
+  // Every neighbor pair of a Feature needs a misorientation, which is far more work per Feature
+  static const size_t k_MisorientationGrainSize = 1024;
+}
+
+/**
+ * @brief The BinnedMomentsImpl class gathers the moments of one or more Feature values, binned by
+ * phase and by equivalent diameter, in a single pass over the Features. It is used directly as
+ * the body of ParallelContext::ParallelReduce.
+ */
+template<typename T>
+class BinnedMomentsImpl
+{
+    int32_t* m_FeaturePhases;
+    bool* m_BiasedFeatures;
+    float* m_EquivalentDiameters;
+    T* m_Values;
+    size_t m_NumComps;
+    const std::vector<size_t>* m_BinOffsets;
+    const std::vector<float>* m_MinDiams;
+    const std::vector<float>* m_BinSteps;
+    std::vector<DistributionMoments> m_Moments;
+
+  public:
+    BinnedMomentsImpl(int32_t* featurePhases, bool* biasedFeatures, float* equivalentDiameters, T* values, size_t numComps,
+                      const std::vector<size_t>* binOffsets, const std::vector<float>* minDiams, const std::vector<float>* binSteps) :
+      m_FeaturePhases(featurePhases),
+      m_BiasedFeatures(biasedFeatures),
+      m_EquivalentDiameters(equivalentDiameters),
+      m_Values(values),
+      m_NumComps(numComps),
+      m_BinOffsets(binOffsets),
+      m_MinDiams(minDiams),
+      m_BinSteps(binSteps),
+      m_Moments(binOffsets->back() * numComps)
+    {}
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    BinnedMomentsImpl(BinnedMomentsImpl& other, tbb::split) :
+      m_FeaturePhases(other.m_FeaturePhases),
+      m_BiasedFeatures(other.m_BiasedFeatures),
+      m_EquivalentDiameters(other.m_EquivalentDiameters),
+      m_Values(other.m_Values),
+      m_NumComps(other.m_NumComps),
+      m_BinOffsets(other.m_BinOffsets),
+      m_MinDiams(other.m_MinDiams),
+      m_BinSteps(other.m_BinSteps),
+      m_Moments(other.m_Moments.size())
+    {}
+#endif
+
+    virtual ~BinnedMomentsImpl() {}
+
+    void convert(size_t start, size_t end)
+    {
+      size_t totalBins = m_BinOffsets->back();
+      for (size_t i = start; i < end; i++)
+      {
+        if (m_BiasedFeatures[i] == true) { continue; }
+        int32_t phase = m_FeaturePhases[i];
+        size_t offset = (*m_BinOffsets)[phase];
+        size_t numBins = (*m_BinOffsets)[phase + 1] - offset;
+        if (numBins == 0) { continue; }
+        size_t bin = 0;
+        if (numBins > 1)
+        {
+          float position = (m_EquivalentDiameters[i] - (*m_MinDiams)[phase]) / (*m_BinSteps)[phase];
+          if (position > 0.0f) { bin = static_cast<size_t>(position); }
+          if (bin >= numBins) { bin = numBins - 1; }
+        }
+        for (size_t c = 0; c < m_NumComps; c++)
+        {
+          m_Moments[c * totalBins + offset + bin].addValue(static_cast<float>(m_Values[i * m_NumComps + c]));
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r)
+    {
+      convert(r.begin(), r.end());
+    }
+
+    void join(const BinnedMomentsImpl& rhs)
+    {
+      for (size_t i = 0; i < m_Moments.size(); i++)
+      {
+        m_Moments[i].merge(rhs.m_Moments[i]);
+      }
+    }
+#endif
+
+    /**
+     * @brief getMoments Returns the moments of each bin of one phase for one component of the values
+     */
+    std::vector<DistributionMoments> getMoments(size_t comp, size_t phase) const
+    {
+      std::vector<DistributionMoments>::const_iterator begin = m_Moments.begin() + comp * m_BinOffsets->back() + (*m_BinOffsets)[phase];
+      return std::vector<DistributionMoments>(begin, begin + ((*m_BinOffsets)[phase + 1] - (*m_BinOffsets)[phase]));
+    }
+};
+
+/**
+ * @brief The PhaseHistogramImpl class builds one histogram per phase along with the total weight
+ * that went into each phase. The Binner decides which bin and weight each Feature adds. It is used
+ * directly as the body of ParallelContext::ParallelReduce.
+ */
+template<class Binner>
+class PhaseHistogramImpl
+{
+    Binner m_Binner;
+    std::vector<double> m_Histogram;
+    std::vector<double> m_Totals;
+
+  public:
+    PhaseHistogramImpl(const Binner& binner, size_t numBins, size_t numPhases) :
+      m_Binner(binner),
+      m_Histogram(numBins, 0.0),
+      m_Totals(numPhases, 0.0)
+    {}
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    PhaseHistogramImpl(PhaseHistogramImpl& other, tbb::split) :
+      m_Binner(other.m_Binner),
+      m_Histogram(other.m_Histogram.size(), 0.0),
+      m_Totals(other.m_Totals.size(), 0.0)
+    {}
+#endif
+
+    virtual ~PhaseHistogramImpl() {}
+
+    void convert(size_t start, size_t end)
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        m_Binner.binFeature(i, m_Histogram, m_Totals);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r)
+    {
+      convert(r.begin(), r.end());
+    }
+
+    void join(const PhaseHistogramImpl& rhs)
+    {
+      for (size_t i = 0; i < m_Histogram.size(); i++)
+      {
+        m_Histogram[i] += rhs.m_Histogram[i];
+      }
+      for (size_t i = 0; i < m_Totals.size(); i++)
+      {
+        m_Totals[i] += rhs.m_Totals[i];
+      }
+    }
+#endif
+
+    const std::vector<double>& getHistogram() const { return m_Histogram; }
+    const std::vector<double>& getTotals() const { return m_Totals; }
+};
+
+/**
+ * @brief The ODFBinner class adds the volume of each interior Feature to the ODF bin of its orientation
+ */
+class ODFBinner
+{
+    int32_t* m_FeaturePhases;
+    bool* m_SurfaceFeatures;
+    float* m_Volumes;
+    float* m_FeatureEulerAngles;
+    unsigned int* m_CrystalStructures;
+    const std::vector<size_t>* m_BinOffsets;
+    const QVector<SpaceGroupOps::Pointer>* m_OrientationOps;
+
+  public:
+    ODFBinner(int32_t* featurePhases, bool* surfaceFeatures, float* volumes, float* featureEulerAngles, unsigned int* crystalStructures,
+              const std::vector<size_t>* binOffsets, const QVector<SpaceGroupOps::Pointer>* orientationOps) :
+      m_FeaturePhases(featurePhases),
+      m_SurfaceFeatures(surfaceFeatures),
+      m_Volumes(volumes),
+      m_FeatureEulerAngles(featureEulerAngles),
+      m_CrystalStructures(crystalStructures),
+      m_BinOffsets(binOffsets),
+      m_OrientationOps(orientationOps)
+    {}
+
+    void binFeature(size_t i, std::vector<double>& histogram, std::vector<double>& totals)
+    {
+      if (m_SurfaceFeatures[i] == true) { return; }
+      int32_t phase = m_FeaturePhases[i];
+      totals[phase] += m_Volumes[i];
+      if ((*m_BinOffsets)[phase] == (*m_BinOffsets)[phase + 1]) { return; }
+
+      FOrientArrayType eu( &(m_FeatureEulerAngles[3 * i]), 3); // Wrap the pointer
+      FOrientArrayType rod(4);
+      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
+      int32_t bin = (*m_OrientationOps)[m_CrystalStructures[phase]]->getOdfBin(rod);
+      histogram[(*m_BinOffsets)[phase] + bin] += m_Volumes[i];
+    }
+};
+
+/**
+ * @brief The AxisODFBinner class counts each unbiased Feature in the bin of its axis orientation
+ */
+class AxisODFBinner
+{
+    int32_t* m_FeaturePhases;
+    bool* m_BiasedFeatures;
+    float* m_AxisEulerAngles;
+    const std::vector<size_t>* m_BinOffsets;
+    SpaceGroupOps::Pointer m_OrthoOps;
+
+  public:
+    AxisODFBinner(int32_t* featurePhases, bool* biasedFeatures, float* axisEulerAngles,
+                  const std::vector<size_t>* binOffsets, SpaceGroupOps::Pointer orthoOps) :
+      m_FeaturePhases(featurePhases),
+      m_BiasedFeatures(biasedFeatures),
+      m_AxisEulerAngles(axisEulerAngles),
+      m_BinOffsets(binOffsets),
+      m_OrthoOps(orthoOps)
+    {}
+
+    void binFeature(size_t i, std::vector<double>& histogram, std::vector<double>& totals)
+    {
+      if (m_BiasedFeatures[i] == true) { return; }
+      int32_t phase = m_FeaturePhases[i];
+      totals[phase] += 1.0;
+
+      FOrientArrayType rod(4);
+      FOrientTransformsType::eu2ro( FOrientArrayType( &(m_AxisEulerAngles[3 * i]), 3), rod);
+      m_OrthoOps->getODFFZRod(rod);
+      int32_t bin = m_OrthoOps->getOdfBin(rod);
+      histogram[(*m_BinOffsets)[phase] + bin] += 1.0;
+    }
+};
+
+/**
+ * @brief The MDFBinner class adds the shared surface area of each boundary between two Features of
+ * the same crystal structure to the misorientation bin of that boundary
+ */
+class MDFBinner
+{
+    NeighborList<int32_t>* m_NeighborList;
+    NeighborList<float>* m_SharedSurfaceAreaList;
+    QuatF* m_AvgQuats;
+    int32_t* m_FeaturePhases;
+    bool* m_SurfaceFeatures;
+    unsigned int* m_CrystalStructures;
+    const std::vector<size_t>* m_BinOffsets;
+    const QVector<SpaceGroupOps::Pointer>* m_OrientationOps;
+
+  public:
+    MDFBinner(NeighborList<int32_t>* neighborList, NeighborList<float>* sharedSurfaceAreaList, QuatF* avgQuats, int32_t* featurePhases,
+              bool* surfaceFeatures, unsigned int* crystalStructures, const std::vector<size_t>* binOffsets,
+              const QVector<SpaceGroupOps::Pointer>* orientationOps) :
+      m_NeighborList(neighborList),
+      m_SharedSurfaceAreaList(sharedSurfaceAreaList),
+      m_AvgQuats(avgQuats),
+      m_FeaturePhases(featurePhases),
+      m_SurfaceFeatures(surfaceFeatures),
+      m_CrystalStructures(crystalStructures),
+      m_BinOffsets(binOffsets),
+      m_OrientationOps(orientationOps)
+    {}
+
+    void binFeature(size_t i, std::vector<double>& histogram, std::vector<double>& totals)
+    {
+      int32_t phase = m_FeaturePhases[i];
+      size_t offset = (*m_BinOffsets)[phase];
+      if (offset == (*m_BinOffsets)[phase + 1]) { return; }
+
+      NeighborList<int32_t>& neighborlist = *m_NeighborList;
+      NeighborList<float>& neighborsurfacearealist = *m_SharedSurfaceAreaList;
+      SpaceGroupOps::Pointer ops = (*m_OrientationOps)[m_CrystalStructures[phase]];
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      QuatF q1 = QuaternionMathF::New();
+      QuatF q2 = QuaternionMathF::New();
+      QuaternionMathF::Copy(m_AvgQuats[i], q1);
+
+      for (size_t j = 0; j < neighborlist[i].size(); j++)
+      {
+        int32_t nname = neighborlist[i][j];
+        // Each interior boundary is counted once from its lower Feature, so only
+        // those boundaries need a misorientation
+        if (static_cast<size_t>(nname) < i && m_SurfaceFeatures[nname] == false) { continue; }
+        if (m_CrystalStructures[m_FeaturePhases[nname]] != m_CrystalStructures[phase]) { continue; }
+
+        QuaternionMathF::Copy(m_AvgQuats[nname], q2);
+        float w = ops->getMisoQuat(q1, q2, n1, n2, n3);
+        FOrientArrayType rod(4);
+        FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
+        int32_t mbin = ops->getMisoBin(rod);
+        float nsa = neighborsurfacearealist[i][j];
+        histogram[offset + mbin] += nsa;
+        totals[phase] += nsa;
+      }
+    }
+};
+
+/**
+ * @brief reduceFeatures Runs a reduction body over all the Features, splitting them across threads
+ * when there are enough of them
+ */
+template<class Body>
+static void reduceFeatures(Body& body, size_t numfeatures, size_t grainSize)
+{
+  ParallelContext::ParallelReduce<size_t>(1, numfeatures, body, grainSize);
+}
+
 
 
 // -----------------------------------------------------------------------------
@@ -576,7 +899,6 @@ void GenerateEnsembleStatistics::gatherSizeStats()
   float mindiam = 0.0f;
   float totalUnbiasedVolume = 0.0f;
   QVector<VectorOfFloatArray> sizedist;
-  std::vector<std::vector<std::vector<float> > > values;
 
   FloatArrayType::Pointer binnumbers;
   size_t numfeatures = m_EquivalentDiametersPtr.lock()->getNumberOfTuples();
@@ -584,27 +906,32 @@ void GenerateEnsembleStatistics::gatherSizeStats()
 
   std::vector<float> fractions(numensembles, 0.0f);
   sizedist.resize(numensembles);
-  values.resize(numensembles);
 
+  // The sizes of each phase all go into a single bin
+  std::vector<size_t> binOffsets(numensembles + 1, 0);
+  std::vector<float> mindiams(numensembles, 0.0f);
+  std::vector<float> binsteps(numensembles, 1.0f);
   for (size_t i = 1; i < numensembles; i++)
   {
     sizedist[i] = statsDataArray[i]->CreateCorrelatedDistributionArrays(m_SizeDistributionFitType, 1);
-    values[i].resize(1);
+    binOffsets[i + 1] = binOffsets[i] + 1;
   }
 
+  BinnedMomentsImpl<float> moments(m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, m_EquivalentDiameters, 1, &binOffsets, &mindiams, &binsteps);
+  reduceFeatures(moments, numfeatures, Detail::k_MinimumGrainSize);
+
   float vol = 0.0f;
   for (size_t i = 1; i < numfeatures; i++)
   {
-    if (m_BiasedFeatures[i] == false)
-    {
-      values[m_FeaturePhases[i]][0].push_back(m_EquivalentDiameters[i]);
-    }
     vol = (1.0f / 6.0f) * SIMPLib::Constants::k_Pi * m_EquivalentDiameters[i] * m_EquivalentDiameters[i] * m_EquivalentDiameters[i];
     fractions[m_FeaturePhases[i]] = fractions[m_FeaturePhases[i]] + vol;
     totalUnbiasedVolume = totalUnbiasedVolume + vol;
   }
   for (size_t i = 1; i < numensembles; i++)
   {
+    std::vector<DistributionMoments> phaseMoments = moments.getMoments(0, i);
+    maxdiam = phaseMoments[0].getMaximum();
+    mindiam = phaseMoments[0].getMinimum();
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::MatrixPhase)
     {
       MatrixStatsData* pp = MatrixStatsData::SafePointerDownCast(statsDataArray[i].get());
@@ -614,9 +941,8 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
       pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(phaseMoments, sizedist[i]);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
       int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, DREAM3D::StringConstants::BinNumber);
@@ -627,9 +953,8 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
       pp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(phaseMoments, sizedist[i]);
       pp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
       int32_t numbins = int32_t(maxdiam / m_SizeCorrelationResolution) + 1;
       pp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, DREAM3D::StringConstants::BinNumber);
@@ -640,9 +965,8 @@ void GenerateEnsembleStatistics::gatherSizeStats()
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
       tp->setPhaseFraction((fractions[i] / totalUnbiasedVolume));
-      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(values[i], sizedist[i]);
+      m_DistributionAnalysis[m_SizeDistributionFitType]->calculateCorrelatedParameters(phaseMoments, sizedist[i]);
       tp->setFeatureSizeDistribution(sizedist[i]);
-      DistributionAnalysisOps::determineMaxAndMinValues(values[i][0], maxdiam, mindiam);
       int numbins = int(maxdiam / m_SizeCorrelationResolution) + 1;
       tp->setFeatureDiameterInfo(m_SizeCorrelationResolution, maxdiam, mindiam);
       binnumbers = FloatArrayType::CreateArray(numbins, DREAM3D::StringConstants::BinNumber);
@@ -659,11 +983,9 @@ void GenerateEnsembleStatistics::gatherAspectRatioStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   QVector<VectorOfFloatArray> boveras;
   QVector<VectorOfFloatArray> coveras;
-  std::vector<std::vector<std::vector<float> > > bvalues;
-  std::vector<std::vector<std::vector<float> > > cvalues;
+  std::vector<size_t> binOffsets;
   std::vector<float> mindiams;
   std::vector<float> binsteps;
   size_t numfeatures = m_AspectRatiosPtr.lock()->getNumberOfTuples();
@@ -671,19 +993,18 @@ void GenerateEnsembleStatistics::gatherAspectRatioStats()
 
   boveras.resize(numensembles);
   coveras.resize(numensembles);
-  bvalues.resize(numensembles);
-  cvalues.resize(numensembles);
+  binOffsets.resize(numensembles + 1, 0);
   mindiams.resize(numensembles);
   binsteps.resize(numensembles);
   for (size_t i = 1; i < numensembles; i++)
   {
+    binOffsets[i + 1] = binOffsets[i];
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
       boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
       coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + pp->getBinNumbers()->getSize();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
@@ -692,8 +1013,7 @@ void GenerateEnsembleStatistics::gatherAspectRatioStats()
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
       boveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
       coveras[i] = pp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, pp->getBinNumbers()->getSize());
-      bvalues[i].resize(pp->getBinNumbers()->getSize());
-      cvalues[i].resize(pp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + pp->getBinNumbers()->getSize();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
@@ -702,49 +1022,39 @@ void GenerateEnsembleStatistics::gatherAspectRatioStats()
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
       boveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
       coveras[i] = tp->CreateCorrelatedDistributionArrays(m_AspectRatioDistributionFitType, tp->getBinNumbers()->getSize());
-      bvalues[i].resize(tp->getBinNumbers()->getSize());
-      cvalues[i].resize(tp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + tp->getBinNumbers()->getSize();
       mindiams[i] = tp->getMinFeatureDiameter();
       binsteps[i] = tp->getBinStepSize();
     }
   }
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::PrimaryPhase ||
-        m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::PrecipitatePhase ||
-        m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::TransformationPhase)
-    {
-      if (m_BiasedFeatures[i] == false)
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        bvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i]);
-        cvalues[m_FeaturePhases[i]][bin].push_back(m_AspectRatios[2 * i + 1]);
-      }
-    }
-  }
+
+  // Both aspect ratios of a Feature are gathered in the same pass
+  BinnedMomentsImpl<float> moments(m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, m_AspectRatios, 2, &binOffsets, &mindiams, &binsteps);
+  reduceFeatures(moments, numfeatures, Detail::k_MinimumGrainSize);
+
   for (size_t i = 1; i < numensembles; i++)
   {
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), boveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(1, i), coveras[i]);
       pp->setFeatureSize_BOverA(boveras[i]);
       pp->setFeatureSize_COverA(coveras[i]);
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrecipitatePhase)
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), boveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(1, i), coveras[i]);
       pp->setFeatureSize_BOverA(boveras[i]);
       pp->setFeatureSize_COverA(coveras[i]);
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::TransformationPhase)
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(bvalues[i], boveras[i]);
-      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(cvalues[i], coveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), boveras[i]);
+      m_DistributionAnalysis[m_AspectRatioDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(1, i), coveras[i]);
       tp->setFeatureSize_BOverA(boveras[i]);
       tp->setFeatureSize_COverA(coveras[i]);
     }
@@ -758,25 +1068,25 @@ void GenerateEnsembleStatistics::gatherOmega3Stats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   QVector<VectorOfFloatArray> omega3s;
-  std::vector<std::vector<std::vector<float> > > values;
-  QVector<float> mindiams;
-  QVector<float> binsteps;
+  std::vector<size_t> binOffsets;
+  std::vector<float> mindiams;
+  std::vector<float> binsteps;
   size_t numfeatures = m_Omega3sPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
   omega3s.resize(numensembles);
-  values.resize(numensembles);
+  binOffsets.resize(numensembles + 1, 0);
   mindiams.resize(numensembles);
   binsteps.resize(numensembles);
   for (size_t i = 1; i < numensembles; i++)
   {
+    binOffsets[i + 1] = binOffsets[i];
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
       omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + pp->getBinNumbers()->getSize();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
@@ -784,7 +1094,7 @@ void GenerateEnsembleStatistics::gatherOmega3Stats()
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
       omega3s[i] = pp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + pp->getBinNumbers()->getSize();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
@@ -792,42 +1102,33 @@ void GenerateEnsembleStatistics::gatherOmega3Stats()
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
       omega3s[i] = tp->CreateCorrelatedDistributionArrays(m_Omega3DistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + tp->getBinNumbers()->getSize();
       mindiams[i] = tp->getMinFeatureDiameter();
       binsteps[i] = tp->getBinStepSize();
     }
   }
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::PrimaryPhase ||
-        m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::PrecipitatePhase ||
-        m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::TransformationPhase)
-    {
-      if (m_BiasedFeatures[i] == false)
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(m_Omega3s[i]);
-      }
-    }
-  }
+
+  BinnedMomentsImpl<float> moments(m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, m_Omega3s, 1, &binOffsets, &mindiams, &binsteps);
+  reduceFeatures(moments, numfeatures, Detail::k_MinimumGrainSize);
+
   for (size_t i = 1; i < numensembles; i++)
   {
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
+      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), omega3s[i]);
       pp->setFeatureSize_Omegas(omega3s[i]);
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrecipitatePhase)
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
+      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), omega3s[i]);
       pp->setFeatureSize_Omegas(omega3s[i]);
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::TransformationPhase)
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(values[i], omega3s[i]);
+      m_DistributionAnalysis[m_Omega3DistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), omega3s[i]);
       tp->setFeatureSize_Omegas(omega3s[i]);
     }
   }
@@ -840,25 +1141,25 @@ void GenerateEnsembleStatistics::gatherNeighborhoodStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   QVector<VectorOfFloatArray> neighborhoods;
-  std::vector<std::vector<std::vector<float> > > values;
+  std::vector<size_t> binOffsets;
   std::vector<float> mindiams;
   std::vector<float> binsteps;
   size_t numfeatures = m_NeighborhoodsPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
 
   neighborhoods.resize(numensembles);
-  values.resize(numensembles);
+  binOffsets.resize(numensembles + 1, 0);
   mindiams.resize(numensembles);
   binsteps.resize(numensembles);
   for (size_t i = 1; i < numensembles; i++)
   {
+    binOffsets[i + 1] = binOffsets[i];
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
       neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + pp->getBinNumbers()->getSize();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
@@ -866,7 +1167,7 @@ void GenerateEnsembleStatistics::gatherNeighborhoodStats()
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
       neighborhoods[i] = pp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, pp->getBinNumbers()->getSize());
-      values[i].resize(pp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + pp->getBinNumbers()->getSize();
       mindiams[i] = pp->getMinFeatureDiameter();
       binsteps[i] = pp->getBinStepSize();
     }
@@ -874,43 +1175,33 @@ void GenerateEnsembleStatistics::gatherNeighborhoodStats()
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
       neighborhoods[i] = tp->CreateCorrelatedDistributionArrays(m_NeighborhoodDistributionFitType, tp->getBinNumbers()->getSize());
-      values[i].resize(tp->getBinNumbers()->getSize());
+      binOffsets[i + 1] = binOffsets[i] + tp->getBinNumbers()->getSize();
       mindiams[i] = tp->getMinFeatureDiameter();
       binsteps[i] = tp->getBinStepSize();
     }
   }
 
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::PrimaryPhase ||
-        m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::PrecipitatePhase ||
-        m_PhaseTypes[m_FeaturePhases[i]] == DREAM3D::PhaseType::TransformationPhase)
-    {
-      if (m_BiasedFeatures[i] == false)
-      {
-        bin = size_t((m_EquivalentDiameters[i] - mindiams[m_FeaturePhases[i]]) / binsteps[m_FeaturePhases[i]]);
-        values[m_FeaturePhases[i]][bin].push_back(static_cast<float>( m_Neighborhoods[i] ));
-      }
-    }
-  }
+  BinnedMomentsImpl<int32_t> moments(m_FeaturePhases, m_BiasedFeatures, m_EquivalentDiameters, m_Neighborhoods, 1, &binOffsets, &mindiams, &binsteps);
+  reduceFeatures(moments, numfeatures, Detail::k_MinimumGrainSize);
+
   for (size_t i = 1; i < numensembles; i++)
   {
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
+      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), neighborhoods[i]);
       pp->setFeatureSize_Neighbors(neighborhoods[i]);
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrecipitatePhase)
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
+      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), neighborhoods[i]);
       pp->setFeatureSize_Clustering(neighborhoods[i]);
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::TransformationPhase)
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
-      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(values[i], neighborhoods[i]);
+      m_DistributionAnalysis[m_NeighborhoodDistributionFitType]->calculateCorrelatedParameters(moments.getMoments(0, i), neighborhoods[i]);
       tp->setFeatureSize_Neighbors(neighborhoods[i]);
     }
   }
@@ -923,55 +1214,43 @@ void GenerateEnsembleStatistics::gatherODFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  size_t bin = 0;
   size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  int32_t phase = 0;
-  std::vector<float> totalvol;
   std::vector<FloatArrayType::Pointer> eulerodf;
+  std::vector<size_t> binOffsets;
 
-  totalvol.resize(numensembles);
   eulerodf.resize(numensembles);
+  binOffsets.resize(numensembles + 1, 0);
   uint64_t dims = 0;
   for (size_t i = 1; i < numensembles; i++)
   {
-    totalvol[i] = 0;
+    dims = 0;
     if (m_CrystalStructures[i] == Ebsd::CrystalStructure::Hexagonal_High)
     {
       dims = 36 * 36 * 12;
       eulerodf[i] = FloatArrayType::CreateArray(dims, DREAM3D::StringConstants::ODF);
-      for (uint64_t j = 0; j < dims; j++)
-      {
-        eulerodf[i]->setValue(j, 0.0);
-      }
     }
     else if (m_CrystalStructures[i] == Ebsd::CrystalStructure::Cubic_High)
     {
       dims = 18 * 18 * 18;
       eulerodf[i] = FloatArrayType::CreateArray(dims, DREAM3D::StringConstants::ODF);
-      for (uint64_t j = 0; j < dims; j++)
-      {
-        eulerodf[i]->setValue(j, 0.0);
-      }
-    }
-  }
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_SurfaceFeatures[i] == false)
-    {
-      totalvol[m_FeaturePhases[i]] = totalvol[m_FeaturePhases[i]] + m_Volumes[i];
     }
+    binOffsets[i + 1] = binOffsets[i] + dims;
   }
-  for (size_t i = 1; i < numfeatures; i++)
+
+  ODFBinner binner(m_FeaturePhases, m_SurfaceFeatures, m_Volumes, m_FeatureEulerAngles, m_CrystalStructures, &binOffsets, &m_OrientationOps);
+  PhaseHistogramImpl<ODFBinner> histogram(binner, binOffsets.back(), numensembles);
+  reduceFeatures(histogram, numfeatures, Detail::k_MinimumGrainSize);
+
+  const std::vector<double>& volumes = histogram.getHistogram();
+  const std::vector<double>& totalvol = histogram.getTotals();
+  for (size_t i = 1; i < numensembles; i++)
   {
-    if (m_SurfaceFeatures[i] == false)
+    if (NULL == eulerodf[i].get()) { continue; }
+    for (size_t j = 0; j < eulerodf[i]->getNumberOfTuples(); j++)
     {
-      phase = m_CrystalStructures[m_FeaturePhases[i]];
-      FOrientArrayType eu( &(m_FeatureEulerAngles[3 * i]), 3); // Wrap the pointer
-      FOrientArrayType rod(4);
-      OrientationTransforms<FOrientArrayType, float>::eu2ro(eu, rod);
-      bin = m_OrientationOps[phase]->getOdfBin(rod);
-      eulerodf[m_FeaturePhases[i]]->setValue(bin, (eulerodf[m_FeaturePhases[i]]->getValue(bin) + (m_Volumes[i] / totalvol[m_FeaturePhases[i]])));
+      double volume = volumes[binOffsets[i] + j];
+      eulerodf[i]->setValue(j, (volume > 0.0) ? static_cast<float>(volume / totalvol[i]) : 0.0f);
     }
   }
   for (size_t i = 1; i < numensembles; i++)
@@ -1001,32 +1280,19 @@ void GenerateEnsembleStatistics::gatherMDFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  // But since a pointer is difficult to use operators with we will now create a
-  // reference variable to the pointer with the correct variable name that allows
-  // us to use the same syntax as the "vector of vectors"
-  NeighborList<int32_t>& neighborlist = *(m_NeighborList.lock());
-  // And we do the same for the SharedSurfaceArea list
-  NeighborList<float>& neighborsurfacearealist = *(m_SharedSurfaceAreaList.lock());
-
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  int32_t mbin = 0;
-  float w = 0.0f;
-  QuatF q1 = QuaternionMathF::New();
-  QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
   size_t numfeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
   size_t numensembles = m_PhaseTypesPtr.lock()->getNumberOfTuples();
-  uint32_t phase1 = 0, phase2 = 0;
-  QVector<float> totalSurfaceArea;
   QVector<FloatArrayType::Pointer> misobin;
+  std::vector<size_t> binOffsets;
   int32_t numbins = 0;
 
   misobin.resize(numensembles);
-  totalSurfaceArea.resize(numensembles);
+  binOffsets.resize(numensembles + 1, 0);
   for (size_t i = 1; i < numensembles; ++i)
   {
-    totalSurfaceArea[i] = 0;
+    numbins = 0;
     if (Ebsd::CrystalStructure::Hexagonal_High == m_CrystalStructures[i] )
     {
       numbins = 36 * 36 * 12;
@@ -1037,64 +1303,43 @@ void GenerateEnsembleStatistics::gatherMDFStats()
       numbins = 18 * 18 * 18;
       misobin[i] = FloatArrayType::CreateArray(numbins, DREAM3D::StringConstants::MisorientationBins);
     }
-    // Now initialize all bins to 0.0
-    for (int32_t j = 0; j < numbins; j++)
-    {
-      misobin[i]->setValue(j, 0.0);
-    }
+    binOffsets[i + 1] = binOffsets[i] + numbins;
   }
-  int32_t nname = 0;
-  float nsa = 0.0f;
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    QuaternionMathF::Copy(avgQuats[i], q1);
-    phase1 = m_CrystalStructures[m_FeaturePhases[i]];
-    for (size_t j = 0; j < neighborlist[i].size(); j++)
-    {
-      w = 10000.0f;
-      nname = neighborlist[i][j];
-      QuaternionMathF::Copy(avgQuats[nname], q2);
-      phase2 = m_CrystalStructures[m_FeaturePhases[nname]];
-      if (phase1 == phase2) { w = m_OrientationOps[phase1]->getMisoQuat( q1, q2, n1, n2, n3); }
-      if (phase1 == phase2)
-      {
-        FOrientArrayType rod(4);
-        FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
 
-        if ((nname > i || m_SurfaceFeatures[nname] == true))
-        {
-          mbin = m_OrientationOps[phase1]->getMisoBin(rod);
-          nsa = neighborsurfacearealist[i][j];
-          misobin[m_FeaturePhases[i]]->setValue(mbin, (misobin[m_FeaturePhases[i]]->getValue(mbin) + nsa));
-          totalSurfaceArea[m_FeaturePhases[i]] = totalSurfaceArea[m_FeaturePhases[i]] + nsa;
-        }
-      }
-    }
-  }
+  MDFBinner binner(m_NeighborList.lock().get(), m_SharedSurfaceAreaList.lock().get(), avgQuats, m_FeaturePhases, m_SurfaceFeatures,
+                   m_CrystalStructures, &binOffsets, &m_OrientationOps);
+  PhaseHistogramImpl<MDFBinner> histogram(binner, binOffsets.back(), numensembles);
+  reduceFeatures(histogram, numfeatures, Detail::k_MisorientationGrainSize);
 
+  const std::vector<double>& areas = histogram.getHistogram();
+  const std::vector<double>& totalSurfaceArea = histogram.getTotals();
   for (size_t i = 1; i < numensembles; i++)
   {
-    for (size_t j = 0; j < misobin[i]->getSize(); j++)
+    if (NULL != misobin[i].get())
     {
-      misobin[i]->setValue(j, (misobin[i]->getValue(j) / totalSurfaceArea[i]));
+      for (size_t j = 0; j < misobin[i]->getSize(); j++)
+      {
+        double area = areas[binOffsets[i] + j];
+        misobin[i]->setValue(j, (area > 0.0) ? static_cast<float>(area / totalSurfaceArea[i]) : 0.0f);
+      }
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
       pp->setMisorientationBins(misobin[i]);
-      pp->setBoundaryArea(totalSurfaceArea[i]);
+      pp->setBoundaryArea(static_cast<float>(totalSurfaceArea[i]));
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrecipitatePhase)
     {
       PrecipitateStatsData* pp = PrecipitateStatsData::SafePointerDownCast(statsDataArray[i].get());
       pp->setMisorientationBins(misobin[i]);
-      pp->setBoundaryArea(totalSurfaceArea[i]);
+      pp->setBoundaryArea(static_cast<float>(totalSurfaceArea[i]));
     }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::TransformationPhase)
     {
       TransformationStatsData* tp = TransformationStatsData::SafePointerDownCast(statsDataArray[i].get());
       tp->setMisorientationBins(misobin[i]);
-      tp->setBoundaryArea(totalSurfaceArea[i]);
+      tp->setBoundaryArea(static_cast<float>(totalSurfaceArea[i]));
     }
   }
 }
@@ -1106,43 +1351,31 @@ void GenerateEnsembleStatistics::gatherAxisODFStats()
 {
   StatsDataArray& statsDataArray = *(m_StatsDataArray);
 
-  int32_t bin = 0;
   QVector<FloatArrayType::Pointer> axisodf;
-  QVector<float> totalaxes;
+  std::vector<size_t> binOffsets;
   size_t numfeatures = m_AxisEulerAnglesPtr.lock()->getNumberOfTuples();
   size_t numXTals = m_PhaseTypesPtr.lock()->getNumberOfTuples();
   axisodf.resize(numXTals);
-  totalaxes.resize(numXTals);
+  binOffsets.resize(numXTals + 1, 0);
   for (size_t i = 1; i < numXTals; i++)
   {
-    totalaxes[i] = 0.0;
     axisodf[i] = FloatArrayType::CreateArray((36 * 36 * 36), DREAM3D::StringConstants::AxisOrientation);
-    for (int32_t j = 0; j < (36 * 36 * 36); j++)
-    {
-      axisodf[i]->setValue(j, 0.0);
-    }
-  }
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_BiasedFeatures[i] == false)
-    {
-      totalaxes[m_FeaturePhases[i]]++;
-    }
-  }
-  for (size_t i = 1; i < numfeatures; i++)
-  {
-    if (m_BiasedFeatures[i] == false)
-    {
-      FOrientArrayType rod(4);
-      FOrientTransformsType::eu2ro( FOrientArrayType( &(m_AxisEulerAngles[3 * i]), 3), rod);
-      m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getODFFZRod(rod);
-      bin = m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]->getOdfBin(rod);
-      axisodf[m_FeaturePhases[i]]->setValue(bin, (axisodf[m_FeaturePhases[i]]->getValue(bin) + static_cast<float>((1.0 / totalaxes[m_FeaturePhases[i]]))));
-    }
+    binOffsets[i + 1] = binOffsets[i] + (36 * 36 * 36);
   }
 
+  AxisODFBinner binner(m_FeaturePhases, m_BiasedFeatures, m_AxisEulerAngles, &binOffsets, m_OrientationOps[Ebsd::CrystalStructure::OrthoRhombic]);
+  PhaseHistogramImpl<AxisODFBinner> histogram(binner, binOffsets.back(), numXTals);
+  reduceFeatures(histogram, numfeatures, Detail::k_MinimumGrainSize);
+
+  const std::vector<double>& counts = histogram.getHistogram();
+  const std::vector<double>& totalaxes = histogram.getTotals();
   for (size_t i = 1; i < numXTals; i++)
   {
+    for (int32_t j = 0; j < (36 * 36 * 36); j++)
+    {
+      double count = counts[binOffsets[i] + j];
+      axisodf[i]->setValue(j, (count > 0.0) ? static_cast<float>(count / totalaxes[i]) : 0.0f);
+    }
     if (m_PhaseTypes[i] == DREAM3D::PhaseType::PrimaryPhase)
     {
       PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[i].get());
@@ -0,0 +1,274 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "DistributionAnalysisOps/BetaOps.h"
+#include "DistributionAnalysisOps/DistributionMoments.h"
+#include "DistributionAnalysisOps/LogNormalOps.h"
+#include "DistributionAnalysisOps/PowerLawOps.h"
+
+namespace
+{
+  /**
+   * @brief randomValue Returns a value between low and high on a fine step
+   */
+  float randomValue(float low, float high)
+  {
+    return low + (high - low) * static_cast<float>(rand() % 10001) / 10000.0f;
+  }
+
+  std::vector<float> randomValues(size_t count, float low, float high)
+  {
+    std::vector<float> values(count, 0.0f);
+    for (size_t i = 0; i < count; i++)
+    {
+      values[i] = randomValue(low, high);
+    }
+    return values;
+  }
+
+  double relativeDifference(double value, double expected)
+  {
+    return fabs(value - expected) / std::max(1.0, fabs(expected));
+  }
+
+  /**
+   * @brief checkMoments Compares the moments against a two pass computation over the samples
+   */
+  void checkMoments(const DistributionMoments& moments, const std::vector<float>& values, bool checkLogs)
+  {
+    DREAM3D_REQUIRE_EQUAL(moments.getCount(), values.size())
+    DREAM3D_REQUIRE_EQUAL(moments.getFirstValue(), values.front())
+    DREAM3D_REQUIRE_EQUAL(moments.getMinimum(), *std::min_element(values.begin(), values.end()))
+    DREAM3D_REQUIRE_EQUAL(moments.getMaximum(), *std::max_element(values.begin(), values.end()))
+
+    double n = static_cast<double>(values.size());
+    double mean = 0.0, logMean = 0.0;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      mean += values[i];
+      if (checkLogs) { logMean += log(static_cast<double>(values[i])); }
+    }
+    mean /= n;
+    logMean /= n;
+    double variance = 0.0, logVariance = 0.0;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      variance += (values[i] - mean) * (values[i] - mean);
+      if (checkLogs) { logVariance += (log(static_cast<double>(values[i])) - logMean) * (log(static_cast<double>(values[i])) - logMean); }
+    }
+    variance /= n;
+    logVariance /= n;
+
+    DREAM3D_REQUIRED(relativeDifference(moments.getMean(), mean), <, 1.0e-9)
+    DREAM3D_REQUIRED(relativeDifference(moments.getVariance(), variance), <, 1.0e-9)
+    if (checkLogs)
+    {
+      DREAM3D_REQUIRED(relativeDifference(moments.getLogMean(), logMean), <, 1.0e-9)
+      DREAM3D_REQUIRED(relativeDifference(moments.getLogVariance(), logVariance), <, 1.0e-9)
+    }
+  }
+
+  DistributionMoments addValues(const std::vector<float>& values, size_t start, size_t end)
+  {
+    DistributionMoments moments;
+    for (size_t i = start; i < end; i++)
+    {
+      moments.addValue(values[i]);
+    }
+    return moments;
+  }
+
+  VectorOfFloatArray createOutputs(size_t numBins)
+  {
+    VectorOfFloatArray outputs;
+    outputs.push_back(FloatArrayType::CreateArray(numBins, "Param1"));
+    outputs.push_back(FloatArrayType::CreateArray(numBins, "Param2"));
+    outputs[0]->initializeWithValue(-1.0f);
+    outputs[1]->initializeWithValue(-1.0f);
+    return outputs;
+  }
+
+  /**
+   * @brief createBins Creates bins of samples with no, one, two, a few and many samples, plus a bin
+   * where every sample is the same
+   */
+  std::vector<std::vector<float> > createBins(float low, float high)
+  {
+    const size_t sizes[6] = { 0, 1, 2, 7, 500, 3000 };
+    std::vector<std::vector<float> > bins;
+    for (size_t b = 0; b < 6; b++)
+    {
+      bins.push_back(randomValues(sizes[b], low, high));
+    }
+    bins.push_back(std::vector<float>(40, 0.5f * (low + high)));
+    return bins;
+  }
+
+  /**
+   * @brief checkFit Fits the bins from their samples and from their moments and compares the parameters.
+   * The sample fits accumulate in single precision, so they only agree to a relative tolerance.
+   */
+  void checkFit(DistributionAnalysisOps::Pointer ops, const std::vector<std::vector<float> >& bins, bool oneBinAtATime)
+  {
+    size_t numBins = bins.size();
+    std::vector<DistributionMoments> moments(numBins);
+    for (size_t b = 0; b < numBins; b++)
+    {
+      moments[b] = addValues(bins[b], 0, bins[b].size());
+    }
+    VectorOfFloatArray fromMoments = createOutputs(numBins);
+    DREAM3D_REQUIRE_EQUAL(ops->calculateCorrelatedParameters(moments, fromMoments), 0)
+
+    VectorOfFloatArray fromSamples = createOutputs(numBins);
+    if (oneBinAtATime)
+    {
+      for (size_t b = 0; b < numBins; b++)
+      {
+        std::vector<std::vector<float> > bin(1, bins[b]);
+        VectorOfFloatArray outputs = createOutputs(1);
+        DREAM3D_REQUIRE_EQUAL(ops->calculateCorrelatedParameters(bin, outputs), 0)
+        fromSamples[0]->setValue(b, outputs[0]->getValue(0));
+        fromSamples[1]->setValue(b, outputs[1]->getValue(0));
+      }
+    }
+    else
+    {
+      std::vector<std::vector<float> > samples(bins);
+      DREAM3D_REQUIRE_EQUAL(ops->calculateCorrelatedParameters(samples, fromSamples), 0)
+    }
+
+    for (size_t b = 0; b < numBins; b++)
+    {
+      DREAM3D_REQUIRED(relativeDifference(fromMoments[0]->getValue(b), fromSamples[0]->getValue(b)), <, 1.0e-3)
+      DREAM3D_REQUIRED(relativeDifference(fromMoments[1]->getValue(b), fromSamples[1]->getValue(b)), <, 1.0e-3)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMoments()
+{
+  srand(5489);
+
+  std::vector<float> positive = randomValues(5000, 0.5f, 10.0f);
+  checkMoments(addValues(positive, 0, positive.size()), positive, true);
+
+  // The maximum of values that are all negative must not be stuck at the starting value
+  std::vector<float> negative = randomValues(300, -10.0f, -0.5f);
+  checkMoments(addValues(negative, 0, negative.size()), negative, false);
+
+  std::vector<float> single(1, 3.0f);
+  DistributionMoments singleMoments = addValues(single, 0, 1);
+  checkMoments(singleMoments, single, true);
+  DREAM3D_REQUIRE_EQUAL(singleMoments.getVariance(), 0.0)
+  DREAM3D_REQUIRE_EQUAL(singleMoments.getLogVariance(), 0.0)
+
+  DistributionMoments empty;
+  DREAM3D_REQUIRE_EQUAL(empty.getCount(), 0)
+  DREAM3D_REQUIRE_EQUAL(empty.getVariance(), 0.0)
+  DREAM3D_REQUIRE_EQUAL(empty.getLogVariance(), 0.0)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestMerge()
+{
+  srand(1234);
+
+  std::vector<float> values = randomValues(4000, 0.5f, 10.0f);
+
+  // Uneven pieces, including empty ones, merged in order as the threads' moments would be
+  const size_t cuts[8] = { 0, 0, 13, 14, 1500, 1500, 3999, 4000 };
+  DistributionMoments merged;
+  merged.merge(DistributionMoments());
+  DREAM3D_REQUIRE_EQUAL(merged.getCount(), 0)
+  for (size_t c = 0; c + 1 < 8; c++)
+  {
+    merged.merge(addValues(values, cuts[c], cuts[c + 1]));
+  }
+  checkMoments(merged, values, true);
+
+  // Merging an empty set changes nothing
+  merged.merge(DistributionMoments());
+  checkMoments(merged, values, true);
+
+  std::vector<float> negative = randomValues(200, -10.0f, -0.5f);
+  DistributionMoments negativeMerged;
+  negativeMerged.merge(addValues(negative, 0, 100));
+  negativeMerged.merge(addValues(negative, 100, 200));
+  checkMoments(negativeMerged, negative, false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFits()
+{
+  srand(42);
+
+  checkFit(BetaOps::New(), createBins(0.05f, 0.95f), false);
+  checkFit(LogNormalOps::New(), createBins(1.0f, 20.0f), false);
+  // The sample fit of the power law carries alpha over from one bin to the next, so it is given one bin at a time
+  checkFit(PowerLawOps::New(), createBins(1.0f, 20.0f), true);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestMoments() )
+  DREAM3D_REGISTER_TEST( TestMerge() )
+  DREAM3D_REGISTER_TEST( TestFits() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
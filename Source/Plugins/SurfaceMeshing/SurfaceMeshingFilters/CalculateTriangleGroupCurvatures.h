@@ -33,60 +33,94 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
-
 #ifndef _CalculateTriangleGroupCurvatures_H_
 #define _CalculateTriangleGroupCurvatures_H_
 
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
+#include <Eigen/Dense>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
 #include "SIMPLib/Common/AbstractFilter.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+
 /**
- * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a group of triangles
- * where each triangle in the group will have the 2 Principal Curvature values computed and optionally
+ * @brief The CalculateTriangleGroupCurvatures class calculates the curvature values for a list of triangles
+ * where each triangle in the list will have the 2 Principal Curvature values computed and optionally
  * the 2 Principal Directions and optionally the Mean and Gaussian Curvature computed.
+ *
+ * The triangles are independent of each other, so any range of the list can be computed by any thread. All
+ * copies of an instance share one set of per-thread working buffers that are reused from triangle to triangle.
  */
 class CalculateTriangleGroupCurvatures
 {
   public:
-    CalculateTriangleGroupCurvatures(int64_t nring,
-                                     std::vector<int64_t> triangleIds, bool useNormalsForCurveFitting,
+    CalculateTriangleGroupCurvatures(FindNRingNeighbors::Pointer nRingNeighbors,
+                                     const int64_t* triangleIds, bool useNormalsForCurveFitting,
                                      DoubleArrayType::Pointer principleCurvature1,
                                      DoubleArrayType::Pointer principleCurvature2,
                                      DoubleArrayType::Pointer principleDirection1,
                                      DoubleArrayType::Pointer principleDirection2,
                                      DoubleArrayType::Pointer gaussianCurvature,
                                      DoubleArrayType::Pointer meanCurvature,
-                                     TriangleGeom::Pointer trianglesGeom,
-                                     DataArray<int32_t>::Pointer surfaceMeshFaceLabels,
                                      DataArray<double>::Pointer surfaceMeshFaceNormals,
                                      DataArray<double>::Pointer surfaceMeshTriangleCentroids,
                                      AbstractFilter* parent);
 
     virtual ~CalculateTriangleGroupCurvatures();
 
-    void operator()() const;
+    /**
+     * @brief convert Computes the curvatures of the triangles at positions [start, end) of the triangle list
+     */
+    void convert(size_t start, size_t end) const;
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const;
+#endif
 
-    typedef std::set<int64_t> UniqueFaceIds_t;
+    /**
+     * @brief The Scratch struct holds the working memory of one thread
+     */
+    struct Scratch
+    {
+      FindNRingNeighbors::Scratch nRing;
+      std::vector<int64_t> triPatch;
+      std::vector<double> patchCentroids;
+      std::vector<double> patchNormals;
+      Eigen::MatrixXd A;
+      Eigen::VectorXd b;
+    };
 
   protected:
     CalculateTriangleGroupCurvatures();
 
     /**
      * @brief extractPatchData Extracts out the needed data values from the global arrays
-     * @param triId The seed triangle Id
-     * @param triPatch The group of triangles being used
+     * @param triPatch The group of triangles being used, seed triangle first
      * @param data The data to extract from
-     * @param name The name of the data array being used
-     * @return Shared pointer to the extracted data
+     * @param extractedData Receives 3 values per triangle of the patch
+     */
+    void extractPatchData(const std::vector<int64_t>& triPatch, const double* data, std::vector<double>& extractedData) const;
+
+    /**
+     * @brief computeCurvatures Fits a quadratic surface to the patch of a triangle and stores its curvatures
+     * @param triId The seed triangle Id
+     * @param scratch Working memory holding the patch data
      */
-    DataArray<double>::Pointer extractPatchData(int64_t triId, UniqueFaceIds_t& triPatch,
-                                                double* data,
-                                                const QString& name) const;
+    void computeCurvatures(int64_t triId, Scratch& scratch) const;
 
   private:
-    int64_t m_NRing;
-    std::vector<int64_t> m_TriangleIds;
+    FindNRingNeighbors::Pointer m_NRingNeighbors;
+    const int64_t* m_TriangleIds;
     bool m_UseNormalsForCurveFitting;
     DoubleArrayType::Pointer m_PrincipleCurvature1;
     DoubleArrayType::Pointer m_PrincipleCurvature2;
@@ -94,11 +128,14 @@ class CalculateTriangleGroupCurvatures
     DoubleArrayType::Pointer m_PrincipleDirection2;
     DoubleArrayType::Pointer m_GaussianCurvature;
     DoubleArrayType::Pointer m_MeanCurvature;
-    TriangleGeom::Pointer m_TrianglesPtr;
-    DataArray<int32_t>::Pointer m_SurfaceMeshFaceLabels;
     DataArray<double>::Pointer m_SurfaceMeshFaceNormals;
     DataArray<double>::Pointer m_SurfaceMeshTriangleCentroids;
     AbstractFilter* m_ParentFilter;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    boost::shared_ptr<tbb::enumerable_thread_specific<Scratch> > m_Scratch;
+#else
+    boost::shared_ptr<Scratch> m_Scratch;
+#endif
 };
 
 #endif /* _CalculateTriangleGroupCurvatures_H_ */
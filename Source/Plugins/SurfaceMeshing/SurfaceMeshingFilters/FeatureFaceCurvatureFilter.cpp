@@ -34,10 +34,12 @@
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 #include "FeatureFaceCurvatureFilter.h"
 
+#include <algorithm>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-#include <tbb/task_scheduler_init.h>
-#include <tbb/task_group.h>
-#include <tbb/task.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
 #endif
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -48,6 +50,11 @@
 #include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
 
 #include "CalculateTriangleGroupCurvatures.h"
 
@@ -321,98 +328,45 @@ void FeatureFaceCurvatureFilter::execute()
   // Just to double check we have everything.
   int64_t numTriangles = triangleGeom->getNumberOfTris();
 
-  // Make sure the Face Connectivity is created because the FindNRing algorithm needs this and will
-  // assert if the data is NOT in the SurfaceMesh Data Container
-  ElementDynamicList::Pointer vertLinks = triangleGeom->getElementsContainingVert();
-  if (NULL == vertLinks.get())
-  {
-    triangleGeom->findElementsContainingVert();
-  }
-
-  // get the QMap from the SharedFeatureFaces filter
-  SharedFeatureFaces_t sharedFeatureFaces;
-
-  int32_t maxFaceId = 0;
-  for (int64_t t = 0; t < numTriangles; ++t)
-  {
-    if (m_SurfaceMeshFeatureFaceIds[t] > maxFaceId) { maxFaceId = m_SurfaceMeshFeatureFaceIds[t]; }
-  }
-  std::vector<int32_t> faceSizes(maxFaceId + 1, 0);
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for (int64_t t = 0; t < numTriangles; ++t)
-  {
-    faceSizes[m_SurfaceMeshFeatureFaceIds[t]]++;
-  }
+  // Group the triangles by the Feature Face Ids from the SharedFeatureFaces filter
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceIds(m_SurfaceMeshFeatureFaceIds, m_SurfaceMeshFaceLabels, numTriangles);
 
-  // Allocate all the vectors that we need
-  for (size_t iter = 0; iter < faceSizes.size(); ++iter)
+  // Build the triangle adjacency within each feature face that the N ring patches are grown from
+  notifyStatusMessage(getMessagePrefix(), getHumanLabel(), "Finding Triangle Neighbors");
+  FindNRingNeighbors::Pointer nRingNeighbors = FindNRingNeighbors::New();
+  nRingNeighbors->setRing(m_NRing);
+  int32_t err = nRingNeighbors->initialize(triangleGeom, faceIndex);
+  if (err < 0)
   {
-    FaceIds_t v;
-    v.reserve(faceSizes[iter]);
-    sharedFeatureFaces[iter] = v;
+    setErrorCondition(-1000);
+    notifyErrorMessage(getHumanLabel(), "Error finding the triangles that contain each vertex", getErrorCondition());
+    return;
   }
 
-  // Loop through all the Triangles and assign each one to a unique Feature Face Id.
-  for(int64_t t = 0; t < numTriangles; ++t)
+  // Every triangle is computed independently, so the triangles are handed out in batches of equal size
+  // instead of one task per feature face, which keeps the threads balanced no matter how the face sizes
+  // vary. The triangles are taken in face order so each thread walks one face at a time
+  const int64_t* triangleIds = faceIndex->getTriangles(0);
+  size_t totalTriangles = static_cast<size_t>(faceIndex->getNumberOfGroupedTriangles());
+  CalculateTriangleGroupCurvatures curvature(nRingNeighbors, triangleIds, m_UseNormalsForCurveFitting,
+                                             m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
+                                             m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(),
+                                             m_SurfaceMeshGaussianCurvaturesPtr.lock(), m_SurfaceMeshMeanCurvaturesPtr.lock(),
+                                             m_SurfaceMeshFaceNormalsPtr.lock(),
+                                             m_SurfaceMeshTriangleCentroidsPtr.lock(),
+                                             this );
+
+  const size_t batchSize = 65536;
+  for (size_t start = 0; start < totalTriangles; start += batchSize)
   {
-    sharedFeatureFaces[m_SurfaceMeshFeatureFaceIds[t]].push_back(t);
-  }
-
-  m_TotalFeatureFaces = sharedFeatureFaces.size();
-  m_CompletedFeatureFaces = 0;
-
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
-#endif
-
-
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_group* g = new tbb::task_group;
-#else
-
-#endif
-  // typedef here for conveneince
-  typedef SharedFeatureFaces_t::iterator SharedFeatureFaceIterator_t;
+    size_t end = std::min(start + batchSize, totalTriangles);
+    ParallelContext::ParallelFor<size_t>(start, end, curvature);
+    if (getCancel() == true) { return; }
 
-  for(SharedFeatureFaceIterator_t iter = sharedFeatureFaces.begin(); iter != sharedFeatureFaces.end(); ++iter)
-  {
-    QString ss = QObject::tr("Working on Face Id %1/%2").arg((*iter).first).arg(maxFaceId);
+    QString ss = QObject::tr("%1/%2 Triangles Complete").arg(end).arg(totalTriangles);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-
-    FaceIds_t& triangleIds = (*iter).second;
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if (doParallel == true)
-    {
-      g->run(CalculateTriangleGroupCurvatures(m_NRing, triangleIds, m_UseNormalsForCurveFitting,
-                                              m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                              m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(),
-                                              m_SurfaceMeshGaussianCurvaturesPtr.lock(), m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom,
-                                              m_SurfaceMeshFaceLabelsPtr.lock(),
-                                              m_SurfaceMeshFaceNormalsPtr.lock(),
-                                              m_SurfaceMeshTriangleCentroidsPtr.lock(),
-                                              this ) );
-    }
-    else
-#endif
-    {
-      CalculateTriangleGroupCurvatures curvature(m_NRing, triangleIds, m_UseNormalsForCurveFitting,
-                                                 m_SurfaceMeshPrincipalCurvature1sPtr.lock(), m_SurfaceMeshPrincipalCurvature2sPtr.lock(),
-                                                 m_SurfaceMeshPrincipalDirection1sPtr.lock(), m_SurfaceMeshPrincipalDirection2sPtr.lock(),
-                                                 m_SurfaceMeshGaussianCurvaturesPtr.lock(), m_SurfaceMeshMeanCurvaturesPtr.lock(), triangleGeom,
-                                                 m_SurfaceMeshFaceLabelsPtr.lock(),
-                                                 m_SurfaceMeshFaceNormalsPtr.lock(),
-                                                 m_SurfaceMeshTriangleCentroidsPtr.lock(),
-                                                 this );
-      curvature();
-    }
   }
-  // *********************** END END END END END END  ********************************************************************
-
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  g->wait(); // Wait for all the threads to complete before moving on.
-  delete g;
-#endif
 
   /* Let the GUI know we are done with this filter */
   notifyStatusMessage(getHumanLabel(), "Complete");
@@ -35,11 +35,13 @@
 
 #include "FindGBCD.h"
 
+#include <vector>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
+#include <tbb/enumerable_thread_specific.h>
 #endif
 
 #include <QtCore/QDateTime>
@@ -52,144 +54,249 @@
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationArray.hpp"
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 #include "OrientationLib/SpaceGroupOps/SpaceGroupOps.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
+
+/**
+ * @brief The GBCDHistogram struct holds one thread's share of a single phase's part of the GBCD, along
+ * with the face area that went into it
+ */
+struct GBCDHistogram
+{
+  GBCDHistogram() : totalFaceArea(0.0) {}
+  GBCDHistogram(size_t numBins) :
+    gbcd(numBins, 0.0),
+    totalFaceArea(0.0)
+  {}
+
+  std::vector<double> gbcd;
+  double totalFaceArea;
+};
+
+/**
+ * @brief The SymmetricMisorientations struct holds the symmetric misorientations from one Feature to another.
+ * For each symmetry operator j, g1s[j] is the first Feature's orientation rotated by that operator and the
+ * Euler angles (with PHI stored as cos(PHI)) of the misorientations that fall inside the GBCD are the
+ * triples start[j] up to start[j + 1] of eulers
+ */
+struct SymmetricMisorientations
+{
+  struct RotatedMatrix
+  {
+    float g[3][3];
+  };
+
+  std::vector<RotatedMatrix> g1s;
+  std::vector<size_t> start;
+  std::vector<float> eulers;
+};
 
 /**
  * @brief The CalculateGBCDImpl class implements a threaded algorithm that calculates the
- * grain boundary character distribution (GBCD) for a surface mesh
+ * grain boundary character distribution (GBCD) for a surface mesh. The work is split by feature
+ * face: the symmetric misorientations only depend on the two Features, so they are found once
+ * per feature face and every triangle of the face then only bins its own normal. The impl works
+ * through the feature faces of one phase at a time, and each triangle's symmetric variants are
+ * added to the calling thread's histogram for that phase as soon as they are found.
  */
 class CalculateGBCDImpl
 {
-    size_t startOffset;
-    size_t numEntriesPerTri;
+    FeatureFaceIndex::Pointer m_FaceIndex;
+    const int32_t* m_FeatureFaces;
     Int32ArrayType::Pointer m_LabelsArray;
     DoubleArrayType::Pointer m_NormalsArray;
+    DoubleArrayType::Pointer m_AreasArray;
     Int32ArrayType::Pointer m_PhasesArray;
     FloatArrayType::Pointer m_EulersArray;
 
     FloatArrayType::Pointer m_GbcdDeltasArray;
     FloatArrayType::Pointer m_GbcdLimitsArray;
     Int32ArrayType::Pointer m_GbcdSizesArray;
-    Int32ArrayType::Pointer m_GbcdBinsArray;
-    BoolArrayType::Pointer  m_GbcdHemiCheckArray;
 
     UInt32ArrayType::Pointer m_CrystalStructuresArray;
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    tbb::enumerable_thread_specific<GBCDHistogram>* m_ThreadHistograms;
+#endif
 
   public:
-    CalculateGBCDImpl(size_t i, size_t numMisoReps, Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, FloatArrayType::Pointer Eulers,
-                      Int32ArrayType::Pointer Phases, UInt32ArrayType::Pointer CrystalStructures,
-                      Int32ArrayType::Pointer Bins, BoolArrayType::Pointer HemiCheck,
+    CalculateGBCDImpl(FeatureFaceIndex::Pointer FaceIndex, Int32ArrayType::Pointer Labels, DoubleArrayType::Pointer Normals, DoubleArrayType::Pointer Areas,
+                      FloatArrayType::Pointer Eulers, Int32ArrayType::Pointer Phases, UInt32ArrayType::Pointer CrystalStructures,
                       FloatArrayType::Pointer GBCDdeltas, Int32ArrayType::Pointer  GBCDsizes,
                       FloatArrayType::Pointer GBCDlimits) :
-      startOffset(i),
-      numEntriesPerTri(numMisoReps),
+      m_FaceIndex(FaceIndex),
+      m_FeatureFaces(NULL),
       m_LabelsArray(Labels),
       m_NormalsArray(Normals),
+      m_AreasArray(Areas),
       m_PhasesArray(Phases),
       m_EulersArray(Eulers),
       m_GbcdDeltasArray(GBCDdeltas),
       m_GbcdLimitsArray(GBCDlimits),
       m_GbcdSizesArray(GBCDsizes),
-      m_GbcdBinsArray(Bins),
-      m_GbcdHemiCheckArray(HemiCheck),
       m_CrystalStructuresArray(CrystalStructures)
     {
       m_OrientationOps = SpaceGroupOps::getOrientationOpsQVector();
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      m_ThreadHistograms = NULL;
+#endif
     }
     virtual ~CalculateGBCDImpl() {}
 
-    void generate(size_t start, size_t end) const
+    /**
+     * @brief setFeatureFaces Sets the feature faces to work through. They must all lie between two
+     * Features of the same phase
+     * @param featureFaces Feature face numbers from the FeatureFaceIndex
+     */
+    void setFeatureFaces(const int32_t* featureFaces)
+    {
+      m_FeatureFaces = featureFaces;
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void setThreadHistograms(tbb::enumerable_thread_specific<GBCDHistogram>* histograms)
+    {
+      m_ThreadHistograms = histograms;
+    }
+#endif
+
+    /**
+     * @brief findSymmetricMisorientations Finds the symmetric misorientations from feature1 to feature2
+     * @param feature1 Feature on the side the boundary normal points away from
+     * @param feature2 Feature on the other side
+     * @param cryst Crystal structure of both Features
+     * @param misorientations Receives the misorientations
+     */
+    void findSymmetricMisorientations(int32_t feature1, int32_t feature2, uint32_t cryst, SymmetricMisorientations& misorientations) const
+    {
+      float* m_Eulers = m_EulersArray->getPointer(0);
+
+      float g1ea[3] = { 0.0f, 0.0f, 0.0f }, g2ea[3] = { 0.0f, 0.0f, 0.0f };
+      float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float g2s[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float sym1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, sym2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, dg[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      float euler_mis[3] = { 0.0f, 0.0f, 0.0f };
+
+      for (int32_t m = 0; m < 3; m++)
+      {
+        g1ea[m] = m_Eulers[3 * feature1 + m];
+        g2ea[m] = m_Eulers[3 * feature2 + m];
+      }
+
+      FOrientArrayType om(9, 0.0f);
+      FOrientTransformsType::eu2om(FOrientArrayType(g1ea, 3), om);
+      om.toGMatrix(g1);
+
+      FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
+      om.toGMatrix(g2);
+
+      int32_t nsym = m_OrientationOps[cryst]->getNumSymOps();
+      misorientations.g1s.resize(nsym);
+      misorientations.start.assign(nsym + 1, 0);
+      misorientations.eulers.clear();
+      for (int32_t j = 0; j < nsym; j++)
+      {
+        // rotate g1 by symOp
+        m_OrientationOps[cryst]->getMatSymOp(j, sym1);
+        float (*g1s)[3] = misorientations.g1s[j].g;
+        MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
+
+        for (int32_t k = 0; k < nsym; k++)
+        {
+          // calculate the symmetric misorienation
+          m_OrientationOps[cryst]->getMatSymOp(k, sym2);
+          // rotate g2 by symOp
+          MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
+          // transpose rotated g2
+          MatrixMath::Transpose3x3(g2s, g2t);
+          // calculate delta g
+          MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
+          // translate matrix to euler angles
+          FOrientArrayType om(dg);
+
+          FOrientArrayType eu(euler_mis, 3);
+          FOrientTransformsType::om2eu(om, eu);
+
+          if (euler_mis[0] < SIMPLib::Constants::k_PiOver2 && euler_mis[1] < SIMPLib::Constants::k_PiOver2 && euler_mis[2] < SIMPLib::Constants::k_PiOver2)
+          {
+            // PHI euler angle is stored in GBCD as cos(PHI)
+            misorientations.eulers.push_back(euler_mis[0]);
+            misorientations.eulers.push_back(cosf(euler_mis[1]));
+            misorientations.eulers.push_back(euler_mis[2]);
+          }
+        }
+        misorientations.start[j + 1] = misorientations.eulers.size() / 3;
+      }
+    }
+
+    void generate(size_t start, size_t end, double* gbcd, double& totalFaceArea) const
     {
 
       // We want to work with the raw pointers for speed so get those pointers.
       float* m_GBCDdeltas = m_GbcdDeltasArray->getPointer(0);
       float* m_GBCDlimits = m_GbcdLimitsArray->getPointer(0);
       int* m_GBCDsizes = m_GbcdSizesArray->getPointer(0);
-      int32_t* m_Bins = m_GbcdBinsArray->getPointer(0);
-      bool* m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
       int32_t* m_Labels = m_LabelsArray->getPointer(0);
       double* m_Normals = m_NormalsArray->getPointer(0);
+      double* m_Areas = m_AreasArray->getPointer(0);
       int32_t* m_Phases = m_PhasesArray->getPointer(0);
-      float* m_Eulers = m_EulersArray->getPointer(0);
       uint32_t* m_CrystalStructures = m_CrystalStructuresArray->getPointer(0);
 
-
-      int32_t j = 0;//, j4;
-      int32_t k = 0;//, k4;
-      int32_t m = 0;
-      int32_t temp = 0;
-      //bool gbcd_indices_good;
-      int32_t feature1 = 0, feature2 = 0;
       int32_t inversion = 1;
-      float g1ea[3] = { 0.0f, 0.0f, 0.0f }, g2ea[3] = { 0.0f, 0.0f, 0.0f };
-      float g1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, g2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-      float g1s[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, g2s[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-      float sym1[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, sym2[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-      float g2t[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } }, dg[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
       float euler_mis[3] = { 0.0f, 0.0f, 0.0f };
       float normal[3] = { 0.0f, 0.0f, 0.0f };
       float xstl1_norm1[3] = { 0.0f, 0.0f, 0.0f };
       int32_t gbcd_index = 0;
       float sqCoord[2] = { 0.0f, 0.0f }, sqCoordInv[2] = { 0.0f, 0.0f };
       bool nhCheck = false, nhCheckInv = true;
-      int32_t SYMcounter = 0;
-      int64_t TRIcounter = static_cast<int64_t>(start - startOffset);
-      int64_t TRIcounterShift = 0;
 
-      for (size_t i = start; i < end; i++)
-      {
-        SYMcounter = 0;
-        feature1 = m_Labels[2 * i];
-        feature2 = m_Labels[2 * i + 1];
-        normal[0] = m_Normals[3 * i];
-        normal[1] = m_Normals[3 * i + 1];
-        normal[2] = m_Normals[3 * i + 2];
-
-        if (feature1 < 0 || feature2 < 0) { continue; }
+      // The misorientations from the smaller to the larger label of the feature face, and the reverse
+      SymmetricMisorientations misorientations[2];
 
-        if (m_Phases[feature1] == m_Phases[feature2] && m_Phases[feature1] > 0)
+      for (size_t p = start; p < end; p++)
+      {
+        int32_t f = m_FeatureFaces[p];
+        const int32_t* faceLabels = m_FaceIndex->getFaceLabels(f);
+        uint32_t cryst = m_CrystalStructures[m_Phases[faceLabels[0]]];
+        int32_t nsym = m_OrientationOps[cryst]->getNumSymOps();
+        findSymmetricMisorientations(faceLabels[0], faceLabels[1], cryst, misorientations[0]);
+        findSymmetricMisorientations(faceLabels[1], faceLabels[0], cryst, misorientations[1]);
+
+        const int64_t* triangles = m_FaceIndex->getTriangles(f);
+        int64_t numTriangles = m_FaceIndex->getNumberOfTriangles(f);
+        for (int64_t t = 0; t < numTriangles; t++)
         {
-          TRIcounterShift = (TRIcounter * numEntriesPerTri);
-          uint32_t cryst = m_CrystalStructures[m_Phases[feature1]];
+          size_t i = static_cast<size_t>(triangles[t]);
+          double area = m_Areas[i];
+          normal[0] = m_Normals[3 * i];
+          normal[1] = m_Normals[3 * i + 1];
+          normal[2] = m_Normals[3 * i + 2];
+
+          // The triangle is binned from both sides; the second time from the other Feature with the normal reversed
+          int32_t side = (m_Labels[2 * i] == faceLabels[0]) ? 0 : 1;
           for (int32_t q = 0; q < 2; q++)
           {
             if (q == 1)
             {
-              temp = feature1;
-              feature1 = feature2;
-              feature2 = temp;
+              side = 1 - side;
               normal[0] = -normal[0];
               normal[1] = -normal[1];
               normal[2] = -normal[2];
             }
-            for (m = 0; m < 3; m++)
-            {
-              g1ea[m] = m_Eulers[3 * feature1 + m];
-              g2ea[m] = m_Eulers[3 * feature2 + m];
-            }
-
-            FOrientArrayType om(9, 0.0f);
-            FOrientTransformsType::eu2om(FOrientArrayType(g1ea, 3), om);
-            om.toGMatrix(g1);
+            const SymmetricMisorientations& sideMisorientations = misorientations[side];
 
-            FOrientTransformsType::eu2om(FOrientArrayType(g2ea, 3), om);
-            om.toGMatrix(g2);
-
-            int32_t nsym = m_OrientationOps[cryst]->getNumSymOps();
-            for (j = 0; j < nsym; j++)
+            for (int32_t j = 0; j < nsym; j++)
             {
-              // rotate g1 by symOp
-              m_OrientationOps[cryst]->getMatSymOp(j, sym1);
-              MatrixMath::Multiply3x3with3x3(sym1, g1, g1s);
               // get the crystal directions along the triangle normals
-              MatrixMath::Multiply3x3with3x1(g1s, normal, xstl1_norm1);
+              MatrixMath::Multiply3x3with3x1(sideMisorientations.g1s[j].g, normal, xstl1_norm1);
               // get coordinates in square projection of crystal normal parallel to boundary normal
               nhCheck = getSquareCoord(xstl1_norm1, sqCoord);
               if (inversion == 1)
@@ -200,58 +307,40 @@ class CalculateGBCDImpl
                 else { nhCheckInv = false; }
               }
 
-              for (k = 0; k < nsym; k++)
+              for (size_t k = sideMisorientations.start[j]; k < sideMisorientations.start[j + 1]; k++)
               {
-                // calculate the symmetric misorienation
-                m_OrientationOps[cryst]->getMatSymOp(k, sym2);
-                // rotate g2 by symOp
-                MatrixMath::Multiply3x3with3x3(sym2, g2, g2s);
-                // transpose rotated g2
-                MatrixMath::Transpose3x3(g2s, g2t);
-                // calculate delta g
-                MatrixMath::Multiply3x3with3x3(g1s, g2t, dg);
-                // translate matrix to euler angles
-                FOrientArrayType om(dg);
-
-                FOrientArrayType eu(euler_mis, 3);
-                FOrientTransformsType::om2eu(om, eu);
-
-                if (euler_mis[0] < SIMPLib::Constants::k_PiOver2 && euler_mis[1] < SIMPLib::Constants::k_PiOver2 && euler_mis[2] < SIMPLib::Constants::k_PiOver2)
+                euler_mis[0] = sideMisorientations.eulers[3 * k];
+                euler_mis[1] = sideMisorientations.eulers[3 * k + 1];
+                euler_mis[2] = sideMisorientations.eulers[3 * k + 2];
+                //get the indexes that this point would be in the GBCD histogram
+                gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoord);
+                // The northern hemisphere goes in the even bin of each pair, the southern one in the odd bin
+                if (gbcd_index != -1)
+                {
+                  gbcd[2 * gbcd_index + (nhCheck ? 0 : 1)] += area;
+                  totalFaceArea += area;
+                }
+                if (inversion == 1)
                 {
-                  // PHI euler angle is stored in GBCD as cos(PHI)
-                  euler_mis[1] = cosf(euler_mis[1]);
-                  //get the indexes that this point would be in the GBCD histogram
-                  gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoord);
+                  gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoordInv);
                   if (gbcd_index != -1)
                   {
-                    m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheck;
-                    m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
-                  }
-                  SYMcounter++;
-                  if (inversion == 1)
-                  {
-                    gbcd_index = GBCDIndex(m_GBCDdeltas, m_GBCDsizes, m_GBCDlimits, euler_mis, sqCoordInv);
-                    if (gbcd_index != -1)
-                    {
-                      m_HemiCheck[TRIcounterShift + SYMcounter] = nhCheckInv;
-                      m_Bins[TRIcounterShift + SYMcounter] = gbcd_index;
-                    }
-                    SYMcounter++;
+                    gbcd[2 * gbcd_index + (nhCheckInv ? 0 : 1)] += area;
+                    totalFaceArea += area;
                   }
                 }
-                else { SYMcounter += 2; }
               }
             }
           }
         }
-        TRIcounter++;
       }
     }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
     void operator()(const tbb::blocked_range<size_t>& r) const
     {
-      generate(r.begin(), r.end());
+      GBCDHistogram& histogram = m_ThreadHistograms->local();
+      generate(r.begin(), r.end(), &(histogram.gbcd.front()), histogram.totalFaceArea);
     }
 #endif
 
@@ -349,15 +438,11 @@ FindGBCD::FindGBCD() :
   m_GBCD(NULL),
   m_GbcdDeltas(NULL),
   m_GbcdSizes(NULL),
-  m_GbcdLimits(NULL),
-  m_GbcdBins(NULL),
-  m_HemiCheck(NULL)
+  m_GbcdLimits(NULL)
 {
   m_GbcdDeltasArray = FloatArrayType::NullPointer();
   m_GbcdSizesArray = Int32ArrayType::NullPointer();
   m_GbcdLimitsArray = FloatArrayType::NullPointer();
-  m_GbcdBinsArray = Int32ArrayType::NullPointer();
-  m_GbcdHemiCheckArray = BoolArrayType::NullPointer();
 
   setupFilterParameters();
 }
@@ -482,8 +567,8 @@ void FindGBCD::dataCheckSurfaceMesh()
   if( NULL != m_SurfaceMeshFaceAreasPtr.lock().get() ) /* Validate the Weak Pointer wraps a non-NULL pointer to a DataArray<T> object */
   { m_SurfaceMeshFaceAreas = m_SurfaceMeshFaceAreasPtr.lock()->getPointer(0); } /* Now assign the raw pointer to data from the DataArray<T> object */
 
-  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.  Note that the input parameters do not affect the size and can be dummy values here;
-  sizeGBCD(0, 0);
+  // call the sizeGBCD function to get the GBCD ranges, dimensions, etc.
+  sizeGBCD();
   cDims.resize(6);
   cDims[0] = m_GbcdSizes[0];
   cDims[1] = m_GbcdSizes[1];
@@ -550,17 +635,14 @@ void FindGBCD::execute()
   if(getErrorCondition() < 0) { return; }
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
   size_t totalPhases = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
   size_t totalFaces = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
   size_t faceChunkSize = 50000;
-  size_t numMisoReps = 576 * 4;
-  if (totalFaces < faceChunkSize) { faceChunkSize = totalFaces; }
-  // call the sizeGBCD function with proper chunkSize and numMisoReps to get Bins array set up properly
-  sizeGBCD(faceChunkSize, numMisoReps);
+  sizeGBCD();
   int32_t totalGBCDBins = m_GbcdSizes[0] * m_GbcdSizes[1] * m_GbcdSizes[2] * m_GbcdSizes[3] * m_GbcdSizes[4] * 2;
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
@@ -569,70 +651,100 @@ void FindGBCD::execute()
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
   startMillis =  QDateTime::currentMSecsSinceEpoch();
-  int32_t hemisphere = 0;
 
-  //create an array to hold the total face area for each phase and initialize the array to 0.0
-  DoubleArrayType::Pointer totalFaceAreaPtr = DoubleArrayType::CreateArray(totalPhases, "totalFaceArea");
-  totalFaceAreaPtr->initializeWithValue(0.0);
-  double* totalFaceArea = totalFaceAreaPtr->getPointer(0);
+  // Group the triangles into feature faces so each face's symmetric misorientations are only found once
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(m_SurfaceMeshFaceLabels, static_cast<int64_t>(totalFaces));
+  int32_t totalFeatureFaces = faceIndex->getNumberOfFaces();
+
+  // Only faces between two Features of the same phase go into the GBCD. They are sorted by phase so each
+  // phase's part of the GBCD can be accumulated on its own. Feature face 0 holds no triangles
+  std::vector<std::vector<int32_t> > phaseFeatureFaces(totalPhases);
+  for (int32_t f = 1; f < totalFeatureFaces; f++)
+  {
+    const int32_t* faceLabels = faceIndex->getFaceLabels(f);
+    if (faceLabels[0] < 0 || faceLabels[1] < 0) { continue; }
+    int32_t phase = m_FeaturePhases[faceLabels[0]];
+    if (phase <= 0 || phase != m_FeaturePhases[faceLabels[1]]) { continue; }
+    phaseFeatureFaces[phase].push_back(f);
+  }
+
+  CalculateGBCDImpl calculator(faceIndex, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_SurfaceMeshFaceAreasPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
+  std::vector<double> totalFaceArea(totalPhases, 0.0);
+  m_GBCDPtr.lock()->initializeWithZeros();
 
   QString ss = QObject::tr("Calculating GBCD || 0/%1 Completed").arg(totalFaces);
-  for (size_t i = 0; i < totalFaces; i = i + faceChunkSize)
+  size_t completedTriangles = 0;
+  for (size_t phase = 1; phase < totalPhases; phase++)
   {
-    if(getCancel() == true) { return; }
-    if (i + faceChunkSize >= totalFaces)
-    {
-      faceChunkSize = totalFaces - i;
-    }
-    m_GbcdBinsArray->initializeWithValue(-1);
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-    if (doParallel == true)
-    {
-      tbb::parallel_for(tbb::blocked_range<size_t>(i, i + faceChunkSize),
-                        CalculateGBCDImpl(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray), tbb::auto_partitioner());
+    const std::vector<int32_t>& featureFaces = phaseFeatureFaces[phase];
+    if (featureFaces.empty() == true) { continue; }
+    double* phaseGBCD = m_GBCD + phase * totalGBCDBins;
+    calculator.setFeatureFaces(&(featureFaces.front()));
 
-    }
-    else
+    // Every thread adds into its own copy of this phase's part of the GBCD, so at most one copy of the
+    // phase's bins per thread is alive at a time; the copies are summed once the phase is done
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    GBCDHistogram exemplar(totalGBCDBins);
+    tbb::enumerable_thread_specific<GBCDHistogram> threadHistograms(exemplar);
+    calculator.setThreadHistograms(&threadHistograms);
 #endif
-    {
-      CalculateGBCDImpl serial(i, numMisoReps, m_SurfaceMeshFaceLabelsPtr.lock(), m_SurfaceMeshFaceNormalsPtr.lock(), m_FeatureEulerAnglesPtr.lock(), m_FeaturePhasesPtr.lock(), m_CrystalStructuresPtr.lock(), m_GbcdBinsArray, m_GbcdHemiCheckArray, m_GbcdDeltasArray, m_GbcdSizesArray, m_GbcdLimitsArray);
-      serial.generate(i, i + faceChunkSize);
-    }
 
-    currentMillis = QDateTime::currentMSecsSinceEpoch();
-    if (currentMillis - millis > 1000)
+    // The faces are handed out in chunks of whole faces that hold about faceChunkSize triangles between them
+    size_t firstFace = 0;
+    while (firstFace < featureFaces.size())
     {
-      QString ss = QObject::tr("Calculating GBCD || Triangles %1/%2 Completed").arg(i).arg(totalFaces);
-      timeDiff = ((float)i / (float)(currentMillis - startMillis));
-      estimatedTime = (float)(totalFaces - i) / timeDiff;
-      ss = ss + QObject::tr(" || Est. Time Remain: %1").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime));
-      millis = QDateTime::currentMSecsSinceEpoch();
-      notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    }
+      if(getCancel() == true) { return; }
+      size_t lastFace = firstFace;
+      size_t chunkTriangles = 0;
+      while (lastFace < featureFaces.size() && (lastFace == firstFace || chunkTriangles < faceChunkSize))
+      {
+        chunkTriangles += static_cast<size_t>(faceIndex->getNumberOfTriangles(featureFaces[lastFace]));
+        lastFace++;
+      }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (doParallel == true)
+      {
+        tbb::parallel_for(tbb::blocked_range<size_t>(firstFace, lastFace), calculator, tbb::auto_partitioner());
+      }
+      else
+#endif
+      {
+        calculator.generate(firstFace, lastFace, phaseGBCD, totalFaceArea[phase]);
+      }
+      firstFace = lastFace;
+      completedTriangles = completedTriangles + chunkTriangles;
 
-    if(getCancel() == true) { return; }
+      currentMillis = QDateTime::currentMSecsSinceEpoch();
+      if (currentMillis - millis > 1000)
+      {
+        QString ss = QObject::tr("Calculating GBCD || Triangles %1/%2 Completed").arg(completedTriangles).arg(totalFaces);
+        timeDiff = ((float)completedTriangles / (float)(currentMillis - startMillis));
+        estimatedTime = (float)(totalFaces - completedTriangles) / timeDiff;
+        ss = ss + QObject::tr(" || Est. Time Remain: %1").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime));
+        millis = QDateTime::currentMSecsSinceEpoch();
+        notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
+      }
+    }
 
-    int32_t phase = 0;
-    int32_t feature = 0;
-    double area = 0.0;
-    for (size_t j = 0; j < faceChunkSize; j++)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    if (doParallel == true)
     {
-      area = m_SurfaceMeshFaceAreas[i + j];
-      feature = m_SurfaceMeshFaceLabels[2 * (i + j)];
-      phase = m_FeaturePhases[feature];
-      for (size_t k = 0; k < numMisoReps; k++)
+      typedef tbb::enumerable_thread_specific<GBCDHistogram>::const_iterator HistogramIterator;
+      for (HistogramIterator iter = threadHistograms.begin(); iter != threadHistograms.end(); ++iter)
       {
-        if (m_GbcdBins[(j * numMisoReps) + (k)] >= 0)
+        for (int32_t j = 0; j < totalGBCDBins; j++)
         {
-          hemisphere = 0;
-          if (m_HemiCheck[(j * numMisoReps) + k] == false) { hemisphere = 1; }
-          m_GBCD[(phase * totalGBCDBins) + (2 * m_GbcdBins[(j * numMisoReps) + (k)] + hemisphere)] += area;
-          totalFaceArea[phase] += area;
+          phaseGBCD[j] += iter->gbcd[j];
         }
+        totalFaceArea[phase] += iter->totalFaceArea;
       }
     }
+#endif
   }
 
+  if(getCancel() == true) { return; }
+
   ss = QObject::tr("Starting GBCD Normalization");
   notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
@@ -653,7 +765,7 @@ void FindGBCD::execute()
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
+void FindGBCD::sizeGBCD()
 {
   m_GbcdDeltasArray = FloatArrayType::CreateArray(5, "GBCDDeltas");
   m_GbcdDeltasArray->initializeWithZeros();
@@ -661,17 +773,10 @@ void FindGBCD::sizeGBCD(size_t faceChunkSize, size_t numMisoReps)
   m_GbcdLimitsArray->initializeWithZeros();
   m_GbcdSizesArray = Int32ArrayType::CreateArray(5, "GBCDSizes");
   m_GbcdSizesArray->initializeWithZeros();
-  QVector<size_t> cDims(1, numMisoReps);
-  m_GbcdBinsArray = Int32ArrayType::CreateArray(faceChunkSize, cDims, "GBCDBins");
-  m_GbcdBinsArray->initializeWithZeros();
-  m_GbcdHemiCheckArray = BoolArrayType::CreateArray(faceChunkSize, cDims, "GBCDHemiCheck");
-  m_GbcdHemiCheckArray->initializeWithValue(false);
 
   m_GbcdDeltas = m_GbcdDeltasArray->getPointer(0);
   m_GbcdSizes = m_GbcdSizesArray->getPointer(0);
   m_GbcdLimits = m_GbcdLimitsArray->getPointer(0);
-  m_GbcdBins = m_GbcdBinsArray->getPointer(0);
-  m_HemiCheck = m_GbcdHemiCheckArray->getPointer(0);
 
   //Original Ranges from Dave R.
   //m_GBCDlimits[0] = 0.0f;
@@ -36,54 +36,109 @@
 
 #include "FindNRingNeighbors.h"
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-FindNRingNeighbors::FindNRingNeighbors() :
-  m_TriangleId(-1),
-  m_RegionId0(0),
-  m_RegionId1(0),
-  m_Ring(2),
-  m_WriteBinaryFile(false),
-  m_WriteConformalMesh(true)
-{
-}
+#include <algorithm>
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-FindNRingNeighbors::~FindNRingNeighbors()
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+/**
+ * @brief The FaceAdjacencyImpl class implements a threaded algorithm that finds, for each triangle, the other
+ * triangles of the same feature face that share a vertex with it. Without an output array it only counts them
+ */
+class FaceAdjacencyImpl
 {
-}
+  public:
+    FaceAdjacencyImpl(const int64_t* triangles, ElementDynamicList* node2Triangle, const int32_t* faceIds,
+                      const int32_t* localIndex, int64_t* counts, const int64_t* rowStart, int32_t* neighbors) :
+      m_Triangles(triangles),
+      m_Node2Triangle(node2Triangle),
+      m_FaceIds(faceIds),
+      m_LocalIndex(localIndex),
+      m_Counts(counts),
+      m_RowStart(rowStart),
+      m_Neighbors(neighbors)
+    {}
+    virtual ~FaceAdjacencyImpl() {}
+
+    void convert(int64_t start, int64_t end) const
+    {
+      std::vector<int32_t> candidates;
+      for (int64_t t = start; t < end; t++)
+      {
+        int32_t faceId = m_FaceIds[t];
+        candidates.clear();
+        if (faceId >= 0)
+        {
+          for (int32_t i = 0; i < 3; i++)
+          {
+            int64_t vert = m_Triangles[3 * t + i];
+            uint16_t tCount = m_Node2Triangle->getNumberOfElements(vert);
+            int64_t* data = m_Node2Triangle->getElementListPointer(vert);
+            for (uint16_t k = 0; k < tCount; k++)
+            {
+              if (data[k] != t && m_FaceIds[data[k]] == faceId) { candidates.push_back(m_LocalIndex[data[k]]); }
+            }
+          }
+          std::sort(candidates.begin(), candidates.end());
+          candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        }
+
+        if (NULL == m_Neighbors)
+        {
+          m_Counts[t + 1] = static_cast<int64_t>(candidates.size());
+        }
+        else if (candidates.empty() == false)
+        {
+          std::copy(candidates.begin(), candidates.end(), m_Neighbors + m_RowStart[t]);
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<int64_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const int64_t* m_Triangles;
+    ElementDynamicList* m_Node2Triangle;
+    const int32_t* m_FaceIds;
+    const int32_t* m_LocalIndex;
+    int64_t* m_Counts;
+    const int64_t* m_RowStart;
+    int32_t* m_Neighbors;
+};
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void FindNRingNeighbors::setRegionIds(int32_t g, int32_t r)
+FindNRingNeighbors::FindNRingNeighbors() :
+  m_Ring(2)
 {
-  m_RegionId0 = g;
-  m_RegionId1 = r;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-FindNRingNeighbors::UniqueFaceIds_t& FindNRingNeighbors::getNRingTriangles()
+FindNRingNeighbors::~FindNRingNeighbors()
 {
-  return m_NRingTriangles;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels)
+int32_t FindNRingNeighbors::initialize(TriangleGeom::Pointer triangleGeom, FeatureFaceIndex::Pointer faceIndex)
 {
   int64_t* triangles = triangleGeom->getTriPointer(0);
+  int64_t numTriangles = triangleGeom->getNumberOfTris();
   int32_t err = 0;
 
-  //Clear out all the previous triangles.
-  m_NRingTriangles.clear();
-
   // Make sure we have the proper connectivity built
   ElementDynamicList::Pointer node2TrianglePtr = triangleGeom->getElementsContainingVert();
   if (node2TrianglePtr.get() == NULL)
@@ -96,52 +151,92 @@ int32_t FindNRingNeighbors::generate(TriangleGeom::Pointer triangleGeom, int32_t
     node2TrianglePtr = triangleGeom->getElementsContainingVert();
   }
 
-  // Figure out these boolean values for a sanity check
-  bool check0 = faceLabels[m_TriangleId * 2] == m_RegionId0 && faceLabels[m_TriangleId * 2 + 1] == m_RegionId1;
-  bool check1 = faceLabels[m_TriangleId * 2 + 1] == m_RegionId0 && faceLabels[m_TriangleId * 2] == m_RegionId1;
+  m_FaceIndex = faceIndex;
+  const int32_t* faceIds = faceIndex->getFaceIds();
 
-#if 1
-  if ( check0 == false && check1 == false)
+  // The neighbors are stored by their position within their feature face, which keeps the adjacency
+  // list compact and lets generate() size its markers by the face instead of the whole mesh
+  m_LocalIndex.assign(numTriangles + 1, 0);
+  for (int32_t f = 0; f < faceIndex->getNumberOfFaces(); f++)
   {
-    qDebug() << "FindNRingNeighbors Seed triangle ID does not have a matching Region ID for " << m_RegionId0 << " & " << m_RegionId1 << "\n";
-    qDebug() << "Region Ids are: " << faceLabels[m_TriangleId * 2] << " & " << faceLabels[m_TriangleId * 2 + 1] << "\n";
-    return err;
+    const int64_t* faceTriangles = faceIndex->getTriangles(f);
+    int64_t count = faceIndex->getNumberOfTriangles(f);
+    for (int64_t i = 0; i < count; i++)
+    {
+      m_LocalIndex[faceTriangles[i]] = static_cast<int32_t>(i);
+    }
   }
-#endif
 
-  // Add our seed triangle
-  m_NRingTriangles.insert(m_TriangleId);
+  m_RowStart.assign(numTriangles + 1, 0);
+  ParallelContext::ParallelFor<int64_t>(0, numTriangles, FaceAdjacencyImpl(triangles, node2TrianglePtr.get(), faceIds, &(m_LocalIndex.front()), &(m_RowStart.front()), NULL, NULL));
 
-  for (int64_t ring = 0; ring < m_Ring; ++ring)
+  for (int64_t t = 0; t < numTriangles; t++)
   {
-    // Make a copy of the 1 Ring Triangles that we just found so that we can use those triangles as the
-    // seed triangles for the 2 Ring triangles
-    UniqueFaceIds_t lcvTriangles(m_NRingTriangles);
+    m_RowStart[t + 1] += m_RowStart[t];
+  }
+
+  m_Neighbors.assign(m_RowStart[numTriangles] + 1, 0);
+  ParallelContext::ParallelFor<int64_t>(0, numTriangles, FaceAdjacencyImpl(triangles, node2TrianglePtr.get(), faceIds, &(m_LocalIndex.front()), NULL, &(m_RowStart.front()), &(m_Neighbors.front())));
+
+  return err;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FindNRingNeighbors::generate(int64_t triangleId, Scratch& scratch, std::vector<int64_t>& patch) const
+{
+  patch.clear();
+  patch.push_back(triangleId);
 
-    // Now that we have the 1 ring triangles, get the 2 Ring neighbors from that list
-    for (UniqueFaceIds_t::iterator triIter = lcvTriangles.begin(); triIter != lcvTriangles.end(); ++triIter)
+  int32_t faceId = m_FaceIndex->getFaceIds()[triangleId];
+  if (faceId < 0) { return; }
+  const int64_t* faceTriangles = m_FaceIndex->getTriangles(faceId);
+  size_t faceSize = static_cast<size_t>(m_FaceIndex->getNumberOfTriangles(faceId));
+
+  if (scratch.visited.size() < faceSize)
+  {
+    scratch.visited.resize(faceSize, 0);
+  }
+  scratch.epoch++;
+  if (scratch.epoch == 0)
+  {
+    // The markers wrapped around so old values could look current; start over
+    std::fill(scratch.visited.begin(), scratch.visited.end(), 0);
+    scratch.epoch = 1;
+  }
+  uint32_t epoch = scratch.epoch;
+
+  int32_t seed = m_LocalIndex[triangleId];
+  scratch.visited[seed] = epoch;
+  scratch.ring.clear();
+  scratch.ring.push_back(seed);
+  scratch.found.clear();
+
+  for (int64_t ring = 0; ring < m_Ring && scratch.ring.empty() == false; ++ring)
+  {
+    scratch.nextRing.clear();
+    for (size_t i = 0; i < scratch.ring.size(); i++)
     {
-      int64_t triangleIdx = *triIter;
-      // For each node, get the triangle ids that the node belongs to
-      for(int32_t i = 0; i < 3; ++i)
+      int64_t t = faceTriangles[scratch.ring[i]];
+      for (int64_t k = m_RowStart[t]; k < m_RowStart[t + 1]; k++)
       {
-        // Get all the triangles for this Node id
-        uint16_t tCount = node2TrianglePtr->getNumberOfElements(triangles[triangleIdx * 3 + i]);
-        int64_t* data = node2TrianglePtr->getElementListPointer(triangles[triangleIdx * 3 + i]);
-
-        // Copy all the triangles into our "2Ring" set which will be the unique set of triangle ids
-        for (uint16_t t = 0; t < tCount; ++t)
+        int32_t n = m_Neighbors[k];
+        if (scratch.visited[n] != epoch)
         {
-          int64_t tid = data[t];
-          check0 = faceLabels[tid * 2] == m_RegionId0 && faceLabels[tid * 2 + 1] == m_RegionId1;
-          check1 = faceLabels[tid * 2 + 1] == m_RegionId0 && faceLabels[tid * 2] == m_RegionId1;
-          if (check0 == true || check1 == true)
-          {
-            m_NRingTriangles.insert(tid);
-          }
+          scratch.visited[n] = epoch;
+          scratch.nextRing.push_back(n);
+          scratch.found.push_back(n);
         }
       }
     }
+    scratch.ring.swap(scratch.nextRing);
+  }
+
+  // The triangles of a face are stored in increasing order, so sorting the positions sorts the ids
+  std::sort(scratch.found.begin(), scratch.found.end());
+  for (size_t i = 0; i < scratch.found.size(); i++)
+  {
+    patch.push_back(faceTriangles[scratch.found[i]]);
   }
-  return err;
 }
@@ -33,16 +33,26 @@
 *
 * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
 
-
 #ifndef _FindNRingNeighbors_H_
 #define _FindNRingNeighbors_H_
 
+#include <vector>
+
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/Geometry/TriangleGeom.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
+
 /**
- * @brief The FindNRingNeighbors class calculates the set of triangles that are "N" rings (based on vertex) from a seed triangle
+ * @brief The FindNRingNeighbors class calculates the set of triangles that are "N" rings (based on vertex) from a seed
+ * triangle and that belong to the same feature face as the seed triangle.
+ *
+ * initialize() builds, once per mesh, a flat adjacency list that holds for each triangle the other triangles of its
+ * feature face that share a vertex with it. generate() then walks that list breadth first for one seed triangle.
+ * generate() only reads the shared data; all of its working memory lives in a Scratch object that the caller
+ * owns, so any number of threads can generate patches at the same time and, once the buffers of a Scratch have
+ * grown to the size of the largest patch, no memory is allocated per seed.
  */
 class FindNRingNeighbors
 {
@@ -53,26 +63,19 @@ class FindNRingNeighbors
 
     virtual ~FindNRingNeighbors();
 
-    typedef std::set<int64_t> UniqueFaceIds_t;
-
-    SIMPL_INSTANCE_PROPERTY(int64_t, TriangleId)
-
     /**
-     * @brief This sets the region id (Feature Id) that we are interested in.
+     * @brief The Scratch struct holds the working memory of generate(). A triangle has been visited during
+     * the current call if its entry in visited equals epoch, which saves clearing the markers between calls
      */
-    SIMPL_INSTANCE_PROPERTY(int32_t, RegionId0)
-
-    /**
-     * @brief This sets the region id (Feature Id) that we are interested in.
-     */
-    SIMPL_INSTANCE_PROPERTY(int32_t, RegionId1)
-
-    /**
-     * @brief setRegionIds Sets the local variables for region Ids
-     * @param g Id for region 0
-     * @param r Id for region 1
-     */
-    void setRegionIds(int32_t g, int32_t r);
+    struct Scratch
+    {
+      Scratch() : epoch(0) {}
+      std::vector<uint32_t> visited;
+      uint32_t epoch;
+      std::vector<int32_t> ring;
+      std::vector<int32_t> nextRing;
+      std::vector<int32_t> found;
+    };
 
     /**
      * @brief This is the number of rings to find
@@ -80,31 +83,32 @@ class FindNRingNeighbors
     SIMPL_INSTANCE_PROPERTY(int64_t, Ring)
 
     /**
-     * @brief getNRingTriangles Returns the N ring set
-     * @return Set of N ring Ids
-     */
-    UniqueFaceIds_t& getNRingTriangles();
-
-    /**
-     * @brief generate Generates the N rings based on the supplied TriangleGeom
+     * @brief initialize Builds the adjacency list between the triangles of each feature face
      * @param triangleGeom Incoming TriangleGeom object
-     * @param faceLabels Feature Id labels for the TriangleGeom
+     * @param faceIndex Grouping of the triangles into feature faces
      * @return Integer error value
      */
-    int32_t generate(TriangleGeom::Pointer triangleGeom, int32_t* faceLabels);
+    int32_t initialize(TriangleGeom::Pointer triangleGeom, FeatureFaceIndex::Pointer faceIndex);
 
-    SIMPL_INSTANCE_PROPERTY(bool, WriteBinaryFile)
-    SIMPL_INSTANCE_PROPERTY(bool, WriteConformalMesh)
+    /**
+     * @brief generate Generates the N ring patch of a seed triangle
+     * @param triangleId The seed triangle
+     * @param scratch Working memory; must not be used by another thread at the same time
+     * @param patch Receives the seed triangle followed by the rest of the patch in increasing order
+     */
+    void generate(int64_t triangleId, Scratch& scratch, std::vector<int64_t>& patch) const;
 
   protected:
     FindNRingNeighbors();
 
   private:
-    UniqueFaceIds_t  m_NRingTriangles;
+    FeatureFaceIndex::Pointer m_FaceIndex;
+    std::vector<int32_t> m_LocalIndex;
+    std::vector<int64_t> m_RowStart;
+    std::vector<int32_t> m_Neighbors;
 
     FindNRingNeighbors(const FindNRingNeighbors&); // Copy Constructor Not Implemented
     void operator=(const FindNRingNeighbors&); // Operator '=' Not Implemented
 };
 
 #endif /* _FindNRingNeighbors_H_ */
-
@@ -48,19 +48,8 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
-#include "SIMPLib/Utilities/ColorTable.h"
-
-#include "OrientationLib/SpaceGroupOps/CubicLowOps.h"
-#include "OrientationLib/SpaceGroupOps/CubicOps.h"
-#include "OrientationLib/SpaceGroupOps/HexagonalLowOps.h"
-#include "OrientationLib/SpaceGroupOps/HexagonalOps.h"
-#include "OrientationLib/SpaceGroupOps/MonoclinicOps.h"
-#include "OrientationLib/SpaceGroupOps/OrthoRhombicOps.h"
-#include "OrientationLib/SpaceGroupOps/TetragonalLowOps.h"
-#include "OrientationLib/SpaceGroupOps/TetragonalOps.h"
-#include "OrientationLib/SpaceGroupOps/TriclinicOps.h"
-#include "OrientationLib/SpaceGroupOps/TrigonalLowOps.h"
-#include "OrientationLib/SpaceGroupOps/TrigonalOps.h"
+
+#include "OrientationLib/SpaceGroupOps/IPFColorGenerator.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 
@@ -76,37 +65,23 @@ class CalculateFaceIPFColorsImpl
     float* m_Eulers;
     uint8_t* m_Colors;
     uint32_t* m_CrystalStructures;
+    IPFColorGenerator* m_Generator;
 
   public:
-    CalculateFaceIPFColorsImpl(int32_t* labels, int32_t* phases, double* normals, float* eulers, uint8_t* colors, uint32_t* crystalStructures) :
+    CalculateFaceIPFColorsImpl(IPFColorGenerator* generator, int32_t* labels, int32_t* phases, double* normals, float* eulers, uint8_t* colors, uint32_t* crystalStructures) :
       m_Labels(labels),
       m_Phases(phases),
       m_Normals(normals),
       m_Eulers(eulers),
       m_Colors(colors),
-      m_CrystalStructures(crystalStructures)
+      m_CrystalStructures(crystalStructures),
+      m_Generator(generator)
     {}
     virtual ~CalculateFaceIPFColorsImpl() {}
 
     void generate(size_t start, size_t end) const
     {
-      // Create 1 of every type of Ops class. This condenses the code below
-      QVector<SpaceGroupOps::Pointer> ops;
-      ops.push_back(HexagonalOps::New());
-      ops.push_back(CubicOps::New());
-      ops.push_back(HexagonalLowOps::New());
-      ops.push_back(CubicLowOps::New());
-      ops.push_back(TriclinicOps::New());
-      ops.push_back(MonoclinicOps::New());
-      ops.push_back(OrthoRhombicOps::New());
-      ops.push_back(TetragonalLowOps::New());
-      ops.push_back(TetragonalOps::New());
-      ops.push_back(TrigonalLowOps::New());
-      ops.push_back(TrigonalOps::New());
-
-      double refDir[3] = {0.0, 0.0, 0.0};
-      double dEuler[3] = {0.0, 0.0, 0.0};
-      DREAM3D::Rgb argb = 0x00000000;
+      float refDir[3] = {0.0f, 0.0f, 0.0f};
 
       int32_t feature1 = 0, feature2 = 0, phase1 = 0, phase2 = 0;
       for (size_t i = start; i < end; i++)
@@ -124,17 +99,11 @@ class CalculateFaceIPFColorsImpl
           // Make sure we are using a valid Euler Angles with valid crystal symmetry
           if (m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
           {
-            dEuler[0] = m_Eulers[3 * feature1 + 0];
-            dEuler[1] = m_Eulers[3 * feature1 + 1];
-            dEuler[2] = m_Eulers[3 * feature1 + 2];
-            refDir[0] = m_Normals[3 * i + 0];
-            refDir[1] = m_Normals[3 * i + 1];
-            refDir[2] = m_Normals[3 * i + 2];
-
-            argb = ops[m_CrystalStructures[phase1]]->generateIPFColor(dEuler, refDir, false);
-            m_Colors[6 * i] = RgbColor::dRed(argb);
-            m_Colors[6 * i + 1] = RgbColor::dGreen(argb);
-            m_Colors[6 * i + 2] = RgbColor::dBlue(argb);
+            refDir[0] = static_cast<float>(m_Normals[3 * i + 0]);
+            refDir[1] = static_cast<float>(m_Normals[3 * i + 1]);
+            refDir[2] = static_cast<float>(m_Normals[3 * i + 2]);
+
+            m_Generator->generateIPFColor(m_CrystalStructures[phase1], m_Eulers + 3 * feature1, refDir, m_Colors + 6 * i);
           }
         }
         else // Phase 1 was Zero so assign a black color
@@ -151,17 +120,11 @@ class CalculateFaceIPFColorsImpl
           // Make sure we are using a valid Euler Angles with valid crystal symmetry
           if (m_CrystalStructures[phase1] < Ebsd::CrystalStructure::LaueGroupEnd)
           {
-            dEuler[0] = m_Eulers[3 * feature2 + 0];
-            dEuler[1] = m_Eulers[3 * feature2 + 1];
-            dEuler[2] = m_Eulers[3 * feature2 + 2];
-            refDir[0] = -m_Normals[3 * i + 0];
-            refDir[1] = -m_Normals[3 * i + 1];
-            refDir[2] = -m_Normals[3 * i + 2];
-
-            argb = ops[m_CrystalStructures[phase1]]->generateIPFColor(dEuler, refDir, false);
-            m_Colors[6 * i + 3] = RgbColor::dRed(argb);
-            m_Colors[6 * i + 4] = RgbColor::dGreen(argb);
-            m_Colors[6 * i + 5] = RgbColor::dBlue(argb);
+            refDir[0] = static_cast<float>(-m_Normals[3 * i + 0]);
+            refDir[1] = static_cast<float>(-m_Normals[3 * i + 1]);
+            refDir[2] = static_cast<float>(-m_Normals[3 * i + 2]);
+
+            m_Generator->generateIPFColor(m_CrystalStructures[phase1], m_Eulers + 3 * feature2, refDir, m_Colors + 6 * i + 3);
           }
         }
         else
@@ -379,6 +342,9 @@ void GenerateFaceIPFColoring::execute()
 
   int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
+  // The symmetry operator tables are built once and shared by every thread
+  IPFColorGenerator::Pointer generator = IPFColorGenerator::New();
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
   bool doParallel = true;
 #endif
@@ -387,12 +353,12 @@ void GenerateFaceIPFColoring::execute()
   if (doParallel == true)
   {
     tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceIPFColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures), tbb::auto_partitioner());
+                      CalculateFaceIPFColorsImpl(generator.get(), m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures), tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateFaceIPFColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures);
+    CalculateFaceIPFColorsImpl serial(generator.get(), m_SurfaceMeshFaceLabels, m_FeaturePhases, m_SurfaceMeshFaceNormals, m_FeatureEulerAngles, m_SurfaceMeshFaceIPFColors, m_CrystalStructures);
     serial.generate(0, numTriangles);
   }
 
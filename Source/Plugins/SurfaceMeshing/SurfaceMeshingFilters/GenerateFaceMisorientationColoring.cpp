@@ -48,6 +48,7 @@
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/SpaceGroupOps/CubicLowOps.h"
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
@@ -59,13 +60,16 @@
 #include "OrientationLib/SpaceGroupOps/TrigonalOps.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
 
 /**
  * @brief The CalculateFaceMisorientationColorsImpl class implements a threaded algorithm that computes the misorientation
- * colors for the given list of surface mesh labels
+ * colors for the given list of surface mesh labels. The color only depends on the two Features, so it is computed once per
+ * feature face for each order of the labels and then copied to the triangles of the face
  */
 class CalculateFaceMisorientationColorsImpl
 {
+    FeatureFaceIndex::Pointer m_FaceIndex;
     int32_t* m_Labels;
     int32_t* m_Phases;
     float* m_Quats;
@@ -74,7 +78,8 @@ class CalculateFaceMisorientationColorsImpl
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
 
   public:
-    CalculateFaceMisorientationColorsImpl(int32_t* labels, int32_t* phases, float* quats, float* colors, unsigned int* crystalStructures) :
+    CalculateFaceMisorientationColorsImpl(FeatureFaceIndex::Pointer faceIndex, int32_t* labels, int32_t* phases, float* quats, float* colors, unsigned int* crystalStructures) :
+      m_FaceIndex(faceIndex),
       m_Labels(labels),
       m_Phases(phases),
       m_Quats(quats),
@@ -85,51 +90,66 @@ class CalculateFaceMisorientationColorsImpl
     }
     virtual ~CalculateFaceMisorientationColorsImpl() {}
 
-    void generate(size_t start, size_t end) const
+    /**
+     * @brief generateColor Computes the color of a triangle whose first label is feature1
+     * @param feature1 First label of the triangle
+     * @param feature2 Second label of the triangle
+     * @param color Receives the color
+     * @return false if the triangle keeps the color it already has
+     */
+    bool generateColor(int32_t feature1, int32_t feature2, float* color) const
     {
-      int32_t feature1 = 0, feature2 = 0, phase1 = 0, phase2 = 0;
+      int32_t phase1 = 0, phase2 = 0;
       QuatF q1 = QuaternionMathF::New();
       QuatF q2 = QuaternionMathF::New();
       QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
       float w = 0.0f, n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
       float radToDeg = 180.0f / SIMPLib::Constants::k_Pi;
-      for (size_t i = start; i < end; i++)
+      if (feature1 > 0) { phase1 = m_Phases[feature1]; }
+      if (feature2 > 0) { phase2 = m_Phases[feature2]; }
+      if (phase1 > 0)
       {
-        feature1 = m_Labels[2 * i];
-        feature2 = m_Labels[2 * i + 1];
-        if (feature1 > 0) { phase1 = m_Phases[feature1]; }
-        else { phase1 = 0; }
-        if (feature2 > 0) { phase2 = m_Phases[feature2]; }
-        else { phase2 = 0; }
-        if (phase1 > 0)
+        if (phase1 == phase2 && (m_CrystalStructures[phase1] == Ebsd::CrystalStructure::Cubic_High || m_CrystalStructures[phase1] == Ebsd::CrystalStructure::Hexagonal_High))
         {
-          if (phase1 == phase2 && m_CrystalStructures[phase1] == Ebsd::CrystalStructure::Cubic_High)
-          {
-            QuaternionMathF::Copy(quats[feature1], q1);
-            QuaternionMathF::Copy(quats[feature2], q2);
-            w = m_OrientationOps[m_CrystalStructures[phase1]]->getMisoQuat(q1, q2, n1, n2, n3);
-            w = w * radToDeg;
-            m_Colors[3 * i + 0] = w * n1;
-            m_Colors[3 * i + 1] = w * n2;
-            m_Colors[3 * i + 2] = w * n3;
-          }
-          else if (phase1 == phase2 && m_CrystalStructures[phase1] == Ebsd::CrystalStructure::Hexagonal_High)
-          {
-            QuaternionMathF::Copy(quats[feature1], q1);
-            QuaternionMathF::Copy(quats[feature2], q2);
-            w = m_OrientationOps[m_CrystalStructures[phase1]]->getMisoQuat(q1, q2, n1, n2, n3);
-            w = w * radToDeg;
-            m_Colors[3 * i + 0] = w * n1;
-            m_Colors[3 * i + 1] = w * n2;
-            m_Colors[3 * i + 2] = w * n3;
-          }
+          QuaternionMathF::Copy(quats[feature1], q1);
+          QuaternionMathF::Copy(quats[feature2], q2);
+          w = m_OrientationOps[m_CrystalStructures[phase1]]->getMisoQuat(q1, q2, n1, n2, n3);
+          w = w * radToDeg;
+          color[0] = w * n1;
+          color[1] = w * n2;
+          color[2] = w * n3;
+          return true;
         }
-        else
+        return false;
+      }
+      color[0] = 0.0f;
+      color[1] = 0.0f;
+      color[2] = 0.0f;
+      return true;
+    }
+
+    void generate(size_t start, size_t end) const
+    {
+      // The colors for the smaller label first, and for the larger label first
+      float colors[2][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      bool valid[2] = { false, false };
+      for (size_t f = start; f < end; f++)
+      {
+        const int32_t* faceLabels = m_FaceIndex->getFaceLabels(static_cast<int32_t>(f));
+        valid[0] = generateColor(faceLabels[0], faceLabels[1], colors[0]);
+        valid[1] = generateColor(faceLabels[1], faceLabels[0], colors[1]);
+
+        const int64_t* triangles = m_FaceIndex->getTriangles(static_cast<int32_t>(f));
+        int64_t numTriangles = m_FaceIndex->getNumberOfTriangles(static_cast<int32_t>(f));
+        for (int64_t t = 0; t < numTriangles; t++)
         {
-          m_Colors[3 * i + 0] = 0;
-          m_Colors[3 * i + 1] = 0;
-          m_Colors[3 * i + 2] = 0;
+          size_t i = static_cast<size_t>(triangles[t]);
+          int32_t side = (m_Labels[2 * i] == faceLabels[0]) ? 0 : 1;
+          if (valid[side] == false) { continue; }
+          m_Colors[3 * i + 0] = colors[side][0];
+          m_Colors[3 * i + 1] = colors[side][1];
+          m_Colors[3 * i + 2] = colors[side][2];
         }
       }
     }
@@ -326,21 +346,23 @@ void GenerateFaceMisorientationColoring::execute()
 
   int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-#endif
+  // Group the triangles into feature faces so each face's misorientation is only computed once
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(m_SurfaceMeshFaceLabels, numTriangles);
+  size_t numFeatureFaces = static_cast<size_t>(faceIndex->getNumberOfFaces());
+  CalculateFaceMisorientationColorsImpl calculator(faceIndex, m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceMisorientationColors, m_CrystalStructures);
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
   if (doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceMisorientationColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceMisorientationColors, m_CrystalStructures), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numFeatureFaces), calculator, tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateFaceMisorientationColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceMisorientationColors, m_CrystalStructures);
-    serial.generate(0, numTriangles);
+    calculator.generate(1, numFeatureFaces);
   }
 
   /* Let the GUI know we are done with this filter */
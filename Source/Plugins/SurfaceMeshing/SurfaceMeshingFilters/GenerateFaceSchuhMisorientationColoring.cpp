@@ -51,6 +51,7 @@
 #include "SIMPLib/Math/SIMPLibMath.h"
 #include "SIMPLib/Math/MatrixMath.h"
 #include "SIMPLib/Utilities/ColorTable.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/SpaceGroupOps/CubicLowOps.h"
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
@@ -64,10 +65,18 @@
 #include "OrientationLib/SpaceGroupOps/TrigonalLowOps.h"
 #include "OrientationLib/SpaceGroupOps/TrigonalOps.h"
 
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
 
 
+
+/**
+ * @brief The CalculateFaceSchuhMisorientationColorsImpl class implements a threaded algorithm that computes the Schuh
+ * misorientation colors of the triangles. The color only depends on the two Features, so it is computed once per
+ * feature face for each order of the labels and then copied to the triangles of the face
+ */
 class CalculateFaceSchuhMisorientationColorsImpl
 {
+    FeatureFaceIndex::Pointer m_FaceIndex;
     int32_t* m_Labels;
     int32_t* m_Phases;
     float* m_Quats;
@@ -76,7 +85,8 @@ class CalculateFaceSchuhMisorientationColorsImpl
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
 
   public:
-    CalculateFaceSchuhMisorientationColorsImpl(int32_t* labels, int32_t* phases, float* quats, uint8_t* colors, unsigned int* crystalStructures) :
+    CalculateFaceSchuhMisorientationColorsImpl(FeatureFaceIndex::Pointer faceIndex, int32_t* labels, int32_t* phases, float* quats, uint8_t* colors, unsigned int* crystalStructures) :
+      m_FaceIndex(faceIndex),
       m_Labels(labels),
       m_Phases(phases),
       m_Quats(quats),
@@ -88,47 +98,61 @@ class CalculateFaceSchuhMisorientationColorsImpl
     virtual ~CalculateFaceSchuhMisorientationColorsImpl() {}
 
     /**
-     * @brief generate Generates the colors for the triangles
-     * @param start The starting DREAM3D::SurfaceMesh::Face_t Index
-     * @param end The ending DREAM3D::SurfaceMesh::Face_t Index
+     * @brief generateColor Computes the color of a triangle whose first label is grain1
+     * @param grain1 First label of the triangle
+     * @param grain2 Second label of the triangle
+     * @param color Receives the color
      */
-    void generate(size_t start, size_t end) const
+    void generateColor(int32_t grain1, int32_t grain2, uint8_t* color) const
     {
-      QVector<SpaceGroupOps::Pointer> ops = SpaceGroupOps::getOrientationOpsQVector();
       DREAM3D::Rgb argb = 0x00000000;
-
-      int grain1, grain2, phase1, phase2;
+      int32_t phase1 = 0, phase2 = 0;
       QuatF q1;
       QuatF q2;
       QuatF* quats = reinterpret_cast<QuatF*>(m_Quats);
 
-      for (size_t i = start; i < end; i++)
+      if(grain1 > 0) { phase1 = m_Phases[grain1]; }
+      if(grain2 > 0) { phase2 = m_Phases[grain2]; }
+
+      color[0] = 0;
+      color[1] = 0;
+      color[2] = 0;
+
+      if(phase1 > 0 && phase1 == phase2 && m_CrystalStructures[phase1] == Ebsd::CrystalStructure::Cubic_High)
+      {
+        QuaternionMathF::Copy(quats[grain1], q1);
+        QuaternionMathF::Copy(quats[grain2], q2);
+        argb = m_OrientationOps[m_CrystalStructures[phase1]]->generateMisorientationColor(q1, q2);
+        color[0] = RgbColor::dRed(argb);
+        color[1] = RgbColor::dGreen(argb);
+        color[2] = RgbColor::dBlue(argb);
+      }
+    }
+
+    /**
+     * @brief generate Generates the colors for the triangles of a range of feature faces
+     * @param start The first feature face
+     * @param end One past the last feature face
+     */
+    void generate(size_t start, size_t end) const
+    {
+      // The colors for the smaller label first, and for the larger label first
+      uint8_t colors[2][3] = { { 0, 0, 0 }, { 0, 0, 0 } };
+      for (size_t f = start; f < end; f++)
       {
-        grain1 = m_Labels[2 * i];
-        grain2 = m_Labels[2 * i + 1];
-        if(grain1 > 0) { phase1 = m_Phases[grain1]; }
-        else { phase1 = 0; }
-        if(grain2 > 0) { phase2 = m_Phases[grain2]; }
-        else { phase2 = 0; }
-
-        m_Colors[3 * i + 0] = 0;
-        m_Colors[3 * i + 1] = 0;
-        m_Colors[3 * i + 2] = 0;
-
-        if(phase1 > 0)
+        const int32_t* faceLabels = m_FaceIndex->getFaceLabels(static_cast<int32_t>(f));
+        generateColor(faceLabels[0], faceLabels[1], colors[0]);
+        generateColor(faceLabels[1], faceLabels[0], colors[1]);
+
+        const int64_t* triangles = m_FaceIndex->getTriangles(static_cast<int32_t>(f));
+        int64_t numTriangles = m_FaceIndex->getNumberOfTriangles(static_cast<int32_t>(f));
+        for (int64_t t = 0; t < numTriangles; t++)
         {
-          if(phase1 == phase2)
-          {
-            if(m_CrystalStructures[phase1] == Ebsd::CrystalStructure::Cubic_High)
-            {
-              QuaternionMathF::Copy(quats[grain1], q1);
-              QuaternionMathF::Copy(quats[grain2], q2);
-              argb = ops[m_CrystalStructures[phase1]]->generateMisorientationColor(q1, q2);
-              m_Colors[3 * i] = RgbColor::dRed(argb);
-              m_Colors[3 * i + 1] = RgbColor::dGreen(argb);
-              m_Colors[3 * i + 2] = RgbColor::dBlue(argb);
-            }
-          }
+          size_t i = static_cast<size_t>(triangles[t]);
+          int32_t side = (m_Labels[2 * i] == faceLabels[0]) ? 0 : 1;
+          m_Colors[3 * i + 0] = colors[side][0];
+          m_Colors[3 * i + 1] = colors[side][1];
+          m_Colors[3 * i + 2] = colors[side][2];
         }
       }
     }
@@ -312,21 +336,23 @@ void GenerateFaceSchuhMisorientationColoring::execute()
   // Run the data check to allocate the memory for the centroid array
   int64_t numTriangles = m_SurfaceMeshFaceLabelsPtr.lock()->getNumberOfTuples();
 
-#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  bool doParallel = true;
-#endif
+  // Group the triangles into feature faces so each face's color is only computed once
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(m_SurfaceMeshFaceLabels, numTriangles);
+  size_t numFeatureFaces = static_cast<size_t>(faceIndex->getNumberOfFaces());
+  CalculateFaceSchuhMisorientationColorsImpl calculator(faceIndex, m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceSchuhMisorientationColors, m_CrystalStructures);
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
   if (doParallel == true)
   {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, numTriangles),
-                      CalculateFaceSchuhMisorientationColorsImpl(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceSchuhMisorientationColors, m_CrystalStructures), tbb::auto_partitioner());
+    tbb::parallel_for(tbb::blocked_range<size_t>(1, numFeatureFaces), calculator, tbb::auto_partitioner());
   }
   else
 #endif
   {
-    CalculateFaceSchuhMisorientationColorsImpl serial(m_SurfaceMeshFaceLabels, m_FeaturePhases, m_AvgQuats, m_SurfaceMeshFaceSchuhMisorientationColors, m_CrystalStructures);
-    serial.generate(0, numTriangles);
+    calculator.generate(1, numFeatureFaces);
   }
 
   /* Let the GUI know we are done with this filter */
@@ -37,7 +37,15 @@
 #include "LaplacianSmoothing.h"
 
 #include <stdio.h>
+#include <algorithm>
 #include <sstream>
+#include <vector>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
 
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
@@ -45,11 +53,88 @@
 
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/DoubleFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
 
+/**
+ * @brief The LaplacianSmoothingImpl class implements a threaded algorithm that moves each vertex towards the
+ * average position of its neighbors. Positions are read from one set of coordinate arrays and written to another,
+ * so every vertex is moved based on the positions of the previous step regardless of the order of evaluation
+ */
+class LaplacianSmoothingImpl
+{
+  public:
+    LaplacianSmoothingImpl(const int64_t* rowStart, const int64_t* neighbors, const float* lambda, float factor,
+                           const float* srcX, const float* srcY, const float* srcZ,
+                           float* dstX, float* dstY, float* dstZ) :
+      m_RowStart(rowStart),
+      m_Neighbors(neighbors),
+      m_Lambda(lambda),
+      m_Factor(factor),
+      m_SrcX(srcX),
+      m_SrcY(srcY),
+      m_SrcZ(srcZ),
+      m_DstX(dstX),
+      m_DstY(dstY),
+      m_DstZ(dstZ)
+    {}
+    virtual ~LaplacianSmoothingImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        int64_t first = m_RowStart[i];
+        int64_t last = m_RowStart[i + 1];
+        float ll = m_Factor * m_Lambda[i];
+        if (first == last || ll == 0.0f)
+        {
+          m_DstX[i] = m_SrcX[i];
+          m_DstY[i] = m_SrcY[i];
+          m_DstZ[i] = m_SrcZ[i];
+          continue;
+        }
+
+        double sumX = 0.0;
+        double sumY = 0.0;
+        double sumZ = 0.0;
+        for (int64_t k = first; k < last; k++)
+        {
+          int64_t n = m_Neighbors[k];
+          sumX += m_SrcX[n];
+          sumY += m_SrcY[n];
+          sumZ += m_SrcZ[n];
+        }
+        double scale = 1.0 / static_cast<double>(last - first);
+        m_DstX[i] = m_SrcX[i] + ll * (sumX * scale - m_SrcX[i]);
+        m_DstY[i] = m_SrcY[i] + ll * (sumY * scale - m_SrcY[i]);
+        m_DstZ[i] = m_SrcZ[i] + ll * (sumZ * scale - m_SrcZ[i]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+  private:
+    const int64_t* m_RowStart;
+    const int64_t* m_Neighbors;
+    const float* m_Lambda;
+    float m_Factor;
+    const float* m_SrcX;
+    const float* m_SrcY;
+    const float* m_SrcZ;
+    float* m_DstX;
+    float* m_DstY;
+    float* m_DstZ;
+};
+
 // Include the MOC generated file for this class
 #include "moc_LaplacianSmoothing.cpp"
 
@@ -69,6 +154,8 @@ LaplacianSmoothing::LaplacianSmoothing() :
   m_QuadPointLambda(0.0f),
   m_SurfaceTripleLineLambda(0.0f),
   m_SurfaceQuadPointLambda(0.0f),
+  m_UseTaubinSmoothing(false),
+  m_MuFactor(-1.03f),
   m_SurfaceMeshNodeType(NULL),
   m_SurfaceMeshFaceLabels(NULL)
 {
@@ -95,6 +182,10 @@ void LaplacianSmoothing::setupFilterParameters()
   parameters.push_back(DoubleFilterParameter::New("Outer Points Lambda", "SurfacePointLambda", getSurfacePointLambda(), FilterParameter::Parameter));
   parameters.push_back(DoubleFilterParameter::New("Outer Triple Line Lambda", "SurfaceTripleLineLambda", getSurfaceTripleLineLambda(), FilterParameter::Parameter));
   parameters.push_back(DoubleFilterParameter::New("Outer Quadruple Points Lambda", "SurfaceQuadPointLambda", getSurfaceQuadPointLambda(), FilterParameter::Parameter));
+  QStringList linkedProps;
+  linkedProps << "MuFactor";
+  parameters.push_back(LinkedBooleanFilterParameter::New("Use Taubin Smoothing", "UseTaubinSmoothing", getUseTaubinSmoothing(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(DoubleFilterParameter::New("Mu Factor", "MuFactor", getMuFactor(), FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Vertex Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(DREAM3D::TypeNames::Int8, 1, DREAM3D::AttributeMatrixType::Vertex, DREAM3D::GeometryType::TriangleGeometry);
@@ -121,6 +212,8 @@ void LaplacianSmoothing::readFilterParameters(AbstractFilterParametersReader* re
   setSurfacePointLambda( reader->readValue("SurfacePointLambda", getSurfacePointLambda()) );
   setSurfaceTripleLineLambda( reader->readValue("SurfaceTripleLineLambda", getSurfaceTripleLineLambda()) );
   setSurfaceQuadPointLambda( reader->readValue("SurfaceQuadPointLambda", getSurfaceQuadPointLambda()) );
+  setUseTaubinSmoothing( reader->readValue("UseTaubinSmoothing", getUseTaubinSmoothing()) );
+  setMuFactor( reader->readValue("MuFactor", getMuFactor()) );
   setSurfaceMeshNodeTypeArrayPath(reader->readDataArrayPath("SurfaceMeshNodeTypeArrayPath", getSurfaceMeshNodeTypeArrayPath() ) );
   setSurfaceMeshFaceLabelsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath() ) );
   reader->closeFilterGroup();
@@ -140,6 +233,8 @@ int LaplacianSmoothing::writeFilterParameters(AbstractFilterParametersWriter* wr
   SIMPL_FILTER_WRITE_PARAMETER(SurfacePointLambda)
   SIMPL_FILTER_WRITE_PARAMETER(SurfaceTripleLineLambda)
   SIMPL_FILTER_WRITE_PARAMETER(SurfaceQuadPointLambda)
+  SIMPL_FILTER_WRITE_PARAMETER(UseTaubinSmoothing)
+  SIMPL_FILTER_WRITE_PARAMETER(MuFactor)
   SIMPL_FILTER_WRITE_PARAMETER(SurfaceMeshNodeTypeArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(SurfaceMeshFaceLabelsArrayPath)
   writer->closeFilterGroup();
@@ -173,6 +268,12 @@ void LaplacianSmoothing::dataCheck()
   getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, faceDataArrays);
   getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, nodeDataArrays);
 
+  if (m_UseTaubinSmoothing == true && m_MuFactor >= 0.0f)
+  {
+    setErrorCondition(-558);
+    notifyErrorMessage(getHumanLabel(), "The Mu Factor must be negative when using Taubin smoothing", getErrorCondition());
+  }
+
   setSurfaceDataContainerName(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
 }
 
@@ -291,53 +392,72 @@ int32_t LaplacianSmoothing::edgeBasedSmoothing()
 
   int64_t* uedges = surfaceMesh->getEdgePointer(0);
   int64_t nedges = surfaceMesh->getNumberOfEdges();
+  if (nvert == 0) { return err; }
+
+  // Convert the unique edges into a compressed vertex adjacency list so that each vertex can
+  // gather from its neighbors instead of every edge scattering into both of its vertices
+  std::vector<int64_t> rowStart(nvert + 1, 0);
+  for (int64_t i = 0; i < nedges; i++)
+  {
+    BOOST_ASSERT( uedges[2 * i] < nvert && uedges[2 * i + 1] < nvert );
+    rowStart[uedges[2 * i] + 1]++;
+    rowStart[uedges[2 * i + 1] + 1]++;
+  }
+  for (int64_t i = 0; i < nvert; i++)
+  {
+    rowStart[i + 1] += rowStart[i];
+  }
+  std::vector<int64_t> neighbors(2 * nedges, 0);
+  {
+    std::vector<int64_t> cursor(rowStart.begin(), rowStart.end() - 1);
+    for (int64_t i = 0; i < nedges; i++)
+    {
+      int64_t in1 = uedges[2 * i];   // row of the first vertex
+      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
+      neighbors[cursor[in1]++] = in2;
+      neighbors[cursor[in2]++] = in1;
+    }
+  }
 
-  DataArray<int32_t>::Pointer numConnections = DataArray<int32_t>::CreateArray(nvert, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_NumberConnections_Array");
-  numConnections->initializeWithZeros();
-  int32_t* ncon = numConnections->getPointer(0);
+  // Each coordinate gets its own pair of arrays; one holds the current positions while the other
+  // receives the smoothed positions and the two are swapped after every step
+  std::vector<float> coords(6 * nvert, 0.0f);
+  float* src[3] = { &(coords.front()), &(coords.front()) + nvert, &(coords.front()) + 2 * nvert };
+  float* dst[3] = { &(coords.front()) + 3 * nvert, &(coords.front()) + 4 * nvert, &(coords.front()) + 5 * nvert };
+  for (int64_t i = 0; i < nvert; i++)
+  {
+    src[0][i] = verts[3 * i];
+    src[1][i] = verts[3 * i + 1];
+    src[2][i] = verts[3 * i + 2];
+  }
 
-  QVector<size_t> cDims(1, 3);
-  DataArray<double>::Pointer deltaArray = DataArray<double>::CreateArray(nvert, cDims, "_INTERNAL_USE_ONLY_Laplacian_Smoothing_Delta_Array");
-  deltaArray->initializeWithZeros();
-  double* delta = deltaArray->getPointer(0);
+  // Plain Laplacian smoothing takes one step per iteration, Taubin smoothing a shrinking and an inflating step
+  QVector<float> factors(1, 1.0f);
+  if (m_UseTaubinSmoothing == true)
+  {
+    factors.push_back(m_MuFactor);
+  }
 
-  double dlta = 0.0;
   for (int32_t q = 0; q < m_IterationSteps; q++)
   {
     if (getCancel() == true) { return -1; }
     QString ss = QObject::tr("Iteration %1").arg(q);
     notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
-    for (int64_t i = 0; i < nedges; i++)
+    for (int32_t f = 0; f < factors.size(); f++)
     {
-      int64_t in1 = uedges[2 * i];   // row of the first vertex
-      int64_t in2 = uedges[2 * i + 1]; // row the second vertex
-
+      ParallelContext::ParallelFor<size_t>(0, nvert, LaplacianSmoothingImpl(&(rowStart.front()), neighbors.empty() ? NULL : &(neighbors.front()), lambda, factors[f], src[0], src[1], src[2], dst[0], dst[1], dst[2]));
       for (int32_t j = 0; j < 3; j++)
       {
-        BOOST_ASSERT( static_cast<size_t>(3 * in1 + j) < static_cast<size_t>(nvert * 3) );
-        BOOST_ASSERT( static_cast<size_t>(3 * in2 + j) < static_cast<size_t>(nvert * 3) );
-        dlta = verts[3 * in2 + j] - verts[3 * in1 + j];
-        delta[3 * in1 + j] += dlta;
-        delta[3 * in2 + j] += -1.0 * dlta;
+        std::swap(src[j], dst[j]);
       }
-      ncon[in1] += 1;
-      ncon[in2] += 1;
     }
+  }
 
-    float ll = 0.0f;
-    for (int64_t i = 0; i < nvert; i++)
-    {
-      for (int32_t j = 0; j < 3; j++)
-      {
-        int64_t in0 = 3 * i + j;
-        dlta = delta[in0] / ncon[i];
-
-        ll = lambda[i];
-        verts[3 * i + j] += ll * dlta;
-        delta[in0] = 0.0; // reset for next iteration
-      }
-      ncon[i] = 0; // reset for next iteration
-    }
+  for (int64_t i = 0; i < nvert; i++)
+  {
+    verts[3 * i] = src[0][i];
+    verts[3 * i + 1] = src[1][i];
+    verts[3 * i + 2] = src[2][i];
   }
 
   return err;
@@ -88,6 +88,12 @@ class LaplacianSmoothing : public SurfaceMeshFilter
     SIMPL_FILTER_PARAMETER(float, SurfaceQuadPointLambda)
     Q_PROPERTY(float SurfaceQuadPointLambda READ getSurfaceQuadPointLambda WRITE setSurfaceQuadPointLambda)
 
+    SIMPL_FILTER_PARAMETER(bool, UseTaubinSmoothing)
+    Q_PROPERTY(bool UseTaubinSmoothing READ getUseTaubinSmoothing WRITE setUseTaubinSmoothing)
+
+    SIMPL_FILTER_PARAMETER(float, MuFactor)
+    Q_PROPERTY(float MuFactor READ getMuFactor WRITE setMuFactor)
+
 
     /* This class is designed to be subclassed so that thoes subclasses can add
      * more functionality such as constrained surface nodes or Triple Lines. We use
@@ -162,7 +168,11 @@ class LaplacianSmoothing : public SurfaceMeshFilter
     virtual int32_t generateLambdaArray();
 
     /**
-     * @brief edgeBasedSmoothing Version of the smoothing algorithm uses Edge->Vertex connectivity information for its algorithm
+     * @brief edgeBasedSmoothing Version of the smoothing algorithm uses Edge->Vertex connectivity information for its algorithm.
+     * The unique edges are converted into a vertex adjacency list once, after which each smoothing step
+     * gathers the neighbor positions of every vertex in parallel from the positions of the previous step.
+     * When UseTaubinSmoothing is set every iteration is followed by a second step with the lambda values
+     * scaled by MuFactor, which counteracts the shrinkage of plain Laplacian smoothing
      * @return Integer error code
      */
     virtual int32_t edgeBasedSmoothing();
@@ -36,6 +36,8 @@
 
 #include "SharedFeatureFaceFilter.h"
 
+#include <string.h>
+
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
@@ -44,6 +46,7 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 
 #include "SurfaceMeshing/SurfaceMeshingConstants.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
 
 // Include the MOC generated file for this class
 #include "moc_SharedFeatureFaceFilter.cpp"
@@ -192,50 +195,17 @@ void SharedFeatureFaceFilter::execute()
   TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
   int64_t totalPoints = triangleGeom->getNumberOfTris();
 
-  QMap<uint64_t, int32_t> faceSizeMap;
-  QMap<uint64_t, int32_t> faceIdMap; // This maps a unique 64 bit integer to an increasing 32 bit integer
-  int32_t index = 1;
-  struct { int g; int r; } faceId;
-  uint64_t* faceId_64 = reinterpret_cast<uint64_t*>(&faceId);
-  int32_t fl0 = -1;
-  int32_t fl1 = -1;
-
-  std::vector< std::pair<int32_t, int32_t> > faceLabelMap;
-  faceLabelMap.push_back( std::pair<int32_t, int32_t>(0, 0) );
-
-  // Loop through all the Triangles and figure out how many triangles we have in each one.
-  for (int64_t t = 0; t < totalPoints; ++t)
+  // Group the triangles by their face labels; the face ids are assigned in the order in which the faces
+  // are first encountered
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(m_SurfaceMeshFaceLabels, totalPoints);
+  if (totalPoints > 0)
   {
-    fl0 = m_SurfaceMeshFaceLabels[t * 2];
-    fl1 = m_SurfaceMeshFaceLabels[t * 2 + 1];
-    if (fl0 < fl1)
-    {
-      faceId.g = fl0;
-      faceId.r = fl1;
-    }
-    else
-    {
-      faceId.g = fl1;
-      faceId.r = fl0;
-    }
-
-    QMap<uint64_t, int32_t>::iterator iter = faceSizeMap.find(*faceId_64);
-    if (iter == faceSizeMap.end())
-    {
-      faceSizeMap[*faceId_64] = 1;
-      faceIdMap[*faceId_64] = index;
-      m_SurfaceMeshFeatureFaceIds[t] = index;
-      faceLabelMap.push_back( std::pair<int32_t, int32_t>(faceId.g, faceId.r) );
-      ++index;
-    }
-    else
-    {
-      iter.value()++;
-      m_SurfaceMeshFeatureFaceIds[t] = faceIdMap[*faceId_64];
-    }
+    ::memcpy(m_SurfaceMeshFeatureFaceIds, faceIndex->getFaceIds(), totalPoints * sizeof(int32_t));
   }
 
   // resize + update pointers
+  int32_t index = faceIndex->getNumberOfFaces();
   QVector<size_t> tDims(1, index);
   faceFeatureAttrMat->resizeAttributeArrays(tDims);
   m_SurfaceMeshFeatureFaceLabels = m_SurfaceMeshFeatureFaceLabelsPtr.lock()->getPointer(0);
@@ -244,13 +214,11 @@ void SharedFeatureFaceFilter::execute()
   for (int32_t i = 0; i < index; i++)
   {
     // get feature face labels
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceLabelMap[i].first;
-    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceLabelMap[i].second;
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 0] = faceIndex->getFaceLabels(i)[0];
+    m_SurfaceMeshFeatureFaceLabels[2 * i + 1] = faceIndex->getFaceLabels(i)[1];
 
     // get feature triangle count
-    faceId.g = faceLabelMap[i].first;
-    faceId.r = faceLabelMap[i].second;
-    m_SurfaceMeshFeatureFaceNumTriangles[i] = faceSizeMap[*faceId_64];
+    m_SurfaceMeshFeatureFaceNumTriangles[i] = static_cast<int32_t>(faceIndex->getNumberOfTriangles(i));
   }
 
   /* Let the GUI know we are done with this filter */
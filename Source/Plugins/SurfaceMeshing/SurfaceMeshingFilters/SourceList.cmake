@@ -86,6 +86,9 @@ ADD_DREAM3D_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util
 ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleOps.h)
 ADD_DREAM3D_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/TriangleOps.cpp)
 
+ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/FeatureFaceIndex.h)
+ADD_DREAM3D_SUPPORT_SOURCE(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/FeatureFaceIndex.cpp)
+
 #ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/Exception.h)
 #ADD_DREAM3D_SUPPORT_HEADER(${SurfaceMeshing_SOURCE_DIR} ${_filterGroupName} util/InvalidParameterException.h)
 
@@ -0,0 +1,423 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#include "FeatureFaceIndex.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+namespace Detail
+{
+  static const int32_t k_RadixBits = 8;
+  static const int64_t k_RadixBuckets = 256;
+  static const int64_t k_RadixBlockSize = 65536;
+
+  /**
+   * @brief FaceKey Packs the smaller label into the upper and the larger label into the lower 32 bits
+   */
+  inline uint64_t FaceKey(int32_t fl0, int32_t fl1)
+  {
+    if (fl0 > fl1) { std::swap(fl0, fl1); }
+    return (static_cast<uint64_t>(static_cast<uint32_t>(fl0)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(fl1));
+  }
+
+  /**
+   * @brief The FaceKeysImpl class implements a threaded algorithm that computes the sort key of each triangle
+   */
+  class FaceKeysImpl
+  {
+    public:
+      FaceKeysImpl(const int32_t* faceLabels, uint64_t* keys, int64_t* triangles) :
+        m_FaceLabels(faceLabels),
+        m_Keys(keys),
+        m_Triangles(triangles)
+      {}
+      virtual ~FaceKeysImpl() {}
+
+      void convert(int64_t start, int64_t end) const
+      {
+        for (int64_t t = start; t < end; t++)
+        {
+          m_Keys[t] = FaceKey(m_FaceLabels[2 * t], m_FaceLabels[2 * t + 1]);
+          m_Triangles[t] = t;
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<int64_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+    private:
+      const int32_t* m_FaceLabels;
+      uint64_t* m_Keys;
+      int64_t* m_Triangles;
+  };
+
+  /**
+   * @brief The RadixHistogramImpl class implements a threaded algorithm that counts the digits of the keys
+   * in each block of keys
+   */
+  class RadixHistogramImpl
+  {
+    public:
+      RadixHistogramImpl(const uint64_t* keys, int64_t numKeys, int32_t shift, int64_t* histograms) :
+        m_Keys(keys),
+        m_NumKeys(numKeys),
+        m_Shift(shift),
+        m_Histograms(histograms)
+      {}
+      virtual ~RadixHistogramImpl() {}
+
+      void convert(int64_t startBlock, int64_t endBlock) const
+      {
+        for (int64_t b = startBlock; b < endBlock; b++)
+        {
+          int64_t* histogram = m_Histograms + b * k_RadixBuckets;
+          std::fill(histogram, histogram + k_RadixBuckets, 0);
+          int64_t end = std::min(m_NumKeys, (b + 1) * k_RadixBlockSize);
+          for (int64_t i = b * k_RadixBlockSize; i < end; i++)
+          {
+            histogram[(m_Keys[i] >> m_Shift) & (k_RadixBuckets - 1)]++;
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<int64_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+    private:
+      const uint64_t* m_Keys;
+      int64_t m_NumKeys;
+      int32_t m_Shift;
+      int64_t* m_Histograms;
+  };
+
+  /**
+   * @brief The RadixScatterImpl class implements a threaded algorithm that moves the keys of each block to
+   * their sorted positions for one digit. The offsets of each block are advanced in place, which keeps the
+   * sort stable
+   */
+  class RadixScatterImpl
+  {
+    public:
+      RadixScatterImpl(const uint64_t* srcKeys, const int64_t* srcTriangles, uint64_t* dstKeys, int64_t* dstTriangles,
+                       int64_t numKeys, int32_t shift, int64_t* offsets) :
+        m_SrcKeys(srcKeys),
+        m_SrcTriangles(srcTriangles),
+        m_DstKeys(dstKeys),
+        m_DstTriangles(dstTriangles),
+        m_NumKeys(numKeys),
+        m_Shift(shift),
+        m_Offsets(offsets)
+      {}
+      virtual ~RadixScatterImpl() {}
+
+      void convert(int64_t startBlock, int64_t endBlock) const
+      {
+        for (int64_t b = startBlock; b < endBlock; b++)
+        {
+          int64_t* offsets = m_Offsets + b * k_RadixBuckets;
+          int64_t end = std::min(m_NumKeys, (b + 1) * k_RadixBlockSize);
+          for (int64_t i = b * k_RadixBlockSize; i < end; i++)
+          {
+            int64_t pos = offsets[(m_SrcKeys[i] >> m_Shift) & (k_RadixBuckets - 1)]++;
+            m_DstKeys[pos] = m_SrcKeys[i];
+            m_DstTriangles[pos] = m_SrcTriangles[i];
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<int64_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+    private:
+      const uint64_t* m_SrcKeys;
+      const int64_t* m_SrcTriangles;
+      uint64_t* m_DstKeys;
+      int64_t* m_DstTriangles;
+      int64_t m_NumKeys;
+      int32_t m_Shift;
+      int64_t* m_Offsets;
+  };
+
+  /**
+   * @brief The FillFacesImpl class implements a threaded algorithm that copies the sorted run of triangles of
+   * each face into the face's slot of the triangle list and stores the face id of each of those triangles
+   */
+  class FillFacesImpl
+  {
+    public:
+      FillFacesImpl(const int64_t* sortedTriangles, const int64_t* runStart, const int32_t* runOfFace,
+                    const int64_t* faceStart, int64_t* triangles, int32_t* faceIds) :
+        m_SortedTriangles(sortedTriangles),
+        m_RunStart(runStart),
+        m_RunOfFace(runOfFace),
+        m_FaceStart(faceStart),
+        m_Triangles(triangles),
+        m_FaceIds(faceIds)
+      {}
+      virtual ~FillFacesImpl() {}
+
+      void convert(int32_t start, int32_t end) const
+      {
+        for (int32_t f = start; f < end; f++)
+        {
+          const int64_t* src = m_SortedTriangles + m_RunStart[m_RunOfFace[f]];
+          int64_t count = m_FaceStart[f + 1] - m_FaceStart[f];
+          for (int64_t i = 0; i < count; i++)
+          {
+            m_Triangles[m_FaceStart[f] + i] = src[i];
+            m_FaceIds[src[i]] = f;
+          }
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<int32_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+    private:
+      const int64_t* m_SortedTriangles;
+      const int64_t* m_RunStart;
+      const int32_t* m_RunOfFace;
+      const int64_t* m_FaceStart;
+      int64_t* m_Triangles;
+      int32_t* m_FaceIds;
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureFaceIndex::FeatureFaceIndex()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureFaceIndex::~FeatureFaceIndex()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureFaceIndex::buildFromFaceLabels(const int32_t* faceLabels, int64_t numTriangles)
+{
+  std::vector<uint64_t> keys(numTriangles + 1, 0);
+  std::vector<int64_t> sorted(numTriangles + 1, 0);
+
+  ParallelContext::ParallelFor<int64_t>(0, numTriangles, Detail::FaceKeysImpl(faceLabels, &(keys.front()), &(sorted.front())));
+
+  // Least significant digit first radix sort of the keys, carrying the triangle indices along. Digits that
+  // are the same for every key (e.g., the upper bytes of the labels) do not need a pass
+  std::vector<uint64_t> tmpKeys(numTriangles + 1, 0);
+  std::vector<int64_t> tmpSorted(numTriangles + 1, 0);
+  int64_t numBlocks = (numTriangles + Detail::k_RadixBlockSize - 1) / Detail::k_RadixBlockSize;
+  std::vector<int64_t> histograms(numBlocks * Detail::k_RadixBuckets + 1, 0);
+  for (int32_t shift = 0; shift < 64 && numTriangles > 0; shift += Detail::k_RadixBits)
+  {
+    ParallelContext::ParallelFor<int64_t>(0, numBlocks, Detail::RadixHistogramImpl(&(keys.front()), numTriangles, shift, &(histograms.front())));
+
+    // Turn the counts into the starting position of each digit within each block
+    int64_t firstDigit = (keys[0] >> shift) & (Detail::k_RadixBuckets - 1);
+    int64_t position = 0;
+    for (int64_t d = 0; d < Detail::k_RadixBuckets; d++)
+    {
+      for (int64_t b = 0; b < numBlocks; b++)
+      {
+        int64_t count = histograms[b * Detail::k_RadixBuckets + d];
+        histograms[b * Detail::k_RadixBuckets + d] = position;
+        position += count;
+      }
+    }
+    int64_t nextDigitStart = (firstDigit + 1 < Detail::k_RadixBuckets) ? histograms[firstDigit + 1] : numTriangles;
+    if (histograms[firstDigit] == 0 && nextDigitStart == numTriangles) { continue; }
+
+    ParallelContext::ParallelFor<int64_t>(0, numBlocks, Detail::RadixScatterImpl(&(keys.front()), &(sorted.front()), &(tmpKeys.front()), &(tmpSorted.front()), numTriangles, shift, &(histograms.front())));
+    keys.swap(tmpKeys);
+    sorted.swap(tmpSorted);
+  }
+  std::vector<uint64_t>().swap(tmpKeys);
+  std::vector<int64_t>().swap(tmpSorted);
+
+  // Every run of equal keys is a face. Since the sort is stable, the first triangle of a run is the
+  // triangle where the face is first encountered
+  std::vector<int64_t> runStart;
+  for (int64_t i = 0; i < numTriangles; i++)
+  {
+    if (i == 0 || keys[i] != keys[i - 1]) { runStart.push_back(i); }
+  }
+  int32_t numRuns = static_cast<int32_t>(runStart.size());
+  runStart.push_back(numTriangles);
+
+  std::vector<std::pair<int64_t, int32_t> > firstTriangles(numRuns);
+  for (int32_t r = 0; r < numRuns; r++)
+  {
+    firstTriangles[r] = std::make_pair(sorted[runStart[r]], r);
+  }
+  ParallelContext::ParallelSort(firstTriangles.begin(), firstTriangles.end(), std::less<std::pair<int64_t, int32_t> >());
+
+  int32_t numFaces = numRuns + 1;
+  std::vector<int32_t> runOfFace(numFaces, 0);
+  m_FaceStart.assign(numFaces + 1, 0);
+  m_FaceLabels.assign(2 * numFaces, 0);
+  for (int32_t f = 1; f < numFaces; f++)
+  {
+    int32_t r = firstTriangles[f - 1].second;
+    runOfFace[f] = r;
+    m_FaceStart[f + 1] = m_FaceStart[f] + (runStart[r + 1] - runStart[r]);
+    uint64_t key = keys[runStart[r]];
+    m_FaceLabels[2 * f] = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+    m_FaceLabels[2 * f + 1] = static_cast<int32_t>(static_cast<uint32_t>(key & 0xFFFFFFFFULL));
+  }
+  std::vector<uint64_t>().swap(keys);
+
+  m_FaceIds.assign(numTriangles + 1, 0);
+  m_Triangles.assign(numTriangles + 1, 0);
+  ParallelContext::ParallelFor<int32_t>(1, numFaces, Detail::FillFacesImpl(&(sorted.front()), &(runStart.front()), &(runOfFace.front()), &(m_FaceStart.front()), &(m_Triangles.front()), &(m_FaceIds.front())));
+  m_FaceIds.resize(numTriangles);
+  m_Triangles.resize(numTriangles);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureFaceIndex::buildFromFaceIds(const int32_t* faceIds, const int32_t* faceLabels, int64_t numTriangles)
+{
+  int32_t maxFaceId = 0;
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    if (faceIds[t] > maxFaceId) { maxFaceId = faceIds[t]; }
+  }
+  int32_t numFaces = maxFaceId + 1;
+
+  m_FaceIds.assign(faceIds, faceIds + numTriangles);
+  m_FaceLabels.assign(2 * numFaces, 0);
+  m_FaceStart.assign(numFaces + 1, 0);
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    if (faceIds[t] >= 0) { m_FaceStart[faceIds[t] + 1]++; }
+  }
+  for (int32_t f = 0; f < numFaces; f++)
+  {
+    m_FaceStart[f + 1] += m_FaceStart[f];
+  }
+
+  // Counting sort of the triangles by face id, which keeps the triangles of each face in order
+  m_Triangles.assign(m_FaceStart[numFaces], 0);
+  std::vector<int64_t> cursor(m_FaceStart.begin(), m_FaceStart.end() - 1);
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    int32_t f = faceIds[t];
+    if (f < 0) { continue; }
+    if (cursor[f] == m_FaceStart[f])
+    {
+      m_FaceLabels[2 * f] = std::min(faceLabels[2 * t], faceLabels[2 * t + 1]);
+      m_FaceLabels[2 * f + 1] = std::max(faceLabels[2 * t], faceLabels[2 * t + 1]);
+    }
+    m_Triangles[cursor[f]++] = t;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int32_t FeatureFaceIndex::getNumberOfFaces() const
+{
+  return static_cast<int32_t>(m_FaceStart.size()) - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int32_t* FeatureFaceIndex::getFaceIds() const
+{
+  return m_FaceIds.empty() ? NULL : &(m_FaceIds.front());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int32_t* FeatureFaceIndex::getFaceLabels(int32_t faceId) const
+{
+  return &(m_FaceLabels[2 * faceId]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t FeatureFaceIndex::getNumberOfTriangles(int32_t faceId) const
+{
+  return m_FaceStart[faceId + 1] - m_FaceStart[faceId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const int64_t* FeatureFaceIndex::getTriangles(int32_t faceId) const
+{
+  return m_Triangles.empty() ? NULL : &(m_Triangles.front()) + m_FaceStart[faceId];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int64_t FeatureFaceIndex::getNumberOfGroupedTriangles() const
+{
+  return m_FaceStart.empty() ? 0 : m_FaceStart.back();
+}
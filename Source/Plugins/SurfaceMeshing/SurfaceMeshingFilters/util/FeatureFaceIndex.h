@@ -0,0 +1,125 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+
+#ifndef _FeatureFaceIndex_H_
+#define _FeatureFaceIndex_H_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+/**
+ * @brief The FeatureFaceIndex class groups the triangles of a surface mesh into feature faces, where a feature
+ * face is the set of all triangles that share the same (unordered) pair of face labels. The grouping is stored
+ * in compressed form: the triangles of each face are held contiguously, in increasing order of triangle index,
+ * so that filters which work face by face (curvature, GBCD, coloring) can walk a face without any lookups.
+ *
+ * Face ids start at 1 and are handed out in the order in which the faces are first encountered when walking
+ * the triangles. Face 0 is reserved; it only holds triangles if a face id array assigns them to it.
+ */
+class FeatureFaceIndex
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureFaceIndex)
+    SIMPL_STATIC_NEW_MACRO(FeatureFaceIndex)
+    SIMPL_TYPE_MACRO(FeatureFaceIndex)
+
+    virtual ~FeatureFaceIndex();
+
+    /**
+     * @brief buildFromFaceLabels Groups the triangles by their face labels. The triangle keys are radix
+     * sorted in parallel, after which the face ids, face sizes and the triangle lists are all derived from
+     * the runs of equal keys
+     * @param faceLabels Face labels, 2 per triangle
+     * @param numTriangles Number of triangles
+     */
+    void buildFromFaceLabels(const int32_t* faceLabels, int64_t numTriangles);
+
+    /**
+     * @brief buildFromFaceIds Groups the triangles by a previously generated feature face id array. The face
+     * labels are taken from the first triangle of each face and triangles with a negative id are left out
+     * @param faceIds Feature face id of each triangle
+     * @param faceLabels Face labels, 2 per triangle
+     * @param numTriangles Number of triangles
+     */
+    void buildFromFaceIds(const int32_t* faceIds, const int32_t* faceLabels, int64_t numTriangles);
+
+    /**
+     * @brief getNumberOfFaces Returns the number of faces including the reserved face 0
+     */
+    int32_t getNumberOfFaces() const;
+
+    /**
+     * @brief getFaceIds Returns the feature face id of every triangle
+     */
+    const int32_t* getFaceIds() const;
+
+    /**
+     * @brief getFaceLabels Returns the two (sorted) labels of a face
+     */
+    const int32_t* getFaceLabels(int32_t faceId) const;
+
+    /**
+     * @brief getNumberOfTriangles Returns the number of triangles in a face
+     */
+    int64_t getNumberOfTriangles(int32_t faceId) const;
+
+    /**
+     * @brief getTriangles Returns the triangle indices of a face; there are getNumberOfTriangles(faceId) of them
+     */
+    const int64_t* getTriangles(int32_t faceId) const;
+
+    /**
+     * @brief getNumberOfGroupedTriangles Returns the number of triangles of all faces together. Since the faces
+     * are stored one after the other, getTriangles(0) points at the triangles of all faces in face order
+     */
+    int64_t getNumberOfGroupedTriangles() const;
+
+  protected:
+    FeatureFaceIndex();
+
+  private:
+    std::vector<int32_t> m_FaceIds;
+    std::vector<int32_t> m_FaceLabels;
+    std::vector<int64_t> m_FaceStart;
+    std::vector<int64_t> m_Triangles;
+
+    FeatureFaceIndex(const FeatureFaceIndex&); // Copy Constructor Not Implemented
+    void operator=(const FeatureFaceIndex&); // Operator '=' Not Implemented
+};
+
+#endif /* _FeatureFaceIndex_H_ */
@@ -0,0 +1,234 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
+
+// -----------------------------------------------------------------------------
+// Checks the labels of a face and that it holds exactly the given triangles
+// -----------------------------------------------------------------------------
+void CheckFace(FeatureFaceIndex::Pointer faceIndex, int32_t faceId, int32_t label0, int32_t label1, const int64_t* triangles, int64_t numTriangles)
+{
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceLabels(faceId)[0], label0)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceLabels(faceId)[1], label1)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfTriangles(faceId), numTriangles)
+  for (int64_t i = 0; i < numTriangles; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getTriangles(faceId)[i], triangles[i])
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceIds()[triangles[i]], faceId)
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Faces are numbered from 1 in the order they are first met, both orders of a label
+// pair belong to the same face and each face lists its triangles in increasing order
+// -----------------------------------------------------------------------------
+void TestBuildFromFaceLabels()
+{
+  const int64_t numTriangles = 9;
+  const int32_t faceLabels[2 * numTriangles] = { 5, 3,
+                                                 -1, 2,
+                                                 3, 5,
+                                                 2, 7,
+                                                 2, -1,
+                                                 5, 3,
+                                                 7, 2,
+                                                 4, 4,
+                                                 -1, 2
+                                               };
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(faceLabels, numTriangles);
+
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfFaces(), 5)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfTriangles(0), 0)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfGroupedTriangles(), numTriangles)
+
+  const int64_t face1[3] = { 0, 2, 5 };
+  CheckFace(faceIndex, 1, 3, 5, face1, 3);
+  const int64_t face2[3] = { 1, 4, 8 };
+  CheckFace(faceIndex, 2, -1, 2, face2, 3);
+  const int64_t face3[2] = { 3, 6 };
+  CheckFace(faceIndex, 3, 2, 7, face3, 2);
+  const int64_t face4[1] = { 7 };
+  CheckFace(faceIndex, 4, 4, 4, face4, 1);
+
+  // getTriangles(0) walks the triangles of all faces in face order
+  const int64_t grouped[numTriangles] = { 0, 2, 5, 1, 4, 8, 3, 6, 7 };
+  for (int64_t i = 0; i < numTriangles; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getTriangles(0)[i], grouped[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Triangles with a negative face id are left out and the labels of a face come
+// from its first triangle, sorted
+// -----------------------------------------------------------------------------
+void TestBuildFromFaceIds()
+{
+  const int64_t numTriangles = 8;
+  const int32_t faceIds[numTriangles] = { 2, -1, 1, 2, 3, -1, 1, 2 };
+  const int32_t faceLabels[2 * numTriangles] = { 9, 4,
+                                                 0, 0,
+                                                 1, 6,
+                                                 4, 9,
+                                                 8, -1,
+                                                 0, 0,
+                                                 6, 1,
+                                                 4, 9
+                                               };
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceIds(faceIds, faceLabels, numTriangles);
+
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfFaces(), 4)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfTriangles(0), 0)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfGroupedTriangles(), 6)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceIds()[1], -1)
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceIds()[5], -1)
+
+  const int64_t face1[2] = { 2, 6 };
+  CheckFace(faceIndex, 1, 1, 6, face1, 2);
+  const int64_t face2[3] = { 0, 3, 7 };
+  CheckFace(faceIndex, 2, 4, 9, face2, 3);
+  const int64_t face3[1] = { 4 };
+  CheckFace(faceIndex, 3, -1, 8, face3, 1);
+}
+
+// -----------------------------------------------------------------------------
+// A mesh with enough triangles to be sorted in several blocks must be grouped the
+// same way as a map from the sorted label pair to the order of first appearance,
+// whatever the number of threads
+// -----------------------------------------------------------------------------
+void TestLargeMesh(int numThreads)
+{
+  const int64_t numTriangles = 300000;
+  uint64_t seed = 20160203;
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+  std::vector<int32_t> faceLabels(2 * numTriangles, 0);
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    faceLabels[2 * t] = static_cast<int32_t>(rg.genrand_res53() * 400) - 1;
+    faceLabels[2 * t + 1] = static_cast<int32_t>(rg.genrand_res53() * 70000) - 1;
+  }
+
+  std::map<std::pair<int32_t, int32_t>, int32_t> faceOfPair;
+  std::vector<int32_t> expectedIds(numTriangles, 0);
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    std::pair<int32_t, int32_t> labels = std::make_pair(std::min(faceLabels[2 * t], faceLabels[2 * t + 1]), std::max(faceLabels[2 * t], faceLabels[2 * t + 1]));
+    std::map<std::pair<int32_t, int32_t>, int32_t>::iterator iter = faceOfPair.find(labels);
+    if (iter == faceOfPair.end())
+    {
+      iter = faceOfPair.insert(std::make_pair(labels, static_cast<int32_t>(faceOfPair.size()) + 1)).first;
+    }
+    expectedIds[t] = iter->second;
+  }
+
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  ParallelContext::SetNumberOfThreads(numThreads);
+  faceIndex->buildFromFaceLabels(&(faceLabels.front()), numTriangles);
+  ParallelContext::SetNumberOfThreads(0);
+
+  int32_t numFaces = static_cast<int32_t>(faceOfPair.size()) + 1;
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfFaces(), numFaces)
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceIds()[t], expectedIds[t])
+  }
+  for (std::map<std::pair<int32_t, int32_t>, int32_t>::iterator iter = faceOfPair.begin(); iter != faceOfPair.end(); ++iter)
+  {
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceLabels(iter->second)[0], iter->first.first)
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getFaceLabels(iter->second)[1], iter->first.second)
+  }
+
+  // The triangle lists of the faces must partition the mesh, each in increasing order
+  std::vector<int64_t> count(numFaces, 0);
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    count[expectedIds[t]]++;
+  }
+  for (int32_t f = 1; f < numFaces; f++)
+  {
+    DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfTriangles(f), count[f])
+    const int64_t* triangles = faceIndex->getTriangles(f);
+    for (int64_t i = 0; i < count[f]; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(expectedIds[triangles[i]], f)
+      if (i > 0) { DREAM3D_REQUIRED(triangles[i - 1], <, triangles[i]) }
+    }
+  }
+
+  // Rebuilding from the face ids just found has to give back the same grouping
+  FeatureFaceIndex::Pointer rebuilt = FeatureFaceIndex::New();
+  rebuilt->buildFromFaceIds(faceIndex->getFaceIds(), &(faceLabels.front()), numTriangles);
+  DREAM3D_REQUIRE_EQUAL(rebuilt->getNumberOfFaces(), numFaces)
+  DREAM3D_REQUIRE_EQUAL(rebuilt->getNumberOfGroupedTriangles(), numTriangles)
+  for (int64_t i = 0; i < numTriangles; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(rebuilt->getTriangles(0)[i], faceIndex->getTriangles(0)[i])
+  }
+  for (int32_t f = 1; f < numFaces; f++)
+  {
+    DREAM3D_REQUIRE_EQUAL(rebuilt->getFaceLabels(f)[0], faceIndex->getFaceLabels(f)[0])
+    DREAM3D_REQUIRE_EQUAL(rebuilt->getFaceLabels(f)[1], faceIndex->getFaceLabels(f)[1])
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestBuildFromFaceLabels() )
+  DREAM3D_REGISTER_TEST( TestBuildFromFaceIds() )
+  DREAM3D_REGISTER_TEST( TestLargeMesh(1) )
+  DREAM3D_REGISTER_TEST( TestLargeMesh(4) )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,411 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+static const QString TriangleDCName("FindGBCDTest_Triangles");
+static const QString FeatureDCName("FindGBCDTest_Features");
+static const int32_t k_NumFeatures = 40;
+static const int32_t k_NumPairs = 90;
+static const int32_t k_NumTriangles = 6000;
+
+/**
+ * @brief The TestMesh struct holds the triangle and Feature data the filter reads. Features alternate
+ * between a cubic and a hexagonal phase, with a few in the unknown phase. Triangle areas are whole
+ * numbers so the GBCD sums are exact whatever order they are added in.
+ */
+struct TestMesh
+{
+  std::vector<int32_t> labels;
+  std::vector<double> normals;
+  std::vector<double> areas;
+  std::vector<float> eulers;
+  std::vector<int32_t> phases;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the FindGBCD Filter from the FilterManager
+  QString filtName = "FindGBCD";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The FindGBCDTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Builds a mesh of random triangles between random pairs of Features. Some pairs
+// touch the outside of the volume (label -1) or join Features of different phases.
+// -----------------------------------------------------------------------------
+TestMesh CreateTestMesh()
+{
+  uint64_t seed = 20151215;
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+
+  TestMesh mesh;
+  mesh.eulers.resize(3 * k_NumFeatures, 0.0f);
+  mesh.phases.resize(k_NumFeatures, 0);
+  for (int32_t i = 1; i < k_NumFeatures; i++)
+  {
+    mesh.eulers[3 * i] = static_cast<float>(SIMPLib::Constants::k_2Pi * rg.genrand_res53());
+    mesh.eulers[3 * i + 1] = acosf(static_cast<float>(2.0 * rg.genrand_res53() - 1.0));
+    mesh.eulers[3 * i + 2] = static_cast<float>(SIMPLib::Constants::k_2Pi * rg.genrand_res53());
+    mesh.phases[i] = (i % 9 == 0) ? 0 : 1 + (i % 2);
+  }
+
+  std::vector<int32_t> pairs(2 * k_NumPairs, 0);
+  for (int32_t p = 0; p < k_NumPairs; p++)
+  {
+    int32_t feature1 = static_cast<int32_t>(rg.genrand_res53() * k_NumFeatures) - 1;
+    int32_t feature2 = static_cast<int32_t>(rg.genrand_res53() * (k_NumFeatures - 1)) + 1;
+    if (feature1 == feature2) { feature1 = 0; }
+    // Most boundaries join two Features of the same phase; the rest show up as cross phase boundaries
+    while (feature1 > 0 && p % 5 != 0 && (mesh.phases[feature1] != mesh.phases[feature2] || feature1 == feature2))
+    {
+      feature2 = (feature2 + 1 < k_NumFeatures) ? feature2 + 1 : 1;
+    }
+    pairs[2 * p] = feature1;
+    pairs[2 * p + 1] = feature2;
+  }
+
+  mesh.labels.resize(2 * k_NumTriangles, 0);
+  mesh.normals.resize(3 * k_NumTriangles, 0.0);
+  mesh.areas.resize(k_NumTriangles, 0.0);
+  for (int32_t t = 0; t < k_NumTriangles; t++)
+  {
+    int32_t p = static_cast<int32_t>(rg.genrand_res53() * k_NumPairs);
+    int32_t side = (rg.genrand_res53() < 0.5) ? 0 : 1;
+    mesh.labels[2 * t] = pairs[2 * p + side];
+    mesh.labels[2 * t + 1] = pairs[2 * p + 1 - side];
+    double normal[3] = { rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5, rg.genrand_res53() - 0.5 };
+    double length = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    for (int32_t i = 0; i < 3; i++)
+    {
+      mesh.normals[3 * t + i] = normal[i] / length;
+    }
+    mesh.areas[t] = 1.0 + floor(8.0 * rg.genrand_res53());
+  }
+  return mesh;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the mesh without the triangles that rejectedPhase could contribute to,
+// and without the triangles that contribute to no phase at all
+// -----------------------------------------------------------------------------
+TestMesh RemovePhase(const TestMesh& mesh, int32_t rejectedPhase)
+{
+  TestMesh kept = mesh;
+  kept.labels.clear();
+  kept.normals.clear();
+  kept.areas.clear();
+  for (int32_t t = 0; t < k_NumTriangles; t++)
+  {
+    int32_t feature1 = mesh.labels[2 * t];
+    int32_t feature2 = mesh.labels[2 * t + 1];
+    if (feature1 < 0 || feature2 < 0) { continue; }
+    if (mesh.phases[feature1] != mesh.phases[feature2] || mesh.phases[feature1] == 0) { continue; }
+    if (mesh.phases[feature1] == rejectedPhase) { continue; }
+    kept.labels.push_back(feature1);
+    kept.labels.push_back(feature2);
+    kept.normals.insert(kept.normals.end(), mesh.normals.begin() + 3 * t, mesh.normals.begin() + 3 * t + 3);
+    kept.areas.push_back(mesh.areas[t]);
+  }
+  return kept;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the mesh with every triangle seen from its other side, in reverse order
+// -----------------------------------------------------------------------------
+TestMesh FlipAndReverse(const TestMesh& mesh)
+{
+  TestMesh flipped = mesh;
+  size_t numTriangles = mesh.areas.size();
+  for (size_t t = 0; t < numTriangles; t++)
+  {
+    size_t r = numTriangles - 1 - t;
+    flipped.labels[2 * r] = mesh.labels[2 * t + 1];
+    flipped.labels[2 * r + 1] = mesh.labels[2 * t];
+    for (size_t i = 0; i < 3; i++)
+    {
+      flipped.normals[3 * r + i] = -mesh.normals[3 * t + i];
+    }
+    flipped.areas[r] = mesh.areas[t];
+  }
+  return flipped;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer CreateDataContainerArray(const TestMesh& mesh)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+
+  int64_t numTriangles = static_cast<int64_t>(mesh.areas.size());
+  DataContainer::Pointer sm = DataContainer::New(TriangleDCName);
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(3);
+  vertices->initializeWithZeros();
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numTriangles, vertices, DREAM3D::Geometry::TriangleGeometry);
+  sm->setGeometry(triangleGeom);
+
+  QVector<size_t> tDims(1, static_cast<size_t>(numTriangles));
+  AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::AttributeMatrixType::Face);
+  QVector<size_t> cDims(1, 2);
+  Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceLabels);
+  std::copy(mesh.labels.begin(), mesh.labels.end(), labels->getPointer(0));
+  cDims[0] = 3;
+  DoubleArrayType::Pointer normals = DoubleArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceNormals);
+  std::copy(mesh.normals.begin(), mesh.normals.end(), normals->getPointer(0));
+  cDims[0] = 1;
+  DoubleArrayType::Pointer areas = DoubleArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceAreas);
+  std::copy(mesh.areas.begin(), mesh.areas.end(), areas->getPointer(0));
+  faceAttrMat->addAttributeArray(labels->getName(), labels);
+  faceAttrMat->addAttributeArray(normals->getName(), normals);
+  faceAttrMat->addAttributeArray(areas->getName(), areas);
+  sm->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+  dca->addDataContainer(sm);
+
+  DataContainer::Pointer m = DataContainer::New(FeatureDCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  size_t dims[3] = { 1, 1, 1 };
+  image->setDimensions(dims);
+  m->setGeometry(image);
+
+  QVector<size_t> fDims(1, static_cast<size_t>(k_NumFeatures));
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(fDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  cDims[0] = 3;
+  FloatArrayType::Pointer eulers = FloatArrayType::CreateArray(fDims, cDims, DREAM3D::FeatureData::EulerAngles);
+  std::copy(mesh.eulers.begin(), mesh.eulers.end(), eulers->getPointer(0));
+  cDims[0] = 1;
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(fDims, cDims, DREAM3D::FeatureData::Phases);
+  std::copy(mesh.phases.begin(), mesh.phases.end(), phases->getPointer(0));
+  featureAttrMat->addAttributeArray(eulers->getName(), eulers);
+  featureAttrMat->addAttributeArray(phases->getName(), phases);
+  m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+  QVector<size_t> eDims(1, 3);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+  crystalStructures->setValue(2, Ebsd::CrystalStructure::Hexagonal_High);
+  ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+  m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+  dca->addDataContainer(m);
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DoubleArrayType::Pointer RunFindGBCD(const TestMesh& mesh, int numThreads)
+{
+  DataContainerArray::Pointer dca = CreateDataContainerArray(mesh);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("FindGBCD");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(TriangleDCName, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::FaceData::SurfaceMeshFaceLabels));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var), true)
+  var.setValue(DataArrayPath(TriangleDCName, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::FaceData::SurfaceMeshFaceNormals));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceMeshFaceNormalsArrayPath", var), true)
+  var.setValue(DataArrayPath(TriangleDCName, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::FaceData::SurfaceMeshFaceAreas));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceMeshFaceAreasArrayPath", var), true)
+  var.setValue(DataArrayPath(FeatureDCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::EulerAngles));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureEulerAnglesArrayPath", var), true)
+  var.setValue(DataArrayPath(FeatureDCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeaturePhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(FeatureDCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::CrystalStructures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CrystalStructuresArrayPath", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  AttributeMatrix::Pointer faceEnsembleAttrMat = dca->getDataContainer(TriangleDCName)->getAttributeMatrix(DREAM3D::Defaults::FaceEnsembleAttributeMatrixName);
+  DREAM3D_REQUIRE(faceEnsembleAttrMat.get() != NULL)
+  DoubleArrayType::Pointer gbcd = boost::dynamic_pointer_cast<DoubleArrayType>(faceEnsembleAttrMat->getAttributeArray(DREAM3D::EnsembleData::GBCD));
+  DREAM3D_REQUIRE(gbcd.get() != NULL)
+  return gbcd;
+}
+
+// -----------------------------------------------------------------------------
+// Compares the part of two GBCDs that belongs to one phase
+// -----------------------------------------------------------------------------
+void ComparePhase(DoubleArrayType::Pointer gbcd1, DoubleArrayType::Pointer gbcd2, size_t phase)
+{
+  DREAM3D_REQUIRE_EQUAL(gbcd1->getSize(), gbcd2->getSize())
+  size_t numBins = gbcd1->getSize() / 3;
+  for (size_t i = phase * numBins; i < (phase + 1) * numBins; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(gbcd1->getValue(i), gbcd2->getValue(i))
+  }
+}
+
+// -----------------------------------------------------------------------------
+// The GBCD must not depend on the number of threads, and each phase's part must be
+// normalized to an average of 1 multiple of random distribution
+// -----------------------------------------------------------------------------
+int TestThreadCountIndependence()
+{
+  TestMesh mesh = CreateTestMesh();
+  DoubleArrayType::Pointer serial = RunFindGBCD(mesh, 1);
+  DoubleArrayType::Pointer parallel = RunFindGBCD(mesh, 4);
+  ComparePhase(serial, parallel, 1);
+  ComparePhase(serial, parallel, 2);
+
+  size_t numBins = serial->getSize() / 3;
+  for (size_t phase = 1; phase < 3; phase++)
+  {
+    double sum = 0.0;
+    size_t nonZeroBins = 0;
+    for (size_t i = phase * numBins; i < (phase + 1) * numBins; i++)
+    {
+      sum += serial->getValue(i);
+      if (serial->getValue(i) > 0.0) { nonZeroBins++; }
+    }
+    DREAM3D_REQUIRE(fabs(sum / static_cast<double>(numBins) - 1.0) < 1.0e-9)
+    DREAM3D_REQUIRED(nonZeroBins, >, 0)
+  }
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Each phase's part of the GBCD only depends on the boundaries inside that phase
+// -----------------------------------------------------------------------------
+int TestPhaseIndependence()
+{
+  TestMesh mesh = CreateTestMesh();
+  DoubleArrayType::Pointer full = RunFindGBCD(mesh, 4);
+  DoubleArrayType::Pointer cubicOnly = RunFindGBCD(RemovePhase(mesh, 2), 4);
+  DoubleArrayType::Pointer hexagonalOnly = RunFindGBCD(RemovePhase(mesh, 1), 4);
+  ComparePhase(full, cubicOnly, 1);
+  ComparePhase(full, hexagonalOnly, 2);
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Every triangle is binned from both of its sides, so neither the order of the
+// triangles nor the order of the labels on a triangle changes the GBCD
+// -----------------------------------------------------------------------------
+int TestTriangleOrderIndependence()
+{
+  TestMesh mesh = CreateTestMesh();
+  DoubleArrayType::Pointer gbcd = RunFindGBCD(mesh, 4);
+  DoubleArrayType::Pointer flipped = RunFindGBCD(FlipAndReverse(mesh), 4);
+  ComparePhase(gbcd, flipped, 1);
+  ComparePhase(gbcd, flipped, 2);
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("FindGBCDTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestThreadCountIndependence() )
+  DREAM3D_REGISTER_TEST( TestPhaseIndependence() )
+  DREAM3D_REGISTER_TEST( TestTriangleOrderIndependence() )
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,197 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+#include "SurfaceMeshing/SurfaceMeshingFilters/FindNRingNeighbors.h"
+#include "SurfaceMeshing/SurfaceMeshingFilters/util/FeatureFaceIndex.h"
+
+/**
+ * The test mesh is a strip of 5 grid cells, 6 vertices long and 2 vertices wide. Bottom vertex x
+ * has index x and top vertex x has index 6 + x. Cell c is split into triangle 2c = (c, c + 1, 7 + c)
+ * and triangle 2c + 1 = (c, 7 + c, 6 + c), so triangle 2c shares a vertex with triangles
+ * 2c - 2, 2c + 1, 2c + 2 and 2c + 3 while triangle 2c + 1 shares one with 2c - 2, 2c - 1, 2c and 2c + 3.
+ */
+static const int64_t k_NumVertices = 12;
+static const int64_t k_NumTriangles = 10;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleGeom::Pointer CreateStripMesh()
+{
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(k_NumVertices);
+  float* verts = vertices->getPointer(0);
+  for (int64_t v = 0; v < k_NumVertices; v++)
+  {
+    verts[3 * v] = static_cast<float>(v % 6);
+    verts[3 * v + 1] = static_cast<float>(v / 6);
+    verts[3 * v + 2] = 0.0f;
+  }
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(k_NumTriangles, vertices, DREAM3D::Geometry::TriangleGeometry);
+  for (int64_t c = 0; c < k_NumTriangles / 2; c++)
+  {
+    int64_t lower[3] = { c, c + 1, 7 + c };
+    int64_t upper[3] = { c, 7 + c, 6 + c };
+    triangleGeom->setVertsAtTri(2 * c, lower);
+    triangleGeom->setVertsAtTri(2 * c + 1, upper);
+  }
+  return triangleGeom;
+}
+
+// -----------------------------------------------------------------------------
+// Builds the N ring patch of a seed triangle and compares it with the expected
+// patch, which lists the seed first and then the other triangles in increasing order
+// -----------------------------------------------------------------------------
+void CheckPatch(const FindNRingNeighbors& nRing, FindNRingNeighbors::Scratch& scratch, int64_t seed, const int64_t* expected, size_t numExpected)
+{
+  std::vector<int64_t> patch;
+  nRing.generate(seed, scratch, patch);
+  DREAM3D_REQUIRE_EQUAL(patch.size(), numExpected)
+  for (size_t i = 0; i < numExpected; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(patch[i], expected[i])
+  }
+}
+
+// -----------------------------------------------------------------------------
+// All triangles of the strip belong to the same feature face
+// -----------------------------------------------------------------------------
+void TestSingleFace(int numThreads)
+{
+  TriangleGeom::Pointer triangleGeom = CreateStripMesh();
+  std::vector<int32_t> faceLabels(2 * k_NumTriangles, 1);
+  for (int64_t t = 0; t < k_NumTriangles; t++)
+  {
+    faceLabels[2 * t + 1] = 2;
+  }
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(&(faceLabels.front()), k_NumTriangles);
+
+  FindNRingNeighbors::Pointer nRing = FindNRingNeighbors::New();
+  ParallelContext::SetNumberOfThreads(numThreads);
+  int32_t err = nRing->initialize(triangleGeom, faceIndex);
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(err, >=, 0)
+  FindNRingNeighbors::Scratch scratch;
+
+  nRing->setRing(1);
+  const int64_t oneRing0[4] = { 0, 1, 2, 3 };
+  CheckPatch(*nRing, scratch, 0, oneRing0, 4);
+  const int64_t oneRing4[5] = { 4, 2, 5, 6, 7 };
+  CheckPatch(*nRing, scratch, 4, oneRing4, 5);
+  const int64_t oneRing9[4] = { 9, 6, 7, 8 };
+  CheckPatch(*nRing, scratch, 9, oneRing9, 4);
+
+  nRing->setRing(2);
+  const int64_t twoRing0[6] = { 0, 1, 2, 3, 4, 5 };
+  CheckPatch(*nRing, scratch, 0, twoRing0, 6);
+  // Triangle 1 only touches triangles 0 and 3, so it is 3 rings away from triangle 4
+  const int64_t twoRing4[9] = { 4, 0, 2, 3, 5, 6, 7, 8, 9 };
+  CheckPatch(*nRing, scratch, 4, twoRing4, 9);
+  const int64_t twoRing9[6] = { 9, 4, 5, 6, 7, 8 };
+  CheckPatch(*nRing, scratch, 9, twoRing9, 6);
+}
+
+// -----------------------------------------------------------------------------
+// Triangle 6 separates two feature faces, so the patches of the other face have
+// to walk around it. Triangle 3 lists its labels the other way around but still
+// belongs to the same face as its neighbors.
+// -----------------------------------------------------------------------------
+void TestSplitFaces(int numThreads)
+{
+  TriangleGeom::Pointer triangleGeom = CreateStripMesh();
+  std::vector<int32_t> faceLabels(2 * k_NumTriangles, 1);
+  for (int64_t t = 0; t < k_NumTriangles; t++)
+  {
+    faceLabels[2 * t + 1] = 2;
+  }
+  faceLabels[2 * 3] = 2;
+  faceLabels[2 * 3 + 1] = 1;
+  faceLabels[2 * 6] = 3;
+  faceLabels[2 * 6 + 1] = 2;
+  FeatureFaceIndex::Pointer faceIndex = FeatureFaceIndex::New();
+  faceIndex->buildFromFaceLabels(&(faceLabels.front()), k_NumTriangles);
+  DREAM3D_REQUIRE_EQUAL(faceIndex->getNumberOfFaces(), 3)
+
+  FindNRingNeighbors::Pointer nRing = FindNRingNeighbors::New();
+  ParallelContext::SetNumberOfThreads(numThreads);
+  int32_t err = nRing->initialize(triangleGeom, faceIndex);
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(err, >=, 0)
+  FindNRingNeighbors::Scratch scratch;
+
+  nRing->setRing(1);
+  const int64_t oneRing4[4] = { 4, 2, 5, 7 };
+  CheckPatch(*nRing, scratch, 4, oneRing4, 4);
+  const int64_t oneRing8[2] = { 8, 9 };
+  CheckPatch(*nRing, scratch, 8, oneRing8, 2);
+
+  nRing->setRing(2);
+  const int64_t twoRing4[7] = { 4, 0, 2, 3, 5, 7, 9 };
+  CheckPatch(*nRing, scratch, 4, twoRing4, 7);
+
+  nRing->setRing(3);
+  const int64_t threeRing4[9] = { 4, 0, 1, 2, 3, 5, 7, 8, 9 };
+  CheckPatch(*nRing, scratch, 4, threeRing4, 9);
+
+  // However many rings are asked for, triangle 6 has no neighbors in its own face
+  const int64_t threeRing6[1] = { 6 };
+  CheckPatch(*nRing, scratch, 6, threeRing6, 1);
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestSingleFace(1) )
+  DREAM3D_REGISTER_TEST( TestSingleFace(4) )
+  DREAM3D_REGISTER_TEST( TestSplitFaces(1) )
+  DREAM3D_REGISTER_TEST( TestSplitFaces(4) )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
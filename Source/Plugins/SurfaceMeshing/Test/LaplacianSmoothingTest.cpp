@@ -0,0 +1,429 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "SurfaceMeshingTestFileLocations.h"
+
+static const QString TriangleDCName("LaplacianSmoothingTest_Triangles");
+
+/**
+ * @brief The Smoothing struct holds the parameters the filter is run with
+ */
+struct Smoothing
+{
+  int iterations;
+  float lambda;
+  float tripleLineLambda;
+  float quadPointLambda;
+  float surfacePointLambda;
+  float surfaceTripleLineLambda;
+  float surfaceQuadPointLambda;
+  bool useTaubin;
+  float muFactor;
+};
+
+/**
+ * @brief The TestMesh struct holds a flat grid of vertices, split into two triangles per
+ * grid cell, along with the node type of every vertex
+ */
+struct TestMesh
+{
+  std::vector<float> vertices;
+  std::vector<int64_t> triangles;
+  std::vector<int8_t> nodeTypes;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the LaplacianSmoothing Filter from the FilterManager
+  QString filtName = "LaplacianSmoothing";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The LaplacianSmoothingTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SurfaceMeshing Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Builds a dim x dim grid of vertices in the z = 0 plane. Each grid cell is split along
+// its (x, y) to (x + 1, y + 1) diagonal, so an interior vertex has 6 neighbors. Every
+// vertex starts out as a default node.
+// -----------------------------------------------------------------------------
+TestMesh CreateGridMesh(int64_t dim)
+{
+  TestMesh mesh;
+  mesh.vertices.resize(3 * dim * dim, 0.0f);
+  mesh.nodeTypes.resize(dim * dim, DREAM3D::SurfaceMesh::NodeType::Default);
+  for (int64_t y = 0; y < dim; y++)
+  {
+    for (int64_t x = 0; x < dim; x++)
+    {
+      mesh.vertices[3 * (y * dim + x)] = static_cast<float>(x);
+      mesh.vertices[3 * (y * dim + x) + 1] = static_cast<float>(y);
+    }
+  }
+  for (int64_t y = 0; y < dim - 1; y++)
+  {
+    for (int64_t x = 0; x < dim - 1; x++)
+    {
+      int64_t v00 = y * dim + x;
+      int64_t v10 = v00 + 1;
+      int64_t v01 = v00 + dim;
+      int64_t v11 = v01 + 1;
+      int64_t tris[6] = { v00, v10, v11, v00, v11, v01 };
+      mesh.triangles.insert(mesh.triangles.end(), tris, tris + 6);
+    }
+  }
+  return mesh;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer CreateDataContainerArray(const TestMesh& mesh)
+{
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+
+  int64_t numVertices = static_cast<int64_t>(mesh.nodeTypes.size());
+  int64_t numTriangles = static_cast<int64_t>(mesh.triangles.size() / 3);
+  DataContainer::Pointer sm = DataContainer::New(TriangleDCName);
+  SharedVertexList::Pointer vertices = TriangleGeom::CreateSharedVertexList(numVertices);
+  std::copy(mesh.vertices.begin(), mesh.vertices.end(), vertices->getPointer(0));
+  TriangleGeom::Pointer triangleGeom = TriangleGeom::CreateGeometry(numTriangles, vertices, DREAM3D::Geometry::TriangleGeometry);
+  std::copy(mesh.triangles.begin(), mesh.triangles.end(), triangleGeom->getTriPointer(0));
+  sm->setGeometry(triangleGeom);
+
+  QVector<size_t> tDims(1, static_cast<size_t>(numTriangles));
+  AttributeMatrix::Pointer faceAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::AttributeMatrixType::Face);
+  QVector<size_t> cDims(1, 2);
+  Int32ArrayType::Pointer labels = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::FaceData::SurfaceMeshFaceLabels);
+  for (int64_t t = 0; t < numTriangles; t++)
+  {
+    labels->setComponent(t, 0, 1);
+    labels->setComponent(t, 1, 2);
+  }
+  faceAttrMat->addAttributeArray(labels->getName(), labels);
+  sm->addAttributeMatrix(faceAttrMat->getName(), faceAttrMat);
+
+  tDims[0] = static_cast<size_t>(numVertices);
+  AttributeMatrix::Pointer vertexAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::VertexAttributeMatrixName, DREAM3D::AttributeMatrixType::Vertex);
+  cDims[0] = 1;
+  Int8ArrayType::Pointer nodeTypes = Int8ArrayType::CreateArray(tDims, cDims, DREAM3D::VertexData::SurfaceMeshNodeType);
+  std::copy(mesh.nodeTypes.begin(), mesh.nodeTypes.end(), nodeTypes->getPointer(0));
+  vertexAttrMat->addAttributeArray(nodeTypes->getName(), nodeTypes);
+  sm->addAttributeMatrix(vertexAttrMat->getName(), vertexAttrMat);
+  dca->addDataContainer(sm);
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+// Runs the filter on a copy of the mesh and returns the smoothed vertex positions
+// -----------------------------------------------------------------------------
+std::vector<float> RunLaplacianSmoothing(const TestMesh& mesh, const Smoothing& params, int numThreads)
+{
+  DataContainerArray::Pointer dca = CreateDataContainerArray(mesh);
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("LaplacianSmoothing");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(TriangleDCName, DREAM3D::Defaults::VertexAttributeMatrixName, DREAM3D::VertexData::SurfaceMeshNodeType));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceMeshNodeTypeArrayPath", var), true)
+  var.setValue(DataArrayPath(TriangleDCName, DREAM3D::Defaults::FaceAttributeMatrixName, DREAM3D::FaceData::SurfaceMeshFaceLabels));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceMeshFaceLabelsArrayPath", var), true)
+  var.setValue(params.iterations);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("IterationSteps", var), true)
+  var.setValue(params.lambda);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("Lambda", var), true)
+  var.setValue(params.tripleLineLambda);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("TripleLineLambda", var), true)
+  var.setValue(params.quadPointLambda);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("QuadPointLambda", var), true)
+  var.setValue(params.surfacePointLambda);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfacePointLambda", var), true)
+  var.setValue(params.surfaceTripleLineLambda);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceTripleLineLambda", var), true)
+  var.setValue(params.surfaceQuadPointLambda);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceQuadPointLambda", var), true)
+  var.setValue(params.useTaubin);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("UseTaubinSmoothing", var), true)
+  var.setValue(params.muFactor);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("MuFactor", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  TriangleGeom::Pointer triangleGeom = dca->getDataContainer(TriangleDCName)->getGeometryAs<TriangleGeom>();
+  DREAM3D_REQUIRE(triangleGeom.get() != NULL)
+  DREAM3D_REQUIRE_EQUAL(triangleGeom->getNumberOfVertices(), static_cast<int64_t>(mesh.nodeTypes.size()))
+  float* verts = triangleGeom->getVertexPointer(0);
+  return std::vector<float>(verts, verts + mesh.vertices.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float NodeLambda(int8_t nodeType, const Smoothing& params)
+{
+  switch (nodeType)
+  {
+    case DREAM3D::SurfaceMesh::NodeType::Default:
+      return params.lambda;
+    case DREAM3D::SurfaceMesh::NodeType::TriplePoint:
+      return params.tripleLineLambda;
+    case DREAM3D::SurfaceMesh::NodeType::QuadPoint:
+      return params.quadPointLambda;
+    case DREAM3D::SurfaceMesh::NodeType::SurfaceDefault:
+      return params.surfacePointLambda;
+    case DREAM3D::SurfaceMesh::NodeType::SurfaceTriplePoint:
+      return params.surfaceTripleLineLambda;
+    case DREAM3D::SurfaceMesh::NodeType::SurfaceQuadPoint:
+      return params.surfaceQuadPointLambda;
+    default:
+      return 0.0f;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Smooths the mesh one vertex at a time, each step moving every vertex toward the
+// average of its neighbors' positions from the previous step
+// -----------------------------------------------------------------------------
+std::vector<float> SerialLaplacianSmoothing(const TestMesh& mesh, const Smoothing& params)
+{
+  size_t numVertices = mesh.nodeTypes.size();
+  std::vector<std::set<int64_t> > neighbors(numVertices);
+  for (size_t t = 0; t < mesh.triangles.size(); t += 3)
+  {
+    for (size_t i = 0; i < 3; i++)
+    {
+      neighbors[mesh.triangles[t + i]].insert(mesh.triangles[t + (i + 1) % 3]);
+      neighbors[mesh.triangles[t + (i + 1) % 3]].insert(mesh.triangles[t + i]);
+    }
+  }
+
+  std::vector<float> factors(1, 1.0f);
+  if (params.useTaubin == true) { factors.push_back(params.muFactor); }
+
+  std::vector<float> current = mesh.vertices;
+  std::vector<float> next = mesh.vertices;
+  for (int q = 0; q < params.iterations; q++)
+  {
+    for (size_t f = 0; f < factors.size(); f++)
+    {
+      for (size_t v = 0; v < numVertices; v++)
+      {
+        float ll = factors[f] * NodeLambda(mesh.nodeTypes[v], params);
+        for (size_t j = 0; j < 3; j++)
+        {
+          next[3 * v + j] = current[3 * v + j];
+          if (ll == 0.0f || neighbors[v].empty()) { continue; }
+          double sum = 0.0;
+          for (std::set<int64_t>::const_iterator n = neighbors[v].begin(); n != neighbors[v].end(); ++n)
+          {
+            sum += current[3 * (*n) + j];
+          }
+          double average = sum / static_cast<double>(neighbors[v].size());
+          next[3 * v + j] = current[3 * v + j] + ll * (average - current[3 * v + j]);
+        }
+      }
+      current.swap(next);
+    }
+  }
+  return current;
+}
+
+// -----------------------------------------------------------------------------
+// One iteration on a 4 x 4 grid with a single raised vertex. Every node type gets its
+// own lambda, so the expected heights can be worked out by hand.
+// -----------------------------------------------------------------------------
+int TestHandComputedStep()
+{
+  const int64_t dim = 4;
+  TestMesh mesh = CreateGridMesh(dim);
+  for (int64_t y = 0; y < dim; y++)
+  {
+    for (int64_t x = 0; x < dim; x++)
+    {
+      if (x == 0 || y == 0 || x == dim - 1 || y == dim - 1)
+      {
+        mesh.nodeTypes[y * dim + x] = DREAM3D::SurfaceMesh::NodeType::SurfaceDefault;
+      }
+    }
+  }
+  // Vertex (1, 1) is raised; (1, 2) is a default node, (2, 2) a triple line node and (2, 1)
+  // a quad point. All three have (1, 1) as one of their 6 neighbors.
+  mesh.vertices[3 * (1 * dim + 1) + 2] = 1.0f;
+  mesh.nodeTypes[2 * dim + 2] = DREAM3D::SurfaceMesh::NodeType::TriplePoint;
+  mesh.nodeTypes[1 * dim + 2] = DREAM3D::SurfaceMesh::NodeType::QuadPoint;
+
+  Smoothing params = { 1, 0.25f, 0.1f, 0.0f, 0.0f, 0.5f, 0.5f, false, -1.03f };
+  std::vector<float> smoothed = RunLaplacianSmoothing(mesh, params, 1);
+
+  for (int64_t y = 0; y < dim; y++)
+  {
+    for (int64_t x = 0; x < dim; x++)
+    {
+      int64_t v = y * dim + x;
+      DREAM3D_REQUIRE_EQUAL(smoothed[3 * v], static_cast<float>(x))
+      DREAM3D_REQUIRE_EQUAL(smoothed[3 * v + 1], static_cast<float>(y))
+      float expected = 0.0f;
+      if (x == 1 && y == 1) { expected = 0.75f; }
+      else if (x == 1 && y == 2) { expected = 0.25f / 6.0f; }
+      else if (x == 2 && y == 2) { expected = 0.1f / 6.0f; }
+      DREAM3D_REQUIRE(fabs(smoothed[3 * v + 2] - expected) < 1.0e-6)
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Several Taubin iterations on a bumpy grid with random node types must match the serial
+// reference whatever the number of threads, and nodes with a zero lambda must not move
+// -----------------------------------------------------------------------------
+int TestMatchesSerialSmoothing()
+{
+  const int64_t dim = 20;
+  TestMesh mesh = CreateGridMesh(dim);
+
+  uint64_t seed = 20160127;
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+  const int8_t types[7] = { DREAM3D::SurfaceMesh::NodeType::Unused, DREAM3D::SurfaceMesh::NodeType::Default,
+                            DREAM3D::SurfaceMesh::NodeType::TriplePoint, DREAM3D::SurfaceMesh::NodeType::QuadPoint,
+                            DREAM3D::SurfaceMesh::NodeType::SurfaceDefault, DREAM3D::SurfaceMesh::NodeType::SurfaceTriplePoint,
+                            DREAM3D::SurfaceMesh::NodeType::SurfaceQuadPoint
+                          };
+  for (size_t v = 0; v < mesh.nodeTypes.size(); v++)
+  {
+    mesh.vertices[3 * v] += static_cast<float>(0.2 * rg.genrand_res53() - 0.1);
+    mesh.vertices[3 * v + 1] += static_cast<float>(0.2 * rg.genrand_res53() - 0.1);
+    mesh.vertices[3 * v + 2] = static_cast<float>(rg.genrand_res53());
+    mesh.nodeTypes[v] = types[static_cast<int32_t>(rg.genrand_res53() * 7) % 7];
+  }
+
+  Smoothing params = { 5, 0.3f, 0.2f, 0.0f, 0.15f, 0.1f, 0.05f, true, -0.32f };
+  std::vector<float> expected = SerialLaplacianSmoothing(mesh, params);
+  std::vector<float> serial = RunLaplacianSmoothing(mesh, params, 1);
+  std::vector<float> parallel = RunLaplacianSmoothing(mesh, params, 4);
+
+  size_t movedTripleLines = 0;
+  for (size_t v = 0; v < mesh.nodeTypes.size(); v++)
+  {
+    for (size_t j = 0; j < 3; j++)
+    {
+      DREAM3D_REQUIRE_EQUAL(serial[3 * v + j], parallel[3 * v + j])
+      DREAM3D_REQUIRE(fabs(serial[3 * v + j] - expected[3 * v + j]) < 1.0e-4)
+      if (mesh.nodeTypes[v] == DREAM3D::SurfaceMesh::NodeType::QuadPoint || mesh.nodeTypes[v] == DREAM3D::SurfaceMesh::NodeType::Unused)
+      {
+        DREAM3D_REQUIRE_EQUAL(serial[3 * v + j], mesh.vertices[3 * v + j])
+      }
+    }
+    if (mesh.nodeTypes[v] == DREAM3D::SurfaceMesh::NodeType::TriplePoint && serial[3 * v + 2] != mesh.vertices[3 * v + 2]) { movedTripleLines++; }
+  }
+  DREAM3D_REQUIRED(movedTripleLines, >, 0)
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("LaplacianSmoothingTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestHandComputedStep() )
+  DREAM3D_REGISTER_TEST( TestMatchesSerialSmoothing() )
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -40,7 +40,6 @@
 #include <tbb/parallel_for.h>
 #include <tbb/blocked_range.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 #include "SIMPLib/Common/Constants.h"
@@ -58,6 +57,7 @@
 #include "SIMPLib/DataArrays/DynamicListArray.hpp"
 
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 
@@ -509,8 +509,8 @@ void InsertAtoms::execute()
   SIMPL_RANDOMNG_NEW()
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
   // pull down faces
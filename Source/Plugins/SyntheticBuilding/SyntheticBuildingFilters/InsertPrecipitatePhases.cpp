@@ -36,6 +36,14 @@
 
 #include "InsertPrecipitatePhases.h"
 
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -51,11 +59,243 @@
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/StatsData/PrecipitateStatsData.h"
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 
+#if (CMP_SIZEOF_SIZE_T == 4)
+typedef int32_t DimType;
+#else
+typedef int64_t DimType;
+#endif
+
+namespace Detail
+{
+  // Edge length, in voxels, of the blocks used to find precipitates that may be rasterized concurrently
+  static const DimType PrecipitateBlockSize = 16;
+
+  /**
+   * @brief precipitateRadii Computes the three semi-axis lengths of a precipitate. ShapeOps keep state
+   * from radcur1() that inside() relies on, so callers must use the same ShapeOps for both
+   * @param shapeOps Shape operators, one per shape class
+   * @param shapeclass Shape class of the precipitate
+   * @param volcur Volume of the precipitate
+   * @param bovera b/a aspect ratio
+   * @param covera c/a aspect ratio
+   * @param omega3 Omega3 value of the precipitate
+   * @param radcur Output semi-axis lengths
+   */
+  static void precipitateRadii(QVector<ShapeOps::Pointer>& shapeOps, uint32_t shapeclass, float volcur, float bovera, float covera, float omega3, float radcur[3])
+  {
+    // init any values for each of the Shape Ops
+    for (int32_t iter = 0; iter < shapeOps.size(); iter++)
+    {
+      shapeOps[iter]->init();
+    }
+    // Create our Argument Map
+    QMap<ShapeOps::ArgName, float> shapeArgMap;
+    shapeArgMap[ShapeOps::Omega3] = omega3;
+    shapeArgMap[ShapeOps::VolCur] = volcur;
+    shapeArgMap[ShapeOps::B_OverA] = bovera;
+    shapeArgMap[ShapeOps::C_OverA] = covera;
+
+    radcur[0] = shapeOps[shapeclass]->radcur1(shapeArgMap);
+    radcur[1] = (radcur[0] * bovera);
+    radcur[2] = (radcur[0] * covera);
+  }
+}
+
+/**
+ * @brief The AssignPrecipitateVoxelsImpl class rasterizes a list of precipitates into the Feature Ids. When
+ * findExtents is set it only computes each precipitate's voxel bounding box; otherwise the precipitates in
+ * the list must not share any voxel so they can be written concurrently.
+ */
+class AssignPrecipitateVoxelsImpl
+{
+    DimType dims[3];
+    float res[3];
+    float size[3];
+    bool m_PeriodicBoundaries;
+    bool m_FindExtents;
+    int32_t m_FirstPrecipitateFeature;
+    int32_t* m_FeatureIds;
+    float* m_Centroids;
+    float* m_AxisLengths;
+    float* m_AxisEulerAngles;
+    float* m_Volumes;
+    float* m_Omega3s;
+    int32_t* m_FeaturePhases;
+    uint32_t* m_ShapeTypes;
+    const size_t* m_Precipitates;
+    DimType* m_Extents;
+
+  public:
+    AssignPrecipitateVoxelsImpl(DimType* dimensions, float* resolution, float* volumeSize, bool periodicBoundaries, bool findExtents, int32_t firstPrecipitateFeature,
+                                int32_t* featureIds, float* centroids, float* axisLengths, float* axisEulerAngles, float* volumes, float* omega3s,
+                                int32_t* featurePhases, uint32_t* shapeTypes, const size_t* precipitates, DimType* extents) :
+      m_PeriodicBoundaries(periodicBoundaries),
+      m_FindExtents(findExtents),
+      m_FirstPrecipitateFeature(firstPrecipitateFeature),
+      m_FeatureIds(featureIds),
+      m_Centroids(centroids),
+      m_AxisLengths(axisLengths),
+      m_AxisEulerAngles(axisEulerAngles),
+      m_Volumes(volumes),
+      m_Omega3s(omega3s),
+      m_FeaturePhases(featurePhases),
+      m_ShapeTypes(shapeTypes),
+      m_Precipitates(precipitates),
+      m_Extents(extents)
+    {
+      for (int32_t i = 0; i < 3; i++)
+      {
+        dims[i] = dimensions[i];
+        res[i] = resolution[i];
+        size[i] = volumeSize[i];
+      }
+    }
+    virtual ~AssignPrecipitateVoxelsImpl() {}
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void convert(size_t start, size_t end) const
+    {
+      // Each task gets its own ShapeOps since they are not safe to share between threads
+      QVector<ShapeOps::Pointer> shapeOps = ShapeOps::getShapeOpsQVector();
+      for (size_t p = start; p < end; p++)
+      {
+        size_t i = m_Precipitates[p];
+        uint32_t shapeclass = m_ShapeTypes[m_FeaturePhases[i]];
+        if (shapeclass >= static_cast<uint32_t>(shapeOps.size())) { continue; }
+        float radcur[3] = { 0.0f, 0.0f, 0.0f };
+        Detail::precipitateRadii(shapeOps, shapeclass, m_Volumes[i], m_AxisLengths[3 * i + 1], m_AxisLengths[3 * i + 2], m_Omega3s[i], radcur);
+        if (m_FindExtents == true) { findExtents(i, radcur[0]); }
+        else { assignPrecipitate(i, shapeOps[shapeclass], radcur); }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void findExtents(size_t i, float radcur1) const
+    {
+      DimType column = static_cast<DimType>( (m_Centroids[3 * i] - (res[0] / 2.0f)) / res[0] );
+      DimType row = static_cast<DimType>( (m_Centroids[3 * i + 1] - (res[1] / 2.0f)) / res[1] );
+      DimType plane = static_cast<DimType>( (m_Centroids[3 * i + 2] - (res[2] / 2.0f)) / res[2] );
+      DimType* extents = m_Extents + 6 * i;
+      extents[0] = DimType(column - ((radcur1 / res[0]) + 1));
+      extents[1] = DimType(column + ((radcur1 / res[0]) + 1));
+      extents[2] = DimType(row - ((radcur1 / res[1]) + 1));
+      extents[3] = DimType(row + ((radcur1 / res[1]) + 1));
+      extents[4] = DimType(plane - ((radcur1 / res[2]) + 1));
+      extents[5] = DimType(plane + ((radcur1 / res[2]) + 1));
+      for (int32_t d = 0; d < 3; d++)
+      {
+        if (m_PeriodicBoundaries == true)
+        {
+          if (extents[2 * d] < -dims[d]) { extents[2 * d] = -dims[d]; }
+          if (extents[2 * d + 1] > 2 * dims[d] - 1) { extents[2 * d + 1] = (2 * dims[d] - 1); }
+        }
+        if (m_PeriodicBoundaries == false)
+        {
+          if (extents[2 * d] < 0) { extents[2 * d] = 0; }
+          if (extents[2 * d + 1] > dims[d] - 1) { extents[2 * d + 1] = dims[d] - 1; }
+        }
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void assignPrecipitate(size_t i, ShapeOps::Pointer shapeOps, float radcur[3]) const
+    {
+      float xc = m_Centroids[3 * i];
+      float yc = m_Centroids[3 * i + 1];
+      float zc = m_Centroids[3 * i + 2];
+      float ga[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
+      FOrientArrayType om(9, 0.0);
+      FOrientTransformsType::eu2om(FOrientArrayType(&(m_AxisEulerAngles[3 * i]), 3), om);
+      om.toGMatrix(ga);
+
+      DimType column = 0, row = 0, plane = 0, index = 0;
+      float coords[3] = { 0.0f, 0.0f, 0.0f };
+      float coordsRotated[3] = { 0.0f, 0.0f, 0.0f };
+      const DimType* extents = m_Extents + 6 * i;
+      if (extents[5] < extents[4]) { return; }
+      // The inside test is run for a whole column of planes at once
+      size_t rowLength = static_cast<size_t>(extents[5] - extents[4] + 1);
+      std::vector<float> axis1comps(rowLength, 0.0f);
+      std::vector<float> axis2comps(rowLength, 0.0f);
+      std::vector<float> axis3comps(rowLength, 0.0f);
+      std::vector<float> insides(rowLength, -1.0f);
+      for (DimType iter1 = extents[0]; iter1 < extents[1] + 1; iter1++)
+      {
+        for (DimType iter2 = extents[2]; iter2 < extents[3] + 1; iter2++)
+        {
+          column = iter1;
+          row = iter2;
+          if (iter1 < 0) { column = iter1 + dims[0]; }
+          if (iter1 > dims[0] - 1) { column = iter1 - dims[0]; }
+          if (iter2 < 0) { row = iter2 + dims[1]; }
+          if (iter2 > dims[1] - 1) { row = iter2 - dims[1]; }
+          for (DimType iter3 = extents[4]; iter3 < extents[5] + 1; iter3++)
+          {
+            plane = iter3;
+            if (iter3 < 0) { plane = iter3 + dims[2]; }
+            if (iter3 > dims[2] - 1) { plane = iter3 - dims[2]; }
+            coords[0] = float(column) * res[0];
+            coords[1] = float(row) * res[1];
+            coords[2] = float(plane) * res[2];
+            if (iter1 < 0) { coords[0] = coords[0] - size[0]; }
+            if (iter1 > dims[0] - 1) { coords[0] = coords[0] + size[0]; }
+            if (iter2 < 0) { coords[1] = coords[1] - size[1]; }
+            if (iter2 > dims[1] - 1) { coords[1] = coords[1] + size[1]; }
+            if (iter3 < 0) { coords[2] = coords[2] - size[2]; }
+            if (iter3 > dims[2] - 1) { coords[2] = coords[2] + size[2]; }
+            coords[0] = coords[0] - xc;
+            coords[1] = coords[1] - yc;
+            coords[2] = coords[2] - zc;
+            MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
+            size_t k = static_cast<size_t>(iter3 - extents[4]);
+            axis1comps[k] = coordsRotated[0] / radcur[0];
+            axis2comps[k] = coordsRotated[1] / radcur[1];
+            axis3comps[k] = coordsRotated[2] / radcur[2];
+          }
+          shapeOps->insideBatch(&axis1comps[0], &axis2comps[0], &axis3comps[0], &insides[0], rowLength);
+
+          for (DimType iter3 = extents[4]; iter3 < extents[5] + 1; iter3++)
+          {
+            if (insides[iter3 - extents[4]] < 0) { continue; }
+            plane = iter3;
+            if (iter3 < 0) { plane = iter3 + dims[2]; }
+            if (iter3 > dims[2] - 1) { plane = iter3 - dims[2]; }
+            index = (plane * dims[0] * dims[1]) + (row * dims[0]) + column;
+            if (m_FeatureIds[index] > m_FirstPrecipitateFeature)
+            {
+              m_FeatureIds[index] = -2;
+            }
+            if (m_FeatureIds[index] < m_FirstPrecipitateFeature && m_FeatureIds[index] != -2)
+            {
+              m_FeatureIds[index] = static_cast<int32_t>(i);
+            }
+          }
+        }
+      }
+    }
+};
+
 // Include the MOC generated file for this class
 #include "moc_InsertPrecipitatePhases.cpp"
 
@@ -1846,8 +2086,6 @@ float InsertPrecipitatePhases::check_sizedisterror(Precip_t* precip)
 // -----------------------------------------------------------------------------
 void InsertPrecipitatePhases::insert_precipitate(size_t gnum)
 {
-  SIMPL_RANDOMNG_NEW()
-
   float inside = -1.0f;
   int64_t column = 0, row = 0, plane = 0;
   int64_t centercolumn = 0, centerrow = 0, centerplane = 0;
@@ -1859,7 +2097,6 @@ void InsertPrecipitatePhases::insert_precipitate(size_t gnum)
   float bovera = m_AxisLengths[3 * gnum + 1];
   float covera = m_AxisLengths[3 * gnum + 2];
   float omega3 = m_Omega3s[gnum];
-  float radcur1 = 1.0f;
   uint32_t shapeclass = m_ShapeTypes[m_FeaturePhases[gnum]];
 
   // Bail if the shapeclass is not one of our enumerated types
@@ -1871,25 +2108,15 @@ void InsertPrecipitatePhases::insert_precipitate(size_t gnum)
     return;
   }
 
-  // init any values for each of the Shape Ops
-  for (size_t iter = 0; iter < m_ShapeOps.size(); iter++)
-  {
-    m_ShapeOps[iter]->init();
-  }
-  // Create our Argument Map
-  QMap<ShapeOps::ArgName, float> shapeArgMap;
-  shapeArgMap[ShapeOps::Omega3] = omega3;
-  shapeArgMap[ShapeOps::VolCur] = volcur;
-  shapeArgMap[ShapeOps::B_OverA] = bovera;
-  shapeArgMap[ShapeOps::C_OverA] = covera;
-
-  radcur1 = m_ShapeOps[shapeclass]->radcur1(shapeArgMap);
+  float radcur[3] = { 0.0f, 0.0f, 0.0f };
+  Detail::precipitateRadii(m_ShapeOps, shapeclass, volcur, bovera, covera, omega3, radcur);
 
   // adjust radcur1 to make larger exclusion zone to prevent precipitate overlap
-  radcur1 = radcur1 * 2.0f;
+  radcur[0] = radcur[0] * 2.0f;
+  radcur[1] = radcur[1] * 2.0f;
+  radcur[2] = radcur[2] * 2.0f;
+  float radcur1 = radcur[0];
 
-  float radcur2 = (radcur1 * bovera);
-  float radcur3 = (radcur1 * covera);
   float ga[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
   FOrientArrayType om(9, 0.0);
   FOrientTransformsType::eu2om(FOrientArrayType(&(m_AxisEulerAngles[3 * gnum]), 3), om);
@@ -1930,9 +2157,9 @@ void InsertPrecipitatePhases::insert_precipitate(size_t gnum)
         coords[1] = coords[1] - yc;
         coords[2] = coords[2] - zc;
         MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
-        float axis1comp = coordsRotated[0] / radcur1;
-        float axis2comp = coordsRotated[1] / radcur2;
-        float axis3comp = coordsRotated[2] / radcur3;
+        float axis1comp = coordsRotated[0] / radcur[0];
+        float axis2comp = coordsRotated[1] / radcur[1];
+        float axis3comp = coordsRotated[2] / radcur[2];
         inside = m_ShapeOps[shapeclass]->inside(axis1comp, axis2comp, axis3comp);
         if (inside >= 0)
         {
@@ -1955,11 +2182,6 @@ void InsertPrecipitatePhases::assign_voxels()
 
   size_t udims[3] = {0, 0, 0};
   m->getGeometryAs<ImageGeom>()->getDimensions(udims);
-#if (CMP_SIZEOF_SIZE_T == 4)
-  typedef int32_t DimType;
-#else
-  typedef int64_t DimType;
-#endif
   DimType dims[3] =
   {
     static_cast<DimType>(udims[0]),
@@ -1967,19 +2189,15 @@ void InsertPrecipitatePhases::assign_voxels()
     static_cast<DimType>(udims[2]),
   };
 
-  DimType index;
-
   float totalPoints = dims[0] * dims[1] * dims[2];
-  float xRes = m->getGeometryAs<ImageGeom>()->getXRes();
-  float yRes = m->getGeometryAs<ImageGeom>()->getYRes();
-  float zRes = m->getGeometryAs<ImageGeom>()->getZRes();
+  float res[3] =
+  {
+    m->getGeometryAs<ImageGeom>()->getXRes(),
+    m->getGeometryAs<ImageGeom>()->getYRes(),
+    m->getGeometryAs<ImageGeom>()->getZRes()
+  };
+  float volumeSize[3] = { m_SizeX, m_SizeY, m_SizeZ };
 
-  DimType column = 0, row = 0, plane = 0;
-  float inside = 0.0f;
-  float xc = 0.0f, yc = 0.0f, zc = 0.0f;
-  float coordsRotated[3] = { 0.0f, 0.0f, 0.0f };
-  float coords[3] = { 0.0f, 0.0f, 0.0f };
-  DimType xmin = 0, xmax = 0, ymin = 0, ymax = 0, zmin = 0, zmax = 0;
   size_t numFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
   gsizes.resize(numFeatures);
 
@@ -1987,119 +2205,88 @@ void InsertPrecipitatePhases::assign_voxels()
   {
     gsizes[i] = 0;
   }
+
+  std::vector<size_t> precipitates;
   for (size_t i = size_t(m_FirstPrecipitateFeature); i < numFeatures; i++)
   {
-    float volcur = m_Volumes[i];
-    float bovera = m_AxisLengths[3 * i + 1];
-    float covera = m_AxisLengths[3 * i + 2];
-    float omega3 = m_Omega3s[i];
-    xc = m_Centroids[3 * i];
-    yc = m_Centroids[3 * i + 1];
-    zc = m_Centroids[3 * i + 2];
-    float radcur1 = 0.0f;
-    // Unbounded Check for the size of shapeTypes. We assume a 1:1 with phase ; this has been checked in insert_precipitate
-    uint32_t shapeclass = m_ShapeTypes[m_FeaturePhases[i]];
+    precipitates.push_back(i);
+  }
+  size_t numPrecipitates = precipitates.size();
+  std::vector<DimType> extents(6 * numFeatures, 0);
 
-    // init any values for each of the Shape Ops
-    for (size_t iter = 0; iter < m_ShapeOps.size(); iter++)
-    {
-      m_ShapeOps[iter]->init();
-    }
-    // Create our Argument Map
-    QMap<ShapeOps::ArgName, float> shapeArgMap;
-    shapeArgMap[ShapeOps::Omega3] = omega3;
-    shapeArgMap[ShapeOps::VolCur] = volcur;
-    shapeArgMap[ShapeOps::B_OverA] = bovera;
-    shapeArgMap[ShapeOps::C_OverA] = covera;
+  if (numPrecipitates > 0)
+  {
+    AssignPrecipitateVoxelsImpl extentFinder(dims, res, volumeSize, m_PeriodicBoundaries, true, m_FirstPrecipitateFeature, m_FeatureIds, m_Centroids, m_AxisLengths,
+                                             m_AxisEulerAngles, m_Volumes, m_Omega3s, m_FeaturePhases, m_ShapeTypes, &(precipitates.front()), &(extents.front()));
+    ParallelContext::ParallelFor<size_t>(0, numPrecipitates, extentFinder);
+  }
 
-    radcur1 = m_ShapeOps[shapeclass]->radcur1(shapeArgMap);
-
-    float radcur2 = (radcur1 * bovera);
-    float radcur3 = (radcur1 * covera);
-    float ga[3][3] = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f } };
-    FOrientArrayType om(9, 0.0);
-    FOrientTransformsType::eu2om(FOrientArrayType(&(m_AxisEulerAngles[3 * i]), 3), om);
-    om.toGMatrix(ga);
-
-    column = static_cast<DimType>( (xc - (xRes / 2.0f)) / xRes );
-    row = static_cast<DimType>( (yc - (yRes / 2.0f)) / yRes );
-    plane = static_cast<DimType>( (zc - (zRes / 2.0f)) / zRes );
-    xmin = DimType(column - ((radcur1 / xRes) + 1));
-    xmax = DimType(column + ((radcur1 / xRes) + 1));
-    ymin = DimType(row - ((radcur1 / yRes) + 1));
-    ymax = DimType(row + ((radcur1 / yRes) + 1));
-    zmin = DimType(plane - ((radcur1 / zRes) + 1));
-    zmax = DimType(plane + ((radcur1 / zRes) + 1));
-    if (m_PeriodicBoundaries == true)
-    {
-      if (xmin < -dims[0]) { xmin = -dims[0]; }
-      if (xmax > 2 * dims[0] - 1) { xmax = (2 * dims[0] - 1); }
-      if (ymin < -dims[1]) { ymin = -dims[1]; }
-      if (ymax > 2 * dims[1] - 1) { ymax = (2 * dims[1] - 1); }
-      if (zmin < -dims[2]) { zmin = -dims[2]; }
-      if (zmax > 2 * dims[2] - 1) { zmax = (2 * dims[2] - 1); }
-    }
-    if (m_PeriodicBoundaries == false)
+  // Precipitates are rasterized in passes. Each precipitate goes in the pass after the latest pass of any lower
+  // Id precipitate whose bounding box touches one of the same blocks of voxels, so precipitates in a pass never
+  // write the same voxel and overlapping precipitates are still applied in increasing Id order. A single
+  // thread gets the same result from the passes as from one pass over every precipitate.
+  std::vector<std::vector<size_t> > passes;
+  {
+    DimType blockDims[3] = { 0, 0, 0 };
+    for (int32_t d = 0; d < 3; d++)
     {
-      if (xmin < 0) { xmin = 0; }
-      if (xmax > dims[0] - 1) { xmax = dims[0] - 1; }
-      if (ymin < 0) { ymin = 0; }
-      if (ymax > dims[1] - 1) { ymax = dims[1] - 1; }
-      if (zmin < 0) { zmin = 0; }
-      if (zmax > dims[2] - 1) { zmax = dims[2] - 1; }
+      blockDims[d] = (dims[d] + Detail::PrecipitateBlockSize - 1) / Detail::PrecipitateBlockSize;
     }
-    for (DimType iter1 = xmin; iter1 < xmax + 1; iter1++)
+    std::vector<int32_t> blockPasses(blockDims[0] * blockDims[1] * blockDims[2], 0);
+    std::vector<DimType> blocks[3];
+    for (size_t p = 0; p < numPrecipitates; p++)
     {
-      for (DimType iter2 = ymin; iter2 < ymax + 1; iter2++)
+      size_t i = precipitates[p];
+      for (int32_t d = 0; d < 3; d++)
       {
-        for (DimType iter3 = zmin; iter3 < zmax + 1; iter3++)
+        blocks[d].clear();
+        DimType iter = extents[6 * i + 2 * d];
+        while (iter <= extents[6 * i + 2 * d + 1])
         {
-          column = iter1;
-          row = iter2;
-          plane = iter3;
-          if (iter1 < 0) { column = iter1 + dims[0]; }
-          if (iter1 > dims[0] - 1) { column = iter1 - dims[0]; }
-          if (iter2 < 0) { row = iter2 + dims[1]; }
-          if (iter2 > dims[1] - 1) { row = iter2 - dims[1]; }
-          if (iter3 < 0) { plane = iter3 + dims[2]; }
-          if (iter3 > dims[2] - 1) { plane = iter3 - dims[2]; }
-          index = (plane * dims[0] * dims[1]) + (row * dims[0]) + column;
-          inside = -1.0f;
-          coords[0] = float(column) * xRes;
-          coords[1] = float(row) * yRes;
-          coords[2] = float(plane) * zRes;
-          if (iter1 < 0) { coords[0] = coords[0] - m_SizeX; }
-          if (iter1 > dims[0] - 1) { coords[0] = coords[0] + m_SizeX; }
-          if (iter2 < 0) { coords[1] = coords[1] - m_SizeY; }
-          if (iter2 > dims[1] - 1) { coords[1] = coords[1] + m_SizeY; }
-          if (iter3 < 0) { coords[2] = coords[2] - m_SizeZ; }
-          if (iter3 > dims[2] - 1) { coords[2] = coords[2] + m_SizeZ; }
-          coords[0] = coords[0] - xc;
-          coords[1] = coords[1] - yc;
-          coords[2] = coords[2] - zc;
-          MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
-          float axis1comp = coordsRotated[0] / radcur1;
-          float axis2comp = coordsRotated[1] / radcur2;
-          float axis3comp = coordsRotated[2] / radcur3;
-          inside = m_ShapeOps[shapeclass]->inside(axis1comp, axis2comp, axis3comp);
-          if (inside >= 0)
+          DimType wrapped = iter;
+          if (iter < 0) { wrapped = iter + dims[d]; }
+          if (iter > dims[d] - 1) { wrapped = iter - dims[d]; }
+          blocks[d].push_back(wrapped / Detail::PrecipitateBlockSize);
+          DimType next = std::min<DimType>((wrapped / Detail::PrecipitateBlockSize + 1) * Detail::PrecipitateBlockSize, dims[d]);
+          iter = iter + (next - wrapped);
+        }
+      }
+      int32_t pass = 0;
+      for (size_t z = 0; z < blocks[2].size(); z++)
+      {
+        for (size_t y = 0; y < blocks[1].size(); y++)
+        {
+          for (size_t x = 0; x < blocks[0].size(); x++)
           {
-            DimType currentpoint = index;
-            if (m_FeatureIds[currentpoint] > m_FirstPrecipitateFeature)
-            {
-              //oldname = m_FeatureIds[currentpoint];
-              m_FeatureIds[currentpoint] = -2;
-            }
-            if (m_FeatureIds[currentpoint] < m_FirstPrecipitateFeature && m_FeatureIds[currentpoint] != -2)
-            {
-              m_FeatureIds[currentpoint] = static_cast<int32_t>(i);
-            }
+            pass = std::max(pass, blockPasses[(blockDims[0] * blockDims[1] * blocks[2][z]) + (blockDims[0] * blocks[1][y]) + blocks[0][x]]);
           }
         }
       }
+      for (size_t z = 0; z < blocks[2].size(); z++)
+      {
+        for (size_t y = 0; y < blocks[1].size(); y++)
+        {
+          for (size_t x = 0; x < blocks[0].size(); x++)
+          {
+            blockPasses[(blockDims[0] * blockDims[1] * blocks[2][z]) + (blockDims[0] * blocks[1][y]) + blocks[0][x]] = pass + 1;
+          }
+        }
+      }
+      if (static_cast<size_t>(pass) >= passes.size()) { passes.resize(pass + 1); }
+      passes[pass].push_back(i);
     }
   }
 
+  for (size_t pass = 0; pass < passes.size(); pass++)
+  {
+    if (getCancel() == true) { return; }
+    size_t passSize = passes[pass].size();
+    if (passSize == 0) { continue; }
+    AssignPrecipitateVoxelsImpl assigner(dims, res, volumeSize, m_PeriodicBoundaries, false, m_FirstPrecipitateFeature, m_FeatureIds, m_Centroids, m_AxisLengths,
+                                         m_AxisEulerAngles, m_Volumes, m_Omega3s, m_FeaturePhases, m_ShapeTypes, &(passes[pass].front()), &(extents.front()));
+    ParallelContext::ParallelFor<size_t>(0, passSize, assigner);
+  }
+
   QVector<bool> activeObjects(numFeatures, false);
   int32_t gnum = 0;
   for (size_t i = 0; i < static_cast<size_t>(totalPoints); i++)
@@ -339,7 +339,8 @@ class InsertPrecipitatePhases : public AbstractFilter
     float check_RDFerror(int32_t gadd, int32_t gremove, bool double_count);
 
     /**
-     * @brief assign_voxels Assigns precipitate Id values to voxels within the packing grid
+     * @brief assign_voxels Assigns precipitate Id values to voxels within the packing grid. Precipitates
+     * whose bounding boxes share no block of voxels are rasterized concurrently
      */
     void assign_voxels();
 
@@ -36,11 +36,18 @@
 
 #include "MatchCrystallography.h"
 
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
 #include "SIMPLib/FilterParameters/IntFilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
@@ -48,6 +55,7 @@
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/SpaceGroupOps/CubicOps.h"
 #include "OrientationLib/SpaceGroupOps/HexagonalOps.h"
@@ -57,6 +65,334 @@
 
 #include "SyntheticBuilding/SyntheticBuildingConstants.h"
 
+namespace Detail
+{
+  /**
+   * @brief Number of Monte-Carlo moves that are proposed and evaluated together before
+   * being committed in proposal order
+   */
+  static const size_t MoveBatchSize = 1024;
+
+  /**
+   * @brief The Move struct is a single proposed Monte-Carlo move. A swap move assigns
+   * a new orientation sampled from ODF bin Choose to Feature1 and has a negative Feature2;
+   * a switch move exchanges the orientations of Feature1 and Feature2
+   */
+  struct Move
+  {
+    int32_t feature1;
+    int32_t feature2;
+    int32_t choose;
+    uint64_t seed;
+  };
+
+  /**
+   * @brief The MoveResult struct holds the new orientations and the ODF/MDF histogram
+   * updates that committing a Move would apply
+   */
+  struct MoveResult
+  {
+    float eulers1[3];
+    float eulers2[3];
+    QuatF q1;
+    QuatF q2;
+    int32_t odfBin1;
+    int32_t odfBin2;
+    // One entry per neighbor list slot whose misorientation bin changes
+    std::vector<int32_t> mdfFeatures;
+    std::vector<int32_t> mdfSlots;
+    std::vector<int32_t> mdfOldBins;
+    std::vector<int32_t> mdfNewBins;
+    std::vector<float> mdfWeights;
+  };
+
+  /**
+   * @brief The HistogramDelta class accumulates the weight changes a move makes to a
+   * histogram so the resulting change in squared error can be computed in time
+   * proportional to the number of touched bins
+   */
+  class HistogramDelta
+  {
+    public:
+      HistogramDelta() {}
+
+      void resize(size_t numBins)
+      {
+        m_Delta.assign(numBins, 0.0);
+        m_Used.assign(numBins, 0);
+        m_Bins.clear();
+      }
+
+      void add(int32_t bin, double weight)
+      {
+        if (m_Used[bin] == 0)
+        {
+          m_Used[bin] = 1;
+          m_Bins.push_back(bin);
+        }
+        m_Delta[bin] += weight;
+      }
+
+      /**
+       * @brief reduction Returns how much the squared error between the goal and simulated
+       * histograms drops if the accumulated changes are applied
+       */
+      double reduction(const float* actual, const float* sim) const
+      {
+        double value = 0.0;
+        for (size_t i = 0; i < m_Bins.size(); i++)
+        {
+          int32_t bin = m_Bins[i];
+          double before = static_cast<double>(actual[bin]) - static_cast<double>(sim[bin]);
+          double after = before - m_Delta[bin];
+          value += before * before - after * after;
+        }
+        return value;
+      }
+
+      void apply(float* sim) const
+      {
+        for (size_t i = 0; i < m_Bins.size(); i++)
+        {
+          sim[m_Bins[i]] = static_cast<float>(sim[m_Bins[i]] + m_Delta[m_Bins[i]]);
+        }
+      }
+
+      void clear()
+      {
+        for (size_t i = 0; i < m_Bins.size(); i++)
+        {
+          m_Delta[m_Bins[i]] = 0.0;
+          m_Used[m_Bins[i]] = 0;
+        }
+        m_Bins.clear();
+      }
+
+    private:
+      std::vector<double> m_Delta;
+      std::vector<uint8_t> m_Used;
+      std::vector<int32_t> m_Bins;
+  };
+
+  /**
+   * @brief squaredError Returns the squared error between the goal and simulated histograms
+   */
+  static double squaredError(const float* actual, const float* sim, size_t numBins)
+  {
+    double error = 0.0;
+    for (size_t i = 0; i < numBins; i++)
+    {
+      double delta = static_cast<double>(actual[i]) - static_cast<double>(sim[i]);
+      error += delta * delta;
+    }
+    return error;
+  }
+
+  /**
+   * @brief relativeReduction Scales an error reduction by the current error so that the
+   * ODF and MDF terms can be summed
+   */
+  static double relativeReduction(double reduction, double error)
+  {
+    if (error > 0.0) { return reduction / error; }
+    return reduction;
+  }
+}
+
+/**
+ * @brief The MoveEvaluator class computes the outcome of a proposed Monte-Carlo move from
+ * the current Feature orientations without modifying any shared state, so many moves can
+ * be evaluated concurrently
+ */
+class MoveEvaluator
+{
+    SpaceGroupOps* m_Ops;
+    NeighborList<int32_t>& m_NeighborList;
+    NeighborList<float>& m_SurfaceAreaList;
+    const std::vector<std::vector<int32_t> >& m_MisoBins;
+    const std::vector<int32_t>& m_OdfBins;
+    float* m_Eulers;
+    QuatF* m_AvgQuats;
+    float* m_Volumes;
+    bool* m_SurfaceFeatures;
+    float m_OdfScale;
+    float m_MdfScale;
+
+  public:
+    MoveEvaluator(SpaceGroupOps* ops, NeighborList<int32_t>& neighborList, NeighborList<float>& surfaceAreaList,
+                  const std::vector<std::vector<int32_t> >& misoBins, const std::vector<int32_t>& odfBins,
+                  float* eulers, QuatF* avgQuats, float* volumes, bool* surfaceFeatures, float odfScale, float mdfScale) :
+      m_Ops(ops),
+      m_NeighborList(neighborList),
+      m_SurfaceAreaList(surfaceAreaList),
+      m_MisoBins(misoBins),
+      m_OdfBins(odfBins),
+      m_Eulers(eulers),
+      m_AvgQuats(avgQuats),
+      m_Volumes(volumes),
+      m_SurfaceFeatures(surfaceFeatures),
+      m_OdfScale(odfScale),
+      m_MdfScale(mdfScale)
+    {}
+    virtual ~MoveEvaluator() {}
+
+    float getOdfWeight(int32_t feature) const
+    {
+      return m_Volumes[feature] * m_OdfScale;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void evaluate(const Detail::Move& move, Detail::MoveResult& result) const
+    {
+      int32_t f1 = move.feature1;
+      int32_t f2 = move.feature2;
+
+      result.mdfFeatures.clear();
+      result.mdfSlots.clear();
+      result.mdfOldBins.clear();
+      result.mdfNewBins.clear();
+      result.mdfWeights.clear();
+
+      if (f2 < 0)
+      {
+        FOrientArrayType eulers = m_Ops->determineEulerAngles(move.seed, move.choose);
+        eulers = m_Ops->randomizeEulerAngles(eulers, move.seed);
+        FOrientArrayType quat(4, 0.0f);
+        FOrientTransformsType::eu2qu(eulers, quat);
+        result.eulers1[0] = eulers[0];
+        result.eulers1[1] = eulers[1];
+        result.eulers1[2] = eulers[2];
+        result.q1 = quat.toQuaternion();
+        result.odfBin1 = move.choose;
+        result.odfBin2 = -1;
+
+        addNeighborChanges(f1, -1, -1, result.q1, result.q1, result);
+      }
+      else
+      {
+        for (int32_t c = 0; c < 3; c++)
+        {
+          result.eulers1[c] = m_Eulers[3 * f2 + c];
+          result.eulers2[c] = m_Eulers[3 * f1 + c];
+        }
+        result.q1 = m_AvgQuats[f2];
+        result.q2 = m_AvgQuats[f1];
+        result.odfBin1 = m_OdfBins[f2];
+        result.odfBin2 = m_OdfBins[f1];
+
+        addNeighborChanges(f1, -1, f2, result.q1, result.q2, result);
+        addNeighborChanges(f2, f1, -1, result.q2, result.q1, result);
+      }
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    bool dependsOnChanged(const Detail::Move& move, const std::vector<uint32_t>& changed, uint32_t stamp) const
+    {
+      int32_t features[2] = { move.feature1, move.feature2 };
+      for (int32_t f = 0; f < 2; f++)
+      {
+        int32_t feature = features[f];
+        if (feature < 0) { continue; }
+        if (changed[feature] == stamp) { return true; }
+        const std::vector<int32_t>& bins = m_MisoBins[feature];
+        for (size_t j = 0; j < bins.size(); j++)
+        {
+          if (bins[j] >= 0 && changed[m_NeighborList[feature][j]] == stamp) { return true; }
+        }
+      }
+      return false;
+    }
+
+  private:
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    int32_t misoBin(const QuatF& qa, const QuatF& qb) const
+    {
+      QuatF q1 = qa;
+      QuatF q2 = qb;
+      float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
+      float w = m_Ops->getMisoQuat(q1, q2, n1, n2, n3);
+      FOrientArrayType rod(4);
+      FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
+      return m_Ops->getMisoBin(rod);
+    }
+
+    // -----------------------------------------------------------------------------
+    // Records the new misorientation bin of every counted boundary of the Feature. The
+    // boundary with skipNeighbor has already been recorded from the other side, and the
+    // boundary with partner uses the partner's new orientation
+    // -----------------------------------------------------------------------------
+    void addNeighborChanges(int32_t feature, int32_t skipNeighbor, int32_t partner, const QuatF& newQuat,
+                            const QuatF& partnerQuat, Detail::MoveResult& result) const
+    {
+      const std::vector<int32_t>& bins = m_MisoBins[feature];
+      for (size_t j = 0; j < bins.size(); j++)
+      {
+        if (bins[j] < 0) { continue; }
+        int32_t neighbor = m_NeighborList[feature][j];
+        if (neighbor == skipNeighbor) { continue; }
+        const QuatF& neighborQuat = (neighbor == partner) ? partnerQuat : m_AvgQuats[neighbor];
+
+        // The MDF counts each boundary once, from the lower Feature Id unless that Feature touches the surface
+        int32_t newBin = 0;
+        if (m_SurfaceFeatures[feature] == false && (neighbor > feature || m_SurfaceFeatures[neighbor] == true))
+        {
+          newBin = misoBin(newQuat, neighborQuat);
+        }
+        else
+        {
+          newBin = misoBin(neighborQuat, newQuat);
+        }
+        if (newBin == bins[j]) { continue; }
+
+        result.mdfFeatures.push_back(feature);
+        result.mdfSlots.push_back(static_cast<int32_t>(j));
+        result.mdfOldBins.push_back(bins[j]);
+        result.mdfNewBins.push_back(newBin);
+        result.mdfWeights.push_back(m_SurfaceAreaList[feature][j] * m_MdfScale);
+      }
+    }
+};
+
+/**
+ * @brief The EvaluateMovesImpl class implements a threaded algorithm that evaluates a batch
+ * of proposed Monte-Carlo moves against the current orientations
+ */
+class EvaluateMovesImpl
+{
+    const MoveEvaluator* m_Evaluator;
+    const Detail::Move* m_Moves;
+    Detail::MoveResult* m_Results;
+
+  public:
+    EvaluateMovesImpl(const MoveEvaluator* evaluator, const Detail::Move* moves, Detail::MoveResult* results) :
+      m_Evaluator(evaluator),
+      m_Moves(moves),
+      m_Results(results)
+    {}
+    virtual ~EvaluateMovesImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        if (m_Moves[i].feature1 >= 0) { m_Evaluator->evaluate(m_Moves[i], m_Results[i]); }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
 // Include the MOC generated file for this class
 #include "moc_MatchCrystallography.cpp"
 
@@ -82,6 +418,8 @@ MatchCrystallography::MatchCrystallography() :
   m_FeatureEulerAnglesArrayName(DREAM3D::FeatureData::EulerAngles),
   m_AvgQuatsArrayName(DREAM3D::FeatureData::AvgQuats),
   m_MaxIterations(1),
+  m_UseFixedSeed(false),
+  m_RandomSeed(0),
   m_FeatureIds(NULL),
   m_CellEulerAngles(NULL),
   m_SurfaceFeatures(NULL),
@@ -92,14 +430,13 @@ MatchCrystallography::MatchCrystallography() :
   m_SyntheticCrystalStructures(NULL),
   m_CrystalStructures(NULL),
   m_PhaseTypes(NULL),
-  m_NumFeatures(NULL)
+  m_NumFeatures(NULL),
+  m_NextSeed(0)
 {
   m_NeighborList = NeighborList<int32_t>::NullPointer();
   m_SharedSurfaceAreaList = NeighborList<float>::NullPointer();
   m_StatsDataArray = StatsDataArray::NullPointer();
 
-  mdfchange = odfchange = 0.0f;
-
   actualodf = FloatArrayType::NullPointer();
   simodf = FloatArrayType::NullPointer();
   actualmdf = FloatArrayType::NullPointer();
@@ -124,6 +461,9 @@ void MatchCrystallography::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(IntFilterParameter::New("Maximum Number of Iterations (Swaps)", "MaxIterations", getMaxIterations(), FilterParameter::Parameter));
+  QStringList linkedProps("RandomSeed");
+  parameters.push_back(LinkedBooleanFilterParameter::New("Use Fixed Random Seed", "UseFixedSeed", getUseFixedSeed(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Random Seed", "RandomSeed", getRandomSeed(), FilterParameter::Parameter));
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -192,6 +532,8 @@ void MatchCrystallography::readFilterParameters(AbstractFilterParametersReader*
 {
   reader->openFilterGroup(this, index);
   setMaxIterations( reader->readValue("MaxIterations", getMaxIterations()) );
+  setUseFixedSeed( reader->readValue("UseFixedSeed", getUseFixedSeed()) );
+  setRandomSeed( reader->readValue("RandomSeed", getRandomSeed()) );
   setInputStatsArrayPath(reader->readDataArrayPath("InputStatsArrayPath", getInputStatsArrayPath() ) );
   setCrystalStructuresArrayPath(reader->readDataArrayPath("CrystalStructuresArrayPath", getCrystalStructuresArrayPath() ) );
   setPhaseTypesArrayPath(reader->readDataArrayPath("PhaseTypesArrayPath", getPhaseTypesArrayPath() ) );
@@ -216,6 +558,8 @@ int MatchCrystallography::writeFilterParameters(AbstractFilterParametersWriter*
   writer->openFilterGroup(this, index);
   SIMPL_FILTER_WRITE_PARAMETER(FilterVersion)
   SIMPL_FILTER_WRITE_PARAMETER(MaxIterations)
+  SIMPL_FILTER_WRITE_PARAMETER(UseFixedSeed)
+  SIMPL_FILTER_WRITE_PARAMETER(RandomSeed)
   SIMPL_FILTER_WRITE_PARAMETER(InputStatsArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(CrystalStructuresArrayPath)
   SIMPL_FILTER_WRITE_PARAMETER(PhaseTypesArrayPath)
@@ -339,6 +683,10 @@ void MatchCrystallography::execute()
 
   size_t totalEnsembles = m_CrystalStructuresPtr.lock()->getNumberOfTuples();
 
+  // Every random number generator of the filter is seeded from here, so a fixed seed makes the
+  // whole run reproducible
+  m_NextSeed = (getUseFixedSeed() == true) ? static_cast<uint64_t>(getRandomSeed()) : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
+
   QString ss;
   ss = QObject::tr("Determining Volumes");
   notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
@@ -517,7 +865,7 @@ void MatchCrystallography::determine_boundary_areas()
 // -----------------------------------------------------------------------------
 void MatchCrystallography::assign_eulers(size_t ensem)
 {
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
+  uint64_t m_Seed = m_NextSeed;
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   int32_t numbins = 0;
@@ -526,6 +874,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
   int32_t choose = 0, phase = 0;
 
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
+  m_FeatureOdfBins.resize(totalFeatures, 0);
 
   CubicOps cOps;
   HexagonalOps hOps;
@@ -552,9 +901,10 @@ void MatchCrystallography::assign_eulers(size_t ensem)
       }
 
       choose = pick_euler(random, numbins);
+      m_FeatureOdfBins[i] = choose;
 
       FOrientArrayType eulers = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
-      eulers = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(eulers);
+      eulers = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(eulers, m_Seed);
       m_FeatureEulerAngles[3 * i] = eulers[0];
       m_FeatureEulerAngles[3 * i + 1] = eulers[1];
       m_FeatureEulerAngles[3 * i + 2] = eulers[2];
@@ -568,6 +918,7 @@ void MatchCrystallography::assign_eulers(size_t ensem)
       }
     }
   }
+  m_NextSeed = m_Seed + 1;
 }
 
 // -----------------------------------------------------------------------------
@@ -588,91 +939,6 @@ int32_t MatchCrystallography::pick_euler(float random, int32_t numbins)
   return choose;
 }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
-{
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  FOrientArrayType rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
-  {
-    rod[3] = std::numeric_limits<float>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-
-  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  mdfchange = mdfchange
-              + (((actualmdf->getValue(curmisobin) - simmdf->getValue(curmisobin)) * (actualmdf->getValue(curmisobin) - simmdf->getValue(curmisobin)))
-                 - ((actualmdf->getValue(curmisobin) - (simmdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))
-                    * (actualmdf->getValue(curmisobin) - (simmdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-  mdfchange = mdfchange
-              + (((actualmdf->getValue(newmisobin) - simmdf->getValue(newmisobin)) * (actualmdf->getValue(newmisobin) - simmdf->getValue(newmisobin)))
-                 - ((actualmdf->getValue(newmisobin) - (simmdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))
-                    * (actualmdf->getValue(newmisobin) - (simmdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])))));
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void MatchCrystallography::MC_LoopBody2(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2)
-{
-  float w = 0.0f;
-  float n1 = 0.0f, n2 = 0.0f, n3 = 0.0f;
-  float curmiso1 = 0.0f, curmiso2 = 0.0f, curmiso3 = 0.0f;
-  size_t curmisobin = 0, newmisobin = 0;
-  float miso1 = 0.0f, miso2 = 0.0f, miso3 = 0.0f;
-
-  curmiso1 = m_MisorientationLists[feature][3 * j];
-  curmiso2 = m_MisorientationLists[feature][3 * j + 1];
-  curmiso3 = m_MisorientationLists[feature][3 * j + 2];
-
-  FOrientArrayType rod(curmiso1, curmiso2, curmiso3, 0.0f);
-  float mag = sqrt(curmiso1 * curmiso1 + curmiso2 * curmiso2 + curmiso3 * curmiso3);
-  if(mag == 0.0f)
-  {
-    rod[3] = std::numeric_limits<float>::infinity();
-  }
-  else
-  {
-    rod[3] = mag;
-    rod[0] = rod[0] / rod[3];
-    rod[1] = rod[1] / rod[3];
-    rod[2] = rod[2] / rod[3];
-  }
-
-  curmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  w = m_OrientationOps[sym]->getMisoQuat(q1, q2, n1, n2, n3);
-
-  FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-  newmisobin = m_OrientationOps[sym]->getMisoBin(rod);
-  m_MisorientationLists[feature][3 * j] = miso1;
-  m_MisorientationLists[feature][3 * j + 1] = miso2;
-  m_MisorientationLists[feature][3 * j + 2] = miso3;
-  simmdf->setValue(curmisobin, (simmdf->getValue(curmisobin) - (neighsurfarea / m_TotalSurfaceArea[ensem])));
-  simmdf->setValue(newmisobin, (simmdf->getValue(newmisobin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
-}
-
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -686,35 +952,51 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
   size_t totalPoints = m_FeatureIdsPtr.lock()->getNumberOfTuples();
   size_t totalFeatures = m_FeaturePhasesPtr.lock()->getNumberOfTuples();
 
-  uint64_t m_Seed = QDateTime::currentMSecsSinceEpoch();
+  // Every random number is drawn serially while proposing moves and each swap move gets
+  // its own orientation seed, so the outcome does not depend on how the batch is threaded
+  uint64_t m_Seed = m_NextSeed;
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
-  int32_t numbins = 0;
-  int32_t iterations = 0, badtrycount = 0;
-  float random = 0.0f;
-  size_t counter = 0;
-
-  QuatF q1;
-  QuatF q2;
+  SpaceGroupOps* ops = m_OrientationOps[m_CrystalStructures[ensem]].get();
+  int32_t numbins = ops->getODFSize();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  float ea1 = 0.0f, ea2 = 0.0f, ea3 = 0.0f;
-  float g1ea1 = 0.0f, g1ea2 = 0.0f, g1ea3 = 0.0f, g2ea1 = 0.0f, g2ea2 = 0.0f, g2ea3 = 0.0f;
-  int32_t g1odfbin = 0, g2odfbin = 0;
-  float deltaerror = 0.0f;
-  float currentodferror = 0.0f, currentmdferror = 0.0f;
-  int32_t selectedfeature1 = 0, selectedfeature2 = 0;
-  iterations = 0;
-  badtrycount = 0;
-  if ( Ebsd::CrystalStructure::Cubic_High == m_CrystalStructures[ensem]) { numbins = 18 * 18 * 18; }
-  if ( Ebsd::CrystalStructure::Hexagonal_High == m_CrystalStructures[ensem]) { numbins = 36 * 36 * 12; }
+  std::vector<int32_t> candidates;
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    if (m_SurfaceFeatures[i] == false && m_FeaturePhases[i] == static_cast<int32_t>(ensem))
+    {
+      candidates.push_back(static_cast<int32_t>(i));
+    }
+  }
+
+  float* actualOdfPtr = actualodf->getPointer(0);
+  float* simOdfPtr = simodf->getPointer(0);
+  float* actualMdfPtr = actualmdf->getPointer(0);
+  float* simMdfPtr = simmdf->getPointer(0);
+  size_t odfSize = std::min(actualodf->getSize(), simodf->getSize());
+  size_t mdfSize = std::min(actualmdf->getSize(), simmdf->getSize());
+
+  MoveEvaluator evaluator(ops, neighborlist, neighborsurfacearealist, m_MisorientationBins, m_FeatureOdfBins,
+                          m_FeatureEulerAngles, avgQuats, m_Volumes, m_SurfaceFeatures,
+                          1.0f / unbiasedvol[ensem], 1.0f / m_TotalSurfaceArea[ensem]);
+
+  std::vector<Detail::Move> moves(Detail::MoveBatchSize);
+  std::vector<Detail::MoveResult> results(Detail::MoveBatchSize);
+  std::vector<uint32_t> changed(totalFeatures, 0);
+  Detail::HistogramDelta odfDelta;
+  Detail::HistogramDelta mdfDelta;
+  odfDelta.resize(simodf->getSize());
+  mdfDelta.resize(simmdf->getSize());
+
+  int32_t iterations = 0, badtrycount = 0;
+  uint32_t batch = 0;
+  float random = 0.0f;
 
   uint64_t millis = QDateTime::currentMSecsSinceEpoch();
   uint64_t startMillis = millis;
-  int32_t lastIteration = 0;
-  while (badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
+  while (candidates.empty() == false && badtrycount < (m_MaxIterations / 10) && iterations < m_MaxIterations)
   {
-    m_Seed++;
     uint64_t currentMillis = QDateTime::currentMSecsSinceEpoch();
     if (currentMillis - millis > 1000)
     {
@@ -726,269 +1008,129 @@ void MatchCrystallography::matchCrystallography(size_t ensem)
       notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
       millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iterations;
-    }
-    currentodferror = 0;
-    currentmdferror = 0;
-    float* actualOdfPtr = actualodf->getPointer(0);
-    float* simOdfPtr = simodf->getPointer(0);
-    float delta = 0.0f;
-    for (int32_t i = 0; i < numbins; i++)
-    {
-      delta = actualOdfPtr[i] - simOdfPtr[i];
-      currentodferror = currentodferror + (delta * delta);
-    }
-    for (int32_t i = 0; i < (numbins); i++)
-    {
-      currentmdferror = currentmdferror + ((actualmdf->getValue(i) - simmdf->getValue(i)) * (actualmdf->getValue(i) - simmdf->getValue(i)));
     }
-    iterations++;
-    badtrycount++;
-    random = static_cast<float>( rg.genrand_res53() );
 
-    if (getCancel() == true) { return; }
-
-    if (random < 0.5) // SwapOutOrientation
+    // Propose the next batch of moves
+    size_t numMoves = std::min(Detail::MoveBatchSize, static_cast<size_t>(m_MaxIterations - iterations));
+    size_t numCandidates = candidates.size();
+    for (size_t m = 0; m < numMoves; m++)
     {
-      counter = 0;
-      selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
-      while ((m_SurfaceFeatures[selectedfeature1] == true || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+      Detail::Move& move = moves[m];
+      m_Seed++;
+      move.seed = m_Seed;
+      move.feature2 = -1;
+      move.choose = 0;
+      random = static_cast<float>( rg.genrand_res53() );
+      size_t index1 = std::min(static_cast<size_t>(rg.genrand_res53() * numCandidates), numCandidates - 1);
+      move.feature1 = candidates[index1];
+      if (random < 0.5) // SwapOutOrientation
       {
-        if (selectedfeature1 >= totalFeatures) { selectedfeature1 = selectedfeature1 - totalFeatures; }
-        selectedfeature1++;
-        counter++;
+        random = static_cast<float>( rg.genrand_res53() );
+        move.choose = pick_euler(random, numbins);
       }
-      if (counter == totalFeatures)
+      else if (numCandidates > 1) // SwitchOrientation
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        size_t index2 = std::min(static_cast<size_t>(rg.genrand_res53() * (numCandidates - 1)), numCandidates - 2);
+        if (index2 >= index1) { index2++; }
+        move.feature2 = candidates[index2];
       }
       else
       {
-        ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-        ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-        ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-        FOrientArrayType rod(4, 0.0);
-        FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
-
-        g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-        random = static_cast<float>( rg.genrand_res53() );
-        int32_t choose = 0;
-
-        choose = pick_euler(random, numbins);
-
-        FOrientArrayType g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->determineEulerAngles(m_Seed, choose);
-        g1ea = m_OrientationOps[m_CrystalStructures[ensem]]->randomizeEulerAngles(g1ea);
-        FOrientArrayType quat(4, 0.0);
-        FOrientTransformsType::eu2qu(g1ea, quat);
-        q1 = quat.toQuaternion();
-
-        odfchange = ((actualodf->getValue(choose) - simodf->getValue(choose)) * (actualodf->getValue(choose) - simodf->getValue(choose)))
-                    - ((actualodf->getValue(choose) - (simodf->getValue(choose) + (m_Volumes[selectedfeature1] / unbiasedvol[ensem])))
-                       * (actualodf->getValue(choose) - (simodf->getValue(choose) + (m_Volumes[selectedfeature1] / unbiasedvol[ensem]))));
-        odfchange = odfchange
-                    + (((actualodf->getValue(g1odfbin) - simodf->getValue(g1odfbin)) * (actualodf->getValue(g1odfbin) - simodf->getValue(g1odfbin)))
-                       - ((actualodf->getValue(g1odfbin) - (simodf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / unbiasedvol[ensem])))
-                          * (actualodf->getValue(g1odfbin) - (simodf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / unbiasedvol[ensem])))));
-
-        mdfchange = 0;
-        size_t size = 0;
-        if (neighborlist[selectedfeature1].size() != 0) { size = neighborlist[selectedfeature1].size(); }
-        for (size_t j = 0; j < size; j++)
-        {
-          int32_t neighbor = neighborlist[selectedfeature1][j];
-          FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-          q1 = quat.toQuaternion();
-          float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-          MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-        }
-
-        deltaerror = (odfchange / currentodferror) + (mdfchange / currentmdferror);
-        if (deltaerror > 0)
-        {
-          badtrycount = 0;
-          m_FeatureEulerAngles[3 * selectedfeature1] = g1ea1;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g1ea2;
-          m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g1ea3;
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          simodf->setValue(choose, (simodf->getValue(choose) + (m_Volumes[selectedfeature1] / unbiasedvol[ensem])));
-          simodf->setValue(g1odfbin, (simodf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / unbiasedvol[ensem])));
-          size = 0;
-          if (neighborlist[selectedfeature1].size() != 0) { size = neighborlist[selectedfeature1].size(); }
-          for (size_t j = 0; j < size; j++)
-          {
-            int neighbor = neighborlist[selectedfeature1][j];
-            FOrientArrayType quat(4);
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-          }
-        }
+        // There is nothing to switch with, so this move can never be accepted
+        move.feature1 = -1;
       }
-      if (getCancel() == true) { return; }
     }
-    else // SwitchOrientation
+
+    // Evaluate the whole batch against the current orientations
+    ParallelContext::ParallelFor<size_t>(0, numMoves, EvaluateMovesImpl(&evaluator, &(moves[0]), &(results[0])));
+
+    // Commit in proposal order. A move that read a Feature changed earlier in this batch
+    // is evaluated again so the result matches applying the moves one at a time
+    batch++;
+    double currentodferror = Detail::squaredError(actualOdfPtr, simOdfPtr, odfSize);
+    double currentmdferror = Detail::squaredError(actualMdfPtr, simMdfPtr, mdfSize);
+    for (size_t m = 0; m < numMoves; m++)
     {
-      counter = 0;
-      selectedfeature1 = int32_t(rg.genrand_res53() * totalFeatures);
-      while ((m_SurfaceFeatures[selectedfeature1] == true || m_FeaturePhases[selectedfeature1] != static_cast<int32_t>(ensem)) && counter < totalFeatures)
+      if (badtrycount >= (m_MaxIterations / 10)) { break; }
+      iterations++;
+      badtrycount++;
+
+      const Detail::Move& move = moves[m];
+      if (move.feature1 < 0) { continue; }
+      Detail::MoveResult& result = results[m];
+      if (evaluator.dependsOnChanged(move, changed, batch) == true)
       {
-        if (selectedfeature1 >= totalFeatures) { selectedfeature1 = selectedfeature1 - totalFeatures; }
-        selectedfeature1++;
-        counter++;
+        evaluator.evaluate(move, result);
       }
-      if (counter == totalFeatures)
+
+      int32_t f1 = move.feature1;
+      int32_t f2 = move.feature2;
+      float w1 = evaluator.getOdfWeight(f1);
+      odfDelta.add(m_FeatureOdfBins[f1], -w1);
+      odfDelta.add(result.odfBin1, w1);
+      if (f2 >= 0)
       {
-        badtrycount = 10 * m_NumFeatures[ensem];
+        float w2 = evaluator.getOdfWeight(f2);
+        odfDelta.add(m_FeatureOdfBins[f2], -w2);
+        odfDelta.add(result.odfBin2, w2);
       }
-      else
+      for (size_t k = 0; k < result.mdfWeights.size(); k++)
       {
-        counter = 0;
-        selectedfeature2 = int32_t(rg.genrand_res53() * totalFeatures);
-        while ((m_SurfaceFeatures[selectedfeature2] == true || m_FeaturePhases[selectedfeature2] != static_cast<int32_t>(ensem) || selectedfeature2 == selectedfeature1) && counter < totalFeatures)
-        {
-          if (selectedfeature2 >= totalFeatures) { selectedfeature2 = selectedfeature2 - totalFeatures; }
-          selectedfeature2++;
-          counter++;
-        }
-        if (counter == totalFeatures)
+        mdfDelta.add(result.mdfOldBins[k], -result.mdfWeights[k]);
+        mdfDelta.add(result.mdfNewBins[k], result.mdfWeights[k]);
+      }
+
+      double odfchange = odfDelta.reduction(actualOdfPtr, simOdfPtr);
+      double mdfchange = mdfDelta.reduction(actualMdfPtr, simMdfPtr);
+      double deltaerror = Detail::relativeReduction(odfchange, currentodferror) + Detail::relativeReduction(mdfchange, currentmdferror);
+      if (deltaerror > 0)
+      {
+        badtrycount = 0;
+        odfDelta.apply(simOdfPtr);
+        mdfDelta.apply(simMdfPtr);
+        currentodferror -= odfchange;
+        currentmdferror -= mdfchange;
+
+        for (int32_t c = 0; c < 3; c++)
         {
-          badtrycount = 10 * m_NumFeatures[ensem];
+          m_FeatureEulerAngles[3 * f1 + c] = result.eulers1[c];
         }
-        else
+        QuaternionMathF::Copy(result.q1, avgQuats[f1]);
+        m_FeatureOdfBins[f1] = result.odfBin1;
+        changed[f1] = batch;
+        if (f2 >= 0)
         {
-          g1ea1 = m_FeatureEulerAngles[3 * selectedfeature1];
-          g1ea2 = m_FeatureEulerAngles[3 * selectedfeature1 + 1];
-          g1ea3 = m_FeatureEulerAngles[3 * selectedfeature1 + 2];
-          g2ea1 = m_FeatureEulerAngles[3 * selectedfeature2];
-          g2ea2 = m_FeatureEulerAngles[3 * selectedfeature2 + 1];
-          g2ea3 = m_FeatureEulerAngles[3 * selectedfeature2 + 2];
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-          FOrientArrayType rod(4);
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature1]), 3), rod);
-
-          g1odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-          QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-
-          FOrientTransformsType::eu2ro(FOrientArrayType(&(m_FeatureEulerAngles[3 * selectedfeature2]), 3), rod);
-          g2odfbin = m_OrientationOps[m_CrystalStructures[ensem]]->getOdfBin(rod);
-
-          odfchange = ((actualodf->getValue(g1odfbin) - simodf->getValue(g1odfbin)) * (actualodf->getValue(g1odfbin) - simodf->getValue(g1odfbin)))
-                      - ((actualodf->getValue(g1odfbin)
-                          - (simodf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / unbiasedvol[ensem])
-                             + (m_Volumes[selectedfeature2] / unbiasedvol[ensem])))
-                         * (actualodf->getValue(g1odfbin)
-                            - (simodf->getValue(g1odfbin) - (m_Volumes[selectedfeature1] / unbiasedvol[ensem])
-                               + (m_Volumes[selectedfeature2] / unbiasedvol[ensem]))));
-          odfchange = odfchange
-                      + (((actualodf->getValue(g2odfbin) - simodf->getValue(g2odfbin)) * (actualodf->getValue(g2odfbin) - simodf->getValue(g2odfbin)))
-                         - ((actualodf->getValue(g2odfbin)
-                             - (simodf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / unbiasedvol[ensem])
-                                + (m_Volumes[selectedfeature1] / unbiasedvol[ensem])))
-                            * (actualodf->getValue(g2odfbin)
-                               - (simodf->getValue(g2odfbin) - (m_Volumes[selectedfeature2] / unbiasedvol[ensem])
-                                  + (m_Volumes[selectedfeature1] / unbiasedvol[ensem])))));
-
-          mdfchange = 0;
-
-          FOrientArrayType quat(4);
-          FOrientTransformsType::eu2qu(FOrientArrayType(g2ea1, g2ea2, g2ea3), quat);
-          q1 = quat.toQuaternion();
-
-          size_t size = 0;
-          if (neighborlist[selectedfeature1].size() != 0) { size = neighborlist[selectedfeature1].size(); }
-          for (size_t j = 0; j < size; j++)
-          {
-            int32_t neighbor = neighborlist[selectedfeature1][j];
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-            if(neighbor != static_cast<int>(selectedfeature2) )
-            {
-              MC_LoopBody1(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
-          }
-
-          FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-          q1 = quat.toQuaternion();
-          size = 0;
-          if (neighborlist[selectedfeature2].size() != 0) { size = neighborlist[selectedfeature2].size(); }
-          for (size_t j = 0; j < size; j++)
+          for (int32_t c = 0; c < 3; c++)
           {
-            size_t neighbor = neighborlist[selectedfeature2][j];
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(&(m_FeatureEulerAngles[3 * neighbor]), 3), quat);
-            q2 = quat.toQuaternion();
-            float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-            if (neighbor != selectedfeature1)
-            {
-              MC_LoopBody1(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-            }
+            m_FeatureEulerAngles[3 * f2 + c] = result.eulers2[c];
           }
+          QuaternionMathF::Copy(result.q2, avgQuats[f2]);
+          m_FeatureOdfBins[f2] = result.odfBin2;
+          changed[f2] = batch;
+        }
 
-          deltaerror = (odfchange / currentodferror) + (mdfchange / currentmdferror);
-          if (deltaerror > 0)
+        // Keep both sides of every changed boundary pointing at the new misorientation bin
+        for (size_t k = 0; k < result.mdfWeights.size(); k++)
+        {
+          int32_t feature = result.mdfFeatures[k];
+          int32_t slot = result.mdfSlots[k];
+          int32_t newBin = result.mdfNewBins[k];
+          int32_t neighbor = neighborlist[feature][slot];
+          m_MisorientationBins[feature][slot] = newBin;
+          std::vector<int32_t>& neighborBins = m_MisorientationBins[neighbor];
+          for (size_t j = 0; j < neighborBins.size(); j++)
           {
-
-            badtrycount = 0;
-            m_FeatureEulerAngles[3 * selectedfeature1] = g2ea1;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 1] = g2ea2;
-            m_FeatureEulerAngles[3 * selectedfeature1 + 2] = g2ea3;
-            m_FeatureEulerAngles[3 * selectedfeature2] = g1ea1;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 1] = g1ea2;
-            m_FeatureEulerAngles[3 * selectedfeature2 + 2] = g1ea3;
-            simodf->setValue(g1odfbin, (simodf->getValue(g1odfbin) + (m_Volumes[selectedfeature2] / unbiasedvol[ensem])
-                                        - (m_Volumes[selectedfeature1] / unbiasedvol[ensem])));
-            simodf->setValue(g2odfbin, (simodf->getValue(g2odfbin) + (m_Volumes[selectedfeature1] / unbiasedvol[ensem])
-                                        - (m_Volumes[selectedfeature2] / unbiasedvol[ensem])));
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature1]);
-            size = 0;
-            if (neighborlist[selectedfeature1].size() != 0) { size = neighborlist[selectedfeature1].size(); }
-            for (size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature1][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature1][j];
-              if (neighbor != selectedfeature2)
-              {
-                MC_LoopBody2(selectedfeature1, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
-
-            FOrientTransformsType::eu2qu(FOrientArrayType(g1ea1, g1ea2, g1ea3), quat);
-            q1 = quat.toQuaternion();
-            QuaternionMathF::Copy(q1, avgQuats[selectedfeature2]);
-            size = 0;
-            if (neighborlist[selectedfeature2].size() != 0) { size = neighborlist[selectedfeature2].size(); }
-            for (size_t j = 0; j < size; j++)
-            {
-              size_t neighbor = neighborlist[selectedfeature2][j];
-              ea1 = m_FeatureEulerAngles[3 * neighbor];
-              ea2 = m_FeatureEulerAngles[3 * neighbor + 1];
-              ea3 = m_FeatureEulerAngles[3 * neighbor + 2];
-              FOrientTransformsType::eu2qu(FOrientArrayType(ea1, ea2, ea3), quat);
-              q2 = quat.toQuaternion();
-              float neighsurfarea = neighborsurfacearealist[selectedfeature2][j];
-              if (neighbor != selectedfeature1)
-              {
-                MC_LoopBody2(selectedfeature2, ensem, j, neighsurfarea, m_CrystalStructures[ensem], q1, q2);
-              }
-            }
+            if (neighborlist[neighbor][j] == feature) { neighborBins[j] = newBin; }
           }
         }
       }
+      odfDelta.clear();
+      mdfDelta.clear();
     }
+
     if (getCancel() == true) { return; }
   }
-
-  if (getCancel() == true) { return; }
+  m_NextSeed = m_Seed + 1;
 
   for (size_t i = 0; i < totalPoints; i++)
   {
@@ -1016,56 +1158,45 @@ void MatchCrystallography::measure_misorientations(size_t ensem)
   QuatF q2 = QuaternionMathF::New();
   QuatF* avgQuats = reinterpret_cast<QuatF*>(m_AvgQuats);
 
-  uint32_t crys1 = 0;
+  uint32_t crys1 = m_CrystalStructures[ensem];
   int32_t mbin = 0;
 
-  m_MisorientationLists.resize(totalFeatures);
-
+  // Each slot of a Feature's neighbor list caches the MDF bin of that boundary, or -1
+  // if the boundary does not contribute to the MDF of this phase
+  m_MisorientationBins.resize(totalFeatures);
   for (size_t i = 1; i < totalFeatures; i++)
   {
-    if (m_FeaturePhases[i] == ensem)
+    m_MisorientationBins[i].clear();
+    if (m_FeaturePhases[i] == ensem && neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
     {
-      if (m_MisorientationLists[i].size() != 0)
-      {
-        m_MisorientationLists[i].clear();
-      }
-      if (neighborlist[i].size() != 0)
-      {
-        m_MisorientationLists[i].assign(neighborlist[i].size() * 3, 0.0f);
-      }
-      QuaternionMathF::Copy(avgQuats[i], q1);
-      crys1 = m_CrystalStructures[ensem];
-      size_t size = 0;
-      if (neighborlist[i].size() != 0 && neighborsurfacearealist[i].size() == neighborlist[i].size())
-      {
-        size = neighborlist[i].size();
-      }
+      m_MisorientationBins[i].assign(neighborlist[i].size(), -1);
+    }
+  }
+
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    if (m_FeaturePhases[i] != ensem || m_SurfaceFeatures[i] == true) { continue; }
 
-      for (size_t j = 0; j < size; j++)
+    QuaternionMathF::Copy(avgQuats[i], q1);
+    size_t size = m_MisorientationBins[i].size();
+    for (size_t j = 0; j < size; j++)
+    {
+      int32_t nname = neighborlist[i][j];
+      if (m_FeaturePhases[nname] == ensem && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname] == true))
       {
-        int32_t nname = neighborlist[i][j];
-        if (m_FeaturePhases[nname] == ensem)
-        {
-          w = 10000.0f;
-          float neighsurfarea = neighborsurfacearealist[i][j];
-          QuaternionMathF::Copy(avgQuats[nname], q2);
-          w = m_OrientationOps[crys1]->getMisoQuat(q1, q2, n1, n2, n3);
-          FOrientArrayType rod(4);
-          FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
-          m_MisorientationLists[i][3 * j] = rod[0];
-          m_MisorientationLists[i][3 * j + 1] = rod[1];
-          m_MisorientationLists[i][3 * j + 2] = rod[2];
-          mbin = m_OrientationOps[crys1]->getMisoBin(rod);
-          if (m_SurfaceFeatures[i] == false && (nname > static_cast<int32_t>(i) || m_SurfaceFeatures[nname] == true))
-          {
-            simmdf->setValue(mbin, (simmdf->getValue(mbin) + (neighsurfarea / m_TotalSurfaceArea[m_FeaturePhases[i]])));
-          }
-        }
-        else
+        float neighsurfarea = neighborsurfacearealist[i][j];
+        QuaternionMathF::Copy(avgQuats[nname], q2);
+        w = m_OrientationOps[crys1]->getMisoQuat(q1, q2, n1, n2, n3);
+        FOrientArrayType rod(4);
+        FOrientTransformsType::ax2ro(FOrientArrayType(n1, n2, n3, w), rod);
+        mbin = m_OrientationOps[crys1]->getMisoBin(rod);
+        simmdf->setValue(mbin, (simmdf->getValue(mbin) + (neighsurfarea / m_TotalSurfaceArea[ensem])));
+
+        m_MisorientationBins[i][j] = mbin;
+        std::vector<int32_t>& neighborBins = m_MisorientationBins[nname];
+        for (size_t k = 0; k < neighborBins.size(); k++)
         {
-          m_MisorientationLists[i][3 * j] = -100;
-          m_MisorientationLists[i][3 * j + 1] = -100;
-          m_MisorientationLists[i][3 * j + 2] = -100;
+          if (neighborlist[nname][k] == static_cast<int32_t>(i)) { neighborBins[k] = mbin; }
         }
       }
     }
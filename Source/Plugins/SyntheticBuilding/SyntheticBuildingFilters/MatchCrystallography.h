@@ -104,6 +104,12 @@ class MatchCrystallography : public AbstractFilter
     SIMPL_FILTER_PARAMETER(int, MaxIterations)
     Q_PROPERTY(int MaxIterations READ getMaxIterations WRITE setMaxIterations)
 
+    SIMPL_FILTER_PARAMETER(bool, UseFixedSeed)
+    Q_PROPERTY(bool UseFixedSeed READ getUseFixedSeed WRITE setUseFixedSeed)
+
+    SIMPL_FILTER_PARAMETER(int, RandomSeed)
+    Q_PROPERTY(int RandomSeed READ getRandomSeed WRITE setRandomSeed)
+
     /**
      * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
      */
@@ -217,39 +223,17 @@ class MatchCrystallography : public AbstractFilter
      */
     int32_t pick_euler(float random, int32_t numbins);
 
-    /**
-     * @brief MC_LoopBody1 Determines the misorientation change after performing a swap
-     * @param feature Feature Id of Feature that has been swapped
-     * @param ensem Ensemble index of the current phase
-     * @param j Neighbor index for the Feature
-     * @param neighsurfarea Surface area for the Feature neighbor
-     * @param sym Crystal structure index
-     * @param q1 Quaterions for the Feature
-     * @param q2 Quaterions for the Feature neighbor
-     */
-    void MC_LoopBody1(int32_t feature, size_t ensem, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
-
-    /**
-     * @brief MC_LoopBody2 Reinserts the swapped orientation if the swap did not improve the fit
-     * @param feature Feature Id of the Feature that has been swapped
-     * @param phase Ensemble index of the current phase
-     * @param j Neighbor index for the Feature
-     * @param neighsurfarea Surface area for the Feature neighbor
-     * @param sym Crystal structure index
-     * @param q1 Quaternions for the Feature
-     * @param q2 Quaternions for the Feature neighbor
-     */
-    void MC_LoopBody2(int32_t feature, size_t phase, size_t j, float neighsurfarea, uint32_t sym, QuatF& q1, QuatF& q2);
-
     /**
      * @brief matchCrystallography Swaps orientations for Features unitl convergence to
-     * the input statistics
+     * the input statistics. Moves are proposed in batches whose histogram updates are
+     * evaluated in parallel and then committed in proposal order
      * @param ensem Ensemble index of the current phase
      */
     void matchCrystallography(size_t ensem);
 
     /**
-     * @brief measure_misorientations Determines the misorientations between each Feature
+     * @brief measure_misorientations Determines the misorientation bin between each Feature
+     * and its neighbors and accumulates the simulated MDF
      * @param ensem Ensemle index of the current phase
      */
     void measure_misorientations(size_t ensem);
@@ -276,18 +260,18 @@ class MatchCrystallography : public AbstractFilter
     StatsDataArray::WeakPointer m_StatsDataArray;
 
     // All other private instance variables
-    float mdfchange;
-    float odfchange;
 
     std::vector<float> unbiasedvol;
     std::vector<float> m_TotalSurfaceArea;
+    uint64_t m_NextSeed; // Seed of the next random number generator; set by execute()
 
     FloatArrayType::Pointer actualodf;
     FloatArrayType::Pointer simodf;
     FloatArrayType::Pointer actualmdf;
     FloatArrayType::Pointer simmdf;
 
-    std::vector<std::vector<float> > m_MisorientationLists;
+    std::vector<int32_t> m_FeatureOdfBins;
+    std::vector<std::vector<int32_t> > m_MisorientationBins;
 
     QVector<SpaceGroupOps::Pointer> m_OrientationOps;
 
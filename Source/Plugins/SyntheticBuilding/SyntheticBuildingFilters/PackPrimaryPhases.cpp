@@ -36,11 +36,13 @@
 
 #include "PackPrimaryPhases.h"
 
+#include <algorithm>
+
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
 #include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
 #include <tbb/blocked_range3d.h>
 #include <tbb/partitioner.h>
-#include <tbb/task_scheduler_init.h>
 #endif
 
 #include <QtCore/QFile>
@@ -53,6 +55,7 @@
 #include "SIMPLib/FilterParameters/AbstractFilterParametersWriter.h"
 
 #include "SIMPLib/FilterParameters/BooleanFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntFilterParameter.h"
 #include "SIMPLib/FilterParameters/AttributeMatrixSelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -64,6 +67,7 @@
 #include "SIMPLib/StatsData/PrimaryStatsData.h"
 #include "SIMPLib/Utilities/SIMPLibRandom.h"
 #include "SIMPLib/Utilities/TimeUtilities.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "OrientationLib/OrientationMath/OrientationTransforms.hpp"
 
@@ -151,6 +155,14 @@ class AssignVoxelsGapsImpl
       int32_t* newowners = newownersPtr->getPointer(0);
       float* ellipfuncs = ellipfuncsPtr->getPointer(0);
 
+      if (zEnd <= zStart) { return; }
+      // The inside test is run for a whole column of planes at once
+      size_t rowLength = static_cast<size_t>(zEnd - zStart);
+      std::vector<float> axis1comps(rowLength, 0.0f);
+      std::vector<float> axis2comps(rowLength, 0.0f);
+      std::vector<float> axis3comps(rowLength, 0.0f);
+      std::vector<float> insides(rowLength, -1.0f);
+
       DimType dim0_dim_1 = dims[0] * dims[1];
       for (DimType iter1 = xStart; iter1 < xEnd; iter1++)
       {
@@ -167,13 +179,7 @@ class AssignVoxelsGapsImpl
 
           for (DimType iter3 = zStart; iter3 < zEnd; iter3++)
           {
-            plane = iter3;
-            if (iter3 < 0) { plane = iter3 + dims[2]; }
-            else if (iter3 > dims[2] - 1) { plane = iter3 - dims[2]; }
-
-            index = static_cast<DimType>( (plane * dim0_dim_1) + (row_dim) + column );
-
-            inside = -1.0f;
+            size_t k = static_cast<size_t>(iter3 - zStart);
             coords[0] = float(iter1) * res[0];
             coords[1] = float(iter2) * res[1];
             coords[2] = float(iter3) * res[2];
@@ -182,17 +188,25 @@ class AssignVoxelsGapsImpl
             coords[1] = coords[1] - yc;
             coords[2] = coords[2] - zc;
             MatrixMath::Multiply3x3with3x1(ga, coords, coordsRotated);
-            float axis1comp = coordsRotated[0] * Invradcur[0];
-            float axis2comp = coordsRotated[1] * Invradcur[1];
-            float axis3comp = coordsRotated[2] * Invradcur[2];
-            inside = m_ShapeOps->inside(axis1comp, axis2comp, axis3comp);
-            //if (inside >= 0 && newowners[index] > 0)
+            axis1comps[k] = coordsRotated[0] * Invradcur[0];
+            axis2comps[k] = coordsRotated[1] * Invradcur[1];
+            axis3comps[k] = coordsRotated[2] * Invradcur[2];
+          }
+          m_ShapeOps->insideBatch(&axis1comps[0], &axis2comps[0], &axis3comps[0], &insides[0], rowLength);
+
+          for (DimType iter3 = zStart; iter3 < zEnd; iter3++)
+          {
+            plane = iter3;
+            if (iter3 < 0) { plane = iter3 + dims[2]; }
+            else if (iter3 > dims[2] - 1) { plane = iter3 - dims[2]; }
+
+            index = static_cast<DimType>( (plane * dim0_dim_1) + (row_dim) + column );
+
+            inside = insides[iter3 - zStart];
             if (inside >= 0 && newowners[index] > 0 && inside > ellipfuncs[index])
             {
               newowners[index] = curFeature;
               ellipfuncs[index] = inside;
-              //newowners[index] = -2;
-              //ellipfuncs[index] = inside;
             }
             else if (inside >= 0 && newowners[index] == -1)
             {
@@ -215,6 +229,178 @@ class AssignVoxelsGapsImpl
 
 };
 
+namespace Detail
+{
+  // Number of adjustment moves proposed and evaluated together during feature placement
+  static const int32_t PackingMoveBatchSize = 256;
+  // Edge length, in packing points, of the blocks used to detect overlapping moves in a batch
+  static const int64_t PackingBlockShift = 2;
+  // Size of the uniform hash of Feature centroids along each axis is limited to this many cells
+  static const int64_t MaxFeatureHashCells = 128;
+
+  /**
+   * @brief The PackingMove struct is one proposed relocation of a Feature's centroid
+   */
+  struct PackingMove
+  {
+    int32_t feature;
+    float xc;
+    float yc;
+    float zc;
+  };
+
+  /**
+   * @brief The PackingMoveResult struct holds the exact change to the unnormalized filling error
+   * that a PackingMove would cause, along with the packing blocks it reads
+   */
+  struct PackingMoveResult
+  {
+    int64_t fillingChange;
+    std::vector<int64_t> oldPoints;
+    std::vector<int64_t> newPoints;
+    std::vector<int64_t> blocks;
+  };
+}
+
+/**
+ * @brief The EvaluatePackingMovesImpl class computes, without modifying the packing grid, how much
+ * the filling error would change if a Feature were moved. Removing a Feature from a point whose
+ * owner count is o changes the error by -2o + 3 and adding one changes it by 2o - 1, so the change
+ * caused by a move only depends on how many times the old and new stencils cover each point.
+ */
+class EvaluatePackingMovesImpl
+{
+    int64_t m_PackingPoints[3];
+    int64_t m_BlockDims[2];
+    float m_HalfPackingRes[3];
+    float m_OneOverPackingRes[3];
+    bool m_PeriodicBoundaries;
+    int32_t* m_FeatureOwners;
+    float* m_Centroids;
+    const std::vector<std::vector<int64_t> >& m_ColumnList;
+    const std::vector<std::vector<int64_t> >& m_RowList;
+    const std::vector<std::vector<int64_t> >& m_PlaneList;
+    const Detail::PackingMove* m_Moves;
+    Detail::PackingMoveResult* m_Results;
+
+  public:
+    EvaluatePackingMovesImpl(int64_t* packingPoints, float* halfPackingRes, float* oneOverPackingRes, bool periodicBoundaries,
+                             int32_t* featureOwners, float* centroids, const std::vector<std::vector<int64_t> >& columnList,
+                             const std::vector<std::vector<int64_t> >& rowList, const std::vector<std::vector<int64_t> >& planeList,
+                             const Detail::PackingMove* moves, Detail::PackingMoveResult* results) :
+      m_PeriodicBoundaries(periodicBoundaries),
+      m_FeatureOwners(featureOwners),
+      m_Centroids(centroids),
+      m_ColumnList(columnList),
+      m_RowList(rowList),
+      m_PlaneList(planeList),
+      m_Moves(moves),
+      m_Results(results)
+    {
+      for (int32_t i = 0; i < 3; i++)
+      {
+        m_PackingPoints[i] = packingPoints[i];
+        m_HalfPackingRes[i] = halfPackingRes[i];
+        m_OneOverPackingRes[i] = oneOverPackingRes[i];
+      }
+      m_BlockDims[0] = (m_PackingPoints[0] >> Detail::PackingBlockShift) + 1;
+      m_BlockDims[1] = (m_PackingPoints[1] >> Detail::PackingBlockShift) + 1;
+    }
+    virtual ~EvaluatePackingMovesImpl() {}
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void evaluate(const Detail::PackingMove& move, Detail::PackingMoveResult& result) const
+    {
+      size_t gnum = static_cast<size_t>(move.feature);
+      // Same centroid to packing point shift that move_feature applies
+      int64_t shiftcolumn = static_cast<int64_t>( (move.xc - m_HalfPackingRes[0]) * m_OneOverPackingRes[0] )
+                            - static_cast<int64_t>( (m_Centroids[3 * gnum] - m_HalfPackingRes[0]) * m_OneOverPackingRes[0] );
+      int64_t shiftrow = static_cast<int64_t>( (move.yc - m_HalfPackingRes[1]) * m_OneOverPackingRes[1] )
+                         - static_cast<int64_t>( (m_Centroids[3 * gnum + 1] - m_HalfPackingRes[1]) * m_OneOverPackingRes[1] );
+      int64_t shiftplane = static_cast<int64_t>( (move.zc - m_HalfPackingRes[2]) * m_OneOverPackingRes[2] )
+                           - static_cast<int64_t>( (m_Centroids[3 * gnum + 2] - m_HalfPackingRes[2]) * m_OneOverPackingRes[2] );
+
+      result.oldPoints.clear();
+      result.newPoints.clear();
+      result.blocks.clear();
+      const std::vector<int64_t>& cl = m_ColumnList[gnum];
+      const std::vector<int64_t>& rl = m_RowList[gnum];
+      const std::vector<int64_t>& pl = m_PlaneList[gnum];
+      size_t size = cl.size();
+      for (size_t i = 0; i < size; i++)
+      {
+        addPoint(cl[i], rl[i], pl[i], result.oldPoints, result.blocks);
+        addPoint(cl[i] + shiftcolumn, rl[i] + shiftrow, pl[i] + shiftplane, result.newPoints, result.blocks);
+      }
+      std::sort(result.oldPoints.begin(), result.oldPoints.end());
+      std::sort(result.newPoints.begin(), result.newPoints.end());
+      std::sort(result.blocks.begin(), result.blocks.end());
+      result.blocks.erase(std::unique(result.blocks.begin(), result.blocks.end()), result.blocks.end());
+
+      // Walk both sorted lists together so each packing point is visited once with its old (a) and new (b) coverage
+      int64_t change = 0;
+      size_t i = 0, j = 0;
+      size_t numOld = result.oldPoints.size();
+      size_t numNew = result.newPoints.size();
+      while (i < numOld || j < numNew)
+      {
+        int64_t point = 0;
+        if (j >= numNew || (i < numOld && result.oldPoints[i] <= result.newPoints[j])) { point = result.oldPoints[i]; }
+        else { point = result.newPoints[j]; }
+        int64_t a = 0, b = 0;
+        while (i < numOld && result.oldPoints[i] == point) { a++; i++; }
+        while (j < numNew && result.newPoints[j] == point) { b++; j++; }
+        int64_t o = m_FeatureOwners[point];
+        change += (-2 * a * o) + (a * a) + (2 * a) + (2 * b * (o - a)) + (b * b) - (2 * b);
+      }
+      result.fillingChange = change;
+    }
+
+    // -----------------------------------------------------------------------------
+    //
+    // -----------------------------------------------------------------------------
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        evaluate(m_Moves[i], m_Results[i]);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+
+    // -----------------------------------------------------------------------------
+    // Applies the same boundary handling as check_fillingerror
+    // -----------------------------------------------------------------------------
+    void addPoint(int64_t col, int64_t row, int64_t plane, std::vector<int64_t>& points, std::vector<int64_t>& blocks) const
+    {
+      if (m_PeriodicBoundaries == true)
+      {
+        if (col < 0) { col = col + m_PackingPoints[0]; }
+        if (col > m_PackingPoints[0] - 1) { col = col - m_PackingPoints[0]; }
+        if (row < 0) { row = row + m_PackingPoints[1]; }
+        if (row > m_PackingPoints[1] - 1) { row = row - m_PackingPoints[1]; }
+        if (plane < 0) { plane = plane + m_PackingPoints[2]; }
+        if (plane > m_PackingPoints[2] - 1) { plane = plane - m_PackingPoints[2]; }
+      }
+      else if (col < 0 || col >= m_PackingPoints[0] || row < 0 || row >= m_PackingPoints[1] || plane < 0 || plane >= m_PackingPoints[2])
+      {
+        return;
+      }
+      points.push_back((m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + col);
+      blocks.push_back((m_BlockDims[0] * m_BlockDims[1] * (plane >> Detail::PackingBlockShift)) + (m_BlockDims[0] * (row >> Detail::PackingBlockShift)) + (col >> Detail::PackingBlockShift));
+    }
+};
+
 
 // Include the MOC generated file for this class
 #include "moc_PackPrimaryPhases.cpp"
@@ -242,6 +428,8 @@ PackPrimaryPhases::PackPrimaryPhases() :
   m_FeatureInputFile(""),
   m_CsvOutputFile(""),
   m_PeriodicBoundaries(false),
+  m_UseFixedSeed(false),
+  m_RandomSeed(0),
   m_WriteGoalAttributes(false),
   m_ErrorOutputFile(""),
   m_VtkOutputFile(""),
@@ -282,6 +470,9 @@ PackPrimaryPhases::PackPrimaryPhases() :
   m_PackingPoints[0] = m_PackingPoints[1] = m_PackingPoints[2] = 1;
 
   m_TotalPackingPoints = 1;
+  m_HashDims[0] = m_HashDims[1] = m_HashDims[2] = 1;
+  m_OneOverHashCellSize[0] = m_OneOverHashCellSize[1] = m_OneOverHashCellSize[2] = 1.0f;
+  m_NeighborDistCountsValid = false;
   availablePointsCount = 1;
   fillingerror = oldfillingerror = 0.0f;
   currentneighborhooderror = oldneighborhooderror = 0.0f;
@@ -309,7 +500,11 @@ void PackPrimaryPhases::setupFilterParameters()
 {
   FilterParameterVector parameters;
   parameters.push_back(BooleanFilterParameter::New("Periodic Boundaries", "PeriodicBoundaries", getPeriodicBoundaries(), FilterParameter::Parameter));
-  QStringList linkedProps("MaskArrayPath");
+  QStringList linkedProps("RandomSeed");
+  parameters.push_back(LinkedBooleanFilterParameter::New("Use Fixed Random Seed", "UseFixedSeed", getUseFixedSeed(), linkedProps, FilterParameter::Parameter));
+  parameters.push_back(IntFilterParameter::New("Random Seed", "RandomSeed", getRandomSeed(), FilterParameter::Parameter));
+  linkedProps.clear();
+  linkedProps << "MaskArrayPath";
   parameters.push_back(LinkedBooleanFilterParameter::New("Use Mask", "UseMask", getUseMask(), linkedProps, FilterParameter::Parameter));
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -389,6 +584,8 @@ void PackPrimaryPhases::readFilterParameters(AbstractFilterParametersReader* rea
   setFeaturePhasesArrayName( reader->readString("FeaturePhasesArrayName", getFeaturePhasesArrayName() ) );
   setNumFeaturesArrayName( reader->readString("NumFeaturesArrayName", getNumFeaturesArrayName() ) );
   setPeriodicBoundaries( reader->readValue("PeriodicBoundaries", false) );
+  setUseFixedSeed( reader->readValue("UseFixedSeed", getUseFixedSeed()) );
+  setRandomSeed( reader->readValue("RandomSeed", getRandomSeed()) );
   setWriteGoalAttributes( reader->readValue("WriteGoalAttributes", false) );
   setUseMask( reader->readValue("UseMask", getUseMask()) );
   setHaveFeatures( reader->readValue("HaveFeatures", getHaveFeatures()) );
@@ -418,6 +615,8 @@ int PackPrimaryPhases::writeFilterParameters(AbstractFilterParametersWriter* wri
   SIMPL_FILTER_WRITE_PARAMETER(FeaturePhasesArrayName)
   SIMPL_FILTER_WRITE_PARAMETER(NumFeaturesArrayName)
   SIMPL_FILTER_WRITE_PARAMETER(PeriodicBoundaries)
+  SIMPL_FILTER_WRITE_PARAMETER(UseFixedSeed)
+  SIMPL_FILTER_WRITE_PARAMETER(RandomSeed)
   SIMPL_FILTER_WRITE_PARAMETER(UseMask)
   SIMPL_FILTER_WRITE_PARAMETER(HaveFeatures)
   SIMPL_FILTER_WRITE_PARAMETER(WriteGoalAttributes)
@@ -808,7 +1007,9 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   }
 
   setErrorCondition(0);
-  m_Seed = QDateTime::currentMSecsSinceEpoch();
+  // Every random number generator used to generate and place the Features is seeded from here,
+  // so a fixed seed makes the packing reproducible
+  m_Seed = (getUseFixedSeed() == true) ? static_cast<uint64_t>(getRandomSeed()) : static_cast<uint64_t>(QDateTime::currentMSecsSinceEpoch());
   SIMPL_RANDOMNG_NEW_SEEDED(m_Seed);
 
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
@@ -858,6 +1059,8 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   int32_t randomfeature = 0;
   float xc = 0.0f, yc = 0.0f, zc = 0.0f;
   float oldxc = 0.0f, oldyc = 0.0f, oldzc = 0.0f;
+  m_HashCells.clear();
+  m_NeighborDistCountsValid = false;
   oldfillingerror = 0.0f;
   currentneighborhooderror = 0.0f, oldneighborhooderror = 0.0f;
   currentsizedisterror = 0.0f, oldsizedisterror = 0.0f;
@@ -895,9 +1098,10 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   Int32ArrayType::Pointer exclusionOwnersPtr = Int32ArrayType::CreateArray(m_TotalPackingPoints, cDim, "_INTERNAL_USE_ONLY_PackPrimaryFeatures::exclusions_owners");
   exclusionOwnersPtr->initializeWithValue(0);
 
-  // This is the set that we are going to keep updated with the points that are not in an exclusion zone
-  std::map<size_t, size_t> availablePoints;
-  std::map<size_t, size_t> availablePointsInv;
+  // This is the set that we are going to keep updated with the points that are not in an exclusion zone. availablePointsInv
+  // lists the available points and availablePoints holds the position of each packing point in that list, or -1
+  std::vector<int64_t> availablePoints(m_TotalPackingPoints, -1);
+  std::vector<int64_t> availablePointsInv(m_TotalPackingPoints, -1);
 
   // Get a pointer to the Feature Owners that was just initialized in the initialize_packinggrid() method
   int32_t* featureOwners = featureOwnersPtr->getPointer(0);
@@ -906,6 +1110,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
 
   // determine initial set of available points
   availablePointsCount = 0;
+  std::fill(availablePoints.begin(), availablePoints.end(), -1);
   for (int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if ((exclusionOwners[i] == 0 && m_UseMask == false) || (exclusionOwners[i] == 0 && m_UseMask == true && m_Mask[i] == true))
@@ -923,6 +1128,8 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   featuresizedist.resize(primaryphases.size());
   simfeaturesizedist.resize(primaryphases.size());
   featuresizediststep.resize(primaryphases.size());
+  m_SizeDistCounts.resize(primaryphases.size());
+  m_SizeDistTotals.assign(primaryphases.size(), 0);
   size_t numPrimaryPhases = primaryphases.size();
   for (size_t i = 0; i < numPrimaryPhases; i++)
   {
@@ -930,6 +1137,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
     PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
     featuresizedist[i].resize(40);
     simfeaturesizedist[i].resize(40);
+    m_SizeDistCounts[i].assign(40, 0);
     featuresizediststep[i] = static_cast<float>(((2 * pp->getMaxFeatureDiameter()) - (pp->getMinFeatureDiameter() / 2.0f)) / featuresizedist[i].size());
     float input = 0.0f;
     float previoustotal = 0.0f;
@@ -1177,6 +1385,8 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   uint64_t estimatedTime = 0;
   float timeDiff = 0.0f;
 
+  build_feature_hash();
+
   // determine neighborhoods and initial neighbor distribution errors
   for (size_t i = firstPrimaryFeature; i < totalFeatures; i++)
   {
@@ -1200,6 +1410,7 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
 
   // determine initial set of available points
   availablePointsCount = 0;
+  std::fill(availablePoints.begin(), availablePoints.end(), -1);
   for (int64_t i = 0; i < m_TotalPackingPoints; i++)
   {
     if ((exclusionOwners[i] == 0 && m_UseMask == false) || (exclusionOwners[i] == 0 && m_UseMask == true && m_Mask[i] == true))
@@ -1219,36 +1430,45 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
   bool good = false;
   size_t key = 0;
   float xshift = 0.0f, yshift = 0.0f, zshift = 0.0f;
-  int32_t lastIteration = 0;
-  for (int32_t iteration = 0; iteration < totalAdjustments; ++iteration)
+
+  // Moves are proposed and evaluated in batches. Each proposal is drawn from the state at the start of its batch,
+  // the filling error change of every proposal is computed in parallel, and the moves are then committed in order.
+  // A move whose Feature or packing blocks were changed by an earlier commit in the same batch is evaluated again.
+  std::vector<Detail::PackingMove> moves(Detail::PackingMoveBatchSize);
+  std::vector<Detail::PackingMoveResult> moveResults(Detail::PackingMoveBatchSize);
+  EvaluatePackingMovesImpl evaluator(m_PackingPoints, m_HalfPackingRes, m_OneOverPackingRes, m_PeriodicBoundaries, featureOwners, m_Centroids,
+                                     columnlist, rowlist, planelist, &(moves.front()), &(moveResults.front()));
+  int64_t blockDims[3] = { 0, 0, 0 };
+  for (int32_t i = 0; i < 3; i++)
+  {
+    blockDims[i] = (m_PackingPoints[i] >> Detail::PackingBlockShift) + 1;
+  }
+  std::vector<int32_t> blockStamps(blockDims[0] * blockDims[1] * blockDims[2], 0);
+  std::vector<int32_t> featureStamps(totalFeatures, 0);
+  int32_t batchStamp = 0;
+
+  for (int32_t batchStart = 0; batchStart < totalAdjustments; batchStart += Detail::PackingMoveBatchSize)
   {
     currentMillis = QDateTime::currentMSecsSinceEpoch();
     if (currentMillis - millis > 1000)
     {
-      QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(iteration).arg(totalAdjustments);
-      timeDiff = ((float)iteration / (float)(currentMillis - startMillis));
-      estimatedTime = (float)(totalAdjustments - iteration) / timeDiff;
+      QString ss = QObject::tr("Swapping/Moving/Adding/Removing Features Iteration %1/%2").arg(batchStart).arg(totalAdjustments);
+      timeDiff = ((float)batchStart / (float)(currentMillis - startMillis));
+      estimatedTime = (float)(totalAdjustments - batchStart) / timeDiff;
 
       ss += QObject::tr(" || Est. Time Remain: %1 || Iterations/Sec: %2").arg(DREAM3D::convertMillisToHrsMinSecs(estimatedTime)).arg(timeDiff * 1000);
       notifyStatusMessage(getMessagePrefix(), getHumanLabel(), ss);
 
       millis = QDateTime::currentMSecsSinceEpoch();
-      lastIteration = iteration;
     }
 
-
     if (getCancel() == true) { return; }
 
-    int32_t option = iteration % 2;
-
-    if (writeErrorFile == true && iteration % 25 == 0)
+    int32_t batchSize = std::min(Detail::PackingMoveBatchSize, totalAdjustments - batchStart);
+    for (int32_t m = 0; m < batchSize; m++)
     {
-      outFile << iteration << " " << fillingerror << "  " << availablePoints.size() << "  " << availablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
-    }
+      int32_t option = (batchStart + m) % 2;
 
-    // JUMP - this option moves one feature to a random spot in the volume
-    if (option == 0)
-    {
       randomfeature = firstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - firstPrimaryFeature));
       good = false;
       count = 0;
@@ -1268,101 +1488,85 @@ void PackPrimaryPhases::place_features(Int32ArrayType::Pointer featureOwnersPtr)
       }
       m_Seed++;
 
-      if (availablePoints.size() > 0)
+      // JUMP - this option moves one feature to a random spot in the volume
+      if (option == 0)
       {
-        key = static_cast<size_t>(rg.genrand_res53() * (availablePointsCount - 1));
-        featureOwnersIdx = availablePointsInv[key];
-      }
-      else
-      {
-        featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
+        if (availablePointsCount > 0)
+        {
+          key = static_cast<size_t>(rg.genrand_res53() * (availablePointsCount - 1));
+          featureOwnersIdx = availablePointsInv[key];
+        }
+        else
+        {
+          featureOwnersIdx = static_cast<size_t>(rg.genrand_res53() * m_TotalPackingPoints);
+        }
+
+        // find the column row and plane of that point
+        column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
+        row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
+        plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
+        xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
+        yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
+        zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
       }
 
-      // find the column row and plane of that point
-      column = static_cast<int64_t>(featureOwnersIdx % m_PackingPoints[0]);
-      row = static_cast<int64_t>(featureOwnersIdx / m_PackingPoints[0]) % m_PackingPoints[1];
-      plane = static_cast<int64_t>(featureOwnersIdx / (m_PackingPoints[0] * m_PackingPoints[1]));
-      xc = static_cast<float>((column * m_PackingRes[0]) + (m_PackingRes[0] * 0.5));
-      yc = static_cast<float>((row * m_PackingRes[1]) + (m_PackingRes[1] * 0.5));
-      zc = static_cast<float>((plane * m_PackingRes[2]) + (m_PackingRes[2] * 0.5));
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      oldfillingerror = fillingerror;
-      fillingerror = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      move_feature(randomfeature, xc, yc, zc);
-      fillingerror = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-      currentneighborhooderror = check_neighborhooderror(-1000, randomfeature);
-      if (fillingerror <= oldfillingerror)
+      // NUDGE - this option moves one feature to a spot close to its current centroid
+      if (option == 1)
       {
-        oldneighborhooderror = currentneighborhooderror;
-        update_availablepoints(availablePoints, availablePointsInv);
-        acceptedmoves++;
-      }
-      else if (fillingerror > oldfillingerror)
-      {
-        fillingerror = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        move_feature(randomfeature, oldxc, oldyc, oldzc);
-        fillingerror = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        pointsToRemove.clear();
-        pointsToAdd.clear();
+        oldxc = m_Centroids[3 * randomfeature];
+        oldyc = m_Centroids[3 * randomfeature + 1];
+        oldzc = m_Centroids[3 * randomfeature + 2];
+        xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])) );
+        yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])) );
+        zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])) );
+        if ((oldxc + xshift) < sizex && (oldxc + xshift) > 0) { xc = oldxc + xshift; }
+        else { xc = oldxc; }
+        if ((oldyc + yshift) < sizey && (oldyc + yshift) > 0) { yc = oldyc + yshift; }
+        else { yc = oldyc; }
+        if ((oldzc + zshift) < sizez && (oldzc + zshift) > 0) { zc = oldzc + zshift; }
+        else { zc = oldzc; }
       }
+
+      moves[m].feature = randomfeature;
+      moves[m].xc = xc;
+      moves[m].yc = yc;
+      moves[m].zc = zc;
     }
 
-    // NUDGE - this option moves one feature to a spot close to its current centroid
-    if (option == 1)
+    ParallelContext::ParallelFor<size_t>(0, batchSize, evaluator);
+
+    batchStamp++;
+    for (int32_t m = 0; m < batchSize; m++)
     {
-      randomfeature = firstPrimaryFeature + int32_t(rg.genrand_res53() * (totalFeatures - firstPrimaryFeature));
-      good = false;
-      count = 0;
-      while (good == false && count < static_cast<int32_t>((totalFeatures - firstPrimaryFeature)) )
+      int32_t iteration = batchStart + m;
+      if (writeErrorFile == true && iteration % 25 == 0)
       {
-        xc = m_Centroids[3 * randomfeature];
-        yc = m_Centroids[3 * randomfeature + 1];
-        zc = m_Centroids[3 * randomfeature + 2];
-        column = static_cast<int64_t>( (xc - (m_HalfPackingRes[0])) * m_OneOverPackingRes[0] );
-        row = static_cast<int64_t>( (yc - (m_HalfPackingRes[1])) * m_OneOverPackingRes[1] );
-        plane = static_cast<int64_t>( (zc - (m_HalfPackingRes[2])) * m_OneOverPackingRes[2] );
-        featureOwnersIdx = (m_PackingPoints[0] * m_PackingPoints[1] * plane) + (m_PackingPoints[0] * row) + column;
-        if (featureOwners[featureOwnersIdx] > 1) { good = true; }
-        else { randomfeature++; }
-        if (static_cast<size_t>(randomfeature) >= totalFeatures) { randomfeature = firstPrimaryFeature; }
-        count++;
+        outFile << iteration << " " << fillingerror << "  " << availablePointsCount << " " << totalFeatures << " " << acceptedmoves << "\n";
       }
-      m_Seed++;
-      oldxc = m_Centroids[3 * randomfeature];
-      oldyc = m_Centroids[3 * randomfeature + 1];
-      oldzc = m_Centroids[3 * randomfeature + 2];
-      xshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[0])) );
-      yshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[1])) );
-      zshift = static_cast<float>(((2.0f * (rg.genrand_res53() - 0.5f)) * (2.0f * m_PackingRes[2])) );
-      if ((oldxc + xshift) < sizex && (oldxc + xshift) > 0) { xc = oldxc + xshift; }
-      else { xc = oldxc; }
-      if ((oldyc + yshift) < sizey && (oldyc + yshift) > 0) { yc = oldyc + yshift; }
-      else { yc = oldyc; }
-      if ((oldzc + zshift) < sizez && (oldzc + zshift) > 0) { zc = oldzc + zshift; }
-      else { zc = oldzc; }
-      oldfillingerror = fillingerror;
-      fillingerror = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-      move_feature(randomfeature, xc, yc, zc);
-      fillingerror = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-      currentneighborhooderror = check_neighborhooderror(-1000, randomfeature);
-      //      change2 = (currentneighborhooderror * currentneighborhooderror) - (oldneighborhooderror * oldneighborhooderror);
-      //      if(fillingerror <= oldfillingerror && currentneighborhooderror >= oldneighborhooderror)
-      if (fillingerror <= oldfillingerror)
+
+      randomfeature = moves[m].feature;
+      Detail::PackingMoveResult& result = moveResults[m];
+      bool stale = (featureStamps[randomfeature] == batchStamp);
+      for (size_t b = 0; b < result.blocks.size() && stale == false; b++)
       {
+        if (blockStamps[result.blocks[b]] == batchStamp) { stale = true; }
+      }
+      if (stale == true) { evaluator.evaluate(moves[m], result); }
+
+      if (result.fillingChange <= 0)
+      {
+        fillingerror = check_fillingerror(-1000, static_cast<int32_t>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
+        move_feature(randomfeature, moves[m].xc, moves[m].yc, moves[m].zc);
+        fillingerror = check_fillingerror(static_cast<int32_t>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
+        currentneighborhooderror = check_neighborhooderror(-1000, randomfeature);
         oldneighborhooderror = currentneighborhooderror;
         update_availablepoints(availablePoints, availablePointsInv);
         acceptedmoves++;
-      }
-      //      else if(fillingerror > oldfillingerror || currentneighborhooderror < oldneighborhooderror)
-      else if (fillingerror > oldfillingerror)
-      {
-        fillingerror = check_fillingerror(-1000, static_cast<int>(randomfeature), featureOwnersPtr, exclusionOwnersPtr);
-        move_feature(randomfeature, oldxc, oldyc, oldzc);
-        fillingerror = check_fillingerror(static_cast<int>(randomfeature), -1000, featureOwnersPtr, exclusionOwnersPtr);
-        pointsToRemove.clear();
-        pointsToAdd.clear();
+        featureStamps[randomfeature] = batchStamp;
+        for (size_t b = 0; b < result.blocks.size(); b++)
+        {
+          blockStamps[result.blocks[b]] = batchStamp;
+        }
       }
     }
   }
@@ -1533,6 +1737,13 @@ void PackPrimaryPhases::transfer_attributes(int32_t gnum, Feature_t* feature)
   m_Omega3s[gnum] = feature->m_Omega3s;
   m_FeaturePhases[gnum] = feature->m_FeaturePhases;
   m_Neighborhoods[gnum] = feature->m_Neighborhoods;
+
+  size_t iter = 0, bin = 0;
+  if (size_dist_bin(feature->m_FeaturePhases, feature->m_EquivalentDiameters, iter, bin) == true && iter < m_SizeDistCounts.size())
+  {
+    m_SizeDistCounts[iter][bin]++;
+    m_SizeDistTotals[iter]++;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1569,6 +1780,11 @@ void PackPrimaryPhases::move_feature(size_t gnum, float xc, float yc, float zc)
     int64_t& pl = planelist[gnum][i];
     pl += shiftplane;
   }
+
+  if (gnum < m_HashNext.size() && m_HashCells.empty() == false)
+  {
+    update_feature_hash(gnum);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -1576,8 +1792,6 @@ void PackPrimaryPhases::move_feature(size_t gnum, float xc, float yc, float zc)
 // -----------------------------------------------------------------------------
 void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
-
   float x = 0.0f, y = 0.0f, z = 0.0f;
   float xn = 0.0f, yn = 0.0f, zn = 0.0f;
   float dia = 0.0f, dia2 = 0.0f;
@@ -1586,26 +1800,42 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
   y = m_Centroids[3 * gnum + 1];
   z = m_Centroids[3 * gnum + 2];
   dia = m_EquivalentDiameters[gnum];
-  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumTuples();
   int32_t increment = 0;
   if (add == true) { increment = 1; }
   if (add == false) { increment = -1; }
-  for (size_t n = firstPrimaryFeature; n < totalFeatures; n++)
-  {
-    xn = m_Centroids[3 * n];
-    yn = m_Centroids[3 * n + 1];
-    zn = m_Centroids[3 * n + 2];
-    dia2 = m_EquivalentDiameters[n];
-    dx = fabs(x - xn);
-    dy = fabs(y - yn);
-    dz = fabs(z - zn);
-    if (dx < dia && dy < dia && dz < dia)
-    {
-      m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
-    }
-    if (dx < dia2 && dy < dia2 && dz < dia2)
+
+  // Hash cells are at least as large as the largest Feature diameter, so every Feature within
+  // reach lies in the cell holding gnum or in one of its 26 neighbors
+  int64_t cell = feature_hash_cell(x, y, z);
+  int64_t cellx = cell % m_HashDims[0];
+  int64_t celly = (cell / m_HashDims[0]) % m_HashDims[1];
+  int64_t cellz = cell / (m_HashDims[0] * m_HashDims[1]);
+  for (int64_t k = std::max<int64_t>(cellz - 1, 0); k <= std::min<int64_t>(cellz + 1, m_HashDims[2] - 1); k++)
+  {
+    for (int64_t j = std::max<int64_t>(celly - 1, 0); j <= std::min<int64_t>(celly + 1, m_HashDims[1] - 1); j++)
     {
-      m_Neighborhoods[n] = m_Neighborhoods[n] + increment;
+      for (int64_t i = std::max<int64_t>(cellx - 1, 0); i <= std::min<int64_t>(cellx + 1, m_HashDims[0] - 1); i++)
+      {
+        int32_t n = m_HashCellHeads[(m_HashDims[0] * m_HashDims[1] * k) + (m_HashDims[0] * j) + i];
+        for (; n >= 0; n = m_HashNext[n])
+        {
+          xn = m_Centroids[3 * n];
+          yn = m_Centroids[3 * n + 1];
+          zn = m_Centroids[3 * n + 2];
+          dia2 = m_EquivalentDiameters[n];
+          dx = fabs(x - xn);
+          dy = fabs(y - yn);
+          dz = fabs(z - zn);
+          if (dx < dia && dy < dia && dz < dia)
+          {
+            update_neighborhood(gnum, increment);
+          }
+          if (dx < dia2 && dy < dia2 && dz < dia2)
+          {
+            update_neighborhood(n, increment);
+          }
+        }
+      }
     }
   }
 }
@@ -1613,41 +1843,165 @@ void PackPrimaryPhases::determine_neighbors(size_t gnum, bool add)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
+int64_t PackPrimaryPhases::feature_hash_cell(float xc, float yc, float zc)
+{
+  int64_t cell[3] = { static_cast<int64_t>(xc * m_OneOverHashCellSize[0]), static_cast<int64_t>(yc * m_OneOverHashCellSize[1]), static_cast<int64_t>(zc * m_OneOverHashCellSize[2]) };
+  for (int32_t i = 0; i < 3; i++)
+  {
+    if (cell[i] < 0) { cell[i] = 0; }
+    if (cell[i] > m_HashDims[i] - 1) { cell[i] = m_HashDims[i] - 1; }
+  }
+  return (m_HashDims[0] * m_HashDims[1] * cell[2]) + (m_HashDims[0] * cell[1]) + cell[0];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::build_feature_hash()
 {
-  // Optimized Code
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumTuples();
+
+  float maxDiameter = 0.0f;
+  for (size_t i = firstPrimaryFeature; i < totalFeatures; i++)
+  {
+    if (m_EquivalentDiameters[i] > maxDiameter) { maxDiameter = m_EquivalentDiameters[i]; }
+  }
+
+  // Use as many cells as fit along each axis without any cell being narrower than the largest Feature
+  float sizes[3] = { sizex, sizey, sizez };
+  for (int32_t i = 0; i < 3; i++)
+  {
+    m_HashDims[i] = 1;
+    if (maxDiameter > 0.0f) { m_HashDims[i] = static_cast<int64_t>(sizes[i] / maxDiameter); }
+    if (m_HashDims[i] < 1) { m_HashDims[i] = 1; }
+    if (m_HashDims[i] > Detail::MaxFeatureHashCells) { m_HashDims[i] = Detail::MaxFeatureHashCells; }
+    m_OneOverHashCellSize[i] = 0.0f;
+    if (sizes[i] > 0.0f) { m_OneOverHashCellSize[i] = static_cast<float>(m_HashDims[i]) / sizes[i]; }
+  }
+
+  m_HashCellHeads.assign(m_HashDims[0] * m_HashDims[1] * m_HashDims[2], -1);
+  m_HashNext.assign(totalFeatures, -1);
+  m_HashPrev.assign(totalFeatures, -1);
+  m_HashCells.assign(totalFeatures, -1);
+  for (size_t i = firstPrimaryFeature; i < totalFeatures; i++)
+  {
+    update_feature_hash(i);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::update_feature_hash(size_t gnum)
+{
+  int64_t cell = feature_hash_cell(m_Centroids[3 * gnum], m_Centroids[3 * gnum + 1], m_Centroids[3 * gnum + 2]);
+  int64_t oldCell = m_HashCells[gnum];
+  if (cell == oldCell) { return; }
+
+  if (oldCell >= 0)
+  {
+    if (m_HashPrev[gnum] >= 0) { m_HashNext[m_HashPrev[gnum]] = m_HashNext[gnum]; }
+    else { m_HashCellHeads[oldCell] = m_HashNext[gnum]; }
+    if (m_HashNext[gnum] >= 0) { m_HashPrev[m_HashNext[gnum]] = m_HashPrev[gnum]; }
+  }
+
+  int32_t head = m_HashCellHeads[cell];
+  m_HashPrev[gnum] = -1;
+  m_HashNext[gnum] = head;
+  if (head >= 0) { m_HashPrev[head] = static_cast<int32_t>(gnum); }
+  m_HashCellHeads[cell] = static_cast<int32_t>(gnum);
+  m_HashCells[gnum] = cell;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::neighbor_dist_bin(size_t gnum, size_t& iter, size_t& bin)
+{
+  int32_t phase = m_FeaturePhases[gnum];
+  size_t numPhases = simneighbordist.size();
+  for (iter = 0; iter < numPhases; ++iter)
+  {
+    if (primaryphases[iter] == phase) { break; }
+  }
+  if (iter >= numPhases) { return false; }
 
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
+  PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
+  size_t curSimNeighborDist_Size = simneighbordist[iter].size();
+  float maxFeatureDia = pp->getMaxFeatureDiameter();
+  float minFeatureDia = pp->getMinFeatureDiameter();
+  float dia = m_EquivalentDiameters[gnum];
+  if (dia > maxFeatureDia) { dia = maxFeatureDia; }
+  if (dia < minFeatureDia) { dia = minFeatureDia; }
+  size_t diabin = static_cast<size_t>(((dia - minFeatureDia) * (1.0f / pp->getBinStepSize())) );
+  if (diabin >= curSimNeighborDist_Size) { diabin = curSimNeighborDist_Size - 1; }
+  size_t nnumbin = static_cast<size_t>( m_Neighborhoods[gnum] * (1.0f / neighbordiststep[iter]) );
+  if (nnumbin >= 40) { nnumbin = 39; }
+  bin = diabin * 40 + nnumbin;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::update_neighborhood(size_t gnum, int32_t increment)
+{
+  size_t iter = 0, bin = 0;
+  if (m_NeighborDistCountsValid == true && neighbor_dist_bin(gnum, iter, bin) == true)
+  {
+    m_NeighborDistCounts[iter][bin]--;
+  }
+  m_Neighborhoods[gnum] = m_Neighborhoods[gnum] + increment;
+  if (m_NeighborDistCountsValid == true && neighbor_dist_bin(gnum, iter, bin) == true)
+  {
+    m_NeighborDistCounts[iter][bin]++;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PackPrimaryPhases::rebuild_neighbor_dist_counts()
+{
+  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
+  size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumTuples();
+
+  size_t numPhases = simneighbordist.size();
+  m_NeighborDistCounts.resize(numPhases);
+  for (size_t iter = 0; iter < numPhases; ++iter)
+  {
+    m_NeighborDistCounts[iter].assign(simneighbordist[iter].size() * 40, 0);
+  }
+  size_t iter = 0, bin = 0;
+  for (size_t i = firstPrimaryFeature; i < totalFeatures; i++)
+  {
+    if (neighbor_dist_bin(i, iter, bin) == true) { m_NeighborDistCounts[iter][bin]++; }
+  }
+  m_NeighborDistCountsValid = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
+{
+  if (m_NeighborDistCountsValid == false) { rebuild_neighbor_dist_counts(); }
 
   float neighborerror = 0.0f;
   float bhattdist = 0.0f;
-  float dia = 0.0f;
-  int32_t nnum = 0;
-  size_t diabin = 0;
-  size_t nnumbin = 0;
-  int32_t index = 0;
   int32_t phase = 0;
+  size_t binIter = 0, bin = 0;
 
   typedef std::vector<std::vector<float> > VectOfVectFloat_t;
   size_t numPhases = simneighbordist.size();
   for (size_t iter = 0; iter < numPhases; ++iter)
   {
     phase = primaryphases[iter];
-    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
     VectOfVectFloat_t& curSimNeighborDist = simneighbordist[iter];
     size_t curSImNeighborDist_Size = curSimNeighborDist.size();
-    float oneOverNeighborDistStep = 1.0f / neighbordiststep[iter];
 
-    std::vector<int32_t> count(curSImNeighborDist_Size, 0);
-    for (size_t i = 0; i < curSImNeighborDist_Size; i++)
-    {
-      curSimNeighborDist[i].resize(40);
-      for (size_t j = 0; j < 40; j++)
-      {
-        curSimNeighborDist[i][j] = 0;
-      }
-    }
     if (gadd > 0 && m_FeaturePhases[gadd] == phase)
     {
       determine_neighbors(gadd, true);
@@ -1657,47 +2011,27 @@ float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
       determine_neighbors(gremove, false);
     }
 
-    float maxFeatureDia = pp->getMaxFeatureDiameter();
-    float minFeatureDia = pp->getMinFeatureDiameter();
-    float oneOverBinStepSize = 1.0f / pp->getBinStepSize();
-
-    size_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumTuples();
-    for (size_t i = firstPrimaryFeature; i < totalFeatures; i++)
+    // The running counts cover every Feature; leave out gremove and count gadd once more
+    std::vector<int32_t> counts = m_NeighborDistCounts[iter];
+    if (gremove > 0 && m_FeaturePhases[gremove] == phase && neighbor_dist_bin(gremove, binIter, bin) == true)
     {
-      nnum = 0;
-      index = static_cast<int32_t>(i);
-      if (index != gremove && m_FeaturePhases[index] == phase)
-      {
-        dia = m_EquivalentDiameters[index];
-        if (dia > maxFeatureDia) { dia = maxFeatureDia; }
-        if (dia < minFeatureDia) { dia = minFeatureDia; }
-        diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize) );
-        if (diabin >= curSImNeighborDist_Size) { diabin = curSImNeighborDist_Size - 1; }
-        nnum = m_Neighborhoods[index];
-        nnumbin = static_cast<size_t>( nnum * oneOverNeighborDistStep );
-        if (nnumbin >= 40) { nnumbin = 39; }
-        curSimNeighborDist[diabin][nnumbin]++;
-        count[diabin]++;
-      }
+      counts[bin]--;
     }
-    if (gadd > 0 && m_FeaturePhases[gadd] == phase)
+    if (gadd > 0 && m_FeaturePhases[gadd] == phase && neighbor_dist_bin(gadd, binIter, bin) == true)
     {
-      dia = m_EquivalentDiameters[gadd];
-      if (dia > maxFeatureDia) { dia = maxFeatureDia; }
-      if (dia < minFeatureDia) { dia = minFeatureDia; }
-      diabin = static_cast<size_t>(((dia - minFeatureDia) * oneOverBinStepSize) );
-      if (diabin >= curSImNeighborDist_Size) { diabin = curSImNeighborDist_Size - 1; }
-      nnum = m_Neighborhoods[gadd];
-      nnumbin = static_cast<size_t>( nnum * oneOverNeighborDistStep );
-      if(nnumbin >= 40) { nnumbin = 39; }
-      curSimNeighborDist[diabin][nnumbin]++;
-      count[diabin]++;
+      counts[bin]++;
     }
-    float runningtotal = 0.0f;
 
+    float runningtotal = 0.0f;
     for (size_t i = 0; i < curSImNeighborDist_Size; i++)
     {
-      if (count[i] == 0)
+      curSimNeighborDist[i].resize(40);
+      int32_t count = 0;
+      for (size_t j = 0; j < 40; j++)
+      {
+        count += counts[i * 40 + j];
+      }
+      if (count == 0)
       {
         for (size_t j = 0; j < 40; j++)
         {
@@ -1706,10 +2040,10 @@ float PackPrimaryPhases::check_neighborhooderror(int32_t gadd, int32_t gremove)
       }
       else
       {
-        float oneOverCount = 1.0f / (float)(count[i]);
+        float oneOverCount = 1.0f / (float)(count);
         for (size_t j = 0; j < 40; j++)
         {
-          curSimNeighborDist[i][j] = curSimNeighborDist[i][j] * oneOverCount;
+          curSimNeighborDist[i][j] = float(counts[i * 40 + j]) * oneOverCount;
           runningtotal = runningtotal + curSimNeighborDist[i][j];
         }
       }
@@ -1795,54 +2129,28 @@ void PackPrimaryPhases::compare_3Ddistributions(std::vector<std::vector<std::vec
 // -----------------------------------------------------------------------------
 float PackPrimaryPhases::check_sizedisterror(Feature_t* feature)
 {
-  DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getOutputCellAttributeMatrixPath().getDataContainerName());
-
-  StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
-
-  float dia = 0.0f;
   float sizedisterror = 0.0f;
   float bhattdist = 0.0f;
-  int32_t index = 0;
   int32_t count = 0;
-  int32_t phase = 0;
+  size_t featureIter = 0, featureBin = 0;
+  bool featureBinned = size_dist_bin(feature->m_FeaturePhases, feature->m_EquivalentDiameters, featureIter, featureBin);
+
+  // The per bin counts of the Features generated so far are kept by transfer_attributes
   size_t featureSizeDist_Size = featuresizedist.size();
   for (size_t iter = 0; iter < featureSizeDist_Size; ++iter)
   {
-    phase = primaryphases[iter];
-    PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
-    count = 0;
-    std::vector<float>& curFeatureSizeDist = featuresizedist[iter];
-    std::vector<float>::size_type curFeatureSizeDistSize = curFeatureSizeDist.size();
+    std::vector<float>::size_type curFeatureSizeDistSize = featuresizedist[iter].size();
     std::vector<float>& curSimFeatureSizeDist = simfeaturesizedist[iter];
-    // Initialize all Values to Zero
+    const std::vector<int32_t>& curCounts = m_SizeDistCounts[iter];
     for (size_t i = 0; i < curFeatureSizeDistSize; i++)
     {
-      curSimFeatureSizeDist[i] = 0.0f;
-    }
-    int64_t totalFeatures = m->getAttributeMatrix(m_OutputCellFeatureAttributeMatrixName)->getNumTuples();
-    float oneOverCurFeatureSizeDistStep = 1.0f / featuresizediststep[iter];
-    float halfMinFeatureDiameter = pp->getMinFeatureDiameter() * 0.5f;
-    for (int32_t b = firstPrimaryFeature; b < totalFeatures; b++)
-    {
-      index = b;
-      if (m_FeaturePhases[index] == phase)
-      {
-        dia = m_EquivalentDiameters[index];
-        dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
-        if (dia < 0) { dia = 0.0f; }
-        if (dia > curFeatureSizeDistSize - 1.0f) { dia = curFeatureSizeDistSize - 1.0f; }
-        curSimFeatureSizeDist[int32_t(dia)]++;
-        count++;
-      }
+      curSimFeatureSizeDist[i] = static_cast<float>(curCounts[i]);
     }
+    count = m_SizeDistTotals[iter];
 
-    if (feature->m_FeaturePhases == phase)
+    if (featureBinned == true && featureIter == iter)
     {
-      dia = feature->m_EquivalentDiameters;
-      dia = (dia - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
-      if (dia < 0) { dia = 0.0f; }
-      if (dia > curFeatureSizeDistSize - 1.0f) { dia = curFeatureSizeDistSize - 1.0f; }
-      curSimFeatureSizeDist[int32_t(dia)]++;
+      curSimFeatureSizeDist[featureBin]++;
       count++;
     }
     float oneOverCount = 1.0f / count;
@@ -1864,6 +2172,30 @@ float PackPrimaryPhases::check_sizedisterror(Feature_t* feature)
   return sizedisterror;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PackPrimaryPhases::size_dist_bin(int32_t phase, float diameter, size_t& iter, size_t& bin)
+{
+  size_t featureSizeDist_Size = featuresizedist.size();
+  for (iter = 0; iter < featureSizeDist_Size; ++iter)
+  {
+    if (primaryphases[iter] == phase) { break; }
+  }
+  if (iter >= featureSizeDist_Size) { return false; }
+
+  StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
+  PrimaryStatsData* pp = PrimaryStatsData::SafePointerDownCast(statsDataArray[phase].get());
+  std::vector<float>::size_type curFeatureSizeDistSize = featuresizedist[iter].size();
+  float oneOverCurFeatureSizeDistStep = 1.0f / featuresizediststep[iter];
+  float halfMinFeatureDiameter = pp->getMinFeatureDiameter() * 0.5f;
+  float dia = (diameter - halfMinFeatureDiameter) * oneOverCurFeatureSizeDistStep;
+  if (dia < 0) { dia = 0.0f; }
+  if (dia > curFeatureSizeDistSize - 1.0f) { dia = curFeatureSizeDistSize - 1.0f; }
+  bin = static_cast<size_t>(int32_t(dia));
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -2004,29 +2336,32 @@ float PackPrimaryPhases::check_fillingerror(int32_t gadd, int32_t gremove, Int32
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void PackPrimaryPhases::update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv)
+void PackPrimaryPhases::update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv)
 {
   size_t removeSize = pointsToRemove.size();
   size_t addSize = pointsToAdd.size();
-  size_t featureOwnersIdx = 0;
-  size_t key = 0, val = 0;
+  int64_t featureOwnersIdx = 0;
+  int64_t key = 0, val = 0;
   for (size_t i = 0; i < removeSize; i++)
   {
     featureOwnersIdx = pointsToRemove[i];
     key = availablePoints[featureOwnersIdx];
-    //  availablePoints.erase(featureOwnersIdx);
+    // Points outside the mask were never available
+    if (key < 0) { continue; }
     val = availablePointsInv[availablePointsCount - 1];
-    //  availablePointsInv.erase(availablePointsCount-1);
-    if (key < availablePointsCount - 1)
+    if (key < static_cast<int64_t>(availablePointsCount - 1))
     {
       availablePointsInv[key] = val;
       availablePoints[val] = key;
     }
+    availablePoints[featureOwnersIdx] = -1;
     availablePointsCount--;
   }
   for (size_t i = 0; i < addSize; i++)
   {
     featureOwnersIdx = pointsToAdd[i];
+    if (availablePoints[featureOwnersIdx] >= 0) { continue; }
+    if (m_UseMask == true && m_Mask[featureOwnersIdx] == false) { continue; }
     availablePoints[featureOwnersIdx] = availablePointsCount;
     availablePointsInv[availablePointsCount] = featureOwnersIdx;
     availablePointsCount++;
@@ -2167,8 +2502,8 @@ void PackPrimaryPhases::assign_voxels()
 
 
 #ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
-  tbb::task_scheduler_init init;
-  bool doParallel = true;
+  ParallelContext::Scheduler scheduler;
+  bool doParallel = scheduler.doParallel();
 #endif
 
   DimType column = 0, row = 0, plane = 0;
@@ -2683,7 +3018,8 @@ int32_t PackPrimaryPhases::estimate_numfeatures(size_t xpoints, size_t ypoints,
   // Create a Reference Variable so we can use the [] syntax
   StatsDataArray& statsDataArray = *(m_StatsDataArray.lock().get());
 
-  SIMPL_RANDOMNG_NEW()
+  // Seeded like place_features() so that the estimate, and with it the whole packing, is reproducible
+  SIMPL_RANDOMNG_NEW_SEEDED(m_Seed)
 
   std::vector<int32_t> primaryPhasesLocal;
   std::vector<double> primaryPhaseFractionsLocal;
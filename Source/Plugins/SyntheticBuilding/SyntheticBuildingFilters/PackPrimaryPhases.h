@@ -116,6 +116,12 @@ class PackPrimaryPhases : public AbstractFilter
     SIMPL_FILTER_PARAMETER(bool, PeriodicBoundaries)
     Q_PROPERTY(bool PeriodicBoundaries READ getPeriodicBoundaries WRITE setPeriodicBoundaries)
 
+    SIMPL_FILTER_PARAMETER(bool, UseFixedSeed)
+    Q_PROPERTY(bool UseFixedSeed READ getUseFixedSeed WRITE setUseFixedSeed)
+
+    SIMPL_FILTER_PARAMETER(int, RandomSeed)
+    Q_PROPERTY(int RandomSeed READ getRandomSeed WRITE setRandomSeed)
+
     SIMPL_FILTER_PARAMETER(bool, WriteGoalAttributes)
     Q_PROPERTY(bool WriteGoalAttributes READ getWriteGoalAttributes WRITE setWriteGoalAttributes)
 
@@ -291,11 +297,64 @@ class PackPrimaryPhases : public AbstractFilter
     float check_fillingerror(int32_t gadd, int32_t gremove, Int32ArrayType::Pointer featureOwnersPtr, Int32ArrayType::Pointer exclusionOwnersPtr);
 
     /**
-     * @brief update_availablepoints Updates the maps used to associate packing points with an "available" state
-     * @param availablePoints Map between Feature owners and number of available points
-     * @param availablePointsInv Inverse associations for the availablePoints map
+     * @brief update_availablepoints Updates the arrays used to associate packing points with an "available" state
+     * @param availablePoints Position of each packing point in the list of available points
+     * @param availablePointsInv List of available packing points; the first availablePointsCount entries are valid
+     */
+    void update_availablepoints(std::vector<int64_t>& availablePoints, std::vector<int64_t>& availablePointsInv);
+
+    /**
+     * @brief build_feature_hash Bins every Feature centroid into a uniform grid of cells as large as
+     * the largest Feature diameter, so determine_neighbors only visits nearby Features
+     */
+    void build_feature_hash();
+
+    /**
+     * @brief update_feature_hash Moves a Feature to the hash cell of its current centroid
+     * @param gnum Id for the Feature that moved
+     */
+    void update_feature_hash(size_t gnum);
+
+    /**
+     * @brief feature_hash_cell Returns the hash cell that holds a centroid
+     * @param xc x centroid coordinate
+     * @param yc y centroid coordinate
+     * @param zc z centroid coordinate
+     * @return Flat index of the hash cell
      */
-    void update_availablepoints(std::map<size_t, size_t>& availablePoints, std::map<size_t, size_t>& availablePointsInv);
+    int64_t feature_hash_cell(float xc, float yc, float zc);
+
+    /**
+     * @brief update_neighborhood Changes the neighborhood count of a Feature and keeps the
+     * simulated neighbor distribution counts current
+     * @param gnum Id for the Feature
+     * @param increment Amount to add to the neighborhood count
+     */
+    void update_neighborhood(size_t gnum, int32_t increment);
+
+    /**
+     * @brief neighbor_dist_bin Finds the neighbor distribution bin a Feature falls into
+     * @param gnum Id for the Feature
+     * @param iter Output index of the Feature's primary phase
+     * @param bin Output flat (diameter, neighborhood) bin index
+     * @return True if the Feature belongs to a primary phase
+     */
+    bool neighbor_dist_bin(size_t gnum, size_t& iter, size_t& bin);
+
+    /**
+     * @brief rebuild_neighbor_dist_counts Recounts the simulated neighbor distribution from scratch
+     */
+    void rebuild_neighbor_dist_counts();
+
+    /**
+     * @brief size_dist_bin Finds the size distribution bin of a Feature diameter
+     * @param phase Ensemble index of the Feature
+     * @param diameter Equivalent diameter of the Feature
+     * @param iter Output index of the primary phase
+     * @param bin Output size distribution bin index
+     * @return True if the phase is a primary phase
+     */
+    bool size_dist_bin(int32_t phase, float diameter, size_t& iter, size_t& bin);
 
     /**
      * @brief assign_voxels Assigns Feature Id values to voxels within the packing grid
@@ -437,6 +496,20 @@ class PackPrimaryPhases : public AbstractFilter
     std::vector<int32_t> primaryphases;
     std::vector<float> primaryphasefractions;
 
+    // Uniform hash of Feature centroids; each cell holds a doubly linked list of Feature Ids
+    std::vector<int32_t> m_HashCellHeads;
+    std::vector<int32_t> m_HashNext;
+    std::vector<int32_t> m_HashPrev;
+    std::vector<int64_t> m_HashCells;
+    int64_t m_HashDims[3];
+    float m_OneOverHashCellSize[3];
+
+    // Integer counts behind simfeaturesizedist and simneighbordist, kept current as Features change
+    std::vector<std::vector<int32_t> > m_SizeDistCounts;
+    std::vector<int32_t> m_SizeDistTotals;
+    std::vector<std::vector<int32_t> > m_NeighborDistCounts;
+    bool m_NeighborDistCountsValid;
+
     size_t availablePointsCount;
     float fillingerror, oldfillingerror;
     float currentneighborhooderror, oldneighborhooderror;
@@ -0,0 +1,385 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QTextStream>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/Math/SIMPLibMath.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+static const QString DCName("InsertPrecipitatePhasesTest");
+static const size_t k_CellsPerSide = 32;
+static const int32_t k_FirstPrecipitate = 2;
+
+/**
+ * @brief Ellipsoidal precipitates given as centroid, semi-axis lengths and a rotation of either 0 or 90 degrees
+ * about the sample Z axis. The fourth and fifth overlap, and the sixth is cut by the X = 0 face of the volume.
+ */
+struct TestPrecipitate
+{
+  float centroid[3];
+  float axes[3];
+  bool rotated;
+};
+
+static const TestPrecipitate k_Precipitates[] =
+{
+  { { 10.3f, 10.2f, 10.1f }, { 4.3f, 3.1f, 2.2f }, false },
+  { { 22.4f, 21.3f, 12.2f }, { 3.6f, 2.4f, 2.4f }, true },
+  { { 15.2f, 14.6f, 24.3f }, { 5.2f, 3.3f, 2.7f }, false },
+  { { 6.1f, 25.2f, 24.1f }, { 3.2f, 3.2f, 3.2f }, false },
+  { { 9.4f, 25.3f, 24.2f }, { 3.3f, 2.3f, 2.3f }, true },
+  { { 1.2f, 16.3f, 5.2f }, { 3.1f, 2.2f, 2.2f }, false },
+};
+static const size_t k_NumPrecipitates = sizeof(k_Precipitates) / sizeof(TestPrecipitate);
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RemoveTestFiles()
+{
+#if REMOVE_TEST_FILES
+  QFile::remove(UnitTest::InsertPrecipitatePhasesTest::PrecipInputFile);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the InsertPrecipitatePhases Filter from the FilterManager
+  QString filtName = "InsertPrecipitatePhases";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The InsertPrecipitatePhasesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Writes the precipitates in the format read when "Already Have Precipitates" is set
+// -----------------------------------------------------------------------------
+void WritePrecipitateFile()
+{
+  QFile file(UnitTest::InsertPrecipitatePhasesTest::PrecipInputFile);
+  DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly | QIODevice::Text))
+  QTextStream out(&file);
+  out << k_NumPrecipitates << "\n";
+  for (size_t p = 0; p < k_NumPrecipitates; p++)
+  {
+    const TestPrecipitate& precip = k_Precipitates[p];
+    float phi1 = (precip.rotated == true) ? static_cast<float>(SIMPLib::Constants::k_PiOver2) : 0.0f;
+    out << 2 << " " << precip.centroid[0] << " " << precip.centroid[1] << " " << precip.centroid[2] << " "
+        << precip.axes[0] << " " << precip.axes[1] << " " << precip.axes[2] << " " << 1.0f << " "
+        << qSetRealNumberPrecision(9) << phi1 << " " << 0.0f << " " << 0.0f << "\n";
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Builds a volume filled by a single primary Feature, with a primary phase and
+// an ellipsoidal precipitate phase
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer CreateDataContainerArray()
+{
+  size_t dims[3] = { k_CellsPerSide, k_CellsPerSide, k_CellsPerSide };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, k_CellsPerSide);
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::FeatureIds);
+  featureIds->initializeWithValue(1);
+  Int32ArrayType::Pointer cellPhases = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::Phases);
+  cellPhases->initializeWithValue(1);
+  Int8ArrayType::Pointer boundaryCells = Int8ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::BoundaryCells);
+  boundaryCells->initializeWithZeros();
+  cellAttrMat->addAttributeArray(featureIds->getName(), featureIds);
+  cellAttrMat->addAttributeArray(cellPhases->getName(), cellPhases);
+  cellAttrMat->addAttributeArray(boundaryCells->getName(), boundaryCells);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+  QVector<size_t> fDims(1, static_cast<size_t>(k_FirstPrecipitate));
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(fDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  Int32ArrayType::Pointer featurePhases = Int32ArrayType::CreateArray(fDims, cDims, DREAM3D::FeatureData::Phases);
+  featurePhases->setValue(0, 0);
+  featurePhases->setValue(1, 1);
+  featureAttrMat->addAttributeArray(featurePhases->getName(), featurePhases);
+  m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+  QVector<size_t> eDims(1, 3);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  UInt32ArrayType::Pointer phaseTypes = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::PhaseTypes);
+  phaseTypes->setValue(0, DREAM3D::PhaseType::UnknownPhaseType);
+  phaseTypes->setValue(1, DREAM3D::PhaseType::PrimaryPhase);
+  phaseTypes->setValue(2, DREAM3D::PhaseType::PrecipitatePhase);
+  UInt32ArrayType::Pointer shapeTypes = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::ShapeTypes);
+  shapeTypes->setValue(0, DREAM3D::ShapeType::UnknownShapeType);
+  shapeTypes->setValue(1, DREAM3D::ShapeType::EllipsoidShape);
+  shapeTypes->setValue(2, DREAM3D::ShapeType::EllipsoidShape);
+  Int32ArrayType::Pointer numFeatures = Int32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::NumFeatures);
+  numFeatures->setValue(0, 0);
+  numFeatures->setValue(1, 1);
+  numFeatures->setValue(2, 0);
+  StatsDataArray::Pointer statsDataArray = StatsDataArray::New();
+  statsDataArray->setName(DREAM3D::EnsembleData::Statistics);
+  statsDataArray->fillArrayWithNewStatsData(3, phaseTypes->getPointer(0));
+  ensembleAttrMat->addAttributeArray(phaseTypes->getName(), phaseTypes);
+  ensembleAttrMat->addAttributeArray(shapeTypes->getName(), shapeTypes);
+  ensembleAttrMat->addAttributeArray(numFeatures->getName(), numFeatures);
+  ensembleAttrMat->addAttributeArray(statsDataArray->getName(), statsDataArray);
+  m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer RunInsertPrecipitatePhases(int numThreads)
+{
+  DataContainerArray::Pointer dca = CreateDataContainerArray();
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("InsertPrecipitatePhases");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CellPhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::BoundaryCells));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("BoundaryCellsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeaturePhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::Statistics));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputStatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::PhaseTypes));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputPhaseTypesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::ShapeTypes));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputShapeTypesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::NumFeatures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumFeaturesArrayPath", var), true)
+  var.setValue(true);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("HavePrecips", var), true)
+  var.setValue(UnitTest::InsertPrecipitatePhasesTest::PrecipInputFile);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("PrecipInputFile", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+// Returns the ellipsoid test value of a cell for a precipitate, which is below 1 inside
+// -----------------------------------------------------------------------------
+float EllipsoidValue(const TestPrecipitate& precip, size_t x, size_t y, size_t z)
+{
+  float dx = static_cast<float>(x) - precip.centroid[0];
+  float dy = static_cast<float>(y) - precip.centroid[1];
+  float dz = static_cast<float>(z) - precip.centroid[2];
+  if (precip.rotated == true)
+  {
+    float t = dx;
+    dx = dy;
+    dy = t;
+  }
+  dx = dx / precip.axes[0];
+  dy = dy / precip.axes[1];
+  dz = dz / precip.axes[2];
+  return dx * dx + dy * dy + dz * dz;
+}
+
+// -----------------------------------------------------------------------------
+// Every cell inside exactly one precipitate must belong to it and every cell outside all
+// of them to the primary Feature. Cells in the overlap of two precipitates are filled from
+// a neighbor and cells too close to a surface to call are skipped.
+// -----------------------------------------------------------------------------
+void CheckFeatureIds(DataContainerArray::Pointer dca)
+{
+  AttributeMatrix::Pointer cellAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellAttributeMatrixName);
+  Int32ArrayType::Pointer featureIds = boost::dynamic_pointer_cast<Int32ArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::FeatureIds));
+  Int32ArrayType::Pointer cellPhases = boost::dynamic_pointer_cast<Int32ArrayType>(cellAttrMat->getAttributeArray(DREAM3D::CellData::Phases));
+  DREAM3D_REQUIRE(featureIds.get() != NULL)
+  DREAM3D_REQUIRE(cellPhases.get() != NULL)
+
+  AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellFeatureAttributeMatrixName);
+  size_t numFeatures = featureAttrMat->getNumTuples();
+  DREAM3D_REQUIRE_EQUAL(numFeatures, k_FirstPrecipitate + k_NumPrecipitates)
+
+  std::vector<size_t> precipitateCells(k_NumPrecipitates, 0);
+  size_t index = 0;
+  for (size_t z = 0; z < k_CellsPerSide; z++)
+  {
+    for (size_t y = 0; y < k_CellsPerSide; y++)
+    {
+      for (size_t x = 0; x < k_CellsPerSide; x++, index++)
+      {
+        int32_t featureId = featureIds->getValue(index);
+        int32_t expected = 1;
+        size_t insideCount = 0;
+        bool nearSurface = false;
+        std::vector<int32_t> candidates(1, 1);
+        for (size_t p = 0; p < k_NumPrecipitates; p++)
+        {
+          float value = EllipsoidValue(k_Precipitates[p], x, y, z);
+          if (fabsf(value - 1.0f) < 1.0e-3f) { nearSurface = true; }
+          if (value < 1.0f)
+          {
+            insideCount++;
+            expected = k_FirstPrecipitate + static_cast<int32_t>(p);
+            candidates.push_back(expected);
+          }
+        }
+        if (nearSurface == true) { continue; }
+        if (insideCount > 1)
+        {
+          DREAM3D_REQUIRE(std::find(candidates.begin(), candidates.end(), featureId) != candidates.end())
+          continue;
+        }
+        DREAM3D_REQUIRE_EQUAL(featureId, expected)
+        int32_t expectedPhase = (expected >= k_FirstPrecipitate) ? 2 : 1;
+        DREAM3D_REQUIRE_EQUAL(cellPhases->getValue(index), expectedPhase)
+        if (expected >= k_FirstPrecipitate) { precipitateCells[expected - k_FirstPrecipitate]++; }
+      }
+    }
+  }
+
+  for (size_t p = 0; p < k_NumPrecipitates; p++)
+  {
+    DREAM3D_REQUIRED(precipitateCells[p], >, 0)
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Precipitates read from a file are rasterized exactly as described, whatever the
+// number of threads that assign their voxels
+// -----------------------------------------------------------------------------
+int TestAssignPrecipitateVoxels()
+{
+  WritePrecipitateFile();
+
+  DataContainerArray::Pointer serial = RunInsertPrecipitatePhases(1);
+  CheckFeatureIds(serial);
+  DataContainerArray::Pointer parallel = RunInsertPrecipitatePhases(4);
+  CheckFeatureIds(parallel);
+
+  Int32ArrayType::Pointer serialIds = boost::dynamic_pointer_cast<Int32ArrayType>(serial->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellAttributeMatrixName)->getAttributeArray(DREAM3D::CellData::FeatureIds));
+  Int32ArrayType::Pointer parallelIds = boost::dynamic_pointer_cast<Int32ArrayType>(parallel->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellAttributeMatrixName)->getAttributeArray(DREAM3D::CellData::FeatureIds));
+  for (size_t i = 0; i < serialIds->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(serialIds->getValue(i), parallelIds->getValue(i))
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("InsertPrecipitatePhasesTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestAssignPrecipitateVoxels() )
+
+  DREAM3D_REGISTER_TEST( RemoveTestFiles() )
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,327 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/StatsData/PrimaryStatsData.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/SIMPLibRandom.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "EbsdLib/EbsdConstants.h"
+
+#include "OrientationLib/SpaceGroupOps/CubicOps.h"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+static const QString DCName("MatchCrystallographyTest");
+static const size_t k_BlocksPerSide = 8;
+static const size_t k_BlockSize = 3;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the MatchCrystallography Filter from the FilterManager
+  QString filtName = "MatchCrystallography";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The MatchCrystallographyTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Fills a histogram with random, normalized densities
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer CreateHistogram(size_t numBins, const QString& name, uint64_t seed)
+{
+  SIMPL_RANDOMNG_NEW_SEEDED(seed)
+  FloatArrayType::Pointer histogram = FloatArrayType::CreateArray(numBins, name);
+  double sum = 0.0;
+  for (size_t i = 0; i < numBins; i++)
+  {
+    float value = static_cast<float>(rg.genrand_res53());
+    histogram->setValue(i, value);
+    sum += value;
+  }
+  for (size_t i = 0; i < numBins; i++)
+  {
+    histogram->setValue(i, static_cast<float>(histogram->getValue(i) / sum));
+  }
+  return histogram;
+}
+
+// -----------------------------------------------------------------------------
+// Builds a volume of cubic Features laid out on a regular grid, each Feature
+// sharing a face with its 6 neighbors, and a single cubic primary phase
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer CreateDataContainerArray()
+{
+  size_t cellsPerSide = k_BlocksPerSide * k_BlockSize;
+  size_t dims[3] = { cellsPerSide, cellsPerSide, cellsPerSide };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+  size_t numFeatures = k_BlocksPerSide * k_BlocksPerSide * k_BlocksPerSide + 1;
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DCName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+
+  QVector<size_t> tDims(3, cellsPerSide);
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(tDims, cDims, DREAM3D::CellData::FeatureIds);
+  size_t index = 0;
+  for (size_t z = 0; z < cellsPerSide; z++)
+  {
+    for (size_t y = 0; y < cellsPerSide; y++)
+    {
+      for (size_t x = 0; x < cellsPerSide; x++)
+      {
+        size_t bx = x / k_BlockSize, by = y / k_BlockSize, bz = z / k_BlockSize;
+        featureIds->setValue(index++, static_cast<int32_t>(1 + bx + k_BlocksPerSide * (by + k_BlocksPerSide * bz)));
+      }
+    }
+  }
+  cellAttrMat->addAttributeArray(featureIds->getName(), featureIds);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+
+  QVector<size_t> fDims(1, numFeatures);
+  AttributeMatrix::Pointer featureAttrMat = AttributeMatrix::New(fDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+  Int32ArrayType::Pointer phases = Int32ArrayType::CreateArray(fDims, cDims, DREAM3D::FeatureData::Phases);
+  BoolArrayType::Pointer surfaceFeatures = BoolArrayType::CreateArray(fDims, cDims, DREAM3D::FeatureData::SurfaceFeatures);
+  NeighborList<int32_t>::Pointer neighborList = NeighborList<int32_t>::CreateArray(fDims, cDims, DREAM3D::FeatureData::NeighborList);
+  NeighborList<float>::Pointer sharedSurfaceAreaList = NeighborList<float>::CreateArray(fDims, cDims, DREAM3D::FeatureData::SharedSurfaceAreaList);
+  phases->setValue(0, 0);
+  surfaceFeatures->setValue(0, false);
+  neighborList->setList(0, NeighborList<int32_t>::SharedVectorType(new std::vector<int32_t>));
+  sharedSurfaceAreaList->setList(0, NeighborList<float>::SharedVectorType(new std::vector<float>));
+  int32_t offsets[3] = { 1, static_cast<int32_t>(k_BlocksPerSide), static_cast<int32_t>(k_BlocksPerSide * k_BlocksPerSide) };
+  for (size_t bz = 0; bz < k_BlocksPerSide; bz++)
+  {
+    for (size_t by = 0; by < k_BlocksPerSide; by++)
+    {
+      for (size_t bx = 0; bx < k_BlocksPerSide; bx++)
+      {
+        int32_t feature = static_cast<int32_t>(1 + bx + k_BlocksPerSide * (by + k_BlocksPerSide * bz));
+        size_t b[3] = { bx, by, bz };
+        NeighborList<int32_t>::SharedVectorType neighbors(new std::vector<int32_t>);
+        NeighborList<float>::SharedVectorType areas(new std::vector<float>);
+        bool surface = false;
+        for (int32_t d = 0; d < 3; d++)
+        {
+          if (b[d] > 0) { neighbors->push_back(feature - offsets[d]); }
+          else { surface = true; }
+          if (b[d] < k_BlocksPerSide - 1) { neighbors->push_back(feature + offsets[d]); }
+          else { surface = true; }
+        }
+        areas->assign(neighbors->size(), static_cast<float>(k_BlockSize * k_BlockSize));
+        phases->setValue(feature, 1);
+        surfaceFeatures->setValue(feature, surface);
+        neighborList->setList(feature, neighbors);
+        sharedSurfaceAreaList->setList(feature, areas);
+      }
+    }
+  }
+  featureAttrMat->addAttributeArray(phases->getName(), phases);
+  featureAttrMat->addAttributeArray(surfaceFeatures->getName(), surfaceFeatures);
+  featureAttrMat->addAttributeArray(neighborList->getName(), neighborList);
+  featureAttrMat->addAttributeArray(sharedSurfaceAreaList->getName(), sharedSurfaceAreaList);
+  m->addAttributeMatrix(featureAttrMat->getName(), featureAttrMat);
+
+  QVector<size_t> eDims(1, 2);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  UInt32ArrayType::Pointer crystalStructures = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::CrystalStructures);
+  crystalStructures->setValue(0, Ebsd::CrystalStructure::UnknownCrystalStructure);
+  crystalStructures->setValue(1, Ebsd::CrystalStructure::Cubic_High);
+  UInt32ArrayType::Pointer phaseTypes = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::PhaseTypes);
+  phaseTypes->setValue(0, DREAM3D::PhaseType::UnknownPhaseType);
+  phaseTypes->setValue(1, DREAM3D::PhaseType::PrimaryPhase);
+  Int32ArrayType::Pointer numFeaturesArray = Int32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::NumFeatures);
+  numFeaturesArray->setValue(0, 0);
+  numFeaturesArray->setValue(1, static_cast<int32_t>(numFeatures - 1));
+
+  StatsDataArray::Pointer statsDataArray = StatsDataArray::New();
+  statsDataArray->setName(DREAM3D::EnsembleData::Statistics);
+  statsDataArray->fillArrayWithNewStatsData(2, phaseTypes->getPointer(0));
+  PrimaryStatsData* primaryStatsData = PrimaryStatsData::SafePointerDownCast(statsDataArray->getStatsData(1).get());
+  DREAM3D_REQUIRE(NULL != primaryStatsData)
+  CubicOps cubicOps;
+  primaryStatsData->setODF(CreateHistogram(cubicOps.getODFSize(), DREAM3D::StringConstants::ODF, 1234));
+  primaryStatsData->setMisorientationBins(CreateHistogram(cubicOps.getMDFSize(), DREAM3D::StringConstants::MisorientationBins, 5678));
+
+  ensembleAttrMat->addAttributeArray(crystalStructures->getName(), crystalStructures);
+  ensembleAttrMat->addAttributeArray(phaseTypes->getName(), phaseTypes);
+  ensembleAttrMat->addAttributeArray(numFeaturesArray->getName(), numFeaturesArray);
+  ensembleAttrMat->addAttributeArray(statsDataArray->getName(), statsDataArray);
+  m->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+
+  dca->addDataContainer(m);
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FloatArrayType::Pointer RunMatchCrystallography(int numThreads)
+{
+  DataContainerArray::Pointer dca = CreateDataContainerArray();
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("MatchCrystallography");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::Statistics));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputStatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::CrystalStructures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("CrystalStructuresArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::PhaseTypes));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("PhaseTypesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::NumFeatures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("NumFeaturesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeatureIdsArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("FeaturePhasesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::SurfaceFeatures));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SurfaceFeaturesArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::NeighborList));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("NeighborListArrayPath", var), true)
+  var.setValue(DataArrayPath(DCName, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::SharedSurfaceAreaList));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("SharedSurfaceAreaListArrayPath", var), true)
+  var.setValue(5000);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("MaxIterations", var), true)
+  var.setValue(true);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("UseFixedSeed", var), true)
+  var.setValue(20151108);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("RandomSeed", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  AttributeMatrix::Pointer featureAttrMat = dca->getDataContainer(DCName)->getAttributeMatrix(DREAM3D::Defaults::CellFeatureAttributeMatrixName);
+  FloatArrayType::Pointer eulers = boost::dynamic_pointer_cast<FloatArrayType>(featureAttrMat->getAttributeArray(DREAM3D::FeatureData::EulerAngles));
+  DREAM3D_REQUIRE(eulers.get() != NULL)
+  return eulers;
+}
+
+// -----------------------------------------------------------------------------
+// With a fixed seed the orientations must not depend on the number of threads
+// that evaluate the batches of moves
+// -----------------------------------------------------------------------------
+int TestThreadCountIndependence()
+{
+  FloatArrayType::Pointer serial = RunMatchCrystallography(1);
+  FloatArrayType::Pointer parallel = RunMatchCrystallography(4);
+  DREAM3D_REQUIRE_EQUAL(serial->getNumberOfTuples(), parallel->getNumberOfTuples())
+
+  for (size_t i = 3; i < serial->getSize(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(serial->getValue(i), parallel->getValue(i))
+  }
+
+  // Running again with the same seed gives the same result
+  FloatArrayType::Pointer again = RunMatchCrystallography(4);
+  for (size_t i = 3; i < serial->getSize(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(serial->getValue(i), again->getValue(i))
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("MatchCrystallographyTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestThreadCountIndependence() )
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
@@ -0,0 +1,333 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+#include <math.h>
+
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+#include "SIMPLib/StatsData/PrimaryStatsData.h"
+#include "SIMPLib/Common/FilterManager.h"
+#include "SIMPLib/Common/FilterFactory.hpp"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/SIMPLibPluginLoader.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+#include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+
+#include "OrientationLib/SpaceGroupOps/OrthoRhombicOps.h"
+
+#include "SyntheticBuildingTestFileLocations.h"
+
+static const size_t k_CellsPerSide = 32;
+static const int k_Seed = 20151112;
+
+/**
+ * @brief Two primary phases of equiaxed ellipsoids about 7 cells across, filling 60% and 40% of the volume
+ */
+static const float k_PhaseFractions[2] = { 0.6f, 0.4f };
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int TestFilterAvailability()
+{
+  // Now instantiate the PackPrimaryPhases Filter from the FilterManager
+  QString filtName = "PackPrimaryPhases";
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer filterFactory = fm->getFactoryForFilter(filtName);
+  if (NULL == filterFactory.get() )
+  {
+    std::stringstream ss;
+    ss << "The PackPrimaryPhasesTest Requires the use of the " << filtName.toStdString() << " filter which is found in the SyntheticBuilding Plugin";
+    DREAM3D_TEST_THROW_EXCEPTION(ss.str())
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Creates a distribution with the same parameters in every diameter bin
+// -----------------------------------------------------------------------------
+VectorOfFloatArray CreateDistribution(uint32_t distributionType, size_t numBins, float value0, float value1)
+{
+  VectorOfFloatArray distribution = StatsData::CreateCorrelatedDistributionArrays(distributionType, numBins);
+  for (size_t i = 0; i < numBins; i++)
+  {
+    distribution[0]->setValue(i, value0);
+    distribution[1]->setValue(i, value1);
+  }
+  return distribution;
+}
+
+// -----------------------------------------------------------------------------
+// Fills in the size, shape, neighbor and axis orientation statistics of a primary phase
+// -----------------------------------------------------------------------------
+void InitializePrimaryStatsData(PrimaryStatsData* primaryStatsData, float phaseFraction)
+{
+  float mu = logf(7.0f);
+  float sigma = 0.1f;
+  primaryStatsData->setPhaseFraction(phaseFraction);
+  primaryStatsData->setBinStepSize(2.0f);
+  primaryStatsData->setMaxFeatureDiameter(expf(mu + 5.0f * sigma));
+  primaryStatsData->setMinFeatureDiameter(expf(mu - 5.0f * sigma));
+  primaryStatsData->setFeatureSizeDistribution(CreateDistribution(DREAM3D::DistributionType::LogNormal, 1, mu, sigma));
+  size_t numBins = primaryStatsData->generateBinNumbers()->getSize();
+
+  primaryStatsData->setFeatureSize_BOverA(CreateDistribution(DREAM3D::DistributionType::Beta, numBins, 15.0f, 2.0f));
+  primaryStatsData->setFeatureSize_COverA(CreateDistribution(DREAM3D::DistributionType::Beta, numBins, 12.0f, 3.0f));
+  primaryStatsData->setFeatureSize_Neighbors(CreateDistribution(DREAM3D::DistributionType::LogNormal, numBins, 2.5f, 0.3f));
+  primaryStatsData->setFeatureSize_Omegas(CreateDistribution(DREAM3D::DistributionType::Beta, numBins, 10.0f, 1.5f));
+
+  OrthoRhombicOps orthoOps;
+  FloatArrayType::Pointer axisOdf = FloatArrayType::CreateArray(orthoOps.getODFSize(), DREAM3D::StringConstants::AxisOrientation);
+  axisOdf->initializeWithValue(1.0f / static_cast<float>(orthoOps.getODFSize()));
+  primaryStatsData->setAxisOrientation(axisOdf);
+}
+
+// -----------------------------------------------------------------------------
+// Builds an empty synthetic volume and the statistics of its two primary phases
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer CreateDataContainerArray()
+{
+  size_t dims[3] = { k_CellsPerSide, k_CellsPerSide, k_CellsPerSide };
+  float res[3] = { 1.0f, 1.0f, 1.0f };
+
+  DataContainerArray::Pointer dca = DataContainerArray::New();
+  DataContainer::Pointer m = DataContainer::New(DREAM3D::Defaults::SyntheticVolumeDataContainerName);
+  ImageGeom::Pointer image = ImageGeom::CreateGeometry(DREAM3D::Geometry::ImageGeometry);
+  image->setDimensions(dims);
+  image->setResolution(res);
+  m->setGeometry(image);
+  QVector<size_t> tDims(3, k_CellsPerSide);
+  AttributeMatrix::Pointer cellAttrMat = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+  m->addAttributeMatrix(cellAttrMat->getName(), cellAttrMat);
+  dca->addDataContainer(m);
+
+  DataContainer::Pointer statsDc = DataContainer::New(DREAM3D::Defaults::StatsGenerator);
+  QVector<size_t> eDims(1, 3);
+  QVector<size_t> cDims(1, 1);
+  AttributeMatrix::Pointer ensembleAttrMat = AttributeMatrix::New(eDims, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::AttributeMatrixType::CellEnsemble);
+  UInt32ArrayType::Pointer phaseTypes = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::PhaseTypes);
+  phaseTypes->setValue(0, DREAM3D::PhaseType::UnknownPhaseType);
+  phaseTypes->setValue(1, DREAM3D::PhaseType::PrimaryPhase);
+  phaseTypes->setValue(2, DREAM3D::PhaseType::PrimaryPhase);
+  UInt32ArrayType::Pointer shapeTypes = UInt32ArrayType::CreateArray(eDims, cDims, DREAM3D::EnsembleData::ShapeTypes);
+  shapeTypes->setValue(0, DREAM3D::ShapeType::UnknownShapeType);
+  shapeTypes->setValue(1, DREAM3D::ShapeType::EllipsoidShape);
+  shapeTypes->setValue(2, DREAM3D::ShapeType::EllipsoidShape);
+  StatsDataArray::Pointer statsDataArray = StatsDataArray::New();
+  statsDataArray->setName(DREAM3D::EnsembleData::Statistics);
+  statsDataArray->fillArrayWithNewStatsData(3, phaseTypes->getPointer(0));
+  for (size_t phase = 1; phase < 3; phase++)
+  {
+    PrimaryStatsData* primaryStatsData = PrimaryStatsData::SafePointerDownCast(statsDataArray->getStatsData(phase).get());
+    DREAM3D_REQUIRE(NULL != primaryStatsData)
+    InitializePrimaryStatsData(primaryStatsData, k_PhaseFractions[phase - 1]);
+  }
+  ensembleAttrMat->addAttributeArray(phaseTypes->getName(), phaseTypes);
+  ensembleAttrMat->addAttributeArray(shapeTypes->getName(), shapeTypes);
+  ensembleAttrMat->addAttributeArray(statsDataArray->getName(), statsDataArray);
+  statsDc->addAttributeMatrix(ensembleAttrMat->getName(), ensembleAttrMat);
+  dca->addDataContainer(statsDc);
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer RunPackPrimaryPhases(int numThreads)
+{
+  DataContainerArray::Pointer dca = CreateDataContainerArray();
+
+  FilterManager* fm = FilterManager::Instance();
+  IFilterFactory::Pointer factory = fm->getFactoryForFilter("PackPrimaryPhases");
+  DREAM3D_REQUIRE(factory.get() != NULL)
+  AbstractFilter::Pointer filter = factory->create();
+  filter->setDataContainerArray(dca);
+
+  QVariant var;
+  var.setValue(DataArrayPath(DREAM3D::Defaults::SyntheticVolumeDataContainerName, DREAM3D::Defaults::CellAttributeMatrixName, ""));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("OutputCellAttributeMatrixPath", var), true)
+  var.setValue(DataArrayPath(DREAM3D::Defaults::StatsGenerator, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::Statistics));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputStatsArrayPath", var), true)
+  var.setValue(DataArrayPath(DREAM3D::Defaults::StatsGenerator, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::PhaseTypes));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputPhaseTypesArrayPath", var), true)
+  var.setValue(DataArrayPath(DREAM3D::Defaults::StatsGenerator, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::ShapeTypes));
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("InputShapeTypesArrayPath", var), true)
+  var.setValue(false);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("PeriodicBoundaries", var), true)
+  var.setValue(true);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("UseFixedSeed", var), true)
+  var.setValue(k_Seed);
+  DREAM3D_REQUIRE_EQUAL(filter->setProperty("RandomSeed", var), true)
+
+  ParallelContext::SetNumberOfThreads(numThreads);
+  filter->execute();
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRED(filter->getErrorCondition(), >=, 0)
+
+  return dca;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer GetArray(DataContainerArray::Pointer dca, const QString& attrMatName, const QString& arrayName)
+{
+  AttributeMatrix::Pointer attrMat = dca->getDataContainer(DREAM3D::Defaults::SyntheticVolumeDataContainerName)->getAttributeMatrix(attrMatName);
+  DREAM3D_REQUIRE(attrMat.get() != NULL)
+  Int32ArrayType::Pointer array = boost::dynamic_pointer_cast<Int32ArrayType>(attrMat->getAttributeArray(arrayName));
+  DREAM3D_REQUIRE(array.get() != NULL)
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+// With a fixed seed the packed volume must not depend on the number of threads
+// that evaluate the batches of moves
+// -----------------------------------------------------------------------------
+int TestThreadCountIndependence()
+{
+  DataContainerArray::Pointer serial = RunPackPrimaryPhases(1);
+  DataContainerArray::Pointer parallel = RunPackPrimaryPhases(4);
+
+  Int32ArrayType::Pointer serialPhases = GetArray(serial, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases);
+  Int32ArrayType::Pointer parallelPhases = GetArray(parallel, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases);
+  DREAM3D_REQUIRE_EQUAL(serialPhases->getNumberOfTuples(), parallelPhases->getNumberOfTuples())
+  for (size_t i = 0; i < serialPhases->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(serialPhases->getValue(i), parallelPhases->getValue(i))
+  }
+
+  Int32ArrayType::Pointer serialIds = GetArray(serial, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+  Int32ArrayType::Pointer parallelIds = GetArray(parallel, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+  for (size_t i = 0; i < serialIds->getNumberOfTuples(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(serialIds->getValue(i), parallelIds->getValue(i))
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+// Every cell must end up in a Feature, every Feature must own cells and each
+// phase must fill close to its requested fraction of the volume
+// -----------------------------------------------------------------------------
+int TestFillFraction()
+{
+  DataContainerArray::Pointer dca = RunPackPrimaryPhases(2);
+
+  Int32ArrayType::Pointer featureIds = GetArray(dca, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::FeatureIds);
+  Int32ArrayType::Pointer cellPhases = GetArray(dca, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::CellData::Phases);
+  Int32ArrayType::Pointer featurePhases = GetArray(dca, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::FeatureData::Phases);
+  Int32ArrayType::Pointer numFeatures = GetArray(dca, DREAM3D::Defaults::CellEnsembleAttributeMatrixName, DREAM3D::EnsembleData::NumFeatures);
+
+  size_t totalFeatures = featurePhases->getNumberOfTuples();
+  size_t totalPoints = featureIds->getNumberOfTuples();
+  DREAM3D_REQUIRED(totalFeatures, >, 20)
+  DREAM3D_REQUIRE_EQUAL(static_cast<size_t>(numFeatures->getValue(1) + numFeatures->getValue(2)), totalFeatures - 1)
+
+  std::vector<size_t> featureCells(totalFeatures, 0);
+  size_t phaseCells[3] = { 0, 0, 0 };
+  for (size_t i = 0; i < totalPoints; i++)
+  {
+    int32_t featureId = featureIds->getValue(i);
+    DREAM3D_REQUIRED(featureId, >, 0)
+    DREAM3D_REQUIRE(static_cast<size_t>(featureId) < totalFeatures)
+    int32_t phase = cellPhases->getValue(i);
+    DREAM3D_REQUIRE_EQUAL(phase, featurePhases->getValue(featureId))
+    DREAM3D_REQUIRE(phase == 1 || phase == 2)
+    featureCells[featureId]++;
+    phaseCells[phase]++;
+  }
+  for (size_t i = 1; i < totalFeatures; i++)
+  {
+    DREAM3D_REQUIRED(featureCells[i], >, 0)
+  }
+
+  for (size_t phase = 1; phase < 3; phase++)
+  {
+    float fraction = static_cast<float>(phaseCells[phase]) / static_cast<float>(totalPoints);
+    DREAM3D_REQUIRE(fabsf(fraction - k_PhaseFractions[phase - 1]) < 0.1f)
+  }
+
+  return EXIT_SUCCESS;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void loadFilterPlugins()
+{
+  // Register all the filters including trying to load those from Plugins
+  FilterManager* fm = FilterManager::Instance();
+  SIMPLibPluginLoader::LoadPluginFilters(fm);
+
+  // Send progress messages from PipelineBuilder to this object for display
+  QMetaObjectUtilities::RegisterMetaTypes();
+}
+
+// -----------------------------------------------------------------------------
+//  Use test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Instantiate the QCoreApplication that we need to get the current path and load plugins.
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setOrganizationName("BlueQuartz Software");
+  QCoreApplication::setOrganizationDomain("bluequartz.net");
+  QCoreApplication::setApplicationName("PackPrimaryPhasesTest");
+
+  int err = EXIT_SUCCESS;
+  DREAM3D_REGISTER_TEST( loadFilterPlugins() );
+  DREAM3D_REGISTER_TEST( TestFilterAvailability() );
+
+  DREAM3D_REGISTER_TEST( TestThreadCountIndependence() )
+  DREAM3D_REGISTER_TEST( TestFillFraction() )
+
+  PRINT_TEST_SUMMARY();
+
+  return err;
+}
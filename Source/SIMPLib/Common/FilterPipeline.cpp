@@ -36,6 +36,7 @@
 
 #include "FilterPipeline.h"
 #include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 #include "moc_FilterPipeline.cpp"
 
@@ -45,6 +46,7 @@
 FilterPipeline::FilterPipeline() :
   QObject(),
   m_ErrorCondition(0),
+  m_NumberOfThreads(0),
   m_Cancel(false)
 {
 
@@ -322,6 +324,9 @@ void FilterPipeline::execute()
 {
   int err = 0;
 
+  // Every filter runs inside this scope, so they all share one worker pool sized for the pipeline
+  ParallelContext::Scheduler scheduler(m_NumberOfThreads);
+
   DataContainerArray::Pointer dca = DataContainerArray::New();
 
   // Start looping through the Pipeline
@@ -73,6 +73,12 @@ class SIMPLib_EXPORT FilterPipeline : public QObject
     SIMPL_INSTANCE_PROPERTY(int, ErrorCondition)
     SIMPL_INSTANCE_PROPERTY(AbstractFilter::Pointer, CurrentFilter)
 
+    /**
+     * @brief Number of threads the filters of this pipeline may use. 0 (the default) uses the
+     * ParallelContext thread count.
+     */
+    SIMPL_INSTANCE_PROPERTY(int, NumberOfThreads)
+
     /**
      * @brief Cancel the operation
      */
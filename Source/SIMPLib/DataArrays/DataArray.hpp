@@ -46,6 +46,7 @@
 #include "SIMPLib/SIMPLib.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataArrays/TupleTransfer.h"
 #include "SIMPLib/HDF5/H5DataArrayWriter.hpp"
 #include "SIMPLib/HDF5/H5DataArrayReader.h"
 
@@ -780,6 +781,46 @@ class DataArray : public IDataArray
       return daCopy;
     }
 
+    /**
+     * @brief Creates a new array where tuple i is a copy of tuple map[i] of this array
+     * @param map Source tuple index for each tuple of the new array
+     * @return
+     */
+    virtual IDataArray::Pointer gather(const IndexMap& map)
+    {
+      Pointer daCopy = CreateArray(map.size(), getComponentDimensions(), getName(), m_IsAllocated);
+      if(NULL == daCopy.get())
+      {
+        return IDataArray::NullPointer();
+      }
+      daCopy->setInitValue(m_InitValue);
+      if(m_IsAllocated == true && map.size() > 0)
+      {
+        if(TupleTransfer::Gather(m_Array, getNumberOfTuples(), daCopy->getPointer(0), sizeof(T) * m_NumComponents, map) == false)
+        {
+          return IDataArray::NullPointer();
+        }
+      }
+      return daCopy;
+    }
+
+    /**
+     * @brief Copies tuple i of the source array into tuple map[i] of this array
+     * @param map Destination tuple index for each tuple of the source array
+     * @param sourceArray
+     * @return
+     */
+    virtual bool scatter(const IndexMap& map, IDataArray::Pointer sourceArray)
+    {
+      Self* source = dynamic_cast<Self*>(sourceArray.get());
+      if(NULL == source) { return false; }
+      if(source->getNumberOfComponents() != getNumberOfComponents()) { return false; }
+      if(source->getNumberOfTuples() != map.size()) { return false; }
+      if(map.size() == 0) { return true; }
+      if(m_IsAllocated == false || source->isAllocated() == false) { return false; }
+      return TupleTransfer::Scatter(source->getPointer(0), m_Array, getNumberOfTuples(), sizeof(T) * m_NumComponents, map);
+    }
+
     /**
      * @brief Returns the number of bytes that make up the data type.
      * 1 = char
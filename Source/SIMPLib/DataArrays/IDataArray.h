@@ -42,6 +42,12 @@ class SIMPLib_EXPORT IDataArray
     SIMPL_SHARED_POINTERS(IDataArray)
     SIMPL_TYPE_MACRO(IDataArray)
 
+    /**
+     * @brief IndexMap relates the tuples of two arrays for gather() and scatter(). A negative
+     * entry marks a tuple that has no partner in the other array.
+     */
+    typedef std::vector<int64_t> IndexMap;
+
     /**
      * This templated method is used to get at the low level pointer that points
      * to the actual data by testing the conversion with dynamic_cast<> first to
@@ -187,6 +193,24 @@ class SIMPLib_EXPORT IDataArray
      */
     virtual IDataArray::Pointer reorderCopy(QVector<size_t> newOrderMap) = 0;
 
+    /**
+     * @brief Creates a new array with map.size() tuples where tuple i is a copy of
+     * tuple map[i] of this array. Tuples with a negative map entry are set to zero.
+     * @param map Source tuple index for each tuple of the new array
+     * @return pointer to new data array, or a null pointer if an entry of the map is out of range
+     */
+    virtual IDataArray::Pointer gather(const IndexMap& map) = 0;
+
+    /**
+     * @brief Copies tuple i of the source array into tuple map[i] of this array. Source tuples
+     * with a negative map entry are skipped, and each tuple of this array may appear at most once
+     * in the map.
+     * @param map Destination tuple index for each tuple of the source array
+     * @param sourceArray Array of the same type holding map.size() tuples
+     * @return false if the arrays do not match or an entry of the map is out of range
+     */
+    virtual bool scatter(const IndexMap& map, IDataArray::Pointer sourceArray) = 0;
+
     /**
      * @brief Splats the same value c across all values in the Tuple
      * @param pos The index of the Tuple
@@ -55,6 +55,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/TupleTransfer.h"
 
 
 /**
@@ -458,6 +459,52 @@ class NeighborList : public IDataArray
       return daCopyPtr;
     }
 
+    /**
+     * @brief Creates a new NeighborList where list i is a copy of list map[i] of this array
+     * @param map Source tuple index for each tuple of the new array
+     * @return
+     */
+    virtual IDataArray::Pointer gather(const IndexMap& map)
+    {
+      if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false)
+      {
+        return IDataArray::NullPointer();
+      }
+      typename NeighborList<T>::Pointer daCopyPtr = NeighborList<T>::CreateArray(map.size(), getName(), true);
+      daCopyPtr->setNumNeighborsArrayName(getNumNeighborsArrayName());
+      for(size_t i = 0; i < map.size(); i++)
+      {
+        if(map[i] >= 0)
+        {
+          SharedVectorType sharedNeiLst(new VectorType(*(m_Array[map[i]])));
+          daCopyPtr->setList(static_cast<int>(i), sharedNeiLst);
+        }
+      }
+      return daCopyPtr;
+    }
+
+    /**
+     * @brief Copies list i of the source array into list map[i] of this array
+     * @param map Destination tuple index for each tuple of the source array
+     * @param sourceArray
+     * @return
+     */
+    virtual bool scatter(const IndexMap& map, IDataArray::Pointer sourceArray)
+    {
+      Self* source = dynamic_cast<Self*>(sourceArray.get());
+      if(NULL == source) { return false; }
+      if(source->getNumberOfTuples() != map.size()) { return false; }
+      if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false) { return false; }
+      for(size_t i = 0; i < map.size(); i++)
+      {
+        if(map[i] >= 0)
+        {
+          m_Array[map[i]] = SharedVectorType(new VectorType(*(source->getList(static_cast<int>(i)))));
+        }
+      }
+      return true;
+    }
+
     /**
      * @brief Splats the same value c across all values in the Tuple
      * @param i The index of the Tuple
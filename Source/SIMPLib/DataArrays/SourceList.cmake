@@ -40,12 +40,14 @@ set(SIMPLib_DataArrays_HDRS
   ${SIMPLib_SOURCE_DIR}/DataArrays/StatsDataArray.h
   ${SIMPLib_SOURCE_DIR}/DataArrays/StringDataArray.hpp
   ${SIMPLib_SOURCE_DIR}/DataArrays/StructArray.hpp
+  ${SIMPLib_SOURCE_DIR}/DataArrays/TupleTransfer.h
   ${SIMPLib_SOURCE_DIR}/DataArrays/DynamicListArray.hpp
 )
 
 set(SIMPLib_DataArrays_SRCS
   ${SIMPLib_SOURCE_DIR}/DataArrays/IDataArray.cpp
   ${SIMPLib_SOURCE_DIR}/DataArrays/StatsDataArray.cpp
+  ${SIMPLib_SOURCE_DIR}/DataArrays/TupleTransfer.cpp
 )
 cmp_IDE_SOURCE_PROPERTIES( "DataArrays" "${SIMPLib_DataArrays_HDRS}" "${SIMPLib_DataArrays_SRCS}" "0")
 if( ${PROJECT_INSTALL_HEADERS} EQUAL 1 )
@@ -43,6 +43,7 @@
 #include "SIMPLib/StatsData/TransformationStatsData.h"
 #include "SIMPLib/StatsData/BoundaryStatsData.h"
 #include "SIMPLib/StatsData/MatrixStatsData.h"
+#include "SIMPLib/DataArrays/TupleTransfer.h"
 
 
 #include "H5Support/QH5Utilities.h"
@@ -381,6 +382,50 @@ IDataArray::Pointer StatsDataArray::reorderCopy(QVector<size_t> newOrderMap)
   return daCopyPtr;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer StatsDataArray::gather(const IndexMap& map)
+{
+  if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false)
+  {
+    return IDataArray::NullPointer();
+  }
+  StatsDataArray::Pointer daCopyPtr = StatsDataArray::New();
+  daCopyPtr->setName(getName());
+  for(size_t i = 0; i < map.size(); i++)
+  {
+    if(map[i] >= 0)
+    {
+      daCopyPtr->setStatsData(static_cast<int>(i), m_StatsDataArray[map[i]]);
+    }
+    else
+    {
+      daCopyPtr->setStatsData(static_cast<int>(i), StatsData::New());
+    }
+  }
+  return daCopyPtr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool StatsDataArray::scatter(const IndexMap& map, IDataArray::Pointer sourceArray)
+{
+  Self* source = dynamic_cast<Self*>(sourceArray.get());
+  if(NULL == source) { return false; }
+  if(source->getNumberOfTuples() != map.size()) { return false; }
+  if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false) { return false; }
+  for(size_t i = 0; i < map.size(); i++)
+  {
+    if(map[i] >= 0)
+    {
+      m_StatsDataArray[map[i]] = (*source)[i];
+    }
+  }
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
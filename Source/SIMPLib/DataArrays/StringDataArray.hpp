@@ -50,6 +50,7 @@
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/TupleTransfer.h"
 
 /**
  * @class StringDataArray StringDataArray.h DREAM3DLib/Common/StringDataArray.h
@@ -405,6 +406,51 @@ class StringDataArray : public IDataArray
       return daCopy;
     }
 
+    /**
+     * @brief Creates a new array where string i is a copy of string map[i] of this array
+     * @param map Source tuple index for each tuple of the new array
+     * @return
+     */
+    virtual IDataArray::Pointer gather(const IndexMap& map)
+    {
+      if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false)
+      {
+        return IDataArray::NullPointer();
+      }
+      StringDataArray::Pointer daCopy = StringDataArray::CreateArray(map.size(), getName());
+      daCopy->initializeWithZeros();
+      for(size_t i = 0; i < map.size(); i++)
+      {
+        if(map[i] >= 0)
+        {
+          daCopy->setValue(i, m_Array[map[i]]);
+        }
+      }
+      return daCopy;
+    }
+
+    /**
+     * @brief Copies string i of the source array into string map[i] of this array
+     * @param map Destination tuple index for each tuple of the source array
+     * @param sourceArray
+     * @return
+     */
+    virtual bool scatter(const IndexMap& map, IDataArray::Pointer sourceArray)
+    {
+      Self* source = dynamic_cast<Self*>(sourceArray.get());
+      if(NULL == source) { return false; }
+      if(source->getNumberOfTuples() != map.size()) { return false; }
+      if(TupleTransfer::IsValid(map, getNumberOfTuples()) == false) { return false; }
+      for(size_t i = 0; i < map.size(); i++)
+      {
+        if(map[i] >= 0)
+        {
+          m_Array[map[i]] = source->getValue(i);
+        }
+      }
+      return true;
+    }
+
     /**
      * @brief Does Nothing
      * @param pos The index of the Tuple
@@ -0,0 +1,290 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "TupleTransfer.h"
+
+#include <string.h>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+namespace Detail
+{
+  // Number of map entries handed to a worker at a time
+  static const size_t k_GrainSize = 32768;
+}
+
+/**
+ * @brief The GatherImpl class copies the source tuples named by a run of the index map into
+ * consecutive destination tuples. FixedBytes is the tuple size when it is known at compile
+ * time, or 0 to use the run time tuple size.
+ */
+template<size_t FixedBytes>
+class GatherImpl
+{
+    const uint8_t* m_Source;
+    uint8_t* m_Destination;
+    size_t m_NumSourceTuples;
+    size_t m_TupleBytes;
+    const int64_t* m_Map;
+
+  public:
+    bool m_Valid;
+
+    GatherImpl(const void* source, size_t numSourceTuples, void* destination, size_t tupleBytes, const int64_t* map) :
+      m_Source(reinterpret_cast<const uint8_t*>(source)),
+      m_Destination(reinterpret_cast<uint8_t*>(destination)),
+      m_NumSourceTuples(numSourceTuples),
+      m_TupleBytes(tupleBytes),
+      m_Map(map),
+      m_Valid(true)
+    {}
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    GatherImpl(GatherImpl& other, tbb::split) :
+      m_Source(other.m_Source),
+      m_Destination(other.m_Destination),
+      m_NumSourceTuples(other.m_NumSourceTuples),
+      m_TupleBytes(other.m_TupleBytes),
+      m_Map(other.m_Map),
+      m_Valid(true)
+    {}
+
+    void join(const GatherImpl& other)
+    {
+      m_Valid = m_Valid && other.m_Valid;
+    }
+
+    void operator()(const tbb::blocked_range<size_t>& r)
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+    void convert(size_t start, size_t end)
+    {
+      const size_t tupleBytes = (FixedBytes > 0) ? FixedBytes : m_TupleBytes;
+      const int64_t numSourceTuples = static_cast<int64_t>(m_NumSourceTuples);
+      size_t i = start;
+      while (i < end)
+      {
+        int64_t srcIdx = m_Map[i];
+        if (srcIdx < 0 || srcIdx >= numSourceTuples)
+        {
+          if (srcIdx >= numSourceTuples) { m_Valid = false; }
+          ::memset(m_Destination + i * tupleBytes, 0, tupleBytes);
+          i++;
+          continue;
+        }
+        // Extend the run for as long as the source tuples are consecutive
+        size_t j = i + 1;
+        int64_t runEnd = srcIdx + 1;
+        while (j < end && m_Map[j] == runEnd && runEnd < numSourceTuples)
+        {
+          j++;
+          runEnd++;
+        }
+        if (j - i == 1)
+        {
+          ::memcpy(m_Destination + i * tupleBytes, m_Source + srcIdx * tupleBytes, tupleBytes);
+        }
+        else
+        {
+          ::memcpy(m_Destination + i * tupleBytes, m_Source + srcIdx * tupleBytes, (j - i) * tupleBytes);
+        }
+        i = j;
+      }
+    }
+};
+
+/**
+ * @brief The ScatterImpl class copies a run of consecutive source tuples into the destination
+ * tuples named by the index map. FixedBytes is used as in GatherImpl.
+ */
+template<size_t FixedBytes>
+class ScatterImpl
+{
+    const uint8_t* m_Source;
+    uint8_t* m_Destination;
+    size_t m_NumDestinationTuples;
+    size_t m_TupleBytes;
+    const int64_t* m_Map;
+
+  public:
+    bool m_Valid;
+
+    ScatterImpl(const void* source, void* destination, size_t numDestinationTuples, size_t tupleBytes, const int64_t* map) :
+      m_Source(reinterpret_cast<const uint8_t*>(source)),
+      m_Destination(reinterpret_cast<uint8_t*>(destination)),
+      m_NumDestinationTuples(numDestinationTuples),
+      m_TupleBytes(tupleBytes),
+      m_Map(map),
+      m_Valid(true)
+    {}
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    ScatterImpl(ScatterImpl& other, tbb::split) :
+      m_Source(other.m_Source),
+      m_Destination(other.m_Destination),
+      m_NumDestinationTuples(other.m_NumDestinationTuples),
+      m_TupleBytes(other.m_TupleBytes),
+      m_Map(other.m_Map),
+      m_Valid(true)
+    {}
+
+    void join(const ScatterImpl& other)
+    {
+      m_Valid = m_Valid && other.m_Valid;
+    }
+
+    void operator()(const tbb::blocked_range<size_t>& r)
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+    void convert(size_t start, size_t end)
+    {
+      const size_t tupleBytes = (FixedBytes > 0) ? FixedBytes : m_TupleBytes;
+      const int64_t numDestinationTuples = static_cast<int64_t>(m_NumDestinationTuples);
+      size_t i = start;
+      while (i < end)
+      {
+        int64_t destIdx = m_Map[i];
+        if (destIdx < 0 || destIdx >= numDestinationTuples)
+        {
+          if (destIdx >= numDestinationTuples) { m_Valid = false; }
+          i++;
+          continue;
+        }
+        size_t j = i + 1;
+        int64_t runEnd = destIdx + 1;
+        while (j < end && m_Map[j] == runEnd && runEnd < numDestinationTuples)
+        {
+          j++;
+          runEnd++;
+        }
+        if (j - i == 1)
+        {
+          ::memcpy(m_Destination + destIdx * tupleBytes, m_Source + i * tupleBytes, tupleBytes);
+        }
+        else
+        {
+          ::memcpy(m_Destination + destIdx * tupleBytes, m_Source + i * tupleBytes, (j - i) * tupleBytes);
+        }
+        i = j;
+      }
+    }
+};
+
+/**
+ * @brief Runs one of the transfer bodies over the whole index map
+ */
+template<typename Body>
+bool runTransfer(Body& body, size_t numEntries)
+{
+  ParallelContext::ParallelReduce<size_t>(0, numEntries, body, Detail::k_GrainSize);
+  return body.m_Valid;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TupleTransfer::TupleTransfer()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TupleTransfer::~TupleTransfer()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TupleTransfer::Gather(const void* source, size_t numSourceTuples, void* destination, size_t tupleBytes, const IDataArray::IndexMap& map)
+{
+  if (map.empty()) { return true; }
+  const int64_t* m = &(map.front());
+  switch(tupleBytes)
+  {
+    case 1: { GatherImpl<1> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 2: { GatherImpl<2> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 4: { GatherImpl<4> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 8: { GatherImpl<8> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 12: { GatherImpl<12> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 16: { GatherImpl<16> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+    default: { GatherImpl<0> body(source, numSourceTuples, destination, tupleBytes, m); return runTransfer(body, map.size()); }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TupleTransfer::Scatter(const void* source, void* destination, size_t numDestinationTuples, size_t tupleBytes, const IDataArray::IndexMap& map)
+{
+  if (map.empty()) { return true; }
+  const int64_t* m = &(map.front());
+  switch(tupleBytes)
+  {
+    case 1: { ScatterImpl<1> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 2: { ScatterImpl<2> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 4: { ScatterImpl<4> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 8: { ScatterImpl<8> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 12: { ScatterImpl<12> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+    case 16: { ScatterImpl<16> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+    default: { ScatterImpl<0> body(source, destination, numDestinationTuples, tupleBytes, m); return runTransfer(body, map.size()); }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool TupleTransfer::IsValid(const IDataArray::IndexMap& map, size_t numTuples)
+{
+  const int64_t numTuplesI = static_cast<int64_t>(numTuples);
+  for (size_t i = 0; i < map.size(); i++)
+  {
+    if (map[i] >= numTuplesI) { return false; }
+  }
+  return true;
+}
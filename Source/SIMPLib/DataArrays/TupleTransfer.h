@@ -0,0 +1,95 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _TupleTransfer_H_
+#define _TupleTransfer_H_
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+/**
+ * @brief The TupleTransfer class holds the kernels behind IDataArray::gather() and
+ * IDataArray::scatter(). The kernels only see raw bytes: tuples of 1, 2, 4, 8, 12 and 16 bytes
+ * are moved with fixed size copies, and runs of consecutive source tuples (a row of an image that
+ * is cropped or shifted, for example) are moved with a single memcpy. When parallel algorithms
+ * are enabled the index map is split across threads.
+ */
+class SIMPLib_EXPORT TupleTransfer
+{
+  public:
+    virtual ~TupleTransfer();
+
+    /**
+     * @brief Gather Copies tuple map[i] of the source into tuple i of the destination for
+     * every entry of the map. Destination tuples with a negative map entry are set to zero.
+     * @param source Source data
+     * @param numSourceTuples Number of tuples in the source
+     * @param destination Destination data, which must hold map.size() tuples
+     * @param tupleBytes Number of bytes in one tuple
+     * @param map Index map
+     * @return false if an entry of the map is outside of the source
+     */
+    static bool Gather(const void* source, size_t numSourceTuples, void* destination, size_t tupleBytes, const IDataArray::IndexMap& map);
+
+    /**
+     * @brief Scatter Copies tuple i of the source into tuple map[i] of the destination for
+     * every entry of the map. Source tuples with a negative map entry are skipped. Each destination
+     * tuple must appear at most once in the map.
+     * @param source Source data, which must hold map.size() tuples
+     * @param destination Destination data
+     * @param numDestinationTuples Number of tuples in the destination
+     * @param tupleBytes Number of bytes in one tuple
+     * @param map Index map
+     * @return false if an entry of the map is outside of the destination
+     */
+    static bool Scatter(const void* source, void* destination, size_t numDestinationTuples, size_t tupleBytes, const IDataArray::IndexMap& map);
+
+    /**
+     * @brief IsValid Returns true if every entry of the map is less than the given number of tuples
+     * @param map Index map
+     * @param numTuples Number of tuples that the map addresses
+     * @return
+     */
+    static bool IsValid(const IDataArray::IndexMap& map, size_t numTuples);
+
+  protected:
+    TupleTransfer();
+
+  private:
+    TupleTransfer(const TupleTransfer&); // Copy Constructor Not Implemented
+    void operator=(const TupleTransfer&); // Operator '=' Not Implemented
+};
+
+#endif /* _TupleTransfer_H_ */
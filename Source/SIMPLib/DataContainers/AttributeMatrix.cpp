@@ -42,6 +42,8 @@
 #include <iostream>
 #include <fstream>
 
+#include <QtCore/QSet>
+
 //HDF5 Includes
 #include "H5Support/QH5Utilities.h"
 #include "H5Support/QH5Lite.h"
@@ -56,6 +58,224 @@
 #include "SIMPLib/HDF5/VTKH5Constants.h"
 #include "SIMPLib/HDF5/H5DataArrayReader.h"
 #include "SIMPLib/DataArrays/StatsDataArray.h"
+#include "SIMPLib/DataArrays/TupleTransfer.h"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The RenumberIdsImpl class replaces each Id with its entry in the old to new map. Ids that
+ * fall outside of the map are left alone.
+ */
+class RenumberIdsImpl
+{
+    int32_t* m_Ids;
+    const int32_t* m_NewIds;
+    int32_t m_NumOldIds;
+
+  public:
+    RenumberIdsImpl(int32_t* ids, const int32_t* newIds, int32_t numOldIds) :
+      m_Ids(ids),
+      m_NewIds(newIds),
+      m_NumOldIds(numOldIds)
+    {}
+    virtual ~RenumberIdsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        if(m_Ids[i] >= 0 && m_Ids[i] < m_NumOldIds)
+        {
+          m_Ids[i] = m_NewIds[m_Ids[i]];
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The RemapNeighborListImpl class renumbers the Feature Ids held in each list of a
+ * NeighborList<int32_t> and drops the entries of removed Features. Whether each original entry
+ * was kept is written to a flag array (laid out with the given per-list offsets) so that lists
+ * paired with this one can be compacted the same way.
+ */
+class RemapNeighborListImpl
+{
+    NeighborList<int32_t>* m_List;
+    const int32_t* m_NewIds;
+    int32_t m_NumOldIds;
+    const size_t* m_Offsets;
+    uint8_t* m_Keep;
+
+  public:
+    RemapNeighborListImpl(NeighborList<int32_t>* list, const int32_t* newIds, int32_t numOldIds, const size_t* offsets, uint8_t* keep) :
+      m_List(list),
+      m_NewIds(newIds),
+      m_NumOldIds(numOldIds),
+      m_Offsets(offsets),
+      m_Keep(keep)
+    {}
+    virtual ~RemapNeighborListImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        std::vector<int32_t>& list = *(m_List->getList(static_cast<int32_t>(i)));
+        uint8_t* keep = m_Keep + m_Offsets[i];
+        size_t count = 0;
+        for (size_t j = 0; j < list.size(); j++)
+        {
+          int32_t id = list[j];
+          keep[j] = 1;
+          if (id > 0 && id < m_NumOldIds)
+          {
+            if (m_NewIds[id] == 0) { keep[j] = 0; }
+            else { id = m_NewIds[id]; }
+          }
+          if (keep[j] == 1)
+          {
+            list[count] = id;
+            count++;
+          }
+        }
+        list.resize(count);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+/**
+ * @brief The CompactPairedListImpl class drops the same entries from a paired NeighborList that
+ * RemapNeighborListImpl dropped from the Feature Id list it is paired with.
+ */
+template<typename T>
+class CompactPairedListImpl
+{
+    NeighborList<T>* m_List;
+    const size_t* m_Offsets;
+    const uint8_t* m_Keep;
+
+  public:
+    CompactPairedListImpl(NeighborList<T>* list, const size_t* offsets, const uint8_t* keep) :
+      m_List(list),
+      m_Offsets(offsets),
+      m_Keep(keep)
+    {}
+    virtual ~CompactPairedListImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      for (size_t i = start; i < end; i++)
+      {
+        std::vector<T>& list = *(m_List->getList(static_cast<int32_t>(i)));
+        const uint8_t* keep = m_Keep + m_Offsets[i];
+        size_t count = 0;
+        for (size_t j = 0; j < list.size(); j++)
+        {
+          if (keep[j] == 1)
+          {
+            list[count] = list[j];
+            count++;
+          }
+        }
+        list.resize(count);
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+namespace Detail
+{
+  /**
+   * @brief Runs one of the Impl classes above over [0, count)
+   */
+  template<typename Body>
+  void runImpl(const Body& body, size_t count)
+  {
+    ParallelContext::ParallelFor<size_t>(0, count, body);
+  }
+
+  /**
+   * @brief Returns whether the array is a NeighborList<T> with the same list sizes as the Id list
+   */
+  template<typename T>
+  bool isPairedList(IDataArray::Pointer array, NeighborList<int32_t>::Pointer idList)
+  {
+    typename NeighborList<T>::Pointer list = boost::dynamic_pointer_cast<NeighborList<T> >(array);
+    if (NULL == list.get() || list->getNumberOfTuples() != idList->getNumberOfTuples())
+    {
+      return false;
+    }
+    for (size_t i = 0; i < list->getNumberOfTuples(); i++)
+    {
+      if (list->getListSize(static_cast<int32_t>(i)) != idList->getListSize(static_cast<int32_t>(i)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool isPairedList(IDataArray::Pointer array, NeighborList<int32_t>::Pointer idList)
+  {
+    return isPairedList<float>(array, idList) || isPairedList<double>(array, idList) || isPairedList<int32_t>(array, idList)
+           || isPairedList<uint32_t>(array, idList) || isPairedList<int64_t>(array, idList);
+  }
+
+  /**
+   * @brief Drops the entries flagged in keep from the list if it is a NeighborList<T>
+   * @return true if the list was a NeighborList<T>
+   */
+  template<typename T>
+  bool compactPairedList(IDataArray::Pointer array, const std::vector<size_t>& offsets, const std::vector<uint8_t>& keep)
+  {
+    typename NeighborList<T>::Pointer list = boost::dynamic_pointer_cast<NeighborList<T> >(array);
+    if (NULL == list.get())
+    {
+      return false;
+    }
+    if (keep.empty() == false)
+    {
+      runImpl(CompactPairedListImpl<T>(list.get(), &(offsets.front()), &(keep.front())), list->getNumberOfTuples());
+    }
+    return true;
+  }
+
+  void compactPairedList(IDataArray::Pointer array, const std::vector<size_t>& offsets, const std::vector<uint8_t>& keep)
+  {
+    if (compactPairedList<float>(array, offsets, keep) || compactPairedList<double>(array, offsets, keep)
+        || compactPairedList<int32_t>(array, offsets, keep) || compactPairedList<uint32_t>(array, offsets, keep))
+    {
+      return;
+    }
+    compactPairedList<int64_t>(array, offsets, keep);
+  }
+}
 
 // -----------------------------------------------------------------------------
 //
@@ -274,6 +494,17 @@ size_t AttributeMatrix::getNumTuples()
 //
 // -----------------------------------------------------------------------------
 bool AttributeMatrix::removeInactiveObjects(QVector<bool> activeObjects, Int32ArrayType::Pointer Ids)
+{
+  QMap<QString, QStringList> idLists;
+  idLists[DREAM3D::FeatureData::NeighborList] << DREAM3D::FeatureData::SharedSurfaceAreaList << DREAM3D::FeatureData::MisorientationList;
+  idLists[DREAM3D::FeatureData::NeighborhoodList] = QStringList();
+  return removeInactiveObjects(activeObjects, Ids, idLists);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AttributeMatrix::removeInactiveObjects(QVector<bool> activeObjects, Int32ArrayType::Pointer Ids, const QMap<QString, QStringList>& idLists)
 {
   bool acceptableMatrix = false;
   //Only valid for feature or ensemble type matrices
@@ -287,52 +518,107 @@ bool AttributeMatrix::removeInactiveObjects(QVector<bool> activeObjects, Int32Ar
   size_t totalTuples = getNumTuples();
   if( static_cast<size_t>(activeObjects.size()) == totalTuples && acceptableMatrix == true)
   {
-    size_t goodcount = 1;
-    QVector<size_t> NewNames(totalTuples, 0);
-    QVector<size_t> RemoveList;
+    // Build the old to new map and its inverse (the old index of every kept tuple) once
+    std::vector<int32_t> NewNames(totalTuples, 0);
+    IDataArray::IndexMap keptTuples;
+    keptTuples.reserve(totalTuples);
+    if (totalTuples > 0) { keptTuples.push_back(0); }
 
     for(qint32 i = 1; i < activeObjects.size(); i++)
     {
-      if(activeObjects[i] == false)
-      {
-        RemoveList.push_back(i);
-        NewNames[i] = 0;
-      }
-      else
+      if(activeObjects[i] == true)
       {
-        NewNames[i] = goodcount;
-        goodcount++;
+        NewNames[i] = static_cast<int32_t>(keptTuples.size());
+        keptTuples.push_back(i);
       }
     }
 
-    if(RemoveList.size() > 0)
+    if(keptTuples.size() < totalTuples)
     {
+      // Only the Id lists and the lists paired with them can be updated, so every other NeighborList is removed
+      QMap<QString, QStringList> pairedLists;
+      QSet<QString> updatedLists;
+      for (QMap<QString, QStringList>::const_iterator iter = idLists.begin(); iter != idLists.end(); ++iter)
+      {
+        NeighborList<int32_t>::Pointer idList = getAttributeArrayAs<NeighborList<int32_t> >(iter.key());
+        if (NULL == idList.get())
+        {
+          continue;
+        }
+        updatedLists.insert(iter.key());
+        QStringList& paired = pairedLists[iter.key()];
+        for (QStringList::const_iterator pIter = iter.value().begin(); pIter != iter.value().end(); ++pIter)
+        {
+          if (idLists.contains(*pIter) || updatedLists.contains(*pIter)) { continue; }
+          if (Detail::isPairedList(getAttributeArray(*pIter), idList) == true)
+          {
+            paired << *pIter;
+            updatedLists.insert(*pIter);
+          }
+        }
+      }
       QList<QString> headers = getAttributeArrayNames();
       for (QList<QString>::iterator iter = headers.begin(); iter != headers.end(); ++iter)
       {
-        IDataArray::Pointer p = getAttributeArray(*iter);
-        QString type = p->getTypeAsString();
-        if(type.compare("NeighborList<T>") == 0)
+        if (getAttributeArray(*iter)->getTypeAsString().compare(DREAM3D::TypeNames::NeighborList) == 0 && updatedLists.contains(*iter) == false)
         {
           removeAttributeArray(*iter);
         }
-        else
+      }
+
+      // Compact every array, including the NeighborLists, through the same map
+      QVector<size_t> tDims(1, keptTuples.size());
+      if (gatherAttributeArrays(keptTuples, tDims) == false)
+      {
+        return false;
+      }
+
+      for (QMap<QString, QStringList>::iterator iter = pairedLists.begin(); iter != pairedLists.end(); ++iter)
+      {
+        NeighborList<int32_t>::Pointer idList = getAttributeArrayAs<NeighborList<int32_t> >(iter.key());
+        size_t numLists = idList->getNumberOfTuples();
+        std::vector<size_t> offsets(numLists + 1, 0);
+        for (size_t i = 0; i < numLists; i++)
+        {
+          offsets[i + 1] = offsets[i] + idList->getListSize(static_cast<int32_t>(i));
+        }
+
+        Int32ArrayType::Pointer numNeighbors = getAttributeArrayAs<Int32ArrayType>(idList->getNumNeighborsArrayName());
+        if (NULL != numNeighbors.get())
+        {
+          bool linked = (numNeighbors->getNumberOfTuples() == numLists && numNeighbors->getNumberOfComponents() == 1);
+          for (size_t i = 0; i < numLists && linked == true; i++)
+          {
+            linked = (static_cast<size_t>(numNeighbors->getValue(i)) == offsets[i + 1] - offsets[i]);
+          }
+          if (linked == false) { numNeighbors = Int32ArrayType::NullPointer(); }
+        }
+
+        // Renumber the Ids, flagging the entries of removed objects, then drop the same entries from the paired lists
+        std::vector<uint8_t> keep(offsets.back(), 1);
+        if (offsets.back() > 0)
+        {
+          Detail::runImpl(RemapNeighborListImpl(idList.get(), &(NewNames.front()), static_cast<int32_t>(totalTuples), &(offsets.front()), &(keep.front())), numLists);
+        }
+        for (QStringList::iterator pIter = iter.value().begin(); pIter != iter.value().end(); ++pIter)
+        {
+          Detail::compactPairedList(getAttributeArray(*pIter), offsets, keep);
+        }
+
+        if (NULL != numNeighbors.get())
         {
-          p->eraseTuples(RemoveList);
+          for (size_t i = 0; i < numLists; i++)
+          {
+            numNeighbors->setValue(i, idList->getListSize(static_cast<int32_t>(i)));
+          }
         }
       }
-      QVector<size_t> tDims(1, (totalTuples - RemoveList.size()));
-      setTupleDimensions(tDims);
 
       // Loop over all the points and correct all the feature names
       size_t totalPoints = Ids->getNumberOfTuples();
-      int32_t* id = Ids->getPointer(0);
-      for (size_t i = 0; i < totalPoints; i++)
+      if (totalPoints > 0)
       {
-        if(id[i] >= 0 && id[i] < NewNames.size())
-        {
-          id[i] = static_cast<int32_t>( NewNames[id[i]] );
-        }
+        Detail::runImpl(RenumberIdsImpl(Ids->getPointer(0), &(NewNames.front()), static_cast<int32_t>(totalTuples)), totalPoints);
       }
     }
   }
@@ -343,6 +629,45 @@ bool AttributeMatrix::removeInactiveObjects(QVector<bool> activeObjects, Int32Ar
   return true;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool AttributeMatrix::gatherAttributeArrays(const IDataArray::IndexMap& map, QVector<size_t> tDims)
+{
+  size_t numTuples = tDims[0];
+  for(int i = 1; i < tDims.size(); i++)
+  {
+    numTuples *= tDims[i];
+  }
+  if(numTuples != map.size() || TupleTransfer::IsValid(map, getNumTuples()) == false)
+  {
+    return false;
+  }
+
+  for(QMap<QString, IDataArray::Pointer>::iterator iter = m_AttributeArrays.begin(); iter != m_AttributeArrays.end(); ++iter)
+  {
+    if (iter.value()->getNumberOfTuples() != getNumTuples())
+    {
+      return false;
+    }
+  }
+
+  // The map and every array were validated above, so a copy can only fail if it can not be allocated.
+  // Each array is replaced as soon as its copy is built, which keeps at most one extra array alive at a time.
+  for(QMap<QString, IDataArray::Pointer>::iterator iter = m_AttributeArrays.begin(); iter != m_AttributeArrays.end(); ++iter)
+  {
+    IDataArray::Pointer d = iter.value()->gather(map);
+    if (NULL == d.get() || d->getNumberOfTuples() != numTuples)
+    {
+      return false;
+    }
+    iter.value() = d;
+  }
+
+  m_TupleDims = tDims;
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -47,6 +47,9 @@
 #include <sstream>
 #include <list>
 
+#include <QtCore/QMap>
+#include <QtCore/QStringList>
+
 //-- EBSD Lib Includes
 #include "EbsdLib/EbsdConstants.h"
 
@@ -493,11 +496,39 @@ class SIMPLib_EXPORT AttributeMatrix : public Observable
 
     /**
     * @brief Removes inactive objects from the Attribute Matrix and renumbers the active objects to preserve a compact matrix
-      (only valid for feature or ensemble type matrices)
-    * @param size The new size of the array
+      (only valid for feature or ensemble type matrices). The NeighborLists written by FindNeighbors, FindMisorientations
+      and FindNeighborhoods are kept under their default names, with their Feature Ids renumbered through the same old to
+      new map as Ids (see the overload below). All other NeighborLists are removed, since their contents can not be renumbered.
+    * @param activeObjects Whether each object is kept
+    * @param Ids The Ids that refer to the objects, which are renumbered
     */
     bool removeInactiveObjects(QVector<bool> activeObjects, Int32ArrayType::Pointer Ids);
 
+    /**
+     * @brief Removes inactive objects from the Attribute Matrix and renumbers the active objects to preserve a compact matrix
+     * (only valid for feature or ensemble type matrices)
+     * @param activeObjects Whether each object is kept
+     * @param Ids The Ids that refer to the objects, which are renumbered
+     * @param idLists Maps the name of each NeighborList<int32_t> whose entries are object Ids to the names of the NeighborLists
+     * that follow it entry for entry. The Ids are renumbered and the entries of removed objects are dropped from the Id list
+     * and its paired lists, and an Int32 array named by the Id list's NumNeighborsArrayName that holds its list sizes is
+     * updated. Paired lists whose list sizes do not match the Id list, and all other NeighborLists, are removed.
+     */
+    bool removeInactiveObjects(QVector<bool> activeObjects, Int32ArrayType::Pointer Ids, const QMap<QString, QStringList>& idLists);
+
+    /**
+     * @brief Replaces every Attribute Array with a copy built through the same index map (see
+     * IDataArray::gather) and sets the new Tuple Dimensions. This is the bulk form of calling
+     * copyTuple on every array for every tuple when cropping or resampling a geometry.
+     * @param map Old tuple index for each new tuple; negative entries produce tuples set to zero
+     * @param tDims The new Tuple Dimensions, which must describe map.size() tuples
+     * @return false if the map does not fit the old or new tuples or an array does not hold the old number of
+     * tuples, in which case the matrix is untouched, or if an array could not be allocated. Arrays are replaced
+     * one at a time to bound the extra memory to a single array, so after a failed allocation the arrays already
+     * gathered keep their new tuples.
+     */
+    bool gatherAttributeArrays(const IDataArray::IndexMap& map, QVector<size_t> tDims);
+
     /**
      * @brief Sets the Tuple Dimensions for the Attribute Matrix
      * @param tupleDims
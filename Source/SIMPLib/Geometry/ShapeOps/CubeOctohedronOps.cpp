@@ -209,3 +209,16 @@ float CubeOctohedronOps::inside(float axis1comp, float axis2comp, float axis3com
   }
   return inside;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CubeOctohedronOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  // Part of the plane tests run in double precision, so the points are evaluated one at a time
+  // through the scalar test, which the compiler can inline here
+  for (size_t i = 0; i < count; i++)
+  {
+    insides[i] = CubeOctohedronOps::inside(axis1comps[i], axis2comps[i], axis3comps[i]);
+  }
+}
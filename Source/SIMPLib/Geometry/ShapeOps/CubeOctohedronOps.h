@@ -57,6 +57,7 @@ class SIMPLib_EXPORT CubeOctohedronOps : public ShapeOps
     virtual float radcur1(QMap<ArgName, float> args);
 
     virtual float inside(float axis1comp, float axis2comp, float axis3comp);
+    virtual void insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count);
     virtual void init() { Gvalue = 0.0f; }
 
   protected:
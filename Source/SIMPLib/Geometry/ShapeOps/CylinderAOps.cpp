@@ -89,3 +89,11 @@ float CylinderAOps::inside(float axis1comp, float axis2comp, float axis3comp)
   }
   return inside;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CylinderAOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  cylinderInsideBatch(axis1comps, axis2comps, axis3comps, insides, count);
+}
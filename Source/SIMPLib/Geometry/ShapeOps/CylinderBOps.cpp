@@ -89,3 +89,11 @@ float CylinderBOps::inside(float axis1comp, float axis2comp, float axis3comp)
   }
   return inside;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CylinderBOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  cylinderInsideBatch(axis2comps, axis1comps, axis3comps, insides, count);
+}
@@ -89,3 +89,11 @@ float CylinderCOps::inside(float axis1comp, float axis2comp, float axis3comp)
   }
   return inside;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void CylinderCOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  cylinderInsideBatch(axis3comps, axis1comps, axis2comps, insides, count);
+}
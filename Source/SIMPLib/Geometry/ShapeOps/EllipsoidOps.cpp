@@ -35,6 +35,10 @@
 
 #include "EllipsoidOps.h"
 
+#if defined (__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 
@@ -90,3 +94,29 @@ float EllipsoidOps::inside(float axis1comp, float axis2comp, float axis3comp)
   inside = 1.0f - axis1comp - axis2comp - axis3comp;
   return inside;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void EllipsoidOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  size_t i = 0;
+#if defined (__AVX2__)
+  const __m256 one = _mm256_set1_ps(1.0f);
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 axis1comp = _mm256_loadu_ps(axis1comps + i);
+    __m256 axis2comp = _mm256_loadu_ps(axis2comps + i);
+    __m256 axis3comp = _mm256_loadu_ps(axis3comps + i);
+    axis1comp = _mm256_mul_ps(axis1comp, axis1comp);
+    axis2comp = _mm256_mul_ps(axis2comp, axis2comp);
+    axis3comp = _mm256_mul_ps(axis3comp, axis3comp);
+    __m256 inside = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(one, axis1comp), axis2comp), axis3comp);
+    _mm256_storeu_ps(insides + i, inside);
+  }
+#endif
+  for (; i < count; i++)
+  {
+    insides[i] = EllipsoidOps::inside(axis1comps[i], axis2comps[i], axis3comps[i]);
+  }
+}
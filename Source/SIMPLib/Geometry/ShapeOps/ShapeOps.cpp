@@ -36,6 +36,10 @@
 
 #include "ShapeOps.h"
 
+#if defined (__AVX2__)
+#include <immintrin.h>
+#endif
+
 #include "SIMPLib/Math/SIMPLibMath.h"
 
 #include "SIMPLib/Geometry/ShapeOps/CubeOctohedronOps.h"
@@ -112,3 +116,55 @@ float ShapeOps::inside(float axis1comp, float axis2comp, float axis3comp)
   return -1.0;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ShapeOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    insides[i] = inside(axis1comps[i], axis2comps[i], axis3comps[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ShapeOps::cylinderInsideBatch(const float* axialComps, const float* radialComps1, const float* radialComps2, float* insides, size_t count)
+{
+  size_t i = 0;
+#if defined (__AVX2__)
+  // The scalar test subtracts the squared components in double precision, so the vector
+  // version widens each half of the batch to keep the results identical
+  const __m256 signMask = _mm256_set1_ps(-0.0f);
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 minusOne = _mm256_set1_ps(-1.0f);
+  const __m256d oneD = _mm256_set1_pd(1.0);
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256 axial = _mm256_andnot_ps(signMask, _mm256_loadu_ps(axialComps + i));
+    __m256 radial1 = _mm256_loadu_ps(radialComps1 + i);
+    __m256 radial2 = _mm256_loadu_ps(radialComps2 + i);
+    radial1 = _mm256_mul_ps(radial1, radial1);
+    radial2 = _mm256_mul_ps(radial2, radial2);
+    __m256d low = _mm256_sub_pd(_mm256_sub_pd(oneD, _mm256_cvtps_pd(_mm256_castps256_ps128(radial1))), _mm256_cvtps_pd(_mm256_castps256_ps128(radial2)));
+    __m256d high = _mm256_sub_pd(_mm256_sub_pd(oneD, _mm256_cvtps_pd(_mm256_extractf128_ps(radial1, 1))), _mm256_cvtps_pd(_mm256_extractf128_ps(radial2, 1)));
+    __m256 inside = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(low)), _mm256_cvtpd_ps(high), 1);
+    inside = _mm256_blendv_ps(minusOne, inside, _mm256_cmp_ps(axial, one, _CMP_LE_OQ));
+    _mm256_storeu_ps(insides + i, inside);
+  }
+#endif
+  for (; i < count; i++)
+  {
+    float inside = -1.0;
+    if (fabs(axialComps[i]) <= 1.0)
+    {
+      float radial1 = fabs(radialComps1[i]);
+      float radial2 = fabs(radialComps2[i]);
+      radial1 = radial1 * radial1;
+      radial2 = radial2 * radial2;
+      inside = static_cast<float>( 1.0 - radial1 - radial2 );
+    }
+    insides[i] = inside;
+  }
+}
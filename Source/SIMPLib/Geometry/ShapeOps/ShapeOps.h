@@ -82,11 +82,33 @@ class SIMPLib_EXPORT ShapeOps
 
     virtual float inside(float axis1comp, float axis2comp, float axis3comp);
 
+    /**
+     * @brief insideBatch Evaluates inside() for a run of points in one call. Subclasses override this
+     * with versions that return the same values as inside(). The ellipsoid and cylinder versions use AVX2
+     * when SIMPLib is configured with SIMPLib_USE_AVX2
+     * @param axis1comps Point coordinates along the first semi-axis, scaled by its length
+     * @param axis2comps Point coordinates along the second semi-axis, scaled by its length
+     * @param axis3comps Point coordinates along the third semi-axis, scaled by its length
+     * @param insides Output inside() value of each point
+     * @param count Number of points
+     */
+    virtual void insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count);
+
     virtual void init() {}
 
   protected:
     ShapeOps();
 
+    /**
+     * @brief cylinderInsideBatch Shared batched inside() test for the cylinder shapes
+     * @param axialComps Scaled coordinates along the cylinder axis
+     * @param radialComps1 Scaled coordinates along the first radial semi-axis
+     * @param radialComps2 Scaled coordinates along the second radial semi-axis
+     * @param insides Output inside() value of each point
+     * @param count Number of points
+     */
+    static void cylinderInsideBatch(const float* axialComps, const float* radialComps1, const float* radialComps2, float* insides, size_t count);
+
   private:
     ShapeOps(const ShapeOps&); // Copy Constructor Not Implemented
     void operator=(const ShapeOps&); // Operator '=' Not Implemented
@@ -151,3 +151,16 @@ float SuperEllipsoidOps::inside(float axis1comp, float axis2comp, float axis3com
   inside = 1.0f - axis1comp - axis2comp - axis3comp;
   return inside;
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SuperEllipsoidOps::insideBatch(const float* axis1comps, const float* axis2comps, const float* axis3comps, float* insides, size_t count)
+{
+  // There is no vector power function that rounds exactly like powf, so the points are evaluated
+  // one at a time through the scalar test to keep the results identical to inside()
+  for (size_t i = 0; i < count; i++)
+  {
+    insides[i] = SuperEllipsoidOps::inside(axis1comps[i], axis2comps[i], axis3comps[i]);
+  }
+}
@@ -75,6 +75,18 @@ set(SIMPLib_Geometry_SRCS
   ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/SuperEllipsoidOps.cpp
 )
 
+# The batched inside tests have AVX2 code paths that are only compiled when asked for
+if(SIMPLib_USE_AVX2)
+  if(MSVC)
+    set(SIMPLib_AVX2_FLAGS "/arch:AVX2")
+  else()
+    set(SIMPLib_AVX2_FLAGS "-mavx2")
+  endif()
+  set_source_files_properties(${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/ShapeOps.cpp
+                              ${SIMPLib_SOURCE_DIR}/Geometry/ShapeOps/EllipsoidOps.cpp
+                              PROPERTIES COMPILE_FLAGS ${SIMPLib_AVX2_FLAGS})
+endif()
+
 cmp_IDE_SOURCE_PROPERTIES( "Geometry" "${SIMPLib_Geometry_HDRS}" "${SIMPLib_Geometry_SRCS}" "0")
 
 set(SIMPLib_Geometry_HDRS
@@ -0,0 +1,238 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PointGrid.h"
+
+#include <math.h>
+#include <limits>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+namespace Detail
+{
+  // The grid is coarsened until it has no more than this many cells per point
+  static const int64_t k_MaxCellsPerPoint = 4;
+
+  // Fewer points than this are bucketed on the calling thread
+  static const size_t k_MinParallelPoints = 65536;
+}
+
+/**
+ * @brief The FindPointCellsImpl class computes the flat index of the grid cell that holds each point
+ */
+class FindPointCellsImpl
+{
+    const float* m_Coords;
+    const float* m_Origin;
+    const int64_t* m_Dims;
+    float m_CellSize;
+    size_t m_FirstPoint;
+    int64_t* m_Cells;
+
+  public:
+    FindPointCellsImpl(const float* coords, const float* origin, const int64_t* dims, float cellSize, size_t firstPoint, int64_t* cells) :
+      m_Coords(coords),
+      m_Origin(origin),
+      m_Dims(dims),
+      m_CellSize(cellSize),
+      m_FirstPoint(firstPoint),
+      m_Cells(cells)
+    {}
+    virtual ~FindPointCellsImpl() {}
+
+    void convert(size_t start, size_t end) const
+    {
+      int64_t cell[3] = { 0, 0, 0 };
+      for (size_t i = start; i < end; i++)
+      {
+        for (size_t k = 0; k < 3; k++)
+        {
+          // Divide the same way the queries do so a point always falls inside its own query box
+          cell[k] = static_cast<int64_t>((m_Coords[3 * i + k] - m_Origin[k]) / m_CellSize);
+          if (cell[k] < 0) { cell[k] = 0; }
+          if (cell[k] >= m_Dims[k]) { cell[k] = m_Dims[k] - 1; }
+        }
+        m_Cells[i - m_FirstPoint] = (cell[2] * m_Dims[1] + cell[1]) * m_Dims[0] + cell[0];
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PointGrid::PointGrid(const float* coords, size_t numPoints, size_t firstPoint, float cellSize) :
+  m_CellSize(cellSize)
+{
+  float maxCoord[3] = { 0.0f, 0.0f, 0.0f };
+  for (size_t k = 0; k < 3; k++)
+  {
+    m_Origin[k] = std::numeric_limits<float>::max();
+    maxCoord[k] = -std::numeric_limits<float>::max();
+    m_Dims[k] = 1;
+  }
+  if (firstPoint > numPoints) { firstPoint = numPoints; }
+  size_t count = numPoints - firstPoint;
+
+  for (size_t i = firstPoint; i < numPoints; i++)
+  {
+    for (size_t k = 0; k < 3; k++)
+    {
+      if (coords[3 * i + k] < m_Origin[k]) { m_Origin[k] = coords[3 * i + k]; }
+      if (coords[3 * i + k] > maxCoord[k]) { maxCoord[k] = coords[3 * i + k]; }
+    }
+  }
+  if (count == 0)
+  {
+    for (size_t k = 0; k < 3; k++)
+    {
+      m_Origin[k] = 0.0f;
+      maxCoord[k] = 0.0f;
+    }
+  }
+
+  if (m_CellSize <= 0.0f) { m_CellSize = 1.0f; }
+  int64_t maxCells = static_cast<int64_t>(count) * Detail::k_MaxCellsPerPoint;
+  if (maxCells < 1) { maxCells = 1; }
+  while (true)
+  {
+    double numCells = 1.0;
+    for (size_t k = 0; k < 3; k++)
+    {
+      numCells *= floor((maxCoord[k] - m_Origin[k]) / m_CellSize) + 1.0;
+    }
+    if (numCells <= static_cast<double>(maxCells)) { break; }
+    m_CellSize = m_CellSize * 2.0f;
+  }
+  for (size_t k = 0; k < 3; k++)
+  {
+    m_Dims[k] = static_cast<int64_t>((maxCoord[k] - m_Origin[k]) / m_CellSize) + 1;
+  }
+  size_t numCells = static_cast<size_t>(m_Dims[0] * m_Dims[1] * m_Dims[2]);
+
+  std::vector<int64_t> cells(count, 0);
+  FindPointCellsImpl finder(coords, m_Origin, m_Dims, m_CellSize, firstPoint, cells.empty() ? NULL : &(cells.front()));
+  if (count < Detail::k_MinParallelPoints)
+  {
+    finder.convert(firstPoint, numPoints);
+  }
+  else
+  {
+    ParallelContext::ParallelFor<size_t>(firstPoint, numPoints, finder);
+  }
+
+  // Counting sort of the points by cell, keeping the points of each cell in index order
+  m_CellStarts.resize(numCells + 1, 0);
+  for (size_t i = 0; i < count; i++)
+  {
+    m_CellStarts[cells[i] + 1]++;
+  }
+  for (size_t c = 0; c < numCells; c++)
+  {
+    m_CellStarts[c + 1] += m_CellStarts[c];
+  }
+  std::vector<size_t> next(m_CellStarts.begin(), m_CellStarts.end() - 1);
+  m_PointIds.resize(count);
+  for (size_t i = 0; i < count; i++)
+  {
+    m_PointIds[next[cells[i]]++] = i + firstPoint;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PointGrid::~PointGrid()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float PointGrid::getCellSize() const
+{
+  return m_CellSize;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PointGrid::getCellRange(const float boxMin[3], const float boxMax[3], int64_t low[3], int64_t high[3]) const
+{
+  for (size_t k = 0; k < 3; k++)
+  {
+    // Work in floating point until the range is clamped so huge boxes cannot overflow the cast
+    float first = floorf((boxMin[k] - m_Origin[k]) / m_CellSize);
+    float last = floorf((boxMax[k] - m_Origin[k]) / m_CellSize);
+    if (last < 0.0f || first > static_cast<float>(m_Dims[k] - 1) || last < first) { return false; }
+    low[k] = (first < 0.0f) ? 0 : static_cast<int64_t>(first);
+    high[k] = (last > static_cast<float>(m_Dims[k] - 1)) ? m_Dims[k] - 1 : static_cast<int64_t>(last);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PointGrid::findCandidatesInBox(const float boxMin[3], const float boxMax[3], std::vector<size_t>& ids) const
+{
+  int64_t low[3] = { 0, 0, 0 };
+  int64_t high[3] = { 0, 0, 0 };
+  if (getCellRange(boxMin, boxMax, low, high) == false) { return; }
+
+  for (int64_t z = low[2]; z <= high[2]; z++)
+  {
+    for (int64_t y = low[1]; y <= high[1]; y++)
+    {
+      // The cells of one row are contiguous, so their points are too
+      size_t row = static_cast<size_t>((z * m_Dims[1] + y) * m_Dims[0]);
+      size_t begin = m_CellStarts[row + low[0]];
+      size_t end = m_CellStarts[row + high[0] + 1];
+      ids.insert(ids.end(), m_PointIds.begin() + begin, m_PointIds.begin() + end);
+    }
+  }
+}
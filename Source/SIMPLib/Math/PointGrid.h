@@ -0,0 +1,96 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _PointGrid_H_
+#define _PointGrid_H_
+
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+/**
+ * @brief The PointGrid class is a spatial index over a set of points such as Feature centroids.
+ * The points are bucketed into a uniform grid of cubic cells and stored sorted by cell, so a
+ * query only visits the cells that overlap its search box instead of every point. The grid
+ * stores only point indices, so a query returns candidates and the caller tests them against
+ * its own coordinates. The queries are const and may be called from several threads at once.
+ */
+class SIMPLib_EXPORT PointGrid
+{
+  public:
+    /**
+     * @brief PointGrid Builds the index
+     * @param coords Interleaved (x, y, z) coordinates of the points
+     * @param numPoints Number of points
+     * @param firstPoint Points before this index are left out of the grid; pass 1 to skip Feature 0
+     * @param cellSize Requested edge length of a cell. The cells are enlarged when the points are
+     * too sparse for the grid to stay at most a few cells per point.
+     */
+    PointGrid(const float* coords, size_t numPoints, size_t firstPoint, float cellSize);
+    virtual ~PointGrid();
+
+    /**
+     * @brief getCellSize Returns the edge length of a cell actually used by the grid
+     * @return
+     */
+    float getCellSize() const;
+
+    /**
+     * @brief findCandidatesInBox Appends every point in a cell that overlaps the box. Points near the
+     * edges of the box may lie outside it, so the caller applies its own exact test.
+     * @param boxMin Lower corner of the box
+     * @param boxMax Upper corner of the box
+     * @param ids Receives the point indices
+     */
+    void findCandidatesInBox(const float boxMin[3], const float boxMax[3], std::vector<size_t>& ids) const;
+
+  private:
+    float m_CellSize;
+    float m_Origin[3];
+    int64_t m_Dims[3];
+    std::vector<size_t> m_CellStarts;
+    std::vector<size_t> m_PointIds;
+
+    /**
+     * @brief getCellRange Finds the range of cells that overlap a box
+     * @return false if the box misses the grid
+     */
+    bool getCellRange(const float boxMin[3], const float boxMax[3], int64_t low[3], int64_t high[3]) const;
+
+    PointGrid(const PointGrid&); // Copy Constructor Not Implemented
+    void operator=(const PointGrid&); // Operator '=' Not Implemented
+};
+
+#endif /* _PointGrid_H_ */
@@ -83,7 +83,6 @@ std::vector<float> RadialDistributionFunction::GenerateRandomDistribution(float
 {
   std::vector<float> freq(numBins, 0);
   std::vector<float> randomCentroids;
-  std::vector<std::vector<float> > distancelist;
   int32_t largeNumber = 1000;
   int32_t numDistances = largeNumber * (largeNumber - 1);
 
@@ -134,10 +133,7 @@ std::vector<float> RadialDistributionFunction::GenerateRandomDistribution(float
 
   }
 
-  distancelist.resize(largeNumber);
-
-
-//Calculating all of the distances and storing them in the distnace list
+  // Bin each distance as soon as it is calculated; every pair counts once for each of its two points
   for (int32_t i = 1; i < largeNumber; i++)
   {
 
@@ -154,27 +150,16 @@ std::vector<float> RadialDistributionFunction::GenerateRandomDistribution(float
 
       r = sqrtf((x - xn) * (x - xn) + (y - yn) * (y - yn) + (z - zn) * (z - zn));
 
-      distancelist[i].push_back(r);
-      distancelist[j].push_back(r);
-
-    }
-
-  }
+      bin = (r - minDistance) / stepsize;
 
-  //bin up the distance list
-  for (int32_t i = 0; i < largeNumber; i++)
-  {
-    for (size_t j = 0; j < distancelist[i].size(); j++)
-    {
-      bin = (distancelist[i][j] - minDistance) / stepsize;
-
-      if (distancelist[i][j] < minDistance)
+      if (r < minDistance)
       {
         bin = -1;
       }
-      freq[bin + 1]++;
+      freq[bin + 1] += 2.0f;
 
     }
+
   }
 
   for (int32_t i = 0; i < current_num_bins + 1; i++)
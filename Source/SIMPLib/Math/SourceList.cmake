@@ -42,12 +42,14 @@ set(SIMPLib_Math_HDRS
   ${SIMPLib_SOURCE_DIR}/Math/ArrayHelpers.hpp
   ${SIMPLib_SOURCE_DIR}/Math/SIMPLibMath.h
   ${SIMPLib_SOURCE_DIR}/Math/RadialDistributionFunction.h
+  ${SIMPLib_SOURCE_DIR}/Math/PointGrid.h
 )
 set(SIMPLib_Math_SRCS
   ${SIMPLib_SOURCE_DIR}/Math/GeometryMath.cpp
   ${SIMPLib_SOURCE_DIR}/Math/MatrixMath.cpp
   ${SIMPLib_SOURCE_DIR}/Math/SIMPLibMath.cpp
   ${SIMPLib_SOURCE_DIR}/Math/RadialDistributionFunction.cpp
+  ${SIMPLib_SOURCE_DIR}/Math/PointGrid.cpp
 )
 cmp_IDE_SOURCE_PROPERTIES( "Math" "${SIMPLib_Math_HDRS}" "${SIMPLib_Math_SRCS}" "0")
 if( ${PROJECT_INSTALL_HEADERS} EQUAL 1 )
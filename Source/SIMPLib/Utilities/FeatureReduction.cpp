@@ -0,0 +1,255 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FeatureReduction.h"
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#endif
+
+#include "SIMPLib/Utilities/ParallelContext.h"
+
+namespace Detail
+{
+  // Number of cells handed to all the reductions at a time so that the Feature Ids for
+  // the block are still in cache when the next reduction walks them.
+  static const size_t k_FusedBlockSize = 4096;
+
+  // Smallest number of cells given to a worker. Each worker allocates and merges a full
+  // set of accumulators, so it must have enough cells to amortize that cost.
+  static const size_t k_MinimumGrainSize = 65536;
+}
+
+/**
+ * @brief The FeatureReductionImpl class holds one set of accumulators for all the reductions
+ * and feeds them blocks of cells. It is used directly as the body of ParallelContext::ParallelReduce.
+ */
+class FeatureReductionImpl
+{
+    const QVector<FeatureReduction::Pointer>* m_Reductions;
+    const std::vector<size_t>* m_Offsets;
+    FeatureReductionRange m_Range;
+    size_t m_NumFeatures;
+    std::vector<double> m_Accumulator;
+
+  public:
+    FeatureReductionImpl(const QVector<FeatureReduction::Pointer>* reductions,
+                         const std::vector<size_t>* offsets,
+                         const FeatureReductionRange& range,
+                         size_t numFeatures) :
+      m_Reductions(reductions),
+      m_Offsets(offsets),
+      m_Range(range),
+      m_NumFeatures(numFeatures),
+      m_Accumulator(offsets->back(), 0.0)
+    {
+      initialize();
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    FeatureReductionImpl(FeatureReductionImpl& other, tbb::split) :
+      m_Reductions(other.m_Reductions),
+      m_Offsets(other.m_Offsets),
+      m_Range(other.m_Range),
+      m_NumFeatures(other.m_NumFeatures),
+      m_Accumulator(other.m_Offsets->back(), 0.0)
+    {
+      initialize();
+    }
+#endif
+
+    virtual ~FeatureReductionImpl() {}
+
+    void initialize()
+    {
+      for (int32_t r = 0; r < m_Reductions->size(); r++)
+      {
+        size_t offset = (*m_Offsets)[r];
+        (*m_Reductions)[r]->initialize(&(m_Accumulator[offset]), (*m_Offsets)[r + 1] - offset);
+      }
+    }
+
+    void convert(size_t start, size_t end)
+    {
+      FeatureReductionRange range = m_Range;
+      for (size_t blockStart = start; blockStart < end; blockStart += Detail::k_FusedBlockSize)
+      {
+        range.start = blockStart;
+        range.end = blockStart + Detail::k_FusedBlockSize;
+        if (range.end > end) { range.end = end; }
+        for (int32_t r = 0; r < m_Reductions->size(); r++)
+        {
+          (*m_Reductions)[r]->accumulate(range, &(m_Accumulator[(*m_Offsets)[r]]));
+        }
+      }
+    }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r)
+    {
+      convert(r.begin(), r.end());
+    }
+
+    void join(const FeatureReductionImpl& rhs)
+    {
+      for (int32_t r = 0; r < m_Reductions->size(); r++)
+      {
+        size_t offset = (*m_Offsets)[r];
+        (*m_Reductions)[r]->merge(&(rhs.m_Accumulator[offset]), &(m_Accumulator[offset]), (*m_Offsets)[r + 1] - offset);
+      }
+    }
+#endif
+
+    const double* getAccumulator(int32_t reduction) const
+    {
+      return &(m_Accumulator[(*m_Offsets)[reduction]]);
+    }
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureReduction::FeatureReduction()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureReduction::~FeatureReduction()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureReduction::initialize(double* accumulator, size_t numValues) const
+{
+  std::fill(accumulator, accumulator + numValues, 0.0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureReduction::merge(const double* source, double* destination, size_t numValues) const
+{
+  for (size_t i = 0; i < numValues; i++)
+  {
+    destination[i] += source[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureReductionEngine::FeatureReductionEngine(int32_t* featureIds, size_t numCells, size_t numFeatures) :
+  m_FeatureIds(featureIds),
+  m_NumCells(numCells),
+  m_NumFeatures(numFeatures)
+{
+  m_Dims[0] = numCells;
+  m_Dims[1] = 1;
+  m_Dims[2] = 1;
+  m_Res[0] = 1.0f;
+  m_Res[1] = 1.0f;
+  m_Res[2] = 1.0f;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FeatureReductionEngine::~FeatureReductionEngine()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureReductionEngine::setDimensions(size_t dims[3], float res[3])
+{
+  for (size_t i = 0; i < 3; i++)
+  {
+    m_Dims[i] = dims[i];
+    m_Res[i] = res[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureReductionEngine::addReduction(FeatureReduction::Pointer reduction)
+{
+  m_Reductions.push_back(reduction);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FeatureReductionEngine::execute()
+{
+  if (m_Reductions.isEmpty()) { return; }
+
+  // Each reduction gets a contiguous block of numFeatures * numComponents values
+  std::vector<size_t> offsets(m_Reductions.size() + 1, 0);
+  for (int32_t r = 0; r < m_Reductions.size(); r++)
+  {
+    offsets[r + 1] = offsets[r] + m_NumFeatures * static_cast<size_t>(m_Reductions[r]->getNumberOfComponents());
+  }
+
+  FeatureReductionRange range;
+  range.featureIds = m_FeatureIds;
+  range.start = 0;
+  range.end = m_NumCells;
+  for (size_t i = 0; i < 3; i++)
+  {
+    range.dims[i] = m_Dims[i];
+    range.res[i] = m_Res[i];
+  }
+
+  FeatureReductionImpl body(&m_Reductions, &offsets, range, m_NumFeatures);
+
+  size_t grainSize = offsets.back();
+  if (grainSize < Detail::k_MinimumGrainSize) { grainSize = Detail::k_MinimumGrainSize; }
+  ParallelContext::ParallelReduce<size_t>(0, m_NumCells, body, grainSize);
+
+  for (int32_t r = 0; r < m_Reductions.size(); r++)
+  {
+    m_Reductions[r]->finalize(body.getAccumulator(r), m_NumFeatures);
+  }
+}
@@ -0,0 +1,165 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _FeatureReduction_H_
+#define _FeatureReduction_H_
+
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+
+/**
+ * @brief The FeatureReductionRange struct describes a contiguous run of cells that is handed to
+ * a FeatureReduction, along with the geometry information needed to recover the (x, y, z) index
+ * of each cell. Cells are assumed to be stored with X varying fastest.
+ */
+struct FeatureReductionRange
+{
+  const int32_t* featureIds;
+  size_t start;
+  size_t end;
+  size_t dims[3];
+  float res[3];
+};
+
+/**
+ * @brief The FeatureReduction class is the base class for any per-Feature aggregate that is built
+ * by sweeping a Feature Ids array. Each reduction owns a block of getNumberOfComponents() doubles per
+ * Feature; the FeatureReductionEngine hands every worker thread its own private block, so the
+ * accumulate(), initialize() and merge() functions must not modify the reduction itself.
+ */
+class SIMPLib_EXPORT FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureReduction)
+    SIMPL_TYPE_MACRO(FeatureReduction)
+
+    virtual ~FeatureReduction();
+
+    /**
+     * @brief getNumberOfComponents Returns the number of accumulator values needed per Feature
+     * @return
+     */
+    virtual int getNumberOfComponents() = 0;
+
+    /**
+     * @brief initialize Sets the starting value of an accumulator block. The default sets all values to zero.
+     * @param accumulator Accumulator block
+     * @param numValues Number of values (numFeatures * numComponents) in the block
+     */
+    virtual void initialize(double* accumulator, size_t numValues) const;
+
+    /**
+     * @brief accumulate Adds the contribution of every cell in the range to the accumulator block
+     * @param range Run of cells to process
+     * @param accumulator Accumulator block private to the calling thread
+     */
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const = 0;
+
+    /**
+     * @brief merge Combines the source accumulator block into the destination block. The default sums the values.
+     * @param source Accumulator block to fold in
+     * @param destination Accumulator block that receives the result
+     * @param numValues Number of values (numFeatures * numComponents) in each block
+     */
+    virtual void merge(const double* source, double* destination, size_t numValues) const;
+
+    /**
+     * @brief finalize Converts the fully merged accumulator block into the final output values
+     * @param accumulator Merged accumulator block
+     * @param numFeatures Number of Features
+     */
+    virtual void finalize(const double* accumulator, size_t numFeatures) = 0;
+
+  protected:
+    FeatureReduction();
+
+  private:
+    FeatureReduction(const FeatureReduction&); // Copy Constructor Not Implemented
+    void operator=(const FeatureReduction&); // Operator '=' Not Implemented
+};
+
+/**
+ * @brief The FeatureReductionEngine class runs any number of FeatureReduction objects over a
+ * Feature Ids array in a single sweep. When parallel algorithms are enabled, the cells are split
+ * into blocks that are reduced into per-thread accumulators, which are merged once at the end.
+ */
+class SIMPLib_EXPORT FeatureReductionEngine
+{
+  public:
+    /**
+     * @brief FeatureReductionEngine
+     * @param featureIds Feature Ids array to sweep
+     * @param numCells Number of cells in the Feature Ids array
+     * @param numFeatures Number of Features (tuples of the Feature Attribute Matrix)
+     */
+    FeatureReductionEngine(int32_t* featureIds, size_t numCells, size_t numFeatures);
+    virtual ~FeatureReductionEngine();
+
+    /**
+     * @brief setDimensions Sets the cell dimensions and resolution used to compute cell coordinates. If
+     * this is not called, the cells are treated as a single row of unit resolution.
+     * @param dims Number of cells along X, Y and Z
+     * @param res Resolution along X, Y and Z
+     */
+    void setDimensions(size_t dims[3], float res[3]);
+
+    /**
+     * @brief addReduction Registers a reduction that will be fed by the next call to execute()
+     * @param reduction
+     */
+    void addReduction(FeatureReduction::Pointer reduction);
+
+    /**
+     * @brief execute Sweeps the Feature Ids once, feeding every registered reduction, and then finalizes them
+     */
+    void execute();
+
+  private:
+    int32_t* m_FeatureIds;
+    size_t m_NumCells;
+    size_t m_NumFeatures;
+    size_t m_Dims[3];
+    float m_Res[3];
+    QVector<FeatureReduction::Pointer> m_Reductions;
+
+    FeatureReductionEngine(const FeatureReductionEngine&); // Copy Constructor Not Implemented
+    void operator=(const FeatureReductionEngine&); // Operator '=' Not Implemented
+};
+
+#endif /* _FeatureReduction_H_ */
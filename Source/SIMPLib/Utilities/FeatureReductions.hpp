@@ -0,0 +1,271 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _FeatureReductions_H_
+#define _FeatureReductions_H_
+
+#include <algorithm>
+#include <limits>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/Utilities/FeatureReduction.h"
+
+/**
+ * @brief The FeatureCountReduction class counts the number of cells belonging to each Feature
+ */
+class FeatureCountReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureCountReduction)
+    SIMPL_TYPE_MACRO_SUPER(FeatureCountReduction, FeatureReduction)
+
+    static Pointer New(int32_t* counts)
+    {
+      Pointer sharedPtr(new FeatureCountReduction(counts));
+      return sharedPtr;
+    }
+
+    virtual ~FeatureCountReduction() {}
+
+    virtual int getNumberOfComponents() { return 1; }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        accumulator[range.featureIds[i]] += 1.0;
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      for (size_t i = 0; i < numFeatures; i++)
+      {
+        m_Counts[i] = static_cast<int32_t>(accumulator[i]);
+      }
+    }
+
+  protected:
+    FeatureCountReduction(int32_t* counts) : FeatureReduction(), m_Counts(counts) {}
+
+  private:
+    int32_t* m_Counts;
+
+    FeatureCountReduction(const FeatureCountReduction&); // Copy Constructor Not Implemented
+    void operator=(const FeatureCountReduction&); // Operator '=' Not Implemented
+};
+
+/**
+ * @brief The FeatureCentroidReduction class computes the centroid of each Feature from the (x, y, z)
+ * index of its cells scaled by the resolution. Feature 0 and Features without cells are left untouched.
+ */
+class FeatureCentroidReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureCentroidReduction)
+    SIMPL_TYPE_MACRO_SUPER(FeatureCentroidReduction, FeatureReduction)
+
+    static Pointer New(float* centroids)
+    {
+      Pointer sharedPtr(new FeatureCentroidReduction(centroids));
+      return sharedPtr;
+    }
+
+    virtual ~FeatureCentroidReduction() {}
+
+    virtual int getNumberOfComponents() { return 4; }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      size_t xPoints = range.dims[0];
+      size_t xyPoints = range.dims[0] * range.dims[1];
+      size_t x = range.start % xPoints;
+      size_t y = (range.start / xPoints) % range.dims[1];
+      size_t z = range.start / xyPoints;
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        double* acc = accumulator + 4 * static_cast<size_t>(range.featureIds[i]);
+        acc[0] += 1.0;
+        acc[1] += static_cast<double>(float(x) * range.res[0]);
+        acc[2] += static_cast<double>(float(y) * range.res[1]);
+        acc[3] += static_cast<double>(float(z) * range.res[2]);
+        if (++x == xPoints)
+        {
+          x = 0;
+          if (++y == range.dims[1]) { y = 0; z++; }
+        }
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      for (size_t i = 1; i < numFeatures; i++)
+      {
+        const double* acc = accumulator + 4 * i;
+        if (acc[0] == 0.0) { continue; }
+        m_Centroids[3 * i] = static_cast<float>(acc[1] / acc[0]);
+        m_Centroids[3 * i + 1] = static_cast<float>(acc[2] / acc[0]);
+        m_Centroids[3 * i + 2] = static_cast<float>(acc[3] / acc[0]);
+      }
+    }
+
+  protected:
+    FeatureCentroidReduction(float* centroids) : FeatureReduction(), m_Centroids(centroids) {}
+
+  private:
+    float* m_Centroids;
+
+    FeatureCentroidReduction(const FeatureCentroidReduction&); // Copy Constructor Not Implemented
+    void operator=(const FeatureCentroidReduction&); // Operator '=' Not Implemented
+};
+
+/**
+ * @brief The FeatureAverageReduction class averages a single component cell array over each Feature.
+ * Feature 0 is not written and Features without cells receive an average of 0.
+ */
+template<typename T>
+class FeatureAverageReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureAverageReduction<T>)
+    SIMPL_TYPE_MACRO_SUPER(FeatureAverageReduction<T>, FeatureReduction)
+
+    static Pointer New(T* cellData, float* averages)
+    {
+      Pointer sharedPtr(new FeatureAverageReduction<T>(cellData, averages));
+      return sharedPtr;
+    }
+
+    virtual ~FeatureAverageReduction() {}
+
+    virtual int getNumberOfComponents() { return 2; }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        double* acc = accumulator + 2 * static_cast<size_t>(range.featureIds[i]);
+        acc[0] += 1.0;
+        acc[1] += static_cast<double>(m_CellData[i]);
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      for (size_t i = 1; i < numFeatures; i++)
+      {
+        const double* acc = accumulator + 2 * i;
+        if (acc[0] == 0.0) { m_Averages[i] = 0.0f; }
+        else { m_Averages[i] = static_cast<float>(acc[1] / acc[0]); }
+      }
+    }
+
+  protected:
+    FeatureAverageReduction(T* cellData, float* averages) : FeatureReduction(), m_CellData(cellData), m_Averages(averages) {}
+
+  private:
+    T* m_CellData;
+    float* m_Averages;
+
+    FeatureAverageReduction(const FeatureAverageReduction&); // Copy Constructor Not Implemented
+    void operator=(const FeatureAverageReduction&); // Operator '=' Not Implemented
+};
+
+/**
+ * @brief The FeatureCellValueReduction class copies a single component cell value to each Feature. The
+ * value is taken from the cell with the highest index in the Feature, which gives the same result as a
+ * serial "last cell wins" loop regardless of how the cells were split among threads.
+ */
+template<typename T>
+class FeatureCellValueReduction : public FeatureReduction
+{
+  public:
+    SIMPL_SHARED_POINTERS(FeatureCellValueReduction<T>)
+    SIMPL_TYPE_MACRO_SUPER(FeatureCellValueReduction<T>, FeatureReduction)
+
+    static Pointer New(T* cellData, T* featureData)
+    {
+      Pointer sharedPtr(new FeatureCellValueReduction<T>(cellData, featureData));
+      return sharedPtr;
+    }
+
+    virtual ~FeatureCellValueReduction() {}
+
+    virtual int getNumberOfComponents() { return 1; }
+
+    virtual void initialize(double* accumulator, size_t numValues) const
+    {
+      std::fill(accumulator, accumulator + numValues, -1.0);
+    }
+
+    virtual void accumulate(const FeatureReductionRange& range, double* accumulator) const
+    {
+      // Cells are visited in increasing order, so the last write is the highest index
+      for (size_t i = range.start; i < range.end; i++)
+      {
+        accumulator[range.featureIds[i]] = static_cast<double>(i);
+      }
+    }
+
+    virtual void merge(const double* source, double* destination, size_t numValues) const
+    {
+      for (size_t i = 0; i < numValues; i++)
+      {
+        if (source[i] > destination[i]) { destination[i] = source[i]; }
+      }
+    }
+
+    virtual void finalize(const double* accumulator, size_t numFeatures)
+    {
+      for (size_t i = 0; i < numFeatures; i++)
+      {
+        if (accumulator[i] < 0.0) { continue; }
+        m_FeatureData[i] = m_CellData[static_cast<size_t>(accumulator[i])];
+      }
+    }
+
+  protected:
+    FeatureCellValueReduction(T* cellData, T* featureData) : FeatureReduction(), m_CellData(cellData), m_FeatureData(featureData) {}
+
+  private:
+    T* m_CellData;
+    T* m_FeatureData;
+
+    FeatureCellValueReduction(const FeatureCellValueReduction&); // Copy Constructor Not Implemented
+    void operator=(const FeatureCellValueReduction&); // Operator '=' Not Implemented
+};
+
+#endif /* _FeatureReductions_H_ */
@@ -0,0 +1,235 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ParallelContext.h"
+
+#include <vector>
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QByteArray>
+#include <QtCore/QThreadStorage>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/atomic.h>
+#include <tbb/task_scheduler_observer.h>
+#endif
+
+#if defined(SIMPLib_USE_PARALLEL_ALGORITHMS) && defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+namespace ParallelContextDetail
+{
+  // 0 means the thread count has not been set and the environment/automatic value is used
+  static QAtomicInt s_NumberOfThreads(0);
+
+  // -1 means pinning has not been set and SIMPL_PIN_THREADS decides
+  static QAtomicInt s_PinThreads(-1);
+
+  // Thread count of the outermost Scheduler on each thread, 0 when there is none
+  static QThreadStorage<int> s_ActiveThreads;
+
+  static const char* k_NumThreadsEnvVar = "SIMPL_NUM_THREADS";
+  static const char* k_PinThreadsEnvVar = "SIMPL_PIN_THREADS";
+
+#if defined(SIMPLib_USE_PARALLEL_ALGORITHMS) && defined(__linux__)
+  /**
+   * @brief The ThreadPinningObserver class binds every TBB worker thread that joins the scheduler to
+   * the next CPU of the process affinity mask
+   */
+  class ThreadPinningObserver : public tbb::task_scheduler_observer
+  {
+    public:
+      ThreadPinningObserver()
+      {
+        m_NextCpu = 0;
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+        {
+          for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+          {
+            if (CPU_ISSET(cpu, &mask)) { m_Cpus.push_back(cpu); }
+          }
+        }
+        observe(true);
+      }
+      virtual ~ThreadPinningObserver()
+      {
+        observe(false);
+      }
+
+      virtual void on_scheduler_entry(bool isWorker)
+      {
+        if (isWorker == false || m_Cpus.empty() || ParallelContext::GetPinThreads() == false) { return; }
+        size_t slot = m_NextCpu.fetch_and_increment() % m_Cpus.size();
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(m_Cpus[slot], &mask);
+        pthread_setaffinity_np(pthread_self(), sizeof(mask), &mask);
+      }
+
+    private:
+      std::vector<int> m_Cpus;
+      tbb::atomic<size_t> m_NextCpu;
+  };
+#endif
+
+  /**
+   * @brief StartPinning Installs the pinning observer the first time it is needed
+   */
+  static void StartPinning()
+  {
+#if defined(SIMPLib_USE_PARALLEL_ALGORITHMS) && defined(__linux__)
+    static ThreadPinningObserver observer;
+#endif
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelContext::ParallelContext()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelContext::~ParallelContext()
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelContext::SetNumberOfThreads(int numThreads)
+{
+  ParallelContextDetail::s_NumberOfThreads.store(numThreads > 0 ? numThreads : 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParallelContext::GetNumberOfThreads()
+{
+  int numThreads = ParallelContextDetail::s_NumberOfThreads.load();
+  if (numThreads > 0) { return numThreads; }
+
+  bool ok = false;
+  numThreads = qgetenv(ParallelContextDetail::k_NumThreadsEnvVar).toInt(&ok);
+  if (ok == true && numThreads > 0) { return numThreads; }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  return tbb::task_scheduler_init::default_num_threads();
+#else
+  return 1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParallelContext::SetPinThreads(bool pin)
+{
+  ParallelContextDetail::s_PinThreads.store(pin ? 1 : 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParallelContext::GetPinThreads()
+{
+  int pin = ParallelContextDetail::s_PinThreads.load();
+  if (pin >= 0) { return pin == 1; }
+  return qgetenv(ParallelContextDetail::k_PinThreadsEnvVar).trimmed() == "1";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelContext::Scheduler::Scheduler(int numThreads) :
+  m_NumberOfThreads(1),
+  m_Outermost(false)
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  , m_Init(tbb::task_scheduler_init::deferred)
+#endif
+{
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  int activeThreads = ParallelContextDetail::s_ActiveThreads.hasLocalData() ? ParallelContextDetail::s_ActiveThreads.localData() : 0;
+  if (activeThreads > 0)
+  {
+    m_NumberOfThreads = activeThreads;
+  }
+  else
+  {
+    m_Outermost = true;
+    m_NumberOfThreads = (numThreads > 0) ? numThreads : ParallelContext::GetNumberOfThreads();
+    ParallelContextDetail::s_ActiveThreads.setLocalData(m_NumberOfThreads);
+    if (ParallelContext::GetPinThreads() == true) { ParallelContextDetail::StartPinning(); }
+  }
+  m_Init.initialize(m_NumberOfThreads);
+#else
+  (void)numThreads;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParallelContext::Scheduler::~Scheduler()
+{
+  if (m_Outermost == true)
+  {
+    ParallelContextDetail::s_ActiveThreads.setLocalData(0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ParallelContext::Scheduler::getNumberOfThreads() const
+{
+  return m_NumberOfThreads;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParallelContext::Scheduler::doParallel() const
+{
+  return m_NumberOfThreads > 1;
+}
@@ -0,0 +1,225 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#ifndef _ParallelContext_H_
+#define _ParallelContext_H_
+
+#include "SIMPLib/SIMPLib.h"
+
+#include <algorithm>
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_scheduler_init.h>
+#endif
+
+/**
+ * @brief The ParallelContext class controls how many threads the parallel algorithms in SIMPLib and
+ * its plugins may use, and whether the worker threads are pinned to CPUs. The thread count is taken
+ * from, in order: a pipeline's own setting, SetNumberOfThreads() (e.g. PipelineRunner --threads),
+ * the SIMPL_NUM_THREADS environment variable and finally the number of CPUs this process may run on.
+ * Setting SIMPL_PIN_THREADS to 1 turns on pinning.
+ *
+ * Loops and sorts go through ParallelFor(), ParallelReduce() and ParallelSort(), which open a Scheduler
+ * and take the serial path themselves when only one thread is available or TBB is not compiled in.
+ * Code that drives TBB in other ways creates a ParallelContext::Scheduler for the duration of the
+ * work instead of its own tbb::task_scheduler_init.
+ */
+class SIMPLib_EXPORT ParallelContext
+{
+  public:
+    virtual ~ParallelContext();
+
+    /**
+     * @brief SetNumberOfThreads Sets the process wide thread count
+     * @param numThreads Number of threads; 0 or less goes back to the environment/automatic value
+     */
+    static void SetNumberOfThreads(int numThreads);
+
+    /**
+     * @brief GetNumberOfThreads Returns the process wide thread count, always at least 1
+     * @return
+     */
+    static int GetNumberOfThreads();
+
+    /**
+     * @brief SetPinThreads Sets whether worker threads are pinned to CPUs. Each worker is bound to one
+     * CPU of the process affinity mask in turn, so a pipeline started under numactl or taskset keeps
+     * its threads on the NUMA node it was given. Pinning is only implemented on Linux.
+     * @param pin
+     */
+    static void SetPinThreads(bool pin);
+
+    /**
+     * @brief GetPinThreads Returns whether worker threads are pinned to CPUs
+     * @return
+     */
+    static bool GetPinThreads();
+
+    /**
+     * @brief The Scheduler class is the scope a parallel algorithm runs in. The first Scheduler created
+     * on a thread fixes the thread count for every Scheduler nested inside it on that thread, the same
+     * way nested tbb::task_scheduler_init objects behave. Without parallel algorithms it only reports
+     * a single thread.
+     */
+    class SIMPLib_EXPORT Scheduler
+    {
+      public:
+        /**
+         * @brief Scheduler
+         * @param numThreads Thread count to use when this is the outermost Scheduler on the thread; 0 or
+         * less uses ParallelContext::GetNumberOfThreads()
+         */
+        Scheduler(int numThreads = 0);
+        virtual ~Scheduler();
+
+        /**
+         * @brief getNumberOfThreads Returns the number of threads the algorithms in this scope run on
+         * @return
+         */
+        int getNumberOfThreads() const;
+
+        /**
+         * @brief doParallel Returns false when the scope only has one thread, in which case the serial
+         * code path should be taken
+         * @return
+         */
+        bool doParallel() const;
+
+      private:
+        int m_NumberOfThreads;
+        bool m_Outermost;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+        tbb::task_scheduler_init m_Init;
+#endif
+
+        Scheduler(const Scheduler&); // Copy Constructor Not Implemented
+        void operator=(const Scheduler&); // Operator '=' Not Implemented
+    };
+
+    /**
+     * @brief ParallelFor Runs body over the items [begin, end). With more than one thread the range is
+     * split among the threads of a Scheduler and every piece is passed to a copy of body as a
+     * tbb::blocked_range<T>; otherwise a single copy of body is called with convert(begin, end). The
+     * body therefore provides both "void convert(T begin, T end)" and, when parallel algorithms are
+     * compiled in, "void operator()(const tbb::blocked_range<T>& r) const".
+     * @param begin First item
+     * @param end One past the last item
+     * @param body The work to run
+     * @param grainSize Number of items below which a piece is not split further. A range that can not
+     * be split into two grains runs serially.
+     */
+    template<typename T, typename Body>
+    static void ParallelFor(T begin, T end, const Body& body, T grainSize = 1)
+    {
+      if (end <= begin) { return; }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (end - begin >= 2 * grainSize)
+      {
+        Scheduler scheduler;
+        if (scheduler.doParallel() == true)
+        {
+          tbb::parallel_for(tbb::blocked_range<T>(begin, end, grainSize), body, tbb::auto_partitioner());
+          return;
+        }
+      }
+#endif
+      Body serial(body);
+      serial.convert(begin, end);
+    }
+
+    /**
+     * @brief ParallelReduce Runs body over the items [begin, end) and leaves the combined result in
+     * body. With more than one thread this is tbb::parallel_reduce over a tbb::blocked_range<T>, so the
+     * body provides a splitting constructor, join() and operator()(const tbb::blocked_range<T>&);
+     * otherwise body itself is called once with convert(begin, end).
+     * @param begin First item
+     * @param end One past the last item
+     * @param body The work to run, which receives the result
+     * @param grainSize Number of items below which a piece is not split further. A range that can not
+     * be split into two grains runs serially.
+     */
+    template<typename T, typename Body>
+    static void ParallelReduce(T begin, T end, Body& body, T grainSize = 1)
+    {
+      if (end <= begin) { return; }
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      if (end - begin >= 2 * grainSize)
+      {
+        Scheduler scheduler;
+        if (scheduler.doParallel() == true)
+        {
+          tbb::parallel_reduce(tbb::blocked_range<T>(begin, end, grainSize), body, tbb::auto_partitioner());
+          return;
+        }
+      }
+#endif
+      body.convert(begin, end);
+    }
+
+    /**
+     * @brief ParallelSort Sorts [begin, end) with comp, using tbb::parallel_sort when a Scheduler has
+     * more than one thread and std::sort otherwise. Like both of those the sort is not stable.
+     * @param begin Random access iterator to the first item
+     * @param end Random access iterator one past the last item
+     * @param comp Strict weak ordering of the items
+     */
+    template<typename Iterator, typename Compare>
+    static void ParallelSort(Iterator begin, Iterator end, const Compare& comp)
+    {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      Scheduler scheduler;
+      if (scheduler.doParallel() == true)
+      {
+        tbb::parallel_sort(begin, end, comp);
+        return;
+      }
+#endif
+      std::sort(begin, end, comp);
+    }
+
+  protected:
+    ParallelContext();
+
+  private:
+    ParallelContext(const ParallelContext&); // Copy Constructor Not Implemented
+    void operator=(const ParallelContext&); // Operator '=' Not Implemented
+};
+
+#endif /* _ParallelContext_H_ */
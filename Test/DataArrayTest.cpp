@@ -171,6 +171,96 @@ void TestReorderCopy()
   __TestReorderCopy<double>();
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template<typename T>
+void __TestGatherScatter()
+{
+  size_t numTuples = 10;
+  QVector<size_t> cDims(1, 3);
+  QString name("Source Array");
+
+  typename DataArray<T>::Pointer src = DataArray<T>::CreateArray(numTuples, cDims, name, true);
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    for(size_t j = 0; j < cDims[0]; j++)
+    {
+      src->setComponent(i, j, static_cast<T>(i * cDims[0] + j + 1) );
+    }
+  }
+
+  // An entry past the end of the source must return a null pointer
+  IDataArray::IndexMap badMap(4, 0);
+  badMap[2] = numTuples;
+  DREAM3D_REQUIRE_EQUAL(src->gather(badMap).get(), 0);
+
+  // A contiguous run, a repeated tuple, a missing tuple and a backwards run
+  IDataArray::IndexMap map;
+  map.push_back(2);
+  map.push_back(3);
+  map.push_back(4);
+  map.push_back(4);
+  map.push_back(-1);
+  map.push_back(9);
+  map.push_back(8);
+  typename DataArray<T>::Pointer copy = boost::dynamic_pointer_cast<DataArray<T> >(src->gather(map));
+  DREAM3D_REQUIRE_NE(copy.get(), 0);
+  DREAM3D_REQUIRED(copy->getNumberOfTuples(), ==, map.size() );
+  DREAM3D_REQUIRED(copy->getNumberOfComponents(), ==, src->getNumberOfComponents() );
+  for(size_t i = 0; i < map.size(); i++)
+  {
+    for(size_t j = 0; j < cDims[0]; j++)
+    {
+      T expected = (map[i] < 0) ? static_cast<T>(0) : src->getComponent(map[i], j);
+      DREAM3D_REQUIRE_EQUAL(copy->getComponent(i, j), expected)
+    }
+  }
+
+  // Scatter the gathered tuples back into a zeroed array
+  typename DataArray<T>::Pointer dest = DataArray<T>::CreateArray(numTuples, cDims, name, true);
+  dest->initializeWithZeros();
+  IDataArray::IndexMap scatterMap(map.size(), -1);
+  scatterMap[0] = 2;
+  scatterMap[1] = 3;
+  scatterMap[2] = 4;
+  scatterMap[5] = 9;
+  scatterMap[6] = 8;
+  bool ok = dest->scatter(scatterMap, copy);
+  DREAM3D_REQUIRE_EQUAL(ok, true)
+  for(size_t i = 0; i < numTuples; i++)
+  {
+    bool written = (i == 2 || i == 3 || i == 4 || i == 8 || i == 9);
+    for(size_t j = 0; j < cDims[0]; j++)
+    {
+      T expected = written ? src->getComponent(i, j) : static_cast<T>(0);
+      DREAM3D_REQUIRE_EQUAL(dest->getComponent(i, j), expected)
+    }
+  }
+
+  // The map must have one entry per source tuple
+  IDataArray::IndexMap shortMap(2, 0);
+  ok = dest->scatter(shortMap, copy);
+  DREAM3D_REQUIRE_EQUAL(ok, false)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestGatherScatter()
+{
+  __TestGatherScatter<int8_t>();
+  __TestGatherScatter<uint8_t>();
+  __TestGatherScatter<int16_t>();
+  __TestGatherScatter<uint16_t>();
+  __TestGatherScatter<int32_t>();
+  __TestGatherScatter<uint32_t>();
+  __TestGatherScatter<int64_t>();
+  __TestGatherScatter<uint64_t>();
+  __TestGatherScatter<float>();
+  __TestGatherScatter<double>();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1073,6 +1163,7 @@ void TestCopyData()
     DREAM3D_REGISTER_TEST( TestDeepCopyArray() )
     DREAM3D_REGISTER_TEST( TestNeighborList() )
     DREAM3D_REGISTER_TEST( TestReorderCopy() )
+    DREAM3D_REGISTER_TEST( TestGatherScatter() )
 
 
 #if REMOVE_TEST_FILES
@@ -0,0 +1,209 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Utilities/FeatureReduction.h"
+#include "SIMPLib/Utilities/FeatureReductions.hpp"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+namespace
+{
+  const size_t k_XPoints = 37;
+  const size_t k_YPoints = 29;
+  const size_t k_ZPoints = 23;
+  const size_t k_NumFeatures = 50;
+
+  /**
+   * @brief The ReductionData struct holds a small volume of Feature Ids with a phase and a scalar
+   * value per cell. Feature ids are handed out in blocks so that every Feature spans several threads'
+   * ranges, and the last Feature is left without cells.
+   */
+  struct ReductionData
+  {
+    size_t dims[3];
+    float res[3];
+    std::vector<int32_t> featureIds;
+    std::vector<int32_t> phases;
+    std::vector<float> values;
+
+    ReductionData()
+    {
+      dims[0] = k_XPoints;
+      dims[1] = k_YPoints;
+      dims[2] = k_ZPoints;
+      res[0] = 0.25f;
+      res[1] = 0.5f;
+      res[2] = 1.5f;
+      size_t numCells = dims[0] * dims[1] * dims[2];
+      featureIds.resize(numCells);
+      phases.resize(numCells);
+      values.resize(numCells);
+      srand(1234);
+      for (size_t i = 0; i < numCells; i++)
+      {
+        featureIds[i] = static_cast<int32_t>(((i / 61) * 7 + rand() % 3) % (k_NumFeatures - 1));
+        phases[i] = 1 + featureIds[i] % 3;
+        values[i] = static_cast<float>(rand() % 1000) * 0.01f - 3.0f;
+      }
+    }
+  };
+}
+
+// -----------------------------------------------------------------------------
+// Runs the reductions on the engine and compares them against the serial
+// per-Feature loops they replaced
+// -----------------------------------------------------------------------------
+void TestReductionsMatchSerialLoops(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  ReductionData data;
+  size_t numCells = data.featureIds.size();
+
+  std::vector<int32_t> counts(k_NumFeatures, 0);
+  std::vector<float> centroids(3 * k_NumFeatures, 0.0f);
+  std::vector<float> averages(k_NumFeatures, 0.0f);
+  std::vector<int32_t> featurePhases(k_NumFeatures, 0);
+
+  FeatureReductionEngine engine(&(data.featureIds.front()), numCells, k_NumFeatures);
+  engine.setDimensions(data.dims, data.res);
+  engine.addReduction(FeatureCountReduction::New(&(counts.front())));
+  engine.addReduction(FeatureCentroidReduction::New(&(centroids.front())));
+  engine.addReduction(FeatureAverageReduction<float>::New(&(data.values.front()), &(averages.front())));
+  engine.addReduction(FeatureCellValueReduction<int32_t>::New(&(data.phases.front()), &(featurePhases.front())));
+  engine.execute();
+
+  // The serial loops from FindSizes, FindFeatureCentroids, FindAvgScalarValueForFeatures and FindFeaturePhases
+  std::vector<float> serialCounts(k_NumFeatures, 0.0f);
+  std::vector<float> serialCenters(5 * k_NumFeatures, 0.0f);
+  std::vector<float> serialAverages(k_NumFeatures, 0.0f);
+  std::vector<int32_t> serialPhases(k_NumFeatures, 0);
+  for (size_t i = 0; i < data.dims[2]; i++)
+  {
+    for (size_t j = 0; j < data.dims[1]; j++)
+    {
+      for (size_t k = 0; k < data.dims[0]; k++)
+      {
+        size_t index = (i * data.dims[1] + j) * data.dims[0] + k;
+        int32_t gnum = data.featureIds[index];
+        serialCounts[gnum]++;
+        serialCenters[gnum * 5 + 0]++;
+        serialCenters[gnum * 5 + 1] += float(k) * data.res[0];
+        serialCenters[gnum * 5 + 2] += float(j) * data.res[1];
+        serialCenters[gnum * 5 + 3] += float(i) * data.res[2];
+        serialAverages[gnum] += data.values[index];
+        serialPhases[gnum] = data.phases[index];
+      }
+    }
+  }
+
+  for (size_t i = 1; i < k_NumFeatures; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(counts[i], static_cast<int32_t>(serialCounts[i]))
+    DREAM3D_REQUIRE_EQUAL(featurePhases[i], serialPhases[i])
+    if (serialCounts[i] == 0.0f)
+    {
+      DREAM3D_REQUIRE_EQUAL(averages[i], 0.0f)
+      continue;
+    }
+    // The serial loops accumulate in float, the engine in double
+    for (size_t c = 0; c < 3; c++)
+    {
+      float expected = serialCenters[i * 5 + 1 + c] / serialCenters[i * 5 + 0];
+      DREAM3D_REQUIRE(std::fabs(centroids[3 * i + c] - expected) <= 1.0e-4f * std::max(1.0f, std::fabs(expected)))
+    }
+    float expected = serialAverages[i] / serialCounts[i];
+    DREAM3D_REQUIRE(std::fabs(averages[i] - expected) <= 1.0e-4f * std::max(1.0f, std::fabs(expected)))
+  }
+  DREAM3D_REQUIRE_EQUAL(counts[k_NumFeatures - 1], 0)
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+// The result must not depend on how many threads the cells are split over
+// -----------------------------------------------------------------------------
+void TestThreadCountIndependence()
+{
+  ReductionData data;
+  size_t numCells = data.featureIds.size();
+  std::vector<float> averages[2];
+  std::vector<float> centroids[2];
+  int threads[2] = { 1, 8 };
+  for (int t = 0; t < 2; t++)
+  {
+    ParallelContext::SetNumberOfThreads(threads[t]);
+    averages[t].assign(k_NumFeatures, 0.0f);
+    centroids[t].assign(3 * k_NumFeatures, 0.0f);
+    FeatureReductionEngine engine(&(data.featureIds.front()), numCells, k_NumFeatures);
+    engine.setDimensions(data.dims, data.res);
+    engine.addReduction(FeatureCentroidReduction::New(&(centroids[t].front())));
+    engine.addReduction(FeatureAverageReduction<float>::New(&(data.values.front()), &(averages[t].front())));
+    engine.execute();
+  }
+  ParallelContext::SetNumberOfThreads(0);
+
+  for (size_t i = 1; i < k_NumFeatures; i++)
+  {
+    DREAM3D_COMPARE_FLOATS(averages[0][i], averages[1][i], 4)
+    for (size_t c = 0; c < 3; c++)
+    {
+      DREAM3D_COMPARE_FLOATS(centroids[0][3 * i + c], centroids[1][3 * i + c], 4)
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestReductionsMatchSerialLoops(1) )
+  DREAM3D_REGISTER_TEST( TestReductionsMatchSerialLoops(4) )
+  DREAM3D_REGISTER_TEST( TestThreadCountIndependence() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,235 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataArrays/StringDataArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+namespace
+{
+  const size_t k_XPoints = 250;
+  const size_t k_YPoints = 200;
+  const size_t k_NumTuples = k_XPoints * k_YPoints;
+
+  /**
+   * @brief Builds a Cell Attribute Matrix holding arrays of every tuple size the gather kernels
+   * special case, a NeighborList and a StringDataArray. Every value encodes its tuple index.
+   */
+  AttributeMatrix::Pointer createCellMatrix()
+  {
+    QVector<size_t> tDims(2, 0);
+    tDims[0] = k_XPoints;
+    tDims[1] = k_YPoints;
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellAttributeMatrixName, DREAM3D::AttributeMatrixType::Cell);
+
+    QVector<size_t> cDims(1, 3);
+    Int32ArrayType::Pointer ints = Int32ArrayType::CreateArray(k_NumTuples, cDims, "Ints");
+    FloatArrayType::Pointer floats = FloatArrayType::CreateArray(k_NumTuples, "Floats");
+    UInt8ArrayType::Pointer bytes = UInt8ArrayType::CreateArray(k_NumTuples, "Bytes");
+    cDims[0] = 2;
+    DoubleArrayType::Pointer doubles = DoubleArrayType::CreateArray(k_NumTuples, cDims, "Doubles");
+    NeighborList<float>::Pointer lists = NeighborList<float>::CreateArray(k_NumTuples, "Lists");
+    StringDataArray::Pointer strings = StringDataArray::CreateArray(k_NumTuples, "Strings");
+
+    for (size_t i = 0; i < k_NumTuples; i++)
+    {
+      for (int k = 0; k < 3; k++) { ints->setComponent(i, k, static_cast<int32_t>(3 * i + k + 1)); }
+      floats->setValue(i, 0.5f * (i + 1));
+      bytes->setValue(i, static_cast<uint8_t>(i % 255 + 1));
+      doubles->setComponent(i, 0, 0.25 * (i + 1));
+      doubles->setComponent(i, 1, -0.25 * (i + 1));
+      lists->getListReference(static_cast<int>(i)).assign(i % 4, static_cast<float>(i));
+      strings->setValue(i, QString::number(i));
+    }
+
+    am->addAttributeArray(ints->getName(), ints);
+    am->addAttributeArray(floats->getName(), floats);
+    am->addAttributeArray(bytes->getName(), bytes);
+    am->addAttributeArray(doubles->getName(), doubles);
+    am->addAttributeArray(lists->getName(), lists);
+    am->addAttributeArray(strings->getName(), strings);
+    return am;
+  }
+
+  /**
+   * @brief Builds a map that shifts and crops the cells, so most of it is runs of consecutive
+   * tuples, with every 7th entry pointing at an arbitrary tuple and every 11th entry left empty
+   */
+  IDataArray::IndexMap createMap(size_t numTuples)
+  {
+    IDataArray::IndexMap map(numTuples, 0);
+    for (size_t i = 0; i < numTuples; i++)
+    {
+      map[i] = static_cast<int64_t>((i + 1234) % k_NumTuples);
+      if (i % 7 == 3) { map[i] = static_cast<int64_t>((i * 7919) % k_NumTuples); }
+      if (i % 11 == 5) { map[i] = -1; }
+    }
+    return map;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestGatherAttributeArrays(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  AttributeMatrix::Pointer am = createCellMatrix();
+  QVector<size_t> tDims(2, 0);
+  tDims[0] = 180;
+  tDims[1] = 150;
+  size_t numTuples = tDims[0] * tDims[1];
+  IDataArray::IndexMap map = createMap(numTuples);
+
+  DREAM3D_REQUIRE_EQUAL(am->gatherAttributeArrays(map, tDims), true)
+  DREAM3D_REQUIRE(am->getTupleDimensions() == tDims)
+  DREAM3D_REQUIRE_EQUAL(am->getNumTuples(), numTuples)
+
+  Int32ArrayType::Pointer ints = am->getAttributeArrayAs<Int32ArrayType>("Ints");
+  FloatArrayType::Pointer floats = am->getAttributeArrayAs<FloatArrayType>("Floats");
+  UInt8ArrayType::Pointer bytes = am->getAttributeArrayAs<UInt8ArrayType>("Bytes");
+  DoubleArrayType::Pointer doubles = am->getAttributeArrayAs<DoubleArrayType>("Doubles");
+  NeighborList<float>::Pointer lists = am->getAttributeArrayAs<NeighborList<float> >("Lists");
+  StringDataArray::Pointer strings = am->getAttributeArrayAs<StringDataArray>("Strings");
+  DREAM3D_REQUIRE_VALID_POINTER(ints.get())
+  DREAM3D_REQUIRE_VALID_POINTER(floats.get())
+  DREAM3D_REQUIRE_VALID_POINTER(bytes.get())
+  DREAM3D_REQUIRE_VALID_POINTER(doubles.get())
+  DREAM3D_REQUIRE_VALID_POINTER(lists.get())
+  DREAM3D_REQUIRE_VALID_POINTER(strings.get())
+  DREAM3D_REQUIRE_EQUAL(ints->getNumberOfTuples(), numTuples)
+  DREAM3D_REQUIRE_EQUAL(ints->getNumberOfComponents(), 3)
+  DREAM3D_REQUIRE_EQUAL(doubles->getNumberOfComponents(), 2)
+  DREAM3D_REQUIRE_EQUAL(lists->getNumberOfTuples(), numTuples)
+  DREAM3D_REQUIRE_EQUAL(strings->getNumberOfTuples(), numTuples)
+
+  for (size_t i = 0; i < numTuples; i++)
+  {
+    if (map[i] < 0)
+    {
+      // Tuples without a source are set to zero
+      for (int k = 0; k < 3; k++) { DREAM3D_REQUIRE_EQUAL(ints->getComponent(i, k), 0) }
+      DREAM3D_REQUIRE_EQUAL(floats->getValue(i), 0.0f)
+      DREAM3D_REQUIRE_EQUAL(bytes->getValue(i), 0)
+      DREAM3D_REQUIRE_EQUAL(doubles->getComponent(i, 0), 0.0)
+      DREAM3D_REQUIRE_EQUAL(doubles->getComponent(i, 1), 0.0)
+      continue;
+    }
+    size_t src = static_cast<size_t>(map[i]);
+    for (int k = 0; k < 3; k++) { DREAM3D_REQUIRE_EQUAL(ints->getComponent(i, k), static_cast<int32_t>(3 * src + k + 1)) }
+    DREAM3D_REQUIRE_EQUAL(floats->getValue(i), 0.5f * (src + 1))
+    DREAM3D_REQUIRE_EQUAL(bytes->getValue(i), static_cast<uint8_t>(src % 255 + 1))
+    DREAM3D_REQUIRE_EQUAL(doubles->getComponent(i, 0), 0.25 * (src + 1))
+    DREAM3D_REQUIRE_EQUAL(doubles->getComponent(i, 1), -0.25 * (src + 1))
+    DREAM3D_REQUIRE(lists->getListReference(static_cast<int>(i)) == std::vector<float>(src % 4, static_cast<float>(src)))
+    DREAM3D_REQUIRE_EQUAL(strings->getValue(i), QString::number(src))
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestFailedGatherLeavesMatrixUnchanged(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  AttributeMatrix::Pointer am = createCellMatrix();
+  QVector<size_t> oldDims = am->getTupleDimensions();
+
+  // An array that is shorter than the matrix can not be gathered through a map that reaches its end.
+  // Its name sorts after the others, so the check has to happen before the first array is replaced.
+  Int64ArrayType::Pointer shortArray = Int64ArrayType::CreateArray(k_NumTuples, "ZShort");
+  shortArray->initializeWithValue(7);
+  am->addAttributeArray(shortArray->getName(), shortArray);
+  shortArray->resize(k_NumTuples / 2);
+
+  QList<QString> names = am->getAttributeArrayNames();
+  QVector<IDataArray::Pointer> oldArrays;
+  for (QList<QString>::iterator iter = names.begin(); iter != names.end(); ++iter)
+  {
+    oldArrays.push_back(am->getAttributeArray(*iter));
+  }
+
+  QVector<size_t> tDims(1, k_NumTuples);
+  IDataArray::IndexMap map(k_NumTuples, 0);
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    map[i] = static_cast<int64_t>(k_NumTuples - 1 - i);
+  }
+
+  DREAM3D_REQUIRE_EQUAL(am->gatherAttributeArrays(map, tDims), false)
+  DREAM3D_REQUIRE(am->getTupleDimensions() == oldDims)
+  DREAM3D_REQUIRE(am->getAttributeArrayNames() == names)
+  for (int i = 0; i < names.size(); i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(am->getAttributeArray(names[i]).get(), oldArrays[i].get())
+  }
+  FloatArrayType::Pointer floats = am->getAttributeArrayAs<FloatArrayType>("Floats");
+  for (size_t i = 0; i < k_NumTuples; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(floats->getValue(i), 0.5f * (i + 1))
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestGatherAttributeArrays(1) )
+  DREAM3D_REGISTER_TEST( TestGatherAttributeArrays(4) )
+  DREAM3D_REGISTER_TEST( TestFailedGatherLeavesMatrixUnchanged(1) )
+  DREAM3D_REGISTER_TEST( TestFailedGatherLeavesMatrixUnchanged(4) )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
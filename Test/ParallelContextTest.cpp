@@ -0,0 +1,283 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/AbstractFilter.h"
+#include "SIMPLib/Common/FilterPipeline.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+namespace
+{
+  const char* k_NumThreadsEnvVar = "SIMPL_NUM_THREADS";
+
+  /**
+   * @brief The ThreadCountFilter class records how many threads a Scheduler opened inside its execute() gets
+   */
+  class ThreadCountFilter : public AbstractFilter
+  {
+    public:
+      SIMPL_SHARED_POINTERS(ThreadCountFilter)
+      SIMPL_STATIC_NEW_MACRO(ThreadCountFilter)
+
+      virtual ~ThreadCountFilter() {}
+
+      virtual void execute()
+      {
+        ParallelContext::Scheduler scheduler;
+        m_NumberOfThreads = scheduler.getNumberOfThreads();
+      }
+
+      int m_NumberOfThreads;
+
+    protected:
+      ThreadCountFilter() : AbstractFilter(), m_NumberOfThreads(0) {}
+  };
+
+  /**
+   * @brief The SquareImpl class squares each index into an array
+   */
+  class SquareImpl
+  {
+      int64_t* m_Values;
+
+    public:
+      SquareImpl(int64_t* values) : m_Values(values) {}
+      virtual ~SquareImpl() {}
+
+      void convert(size_t start, size_t end) const
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          m_Values[i] = static_cast<int64_t>(i * i);
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r) const
+      {
+        convert(r.begin(), r.end());
+      }
+#endif
+  };
+
+  /**
+   * @brief The SumImpl class sums the indices of a range
+   */
+  class SumImpl
+  {
+    public:
+      int64_t m_Sum;
+
+      SumImpl() : m_Sum(0) {}
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      SumImpl(SumImpl& other, tbb::split) : m_Sum(0) {}
+#endif
+      virtual ~SumImpl() {}
+
+      void convert(size_t start, size_t end)
+      {
+        for (size_t i = start; i < end; i++)
+        {
+          m_Sum += static_cast<int64_t>(i);
+        }
+      }
+
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+      void operator()(const tbb::blocked_range<size_t>& r)
+      {
+        convert(r.begin(), r.end());
+      }
+
+      void join(const SumImpl& rhs)
+      {
+        m_Sum += rhs.m_Sum;
+      }
+#endif
+  };
+
+  /**
+   * @brief defaultNumberOfThreads Returns the thread count used when nothing else sets one
+   */
+  int defaultNumberOfThreads()
+  {
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    return tbb::task_scheduler_init::default_num_threads();
+#else
+    return 1;
+#endif
+  }
+}
+
+// -----------------------------------------------------------------------------
+// A pipeline's own count beats SetNumberOfThreads(), which beats SIMPL_NUM_THREADS, which beats the
+// TBB default
+// -----------------------------------------------------------------------------
+void TestThreadCountPrecedence()
+{
+  QByteArray savedEnv = qgetenv(k_NumThreadsEnvVar);
+  qunsetenv(k_NumThreadsEnvVar);
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), defaultNumberOfThreads())
+
+  // Values that are not a positive count are ignored
+  qputenv(k_NumThreadsEnvVar, "none");
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), defaultNumberOfThreads())
+  qputenv(k_NumThreadsEnvVar, "0");
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), defaultNumberOfThreads())
+
+  qputenv(k_NumThreadsEnvVar, "3");
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), 3)
+
+  ParallelContext::SetNumberOfThreads(2);
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), 2)
+
+  FilterPipeline::Pointer pipeline = FilterPipeline::New();
+  ThreadCountFilter::Pointer filter = ThreadCountFilter::New();
+  pipeline->pushBack(filter);
+
+  // Without a count of its own the pipeline uses the process wide count
+  pipeline->execute();
+  int expected = 2;
+#ifndef SIMPLib_USE_PARALLEL_ALGORITHMS
+  expected = 1;
+#endif
+  DREAM3D_REQUIRE_EQUAL(filter->m_NumberOfThreads, expected)
+
+  pipeline->setNumberOfThreads(5);
+  pipeline->execute();
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+  expected = 5;
+#endif
+  DREAM3D_REQUIRE_EQUAL(filter->m_NumberOfThreads, expected)
+  // The pipeline's count only applies while it runs
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), 2)
+
+  ParallelContext::SetNumberOfThreads(0);
+  DREAM3D_REQUIRE_EQUAL(ParallelContext::GetNumberOfThreads(), 3)
+
+  if (savedEnv.isEmpty()) { qunsetenv(k_NumThreadsEnvVar); }
+  else { qputenv(k_NumThreadsEnvVar, savedEnv); }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestNestedSchedulers()
+{
+  ParallelContext::SetNumberOfThreads(2);
+  {
+    ParallelContext::Scheduler outer(3);
+    ParallelContext::Scheduler inner(4);
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    DREAM3D_REQUIRE_EQUAL(outer.getNumberOfThreads(), 3)
+    DREAM3D_REQUIRE_EQUAL(inner.getNumberOfThreads(), 3)
+#else
+    DREAM3D_REQUIRE_EQUAL(inner.getNumberOfThreads(), 1)
+#endif
+  }
+  {
+    ParallelContext::Scheduler scheduler;
+#ifdef SIMPLib_USE_PARALLEL_ALGORITHMS
+    DREAM3D_REQUIRE_EQUAL(scheduler.getNumberOfThreads(), 2)
+    DREAM3D_REQUIRE_EQUAL(scheduler.doParallel(), true)
+#else
+    DREAM3D_REQUIRE_EQUAL(scheduler.doParallel(), false)
+#endif
+  }
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestParallelAlgorithms(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  const size_t numValues = 100000;
+  std::vector<int64_t> values(numValues, -1);
+  ParallelContext::ParallelFor<size_t>(0, numValues, SquareImpl(&(values.front())), 64);
+  for (size_t i = 0; i < numValues; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(values[i], static_cast<int64_t>(i * i))
+  }
+
+  // An empty range does not call the body
+  values[0] = -1;
+  ParallelContext::ParallelFor<size_t>(0, 0, SquareImpl(&(values.front())));
+  DREAM3D_REQUIRE_EQUAL(values[0], -1)
+
+  SumImpl sum;
+  ParallelContext::ParallelReduce<size_t>(10, numValues, sum, 64);
+  int64_t expectedSum = static_cast<int64_t>(numValues - 1) * static_cast<int64_t>(numValues) / 2 - 45;
+  DREAM3D_REQUIRE_EQUAL(sum.m_Sum, expectedSum)
+
+  std::vector<int64_t> reversed(numValues);
+  for (size_t i = 0; i < numValues; i++)
+  {
+    reversed[i] = static_cast<int64_t>((i * 7919) % numValues);
+  }
+  ParallelContext::ParallelSort(reversed.begin(), reversed.end(), std::less<int64_t>());
+  for (size_t i = 0; i < numValues; i++)
+  {
+    DREAM3D_REQUIRE_EQUAL(reversed[i], static_cast<int64_t>(i))
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestThreadCountPrecedence() )
+  DREAM3D_REGISTER_TEST( TestNestedSchedulers() )
+  DREAM3D_REGISTER_TEST( TestParallelAlgorithms(1) )
+  DREAM3D_REGISTER_TEST( TestParallelAlgorithms(4) )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
@@ -0,0 +1,335 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Math/PointGrid.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+namespace
+{
+  /**
+   * @brief randomCoord Returns a coordinate between low and high on a 0.01 step
+   */
+  float randomCoord(float low, float high)
+  {
+    int steps = static_cast<int>((high - low) * 100.0f);
+    return low + static_cast<float>(rand() % (steps + 1)) * 0.01f;
+  }
+
+  /**
+   * @brief createPoints Creates random points in a cube. Point 0 plays the part of Feature 0 and is
+   * placed in the middle of the cube, where every query would find it if the grid did not skip it.
+   */
+  std::vector<float> createPoints(size_t numPoints, float size)
+  {
+    std::vector<float> coords(3 * numPoints, 0.0f);
+    for (size_t i = 0; i < 3 * numPoints; i++)
+    {
+      coords[i] = randomCoord(0.0f, size);
+    }
+    if (numPoints > 0)
+    {
+      coords[0] = coords[1] = coords[2] = 0.5f * size;
+    }
+    return coords;
+  }
+
+  bool insideBox(const float* point, const float boxMin[3], const float boxMax[3])
+  {
+    for (size_t k = 0; k < 3; k++)
+    {
+      if (point[k] < boxMin[k] || point[k] > boxMax[k]) { return false; }
+    }
+    return true;
+  }
+
+  /**
+   * @brief checkBoxQuery Compares the exact box test applied to the grid candidates against the
+   * same test applied to every point. The candidates must also be unique, skip the points before
+   * firstPoint and lie in cells that overlap the box.
+   */
+  void checkBoxQuery(const PointGrid& grid, const std::vector<float>& coords, size_t firstPoint, const float boxMin[3], const float boxMax[3])
+  {
+    size_t numPoints = coords.size() / 3;
+    std::vector<size_t> candidates;
+    grid.findCandidatesInBox(boxMin, boxMax, candidates);
+
+    std::vector<size_t> sorted(candidates);
+    std::sort(sorted.begin(), sorted.end());
+    DREAM3D_REQUIRE(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end())
+
+    float slack = 1.01f * grid.getCellSize();
+    std::vector<size_t> found;
+    for (size_t n = 0; n < sorted.size(); n++)
+    {
+      size_t i = sorted[n];
+      DREAM3D_REQUIRED(i, >=, firstPoint)
+      DREAM3D_REQUIRED(i, <, numPoints)
+      for (size_t k = 0; k < 3; k++)
+      {
+        DREAM3D_REQUIRED(coords[3 * i + k], >=, boxMin[k] - slack)
+        DREAM3D_REQUIRED(coords[3 * i + k], <=, boxMax[k] + slack)
+      }
+      if (insideBox(&(coords[3 * i]), boxMin, boxMax)) { found.push_back(i); }
+    }
+
+    std::vector<size_t> expected;
+    for (size_t i = firstPoint; i < numPoints; i++)
+    {
+      if (insideBox(&(coords[3 * i]), boxMin, boxMax)) { expected.push_back(i); }
+    }
+    DREAM3D_REQUIRE_EQUAL(found.size(), expected.size())
+    DREAM3D_REQUIRE(found == expected)
+  }
+
+  /**
+   * @brief checkRandomBoxes Runs boxes of many sizes, including boxes that hang over the edges of the
+   * points, boxes that miss them entirely and a box far larger than the grid
+   */
+  void checkRandomBoxes(const PointGrid& grid, const std::vector<float>& coords, size_t firstPoint, float size, size_t numBoxes)
+  {
+    for (size_t b = 0; b < numBoxes; b++)
+    {
+      float boxMin[3] = { 0.0f, 0.0f, 0.0f };
+      float boxMax[3] = { 0.0f, 0.0f, 0.0f };
+      for (size_t k = 0; k < 3; k++)
+      {
+        float center = randomCoord(-0.25f * size, 1.25f * size);
+        float halfWidth = randomCoord(0.0f, 0.3f * size);
+        boxMin[k] = center - halfWidth;
+        boxMax[k] = center + halfWidth;
+      }
+      checkBoxQuery(grid, coords, firstPoint, boxMin, boxMax);
+    }
+
+    float outsideMin[3] = { 2.0f * size + 1.0f, 0.0f, 0.0f };
+    float outsideMax[3] = { 3.0f * size + 1.0f, size, size };
+    checkBoxQuery(grid, coords, firstPoint, outsideMin, outsideMax);
+
+    float belowMin[3] = { 0.0f, 0.0f, -3.0f * size - 1.0f };
+    float belowMax[3] = { size, size, -2.0f * size - 1.0f };
+    checkBoxQuery(grid, coords, firstPoint, belowMin, belowMax);
+
+    float hugeMin[3] = { -1.0e30f, -1.0e30f, -1.0e30f };
+    float hugeMax[3] = { 1.0e30f, 1.0e30f, 1.0e30f };
+    checkBoxQuery(grid, coords, firstPoint, hugeMin, hugeMax);
+
+    // A box turned inside out contains nothing
+    float invertedMin[3] = { size, size, size };
+    float invertedMax[3] = { 0.0f, 0.0f, 0.0f };
+    std::vector<size_t> candidates;
+    grid.findCandidatesInBox(invertedMin, invertedMax, candidates);
+    DREAM3D_REQUIRE_EQUAL(candidates.size(), 0)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestBoxQueries(int numThreads, size_t numPoints)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+  srand(5489);
+
+  float size = 100.0f;
+  std::vector<float> coords = createPoints(numPoints, size);
+  PointGrid grid(&(coords.front()), numPoints, 1, 5.0f);
+  DREAM3D_REQUIRED(grid.getCellSize(), >=, 5.0f)
+  checkRandomBoxes(grid, coords, 1, size, 200);
+
+  // Without skipping point 0 the grid must return it as well
+  PointGrid allGrid(&(coords.front()), numPoints, 0, 5.0f);
+  checkRandomBoxes(allGrid, coords, 0, size, 50);
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestNeighborSearch(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+  srand(1234);
+
+  // Search around every point the way FindNeighborhoods does: box candidates, then an exact distance test
+  size_t numPoints = 2000;
+  float size = 50.0f;
+  float radius = 4.0f;
+  float radiusSquared = radius * radius;
+  std::vector<float> coords = createPoints(numPoints, size);
+  PointGrid grid(&(coords.front()), numPoints, 1, radius);
+
+  std::vector<size_t> candidates;
+  for (size_t i = 1; i < numPoints; i++)
+  {
+    const float* center = &(coords[3 * i]);
+    float boxMin[3] = { center[0] - radius, center[1] - radius, center[2] - radius };
+    float boxMax[3] = { center[0] + radius, center[1] + radius, center[2] + radius };
+    candidates.clear();
+    grid.findCandidatesInBox(boxMin, boxMax, candidates);
+
+    std::vector<size_t> found;
+    for (size_t n = 0; n < candidates.size(); n++)
+    {
+      const float* other = &(coords[3 * candidates[n]]);
+      float dx = other[0] - center[0];
+      float dy = other[1] - center[1];
+      float dz = other[2] - center[2];
+      if (candidates[n] != i && dx * dx + dy * dy + dz * dz <= radiusSquared) { found.push_back(candidates[n]); }
+    }
+    std::sort(found.begin(), found.end());
+
+    std::vector<size_t> expected;
+    for (size_t j = 1; j < numPoints; j++)
+    {
+      const float* other = &(coords[3 * j]);
+      float dx = other[0] - center[0];
+      float dy = other[1] - center[1];
+      float dz = other[2] - center[2];
+      if (j != i && dx * dx + dy * dy + dz * dz <= radiusSquared) { expected.push_back(j); }
+    }
+    DREAM3D_REQUIRE_EQUAL(found.size(), expected.size())
+    DREAM3D_REQUIRE(found == expected)
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestSparsePoints()
+{
+  // Two clusters a long way apart would need billions of unit cells, so the grid has to coarsen
+  std::vector<float> coords;
+  for (size_t i = 0; i < 20; i++)
+  {
+    float offset = (i % 2 == 0) ? 0.0f : 1.0e6f;
+    coords.push_back(offset + static_cast<float>(i));
+    coords.push_back(offset - static_cast<float>(i));
+    coords.push_back(offset + 0.5f * static_cast<float>(i));
+  }
+  size_t numPoints = coords.size() / 3;
+  PointGrid grid(&(coords.front()), numPoints, 1, 1.0f);
+
+  float cellSize = grid.getCellSize();
+  DREAM3D_REQUIRED(cellSize, >, 1.0f)
+  double cellsPerAxis = floor((1.0e6 + 19.0) / cellSize) + 1.0;
+  DREAM3D_REQUIRED(cellsPerAxis * cellsPerAxis * cellsPerAxis, <=, 4.0 * static_cast<double>(numPoints - 1))
+
+  float nearMin[3] = { -1.0f, -20.0f, -1.0f };
+  float nearMax[3] = { 20.0f, 1.0f, 10.0f };
+  checkBoxQuery(grid, coords, 1, nearMin, nearMax);
+  float farMin[3] = { 1.0e6f - 1.0f, 1.0e6f - 20.0f, 1.0e6f - 1.0f };
+  float farMax[3] = { 1.0e6f + 20.0f, 1.0e6f + 1.0f, 1.0e6f + 10.0f };
+  checkBoxQuery(grid, coords, 1, farMin, farMax);
+  float hugeMin[3] = { -1.0e30f, -1.0e30f, -1.0e30f };
+  float hugeMax[3] = { 1.0e30f, 1.0e30f, 1.0e30f };
+  checkBoxQuery(grid, coords, 1, hugeMin, hugeMax);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestDegenerateGrids()
+{
+  float boxMin[3] = { -10.0f, -10.0f, -10.0f };
+  float boxMax[3] = { 10.0f, 10.0f, 10.0f };
+
+  // Only point 0, which is skipped, so the grid is empty
+  std::vector<float> single(3, 1.0f);
+  PointGrid emptyGrid(&(single.front()), 1, 1, 2.0f);
+  std::vector<size_t> candidates;
+  emptyGrid.findCandidatesInBox(boxMin, boxMax, candidates);
+  DREAM3D_REQUIRE_EQUAL(candidates.size(), 0)
+
+  // A first point past the end is treated as an empty grid
+  PointGrid pastEndGrid(&(single.front()), 1, 5, 2.0f);
+  pastEndGrid.findCandidatesInBox(boxMin, boxMax, candidates);
+  DREAM3D_REQUIRE_EQUAL(candidates.size(), 0)
+
+  // A single point with an invalid cell size
+  PointGrid singleGrid(&(single.front()), 1, 0, 0.0f);
+  DREAM3D_REQUIRED(singleGrid.getCellSize(), >, 0.0f)
+  checkBoxQuery(singleGrid, single, 0, boxMin, boxMax);
+  float missMin[3] = { 1.5f, 0.0f, 0.0f };
+  float missMax[3] = { 2.0f, 2.0f, 2.0f };
+  checkBoxQuery(singleGrid, single, 0, missMin, missMax);
+
+  // Many points on the same spot and on a plane
+  std::vector<float> stacked;
+  for (size_t i = 0; i < 100; i++)
+  {
+    stacked.push_back(3.0f);
+    stacked.push_back((i < 50) ? 3.0f : static_cast<float>(i % 10));
+    stacked.push_back((i < 50) ? 3.0f : static_cast<float>(i / 10));
+  }
+  PointGrid stackedGrid(&(stacked.front()), 100, 1, 1.0f);
+  checkBoxQuery(stackedGrid, stacked, 1, boxMin, boxMax);
+  float spotMin[3] = { 3.0f, 3.0f, 3.0f };
+  float spotMax[3] = { 3.0f, 3.0f, 3.0f };
+  checkBoxQuery(stackedGrid, stacked, 1, spotMin, spotMax);
+  float stripMin[3] = { 2.5f, 4.5f, -1.0f };
+  float stripMax[3] = { 3.5f, 7.5f, 20.0f };
+  checkBoxQuery(stackedGrid, stacked, 1, stripMin, stripMax);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestBoxQueries(1, 5000) )
+  DREAM3D_REGISTER_TEST( TestBoxQueries(4, 5000) )
+  // Enough points for the grid to bucket them in parallel
+  DREAM3D_REGISTER_TEST( TestBoxQueries(4, 70000) )
+  DREAM3D_REGISTER_TEST( TestNeighborSearch(1) )
+  DREAM3D_REGISTER_TEST( TestNeighborSearch(4) )
+  DREAM3D_REGISTER_TEST( TestSparsePoints() )
+  DREAM3D_REGISTER_TEST( TestDegenerateGrids() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
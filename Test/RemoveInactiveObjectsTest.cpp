@@ -0,0 +1,362 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QMap>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataArrays/NeighborList.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+namespace
+{
+  const int32_t k_NumFeatures = 9;
+  const size_t k_NumCells = 100;
+
+  /**
+   * @brief Whether Feature j is a neighbor of Feature i in the test data
+   */
+  bool isNeighbor(int32_t i, int32_t j)
+  {
+    return i != j && (i + j) % 3 != 0;
+  }
+
+  /**
+   * @brief The features removed by the tests
+   */
+  bool isActive(int32_t i)
+  {
+    return i != 2 && i != 5 && i != 6;
+  }
+
+  /**
+   * @brief Builds a Feature Attribute Matrix holding the NeighborLists written by FindNeighbors,
+   * FindMisorientations and FindNeighborhoods, along with lists that are not paired with them
+   */
+  AttributeMatrix::Pointer createFeatureMatrix()
+  {
+    QVector<size_t> tDims(1, k_NumFeatures);
+    AttributeMatrix::Pointer am = AttributeMatrix::New(tDims, DREAM3D::Defaults::CellFeatureAttributeMatrixName, DREAM3D::AttributeMatrixType::CellFeature);
+
+    NeighborList<int32_t>::Pointer neighbors = NeighborList<int32_t>::CreateArray(k_NumFeatures, DREAM3D::FeatureData::NeighborList);
+    NeighborList<float>::Pointer areas = NeighborList<float>::CreateArray(k_NumFeatures, DREAM3D::FeatureData::SharedSurfaceAreaList);
+    NeighborList<float>::Pointer misorientations = NeighborList<float>::CreateArray(k_NumFeatures, DREAM3D::FeatureData::MisorientationList);
+    NeighborList<float>::Pointer clustering = NeighborList<float>::CreateArray(k_NumFeatures, "ClusteringList");
+    NeighborList<int32_t>::Pointer neighborhoods = NeighborList<int32_t>::CreateArray(k_NumFeatures, DREAM3D::FeatureData::NeighborhoodList);
+    NeighborList<int32_t>::Pointer counts = NeighborList<int32_t>::CreateArray(k_NumFeatures, "Counts");
+    Int32ArrayType::Pointer numNeighbors = Int32ArrayType::CreateArray(k_NumFeatures, DREAM3D::FeatureData::NumNeighbors);
+    FloatArrayType::Pointer volumes = FloatArrayType::CreateArray(k_NumFeatures, DREAM3D::FeatureData::Volumes);
+
+    for (int32_t i = 0; i < k_NumFeatures; i++)
+    {
+      for (int32_t j = 1; j < k_NumFeatures; j++)
+      {
+        if (isNeighbor(i, j) == true)
+        {
+          neighbors->getListReference(i).push_back(j);
+          areas->getListReference(i).push_back(10.0f * i + j);
+          misorientations->getListReference(i).push_back(100.0f * i + j);
+          clustering->getListReference(i).push_back(0.5f * j);
+          // Holds values in the Feature Id range that are not Feature Ids
+          counts->getListReference(i).push_back(j);
+        }
+        if (i != j && (i * j) % 2 == 1)
+        {
+          neighborhoods->getListReference(i).push_back(j);
+        }
+      }
+      numNeighbors->setValue(i, neighbors->getListSize(i));
+      volumes->setValue(i, 1.5f * i);
+    }
+
+    am->addAttributeArray(neighbors->getName(), neighbors);
+    am->addAttributeArray(areas->getName(), areas);
+    am->addAttributeArray(misorientations->getName(), misorientations);
+    am->addAttributeArray(clustering->getName(), clustering);
+    am->addAttributeArray(neighborhoods->getName(), neighborhoods);
+    am->addAttributeArray(counts->getName(), counts);
+    am->addAttributeArray(numNeighbors->getName(), numNeighbors);
+    am->addAttributeArray(volumes->getName(), volumes);
+    return am;
+  }
+
+  /**
+   * @brief Builds the cell Feature Ids and the active flags, and fills in the new Id of every old Feature
+   */
+  Int32ArrayType::Pointer createFeatureIds(QVector<bool>& activeObjects, std::vector<int32_t>& newIds)
+  {
+    Int32ArrayType::Pointer featureIds = Int32ArrayType::CreateArray(k_NumCells, DREAM3D::CellData::FeatureIds);
+    for (size_t i = 0; i < k_NumCells; i++)
+    {
+      featureIds->setValue(i, static_cast<int32_t>(i % k_NumFeatures));
+    }
+    activeObjects.fill(true, k_NumFeatures);
+    newIds.assign(k_NumFeatures, 0);
+    int32_t next = 1;
+    for (int32_t i = 1; i < k_NumFeatures; i++)
+    {
+      activeObjects[i] = isActive(i);
+      if (activeObjects[i] == true) { newIds[i] = next++; }
+    }
+    return featureIds;
+  }
+
+  /**
+   * @brief Checks the Feature Ids of the cells after the inactive Features were removed
+   */
+  void checkFeatureIds(Int32ArrayType::Pointer featureIds, const std::vector<int32_t>& newIds)
+  {
+    for (size_t i = 0; i < k_NumCells; i++)
+    {
+      DREAM3D_REQUIRE_EQUAL(featureIds->getValue(i), newIds[i % k_NumFeatures])
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestDefaultNeighborLists(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  AttributeMatrix::Pointer am = createFeatureMatrix();
+  QVector<bool> activeObjects;
+  std::vector<int32_t> newIds;
+  Int32ArrayType::Pointer featureIds = createFeatureIds(activeObjects, newIds);
+
+  DREAM3D_REQUIRE_EQUAL(am->removeInactiveObjects(activeObjects, featureIds), true)
+  checkFeatureIds(featureIds, newIds);
+
+  int32_t numKept = newIds.back() + 1;
+  DREAM3D_REQUIRE_EQUAL(am->getNumTuples(), static_cast<size_t>(numKept))
+
+  // Lists that are not known to be paired with a Feature Id list are removed
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("ClusteringList"), false)
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("Counts"), false)
+
+  NeighborList<int32_t>::Pointer neighbors = am->getAttributeArrayAs<NeighborList<int32_t> >(DREAM3D::FeatureData::NeighborList);
+  NeighborList<float>::Pointer areas = am->getAttributeArrayAs<NeighborList<float> >(DREAM3D::FeatureData::SharedSurfaceAreaList);
+  NeighborList<float>::Pointer misorientations = am->getAttributeArrayAs<NeighborList<float> >(DREAM3D::FeatureData::MisorientationList);
+  NeighborList<int32_t>::Pointer neighborhoods = am->getAttributeArrayAs<NeighborList<int32_t> >(DREAM3D::FeatureData::NeighborhoodList);
+  Int32ArrayType::Pointer numNeighbors = am->getAttributeArrayAs<Int32ArrayType>(DREAM3D::FeatureData::NumNeighbors);
+  FloatArrayType::Pointer volumes = am->getAttributeArrayAs<FloatArrayType>(DREAM3D::FeatureData::Volumes);
+  DREAM3D_REQUIRE_VALID_POINTER(neighbors.get())
+  DREAM3D_REQUIRE_VALID_POINTER(areas.get())
+  DREAM3D_REQUIRE_VALID_POINTER(misorientations.get())
+  DREAM3D_REQUIRE_VALID_POINTER(neighborhoods.get())
+  DREAM3D_REQUIRE_VALID_POINTER(numNeighbors.get())
+  DREAM3D_REQUIRE_VALID_POINTER(volumes.get())
+
+  for (int32_t i = 0; i < k_NumFeatures; i++)
+  {
+    if (i != 0 && activeObjects[i] == false) { continue; }
+    int32_t n = newIds[i];
+    DREAM3D_REQUIRE_EQUAL(volumes->getValue(n), 1.5f * i)
+
+    std::vector<int32_t> expectedNeighbors;
+    std::vector<float> expectedAreas;
+    std::vector<float> expectedMisorientations;
+    std::vector<int32_t> expectedNeighborhoods;
+    for (int32_t j = 1; j < k_NumFeatures; j++)
+    {
+      if (activeObjects[j] == false) { continue; }
+      if (isNeighbor(i, j) == true)
+      {
+        expectedNeighbors.push_back(newIds[j]);
+        expectedAreas.push_back(10.0f * i + j);
+        expectedMisorientations.push_back(100.0f * i + j);
+      }
+      if (i != j && (i * j) % 2 == 1)
+      {
+        expectedNeighborhoods.push_back(newIds[j]);
+      }
+    }
+    DREAM3D_REQUIRE(neighbors->getListReference(n) == expectedNeighbors)
+    DREAM3D_REQUIRE(areas->getListReference(n) == expectedAreas)
+    DREAM3D_REQUIRE(misorientations->getListReference(n) == expectedMisorientations)
+    DREAM3D_REQUIRE(neighborhoods->getListReference(n) == expectedNeighborhoods)
+    DREAM3D_REQUIRE_EQUAL(numNeighbors->getValue(n), static_cast<int32_t>(expectedNeighbors.size()))
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestExplicitNeighborLists(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  AttributeMatrix::Pointer am = createFeatureMatrix();
+  QVector<bool> activeObjects;
+  std::vector<int32_t> newIds;
+  Int32ArrayType::Pointer featureIds = createFeatureIds(activeObjects, newIds);
+
+  NeighborList<int32_t>::Pointer myIds = NeighborList<int32_t>::CreateArray(k_NumFeatures, "MyIds");
+  NeighborList<double>::Pointer myValues = NeighborList<double>::CreateArray(k_NumFeatures, "MyValues");
+  NeighborList<double>::Pointer badValues = NeighborList<double>::CreateArray(k_NumFeatures, "BadValues");
+  for (int32_t i = 0; i < k_NumFeatures; i++)
+  {
+    for (int32_t j = 0; j < k_NumFeatures; j++)
+    {
+      myIds->getListReference(i).push_back((i + j) % k_NumFeatures);
+      myValues->getListReference(i).push_back(0.25 * ((i + j) % k_NumFeatures));
+    }
+    // One list is a different size, so this list can not follow MyIds
+    badValues->getListReference(i).resize(i == 4 ? 1 : k_NumFeatures, 1.0);
+  }
+  am->addAttributeArray(myIds->getName(), myIds);
+  am->addAttributeArray(myValues->getName(), myValues);
+  am->addAttributeArray(badValues->getName(), badValues);
+
+  QMap<QString, QStringList> idLists;
+  idLists["MyIds"] << "MyValues" << "BadValues";
+  DREAM3D_REQUIRE_EQUAL(am->removeInactiveObjects(activeObjects, featureIds, idLists), true)
+  checkFeatureIds(featureIds, newIds);
+
+  // Only the given Id list and the list that matches it remain
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist(DREAM3D::FeatureData::NeighborList), false)
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist(DREAM3D::FeatureData::SharedSurfaceAreaList), false)
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist(DREAM3D::FeatureData::NeighborhoodList), false)
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("BadValues"), false)
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist(DREAM3D::FeatureData::NumNeighbors), true)
+
+  myIds = am->getAttributeArrayAs<NeighborList<int32_t> >("MyIds");
+  myValues = am->getAttributeArrayAs<NeighborList<double> >("MyValues");
+  DREAM3D_REQUIRE_VALID_POINTER(myIds.get())
+  DREAM3D_REQUIRE_VALID_POINTER(myValues.get())
+
+  for (int32_t i = 0; i < k_NumFeatures; i++)
+  {
+    if (i != 0 && activeObjects[i] == false) { continue; }
+    int32_t n = newIds[i];
+    std::vector<int32_t> expectedIds;
+    std::vector<double> expectedValues;
+    for (int32_t j = 0; j < k_NumFeatures; j++)
+    {
+      int32_t id = (i + j) % k_NumFeatures;
+      // Feature 0 is never removed and keeps its Id
+      if (id != 0 && activeObjects[id] == false) { continue; }
+      expectedIds.push_back(newIds[id]);
+      expectedValues.push_back(0.25 * id);
+    }
+    DREAM3D_REQUIRE(myIds->getListReference(n) == expectedIds)
+    DREAM3D_REQUIRE(myValues->getListReference(n) == expectedValues)
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+// Every NeighborList that survives the default removal must hold the new Ids, so a
+// list of Feature Ids under a name the default pairing does not know is removed
+// instead of being kept with the old Ids
+// -----------------------------------------------------------------------------
+void TestNoStaleIds(int numThreads)
+{
+  ParallelContext::SetNumberOfThreads(numThreads);
+
+  AttributeMatrix::Pointer am = createFeatureMatrix();
+  QVector<bool> activeObjects;
+  std::vector<int32_t> newIds;
+  Int32ArrayType::Pointer featureIds = createFeatureIds(activeObjects, newIds);
+
+  // The neighbor list written by FindNeighbors under a name chosen by the user
+  NeighborList<int32_t>::Pointer renamed = NeighborList<int32_t>::CreateArray(k_NumFeatures, "MyNeighborList");
+  for (int32_t i = 0; i < k_NumFeatures; i++)
+  {
+    renamed->getListReference(i) = am->getAttributeArrayAs<NeighborList<int32_t> >(DREAM3D::FeatureData::NeighborList)->getListReference(i);
+  }
+  am->addAttributeArray(renamed->getName(), renamed);
+
+  DREAM3D_REQUIRE_EQUAL(am->removeInactiveObjects(activeObjects, featureIds), true)
+  DREAM3D_REQUIRE_EQUAL(am->doesAttributeArrayExist("MyNeighborList"), false)
+
+  int32_t numKept = newIds.back() + 1;
+  std::vector<bool> keptIds(numKept, false);
+  for (int32_t i = 1; i < k_NumFeatures; i++)
+  {
+    if (activeObjects[i] == true) { keptIds[newIds[i]] = true; }
+  }
+
+  QList<QString> names = am->getAttributeArrayNames();
+  for (QList<QString>::iterator iter = names.begin(); iter != names.end(); ++iter)
+  {
+    NeighborList<int32_t>::Pointer idList = am->getAttributeArrayAs<NeighborList<int32_t> >(*iter);
+    if (NULL == idList.get()) { continue; }
+    DREAM3D_REQUIRE_EQUAL(idList->getNumberOfTuples(), static_cast<size_t>(numKept))
+    for (int32_t n = 0; n < numKept; n++)
+    {
+      const std::vector<int32_t>& list = idList->getListReference(n);
+      for (size_t j = 0; j < list.size(); j++)
+      {
+        DREAM3D_REQUIRED(list[j], >, 0)
+        DREAM3D_REQUIRED(list[j], <, numKept)
+        DREAM3D_REQUIRE(keptIds[list[j]] == true)
+      }
+    }
+  }
+
+  ParallelContext::SetNumberOfThreads(0);
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestDefaultNeighborLists(1) )
+  DREAM3D_REGISTER_TEST( TestDefaultNeighborLists(4) )
+  DREAM3D_REGISTER_TEST( TestExplicitNeighborLists(1) )
+  DREAM3D_REGISTER_TEST( TestExplicitNeighborLists(4) )
+  DREAM3D_REGISTER_TEST( TestNoStaleIds(1) )
+  DREAM3D_REGISTER_TEST( TestNoStaleIds(4) )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
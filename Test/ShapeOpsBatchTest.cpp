@@ -0,0 +1,147 @@
+/* ============================================================================
+* Copyright (c) 2009-2015 BlueQuartz Software, LLC
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* Redistributions of source code must retain the above copyright notice, this
+* list of conditions and the following disclaimer.
+*
+* Redistributions in binary form must reproduce the above copyright notice, this
+* list of conditions and the following disclaimer in the documentation and/or
+* other materials provided with the distribution.
+*
+* Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+* contributors may be used to endorse or promote products derived from this software
+* without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+* USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*
+* The code contained herein was partially funded by the followig contracts:
+*    United States Air Force Prime Contract FA8650-07-D-5800
+*    United States Air Force Prime Contract FA8650-10-D-5210
+*    United States Prime Contract Navy N00173-07-C-2068
+*
+* ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <stdlib.h>
+
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QMap>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/Geometry/ShapeOps/ShapeOps.h"
+#include "SIMPLib/Utilities/UnitTestSupport.hpp"
+
+namespace
+{
+  /**
+   * @brief The BatchPoints struct holds scaled point coordinates spread over and just beyond the unit
+   * cube, followed by points that sit exactly on the shape boundaries and axes
+   */
+  struct BatchPoints
+  {
+    std::vector<float> axis1comps;
+    std::vector<float> axis2comps;
+    std::vector<float> axis3comps;
+
+    BatchPoints(size_t numRandom)
+    {
+      srand(4321);
+      for (size_t i = 0; i < numRandom; i++)
+      {
+        axis1comps.push_back(static_cast<float>(rand() % 20001) * 0.000125f - 1.25f);
+        axis2comps.push_back(static_cast<float>(rand() % 20001) * 0.000125f - 1.25f);
+        axis3comps.push_back(static_cast<float>(rand() % 20001) * 0.000125f - 1.25f);
+      }
+      const float special[7] = { -1.0f, -0.5f, -0.0f, 0.0f, 0.5f, 1.0f, 1.0000001f };
+      for (int a = 0; a < 7; a++)
+      {
+        for (int b = 0; b < 7; b++)
+        {
+          for (int c = 0; c < 7; c++)
+          {
+            axis1comps.push_back(special[a]);
+            axis2comps.push_back(special[b]);
+            axis3comps.push_back(special[c]);
+          }
+        }
+      }
+    }
+  };
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void TestInsideBatchMatchesInside()
+{
+  // 1003 random points plus the 343 boundary points leave a partial vector at the end of the batch
+  BatchPoints points(1003);
+  size_t numPoints = points.axis1comps.size();
+
+  // Several sphericity values so the super ellipsoid and cube-octohedron shape parameters change
+  const float omega3s[5] = { 0.3f, 0.6f, 0.785f, 0.9f, 1.0f };
+
+  std::vector<ShapeOps::Pointer> shapeOps = ShapeOps::getShapeOpsVector();
+  for (size_t s = 0; s < shapeOps.size(); s++)
+  {
+    for (int o = 0; o < 5; o++)
+    {
+      QMap<ShapeOps::ArgName, float> args;
+      args[ShapeOps::Omega3] = omega3s[o];
+      args[ShapeOps::VolCur] = 10.0f;
+      args[ShapeOps::B_OverA] = 0.8f;
+      args[ShapeOps::C_OverA] = 0.6f;
+      shapeOps[s]->init();
+      shapeOps[s]->radcur1(args);
+
+      // Batches of every length up to a few vectors, starting at varying offsets, then the whole set
+      for (size_t count = 0; count <= 19; count++)
+      {
+        size_t offset = (count * 37) % (numPoints - count);
+        std::vector<float> insides(count + 1, 0.0f);
+        shapeOps[s]->insideBatch(&(points.axis1comps.front()) + offset, &(points.axis2comps.front()) + offset, &(points.axis3comps.front()) + offset, &(insides.front()), count);
+        for (size_t i = 0; i < count; i++)
+        {
+          float inside = shapeOps[s]->inside(points.axis1comps[offset + i], points.axis2comps[offset + i], points.axis3comps[offset + i]);
+          DREAM3D_REQUIRE_EQUAL(insides[i], inside)
+        }
+        // Nothing is written past the end of the batch
+        DREAM3D_REQUIRE_EQUAL(insides[count], 0.0f)
+      }
+
+      std::vector<float> insides(numPoints, 0.0f);
+      shapeOps[s]->insideBatch(&(points.axis1comps.front()), &(points.axis2comps.front()), &(points.axis3comps.front()), &(insides.front()), numPoints);
+      for (size_t i = 0; i < numPoints; i++)
+      {
+        float inside = shapeOps[s]->inside(points.axis1comps[i], points.axis2comps[i], points.axis3comps[i]);
+        DREAM3D_REQUIRE_EQUAL(insides[i], inside)
+      }
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//  Use unit test framework
+// -----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  int err = EXIT_SUCCESS;
+
+  DREAM3D_REGISTER_TEST( TestInsideBatchMatchesInside() )
+
+  PRINT_TEST_SUMMARY();
+  return err;
+}
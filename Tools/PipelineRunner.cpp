@@ -44,6 +44,7 @@
 // TCLAP Includes
 #include <tclap/CmdLine.h>
 #include <tclap/ValueArg.h>
+#include <tclap/SwitchArg.h>
 
 // Boost includes
 #include <boost/assert.hpp>
@@ -69,6 +70,7 @@
 #include "SIMPLib/FilterParameters/H5FilterParametersReader.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
 #include "SIMPLib/Utilities/QMetaObjectUtilities.h"
+#include "SIMPLib/Utilities/ParallelContext.h"
 
 
 // -----------------------------------------------------------------------------
@@ -136,6 +138,12 @@ int main (int argc, char*  argv[])
     TCLAP::ValueArg<std::string> pipelineFileArg( "p", "pipeline", "Pipeline File", true, "", "Pipeline Input File (*.txt or *.ini)");
     cmd.add(pipelineFileArg);
 
+    TCLAP::ValueArg<int> threadsArg( "t", "threads", "Number of threads the filters may use. Defaults to SIMPL_NUM_THREADS or the number of available CPUs", false, 0, "Thread Count");
+    cmd.add(threadsArg);
+
+    TCLAP::SwitchArg pinThreadsArg( "", "pin-threads", "Pin each worker thread to one of the CPUs this process may run on", false);
+    cmd.add(pinThreadsArg);
+
     // Parse the argv array.
     cmd.parse(argc, argv);
     if (argc == 1)
@@ -145,6 +153,14 @@ int main (int argc, char*  argv[])
     }
     // Extract the file path passed in by the user.
     pipelineFile = QString::fromStdString(pipelineFileArg.getValue());
+    if (threadsArg.getValue() > 0)
+    {
+      ParallelContext::SetNumberOfThreads(threadsArg.getValue());
+    }
+    if (pinThreadsArg.getValue() == true)
+    {
+      ParallelContext::SetPinThreads(true);
+    }
   }
   catch (TCLAP::ArgException& e) // catch any exceptions
   {